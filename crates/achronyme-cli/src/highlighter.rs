@@ -17,7 +17,7 @@ fn is_builtin_function(name: &str) -> bool {
         // Rounding
         "floor" | "ceil" | "round" | "abs" |
         // Higher-order functions
-        "map" | "reduce" | "filter" | "fold" |
+        "map" | "reduce" | "filter" | "fold" | "pmap" | "preduce" | "pfilter" |
         // Calculus
         "diff" | "integral" | "solve" | "derivative" |
         // Linear algebra
@@ -27,7 +27,7 @@ fn is_builtin_function(name: &str) -> bool {
         "sum" | "mean" | "median" | "std" | "var" | "min" | "max" |
         "corr" | "cov" |
         // Signal processing
-        "fft" | "ifft" | "fft_mag" | "fft_phase" | "convolve" |
+        "fft" | "ifft" | "fft_mag" | "fft_phase" | "rfft" | "irfft" | "convolve" |
         // Conditional
         "if" | "piecewise" |
         // Utilities
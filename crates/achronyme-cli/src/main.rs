@@ -6,6 +6,7 @@ use std::fs;
 
 mod highlighter;
 mod repl_helper;
+mod serve;
 
 use repl_helper::ReplHelper;
 
@@ -28,6 +29,11 @@ struct Cli {
     #[arg(short, long)]
     interactive: bool,
 
+    /// Profile the run: print per-function timings to stderr and write
+    /// folded stacks (for flamegraph tools) to <INPUT>.folded
+    #[arg(long, global = true)]
+    profile: bool,
+
     #[command(subcommand)]
     command: Option<Commands>,
 }
@@ -51,6 +57,31 @@ enum Commands {
         /// File to check
         file: String,
     },
+    /// Serve isolated sessions over TCP, one per connection
+    Serve {
+        /// Address to listen on
+        #[arg(long, default_value = "127.0.0.1:7878")]
+        addr: String,
+        /// Worker threads (default: available parallelism)
+        #[arg(long)]
+        workers: Option<usize>,
+        /// Script whose definitions every session starts with
+        #[arg(long, value_name = "FILE")]
+        prelude: Option<String>,
+        /// Seconds one request may evaluate before it fails (0: no limit)
+        #[arg(long, value_name = "SECS", default_value_t = 10)]
+        timeout: u64,
+        /// Seconds a session may wait for input before it is closed (0: no limit)
+        #[arg(long, value_name = "SECS", default_value_t = 300)]
+        idle_timeout: u64,
+        /// Seconds a session may stay connected in total (0: no limit)
+        #[arg(long, value_name = "SECS", default_value_t = 900)]
+        session_timeout: u64,
+        /// Let sessions read and write files (save_env, restore_env, env_info,
+        /// compact_env, module imports and the ACHRONYME_AST_CACHE directory)
+        #[arg(long)]
+        allow_io: bool,
+    },
 }
 
 fn main() {
@@ -60,16 +91,20 @@ fn main() {
     if let Some(command) = cli.command {
         match command {
             Commands::Repl => run_repl(),
-            Commands::Run { file } => run_file(&file),
-            Commands::Eval { expression } => run_expression(&expression),
+            Commands::Run { file } => run_file(&file, cli.profile),
+            Commands::Eval { expression } => run_expression(&expression, cli.profile),
             Commands::Check { file } => check_syntax(&file),
+            Commands::Serve { addr, workers, prelude, timeout, idle_timeout, session_timeout, allow_io } => {
+                let limits = serve::Limits::from_secs(timeout, idle_timeout, session_timeout, allow_io);
+                serve::run_server(&addr, workers, prelude.as_deref(), limits)
+            }
         }
         return;
     }
 
     // Handle --eval flag
     if let Some(expr) = cli.eval {
-        run_expression(&expr);
+        run_expression(&expr, cli.profile);
         return;
     }
 
@@ -84,9 +119,9 @@ fn main() {
         None => run_repl(),
         Some(input) => {
             if input.ends_with(".ach") || input.ends_with(".soc") {
-                run_file(&input);
+                run_file(&input, cli.profile);
             } else {
-                run_expression(&input);
+                run_expression(&input, cli.profile);
             }
         }
     }
@@ -312,7 +347,7 @@ fn clear_screen() {
     print!("\x1B[2J\x1B[1;1H");
 }
 
-fn run_file(filename: &str) {
+fn run_file(filename: &str, profile: bool) {
     let contents = match fs::read_to_string(filename) {
         Ok(contents) => contents,
         Err(err) => {
@@ -326,8 +361,21 @@ fn run_file(filename: &str) {
     // Set the current file directory for relative imports
     evaluator.set_current_file_dir(filename);
 
+    // Optional on-disk AST cache: scripts and modules parsed by an earlier
+    // run are loaded instead of re-parsed
+    if let Some(dir) = std::env::var_os("ACHRONYME_AST_CACHE") {
+        evaluator.parse_cache_mut().set_disk_cache(Some(dir.into()));
+    }
+
+    evaluator.set_profiling(profile);
+
     // Parse and evaluate the entire file using Pest
-    match evaluate_expression(&mut evaluator, &contents) {
+    let result = evaluate_expression(&mut evaluator, &contents);
+    if profile {
+        write_profile(&evaluator, &format!("{}.folded", filename));
+    }
+
+    match result {
         Ok(result) => println!("{}", result),
         Err(err) => {
             eprintln!("Error: {}", err);
@@ -336,10 +384,16 @@ fn run_file(filename: &str) {
     }
 }
 
-fn run_expression(expr: &str) {
+fn run_expression(expr: &str, profile: bool) {
     let mut evaluator = Evaluator::new();
+    evaluator.set_profiling(profile);
 
-    match evaluate_expression(&mut evaluator, expr) {
+    let result = evaluate_expression(&mut evaluator, expr);
+    if profile {
+        write_profile(&evaluator, "achronyme.folded");
+    }
+
+    match result {
         Ok(result) => println!("{}", result),
         Err(err) => {
             eprintln!("Error: {}", err);
@@ -348,6 +402,19 @@ fn run_expression(expr: &str) {
     }
 }
 
+/// Print the profile table to stderr and write the folded stacks to `folded_path`
+fn write_profile(evaluator: &Evaluator, folded_path: &str) {
+    let Some(profiler) = evaluator.profiler() else {
+        return;
+    };
+
+    eprint!("{}", profiler.report());
+    match fs::write(folded_path, profiler.folded_stacks()) {
+        Ok(()) => eprintln!("Folded stacks written to {}", folded_path),
+        Err(err) => eprintln!("Error writing '{}': {}", folded_path, err),
+    }
+}
+
 fn evaluate_expression(evaluator: &mut Evaluator, input: &str) -> Result<String, String> {
     // Parse and evaluate using Pest
     let result = evaluator.eval_str(input)?;
@@ -455,14 +522,15 @@ fn format_value(value: &achronyme_types::value::Value) -> String {
                 "<generator>".to_string()
             }
         }
+        Value::Sequence(_) => "<sequence>".to_string(),
         Value::GeneratorYield(_) => {
             // GeneratorYield is an internal marker that should never reach the REPL
             "<internal:generator-yield>".to_string()
         }
-        Value::Error { message, kind, .. } => {
-            match kind {
-                Some(k) => format!("Error({}: {})", k, message),
-                None => format!("Error({})", message),
+        Value::Error(error) => {
+            match &error.kind {
+                Some(k) => format!("Error({}: {})", k, error.message),
+                None => format!("Error({})", error.message),
             }
         }
     }
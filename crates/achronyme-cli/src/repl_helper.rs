@@ -24,7 +24,7 @@ impl ReplHelper {
             // Rounding
             "floor", "ceil", "round", "abs",
             // Higher-order functions
-            "map", "reduce", "filter", "fold",
+            "map", "reduce", "filter", "fold", "pmap", "preduce", "pfilter",
             // Calculus
             "diff", "integral", "solve", "derivative",
             // Linear algebra
@@ -34,7 +34,7 @@ impl ReplHelper {
             "sum", "mean", "median", "std", "var", "min", "max",
             "corr", "cov",
             // Signal processing
-            "fft", "ifft", "fft_mag", "fft_phase", "convolve",
+            "fft", "ifft", "fft_mag", "fft_phase", "rfft", "irfft", "convolve",
             // Conditional
             "if", "piecewise",
             // Utilities
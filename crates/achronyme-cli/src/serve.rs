@@ -0,0 +1,319 @@
+//! `achronyme serve`: isolated sessions on a pool of worker threads
+//!
+//! Every TCP connection is one session. Sessions are handed to a fixed pool
+//! of workers; each worker builds a warm base evaluator once (builtin
+//! registries are shared by the whole process, the prelude AST is parsed
+//! once and shared by every worker) and forks it for each session it runs,
+//! so a session starts with the prelude already evaluated and nothing one
+//! session defines or mutates is visible to another.
+//!
+//! The protocol is line based. Lines are collected like in the REPL until
+//! the program is complete; the reply is a single line, `ok <value>` or
+//! `error <message>`, with newlines escaped as `\n` (and backslashes as
+//! `\\`). Closing the connection ends the session.
+//!
+//! Clients are not trusted. Each request gets a wall-clock budget and each
+//! session a total lifetime, lines and programs have a maximum size, idle
+//! and stalled connections are dropped, and sessions cannot reach the file
+//! system (file builtins, module imports, the on-disk AST cache) unless the
+//! server runs with `--allow-io`. What is not bounded: a single builtin call
+//! (`matmul` on large matrices, say) runs to completion between deadline
+//! checks, and identifiers are interned for the life of the process, so
+//! every new name a client sends grows memory a little.
+
+use achronyme_eval::Evaluator;
+use achronyme_parser::ParseCache;
+use std::fs;
+use std::io::{self, BufRead, BufReader, Read, Write};
+use std::net::{TcpListener, TcpStream};
+use std::panic::{self, AssertUnwindSafe};
+use std::sync::mpsc::{self, Receiver};
+use std::sync::{Arc, Mutex};
+use std::thread;
+use std::time::{Duration, Instant};
+
+use crate::{evaluate_expression, should_continue_reading};
+
+/// Longest accepted protocol line, in bytes
+const MAX_LINE_BYTES: usize = 64 * 1024;
+
+/// Longest accepted program (every line of one request), in bytes
+const MAX_REQUEST_BYTES: usize = 1024 * 1024;
+
+/// A client that doesn't take a reply within this long is dropped
+const WRITE_TIMEOUT: Duration = Duration::from_secs(10);
+
+/// Limits applied to every session
+#[derive(Debug, Clone, Copy)]
+pub struct Limits {
+    /// Evaluation time of one request
+    pub request_timeout: Option<Duration>,
+    /// Time a session may wait for its next line
+    pub idle_timeout: Option<Duration>,
+    /// Time a session may stay connected in total
+    pub session_timeout: Option<Duration>,
+    /// Keep the file builtins and module imports enabled
+    pub allow_io: bool,
+}
+
+impl Limits {
+    /// Limits from command-line seconds, where 0 means no limit
+    pub fn from_secs(request_timeout: u64, idle_timeout: u64, session_timeout: u64, allow_io: bool) -> Self {
+        let seconds = |secs: u64| (secs > 0).then(|| Duration::from_secs(secs));
+        Self {
+            request_timeout: seconds(request_timeout),
+            idle_timeout: seconds(idle_timeout),
+            session_timeout: seconds(session_timeout),
+            allow_io,
+        }
+    }
+}
+
+/// Everything a worker needs to build its base evaluator
+#[derive(Clone)]
+struct Warmup {
+    /// Cache already holding the prelude AST; clones share it
+    parse_cache: ParseCache,
+    prelude: Option<(String, String)>,
+    limits: Limits,
+}
+
+impl Warmup {
+    fn base_evaluator(&self) -> Result<Evaluator, String> {
+        let mut evaluator = Evaluator::new();
+        *evaluator.parse_cache_mut() = self.parse_cache.clone();
+        if let Some((path, source)) = &self.prelude {
+            evaluator.set_current_file_dir(path);
+            evaluator
+                .eval_prelude(source)
+                .map_err(|err| format!("prelude '{}': {}", path, err))?;
+        }
+        // The prelude is the operator's and may use files; sessions may not
+        if !self.limits.allow_io {
+            evaluator.disable_file_io();
+        }
+        Ok(evaluator)
+    }
+}
+
+pub fn run_server(addr: &str, workers: Option<usize>, prelude: Option<&str>, limits: Limits) {
+    let mut parse_cache = ParseCache::new();
+    if let Some(dir) = std::env::var_os("ACHRONYME_AST_CACHE") {
+        parse_cache.set_disk_cache(Some(dir.into()));
+    }
+
+    let prelude = prelude.map(|path| match fs::read_to_string(path) {
+        Ok(source) => (path.to_string(), source),
+        Err(err) => {
+            eprintln!("Error reading prelude '{}': {}", path, err);
+            std::process::exit(1);
+        }
+    });
+    if let Some((path, source)) = &prelude {
+        if let Err(err) = parse_cache.parse(source) {
+            eprintln!("Error in prelude '{}': {}", path, err);
+            std::process::exit(1);
+        }
+    }
+    // Only the prelude goes through the disk cache; client programs would
+    // otherwise each leave a file behind
+    if !limits.allow_io {
+        parse_cache.set_disk_cache(None);
+    }
+    let warmup = Warmup { parse_cache, prelude, limits };
+
+    // Fail before listening if the prelude doesn't evaluate
+    if let Err(err) = warmup.base_evaluator() {
+        eprintln!("Error: {}", err);
+        std::process::exit(1);
+    }
+
+    let listener = match TcpListener::bind(addr) {
+        Ok(listener) => listener,
+        Err(err) => {
+            eprintln!("Error binding {}: {}", addr, err);
+            std::process::exit(1);
+        }
+    };
+
+    let workers = workers
+        .unwrap_or_else(|| thread::available_parallelism().map_or(1, |n| n.get()))
+        .max(1);
+    let (sender, receiver) = mpsc::channel::<TcpStream>();
+    let receiver = Arc::new(Mutex::new(receiver));
+    for _ in 0..workers {
+        let receiver = Arc::clone(&receiver);
+        let warmup = warmup.clone();
+        thread::spawn(move || run_worker(&warmup, &receiver));
+    }
+
+    eprintln!("Achronyme server listening on {} ({} workers)", addr, workers);
+    for stream in listener.incoming() {
+        match stream {
+            Ok(stream) => {
+                if sender.send(stream).is_err() {
+                    eprintln!("Error: all workers have stopped");
+                    std::process::exit(1);
+                }
+            }
+            Err(err) => eprintln!("Error accepting connection: {}", err),
+        }
+    }
+}
+
+/// Run sessions from the queue, each forked from this worker's base
+fn run_worker(warmup: &Warmup, queue: &Mutex<Receiver<TcpStream>>) {
+    let base = match warmup.base_evaluator() {
+        Ok(base) => base,
+        Err(err) => {
+            eprintln!("Error: {}", err);
+            return;
+        }
+    };
+
+    loop {
+        // The lock is released as soon as a connection is taken
+        let stream = match queue.lock() {
+            Ok(queue) => queue.recv(),
+            Err(_) => return,
+        };
+        let Ok(stream) = stream else {
+            return;
+        };
+
+        let peer = stream
+            .peer_addr()
+            .map_or_else(|_| "unknown peer".to_string(), |addr| addr.to_string());
+        // A panicking session must not take its worker down with it
+        match panic::catch_unwind(AssertUnwindSafe(|| run_session(&base, stream, &warmup.limits))) {
+            Ok(Ok(())) => {}
+            Ok(Err(err)) => eprintln!("Session {}: {}", peer, err),
+            Err(_) => eprintln!("Session {}: evaluator panicked", peer),
+        }
+    }
+}
+
+/// Serve one connection on a fork of `base`
+fn run_session(base: &Evaluator, stream: TcpStream, limits: &Limits) -> io::Result<()> {
+    let session_end = limits.session_timeout.map(|timeout| Instant::now() + timeout);
+    stream.set_write_timeout(Some(WRITE_TIMEOUT))?;
+    let mut session = base.fork();
+    let mut writer = stream.try_clone()?;
+    let mut reader = BufReader::new(stream);
+    let mut input_buffer = String::new();
+    let mut line = String::new();
+
+    loop {
+        // Wait for the next line no longer than the idle timeout or what is
+        // left of the session
+        let remaining = match session_end {
+            Some(end) => match end.checked_duration_since(Instant::now()).filter(|left| !left.is_zero()) {
+                Some(left) => Some(left),
+                None => {
+                    let _ = writeln!(writer, "error session time limit reached");
+                    return Err(io::Error::new(io::ErrorKind::TimedOut, "session time limit reached"));
+                }
+            },
+            None => None,
+        };
+        let wait = match (limits.idle_timeout, remaining) {
+            (Some(idle), Some(left)) => Some(idle.min(left)),
+            (idle, left) => idle.or(left),
+        };
+        reader.get_ref().set_read_timeout(wait)?;
+
+        match read_line(&mut reader, &mut line) {
+            Ok(true) => {}
+            Ok(false) => break,
+            Err(err) => {
+                let err = match err.kind() {
+                    io::ErrorKind::TimedOut if session_end.map_or(false, |end| Instant::now() >= end) => {
+                        io::Error::new(io::ErrorKind::TimedOut, "session time limit reached")
+                    }
+                    _ => err,
+                };
+                // Best effort: the client may be gone already
+                if matches!(err.kind(), io::ErrorKind::InvalidData | io::ErrorKind::TimedOut) {
+                    let _ = writeln!(writer, "error {}", err);
+                }
+                return Err(err);
+            }
+        }
+        if input_buffer.is_empty() && line.trim().is_empty() {
+            continue;
+        }
+        if !input_buffer.is_empty() {
+            input_buffer.push('\n');
+        }
+        input_buffer.push_str(&line);
+        if input_buffer.len() > MAX_REQUEST_BYTES {
+            let err = format!("program longer than {} bytes", MAX_REQUEST_BYTES);
+            let _ = writeln!(writer, "error {}", err);
+            return Err(io::Error::new(io::ErrorKind::InvalidData, err));
+        }
+
+        if should_continue_reading(&input_buffer) {
+            continue;
+        }
+
+        let depth = session.environment().scope_depth();
+        let deadline = limits.request_timeout.map(|timeout| Instant::now() + timeout);
+        session.set_deadline(match (deadline, session_end) {
+            (Some(deadline), Some(end)) => Some(deadline.min(end)),
+            (deadline, end) => deadline.or(end),
+        });
+        let result = evaluate_expression(&mut session, input_buffer.trim());
+        session.set_deadline(None);
+        if result.is_err() {
+            // Loops and blocks the error unwound out of leave their scopes behind
+            while session.environment().scope_depth() > depth {
+                session.environment_mut().pop_scope();
+            }
+        }
+
+        let reply = match result {
+            Ok(result) => format!("ok {}", escape_newlines(&result)),
+            Err(err) => format!("error {}", escape_newlines(&err)),
+        };
+        input_buffer.clear();
+        writeln!(writer, "{}", reply)?;
+        writer.flush()?;
+    }
+    Ok(())
+}
+
+/// Read the next line into `line`, without its terminator; `false` at the
+/// end of input
+///
+/// A line over `MAX_LINE_BYTES` is an `InvalidData` error and silence past
+/// the read timeout a `TimedOut` one; either ends the session.
+fn read_line(reader: &mut impl BufRead, line: &mut String) -> io::Result<bool> {
+    line.clear();
+    let read = match reader.by_ref().take(MAX_LINE_BYTES as u64 + 1).read_line(line) {
+        Ok(read) => read,
+        Err(err) if matches!(err.kind(), io::ErrorKind::WouldBlock | io::ErrorKind::TimedOut) => {
+            return Err(io::Error::new(io::ErrorKind::TimedOut, "timed out waiting for input"));
+        }
+        Err(err) => return Err(err),
+    };
+    if read == 0 {
+        return Ok(false);
+    }
+    if line.ends_with('\n') {
+        line.pop();
+        if line.ends_with('\r') {
+            line.pop();
+        }
+    } else if read > MAX_LINE_BYTES {
+        return Err(io::Error::new(
+            io::ErrorKind::InvalidData,
+            format!("line longer than {} bytes", MAX_LINE_BYTES),
+        ));
+    }
+    Ok(true)
+}
+
+/// Keep a multi-line value or message on one protocol line
+fn escape_newlines(text: &str) -> String {
+    text.replace('\\', "\\\\").replace('\n', "\\n")
+}
@@ -0,0 +1,80 @@
+use achronyme_dsp::{convolve_auto, convolve_fft, convolve_simd, fft_transform, FirFilter, Stft, WindowKind};
+use achronyme_types::complex::Complex;
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+
+/// Power-of-two lengths hit radix-2 kernels, primes hit Bluestein / Rader
+const LENGTHS: &[usize] = &[1024, 1021, 4096, 4093, 65536, 65521];
+
+fn signal(n: usize) -> Vec<f64> {
+    (0..n).map(|i| (i as f64 * 0.05).sin() + 0.25 * (i as f64 * 0.31).cos()).collect()
+}
+
+fn bench_fft(c: &mut Criterion) {
+    let mut group = c.benchmark_group("dsp/fft_transform");
+    for &n in LENGTHS {
+        let input: Vec<Complex> = signal(n).into_iter().map(|x| Complex::new(x, 0.0)).collect();
+        group.throughput(Throughput::Elements(n as u64));
+        group.bench_with_input(BenchmarkId::from_parameter(n), &input, |bench, input| {
+            bench.iter(|| fft_transform(black_box(input)))
+        });
+    }
+    group.finish();
+}
+
+fn bench_convolve_fft(c: &mut Criterion) {
+    let mut group = c.benchmark_group("dsp/convolve_fft");
+    for &n in LENGTHS {
+        let input = signal(n);
+        let kernel = signal(n / 16 + 1);
+        group.throughput(Throughput::Elements(n as u64));
+        group.bench_with_input(BenchmarkId::from_parameter(n), &input, |bench, input| {
+            bench.iter(|| convolve_fft(black_box(input), black_box(&kernel)))
+        });
+    }
+    group.finish();
+}
+
+/// Long signal, short filter: the case block convolution is for
+fn bench_fir(c: &mut Criterion) {
+    let input = signal(1 << 20);
+    let mut group = c.benchmark_group("dsp/fir");
+    group.throughput(Throughput::Elements(input.len() as u64));
+    for taps in [16, 64, 256] {
+        let kernel = signal(taps);
+        group.bench_with_input(BenchmarkId::new("simd_direct", taps), &input, |bench, input| {
+            bench.iter(|| convolve_simd(black_box(input), black_box(&kernel)))
+        });
+        group.bench_with_input(BenchmarkId::new("auto", taps), &input, |bench, input| {
+            bench.iter(|| convolve_auto(black_box(input), black_box(&kernel)))
+        });
+        group.bench_with_input(BenchmarkId::new("stream_4096", taps), &input, |bench, input| {
+            bench.iter(|| {
+                let mut filter = FirFilter::new(&kernel).unwrap();
+                let mut last = 0.0;
+                for chunk in input.chunks(4096) {
+                    last = *filter.process(black_box(chunk)).last().unwrap();
+                }
+                last
+            })
+        });
+    }
+    group.finish();
+}
+
+/// One second of 48 kHz audio, 1024-sample frames at 75% overlap
+fn bench_stft(c: &mut Criterion) {
+    let input = signal(48_000);
+    let stft = Stft::new(1024, 256, WindowKind::Hanning).unwrap();
+    let mut group = c.benchmark_group("dsp/stft");
+    group.throughput(Throughput::Elements(input.len() as u64));
+    group.bench_function("transform", |bench| bench.iter(|| stft.transform(black_box(&input))));
+
+    let spectrum = stft.transform(&input);
+    group.bench_function("inverse", |bench| {
+        bench.iter(|| stft.inverse(black_box(spectrum.data()), spectrum.shape()[0], Some(input.len())))
+    });
+    group.finish();
+}
+
+criterion_group!(benches, bench_fft, bench_convolve_fft, bench_fir, bench_stft);
+criterion_main!(benches);
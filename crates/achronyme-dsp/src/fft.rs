@@ -1,20 +1,155 @@
+use std::cell::RefCell;
+use std::collections::HashMap;
+use std::f64::consts::PI;
+use std::sync::{Arc, Mutex, OnceLock};
+
 use achronyme_types::complex::Complex;
-use rustfft::{FftPlanner, num_complex::Complex64};
+use rustfft::{Fft, FftDirection, FftPlanner, num_complex::Complex64};
+
+// `Complex` is `#[repr(C)] { re: f64, im: f64 }`, exactly like `Complex64`,
+// so buffers can be handed to rustfft without copying
+const _: () = assert!(
+    std::mem::size_of::<Complex>() == std::mem::size_of::<Complex64>()
+        && std::mem::align_of::<Complex>() == std::mem::align_of::<Complex64>()
+);
+
+// SAFETY (all four views): both types are #[repr(C)] pairs of f64 with
+// identical size and alignment (checked above), so the slices have the same
+// layout and the borrow carries over unchanged
+
+/// View an Achronyme Complex buffer as a rustfft Complex64 buffer
+pub fn as_complex64(buffer: &[Complex]) -> &[Complex64] {
+    unsafe { std::slice::from_raw_parts(buffer.as_ptr() as *const Complex64, buffer.len()) }
+}
+
+/// Mutable view of an Achronyme Complex buffer as a rustfft Complex64 buffer
+pub fn as_complex64_mut(buffer: &mut [Complex]) -> &mut [Complex64] {
+    unsafe { std::slice::from_raw_parts_mut(buffer.as_mut_ptr() as *mut Complex64, buffer.len()) }
+}
+
+/// View a rustfft Complex64 buffer as an Achronyme Complex buffer
+pub fn from_complex64(buffer: &[Complex64]) -> &[Complex] {
+    unsafe { std::slice::from_raw_parts(buffer.as_ptr() as *const Complex, buffer.len()) }
+}
+
+/// Mutable view of a rustfft Complex64 buffer as an Achronyme Complex buffer
+pub fn from_complex64_mut(buffer: &mut [Complex64]) -> &mut [Complex] {
+    unsafe { std::slice::from_raw_parts_mut(buffer.as_mut_ptr() as *mut Complex, buffer.len()) }
+}
+
+// ============================================================================
+// Plan cache
+// ============================================================================
+
+/// Half-length complex plans plus twiddles for real transforms of length n
+pub(crate) struct RealPlan {
+    forward: Arc<dyn Fft<f64>>,
+    inverse: Arc<dyn Fft<f64>>,
+    /// exp(-2*pi*i*k/n) for k in 0..n/2
+    twiddles: Vec<Complex64>,
+}
+
+#[derive(Default)]
+struct PlanCache {
+    complex: HashMap<(usize, FftDirection), Arc<dyn Fft<f64>>>,
+    real: HashMap<usize, Arc<RealPlan>>,
+}
+
+/// Process-wide plan cache, shared by every caller and thread
+fn plan_cache() -> &'static Mutex<PlanCache> {
+    static CACHE: OnceLock<Mutex<PlanCache>> = OnceLock::new();
+    CACHE.get_or_init(|| Mutex::new(PlanCache::default()))
+}
+
+fn lock_cache() -> std::sync::MutexGuard<'static, PlanCache> {
+    // A panic while planning leaves the cache itself intact
+    plan_cache().lock().unwrap_or_else(|poisoned| poisoned.into_inner())
+}
+
+/// Get (or build and cache) the complex FFT plan for a length and direction
+pub fn fft_plan(len: usize, direction: FftDirection) -> Arc<dyn Fft<f64>> {
+    let mut cache = lock_cache();
+    cache
+        .complex
+        .entry((len, direction))
+        .or_insert_with(|| FftPlanner::new().plan_fft(len, direction))
+        .clone()
+}
+
+/// Get (or build and cache) the plan for a real transform of even length n
+pub(crate) fn real_plan(n: usize) -> Arc<RealPlan> {
+    if let Some(plan) = lock_cache().real.get(&n) {
+        return plan.clone();
+    }
+
+    let half = n / 2;
+    let plan = Arc::new(RealPlan {
+        forward: fft_plan(half, FftDirection::Forward),
+        inverse: fft_plan(half, FftDirection::Inverse),
+        twiddles: (0..half)
+            .map(|k| Complex64::from_polar(1.0, -2.0 * PI * k as f64 / n as f64))
+            .collect(),
+    });
+    lock_cache().real.insert(n, plan.clone());
+    plan
+}
+
+/// Run a plan in place, reusing a per-thread scratch buffer
+fn process(fft: &dyn Fft<f64>, buffer: &mut [Complex64]) {
+    thread_local! {
+        static SCRATCH: RefCell<Vec<Complex64>> = const { RefCell::new(Vec::new()) };
+    }
+
+    SCRATCH.with(|scratch| {
+        let mut scratch = scratch.borrow_mut();
+        let len = fft.get_inplace_scratch_len();
+        if scratch.len() < len {
+            scratch.resize(len, Complex64::new(0.0, 0.0));
+        }
+        fft.process_with_scratch(buffer, &mut scratch[..len]);
+    });
+}
+
+// ============================================================================
+// In-place transforms
+// ============================================================================
 
-/// Convert Achronyme Complex vector to rustfft Complex64 vector
-fn to_complex64(input: &[Complex]) -> Vec<Complex64> {
-    input
-        .iter()
-        .map(|c| Complex64::new(c.re, c.im))
-        .collect()
+/// In-place forward FFT
+///
+/// Transforms `buffer` without allocating; plans are cached by length.
+///
+/// # Example
+/// ```
+/// use achronyme_dsp::fft_in_place;
+/// use achronyme_types::complex::Complex;
+///
+/// let mut buffer = vec![Complex::new(1.0, 0.0); 4];
+/// fft_in_place(&mut buffer);
+/// assert_eq!(buffer[0].re, 4.0);
+/// ```
+pub fn fft_in_place(buffer: &mut [Complex]) {
+    if buffer.is_empty() {
+        return;
+    }
+    let fft = fft_plan(buffer.len(), FftDirection::Forward);
+    process(fft.as_ref(), as_complex64_mut(buffer));
 }
 
-/// Convert rustfft Complex64 vector to Achronyme Complex vector
-fn from_complex64(input: &[Complex64]) -> Vec<Complex> {
-    input
-        .iter()
-        .map(|c| Complex::new(c.re, c.im))
-        .collect()
+/// In-place inverse FFT, scaled by 1/N
+pub fn ifft_in_place(buffer: &mut [Complex]) {
+    if buffer.is_empty() {
+        return;
+    }
+    let n = buffer.len();
+    let fft = fft_plan(n, FftDirection::Inverse);
+    process(fft.as_ref(), as_complex64_mut(buffer));
+
+    // Scale by 1/N
+    let scale = 1.0 / (n as f64);
+    for x in buffer.iter_mut() {
+        x.re *= scale;
+        x.im *= scale;
+    }
 }
 
 /// Fast Fourier Transform
@@ -42,14 +177,9 @@ fn from_complex64(input: &[Complex64]) -> Vec<Complex> {
 /// let spectrum = fft_transform(&signal);
 /// ```
 pub fn fft_transform(input: &[Complex]) -> Vec<Complex> {
-    let mut buffer = to_complex64(input);
-    
-    let mut planner = FftPlanner::new();
-    let fft = planner.plan_fft_forward(buffer.len());
-    
-    fft.process(&mut buffer);
-    
-    from_complex64(&buffer)
+    let mut buffer = input.to_vec();
+    fft_in_place(&mut buffer);
+    buffer
 }
 
 /// Inverse Fast Fourier Transform
@@ -79,26 +209,15 @@ pub fn fft_transform(input: &[Complex]) -> Vec<Complex> {
 /// // reconstructed should be close to signal
 /// ```
 pub fn ifft_transform(input: &[Complex]) -> Vec<Complex> {
-    let mut buffer = to_complex64(input);
-    let n = buffer.len();
-    
-    let mut planner = FftPlanner::new();
-    let fft = planner.plan_fft_inverse(n);
-    
-    fft.process(&mut buffer);
-    
-    // Scale by 1/N
-    let scale = 1.0 / (n as f64);
-    for x in &mut buffer {
-        *x *= scale;
-    }
-    
-    from_complex64(&buffer)
+    let mut buffer = input.to_vec();
+    ifft_in_place(&mut buffer);
+    buffer
 }
 
 /// FFT for real-valued signals
 ///
-/// Convenience function that converts real vector to complex and computes FFT.
+/// Computes the full N-bin spectrum from the half spectrum of [`rfft`],
+/// mirroring the upper bins by conjugate symmetry.
 ///
 /// # Arguments
 /// * `input` - Real-valued signal (slice)
@@ -114,12 +233,14 @@ pub fn ifft_transform(input: &[Complex]) -> Vec<Complex> {
 /// let spectrum = fft_real(&signal);
 /// ```
 pub fn fft_real(input: &[f64]) -> Vec<Complex> {
-    let complex_input: Vec<Complex> = input
-        .iter()
-        .map(|&x| Complex::new(x, 0.0))
-        .collect();
-
-    fft_transform(&complex_input)
+    let n = input.len();
+    let mut spectrum = rfft(input);
+    spectrum.reserve(n - spectrum.len());
+    for k in spectrum.len()..n {
+        let mirrored = spectrum[n - k].conjugate();
+        spectrum.push(mirrored);
+    }
+    spectrum
 }
 
 /// Inverse FFT returning real part only
@@ -145,6 +266,172 @@ pub fn ifft_real(input: &[Complex]) -> Vec<f64> {
     result.iter().map(|c| c.re).collect()
 }
 
+// ============================================================================
+// Real-input transforms (R2C / C2R)
+// ============================================================================
+
+/// Real-to-complex FFT returning the half spectrum
+///
+/// For a real signal of length N, returns bins 0..=N/2 (N/2 + 1 values);
+/// the remaining bins are their complex conjugates. Even lengths run a
+/// single complex FFT of length N/2 over the packed samples.
+///
+/// # Example
+/// ```
+/// use achronyme_dsp::rfft;
+///
+/// let spectrum = rfft(&[1.0, 2.0, 3.0, 4.0]);
+/// assert_eq!(spectrum.len(), 3);
+/// assert_eq!(spectrum[0].re, 10.0);
+/// ```
+pub fn rfft(input: &[f64]) -> Vec<Complex> {
+    let n = input.len();
+    if n == 0 {
+        return Vec::new();
+    }
+    if n % 2 == 1 {
+        let mut buffer: Vec<Complex> = input.iter().map(|&x| Complex::from_real(x)).collect();
+        fft_in_place(&mut buffer);
+        buffer.truncate(n / 2 + 1);
+        return buffer;
+    }
+
+    let mut spectrum = vec![Complex::new(0.0, 0.0); n / 2 + 1];
+    rfft_even(&real_plan(n), input, &mut spectrum);
+    spectrum
+}
+
+/// Real-to-complex FFT into a caller-provided half spectrum
+///
+/// Same result as [`rfft`], written to `output`, which must hold
+/// `input.len() / 2 + 1` bins. Even lengths do not allocate: the packed
+/// samples are transformed inside `output` itself.
+///
+/// # Example
+/// ```
+/// use achronyme_dsp::{rfft, rfft_into};
+/// use achronyme_types::complex::Complex;
+///
+/// let signal = [1.0, 2.0, 3.0, 4.0];
+/// let mut spectrum = [Complex::new(0.0, 0.0); 3];
+/// rfft_into(&signal, &mut spectrum).unwrap();
+/// assert_eq!(spectrum.to_vec(), rfft(&signal));
+/// ```
+pub fn rfft_into(input: &[f64], output: &mut [Complex]) -> Result<(), String> {
+    let n = input.len();
+    if output.len() != n / 2 + 1 {
+        return Err(format!(
+            "rfft: a signal of length {} has {} spectrum bins, got room for {}",
+            n,
+            n / 2 + 1,
+            output.len()
+        ));
+    }
+    if n == 0 {
+        return Ok(());
+    }
+    if n % 2 == 1 {
+        output.copy_from_slice(&rfft(input));
+    } else {
+        rfft_even(&real_plan(n), input, output);
+    }
+    Ok(())
+}
+
+/// Real FFT of even length n = input.len() into n/2 + 1 bins, in place
+pub(crate) fn rfft_even(plan: &RealPlan, input: &[f64], output: &mut [Complex]) {
+    let half = input.len() / 2;
+    debug_assert_eq!(output.len(), half + 1);
+
+    // Pack x[2k] + i*x[2k+1] and transform at half length
+    for (slot, pair) in output[..half].iter_mut().zip(input.chunks_exact(2)) {
+        *slot = Complex::new(pair[0], pair[1]);
+    }
+    process(plan.forward.as_ref(), as_complex64_mut(&mut output[..half]));
+
+    // Split the even/odd spectra: X[k] = E[k] + W^k O[k]. Bins k and
+    // half - k are built from the same two packed values, so each pair is
+    // read before either is overwritten
+    let z0 = output[0];
+    output[0] = Complex::new(z0.re + z0.im, 0.0);
+    output[half] = Complex::new(z0.re - z0.im, 0.0);
+    for k in 1..=half / 2 {
+        let j = half - k;
+        let zk = Complex64::new(output[k].re, output[k].im);
+        let zj = Complex64::new(output[j].re, output[j].im);
+        output[k] = split_bin(zk, zj, plan.twiddles[k]);
+        output[j] = split_bin(zj, zk, plan.twiddles[j]);
+    }
+}
+
+/// Bin k of a real spectrum from packed values z = Z[k] and mirror = Z[half - k]
+fn split_bin(z: Complex64, mirror: Complex64, twiddle: Complex64) -> Complex {
+    let zc = mirror.conj();
+    let even = (z + zc) * 0.5;
+    let odd = (z - zc) * Complex64::new(0.0, -0.5);
+    let x = even + twiddle * odd;
+    Complex::new(x.re, x.im)
+}
+
+/// Complex-to-real inverse FFT of a half spectrum
+///
+/// Inverse of [`rfft`]: takes the N/2 + 1 bins of a real signal of length
+/// `n` and returns the signal, scaled by 1/N.
+///
+/// # Example
+/// ```
+/// use achronyme_dsp::{rfft, irfft};
+///
+/// let signal = vec![1.0, 2.0, 3.0, 4.0, 5.0];
+/// let reconstructed = irfft(&rfft(&signal), signal.len()).unwrap();
+/// assert!((reconstructed[4] - 5.0).abs() < 1e-10);
+/// ```
+pub fn irfft(spectrum: &[Complex], n: usize) -> Result<Vec<f64>, String> {
+    if spectrum.len() != n / 2 + 1 {
+        return Err(format!(
+            "irfft: a signal of length {} needs {} spectrum bins, got {}",
+            n,
+            n / 2 + 1,
+            spectrum.len()
+        ));
+    }
+    if n == 0 {
+        return Ok(Vec::new());
+    }
+    if n % 2 == 1 {
+        let mut buffer = spectrum.to_vec();
+        for k in buffer.len()..n {
+            let mirrored = buffer[n - k].conjugate();
+            buffer.push(mirrored);
+        }
+        ifft_in_place(&mut buffer);
+        return Ok(buffer.iter().map(|c| c.re).collect());
+    }
+
+    let half = n / 2;
+    let plan = real_plan(n);
+
+    // Rebuild Z[k] = E[k] + i*O[k] from the half spectrum
+    let mut packed: Vec<Complex64> = (0..half)
+        .map(|k| {
+            let x = Complex64::new(spectrum[k].re, spectrum[k].im);
+            let xc = Complex64::new(spectrum[half - k].re, -spectrum[half - k].im);
+            let even = (x + xc) * 0.5;
+            let odd = (x - xc) * plan.twiddles[k].conj() * 0.5;
+            even + Complex64::new(0.0, 1.0) * odd
+        })
+        .collect();
+    process(plan.inverse.as_ref(), &mut packed);
+
+    let scale = 1.0 / half as f64;
+    let mut signal = Vec::with_capacity(n);
+    for z in &packed {
+        signal.push(z.re * scale);
+        signal.push(z.im * scale);
+    }
+    Ok(signal)
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -231,4 +518,73 @@ mod tests {
         // For freq=2, peak should be at bin 2
         assert_eq!(peak_idx, 2);
     }
+
+    #[test]
+    fn test_rfft_matches_complex_fft() {
+        for n in [1, 2, 7, 8, 12, 15] {
+            let signal: Vec<f64> = (0..n).map(|i| ((i * 7 % 5) as f64) - 1.5).collect();
+            let complex: Vec<Complex> = signal.iter().map(|&x| Complex::from_real(x)).collect();
+            let full = fft_transform(&complex);
+
+            let half = rfft(&signal);
+            assert_eq!(half.len(), n / 2 + 1);
+            for (a, b) in half.iter().zip(full.iter()) {
+                assert_relative_eq!(a.re, b.re, epsilon = 1e-9);
+                assert_relative_eq!(a.im, b.im, epsilon = 1e-9);
+            }
+
+            let mirrored = fft_real(&signal);
+            assert_eq!(mirrored.len(), n);
+            for (a, b) in mirrored.iter().zip(full.iter()) {
+                assert_relative_eq!(a.re, b.re, epsilon = 1e-9);
+                assert_relative_eq!(a.im, b.im, epsilon = 1e-9);
+            }
+        }
+    }
+
+    #[test]
+    fn test_rfft_irfft_roundtrip() {
+        for n in [1, 2, 6, 9, 16] {
+            let signal: Vec<f64> = (0..n).map(|i| (i as f64 * 0.3).sin() + 0.25).collect();
+            let reconstructed = irfft(&rfft(&signal), n).unwrap();
+
+            assert_eq!(reconstructed.len(), n);
+            for (orig, recon) in signal.iter().zip(reconstructed.iter()) {
+                assert_relative_eq!(*orig, *recon, epsilon = 1e-9);
+            }
+        }
+    }
+
+    #[test]
+    fn test_irfft_rejects_wrong_bin_count() {
+        let spectrum = rfft(&[1.0, 2.0, 3.0, 4.0]);
+        assert!(irfft(&spectrum, 8).is_err());
+        assert!(irfft(&[], 0).is_err());
+        assert_eq!(irfft(&[Complex::new(2.0, 0.0)], 1).unwrap(), vec![2.0]);
+    }
+
+    #[test]
+    fn test_in_place_matches_transform() {
+        let signal: Vec<Complex> = (0..6).map(|i| Complex::new(i as f64, -(i as f64) / 2.0)).collect();
+        let mut buffer = signal.clone();
+        fft_in_place(&mut buffer);
+        assert_eq!(buffer, fft_transform(&signal));
+
+        ifft_in_place(&mut buffer);
+        for (orig, recon) in signal.iter().zip(buffer.iter()) {
+            assert_relative_eq!(orig.re, recon.re, epsilon = 1e-10);
+            assert_relative_eq!(orig.im, recon.im, epsilon = 1e-10);
+        }
+    }
+
+    #[test]
+    fn test_plans_are_cached() {
+        let a = fft_plan(48, FftDirection::Forward);
+        let b = fft_plan(48, FftDirection::Forward);
+        let c = fft_plan(48, FftDirection::Inverse);
+
+        assert!(Arc::ptr_eq(&a, &b));
+        assert!(!Arc::ptr_eq(&a, &c));
+        assert!(Arc::ptr_eq(&real_plan(48), &real_plan(48)));
+    }
 }
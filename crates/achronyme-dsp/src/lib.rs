@@ -3,16 +3,23 @@
 //! Provides DSP operations using rustfft:
 //! - Fast Fourier Transform (FFT)
 //! - Inverse FFT
-//! - Convolution
+//! - Real-input FFT (half spectrum) and its inverse
+//! - Convolution (direct, vectorized, block FFT) and streaming FIR filters
 //! - Windowing functions
+//! - Short-time Fourier transform (STFT / ISTFT / spectrogram)
 //!
 //! Phase 3 of the Rust refactor
 
 pub mod fft;
 pub mod convolution;
+pub mod streaming;
 pub mod windows;
+pub mod stft;
 
 // Re-exports for convenience
-pub use fft::{fft_transform, ifft_transform, fft_real, ifft_real};
-pub use convolution::{convolve, convolve_fft};
-pub use windows::{hanning_window, hamming_window, blackman_window, rectangular_window, apply_window};
+pub use fft::{fft_transform, ifft_transform, fft_real, ifft_real, fft_in_place, ifft_in_place, rfft, rfft_into, irfft, fft_plan};
+pub use fft::{as_complex64, as_complex64_mut, from_complex64, from_complex64_mut};
+pub use convolution::{convolve, convolve_simd, convolve_fft, convolve_auto, ConvolutionMethod};
+pub use streaming::{BlockConvolver, FirFilter};
+pub use windows::{hanning_window, hamming_window, blackman_window, rectangular_window, apply_window, WindowKind};
+pub use stft::{stft, istft, spectrogram, Stft};
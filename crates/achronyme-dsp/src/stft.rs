@@ -0,0 +1,470 @@
+//! Short-time Fourier transform
+//!
+//! [`Stft`] holds what every frame shares (the window, the hop and the
+//! real FFT plan), so analysing a signal is a single pass: each frame is
+//! windowed into a per-thread buffer and transformed straight into its row
+//! of a preallocated `[frames, bins]` spectrum. Frames are independent and
+//! are spread across threads for large inputs.
+//!
+//! Frame f covers samples f·hop .. f·hop + frame_len, the last one
+//! zero-padded; there are `frame_len / 2 + 1` bins per frame. The inverse
+//! is a weighted overlap-add, exact wherever the windows covering a sample
+//! are not all zero.
+
+use std::borrow::Cow;
+use std::sync::Arc;
+
+use crate::fft::{irfft, real_plan, rfft_even, rfft_into, RealPlan};
+use crate::windows::WindowKind;
+use achronyme_types::complex::Complex;
+use achronyme_types::tensor::{ComplexTensor, RealTensor};
+
+/// Frames × frame length below which framing stays on the calling thread
+const PARALLEL_MIN_WORK: usize = 1 << 16;
+
+/// Overlap-add weights below this are treated as "no window covers the sample"
+const MIN_WINDOW_WEIGHT: f64 = 1e-12;
+
+/// Reusable STFT configuration: window, hop size and FFT plan
+#[derive(Clone)]
+pub struct Stft {
+    window: Vec<f64>,
+    hop: usize,
+    /// Real FFT plan, for even frame lengths
+    plan: Option<Arc<RealPlan>>,
+}
+
+impl Stft {
+    /// STFT with frames of `frame_len` samples every `hop` samples
+    ///
+    /// # Example
+    /// ```
+    /// use achronyme_dsp::{Stft, WindowKind};
+    ///
+    /// let stft = Stft::new(256, 64, WindowKind::Hanning).unwrap();
+    /// let signal: Vec<f64> = (0..4096).map(|i| (i as f64 * 0.2).sin()).collect();
+    ///
+    /// let spectrum = stft.transform(&signal);
+    /// assert_eq!(spectrum.shape(), &[61, 129]);
+    /// ```
+    pub fn new(frame_len: usize, hop: usize, window: WindowKind) -> Result<Self, String> {
+        Self::with_window(window.generate(frame_len), hop)
+    }
+
+    /// STFT with a custom window; the frame length is the window length
+    pub fn with_window(window: Vec<f64>, hop: usize) -> Result<Self, String> {
+        if window.is_empty() {
+            return Err("STFT: the frame length must be at least 1".to_string());
+        }
+        if hop == 0 {
+            return Err("STFT: the hop size must be at least 1".to_string());
+        }
+        let plan = (window.len() % 2 == 0).then(|| real_plan(window.len()));
+        Ok(Self { window, hop, plan })
+    }
+
+    /// Samples per frame
+    pub fn frame_len(&self) -> usize {
+        self.window.len()
+    }
+
+    /// Samples between the starts of consecutive frames
+    pub fn hop(&self) -> usize {
+        self.hop
+    }
+
+    /// Spectrum bins per frame
+    pub fn bins(&self) -> usize {
+        self.frame_len() / 2 + 1
+    }
+
+    pub fn window(&self) -> &[f64] {
+        &self.window
+    }
+
+    /// Frames needed to cover `samples` samples
+    pub fn frame_count(&self, samples: usize) -> usize {
+        if samples == 0 {
+            0
+        } else if samples <= self.frame_len() {
+            1
+        } else {
+            1 + (samples - self.frame_len()).div_ceil(self.hop)
+        }
+    }
+
+    /// Length of the signal an overlap-add of `frames` frames spans
+    pub fn signal_len(&self, frames: usize) -> usize {
+        match frames {
+            0 => 0,
+            _ => (frames - 1) * self.hop + self.frame_len(),
+        }
+    }
+
+    /// Spectrum of `signal` as a `[frames, bins]` tensor
+    pub fn transform(&self, signal: &[f64]) -> ComplexTensor {
+        let frames = self.frame_count(signal.len());
+        let mut output = vec![Complex::new(0.0, 0.0); frames * self.bins()];
+        self.frames_into(&[signal], frames, &mut output);
+        ComplexTensor::new(output, vec![frames, self.bins()]).expect("frames × bins elements")
+    }
+
+    /// Spectrum of `signal` written into `output`, which must hold
+    /// `frame_count(signal.len()) · bins()` values (row-major `[frames, bins]`)
+    pub fn transform_into(&self, signal: &[f64], output: &mut [Complex]) -> Result<(), String> {
+        let frames = self.frame_count(signal.len());
+        if output.len() != frames * self.bins() {
+            return Err(format!(
+                "STFT: {} frames of {} bins need {} values, got room for {}",
+                frames,
+                self.bins(),
+                frames * self.bins(),
+                output.len()
+            ));
+        }
+        self.frames_into(&[signal], frames, output);
+        Ok(())
+    }
+
+    /// Spectra of equal-length channels as a `[channels, frames, bins]` tensor
+    pub fn transform_channels(&self, channels: &[&[f64]]) -> Result<ComplexTensor, String> {
+        let samples = channels.first().map_or(0, |channel| channel.len());
+        if channels.iter().any(|channel| channel.len() != samples) {
+            return Err("STFT: every channel must have the same length".to_string());
+        }
+
+        let frames = self.frame_count(samples);
+        let mut output = vec![Complex::new(0.0, 0.0); channels.len() * frames * self.bins()];
+        self.frames_into(channels, frames, &mut output);
+        ComplexTensor::new(output, vec![channels.len(), frames, self.bins()]).map_err(|e| e.to_string())
+    }
+
+    /// Signal rebuilt from a row-major `[frames, bins]` spectrum by weighted
+    /// overlap-add, truncated or zero-padded to `len` (default: the
+    /// `signal_len` of the frames)
+    ///
+    /// # Example
+    /// ```
+    /// use achronyme_dsp::{Stft, WindowKind};
+    ///
+    /// let stft = Stft::new(64, 16, WindowKind::Hamming).unwrap();
+    /// let signal: Vec<f64> = (0..500).map(|i| (i as f64 * 0.05).cos()).collect();
+    ///
+    /// let spectrum = stft.transform(&signal);
+    /// let frames = spectrum.shape()[0];
+    /// let rebuilt = stft.inverse(spectrum.data(), frames, Some(signal.len())).unwrap();
+    /// assert!((rebuilt[250] - signal[250]).abs() < 1e-9);
+    /// ```
+    pub fn inverse(&self, spectrum: &[Complex], frames: usize, len: Option<usize>) -> Result<Vec<f64>, String> {
+        let bins = self.bins();
+        if spectrum.len() != frames * bins {
+            return Err(format!(
+                "ISTFT: {} frames of {} bins need {} values, got {}",
+                frames,
+                bins,
+                frames * bins,
+                spectrum.len()
+            ));
+        }
+
+        let span = self.signal_len(frames);
+        let mut signal = vec![0.0; span];
+        let mut weight = vec![0.0; span];
+        for (f, row) in spectrum.chunks_exact(bins).enumerate() {
+            let frame = irfft(row, self.frame_len())?;
+            let start = f * self.hop;
+            let covered = signal[start..start + self.frame_len()].iter_mut().zip(&mut weight[start..]);
+            for ((x, total), (y, w)) in covered.zip(frame.iter().zip(&self.window)) {
+                *x += w * y;
+                *total += w * w;
+            }
+        }
+        for (x, total) in signal.iter_mut().zip(&weight) {
+            if *total > MIN_WINDOW_WEIGHT {
+                *x /= total;
+            }
+        }
+
+        signal.resize(len.unwrap_or(span), 0.0);
+        Ok(signal)
+    }
+
+    /// Transform every frame of every channel into `output`, one
+    /// `bins()`-value row per (channel, frame) in row-major order
+    fn frames_into(&self, channels: &[&[f64]], frames: usize, output: &mut [Complex]) {
+        let bins = self.bins();
+        let rows = channels.len() * frames;
+        if rows == 0 {
+            return;
+        }
+
+        let threads = if rows.saturating_mul(self.frame_len()) >= PARALLEL_MIN_WORK {
+            std::thread::available_parallelism().map_or(1, |t| t.get()).min(rows)
+        } else {
+            1
+        };
+
+        let run = |first: usize, chunk: &mut [Complex]| {
+            let mut buffer = vec![0.0; self.frame_len()];
+            for (offset, row) in chunk.chunks_exact_mut(bins).enumerate() {
+                let index = first + offset;
+                self.frame_into(channels[index / frames], index % frames, &mut buffer, row);
+            }
+        };
+
+        if threads <= 1 {
+            run(0, output);
+            return;
+        }
+
+        let per_thread = rows.div_ceil(threads);
+        std::thread::scope(|scope| {
+            for (panel, chunk) in output.chunks_mut(per_thread * bins).enumerate() {
+                let run = &run;
+                scope.spawn(move || run(panel * per_thread, chunk));
+            }
+        });
+    }
+
+    /// Window frame `frame` of `signal` into `buffer` and transform it into `row`
+    fn frame_into(&self, signal: &[f64], frame: usize, buffer: &mut [f64], row: &mut [Complex]) {
+        let start = frame * self.hop;
+        let samples = &signal[start.min(signal.len())..];
+        let available = samples.len().min(buffer.len());
+
+        for ((out, x), w) in buffer.iter_mut().zip(samples).zip(&self.window) {
+            *out = x * w;
+        }
+        buffer[available..].fill(0.0);
+
+        match &self.plan {
+            Some(plan) => rfft_even(plan, buffer, row),
+            None => rfft_into(buffer, row).expect("row holds frame_len / 2 + 1 bins"),
+        }
+    }
+}
+
+/// Channels of a signal tensor as contiguous slices
+///
+/// A vector is a single channel. A matrix has one channel per row when
+/// `channel_axis` is 0 and one per column when it is 1 (columns are
+/// gathered into owned buffers).
+fn channels(signal: &RealTensor, channel_axis: usize) -> Result<Vec<Cow<'_, [f64]>>, String> {
+    if signal.is_vector() {
+        return Ok(vec![Cow::Borrowed(signal.data())]);
+    }
+    if !signal.is_matrix() {
+        return Err(format!(
+            "STFT requires a vector or a [channels, samples] matrix, got a rank-{} tensor",
+            signal.rank()
+        ));
+    }
+
+    let (rows, cols) = (signal.rows(), signal.cols());
+    match channel_axis {
+        0 => Ok(signal.data().chunks_exact(cols.max(1)).take(rows).map(Cow::Borrowed).collect()),
+        1 => Ok((0..cols)
+            .map(|c| Cow::Owned(signal.data().iter().skip(c).step_by(cols).copied().collect()))
+            .collect()),
+        _ => Err(format!("STFT: channel axis must be 0 or 1, got {}", channel_axis)),
+    }
+}
+
+/// Short-time Fourier transform of a signal tensor
+///
+/// A vector gives a `[frames, bins]` spectrum; a matrix of channels (along
+/// `channel_axis`) gives `[channels, frames, bins]`.
+///
+/// # Example
+/// ```
+/// use achronyme_dsp::{stft, WindowKind};
+/// use achronyme_types::tensor::RealTensor;
+///
+/// let stereo = RealTensor::matrix(2, 1000, vec![0.5; 2000]).unwrap();
+/// let spectrum = stft(&stereo, 128, 32, WindowKind::Hanning, 0).unwrap();
+/// assert_eq!(spectrum.shape(), &[2, 29, 65]);
+/// ```
+pub fn stft(
+    signal: &RealTensor,
+    frame_len: usize,
+    hop: usize,
+    window: WindowKind,
+    channel_axis: usize,
+) -> Result<ComplexTensor, String> {
+    let stft = Stft::new(frame_len, hop, window)?;
+    if signal.is_vector() {
+        return Ok(stft.transform(signal.data()));
+    }
+    let channels = channels(signal, channel_axis)?;
+    let slices: Vec<&[f64]> = channels.iter().map(|channel| channel.as_ref()).collect();
+    stft.transform_channels(&slices)
+}
+
+/// Power spectrogram |STFT|², with the shape [`stft`] returns
+pub fn spectrogram(
+    signal: &RealTensor,
+    frame_len: usize,
+    hop: usize,
+    window: WindowKind,
+    channel_axis: usize,
+) -> Result<RealTensor, String> {
+    let spectrum = stft(signal, frame_len, hop, window, channel_axis)?;
+    Ok(spectrum.norm_sqr())
+}
+
+/// Inverse short-time Fourier transform
+///
+/// Takes a `[frames, bins]` spectrum (returning a vector) or
+/// `[channels, frames, bins]` (returning a `[channels, samples]` matrix),
+/// with the frame length, hop and window used for the forward transform.
+/// `len` trims or pads the output to the original signal length.
+pub fn istft(
+    spectrum: &ComplexTensor,
+    frame_len: usize,
+    hop: usize,
+    window: WindowKind,
+    len: Option<usize>,
+) -> Result<RealTensor, String> {
+    let stft = Stft::new(frame_len, hop, window)?;
+    let (channels, frames, bins) = match spectrum.shape() {
+        [frames, bins] => (None, *frames, *bins),
+        [channels, frames, bins] => (Some(*channels), *frames, *bins),
+        shape => {
+            return Err(format!(
+                "ISTFT requires a [frames, bins] or [channels, frames, bins] tensor, got shape {:?}",
+                shape
+            ))
+        }
+    };
+    if bins != stft.bins() {
+        return Err(format!(
+            "ISTFT: a frame length of {} has {} bins, the spectrum has {}",
+            frame_len,
+            stft.bins(),
+            bins
+        ));
+    }
+
+    match channels {
+        None => Ok(RealTensor::vector(stft.inverse(spectrum.data(), frames, len)?)),
+        Some(channels) => {
+            let samples = len.unwrap_or(stft.signal_len(frames));
+            let mut data = Vec::with_capacity(channels * samples);
+            for channel in spectrum.data().chunks_exact((frames * bins).max(1)).take(channels) {
+                data.extend(stft.inverse(channel, frames, Some(samples))?);
+            }
+            data.resize(channels * samples, 0.0);
+            RealTensor::matrix(channels, samples, data).map_err(|e| e.to_string())
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::fft::rfft;
+    use approx::assert_relative_eq;
+
+    fn signal(n: usize) -> Vec<f64> {
+        (0..n).map(|i| (i as f64 * 0.13).sin() + 0.4 * (i as f64 * 0.71).cos()).collect()
+    }
+
+    #[test]
+    fn test_frames_match_windowed_rfft() {
+        // Even (planned) and odd frame lengths, including a final partial frame
+        for frame_len in [16, 15] {
+            let x = signal(100);
+            let stft = Stft::new(frame_len, 6, WindowKind::Hanning).unwrap();
+            let spectrum = stft.transform(&x);
+            let frames = stft.frame_count(x.len());
+            assert_eq!(spectrum.shape(), &[frames, frame_len / 2 + 1]);
+
+            for f in 0..frames {
+                let mut frame = vec![0.0; frame_len];
+                for i in 0..frame_len {
+                    frame[i] = x.get(f * 6 + i).copied().unwrap_or(0.0) * stft.window()[i];
+                }
+                let expected = rfft(&frame);
+                let row = &spectrum.data()[f * stft.bins()..(f + 1) * stft.bins()];
+                for (a, b) in row.iter().zip(&expected) {
+                    assert_relative_eq!(a.re, b.re, epsilon = 1e-9);
+                    assert_relative_eq!(a.im, b.im, epsilon = 1e-9);
+                }
+            }
+        }
+    }
+
+    #[test]
+    fn test_frame_count() {
+        let stft = Stft::new(8, 4, WindowKind::Rectangular).unwrap();
+        assert_eq!(stft.frame_count(0), 0);
+        assert_eq!(stft.frame_count(3), 1);
+        assert_eq!(stft.frame_count(8), 1);
+        assert_eq!(stft.frame_count(9), 2);
+        assert_eq!(stft.frame_count(16), 3);
+        assert_eq!(stft.signal_len(3), 16);
+        assert!(Stft::new(8, 0, WindowKind::Hanning).is_err());
+        assert!(Stft::new(0, 4, WindowKind::Hanning).is_err());
+    }
+
+    #[test]
+    fn test_inverse_reconstructs_signal() {
+        let x = signal(1000);
+        for (frame_len, hop, window) in [(64, 16, WindowKind::Hamming), (33, 11, WindowKind::Blackman), (50, 50, WindowKind::Rectangular)] {
+            let stft = Stft::new(frame_len, hop, window).unwrap();
+            let spectrum = stft.transform(&x);
+            let rebuilt = stft.inverse(spectrum.data(), spectrum.shape()[0], Some(x.len())).unwrap();
+
+            assert_eq!(rebuilt.len(), x.len());
+            // Blackman is zero at its ends, so the very first sample is lost
+            for (a, b) in rebuilt.iter().zip(&x).skip(1) {
+                assert_relative_eq!(*a, *b, epsilon = 1e-8);
+            }
+        }
+    }
+
+    #[test]
+    fn test_transform_into_checks_size() {
+        let stft = Stft::new(8, 4, WindowKind::Hanning).unwrap();
+        let mut output = vec![Complex::new(0.0, 0.0); 2 * 5];
+        assert!(stft.transform_into(&signal(12), &mut output).is_ok());
+        assert!(stft.transform_into(&signal(13), &mut output).is_err());
+    }
+
+    #[test]
+    fn test_multi_channel_axes() {
+        let left = signal(300);
+        let right: Vec<f64> = left.iter().map(|x| -2.0 * x).collect();
+
+        let rows = RealTensor::matrix(2, 300, [left.clone(), right.clone()].concat()).unwrap();
+        let interleaved: Vec<f64> = left.iter().zip(&right).flat_map(|(l, r)| [*l, *r]).collect();
+        let cols = RealTensor::matrix(300, 2, interleaved).unwrap();
+
+        let by_rows = stft(&rows, 32, 8, WindowKind::Hanning, 0).unwrap();
+        let by_cols = stft(&cols, 32, 8, WindowKind::Hanning, 1).unwrap();
+        assert_eq!(by_rows.shape(), &[2, 35, 17]);
+        assert_eq!(by_rows.data(), by_cols.data());
+
+        // Each channel equals its single-channel transform
+        let single = stft(&RealTensor::vector(right.clone()), 32, 8, WindowKind::Hanning, 0).unwrap();
+        assert_eq!(&by_rows.data()[35 * 17..], single.data());
+
+        let rebuilt = istft(&by_rows, 32, 8, WindowKind::Hanning, Some(300)).unwrap();
+        assert_eq!(rebuilt.shape(), &[2, 300]);
+        assert_relative_eq!(rebuilt.data()[300 + 150], right[150], epsilon = 1e-9);
+
+        assert!(stft(&rows, 32, 8, WindowKind::Hanning, 2).is_err());
+        assert!(istft(&by_rows, 30, 8, WindowKind::Hanning, None).is_err());
+    }
+
+    #[test]
+    fn test_spectrogram_is_power() {
+        let x = RealTensor::vector(signal(200));
+        let spectrum = stft(&x, 20, 10, WindowKind::Hamming, 0).unwrap();
+        let power = spectrogram(&x, 20, 10, WindowKind::Hamming, 0).unwrap();
+        assert_eq!(power.shape(), spectrum.shape());
+        for (p, z) in power.data().iter().zip(spectrum.data()) {
+            assert_relative_eq!(*p, z.magnitude() * z.magnitude(), epsilon = 1e-9);
+        }
+    }
+}
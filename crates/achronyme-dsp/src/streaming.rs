@@ -0,0 +1,273 @@
+//! Block and streaming FIR convolution
+//!
+//! [`BlockConvolver`] transforms its kernel once and convolves signals of
+//! any length by overlap-add: the signal is cut into blocks of
+//! `fft_len - kernel_len + 1` samples, each block is multiplied by the
+//! cached kernel spectrum, and the overlapping block outputs are summed.
+//! Memory is O(fft_len) whatever the signal length.
+//!
+//! [`FirFilter`] keeps the overlap between calls, so a stream fed in chunks
+//! of any size produces exactly the samples of one convolution over the
+//! concatenated stream.
+
+use crate::convolution::{convolve_simd, optimal_fft_len};
+use crate::fft::{irfft, rfft};
+use achronyme_types::complex::Complex;
+use achronyme_types::tensor::complex_kernels;
+
+/// Overlap-add FFT convolver with a precomputed kernel spectrum
+#[derive(Debug, Clone)]
+pub struct BlockConvolver {
+    kernel_len: usize,
+    fft_len: usize,
+    /// Half spectrum of the kernel zero-padded to `fft_len`
+    spectrum: Vec<Complex>,
+}
+
+impl BlockConvolver {
+    /// Build a convolver for `kernel`, with the FFT length that needs the
+    /// fewest transform operations per output sample
+    ///
+    /// # Example
+    /// ```
+    /// use achronyme_dsp::{convolve, BlockConvolver};
+    ///
+    /// let kernel = vec![0.25, 0.5, 0.25];
+    /// let convolver = BlockConvolver::new(&kernel).unwrap();
+    ///
+    /// let signal: Vec<f64> = (0..1000).map(|i| (i as f64 * 0.1).sin()).collect();
+    /// let fast = convolver.convolve(&signal);
+    /// let direct = convolve(&signal, &kernel);
+    /// assert!((fast[500] - direct[500]).abs() < 1e-10);
+    /// ```
+    pub fn new(kernel: &[f64]) -> Result<Self, String> {
+        Self::with_fft_len(kernel, optimal_fft_len(kernel.len()))
+    }
+
+    /// Build a convolver that transforms blocks of exactly `fft_len`
+    /// samples, which must be at least `kernel.len()`
+    pub fn with_fft_len(kernel: &[f64], fft_len: usize) -> Result<Self, String> {
+        if kernel.is_empty() {
+            return Err("BlockConvolver: the kernel must not be empty".to_string());
+        }
+        if fft_len < kernel.len() {
+            return Err(format!(
+                "BlockConvolver: FFT length {} is shorter than the {}-tap kernel",
+                fft_len,
+                kernel.len()
+            ));
+        }
+
+        let mut padded = kernel.to_vec();
+        padded.resize(fft_len, 0.0);
+        Ok(Self { kernel_len: kernel.len(), fft_len, spectrum: rfft(&padded) })
+    }
+
+    /// Number of kernel taps
+    pub fn kernel_len(&self) -> usize {
+        self.kernel_len
+    }
+
+    /// Length of each transform
+    pub fn fft_len(&self) -> usize {
+        self.fft_len
+    }
+
+    /// Input samples consumed per transform
+    pub fn block_len(&self) -> usize {
+        self.fft_len - self.kernel_len + 1
+    }
+
+    /// Full convolution of `signal` with the kernel
+    /// (length = signal.len() + kernel_len - 1)
+    pub fn convolve(&self, signal: &[f64]) -> Vec<f64> {
+        if signal.is_empty() {
+            return Vec::new();
+        }
+        let mut output = vec![0.0; signal.len() + self.kernel_len - 1];
+        self.convolve_add(signal, &mut output);
+        output
+    }
+
+    /// Add the full convolution of `signal` to the start of `output`, which
+    /// must hold at least signal.len() + kernel_len - 1 samples
+    fn convolve_add(&self, signal: &[f64], output: &mut [f64]) {
+        let block_len = self.block_len();
+        let mut block = vec![0.0; self.fft_len];
+
+        for (index, segment) in signal.chunks(block_len).enumerate() {
+            block[..segment.len()].copy_from_slice(segment);
+            block[segment.len()..].fill(0.0);
+
+            let mut spectrum = rfft(&block);
+            complex_kernels::mul_assign(&mut spectrum, &self.spectrum);
+            let filtered = irfft(&spectrum, self.fft_len).expect("rfft returns fft_len / 2 + 1 bins");
+
+            // Overlap-add: this block's output spills kernel_len - 1 samples
+            // into the next one
+            let start = index * block_len;
+            let len = segment.len() + self.kernel_len - 1;
+            for (out, y) in output[start..start + len].iter_mut().zip(&filtered) {
+                *out += y;
+            }
+        }
+    }
+}
+
+/// Stateful FIR filter for signals that arrive in chunks
+///
+/// Each call to [`process`](FirFilter::process) returns as many samples as
+/// it was given: outputs are causal, y[i] = Σ h[k]·x[i - k] over the whole
+/// stream so far. [`flush`](FirFilter::flush) returns the kernel_len - 1
+/// samples still ringing once the stream ends.
+///
+/// # Example
+/// ```
+/// use achronyme_dsp::{convolve, FirFilter};
+///
+/// let kernel = vec![0.5, 0.3, 0.2];
+/// let signal: Vec<f64> = (0..100).map(|i| i as f64).collect();
+///
+/// let mut filter = FirFilter::new(&kernel).unwrap();
+/// let mut streamed = Vec::new();
+/// for chunk in signal.chunks(7) {
+///     streamed.extend(filter.process(chunk));
+/// }
+/// streamed.extend(filter.flush());
+///
+/// let whole = convolve(&signal, &kernel);
+/// assert_eq!(streamed.len(), whole.len());
+/// assert!((streamed[50] - whole[50]).abs() < 1e-10);
+/// ```
+#[derive(Debug, Clone)]
+pub struct FirFilter {
+    kernel: Vec<f64>,
+    convolver: BlockConvolver,
+    /// Contributions of past samples to the next kernel_len - 1 outputs
+    tail: Vec<f64>,
+}
+
+impl FirFilter {
+    /// Create a filter with the given impulse response
+    pub fn new(kernel: &[f64]) -> Result<Self, String> {
+        let convolver = BlockConvolver::new(kernel)?;
+        Ok(Self { kernel: kernel.to_vec(), convolver, tail: vec![0.0; kernel.len() - 1] })
+    }
+
+    /// Impulse response
+    pub fn kernel(&self) -> &[f64] {
+        &self.kernel
+    }
+
+    /// Filter the next chunk of the stream, returning chunk.len() samples
+    pub fn process(&mut self, chunk: &[f64]) -> Vec<f64> {
+        if chunk.is_empty() {
+            return Vec::new();
+        }
+        let m = self.kernel.len();
+
+        // A chunk shorter than one block would pay for a whole transform to
+        // use part of it; those go through the direct sum
+        let block_len = self.convolver.fft_len() - m + 1;
+        let mut output = if chunk.len() >= block_len {
+            self.convolver.convolve(chunk)
+        } else {
+            convolve_simd(chunk, &self.kernel)
+        };
+
+        for (out, pending) in output.iter_mut().zip(&self.tail) {
+            *out += pending;
+        }
+        self.tail = output.split_off(chunk.len());
+        output
+    }
+
+    /// End the stream: return the last kernel_len - 1 output samples and
+    /// reset the filter
+    pub fn flush(&mut self) -> Vec<f64> {
+        std::mem::replace(&mut self.tail, vec![0.0; self.kernel.len() - 1])
+    }
+
+    /// Forget the stream so far
+    pub fn reset(&mut self) {
+        self.tail.fill(0.0);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::convolution::convolve;
+    use approx::assert_relative_eq;
+
+    fn signal(n: usize) -> Vec<f64> {
+        (0..n).map(|i| (i as f64 * 0.37).sin() + 0.5 * (i as f64 * 0.011).cos()).collect()
+    }
+
+    fn assert_close(actual: &[f64], expected: &[f64]) {
+        assert_eq!(actual.len(), expected.len());
+        for (a, e) in actual.iter().zip(expected) {
+            assert_relative_eq!(*a, *e, epsilon = 1e-9);
+        }
+    }
+
+    #[test]
+    fn test_block_convolver_matches_direct() {
+        let kernel = signal(37);
+        let convolver = BlockConvolver::with_fft_len(&kernel, 64).unwrap();
+        assert_eq!(convolver.block_len(), 28);
+
+        // Shorter than, exactly, and many times the block length
+        for n in [1, 5, 28, 56, 1000] {
+            let x = signal(n);
+            assert_close(&convolver.convolve(&x), &convolve(&x, &kernel));
+        }
+        assert!(convolver.convolve(&[]).is_empty());
+    }
+
+    #[test]
+    fn test_block_convolver_rejects_bad_sizes() {
+        assert!(BlockConvolver::new(&[]).is_err());
+        assert!(BlockConvolver::with_fft_len(&[1.0; 10], 8).is_err());
+        assert_eq!(BlockConvolver::with_fft_len(&[1.0; 8], 8).unwrap().block_len(), 1);
+    }
+
+    #[test]
+    fn test_fir_filter_chunks_match_whole_signal() {
+        let x = signal(3000);
+        for taps in [1, 3, 40, 300] {
+            let kernel = signal(taps);
+            let whole = convolve(&x, &kernel);
+
+            // Irregular chunk sizes, including chunks shorter than the kernel
+            let mut filter = FirFilter::new(&kernel).unwrap();
+            let mut streamed = Vec::new();
+            let mut rest = &x[..];
+            for size in [1, 2, 17, 0, 250, 1024].iter().cycle() {
+                if rest.is_empty() {
+                    break;
+                }
+                let (chunk, tail) = rest.split_at((*size).min(rest.len()));
+                let out = filter.process(chunk);
+                assert_eq!(out.len(), chunk.len());
+                streamed.extend(out);
+                rest = tail;
+            }
+            streamed.extend(filter.flush());
+            assert_close(&streamed, &whole);
+        }
+    }
+
+    #[test]
+    fn test_fir_filter_flush_and_reset() {
+        let mut filter = FirFilter::new(&[1.0, 1.0]).unwrap();
+        assert_eq!(filter.process(&[1.0, 2.0]), vec![1.0, 3.0]);
+        assert_eq!(filter.flush(), vec![2.0]);
+
+        // Flushed: the next stream starts from silence
+        assert_eq!(filter.process(&[4.0]), vec![4.0]);
+        filter.reset();
+        assert_eq!(filter.process(&[5.0]), vec![5.0]);
+        assert_eq!(filter.kernel(), &[1.0, 1.0]);
+    }
+}
@@ -164,6 +164,42 @@ pub fn apply_window(signal: &[f64], window: &[f64]) -> Result<Vec<f64>, String>
     Ok(result)
 }
 
+/// Window shapes, by name, for functions that build their own window
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum WindowKind {
+    Hanning,
+    Hamming,
+    Blackman,
+    Rectangular,
+}
+
+impl WindowKind {
+    /// Parse a window name ("hanning" or "hann", "hamming", "blackman",
+    /// "rectangular" or "rect")
+    pub fn from_name(name: &str) -> Result<Self, String> {
+        match name.to_ascii_lowercase().as_str() {
+            "hanning" | "hann" => Ok(WindowKind::Hanning),
+            "hamming" => Ok(WindowKind::Hamming),
+            "blackman" => Ok(WindowKind::Blackman),
+            "rectangular" | "rect" => Ok(WindowKind::Rectangular),
+            _ => Err(format!(
+                "Unknown window '{}' (expected hanning, hamming, blackman or rectangular)",
+                name
+            )),
+        }
+    }
+
+    /// Window of length `n`
+    pub fn generate(self, n: usize) -> Vec<f64> {
+        match self {
+            WindowKind::Hanning => hanning_window(n),
+            WindowKind::Hamming => hamming_window(n),
+            WindowKind::Blackman => blackman_window(n),
+            WindowKind::Rectangular => rectangular_window(n),
+        }
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -249,4 +285,12 @@ mod tests {
         assert_eq!(w1.len(), 1);
         assert_relative_eq!(w1[0], 1.0, epsilon = 1e-10);
     }
+
+    #[test]
+    fn test_window_kind_by_name() {
+        assert_eq!(WindowKind::from_name("Hann").unwrap(), WindowKind::Hanning);
+        assert_eq!(WindowKind::from_name("rect").unwrap().generate(3), vec![1.0; 3]);
+        assert_eq!(WindowKind::Blackman.generate(7), blackman_window(7));
+        assert!(WindowKind::from_name("kaiser").is_err());
+    }
 }
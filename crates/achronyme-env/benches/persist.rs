@@ -0,0 +1,96 @@
+use std::collections::HashMap;
+
+use achronyme_env::{restore_environment, save_environment, RestoreOptions, SaveOptions};
+use achronyme_types::tensor::RealTensor;
+use achronyme_types::value::Value;
+use achronyme_types::Environment;
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use tempfile::TempDir;
+
+/// `bindings` variables mixing scalars, tensors, vectors and records
+fn large_environment(bindings: usize, tensor_len: usize) -> Environment {
+    let mut env = Environment::new();
+    for i in 0..bindings {
+        let value = match i % 4 {
+            0 => Value::Number(i as f64 * 0.5),
+            1 => {
+                let data = (0..tensor_len).map(|k| (k * i) as f64 * 1e-3).collect();
+                Value::Tensor(Box::new(RealTensor::vector(data)))
+            }
+            2 => Value::Vector(vec![Value::String(format!("item_{}", i)), Value::Boolean(i % 3 == 0)]),
+            _ => {
+                let mut record = HashMap::new();
+                record.insert("id".to_string(), Value::Number(i as f64));
+                record.insert("name".to_string(), Value::String(format!("record_{}", i)));
+                Value::Record(Box::new(record))
+            }
+        };
+        env.define(format!("var_{}", i), value).unwrap();
+    }
+    env
+}
+
+fn save_options(compress: bool) -> SaveOptions {
+    SaveOptions {
+        compress,
+        allow_overwrite: true,
+        ..SaveOptions::default()
+    }
+}
+
+fn bench_save(c: &mut Criterion) {
+    let dir = TempDir::new().unwrap();
+    let mut group = c.benchmark_group("env/save_environment");
+    group.sample_size(20);
+    for bindings in [100, 1000, 10000] {
+        let env = large_environment(bindings, 1000);
+        group.throughput(Throughput::Elements(bindings as u64));
+        for compress in [false, true] {
+            let path = dir.path().join(format!("save_{}_{}.ach", bindings, compress));
+            let id = BenchmarkId::new(if compress { "zstd" } else { "raw" }, bindings);
+            group.bench_with_input(id, &env, |bench, env| {
+                bench.iter(|| save_environment(black_box(env), &path, save_options(compress)).unwrap())
+            });
+        }
+    }
+    group.finish();
+}
+
+/// A few 8 MiB tensors, compressed inline vs. with zstd worker threads
+fn bench_save_large_tensors(c: &mut Criterion) {
+    let dir = TempDir::new().unwrap();
+    let mut group = c.benchmark_group("env/save_large_tensors");
+    group.sample_size(10);
+    let env = large_environment(8, 1 << 20);
+    group.throughput(Throughput::Bytes(2 * (1 << 20) * 8));
+    for threads in [0, 4] {
+        let path = dir.path().join(format!("large_{}.ach", threads));
+        let options = SaveOptions { compression_threads: threads, ..save_options(true) };
+        group.bench_with_input(BenchmarkId::new("zstd_threads", threads), &env, |bench, env| {
+            bench.iter(|| save_environment(black_box(env), &path, options.clone()).unwrap())
+        });
+    }
+    group.finish();
+}
+
+fn bench_restore(c: &mut Criterion) {
+    let dir = TempDir::new().unwrap();
+    let mut group = c.benchmark_group("env/restore_environment");
+    group.sample_size(20);
+    for bindings in [100, 1000, 10000] {
+        let env = large_environment(bindings, 1000);
+        group.throughput(Throughput::Elements(bindings as u64));
+        for compress in [false, true] {
+            let path = dir.path().join(format!("restore_{}_{}.ach", bindings, compress));
+            save_environment(&env, &path, save_options(compress)).unwrap();
+            let id = BenchmarkId::new(if compress { "zstd" } else { "raw" }, bindings);
+            group.bench_with_input(id, &path, |bench, path| {
+                bench.iter(|| restore_environment(black_box(path), RestoreOptions::default()).unwrap())
+            });
+        }
+    }
+    group.finish();
+}
+
+criterion_group!(benches, bench_save, bench_save_large_tensors, bench_restore);
+criterion_main!(benches);
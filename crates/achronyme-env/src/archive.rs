@@ -0,0 +1,814 @@
+//! Indexed, chunked `.ach` container (format v2)
+//!
+//! ```text
+//! +----------------------+  0
+//! | AchHeader (64 bytes) |  version 2.x, INDEXED flag
+//! +----------------------+  64
+//! | chunk: binding 0     |  one independently compressed chunk per binding;
+//! | chunk: binding 1     |  raw tensor chunks start on a 64-byte boundary
+//! | ...                  |
+//! +----------------------+  index_offset
+//! | index (MessagePack)  |  Metadata + one IndexEntry per binding
+//! +----------------------+
+//! | trailer (52 bytes)   |  index_offset u64 | index_len u64 | SHA-256(index) | "ACHX"
+//! +----------------------+
+//! ```
+//!
+//! Readers open the file from the trailer, so inspecting metadata or
+//! restoring a subset of bindings only reads the index and the chunks asked
+//! for. Each chunk carries its own SHA-256, checked as the chunk is read.
+//!
+//! Checkpoints ([`crate::checkpoint`]) append further chunks, a new index and
+//! a new trailer after the last trailer. Chunks of unchanged bindings are
+//! referenced by the new index at their old offsets; superseded chunks stay
+//! in the file as garbage until the archive is compacted.
+//!
+//! A segment is committed by syncing it to disk and then rewriting
+//! `AchHeader::committed_len` in place to point past its trailer. If the
+//! trailer at the end of the file is torn (an append was interrupted), the
+//! reader falls back to the committed one, so the previous checkpoint stays
+//! readable; the next append cuts the torn tail off.
+//!
+//! Real and complex tensors are stored as little-endian `f64` runs instead of
+//! MessagePack; uncompressed runs are aligned so the payload can be read
+//! straight into the tensor buffer in one pass.
+
+use std::fs::{File, OpenOptions};
+use std::io::{self, BufReader, BufWriter, Read, Seek, SeekFrom, Write};
+use std::path::Path;
+
+use byteorder::{LittleEndian, ReadBytesExt, WriteBytesExt};
+use serde::{Deserialize, Serialize};
+
+use achronyme_types::complex::Complex;
+use achronyme_types::tensor::{ComplexTensor, RealTensor};
+use achronyme_types::value::Value;
+
+use crate::checksum::{Checksummer, CHECKSUM_SIZE};
+use crate::errors::{EnvError, Result};
+use crate::format::{flags, AchHeader, CompressionType, COMMITTED_LEN_OFFSET, HEADER_SIZE};
+use crate::metadata::Metadata;
+use crate::serialize::{unsupported_type, SerializedValue, ValueRef};
+
+/// Magic bytes closing the trailer: "ACHX"
+pub const INDEX_MAGIC: [u8; 4] = [0x41, 0x43, 0x48, 0x58];
+
+/// Size of the trailer in bytes
+pub const TRAILER_SIZE: usize = 8 + 8 + CHECKSUM_SIZE + 4;
+
+/// Alignment of uncompressed tensor payloads within the file
+pub const TENSOR_ALIGNMENT: u64 = 64;
+
+/// Elements converted per read/write when streaming tensor payloads
+const TENSOR_BLOCK: usize = 8192;
+
+/// Smallest chunk payload compressed with worker threads (1 MiB)
+const MULTITHREAD_MIN_BYTES: usize = 1 << 20;
+
+/// How a chunk's payload is encoded
+#[repr(u8)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Serialize, Deserialize)]
+pub enum ChunkKind {
+    /// MessagePack-encoded `SerializedValue`
+    Value = 0,
+    /// Row-major little-endian `f64` data of a `RealTensor`
+    Tensor = 1,
+    /// Interleaved little-endian `(re, im)` pairs of a `ComplexTensor`
+    ComplexTensor = 2,
+}
+
+/// Location and integrity data of one binding's chunk
+#[derive(Debug, Clone, Serialize, Deserialize)]
+pub struct IndexEntry {
+    pub name: String,
+    pub kind: ChunkKind,
+    /// `CompressionType` as its `u8` tag
+    pub compression: u8,
+    /// Absolute file offset of the chunk
+    pub offset: u64,
+    /// Stored (possibly compressed) length in bytes
+    pub length: u64,
+    /// Tensor shape; empty for `ChunkKind::Value`
+    pub shape: Vec<usize>,
+    /// SHA-256 of the stored bytes
+    pub checksum: [u8; CHECKSUM_SIZE],
+    /// SHA-256 of the uncompressed payload; absent in files from 2.0 writers
+    #[serde(default)]
+    pub content_hash: Option<[u8; CHECKSUM_SIZE]>,
+}
+
+impl IndexEntry {
+    pub fn is_compressed(&self) -> bool {
+        self.compression == CompressionType::Zstd as u8
+    }
+}
+
+/// The index written after the last chunk
+#[derive(Debug, Clone, Serialize, Deserialize)]
+pub struct ChunkIndex {
+    pub metadata: Metadata,
+    /// Sorted by name
+    pub entries: Vec<IndexEntry>,
+    /// Delta segments appended since the file was last written whole
+    #[serde(default)]
+    pub segments: u32,
+}
+
+impl ChunkIndex {
+    pub fn entry(&self, name: &str) -> Option<&IndexEntry> {
+        self.entries
+            .binary_search_by(|entry| entry.name.as_str().cmp(name))
+            .ok()
+            .map(|i| &self.entries[i])
+    }
+}
+
+/// Writer that tracks its position and hashes the current chunk
+struct ChunkWriter<W: Write> {
+    inner: W,
+    position: u64,
+    checksummer: Checksummer,
+}
+
+impl<W: Write> Write for ChunkWriter<W> {
+    fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+        let written = self.inner.write(buf)?;
+        self.checksummer.update(&buf[..written]);
+        self.position += written as u64;
+        Ok(written)
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        self.inner.flush()
+    }
+}
+
+impl<W: Write> ChunkWriter<W> {
+    /// Zero-pad up to the next multiple of `alignment`
+    fn align(&mut self, alignment: u64) -> io::Result<()> {
+        let padding = (alignment - self.position % alignment) % alignment;
+        self.write_all(&vec![0u8; padding as usize])
+    }
+}
+
+/// Writer that hashes the bytes passing through it
+struct HashingWriter<'a, W: Write> {
+    inner: W,
+    checksummer: &'a mut Checksummer,
+}
+
+impl<W: Write> Write for HashingWriter<'_, W> {
+    fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+        let written = self.inner.write(buf)?;
+        self.checksummer.update(&buf[..written]);
+        Ok(written)
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        self.inner.flush()
+    }
+}
+
+/// SHA-256 of the payload `write_binding` would store for `value`, before
+/// compression; `None` for values that cannot be serialized
+///
+/// Tensor payloads do not include the shape, so compare `IndexEntry::shape`
+/// as well when deciding whether a binding changed.
+pub fn content_hash(value: &Value) -> Result<Option<[u8; CHECKSUM_SIZE]>> {
+    if unsupported_type(value).is_some() {
+        return Ok(None);
+    }
+    let mut checksummer = Checksummer::new();
+    let mut sink = HashingWriter { inner: io::sink(), checksummer: &mut checksummer };
+    write_payload(&mut sink, value, chunk_kind(value).0)?;
+    Ok(Some(checksummer.finish()))
+}
+
+pub(crate) fn chunk_kind(value: &Value) -> (ChunkKind, Vec<usize>) {
+    match value {
+        Value::Tensor(t) => (ChunkKind::Tensor, t.shape.clone()),
+        Value::ComplexTensor(t) => (ChunkKind::ComplexTensor, t.shape.clone()),
+        _ => (ChunkKind::Value, Vec::new()),
+    }
+}
+
+/// Writes bindings one chunk at a time, then the index and trailer
+pub struct ArchiveWriter {
+    writer: ChunkWriter<BufWriter<File>>,
+    compression_level: Option<i32>,
+    compression_threads: u32,
+    entries: Vec<IndexEntry>,
+    segments: u32,
+    /// File length before an append started
+    base_len: u64,
+}
+
+impl ArchiveWriter {
+    /// Create `path` and write the header; `compression_level: None` stores chunks raw
+    pub fn create(path: impl AsRef<Path>, compression_level: Option<i32>) -> Result<Self> {
+        let file = File::create(path)?;
+        let mut writer = ChunkWriter {
+            inner: BufWriter::new(file),
+            position: 0,
+            checksummer: Checksummer::new(),
+        };
+
+        let mut header = AchHeader::new();
+        header.flags |= flags::INDEXED;
+        if compression_level.is_some() {
+            header.compression = CompressionType::Zstd;
+            header.set_compressed(true);
+        }
+        header.write(&mut writer)?;
+        debug_assert_eq!(writer.position, HEADER_SIZE as u64);
+
+        Ok(Self {
+            writer,
+            compression_level,
+            compression_threads: 0,
+            entries: Vec::new(),
+            segments: 0,
+            base_len: 0,
+        })
+    }
+
+    /// Reopen an existing v2 file to append a delta segment after its trailer
+    ///
+    /// Returns the writer together with the file's current index. The writer
+    /// starts with no entries: carry over unchanged ones with `keep_entry`.
+    /// Until `finish` succeeds readers keep seeing the previous index, even
+    /// if the process dies mid-append; call `abort` on failure to cut the
+    /// file back to its previous state.
+    pub fn append(path: impl AsRef<Path>, compression_level: Option<i32>) -> Result<(Self, ChunkIndex)> {
+        let path = path.as_ref();
+        let reader = ArchiveReader::open(path, true)?;
+        let (index, position) = (reader.index, reader.archive_len);
+
+        // Anything past the committed trailer is the torn tail of an
+        // interrupted append
+        let mut file = OpenOptions::new().write(true).open(path)?;
+        file.set_len(position)?;
+        file.seek(SeekFrom::Start(position))?;
+        let writer = ChunkWriter {
+            inner: BufWriter::new(file),
+            position,
+            checksummer: Checksummer::new(),
+        };
+
+        let segments = index.segments + 1;
+        Ok((
+            Self {
+                writer,
+                compression_level,
+                compression_threads: 0,
+                entries: Vec::new(),
+                segments,
+                base_len: position,
+            },
+            index,
+        ))
+    }
+
+    /// Length of the file when the writer started: 0 for `create`, the end
+    /// of the committed trailer for `append`
+    pub fn base_len(&self) -> u64 {
+        self.base_len
+    }
+
+    /// Compress large chunks with `threads` zstd workers (0 or 1 = inline)
+    ///
+    /// The output is an ordinary zstd frame, so readers are unaffected.
+    pub fn with_compression_threads(mut self, threads: u32) -> Self {
+        self.compression_threads = threads;
+        self
+    }
+
+    /// Append one binding; returns `false` (and writes nothing) for values
+    /// that cannot be serialized
+    pub fn write_binding(&mut self, name: &str, value: &Value) -> Result<bool> {
+        let (kind, shape) = chunk_kind(value);
+        if unsupported_type(value).is_some() {
+            return Ok(false);
+        }
+
+        if kind != ChunkKind::Value && self.compression_level.is_none() {
+            self.writer.align(TENSOR_ALIGNMENT)?;
+        }
+        self.writer.checksummer.finish();
+        let offset = self.writer.position;
+        let mut content = Checksummer::new();
+
+        match self.compression_level {
+            Some(level) => {
+                let mut encoder = zstd::stream::write::Encoder::new(&mut self.writer, level)
+                    .map_err(|e| EnvError::Compression(e.to_string()))?;
+                // Worker threads only pay off on large payloads; spawning a
+                // pool per small chunk would dominate the save
+                if self.compression_threads > 1 && payload_size(value) >= MULTITHREAD_MIN_BYTES {
+                    encoder
+                        .multithread(self.compression_threads)
+                        .map_err(|e| EnvError::Compression(e.to_string()))?;
+                }
+                let mut payload = HashingWriter { inner: &mut encoder, checksummer: &mut content };
+                write_payload(&mut payload, value, kind)?;
+                encoder.finish().map_err(|e| EnvError::Compression(e.to_string()))?;
+            }
+            None => {
+                let mut payload = HashingWriter { inner: &mut self.writer, checksummer: &mut content };
+                write_payload(&mut payload, value, kind)?;
+            }
+        }
+
+        let compression = match self.compression_level {
+            Some(_) => CompressionType::Zstd,
+            None => CompressionType::None,
+        };
+        self.entries.push(IndexEntry {
+            name: name.to_string(),
+            kind,
+            compression: compression as u8,
+            offset,
+            length: self.writer.position - offset,
+            shape,
+            checksum: self.writer.checksummer.finish(),
+            content_hash: Some(content.finish()),
+        });
+        Ok(true)
+    }
+
+    /// Drop everything written so far, restoring the file as it was before
+    /// `create` (empty) or `append`
+    pub fn abort(self) -> Result<()> {
+        let (file, _) = self.writer.inner.into_parts();
+        file.set_len(self.base_len)?;
+        Ok(())
+    }
+
+    /// Reference a chunk already present in the file being appended to
+    pub fn keep_entry(&mut self, entry: IndexEntry) {
+        self.entries.push(entry);
+    }
+
+    /// Copy a stored chunk from another archive without decoding it
+    pub fn copy_entry(&mut self, reader: &mut ArchiveReader, entry: &IndexEntry) -> Result<()> {
+        if entry.kind != ChunkKind::Value && !entry.is_compressed() {
+            self.writer.align(TENSOR_ALIGNMENT)?;
+        }
+        self.writer.checksummer.finish();
+        let offset = self.writer.position;
+
+        reader.reader.seek(SeekFrom::Start(entry.offset))?;
+        let copied = io::copy(&mut (&mut reader.reader).take(entry.length), &mut self.writer)?;
+        let checksum = self.writer.checksummer.finish();
+        if copied != entry.length {
+            return Err(EnvError::InvalidFormat(format!("Truncated chunk for '{}'", entry.name)));
+        }
+        if reader.verify_checksums && checksum != entry.checksum {
+            return Err(EnvError::ChecksumMismatch);
+        }
+
+        self.entries.push(IndexEntry { offset, ..entry.clone() });
+        Ok(())
+    }
+
+    /// Write the index and trailer and commit them; `metadata.binding_names`
+    /// is filled in here
+    pub fn finish(mut self, metadata: Metadata) -> Result<()> {
+        self.entries.sort_by(|a, b| a.name.cmp(&b.name));
+        let names = self.entries.iter().map(|e| e.name.clone()).collect();
+        let index = ChunkIndex {
+            metadata: metadata.with_bindings(names),
+            entries: self.entries,
+            segments: self.segments,
+        };
+
+        let index_bytes = rmp_serde::to_vec(&index)?;
+        self.writer.checksummer.finish();
+        let index_offset = self.writer.position;
+        self.writer.write_all(&index_bytes)?;
+        let index_checksum = self.writer.checksummer.finish();
+
+        // Chunks and index must be on disk before a trailer points at them,
+        // and the trailer before the header does
+        self.writer.flush()?;
+        self.writer.inner.get_ref().sync_data()?;
+        self.writer.write_u64::<LittleEndian>(index_offset)?;
+        self.writer.write_u64::<LittleEndian>(index_bytes.len() as u64)?;
+        self.writer.write_all(&index_checksum)?;
+        self.writer.write_all(&INDEX_MAGIC)?;
+        self.writer.flush()?;
+        self.writer.inner.get_ref().sync_data()?;
+
+        let file = self.writer.inner.get_mut();
+        file.seek(SeekFrom::Start(COMMITTED_LEN_OFFSET))?;
+        file.write_u64::<LittleEndian>(self.writer.position)?;
+        file.sync_data()?;
+        Ok(())
+    }
+}
+
+/// Encode `value` straight into `writer`, without an intermediate copy
+fn write_payload<W: Write>(writer: &mut W, value: &Value, kind: ChunkKind) -> Result<()> {
+    match (value, kind) {
+        (_, ChunkKind::Value) => rmp_serde::encode::write(writer, &ValueRef(value))?,
+        (Value::Tensor(t), _) => write_f64s(writer, t.data().iter().copied())?,
+        (Value::ComplexTensor(t), _) => write_f64s(writer, t.data().iter().flat_map(|c| [c.re, c.im]))?,
+        _ => unreachable!("tensor chunks carry tensor values"),
+    }
+    Ok(())
+}
+
+/// Raw payload size of tensor chunks; other values are assumed small
+fn payload_size(value: &Value) -> usize {
+    match value {
+        Value::Tensor(t) => t.data().len() * 8,
+        Value::ComplexTensor(t) => t.data().len() * 16,
+        _ => 0,
+    }
+}
+
+fn write_f64s<W: Write>(writer: &mut W, values: impl Iterator<Item = f64>) -> io::Result<()> {
+    let mut block = Vec::with_capacity(TENSOR_BLOCK * 8);
+    for x in values {
+        block.extend_from_slice(&x.to_le_bytes());
+        if block.len() == block.capacity() {
+            writer.write_all(&block)?;
+            block.clear();
+        }
+    }
+    writer.write_all(&block)
+}
+
+/// Reader that hashes everything read through it
+struct HashingReader<R: Read> {
+    inner: R,
+    checksummer: Checksummer,
+}
+
+impl<R: Read> Read for HashingReader<R> {
+    fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+        let read = self.inner.read(buf)?;
+        self.checksummer.update(&buf[..read]);
+        Ok(read)
+    }
+}
+
+/// Random access to the bindings of a v2 file
+pub struct ArchiveReader {
+    reader: BufReader<File>,
+    header: AchHeader,
+    index: ChunkIndex,
+    verify_checksums: bool,
+    /// End of the trailer in use, bounding every chunk the index points to;
+    /// the file extends past it after an interrupted append
+    archive_len: u64,
+}
+
+impl ArchiveReader {
+    /// Open a v2 file, reading only the header, trailer and index
+    pub fn open(path: impl AsRef<Path>, verify_checksums: bool) -> Result<Self> {
+        let mut reader = BufReader::new(File::open(path)?);
+        let header = AchHeader::read(&mut reader)?;
+        if header.flags & flags::INDEXED == 0 {
+            return Err(EnvError::InvalidFormat("File has no chunk index".to_string()));
+        }
+        Self::from_header(reader, header, verify_checksums)
+    }
+
+    /// Continue opening after the header has been read
+    pub(crate) fn from_header(mut reader: BufReader<File>, header: AchHeader, verify_checksums: bool) -> Result<Self> {
+        let file_len = reader.seek(SeekFrom::End(0))?;
+        let committed_len = header.committed_len;
+
+        // A trailer past the committed one belongs to an append that may not
+        // have completed: only trust it with a verified index
+        let latest = read_index(&mut reader, file_len, verify_checksums || file_len != committed_len);
+        let (index, archive_len) = match latest {
+            Ok(index) => (index, file_len),
+            Err(_) if committed_len != 0 && committed_len < file_len => {
+                (read_index(&mut reader, committed_len, verify_checksums)?, committed_len)
+            }
+            Err(e) => return Err(e),
+        };
+
+        Ok(Self {
+            reader,
+            header,
+            index,
+            verify_checksums,
+            archive_len,
+        })
+    }
+
+    pub fn header(&self) -> &AchHeader {
+        &self.header
+    }
+
+    pub fn metadata(&self) -> &Metadata {
+        &self.index.metadata
+    }
+
+    pub fn entries(&self) -> &[IndexEntry] {
+        &self.index.entries
+    }
+
+    pub fn index(&self) -> &ChunkIndex {
+        &self.index
+    }
+
+    /// Read and decode one binding
+    pub fn read_binding(&mut self, name: &str) -> Result<Value> {
+        let entry = self
+            .index
+            .entry(name)
+            .cloned()
+            .ok_or_else(|| EnvError::BindingNotFound(name.to_string()))?;
+        self.read_entry(&entry)
+    }
+
+    /// Read and decode the chunk `entry` points to
+    pub fn read_entry(&mut self, entry: &IndexEntry) -> Result<Value> {
+        // The index is data too: check it before trusting any size in it
+        if entry.offset.checked_add(entry.length).map_or(true, |end| end > self.archive_len) {
+            return Err(EnvError::InvalidFormat(format!("Chunk for '{}' out of file bounds", entry.name)));
+        }
+        let values = tensor_values(entry)?;
+        if !entry.is_compressed() && values.map_or(false, |n| n as u64 * 8 != entry.length) {
+            return Err(EnvError::InvalidFormat(format!(
+                "Tensor chunk for '{}' is {} bytes, shape {:?} needs {}",
+                entry.name,
+                entry.length,
+                entry.shape,
+                values.unwrap_or(0) * 8
+            )));
+        }
+
+        self.reader.seek(SeekFrom::Start(entry.offset))?;
+        let mut chunk = HashingReader {
+            inner: (&mut self.reader).take(entry.length),
+            checksummer: Checksummer::new(),
+        };
+
+        let value = if entry.is_compressed() {
+            let mut decoder = zstd::stream::read::Decoder::new(&mut chunk)
+                .map_err(|e| EnvError::Decompression(e.to_string()))?;
+            let value = read_payload(&mut decoder, entry);
+            // Hash any bytes the decoder did not need before checking
+            io::copy(&mut decoder.finish(), &mut io::sink())?;
+            value
+        } else {
+            read_payload(&mut chunk, entry)
+        };
+        io::copy(&mut chunk, &mut io::sink())?;
+
+        // A corrupt chunk reports a checksum error rather than a decode error
+        if self.verify_checksums && chunk.checksummer.finish() != entry.checksum {
+            return Err(EnvError::ChecksumMismatch);
+        }
+        value
+    }
+}
+
+/// Number of `f64`s in a tensor chunk per its shape; None for other chunks
+///
+/// Errors if the stored payload size wouldn't fit in memory.
+fn tensor_values(entry: &IndexEntry) -> Result<Option<usize>> {
+    let per_element = match entry.kind {
+        ChunkKind::Value => return Ok(None),
+        ChunkKind::Tensor => 1,
+        ChunkKind::ComplexTensor => 2,
+    };
+    entry
+        .shape
+        .iter()
+        .try_fold(per_element, |n: usize, &dim| n.checked_mul(dim))
+        .filter(|n| n.checked_mul(8).is_some())
+        .map(Some)
+        .ok_or_else(|| EnvError::InvalidFormat(format!("Tensor shape {:?} of '{}' overflows", entry.shape, entry.name)))
+}
+
+/// Read the index whose trailer ends at `end`
+fn read_index(reader: &mut BufReader<File>, end: u64, verify_checksum: bool) -> Result<ChunkIndex> {
+    if end < (HEADER_SIZE + TRAILER_SIZE) as u64 {
+        return Err(EnvError::InvalidFormat("File too small to contain an index".to_string()));
+    }
+
+    reader.seek(SeekFrom::Start(end - TRAILER_SIZE as u64))?;
+    let index_offset = reader.read_u64::<LittleEndian>()?;
+    let index_len = reader.read_u64::<LittleEndian>()?;
+    let mut index_checksum = [0u8; CHECKSUM_SIZE];
+    reader.read_exact(&mut index_checksum)?;
+    let mut magic = [0u8; 4];
+    reader.read_exact(&mut magic)?;
+    if magic != INDEX_MAGIC {
+        return Err(EnvError::InvalidFormat("Missing index trailer".to_string()));
+    }
+    let index_end = index_offset.checked_add(index_len);
+    if index_offset < HEADER_SIZE as u64 || index_end.map_or(true, |index_end| index_end > end - TRAILER_SIZE as u64) {
+        return Err(EnvError::InvalidFormat("Index out of file bounds".to_string()));
+    }
+
+    reader.seek(SeekFrom::Start(index_offset))?;
+    let mut index_bytes = vec![0u8; index_len as usize];
+    reader.read_exact(&mut index_bytes)?;
+    if verify_checksum && !crate::checksum::verify_checksum(&index_bytes, &index_checksum) {
+        return Err(EnvError::ChecksumMismatch);
+    }
+    Ok(rmp_serde::from_slice(&index_bytes)?)
+}
+
+fn read_payload<R: Read>(reader: &mut R, entry: &IndexEntry) -> Result<Value> {
+    let len = tensor_values(entry)?.unwrap_or(0);
+    // Raw payloads were checked against the chunk length; a compressed one
+    // only proves its size by decompressing, so its buffer grows as it does
+    let reserve = if entry.is_compressed() { len.min(TENSOR_BLOCK) } else { len };
+    match entry.kind {
+        ChunkKind::Value => {
+            let serialized: SerializedValue = rmp_serde::from_read(reader)?;
+            serialized.to_value()
+        }
+        ChunkKind::Tensor => {
+            let data = read_f64s(reader, len, reserve)?;
+            RealTensor::new(data, entry.shape.clone())
+                .map(Value::from)
+                .map_err(|e| EnvError::Deserialization(format!("Invalid tensor: {}", e)))
+        }
+        ChunkKind::ComplexTensor => {
+            let flat = read_f64s(reader, len, reserve)?;
+            let data = flat.chunks_exact(2).map(|c| Complex::new(c[0], c[1])).collect();
+            ComplexTensor::new(data, entry.shape.clone())
+                .map(Value::from)
+                .map_err(|e| EnvError::Deserialization(format!("Invalid complex tensor: {}", e)))
+        }
+    }
+}
+
+/// Read exactly `len` little-endian `f64`s into a freshly allocated buffer
+/// with room for `reserve` of them up front
+fn read_f64s<R: Read>(reader: &mut R, len: usize, reserve: usize) -> Result<Vec<f64>> {
+    let mut data = Vec::with_capacity(reserve);
+    let mut block = vec![0u8; TENSOR_BLOCK.min(len.max(1)) * 8];
+    while data.len() < len {
+        let n = (len - data.len()).min(TENSOR_BLOCK);
+        let bytes = &mut block[..n * 8];
+        reader
+            .read_exact(bytes)
+            .map_err(|_| EnvError::InvalidFormat("Truncated tensor chunk".to_string()))?;
+        data.extend(bytes.chunks_exact(8).map(|b| f64::from_le_bytes(b.try_into().unwrap())));
+    }
+    Ok(data)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use tempfile::NamedTempFile;
+
+    fn sample_tensor() -> RealTensor {
+        RealTensor::new((0..24).map(|i| i as f64 * 0.5).collect(), vec![2, 3, 4]).unwrap()
+    }
+
+    fn sample_complex_tensor() -> ComplexTensor {
+        let data = (0..6).map(|i| Complex::new(i as f64, -(i as f64))).collect();
+        ComplexTensor::new(data, vec![2, 3]).unwrap()
+    }
+
+    fn write_sample(path: &Path, compression_level: Option<i32>) {
+        let mut writer = ArchiveWriter::create(path, compression_level).unwrap();
+        assert!(writer.write_binding("n", &Value::Number(3.5)).unwrap());
+        assert!(writer.write_binding("t", &Value::Tensor(Box::new(sample_tensor()))).unwrap());
+        assert!(writer.write_binding("s", &Value::String("hello".to_string())).unwrap());
+        assert!(writer.write_binding("z", &Value::ComplexTensor(Box::new(sample_complex_tensor()))).unwrap());
+        writer.finish(Metadata::new().with_description("sample")).unwrap();
+    }
+
+    #[test]
+    fn test_roundtrip_every_chunk_kind() {
+        for level in [None, Some(3)] {
+            let temp = NamedTempFile::new().unwrap();
+            write_sample(temp.path(), level);
+
+            let mut reader = ArchiveReader::open(temp.path(), true).unwrap();
+            assert_eq!(reader.metadata().num_bindings, 4);
+            assert_eq!(reader.metadata().description, Some("sample".to_string()));
+            assert_eq!(reader.read_binding("n").unwrap(), Value::Number(3.5));
+            assert_eq!(reader.read_binding("t").unwrap(), Value::Tensor(Box::new(sample_tensor())));
+            assert_eq!(reader.read_binding("s").unwrap(), Value::String("hello".to_string()));
+            assert_eq!(reader.read_binding("z").unwrap(), Value::ComplexTensor(Box::new(sample_complex_tensor())));
+            assert!(matches!(reader.read_binding("missing"), Err(EnvError::BindingNotFound(_))));
+        }
+    }
+
+    #[test]
+    fn test_index_is_sorted_and_typed() {
+        let temp = NamedTempFile::new().unwrap();
+        write_sample(temp.path(), None);
+
+        let reader = ArchiveReader::open(temp.path(), true).unwrap();
+        let names: Vec<&str> = reader.entries().iter().map(|e| e.name.as_str()).collect();
+        assert_eq!(names, ["n", "s", "t", "z"]);
+
+        let tensor = reader.entries().iter().find(|e| e.name == "t").unwrap();
+        assert_eq!(tensor.kind, ChunkKind::Tensor);
+        assert_eq!(tensor.shape, vec![2, 3, 4]);
+        assert_eq!(tensor.length, 24 * 8);
+        assert!(!tensor.is_compressed());
+    }
+
+    #[test]
+    fn test_raw_tensor_payloads_are_aligned() {
+        let temp = NamedTempFile::new().unwrap();
+        write_sample(temp.path(), None);
+
+        let reader = ArchiveReader::open(temp.path(), true).unwrap();
+        for entry in reader.entries().iter().filter(|e| e.kind != ChunkKind::Value) {
+            assert_eq!(entry.offset % TENSOR_ALIGNMENT, 0, "{} is not aligned", entry.name);
+        }
+    }
+
+    #[test]
+    fn test_views_are_stored_as_their_window() {
+        let temp = NamedTempFile::new().unwrap();
+        let row = sample_tensor().subtensor(1).unwrap();
+        let mut writer = ArchiveWriter::create(temp.path(), None).unwrap();
+        writer.write_binding("row", &Value::Tensor(Box::new(row.clone()))).unwrap();
+        writer.finish(Metadata::new()).unwrap();
+
+        let mut reader = ArchiveReader::open(temp.path(), true).unwrap();
+        assert_eq!(reader.read_binding("row").unwrap(), Value::Tensor(Box::new(row)));
+    }
+
+    #[test]
+    fn test_corrupt_chunk_is_detected() {
+        let temp = NamedTempFile::new().unwrap();
+        write_sample(temp.path(), Some(3));
+
+        let entry = ArchiveReader::open(temp.path(), true).unwrap().index.entry("t").unwrap().clone();
+        let mut data = std::fs::read(temp.path()).unwrap();
+        data[entry.offset as usize + entry.length as usize / 2] ^= 0xFF;
+        std::fs::write(temp.path(), data).unwrap();
+
+        let mut reader = ArchiveReader::open(temp.path(), true).unwrap();
+        assert!(matches!(reader.read_binding("t"), Err(EnvError::ChecksumMismatch)));
+        // Other chunks are unaffected
+        assert_eq!(reader.read_binding("n").unwrap(), Value::Number(3.5));
+    }
+
+    /// Rewrite the index of `path` through `edit`, keeping the trailer valid
+    fn rewrite_index(path: &Path, edit: impl FnOnce(&mut ChunkIndex)) {
+        let mut index = ArchiveReader::open(path, true).unwrap().index;
+        edit(&mut index);
+        let mut data = std::fs::read(path).unwrap();
+        let index_bytes = rmp_serde::to_vec(&index).unwrap();
+        let index_offset = data.len() as u64;
+        data.extend_from_slice(&index_bytes);
+        data.write_u64::<LittleEndian>(index_offset).unwrap();
+        data.write_u64::<LittleEndian>(index_bytes.len() as u64).unwrap();
+        data.extend_from_slice(&crate::checksum::calculate_checksum(&index_bytes));
+        data.extend_from_slice(&INDEX_MAGIC);
+        std::fs::write(path, data).unwrap();
+    }
+
+    #[test]
+    fn test_index_sizes_are_checked_before_allocating() {
+        for level in [None, Some(3)] {
+            let temp = NamedTempFile::new().unwrap();
+            write_sample(temp.path(), level);
+
+            // A shape whose byte size overflows
+            rewrite_index(temp.path(), |index| {
+                index.entries.iter_mut().find(|e| e.name == "t").unwrap().shape = vec![usize::MAX / 4, 4];
+            });
+            let mut reader = ArchiveReader::open(temp.path(), true).unwrap();
+            assert!(matches!(reader.read_binding("t"), Err(EnvError::InvalidFormat(_))));
+
+            // A huge shape that fits in usize but not in the chunk
+            rewrite_index(temp.path(), |index| {
+                index.entries.iter_mut().find(|e| e.name == "t").unwrap().shape = vec![1 << 40];
+            });
+            let mut reader = ArchiveReader::open(temp.path(), false).unwrap();
+            assert!(matches!(reader.read_binding("t"), Err(EnvError::InvalidFormat(_))));
+
+            // A chunk reaching past the end of the file
+            rewrite_index(temp.path(), |index| {
+                index.entries.iter_mut().find(|e| e.name == "z").unwrap().length = u64::MAX;
+            });
+            let mut reader = ArchiveReader::open(temp.path(), true).unwrap();
+            assert!(matches!(reader.read_binding("z"), Err(EnvError::InvalidFormat(_))));
+            assert_eq!(reader.read_binding("n").unwrap(), Value::Number(3.5));
+        }
+    }
+
+    #[test]
+    fn test_missing_trailer_is_rejected() {
+        let temp = NamedTempFile::new().unwrap();
+        write_sample(temp.path(), None);
+
+        let mut data = std::fs::read(temp.path()).unwrap();
+        let len = data.len();
+        data[len - 1] = 0;
+        std::fs::write(temp.path(), data).unwrap();
+
+        assert!(matches!(ArchiveReader::open(temp.path(), true), Err(EnvError::InvalidFormat(_))));
+    }
+}
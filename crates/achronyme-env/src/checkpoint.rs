@@ -0,0 +1,359 @@
+//! Incremental checkpoints of an environment into one `.ach` file
+//!
+//! A checkpoint compares every binding with the content hash recorded in the
+//! file's index and appends only new or changed bindings, followed by a new
+//! index and trailer, as a delta segment (see [`crate::archive`]). The file
+//! stays an ordinary v2 archive: restoring it reads the latest index, so
+//! superseded chunks are never touched.
+//!
+//! Superseded chunks are garbage that [`compact_archive`] drops by copying the
+//! live chunks, still encoded, into a fresh file.
+//!
+//! A checkpoint interrupted by a crash leaves the previous one readable: the
+//! header still points at its trailer, and the next checkpoint writes over
+//! the torn tail.
+
+use std::collections::HashSet;
+use std::path::Path;
+
+use achronyme_types::Environment;
+
+use std::fs::File;
+use std::io::BufReader;
+
+use crate::archive::{chunk_kind, content_hash, ArchiveReader, ArchiveWriter, ChunkIndex};
+use crate::errors::{EnvError, Result};
+use crate::format::{flags, AchHeader};
+use crate::persist::{partial_path, passes_filters, save_environment, SaveOptions};
+
+/// What a checkpoint wrote
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct CheckpointStats {
+    /// Bindings written as new chunks
+    pub written: usize,
+    /// Bindings whose existing chunk was kept
+    pub unchanged: usize,
+    /// Bindings in the previous checkpoint that no longer exist
+    pub removed: usize,
+    /// Bytes added to the file
+    pub bytes_written: u64,
+    /// Delta segments on top of the last full write
+    pub segments: u32,
+    /// Size of the file
+    pub file_bytes: u64,
+    /// Bytes of the chunks the latest index refers to
+    pub live_bytes: u64,
+}
+
+impl CheckpointStats {
+    /// Fraction of the file taken by superseded chunks and indexes
+    pub fn garbage_ratio(&self) -> f64 {
+        if self.file_bytes == 0 {
+            return 0.0;
+        }
+        1.0 - self.live_bytes as f64 / self.file_bytes as f64
+    }
+}
+
+/// Checkpoint `env` into `path`, appending only what changed
+///
+/// Produces the same bindings `save_environment` would with `options`, but
+/// writes a full archive only when `path` does not exist yet (or holds a v1
+/// file). Checkpointing implies overwriting, so `allow_overwrite` is ignored.
+/// `description` and `tags` replace the stored ones when given.
+pub fn checkpoint_environment(
+    env: &Environment,
+    path: impl AsRef<Path>,
+    options: SaveOptions,
+) -> Result<CheckpointStats> {
+    let path = path.as_ref();
+
+    if !is_indexed_archive(path)? {
+        save_environment(env, path, SaveOptions { allow_overwrite: true, ..options })?;
+        let reader = ArchiveReader::open(path, false)?;
+        let file_bytes = std::fs::metadata(path)?.len();
+        return Ok(CheckpointStats {
+            written: reader.entries().len(),
+            bytes_written: file_bytes,
+            file_bytes,
+            live_bytes: live_bytes(reader.index()),
+            ..Default::default()
+        });
+    }
+
+    let level = options.compress.then_some(options.compression_level);
+    let (writer, index) = ArchiveWriter::append(path, level)?;
+    let mut writer = writer.with_compression_threads(options.compression_threads);
+    let base_len = writer.base_len();
+
+    let mut stats = CheckpointStats::default();
+    let names: Vec<String> = env
+        .visible_names()
+        .into_iter()
+        .filter(|name| passes_filters(name, &options.include_only, &options.exclude))
+        .collect();
+
+    let mut delta = || -> Result<()> {
+        for name in &names {
+            let value = env.get(name).ok();
+            let hash = match &value {
+                Some(value) => content_hash(value)?,
+                None => None,
+            };
+            let (value, hash) = match (value, hash) {
+                (Some(value), Some(hash)) => (value, hash),
+                _ => {
+                    eprintln!("Warning: Variable '{}' is not serializable and will be skipped", name);
+                    continue;
+                }
+            };
+
+            let (kind, shape) = chunk_kind(&value);
+            match index.entry(name) {
+                Some(entry) if entry.content_hash == Some(hash) && entry.kind == kind && entry.shape == shape => {
+                    writer.keep_entry(entry.clone());
+                    stats.unchanged += 1;
+                }
+                _ => {
+                    writer.write_binding(name, &value)?;
+                    stats.written += 1;
+                }
+            }
+        }
+        Ok(())
+    };
+    if let Err(e) = delta() {
+        writer.abort()?;
+        return Err(e);
+    }
+
+    let current: HashSet<&str> = names.iter().map(String::as_str).collect();
+    stats.removed = index.entries.iter().filter(|e| !current.contains(e.name.as_str())).count();
+    let description_changed = options.description.is_some() && options.description != index.metadata.description;
+    let tags_changed = !options.tags.is_empty() && options.tags != index.metadata.tags;
+    if stats.written == 0 && stats.removed == 0 && !description_changed && !tags_changed {
+        // Nothing to record: leave the file untouched
+        writer.abort()?;
+        stats.segments = index.segments;
+        stats.file_bytes = base_len;
+        stats.live_bytes = live_bytes(&index);
+        return Ok(stats);
+    }
+
+    let mut metadata = index.metadata.clone();
+    if let Some(desc) = options.description {
+        metadata = metadata.with_description(desc);
+    }
+    if !options.tags.is_empty() {
+        metadata = metadata.with_tags(options.tags);
+    }
+    metadata = metadata.with_custom("checkpointed_at", chrono::Utc::now().to_rfc3339());
+    writer.finish(metadata)?;
+
+    let reader = ArchiveReader::open(path, false)?;
+    stats.segments = reader.index().segments;
+    stats.file_bytes = std::fs::metadata(path)?.len();
+    stats.bytes_written = stats.file_bytes - base_len;
+    stats.live_bytes = live_bytes(reader.index());
+    Ok(stats)
+}
+
+/// Rewrite `path` with only the chunks its latest index refers to
+///
+/// Chunks are copied as stored (no decoding or recompression), with their
+/// checksums verified on the way. Returns the file size before and after.
+pub fn compact_archive(path: impl AsRef<Path>) -> Result<(u64, u64)> {
+    let path = path.as_ref();
+    if !is_indexed_archive(path)? {
+        return Err(EnvError::InvalidFormat("Only indexed (v2) archives can be compacted".to_string()));
+    }
+    let before = std::fs::metadata(path)?.len();
+
+    let mut reader = ArchiveReader::open(path, true)?;
+    let partial = partial_path(path);
+    // Chunks keep their own compression; the level is only used for the header flag
+    let level = reader.header().is_compressed().then_some(0);
+    let mut writer = ArchiveWriter::create(&partial, level)?;
+
+    let entries = reader.entries().to_vec();
+    let metadata = reader.metadata().clone();
+    let mut copy = || -> Result<()> {
+        for entry in &entries {
+            writer.copy_entry(&mut reader, entry)?;
+        }
+        Ok(())
+    };
+    if let Err(e) = copy().and_then(|()| writer.finish(metadata)) {
+        let _ = std::fs::remove_file(&partial);
+        return Err(e);
+    }
+
+    std::fs::rename(&partial, path)?;
+    Ok((before, std::fs::metadata(path)?.len()))
+}
+
+/// Whether `path` exists and holds an indexed (v2) archive
+fn is_indexed_archive(path: &Path) -> Result<bool> {
+    if !path.exists() {
+        return Ok(false);
+    }
+    let header = AchHeader::read(&mut BufReader::new(File::open(path)?))?;
+    Ok(header.flags & flags::INDEXED != 0)
+}
+
+fn live_bytes(index: &ChunkIndex) -> u64 {
+    index.entries.iter().map(|e| e.length).sum()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::archive::{ChunkKind, TENSOR_ALIGNMENT};
+    use crate::persist::{restore_environment, RestoreOptions};
+    use achronyme_types::tensor::RealTensor;
+    use achronyme_types::value::Value;
+    use std::collections::HashMap;
+    use tempfile::TempDir;
+
+    fn options(compress: bool) -> SaveOptions {
+        SaveOptions { compress, ..Default::default() }
+    }
+
+    fn sample_env() -> Environment {
+        let mut env = Environment::new();
+        env.define("x".to_string(), Value::Number(1.0)).unwrap();
+        env.define("s".to_string(), Value::String("text".to_string())).unwrap();
+        let big = RealTensor::vector((0..10_000).map(|i| i as f64).collect());
+        env.define("big".to_string(), Value::Tensor(Box::new(big))).unwrap();
+        env
+    }
+
+    #[test]
+    fn test_checkpoint_appends_only_changed_bindings() {
+        for compress in [false, true] {
+            let dir = TempDir::new().unwrap();
+            let path = dir.path().join("session.ach");
+            let mut env = sample_env();
+
+            let first = checkpoint_environment(&env, &path, options(compress)).unwrap();
+            assert_eq!(first.written, 3);
+            assert_eq!(first.segments, 0);
+
+            env.set("x", Value::Number(2.0)).unwrap();
+            let second = checkpoint_environment(&env, &path, options(compress)).unwrap();
+            assert_eq!((second.written, second.unchanged, second.removed), (1, 2, 0));
+            assert_eq!(second.segments, 1);
+            assert!(second.bytes_written < first.bytes_written / 4, "{:?} vs {:?}", second, first);
+
+            let restored = restore_environment(&path, RestoreOptions::default()).unwrap();
+            assert_eq!(restored.get("x").unwrap(), Value::Number(2.0));
+            assert_eq!(restored.get("big").unwrap(), env.get("big").unwrap());
+        }
+    }
+
+    #[test]
+    fn test_unchanged_checkpoint_leaves_file_untouched() {
+        let dir = TempDir::new().unwrap();
+        let path = dir.path().join("session.ach");
+        let mut env = sample_env();
+        let mut record = HashMap::new();
+        for key in ["a", "b", "c", "d"] {
+            record.insert(key.to_string(), Value::Number(1.0));
+        }
+        env.define("r".to_string(), Value::Record(Box::new(record.clone()))).unwrap();
+        checkpoint_environment(&env, &path, options(true)).unwrap();
+        let len = std::fs::metadata(&path).unwrap().len();
+
+        // An equal record built separately encodes to the same bytes
+        let rebuilt: HashMap<String, Value> = ["d", "c", "b", "a"]
+            .iter()
+            .map(|key| (key.to_string(), Value::Number(1.0)))
+            .collect();
+        assert_eq!(rebuilt, record);
+        env.set("r", Value::Record(Box::new(rebuilt))).unwrap();
+        let stats = checkpoint_environment(&env, &path, options(true)).unwrap();
+        assert_eq!((stats.written, stats.unchanged, stats.bytes_written), (0, 4, 0));
+        assert_eq!(std::fs::metadata(&path).unwrap().len(), len);
+    }
+
+    #[test]
+    fn test_checkpoint_tracks_removed_and_reshaped_bindings() {
+        let dir = TempDir::new().unwrap();
+        let path = dir.path().join("session.ach");
+        let env = sample_env();
+        checkpoint_environment(&env, &path, options(false)).unwrap();
+
+        let mut env = Environment::new();
+        env.define("x".to_string(), Value::Number(1.0)).unwrap();
+        let reshaped = RealTensor::new((0..10_000).map(|i| i as f64).collect(), vec![100, 100]).unwrap();
+        env.define("big".to_string(), Value::Tensor(Box::new(reshaped.clone()))).unwrap();
+        let stats = checkpoint_environment(&env, &path, options(false)).unwrap();
+        assert_eq!((stats.written, stats.unchanged, stats.removed), (1, 1, 1));
+
+        let restored = restore_environment(&path, RestoreOptions::default()).unwrap();
+        assert!(!restored.has("s"));
+        assert_eq!(restored.get("big").unwrap(), Value::Tensor(Box::new(reshaped)));
+    }
+
+    #[test]
+    fn test_interrupted_checkpoint_keeps_previous_one() {
+        for compress in [false, true] {
+            let dir = TempDir::new().unwrap();
+            let path = dir.path().join("session.ach");
+            let mut env = sample_env();
+            checkpoint_environment(&env, &path, options(compress)).unwrap();
+            let committed = std::fs::read(&path).unwrap();
+
+            // The process dies while appending: chunks and index are written,
+            // the trailer only partly
+            env.set("x", Value::Number(2.0)).unwrap();
+            checkpoint_environment(&env, &path, options(compress)).unwrap();
+            let appended = std::fs::read(&path).unwrap();
+            let mut torn = appended[..appended.len() - 7].to_vec();
+            torn[..crate::format::HEADER_SIZE].copy_from_slice(&committed[..crate::format::HEADER_SIZE]);
+            std::fs::write(&path, &torn).unwrap();
+
+            let restored = restore_environment(&path, RestoreOptions::default()).unwrap();
+            assert_eq!(restored.get("x").unwrap(), Value::Number(1.0));
+            assert_eq!(restored.get("big").unwrap(), env.get("big").unwrap());
+
+            // The next checkpoint replaces the torn tail
+            env.set("x", Value::Number(3.0)).unwrap();
+            let stats = checkpoint_environment(&env, &path, options(compress)).unwrap();
+            assert_eq!((stats.written, stats.unchanged), (1, 2));
+            assert_eq!(stats.bytes_written, stats.file_bytes - committed.len() as u64);
+            let restored = restore_environment(&path, RestoreOptions::default()).unwrap();
+            assert_eq!(restored.get("x").unwrap(), Value::Number(3.0));
+        }
+    }
+
+    #[test]
+    fn test_compaction_folds_segments() {
+        let dir = TempDir::new().unwrap();
+        let path = dir.path().join("session.ach");
+        let mut env = sample_env();
+        checkpoint_environment(&env, &path, options(false)).unwrap();
+        for i in 0..5 {
+            let data = (0..10_000).map(|k| (k + i) as f64).collect();
+            env.set("big", Value::Tensor(Box::new(RealTensor::vector(data)))).unwrap();
+            checkpoint_environment(&env, &path, options(false)).unwrap();
+        }
+
+        let (before, after) = compact_archive(&path).unwrap();
+        assert!(after < before / 3, "{} -> {}", before, after);
+
+        let reader = ArchiveReader::open(&path, true).unwrap();
+        assert_eq!(reader.index().segments, 0);
+        for entry in reader.entries().iter().filter(|e| e.kind != ChunkKind::Value) {
+            assert_eq!(entry.offset % TENSOR_ALIGNMENT, 0);
+        }
+
+        let restored = restore_environment(&path, RestoreOptions::default()).unwrap();
+        assert_eq!(restored.get("big").unwrap(), env.get("big").unwrap());
+        assert_eq!(restored.get("s").unwrap(), Value::String("text".to_string()));
+
+        // Compacted files keep their content hashes, so the next checkpoint is a no-op
+        let stats = checkpoint_environment(&env, &path, options(false)).unwrap();
+        assert_eq!(stats.bytes_written, 0);
+    }
+}
@@ -10,6 +10,28 @@ pub fn calculate_checksum(data: &[u8]) -> [u8; CHECKSUM_SIZE] {
     hasher.finalize().into()
 }
 
+/// Incremental SHA-256 for data that is written or read in pieces
+#[derive(Clone, Default)]
+pub struct Checksummer {
+    hasher: Sha256,
+}
+
+impl Checksummer {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Feed the next piece of data
+    pub fn update(&mut self, data: &[u8]) {
+        self.hasher.update(data);
+    }
+
+    /// Checksum of everything fed so far; resets the hasher
+    pub fn finish(&mut self) -> [u8; CHECKSUM_SIZE] {
+        std::mem::take(&mut self.hasher).finalize().into()
+    }
+}
+
 /// Verify checksum
 pub fn verify_checksum(data: &[u8], expected: &[u8; CHECKSUM_SIZE]) -> bool {
     let computed = calculate_checksum(data);
@@ -42,6 +64,18 @@ mod tests {
         assert!(!verify_checksum(wrong_data, &checksum));
     }
 
+    #[test]
+    fn test_checksummer_matches_one_shot() {
+        let mut checksummer = Checksummer::new();
+        checksummer.update(b"hello ");
+        checksummer.update(b"world");
+        assert_eq!(checksummer.finish(), calculate_checksum(b"hello world"));
+
+        // finish() starts over
+        checksummer.update(b"test data");
+        assert_eq!(checksummer.finish(), calculate_checksum(b"test data"));
+    }
+
     #[test]
     fn test_checksum_deterministic() {
         let data = b"test data";
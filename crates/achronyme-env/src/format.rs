@@ -6,14 +6,20 @@ use crate::errors::{EnvError, Result};
 pub const MAGIC: [u8; 4] = [0x41, 0x43, 0x48, 0x00];
 
 /// Major version of the .ach format
-pub const FORMAT_VERSION_MAJOR: u16 = 1;
+pub const FORMAT_VERSION_MAJOR: u16 = 2;
 
 /// Minor version of the .ach format
-pub const FORMAT_VERSION_MINOR: u16 = 0;
+///
+/// 2.1 adds per-binding content hashes and delta segments to the index.
+/// 2.2 records the end of the last completed trailer in the header.
+pub const FORMAT_VERSION_MINOR: u16 = 2;
 
 /// Size of the header in bytes
 pub const HEADER_SIZE: usize = 64;
 
+/// File offset of `AchHeader::committed_len`, rewritten in place on commit
+pub const COMMITTED_LEN_OFFSET: u64 = 37;
+
 /// Feature flags
 pub mod flags {
     /// No special features
@@ -27,6 +33,9 @@ pub mod flags {
 
     /// File includes user-defined functions (future)
     pub const HAS_FUNCTIONS: u32 = 1 << 2;
+
+    /// Bindings are stored as separate chunks with a trailing index (v2)
+    pub const INDEXED: u32 = 1 << 3;
 }
 
 /// Compression algorithms
@@ -71,8 +80,14 @@ pub struct AchHeader {
     /// Compression type
     pub compression: CompressionType,
 
-    /// Reserved for future use (27 bytes to make total 64)
-    pub reserved: [u8; 27],
+    /// File length up to the end of the last completed index trailer (v2.2)
+    ///
+    /// An interrupted append leaves a torn tail past this point. 0 in files
+    /// from older writers, whose trailer is always at the end of the file.
+    pub committed_len: u64,
+
+    /// Reserved for future use (19 bytes to make total 64)
+    pub reserved: [u8; 19],
 }
 
 impl AchHeader {
@@ -100,7 +115,8 @@ impl AchHeader {
             created_timestamp: timestamp,
             achronyme_version: version_bytes,
             compression: CompressionType::None,
-            reserved: [0u8; 27],
+            committed_len: 0,
+            reserved: [0u8; 19],
         }
     }
 
@@ -113,6 +129,7 @@ impl AchHeader {
         writer.write_u64::<LittleEndian>(self.created_timestamp)?;
         writer.write_all(&self.achronyme_version)?;
         writer.write_u8(self.compression as u8)?;
+        writer.write_u64::<LittleEndian>(self.committed_len)?;
         writer.write_all(&self.reserved)?;
         Ok(())
     }
@@ -142,7 +159,10 @@ impl AchHeader {
                 format!("Invalid compression type: {}", compression_byte)
             ))?;
 
-        let mut reserved = [0u8; 27];
+        // Older writers left these bytes zeroed, so they read as 0
+        let committed_len = reader.read_u64::<LittleEndian>()?;
+
+        let mut reserved = [0u8; 19];
         reader.read_exact(&mut reserved)?;
 
         Ok(Self {
@@ -153,6 +173,7 @@ impl AchHeader {
             created_timestamp,
             achronyme_version,
             compression,
+            committed_len,
             reserved,
         })
     }
@@ -189,7 +210,7 @@ impl AchHeader {
             });
         }
 
-        // For now, we only support version 1.x
+        // Versions 1.x (single body) and 2.x (indexed chunks) are readable
         if self.version_major > FORMAT_VERSION_MAJOR {
             return Err(EnvError::VersionMismatch {
                 file_version: format!("{}.{}", self.version_major, self.version_minor),
@@ -234,6 +255,18 @@ mod tests {
         assert_eq!(restored.version_minor, FORMAT_VERSION_MINOR);
     }
 
+    #[test]
+    fn test_committed_len_offset() {
+        let mut header = AchHeader::new();
+        header.committed_len = 0x0102_0304_0506_0708;
+        let mut buf = Vec::new();
+        header.write(&mut buf).unwrap();
+
+        let at = COMMITTED_LEN_OFFSET as usize;
+        assert_eq!(buf[at..at + 8], header.committed_len.to_le_bytes());
+        assert_eq!(AchHeader::read(&mut Cursor::new(buf)).unwrap().committed_len, header.committed_len);
+    }
+
     #[test]
     fn test_invalid_magic() {
         let mut buf = vec![0xFF, 0xFF, 0xFF, 0xFF];
@@ -7,9 +7,18 @@
 //!
 //! The `.ach` format uses a hybrid approach:
 //! - Custom 64-byte header for version control and metadata offsets
-//! - MessagePack serialization for the actual data
-//! - Optional Zstandard compression
-//! - SHA-256 checksum for integrity verification
+//! - One chunk per binding: MessagePack for general values, aligned raw
+//!   little-endian `f64` for tensors
+//! - Optional Zstandard compression, applied per chunk
+//! - A trailing index with the offset, length and SHA-256 checksum of every
+//!   chunk, so single bindings and metadata can be read without touching
+//!   the rest of the file
+//!
+//! Version 1 files (a single compressed body) are still readable.
+//!
+//! [`checkpoint_environment`] appends only new or changed bindings to an
+//! existing archive; [`compact_archive`] folds those delta segments back into
+//! a single one.
 //!
 //! # Example
 //!
@@ -34,6 +43,8 @@ pub mod metadata;
 pub mod persist;
 pub mod serialize;
 pub mod checksum;
+pub mod archive;
+pub mod checkpoint;
 
 // Re-exports
 pub use errors::{EnvError, Result};
@@ -41,3 +52,5 @@ pub use format::{AchHeader, MAGIC, FORMAT_VERSION_MAJOR, FORMAT_VERSION_MINOR};
 pub use metadata::Metadata;
 pub use persist::{save_environment, restore_environment, get_metadata, SaveOptions, RestoreOptions, RestoreMode};
 pub use serialize::{serialize_value, deserialize_value};
+pub use archive::{ArchiveReader, ArchiveWriter, ChunkIndex, ChunkKind, IndexEntry};
+pub use checkpoint::{checkpoint_environment, compact_archive, CheckpointStats};
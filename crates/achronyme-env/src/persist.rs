@@ -1,15 +1,17 @@
 use std::path::Path;
-use std::io::{BufWriter, BufReader, Write, Read};
+use std::io::{BufReader, Read};
 use std::fs::File;
 use std::collections::HashMap;
 use serde::{Deserialize, Serialize};
 
+use achronyme_types::value::Value;
 use achronyme_types::Environment;
+use crate::archive::{ArchiveReader, ArchiveWriter, IndexEntry};
 use crate::errors::{EnvError, Result};
-use crate::format::{AchHeader, CompressionType};
+use crate::format::AchHeader;
 use crate::metadata::Metadata;
 use crate::serialize::SerializedValue;
-use crate::checksum::{calculate_checksum, verify_checksum, CHECKSUM_SIZE};
+use crate::checksum::{verify_checksum, CHECKSUM_SIZE};
 
 /// Options for saving environment
 #[derive(Debug, Clone)]
@@ -34,6 +36,9 @@ pub struct SaveOptions {
 
     /// Allow overwriting existing file
     pub allow_overwrite: bool,
+
+    /// zstd worker threads for large chunks (0 or 1 = compress inline)
+    pub compression_threads: u32,
 }
 
 impl Default for SaveOptions {
@@ -46,6 +51,7 @@ impl Default for SaveOptions {
             include_only: None,
             exclude: Vec::new(),
             allow_overwrite: false,
+            compression_threads: 0,
         }
     }
 }
@@ -100,14 +106,39 @@ impl Default for RestoreOptions {
     }
 }
 
-/// Internal structure for .ach file body
+/// Internal structure for the body of a v1 .ach file
 #[derive(Debug, Serialize, Deserialize)]
 struct AchBody {
     metadata: Metadata,
     bindings: HashMap<String, SerializedValue>,
 }
 
+/// Whether a binding passes the `include_only` / `exclude` filters
+///
+/// Exclude patterns are exact names, or prefixes when they end in `*`.
+pub(crate) fn passes_filters(name: &str, include_only: &Option<Vec<String>>, exclude: &[String]) -> bool {
+    if let Some(include_only) = include_only {
+        if !include_only.iter().any(|n| n == name) {
+            return false;
+        }
+    }
+
+    !exclude.iter().any(|pattern| match pattern.strip_suffix('*') {
+        Some(prefix) => name.starts_with(prefix),
+        None => name == pattern,
+    })
+}
+
 /// Save environment to .ach file
+///
+/// Writes the indexed v2 layout (see [`crate::archive`]): one chunk per
+/// binding, so later restores can read bindings individually.
+///
+/// Bindings are encoded one at a time straight from the environment into
+/// the compressor and file, so no copy of the whole environment (or of its
+/// encoded form) is ever held in memory. The archive is written next to
+/// `path` and renamed into place once complete; an interrupted save leaves
+/// any previous file intact.
 pub fn save_environment(
     env: &Environment,
     path: impl AsRef<Path>,
@@ -122,52 +153,51 @@ pub fn save_environment(
         ));
     }
 
-    // Collect bindings to save
-    let mut bindings_to_save = HashMap::new();
-    let mut binding_names = Vec::new();
-
-    // Get snapshot of all variables in environment
-    let snapshot = env.snapshot();
-
-    for (name, value) in snapshot.iter() {
-        // Apply filters
-        if let Some(ref include_only) = options.include_only {
-            if !include_only.contains(&name.to_string()) {
-                continue;
-            }
-        }
-
-        if options.exclude.iter().any(|pattern| {
-            // Simple pattern matching: exact match or starts_with for "prefix_*"
-            if pattern.ends_with('*') {
-                let prefix = &pattern[..pattern.len() - 1];
-                name.starts_with(prefix)
-            } else {
-                name == pattern
-            }
-        }) {
-            continue;
+    let names: Vec<String> = env
+        .visible_names()
+        .into_iter()
+        .filter(|name| passes_filters(name, &options.include_only, &options.exclude))
+        .collect();
+
+    let partial = partial_path(path);
+    let result = write_archive(env, names, &partial, options);
+    match result {
+        Ok(()) => std::fs::rename(&partial, path).map_err(EnvError::from),
+        Err(e) => {
+            let _ = std::fs::remove_file(&partial);
+            Err(e)
         }
+    }
+}
 
-        // Serialize value
-        let serialized = SerializedValue::from_value(value);
+/// Sibling of `path` the archive is written to before being renamed
+pub(crate) fn partial_path(path: &Path) -> std::path::PathBuf {
+    let mut name = path.file_name().unwrap_or_default().to_os_string();
+    name.push(".partial");
+    path.with_file_name(name)
+}
 
-        // Warn about unsupported values
-        if matches!(serialized, SerializedValue::Unsupported { .. }) {
+fn write_archive(
+    env: &Environment,
+    names: Vec<String>,
+    path: &Path,
+    options: SaveOptions,
+) -> Result<()> {
+    let level = options.compress.then_some(options.compression_level);
+    let mut writer = ArchiveWriter::create(path, level)?
+        .with_compression_threads(options.compression_threads);
+    for name in names {
+        let written = match env.get(&name) {
+            Ok(value) => writer.write_binding(&name, &value)?,
+            Err(_) => false,
+        };
+        if !written {
             eprintln!("Warning: Variable '{}' is not serializable and will be skipped", name);
-            continue;
         }
-
-        bindings_to_save.insert(name.clone(), serialized);
-        binding_names.push(name.clone());
     }
 
-    // Sort binding names for consistent output
-    binding_names.sort();
-
-    // Create metadata
-    let mut metadata = Metadata::new()
-        .with_bindings(binding_names);
+    // Create metadata (binding names are filled in by the writer)
+    let mut metadata = Metadata::new();
 
     if let Some(desc) = options.description {
         metadata = metadata.with_description(desc);
@@ -177,53 +207,13 @@ pub fn save_environment(
         metadata = metadata.with_tags(options.tags);
     }
 
-    // Create body
-    let body = AchBody {
-        metadata,
-        bindings: bindings_to_save,
-    };
-
-    // Serialize body to MessagePack
-    let body_bytes = rmp_serde::to_vec(&body)?;
-
-    // Compress if requested
-    let (final_bytes, compression) = if options.compress {
-        let compressed = zstd::encode_all(&body_bytes[..], options.compression_level)
-            .map_err(|e| EnvError::Compression(e.to_string()))?;
-        (compressed, CompressionType::Zstd)
-    } else {
-        (body_bytes, CompressionType::None)
-    };
-
-    // Calculate checksum
-    let checksum = calculate_checksum(&final_bytes);
-
-    // Create header
-    let mut header = AchHeader::new();
-    header.compression = compression;
-    if options.compress {
-        header.set_compressed(true);
-    }
-
-    // Write to file
-    let file = File::create(path)?;
-    let mut writer = BufWriter::new(file);
-
-    // Write header
-    header.write(&mut writer)?;
-
-    // Write body
-    writer.write_all(&final_bytes)?;
-
-    // Write checksum
-    writer.write_all(&checksum)?;
-
-    writer.flush()?;
-
-    Ok(())
+    writer.finish(metadata)
 }
 
 /// Restore environment from .ach file
+///
+/// For v2 files only the index and the chunks that pass the filters are
+/// read; v1 files are decoded whole.
 pub fn restore_environment(
     path: impl AsRef<Path>,
     options: RestoreOptions,
@@ -240,73 +230,44 @@ pub fn restore_environment(
     // Verify version
     header.verify_version(options.strict_version)?;
 
-    // Read body
-    let mut body_bytes = Vec::new();
-    reader.read_to_end(&mut body_bytes)?;
-
-    // Extract checksum (last 32 bytes)
-    if body_bytes.len() < CHECKSUM_SIZE {
-        return Err(EnvError::InvalidFormat(
-            "File too small to contain checksum".to_string()
-        ));
-    }
-
-    let data_end = body_bytes.len() - CHECKSUM_SIZE;
-    let data_bytes = &body_bytes[..data_end];
-    let checksum_bytes: &[u8; CHECKSUM_SIZE] = body_bytes[data_end..].try_into()
-        .map_err(|_| EnvError::InvalidFormat("Invalid checksum size".to_string()))?;
-
-    // Verify checksum
-    if options.verify_checksum {
-        if !verify_checksum(data_bytes, checksum_bytes) {
-            return Err(EnvError::ChecksumMismatch);
-        }
-    }
-
-    // Decompress if needed
-    let decompressed = if header.is_compressed() {
-        zstd::decode_all(data_bytes)
-            .map_err(|e| EnvError::Decompression(e.to_string()))?
-    } else {
-        data_bytes.to_vec()
-    };
-
-    // Deserialize body
-    let body: AchBody = rmp_serde::from_slice(&decompressed)?;
-
     // Create environment
     let mut env = Environment::new();
 
-    // Apply bindings based on mode and filters
-    for (name, serialized_value) in body.bindings {
-        // Apply filters
-        if let Some(ref include_only) = options.include_only {
-            if !include_only.contains(&name) {
-                continue;
+    let define = |env: &mut Environment, name: String, value: Result<Value>| match value {
+        Ok(value) => {
+            if let Err(e) = env.define(name.clone(), value) {
+                eprintln!("Warning: Failed to define '{}': {}", name, e);
             }
         }
+        Err(e) => {
+            eprintln!("Warning: Failed to restore '{}': {}", name, e);
+        }
+    };
 
-        if options.exclude.iter().any(|pattern| {
-            if pattern.ends_with('*') {
-                let prefix = &pattern[..pattern.len() - 1];
-                name.starts_with(prefix)
-            } else {
-                &name == pattern
+    if header.version_major < 2 {
+        let body = read_v1_body(&mut reader, &header, options.verify_checksum)?;
+        for (name, serialized_value) in body.bindings {
+            if passes_filters(&name, &options.include_only, &options.exclude) {
+                let value = serialized_value.to_value();
+                define(&mut env, name, value);
             }
-        }) {
-            continue;
         }
+        return Ok(env);
+    }
 
-        // Deserialize value
-        match serialized_value.to_value() {
-            Ok(value) => {
-                if let Err(e) = env.define(name.clone(), value) {
-                    eprintln!("Warning: Failed to define '{}': {}", name, e);
-                }
-            }
-            Err(e) => {
-                eprintln!("Warning: Failed to restore '{}': {}", name, e);
-            }
+    let mut archive = ArchiveReader::from_header(reader, header, options.verify_checksum)?;
+    let entries: Vec<IndexEntry> = archive
+        .entries()
+        .iter()
+        .filter(|entry| passes_filters(&entry.name, &options.include_only, &options.exclude))
+        .cloned()
+        .collect();
+
+    for entry in entries {
+        match archive.read_entry(&entry) {
+            // Integrity failures abort the restore instead of being skipped
+            Err(EnvError::ChecksumMismatch) => return Err(EnvError::ChecksumMismatch),
+            value => define(&mut env, entry.name, value),
         }
     }
 
@@ -314,6 +275,8 @@ pub fn restore_environment(
 }
 
 /// Get metadata from .ach file without loading the entire file
+///
+/// For v2 files this reads only the trailer and the index.
 pub fn get_metadata(path: impl AsRef<Path>) -> Result<Metadata> {
     let path = path.as_ref();
 
@@ -323,17 +286,35 @@ pub fn get_metadata(path: impl AsRef<Path>) -> Result<Metadata> {
     // Read header
     let header = AchHeader::read(&mut reader)?;
 
+    if header.version_major < 2 {
+        return Ok(read_v1_body(&mut reader, &header, false)?.metadata);
+    }
+
+    Ok(ArchiveReader::from_header(reader, header, false)?.metadata().clone())
+}
+
+/// Decode the single MessagePack body of a v1 file
+fn read_v1_body<R: Read>(reader: &mut R, header: &AchHeader, verify: bool) -> Result<AchBody> {
     // Read body
     let mut body_bytes = Vec::new();
     reader.read_to_end(&mut body_bytes)?;
 
-    // Extract data (without checksum)
+    // Extract checksum (last 32 bytes)
     if body_bytes.len() < CHECKSUM_SIZE {
-        return Err(EnvError::InvalidFormat("File too small".to_string()));
+        return Err(EnvError::InvalidFormat(
+            "File too small to contain checksum".to_string()
+        ));
     }
 
     let data_end = body_bytes.len() - CHECKSUM_SIZE;
     let data_bytes = &body_bytes[..data_end];
+    let checksum_bytes: &[u8; CHECKSUM_SIZE] = body_bytes[data_end..].try_into()
+        .map_err(|_| EnvError::InvalidFormat("Invalid checksum size".to_string()))?;
+
+    // Verify checksum
+    if verify && !verify_checksum(data_bytes, checksum_bytes) {
+        return Err(EnvError::ChecksumMismatch);
+    }
 
     // Decompress if needed
     let decompressed = if header.is_compressed() {
@@ -343,17 +324,14 @@ pub fn get_metadata(path: impl AsRef<Path>) -> Result<Metadata> {
         data_bytes.to_vec()
     };
 
-    // Deserialize body (we only need metadata)
-    let body: AchBody = rmp_serde::from_slice(&decompressed)?;
-
-    Ok(body.metadata)
+    // Deserialize body
+    Ok(rmp_serde::from_slice(&decompressed)?)
 }
 
 #[cfg(test)]
 mod tests {
     use super::*;
     use tempfile::NamedTempFile;
-    use achronyme_types::value::Value;
 
     #[test]
     fn test_ach_body_serialization() {
@@ -488,4 +466,134 @@ mod tests {
         let result = restore_environment(path, Default::default());
         assert!(matches!(result, Err(EnvError::ChecksumMismatch)));
     }
+
+    #[test]
+    fn test_save_writes_indexed_v2() {
+        let mut env = Environment::new();
+        env.define("x".to_string(), Value::Number(1.0)).unwrap();
+
+        let temp = NamedTempFile::new().unwrap();
+        save_environment(&env, temp.path(), SaveOptions {
+            allow_overwrite: true,
+            ..Default::default()
+        }).unwrap();
+
+        let archive = ArchiveReader::open(temp.path(), true).unwrap();
+        assert_eq!(archive.header().version_major, 2);
+        assert_eq!(archive.entries().len(), 1);
+        assert_eq!(archive.metadata().binding_names, vec!["x".to_string()]);
+    }
+
+    #[test]
+    fn test_restore_v1_file() {
+        let mut bindings = HashMap::new();
+        bindings.insert("x".to_string(), SerializedValue::Number(42.0));
+        bindings.insert("flag".to_string(), SerializedValue::Boolean(true));
+        let body = AchBody {
+            metadata: Metadata::new().with_bindings(vec!["flag".to_string(), "x".to_string()]),
+            bindings,
+        };
+
+        for compress in [false, true] {
+            let mut body_bytes = rmp_serde::to_vec(&body).unwrap();
+            let mut header = AchHeader::new();
+            header.version_major = 1;
+            if compress {
+                body_bytes = zstd::encode_all(&body_bytes[..], 3).unwrap();
+                header.compression = crate::format::CompressionType::Zstd;
+                header.set_compressed(true);
+            }
+
+            let mut file = Vec::new();
+            header.write(&mut file).unwrap();
+            file.extend_from_slice(&body_bytes);
+            file.extend_from_slice(&crate::checksum::calculate_checksum(&body_bytes));
+
+            let temp = NamedTempFile::new().unwrap();
+            std::fs::write(temp.path(), file).unwrap();
+
+            let restored = restore_environment(temp.path(), Default::default()).unwrap();
+            assert_eq!(restored.get("x").unwrap(), Value::Number(42.0));
+            assert_eq!(restored.get("flag").unwrap(), Value::Boolean(true));
+            assert_eq!(get_metadata(temp.path()).unwrap().num_bindings, 2);
+        }
+    }
+
+    #[test]
+    fn test_filtered_restore_reads_only_selected_chunks() {
+        use achronyme_types::tensor::RealTensor;
+
+        let mut env = Environment::new();
+        env.define("wanted".to_string(), Value::Number(7.0)).unwrap();
+        env.define("big".to_string(), Value::Tensor(Box::new(RealTensor::vector(vec![1.5; 1000])))).unwrap();
+
+        let temp = NamedTempFile::new().unwrap();
+        save_environment(&env, temp.path(), SaveOptions {
+            compress: false,
+            allow_overwrite: true,
+            ..Default::default()
+        }).unwrap();
+
+        // Corrupt the payload of the binding we don't ask for
+        let big = ArchiveReader::open(temp.path(), true).unwrap().entries()
+            .iter().find(|e| e.name == "big").unwrap().clone();
+        let mut data = std::fs::read(temp.path()).unwrap();
+        data[big.offset as usize + 100] ^= 0xFF;
+        std::fs::write(temp.path(), data).unwrap();
+
+        let restored = restore_environment(temp.path(), RestoreOptions {
+            include_only: Some(vec!["wanted".to_string()]),
+            ..Default::default()
+        }).unwrap();
+        assert_eq!(restored.get("wanted").unwrap(), Value::Number(7.0));
+        assert!(restored.get("big").is_err());
+
+        let result = restore_environment(temp.path(), Default::default());
+        assert!(matches!(result, Err(EnvError::ChecksumMismatch)));
+    }
+
+    #[test]
+    fn test_exclude_prefix_pattern() {
+        let mut env = Environment::new();
+        env.define("tmp_a".to_string(), Value::Number(1.0)).unwrap();
+        env.define("tmp_b".to_string(), Value::Number(2.0)).unwrap();
+        env.define("kept".to_string(), Value::Number(3.0)).unwrap();
+
+        let temp = NamedTempFile::new().unwrap();
+        save_environment(&env, temp.path(), SaveOptions {
+            exclude: vec!["tmp_*".to_string()],
+            allow_overwrite: true,
+            ..Default::default()
+        }).unwrap();
+
+        let metadata = get_metadata(temp.path()).unwrap();
+        assert_eq!(metadata.binding_names, vec!["kept".to_string()]);
+    }
+
+    #[test]
+    fn test_streaming_save_sees_scopes_and_mutable_cells() {
+        use achronyme_types::tensor::RealTensor;
+
+        let mut env = Environment::new();
+        env.define("x".to_string(), Value::Number(1.0)).unwrap();
+        env.define_mutable("counter".to_string(), Value::Number(5.0)).unwrap();
+        env.push_scope();
+        env.define("x".to_string(), Value::Number(2.0)).unwrap();
+        // Large enough to be compressed by the zstd worker threads
+        let big = RealTensor::new((0..200_000).map(|i| i as f64).collect(), vec![200_000]).unwrap();
+        env.define("big".to_string(), Value::Tensor(Box::new(big.clone()))).unwrap();
+
+        let temp = NamedTempFile::new().unwrap();
+        save_environment(&env, temp.path(), SaveOptions {
+            compression_threads: 2,
+            allow_overwrite: true,
+            ..Default::default()
+        }).unwrap();
+        assert!(!partial_path(temp.path()).exists());
+
+        let restored = restore_environment(temp.path(), RestoreOptions::default()).unwrap();
+        assert_eq!(restored.get("x").unwrap(), Value::Number(2.0));
+        assert_eq!(restored.get("counter").unwrap(), Value::Number(5.0));
+        assert_eq!(restored.get("big").unwrap(), Value::Tensor(Box::new(big)));
+    }
 }
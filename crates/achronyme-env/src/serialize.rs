@@ -1,4 +1,6 @@
+use achronyme_types::complex::Complex;
 use achronyme_types::value::Value;
+use serde::ser::{SerializeTupleVariant, Serializer};
 use serde::{Deserialize, Serialize};
 use std::collections::HashMap;
 use crate::errors::{EnvError, Result};
@@ -77,8 +79,8 @@ impl SerializedValue {
                     .map(|(k, v)| (k.clone(), SerializedValue::from_value(v)))
                     .collect();
                 SerializedValue::Edge(
-                    from.clone(),
-                    to.clone(),
+                    from.to_string(),
+                    to.to_string(),
                     *directed,
                     serialized_props,
                 )
@@ -118,12 +120,17 @@ impl SerializedValue {
                 SerializedValue::Unsupported("generator".to_string())
             },
 
+            Value::Sequence(_) => {
+                // Sequences hold lambdas and possibly a generator
+                SerializedValue::Unsupported("sequence".to_string())
+            },
+
             Value::GeneratorYield(_) => {
                 // GeneratorYield is an internal marker and should never be persisted
                 SerializedValue::Unsupported("generator yield".to_string())
             },
 
-            Value::Error { .. } => {
+            Value::Error(_) => {
                 // Errors should not be persisted across sessions
                 SerializedValue::Unsupported("error".to_string())
             },
@@ -153,7 +160,7 @@ impl SerializedValue {
                 use achronyme_types::tensor::RealTensor;
                 let tensor = RealTensor::new(data.clone(), shape.clone())
                     .map_err(|e| EnvError::Deserialization(format!("Invalid tensor: {}", e)))?;
-                Ok(Value::Tensor(tensor))
+                Ok(Value::Tensor(Box::new(tensor)))
             },
 
             SerializedValue::ComplexTensor(shape, data) => {
@@ -167,7 +174,7 @@ impl SerializedValue {
 
                 let tensor = ComplexTensor::new(complex_data, shape.clone())
                     .map_err(|e| EnvError::Deserialization(format!("Invalid complex tensor: {}", e)))?;
-                Ok(Value::ComplexTensor(tensor))
+                Ok(Value::ComplexTensor(Box::new(tensor)))
             },
 
             SerializedValue::Record(map) => {
@@ -175,7 +182,7 @@ impl SerializedValue {
                 for (k, v) in map {
                     record.insert(k.clone(), v.to_value()?);
                 }
-                Ok(Value::Record(record))
+                Ok(Value::Record(Box::new(record)))
             },
 
             SerializedValue::Edge(from, to, directed, properties) => {
@@ -184,10 +191,10 @@ impl SerializedValue {
                     props.insert(k.clone(), v.to_value()?);
                 }
                 Ok(Value::Edge {
-                    from: from.clone(),
-                    to: to.clone(),
+                    from: from.into(),
+                    to: to.into(),
                     directed: *directed,
-                    properties: props,
+                    properties: Box::new(props),
                 })
             },
 
@@ -210,10 +217,109 @@ impl SerializedValue {
     }
 }
 
+/// Borrowing serializer for a `Value`
+///
+/// Produces exactly the encoding of `SerializedValue::from_value(value)`,
+/// so it is read back as a `SerializedValue`, but walks the value in place
+/// instead of building a deep copy first.
+pub struct ValueRef<'a>(pub &'a Value);
+
+/// Type name recorded for values that cannot be persisted
+pub fn unsupported_type(value: &Value) -> Option<&'static str> {
+    match value {
+        Value::Function(func) if func.builtin_name().is_none() => Some("user-defined function"),
+        Value::MutableRef(rc) if rc.try_borrow().is_err() => Some("borrowed mutable reference"),
+        Value::MutableRef(rc) => rc.try_borrow().ok().and_then(|inner| unsupported_type(&inner)),
+        Value::TailCall(_) => Some("tail call"),
+        Value::EarlyReturn(_) => Some("early return"),
+        Value::Generator(_) => Some("generator"),
+        Value::GeneratorYield(_) => Some("generator yield"),
+        Value::Error(_) => Some("error"),
+        _ => None,
+    }
+}
+
+const SERIALIZED_VALUE: &str = "SerializedValue";
+
+impl Serialize for ValueRef<'_> {
+    fn serialize<S: Serializer>(&self, serializer: S) -> std::result::Result<S::Ok, S::Error> {
+        if let Some(type_name) = unsupported_type(self.0) {
+            return serializer.serialize_newtype_variant(SERIALIZED_VALUE, 11, "Unsupported", type_name);
+        }
+
+        match self.0 {
+            Value::Number(n) => serializer.serialize_newtype_variant(SERIALIZED_VALUE, 0, "Number", n),
+            Value::Boolean(b) => serializer.serialize_newtype_variant(SERIALIZED_VALUE, 1, "Boolean", b),
+            Value::String(s) => serializer.serialize_newtype_variant(SERIALIZED_VALUE, 2, "String", s),
+            Value::Complex(c) => {
+                let mut variant = serializer.serialize_tuple_variant(SERIALIZED_VALUE, 3, "Complex", 2)?;
+                variant.serialize_field(&c.re)?;
+                variant.serialize_field(&c.im)?;
+                variant.end()
+            }
+            Value::Vector(items) => serializer.serialize_newtype_variant(SERIALIZED_VALUE, 4, "Vector", &Items(items)),
+            Value::Tensor(tensor) => {
+                let mut variant = serializer.serialize_tuple_variant(SERIALIZED_VALUE, 5, "Tensor", 2)?;
+                variant.serialize_field(tensor.shape())?;
+                variant.serialize_field(tensor.data())?;
+                variant.end()
+            }
+            Value::ComplexTensor(tensor) => {
+                let mut variant = serializer.serialize_tuple_variant(SERIALIZED_VALUE, 6, "ComplexTensor", 2)?;
+                variant.serialize_field(tensor.shape())?;
+                variant.serialize_field(&Pairs(tensor.data()))?;
+                variant.end()
+            }
+            Value::Record(map) => serializer.serialize_newtype_variant(SERIALIZED_VALUE, 7, "Record", &Fields(map)),
+            Value::Edge { from, to, directed, properties } => {
+                let mut variant = serializer.serialize_tuple_variant(SERIALIZED_VALUE, 8, "Edge", 4)?;
+                variant.serialize_field(from.as_str())?;
+                variant.serialize_field(to.as_str())?;
+                variant.serialize_field(directed)?;
+                variant.serialize_field(&Fields(properties))?;
+                variant.end()
+            }
+            Value::Function(func) => {
+                let name = func.builtin_name().unwrap_or_default();
+                serializer.serialize_newtype_variant(SERIALIZED_VALUE, 9, "BuiltinFunction", name)
+            }
+            Value::MutableRef(rc) => ValueRef(&rc.borrow()).serialize(serializer),
+            Value::Null => serializer.serialize_unit_variant(SERIALIZED_VALUE, 10, "Null"),
+            _ => unreachable!("unsupported values are handled above"),
+        }
+    }
+}
+
+struct Items<'a>(&'a [Value]);
+
+impl Serialize for Items<'_> {
+    fn serialize<S: Serializer>(&self, serializer: S) -> std::result::Result<S::Ok, S::Error> {
+        serializer.collect_seq(self.0.iter().map(ValueRef))
+    }
+}
+
+struct Fields<'a>(&'a HashMap<String, Value>);
+
+impl Serialize for Fields<'_> {
+    fn serialize<S: Serializer>(&self, serializer: S) -> std::result::Result<S::Ok, S::Error> {
+        // Sorted so equal records always encode to equal bytes
+        let mut fields: Vec<_> = self.0.iter().collect();
+        fields.sort_unstable_by(|a, b| a.0.cmp(b.0));
+        serializer.collect_map(fields.into_iter().map(|(k, v)| (k, ValueRef(v))))
+    }
+}
+
+struct Pairs<'a>(&'a [Complex]);
+
+impl Serialize for Pairs<'_> {
+    fn serialize<S: Serializer>(&self, serializer: S) -> std::result::Result<S::Ok, S::Error> {
+        serializer.collect_seq(self.0.iter().map(|c| (c.re, c.im)))
+    }
+}
+
 /// Serialize a Value to MessagePack bytes
 pub fn serialize_value(value: &Value) -> Result<Vec<u8>> {
-    let serialized = SerializedValue::from_value(value);
-    rmp_serde::to_vec(&serialized).map_err(EnvError::from)
+    rmp_serde::to_vec(&ValueRef(value)).map_err(EnvError::from)
 }
 
 /// Deserialize a Value from MessagePack bytes
@@ -275,7 +381,7 @@ mod tests {
     #[test]
     fn test_serialize_tensor() {
         let tensor = RealTensor::new(vec![1.0, 2.0, 3.0, 4.0], vec![2, 2]).unwrap();
-        let value = Value::Tensor(tensor);
+        let value = Value::Tensor(Box::new(tensor));
         let bytes = serialize_value(&value).unwrap();
         let restored = deserialize_value(&bytes).unwrap();
         assert_eq!(value, restored);
@@ -287,7 +393,7 @@ mod tests {
         map.insert("x".to_string(), Value::Number(10.0));
         map.insert("name".to_string(), Value::String("test".to_string()));
 
-        let value = Value::Record(map);
+        let value = Value::Record(Box::new(map));
         let bytes = serialize_value(&value).unwrap();
         let restored = deserialize_value(&bytes).unwrap();
         assert_eq!(value, restored);
@@ -299,12 +405,40 @@ mod tests {
         inner.insert("a".to_string(), Value::Number(1.0));
 
         let mut outer = HashMap::new();
-        outer.insert("inner".to_string(), Value::Record(inner));
+        outer.insert("inner".to_string(), Value::Record(Box::new(inner)));
         outer.insert("value".to_string(), Value::Boolean(true));
 
-        let value = Value::Record(outer);
+        let value = Value::Record(Box::new(outer));
         let bytes = serialize_value(&value).unwrap();
         let restored = deserialize_value(&bytes).unwrap();
         assert_eq!(value, restored);
     }
+
+    #[test]
+    fn test_value_ref_matches_serialized_value() {
+        use achronyme_types::tensor::ComplexTensor;
+
+        let mut props = HashMap::new();
+        props.insert("weight".to_string(), Value::Number(2.5));
+        let mut record = HashMap::new();
+        record.insert("t".to_string(), Value::Tensor(Box::new(RealTensor::new(vec![1.0, 2.0], vec![2]).unwrap())));
+        record.insert("nothing".to_string(), Value::Null);
+
+        let values = vec![
+            Value::Number(-1.5),
+            Value::Boolean(false),
+            Value::String("s".to_string()),
+            Value::Complex(Complex::new(1.0, -2.0)),
+            Value::ComplexTensor(Box::new(ComplexTensor::new(vec![Complex::new(1.0, 2.0)], vec![1]).unwrap())),
+            Value::Edge { from: "A".into(), to: "B".into(), directed: true, properties: Box::new(props) },
+            Value::Vector(vec![Value::Record(Box::new(record)), Value::Number(3.0)]),
+            Value::new_mutable(Value::Number(4.0)),
+        ];
+
+        for value in values {
+            let bytes = rmp_serde::to_vec(&ValueRef(&value)).unwrap();
+            let decoded: SerializedValue = rmp_serde::from_slice(&bytes).unwrap();
+            assert_eq!(decoded, SerializedValue::from_value(&value), "{:?}", value);
+        }
+    }
 }
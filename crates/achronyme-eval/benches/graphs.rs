@@ -0,0 +1,68 @@
+use std::collections::HashMap;
+
+use achronyme_eval::functions::FunctionRegistry;
+use achronyme_types::value::Value;
+use achronyme_types::Environment;
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+
+/// Layered scheduling DAG: `width` tasks per layer, each depending on
+/// `fan_in` tasks of the previous layer, with weights and durations
+fn scheduling_network(registry: &FunctionRegistry, layers: usize, width: usize, fan_in: usize) -> Value {
+    let name = |layer: usize, i: usize| format!("t{}_{}", layer, i);
+    let mut edges = Vec::new();
+    let mut nodes = HashMap::new();
+    for layer in 0..layers {
+        for i in 0..width {
+            let mut task = HashMap::new();
+            task.insert("duration".to_string(), Value::Number(((layer * 7 + i * 13) % 11 + 1) as f64));
+            nodes.insert(name(layer, i), Value::Record(Box::new(task)));
+            if layer == 0 {
+                continue;
+            }
+            for k in 0..fan_in {
+                let mut properties = HashMap::new();
+                properties.insert("weight".to_string(), Value::Number(((i + k * 5) % 9 + 1) as f64));
+                edges.push(Value::Edge {
+                    from: name(layer - 1, (i + k * 17) % width).into(),
+                    to: name(layer, i).into(),
+                    directed: true,
+                    properties: Box::new(properties),
+                });
+            }
+        }
+    }
+    registry
+        .call("network", &[Value::Vector(edges), Value::Record(Box::new(nodes))], &mut Environment::new())
+        .unwrap()
+}
+
+fn bench_graph_algorithms(c: &mut Criterion) {
+    let registry = FunctionRegistry::new();
+    let mut env = Environment::new();
+    let mut group = c.benchmark_group("eval/graphs");
+    group.sample_size(10);
+    for (layers, width) in [(50, 200), (100, 1000)] {
+        let fan_in = 5;
+        let network = scheduling_network(&registry, layers, width, fan_in);
+        let edges = (layers - 1) * width * fan_in;
+        group.throughput(Throughput::Elements(edges as u64));
+
+        let start = Value::String("t0_0".to_string());
+        let end = Value::String(format!("t{}_{}", layers - 1, width - 1));
+        group.bench_with_input(BenchmarkId::new("dijkstra", edges), &network, |bench, network| {
+            bench.iter(|| {
+                let args = [black_box(network.clone()), start.clone(), end.clone()];
+                registry.call("dijkstra", &args, &mut env).unwrap()
+            })
+        });
+        for algorithm in ["topological_sort", "connected_components", "pert_analysis"] {
+            group.bench_with_input(BenchmarkId::new(algorithm, edges), &network, |bench, network| {
+                bench.iter(|| registry.call(algorithm, &[black_box(network.clone())], &mut env).unwrap())
+            });
+        }
+    }
+    group.finish();
+}
+
+criterion_group!(benches, bench_graph_algorithms);
+criterion_main!(benches);
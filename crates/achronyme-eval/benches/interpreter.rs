@@ -0,0 +1,54 @@
+use achronyme_eval::Evaluator;
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+
+/// Long scripts where parsing and top-level dispatch dominate
+const PARSE_HEAVY: &[(&str, &str)] = &[
+    ("tensor-slicing", include_str!("../../../examples/soc/34-tensor-slicing.soc")),
+    ("working-scope", include_str!("../../../examples/soc/26-working-scope.soc")),
+    ("dijkstra-complex", include_str!("../../../examples/soc/algorithms/dijkstra_complex_test.soc")),
+];
+
+/// Scripts that spend their time calling lambdas and iterating
+const LOOP_HEAVY: &[(&str, &str)] = &[
+    ("numerical-calculus", include_str!("../../../examples/soc/06-numerical-calculus-suite.soc")),
+    ("pert", include_str!("../../../examples/soc/algorithms/pert_example.soc")),
+    (
+        "while-sum",
+        "mut i = 0\nmut acc = 0\nwhile (i < 20000) { acc = acc + i * i % 7; i = i + 1 }\nacc",
+    ),
+    (
+        "tail-recursion",
+        "let count = (n, acc) => if(n == 0, acc, rec(n - 1, acc + n))\ncount(20000, 0)",
+    ),
+    (
+        "hof-pipeline",
+        "let xs = range(0, 2000)\nreduce((a, b) => a + b, 0, map(x => x * 2, filter(x => x % 3 == 0, xs)))",
+    ),
+];
+
+fn bench_scripts(c: &mut Criterion, group_name: &str, scripts: &[(&str, &str)]) {
+    let mut group = c.benchmark_group(group_name);
+    for &(name, source) in scripts {
+        // A script that stops running would otherwise be measured as a fast one
+        Evaluator::new()
+            .eval_str(source)
+            .unwrap_or_else(|e| panic!("benchmark script '{}' failed: {}", name, e));
+
+        group.throughput(Throughput::Bytes(source.len() as u64));
+        group.bench_with_input(BenchmarkId::from_parameter(name), source, |bench, source| {
+            bench.iter(|| Evaluator::new().eval_str(black_box(source)).unwrap())
+        });
+    }
+    group.finish();
+}
+
+fn bench_parse_heavy(c: &mut Criterion) {
+    bench_scripts(c, "eval/parse_heavy", PARSE_HEAVY);
+}
+
+fn bench_loop_heavy(c: &mut Criterion) {
+    bench_scripts(c, "eval/loop_heavy", LOOP_HEAVY);
+}
+
+criterion_group!(benches, bench_parse_heavy, bench_loop_heavy);
+criterion_main!(benches);
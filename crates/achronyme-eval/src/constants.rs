@@ -1,5 +1,6 @@
 use std::collections::HashMap;
 use std::f64::consts;
+use std::sync::{Arc, OnceLock};
 
 /// Mathematical constants
 pub const PI: f64 = consts::PI;
@@ -28,6 +29,12 @@ pub struct ConstantsRegistry {
 }
 
 impl ConstantsRegistry {
+    /// The process-wide registry of standard constants, built on first use
+    pub fn shared() -> Arc<ConstantsRegistry> {
+        static SHARED: OnceLock<Arc<ConstantsRegistry>> = OnceLock::new();
+        Arc::clone(SHARED.get_or_init(|| Arc::new(ConstantsRegistry::new())))
+    }
+
     /// Create a new constants registry with all standard constants
     pub fn new() -> Self {
         let mut constants = HashMap::new();
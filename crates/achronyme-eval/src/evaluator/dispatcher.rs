@@ -1,6 +1,7 @@
 use achronyme_parser::ast::AstNode;
-use achronyme_types::value::Value;
+use achronyme_types::value::{ErrorValue, Value};
 use crate::handlers;
+use crate::profiler::Phase;
 
 use super::Evaluator;
 
@@ -19,21 +20,44 @@ impl Evaluator {
     /// let result = evaluator.eval_str("2 + 3 * 4").unwrap();
     /// ```
     pub fn eval_str(&mut self, source: &str) -> Result<Value, String> {
-        use achronyme_parser::parse;
+        // Shared with the cache: repeated sources skip the parser
+        let statements = self.profile_phase(Phase::Parse, |ev| ev.parse_cache.parse(source))?;
 
-        let statements = parse(source)?;
+        self.eval_statements(&statements)
+    }
+
+    /// Evaluate a program whose top-level bindings stay defined afterwards
+    ///
+    /// `eval_str` runs a multi-statement program in its own scope, like a
+    /// block. A prelude (definitions every session of a server starts
+    /// from) instead binds into the current scope, as if each statement
+    /// had been evaluated on its own.
+    pub fn eval_prelude(&mut self, source: &str) -> Result<Value, String> {
+        let statements = self.profile_phase(Phase::Parse, |ev| ev.parse_cache.parse(source))?;
+        match statements.as_slice() {
+            [AstNode::Sequence { statements }] => self.eval_statements(statements),
+            statements => self.eval_statements(statements),
+        }
+    }
 
+    /// Evaluate top-level statements in order, returning the last value
+    fn eval_statements(&mut self, statements: &[AstNode]) -> Result<Value, String> {
         if statements.is_empty() {
             return Err("No statements to evaluate".to_string());
         }
 
         // Evaluate all statements, return the last one
-        let mut result = Value::Number(0.0);
-        for stmt in &statements {
-            result = self.evaluate(stmt)?;
-        }
-
-        Ok(result)
+        self.profile_script(|ev| {
+            let mut result = Value::Number(0.0);
+            for stmt in statements.iter() {
+                result = if ev.bytecode_mode {
+                    ev.evaluate_compiled(stmt)?
+                } else {
+                    ev.evaluate(stmt)?
+                };
+            }
+            Ok(result)
+        })
     }
 
     /// Evaluate an AST node and return the result
@@ -41,6 +65,7 @@ impl Evaluator {
     /// This is the main dispatch method that routes AST nodes to their
     /// appropriate handler functions.
     pub fn evaluate(&mut self, node: &AstNode) -> Result<Value, String> {
+        self.check_deadline()?;
         match node {
             // Literals
             AstNode::Number(n) => handlers::literals::evaluate_number(*n),
@@ -55,7 +80,10 @@ impl Evaluator {
             AstNode::VariableDecl { name, type_annotation, initializer } => {
                 handlers::variables::evaluate_declaration(self, name, type_annotation, initializer)
             }
-            AstNode::VariableRef(name) => handlers::variables::evaluate_reference(self, name),
+            AstNode::VariableRef(name) => handlers::variables::evaluate_reference(self, *name),
+            AstNode::LocalRef { name, depth, index } => {
+                handlers::variables::evaluate_local_reference(self, *name, *depth, *index)
+            }
             AstNode::MutableDecl { name, type_annotation, initializer } => {
                 handlers::variables::evaluate_mutable_declaration(self, name, type_annotation, initializer)
             }
@@ -118,6 +146,9 @@ impl Evaluator {
 
             // Operations
             AstNode::BinaryOp { op, left, right } => {
+                if self.fusion_mode && handlers::binary_ops::fusion::is_fusible_chain(op, left, right) {
+                    return handlers::binary_ops::fusion::evaluate_fused(self, op, left, right);
+                }
                 let left_val = self.evaluate(left)?;
                 let right_val = self.evaluate(right)?;
                 handlers::binary_ops::apply(op, left_val, right_val)
@@ -140,7 +171,7 @@ impl Evaluator {
 
             // Edges (graph/network support)
             AstNode::Edge { from, to, directed, metadata } => {
-                handlers::literals::evaluate_edge(self, from, to, *directed, metadata)
+                handlers::literals::evaluate_edge(self, *from, *to, *directed, metadata)
             }
 
             // Indexing and slicing
@@ -192,6 +223,11 @@ impl Evaluator {
     /// Evaluate field access on records and edges
     fn evaluate_field_access(&mut self, record: &AstNode, field: &str) -> Result<Value, String> {
         let record_value = self.evaluate(record)?;
+        Self::access_field(record_value, field)
+    }
+
+    /// Read a field of an already evaluated record/edge/error value
+    pub(crate) fn access_field(record_value: Value, field: &str) -> Result<Value, String> {
         match record_value {
             Value::Record(ref map) => {
                 let field_value = map.get(field)
@@ -203,8 +239,8 @@ impl Evaluator {
             Value::Edge { from, to, directed, properties } => {
                 // Handle special fields
                 match field {
-                    "from" => Ok(Value::String(from.clone())),
-                    "to" => Ok(Value::String(to.clone())),
+                    "from" => Ok(Value::String(from.to_string())),
+                    "to" => Ok(Value::String(to.to_string())),
                     "directed" => Ok(Value::Boolean(directed)),
                     // Otherwise, look in properties
                     _ => properties.get(field)
@@ -225,8 +261,9 @@ impl Evaluator {
                     _ => Err(format!("Generators only have a 'next' method, not '{}'", field)),
                 }
             }
-            Value::Error { message, kind, source } => {
+            Value::Error(error) => {
                 // Error field access
+                let ErrorValue { message, kind, source } = *error;
                 match field {
                     "message" => Ok(Value::String(message)),
                     "kind" => match kind {
@@ -315,7 +352,7 @@ impl Evaluator {
         // Must be a function
         match func_value {
             Value::Function(ref func) => {
-                match func {
+                match &**func {
                     achronyme_types::function::Function::UserDefined { .. } => {
                         // User-defined lambda - evaluate args and apply
                         let mut arg_values = Vec::new();
@@ -19,14 +19,22 @@
 //!   5. eval(2+12) → 14
 //! ```
 
-use achronyme_types::Environment;
+use achronyme_types::{Environment, Forker};
 use achronyme_types::value::Value;
 use achronyme_parser::type_annotation::TypeAnnotation;
+use achronyme_parser::ParseCache;
 use std::collections::HashMap;
+use std::rc::Rc;
+use std::sync::Arc;
+use std::time::Instant;
+use achronyme_parser::ast::AstNode;
 
 use crate::constants::ConstantsRegistry;
 use crate::functions::FunctionRegistry;
-use crate::modules::{ModuleRegistry, create_builtin_registry};
+use crate::modules::{ModuleRegistry, shared_builtin_registry};
+use crate::native::specialize::Specialized;
+use crate::profiler::Profiler;
+use crate::vm::Chunk;
 
 // Module declarations
 mod state;
@@ -34,24 +42,38 @@ mod modules;
 mod lambda_eval;
 mod dispatcher;
 
+pub(crate) use modules::CachedModule;
+use modules::fork_values;
+
+/// Steps (AST nodes, VM jumps and calls, native recursions) between two
+/// reads of the clock while a deadline is set
+pub(crate) const DEADLINE_STRIDE: u32 = 1024;
+
+/// Error of an evaluation stopped by its deadline
+pub(crate) const DEADLINE_ERROR: &str = "Evaluation timed out";
+
 /// Evaluator
 ///
 /// Walks the AST and computes the result.
 pub struct Evaluator {
     pub(crate) env: Environment,
-    pub(crate) constants: ConstantsRegistry,
-    pub(crate) functions: FunctionRegistry,
+    /// Builtin registries are immutable and shared by every evaluator in
+    /// the process (`functions_mut` copies on write)
+    pub(crate) constants: Arc<ConstantsRegistry>,
+    pub(crate) functions: Arc<FunctionRegistry>,
     /// Module registry for organizing functions into modules
-    pub(crate) module_registry: ModuleRegistry,
+    pub(crate) module_registry: Arc<ModuleRegistry>,
     /// Track which modules have been imported
     /// Format: local_name -> (module_name, original_name)
     pub(crate) imported_modules: HashMap<String, (String, String)>,
     /// Track exported values from current module (for user-defined modules)
     /// Format: name -> Value
     pub(crate) exported_values: HashMap<String, Value>,
-    /// Cache of loaded user modules to avoid re-parsing
-    /// Format: module_path -> HashMap<name, Value>
-    pub(crate) module_cache: HashMap<String, HashMap<String, Value>>,
+    /// Cache of loaded user modules, reused while the file is unchanged
+    /// Format: resolved file path -> exports and file stamp
+    pub(crate) module_cache: HashMap<String, CachedModule>,
+    /// Parsed ASTs of `eval_str` sources and module files, by content hash
+    pub(crate) parse_cache: ParseCache,
     /// Current file being evaluated (for relative imports)
     /// This is the directory path of the file currently being evaluated
     pub(crate) current_file_dir: Option<String>,
@@ -63,6 +85,25 @@ pub struct Evaluator {
     pub(crate) type_registry: HashMap<String, TypeAnnotation>,
     /// Track if we're currently inside a generator (for yield validation)
     pub(crate) in_generator: bool,
+    /// Run statements and function bodies on the bytecode VM when possible
+    pub(crate) bytecode_mode: bool,
+    /// Evaluate chains of element-wise tensor arithmetic in a single pass
+    pub(crate) fusion_mode: bool,
+    /// Compiled function bodies, keyed by the address of the body `Rc`
+    /// Format: body address -> (body, chunk or None if the compiler refused it)
+    pub(crate) compiled_functions: HashMap<usize, (Rc<AstNode>, Option<Rc<Chunk>>)>,
+    /// Native programs of closures with all-`Number` parameters
+    /// Format: (body address, closure env address) -> specialization
+    pub(crate) specialized_functions: HashMap<(usize, usize), Specialized>,
+    /// Call timings and phase times while profiling is enabled
+    pub(crate) profiler: Option<Box<Profiler>>,
+    /// Whether file builtins and module imports may read or write files
+    /// (see `disable_file_io`)
+    pub(crate) file_io: bool,
+    /// Evaluation fails once this instant has passed (see `set_deadline`)
+    pub(crate) deadline: Option<Instant>,
+    /// Steps counted since the deadline was set, for `DEADLINE_STRIDE`
+    pub(crate) deadline_ticks: u32,
 }
 
 impl Evaluator {
@@ -70,16 +111,64 @@ impl Evaluator {
     pub fn new() -> Self {
         Self {
             env: Environment::new(),
-            constants: ConstantsRegistry::new(),
-            functions: FunctionRegistry::new(),
-            module_registry: create_builtin_registry(),
+            constants: ConstantsRegistry::shared(),
+            functions: FunctionRegistry::shared(),
+            module_registry: shared_builtin_registry(),
             imported_modules: HashMap::new(),
             exported_values: HashMap::new(),
             module_cache: HashMap::new(),
+            parse_cache: ParseCache::new(),
             current_file_dir: None,
             tco_mode: false,
             type_registry: HashMap::new(),
             in_generator: false,
+            bytecode_mode: false,
+            fusion_mode: false,
+            compiled_functions: HashMap::new(),
+            specialized_functions: HashMap::new(),
+            profiler: None,
+            file_io: true,
+            deadline: None,
+            deadline_ticks: 0,
+        }
+    }
+
+    /// Create an independent evaluator that starts from this one's state
+    ///
+    /// Bindings, imports, exports, type aliases and modes carry over. `mut`
+    /// cells and generators are copied, so nothing the fork does is visible
+    /// here or in other forks. Builtin registries, parsed ASTs and compiled
+    /// bodies stay shared, which makes forking a warm evaluator (one that
+    /// ran a prelude) much cheaper than building a new one and re-running
+    /// the prelude.
+    pub fn fork(&self) -> Evaluator {
+        let mut forker = Forker::new();
+        Self {
+            env: forker.environment(&self.env),
+            constants: Arc::clone(&self.constants),
+            functions: Arc::clone(&self.functions),
+            module_registry: Arc::clone(&self.module_registry),
+            imported_modules: self.imported_modules.clone(),
+            exported_values: fork_values(&self.exported_values, &mut forker),
+            module_cache: self
+                .module_cache
+                .iter()
+                .map(|(path, module)| (path.clone(), module.fork_with(&mut forker)))
+                .collect(),
+            parse_cache: self.parse_cache.clone(),
+            current_file_dir: self.current_file_dir.clone(),
+            tco_mode: self.tco_mode,
+            type_registry: self.type_registry.clone(),
+            in_generator: self.in_generator,
+            bytecode_mode: self.bytecode_mode,
+            fusion_mode: self.fusion_mode,
+            compiled_functions: self.compiled_functions.clone(),
+            // Native programs keep per-call frames; forks compile their own
+            specialized_functions: HashMap::new(),
+            profiler: None,
+            file_io: self.file_io,
+            deadline: None,
+            deadline_ticks: 0,
         }
     }
 
@@ -1,21 +1,65 @@
 use achronyme_types::value::Value;
+use achronyme_types::Forker;
 use std::collections::HashMap;
+use std::time::SystemTime;
+
+use crate::profiler::Phase;
 
 use super::Evaluator;
 
+/// Exports of an evaluated user module, with the stamp of the file they
+/// came from
+#[derive(Debug, Clone)]
+pub(crate) struct CachedModule {
+    stamp: FileStamp,
+    exports: HashMap<String, Value>,
+}
+
+impl CachedModule {
+    /// Copy for a forked evaluator, sharing `forker` with its environment
+    pub(crate) fn fork_with(&self, forker: &mut Forker) -> CachedModule {
+        CachedModule {
+            stamp: self.stamp,
+            exports: fork_values(&self.exports, forker),
+        }
+    }
+}
+
+/// `values` with their mutable state copied by `forker`
+pub(crate) fn fork_values(values: &HashMap<String, Value>, forker: &mut Forker) -> HashMap<String, Value> {
+    values.iter().map(|(name, value)| (name.clone(), forker.value(value))).collect()
+}
+
+/// Modification time and length of a module file
+///
+/// The length catches rewrites within the file system's mtime resolution.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+struct FileStamp {
+    modified: Option<SystemTime>,
+    len: u64,
+}
+
+impl FileStamp {
+    fn of(path: &str) -> Option<Self> {
+        let metadata = std::fs::metadata(path).ok()?;
+        Some(Self {
+            modified: metadata.modified().ok(),
+            len: metadata.len(),
+        })
+    }
+}
+
 /// Module loading and management
 impl Evaluator {
     /// Load and evaluate a user module from a file path
     /// Returns the exported values from the module
+    ///
+    /// Exports are cached per resolved path and reused until the file's
+    /// modification time or size changes; a changed file is re-read and its
+    /// AST looked up in the parse cache by content.
     pub fn load_user_module(&mut self, module_path: &str) -> Result<HashMap<String, Value>, String> {
         use std::fs;
         use std::path::Path;
-        use achronyme_parser::parse;
-
-        // Check cache first
-        if let Some(cached_exports) = self.module_cache.get(module_path) {
-            return Ok(cached_exports.clone());
-        }
 
         // Add .soc extension if missing
         let module_path_with_ext = if module_path.ends_with(".soc") {
@@ -37,12 +81,30 @@ impl Evaluator {
             module_path_with_ext
         };
 
+        // Without file access only modules loaded before it was disabled
+        // (by a server's prelude) can be imported
+        if !self.file_io {
+            return self
+                .module_cache
+                .get(&resolved_path)
+                .map(|cached| cached.exports.clone())
+                .ok_or_else(|| format!("Cannot import '{}': file access is disabled here", resolved_path));
+        }
+
+        // Check cache first
+        let stamp = FileStamp::of(&resolved_path);
+        if let Some(cached) = self.module_cache.get(&resolved_path) {
+            if stamp.is_some() && Some(cached.stamp) == stamp {
+                return Ok(cached.exports.clone());
+            }
+        }
+
         // Read the file
         let file_content = fs::read_to_string(&resolved_path)
             .map_err(|e| format!("Failed to read module '{}': {}", resolved_path, e))?;
 
         // Parse the module
-        let statements = parse(&file_content)?;
+        let statements = self.profile_phase(Phase::Parse, |ev| ev.parse_cache.parse(&file_content))?;
 
         // Save the current file directory and set new one for this module
         let old_file_dir = self.current_file_dir.clone();
@@ -55,7 +117,7 @@ impl Evaluator {
         self.env.push_scope();
 
         // Evaluate all statements in the module
-        for stmt in &statements {
+        for stmt in statements.iter() {
             self.evaluate(stmt)?;
         }
 
@@ -71,8 +133,13 @@ impl Evaluator {
         // Clear exported values (they've been captured)
         self.exported_values.clear();
 
-        // Cache the module
-        self.module_cache.insert(module_path.to_string(), module_exports.clone());
+        // Cache the module (files whose stamp can't be read are never reused)
+        if let Some(stamp) = stamp {
+            self.module_cache.insert(resolved_path, CachedModule {
+                stamp,
+                exports: module_exports.clone(),
+            });
+        }
 
         Ok(module_exports)
     }
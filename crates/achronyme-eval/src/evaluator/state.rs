@@ -2,10 +2,15 @@ use achronyme_types::Environment;
 use crate::constants::ConstantsRegistry;
 use crate::functions::FunctionRegistry;
 use crate::modules::ModuleRegistry;
+use crate::profiler::Profiler;
 use achronyme_types::value::Value;
+use achronyme_parser::ParseCache;
+use achronyme_types::tensor::allocations;
 use std::collections::HashMap;
+use std::sync::Arc;
+use std::time::Instant;
 
-use super::Evaluator;
+use super::{Evaluator, DEADLINE_ERROR, DEADLINE_STRIDE};
 
 /// State management methods for Evaluator
 impl Evaluator {
@@ -30,8 +35,55 @@ impl Evaluator {
     }
 
     /// Get mutable functions registry (for handlers)
+    ///
+    /// The first call gives this evaluator a private copy of the shared
+    /// registry.
     pub fn functions_mut(&mut self) -> &mut FunctionRegistry {
-        &mut self.functions
+        Arc::make_mut(&mut self.functions)
+    }
+
+    /// Make evaluation fail once `deadline` has passed; `None` removes the
+    /// limit
+    ///
+    /// The clock is read every `DEADLINE_STRIDE` steps, so a runaway loop or
+    /// recursion stops shortly after the deadline. `try`/`catch` does not
+    /// catch the timeout.
+    pub fn set_deadline(&mut self, deadline: Option<Instant>) {
+        self.deadline = deadline;
+        self.deadline_ticks = 0;
+    }
+
+    /// The current deadline, if any
+    pub fn deadline(&self) -> Option<Instant> {
+        self.deadline
+    }
+
+    /// Whether the deadline has passed
+    pub(crate) fn deadline_passed(&self) -> bool {
+        self.deadline.map_or(false, |deadline| Instant::now() >= deadline)
+    }
+
+    /// Count one step against the deadline
+    #[inline]
+    pub(crate) fn check_deadline(&mut self) -> Result<(), String> {
+        let Some(deadline) = self.deadline else {
+            return Ok(());
+        };
+        self.deadline_ticks = self.deadline_ticks.wrapping_add(1);
+        if self.deadline_ticks % DEADLINE_STRIDE == 0 && Instant::now() >= deadline {
+            return Err(DEADLINE_ERROR.to_string());
+        }
+        Ok(())
+    }
+
+    /// Keep this evaluator and its forks off the file system: the file
+    /// builtins (`save_env`, `restore_env`, `env_info`, `compact_env`) fail,
+    /// only modules already loaded can be imported, and the parse cache stops
+    /// reading and writing its on-disk directory
+    pub fn disable_file_io(&mut self) {
+        self.file_io = false;
+        self.parse_cache.set_disk_cache(None);
+        crate::function_modules::io::disable_functions(self.functions_mut());
     }
 
     /// Get the module registry
@@ -59,6 +111,73 @@ impl Evaluator {
         self.tco_mode = enabled;
     }
 
+    /// Check if bytecode mode is enabled
+    pub fn is_bytecode_mode(&self) -> bool {
+        self.bytecode_mode
+    }
+
+    /// Enable or disable the bytecode VM
+    ///
+    /// When enabled, `eval_str` compiles each statement and user-defined
+    /// function bodies are compiled on first call; anything the compiler
+    /// can't handle keeps running on the tree-walker.
+    pub fn set_bytecode_mode(&mut self, enabled: bool) {
+        self.bytecode_mode = enabled;
+        if !enabled {
+            self.compiled_functions.clear();
+        }
+    }
+
+    /// Check if expression fusion mode is enabled
+    pub fn is_fusion_mode(&self) -> bool {
+        self.fusion_mode
+    }
+
+    /// Enable or disable fused evaluation of element-wise tensor chains
+    ///
+    /// When enabled, `a*x + b*y - c` over same-shape tensors runs as one
+    /// pass over memory instead of allocating a temporary per operator.
+    /// Applies to tree-walked code; the bytecode VM lowers operators itself.
+    pub fn set_fusion_mode(&mut self, enabled: bool) {
+        self.fusion_mode = enabled;
+    }
+
+    /// Check if profiling is enabled
+    pub fn is_profiling(&self) -> bool {
+        self.profiler.is_some()
+    }
+
+    /// Enable or disable the profiler
+    ///
+    /// Enabling starts an empty profile (or keeps the running one) and turns
+    /// on tensor allocation counting for this thread; disabling discards the
+    /// profile. Read results with `profiler()` before disabling.
+    pub fn set_profiling(&mut self, enabled: bool) {
+        if enabled {
+            if self.profiler.is_none() {
+                allocations::set_allocation_tracking(true);
+                self.profiler = Some(Box::new(Profiler::new()));
+            }
+        } else if self.profiler.take().is_some() {
+            allocations::set_allocation_tracking(false);
+        }
+    }
+
+    /// Get the profile collected since profiling was enabled
+    pub fn profiler(&self) -> Option<&Profiler> {
+        self.profiler.as_deref()
+    }
+
+    /// Get the parse cache used by `eval_str` and module imports
+    pub fn parse_cache(&self) -> &ParseCache {
+        &self.parse_cache
+    }
+
+    /// Get the mutable parse cache (e.g. to enable its on-disk cache)
+    pub fn parse_cache_mut(&mut self) -> &mut ParseCache {
+        &mut self.parse_cache
+    }
+
     /// Set the current file directory (for relative imports)
     /// This should be called when loading a file from disk
     pub fn set_current_file_dir(&mut self, file_path: &str) {
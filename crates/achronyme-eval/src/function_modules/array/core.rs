@@ -73,6 +73,43 @@ pub fn product(args: &[Value], _env: &mut Environment) -> Result<Value, String>
 ///
 /// Performance: O(n) where n = abs((end - start) / step)
 pub fn range(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
+    let (start, end, step) = range_bounds(args)?;
+
+    // Generate range
+    let mut result = Vec::new();
+    let mut current = start;
+
+    // Avoid infinite loops by limiting iterations
+    const MAX_ITERATIONS: usize = 1_000_000;
+    let mut iterations = 0;
+
+    if step > 0.0 {
+        while current < end && iterations < MAX_ITERATIONS {
+            result.push(Value::Number(current));
+            current += step;
+            iterations += 1;
+        }
+    } else {
+        while current > end && iterations < MAX_ITERATIONS {
+            result.push(Value::Number(current));
+            current += step;
+            iterations += 1;
+        }
+    }
+
+    if iterations >= MAX_ITERATIONS {
+        return Err("range() exceeded maximum iterations (1,000,000)".to_string());
+    }
+
+    Ok(Value::Vector(result))
+}
+
+/// Validate range(start, end, step?) arguments, returning (start, end, step)
+/// with the default step filled in
+///
+/// Shared with lazy sequences, which iterate the same bounds without
+/// materializing them.
+pub(crate) fn range_bounds(args: &[Value]) -> Result<(f64, f64, f64), String> {
     // Validate argument count
     if args.len() < 2 || args.len() > 3 {
         return Err("range() expects 2 or 3 arguments: range(start, end, step?)".to_string());
@@ -117,33 +154,7 @@ pub fn range(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
         );
     }
 
-    // Generate range
-    let mut result = Vec::new();
-    let mut current = start;
-
-    // Avoid infinite loops by limiting iterations
-    const MAX_ITERATIONS: usize = 1_000_000;
-    let mut iterations = 0;
-
-    if step > 0.0 {
-        while current < end && iterations < MAX_ITERATIONS {
-            result.push(Value::Number(current));
-            current += step;
-            iterations += 1;
-        }
-    } else {
-        while current > end && iterations < MAX_ITERATIONS {
-            result.push(Value::Number(current));
-            current += step;
-            iterations += 1;
-        }
-    }
-
-    if iterations >= MAX_ITERATIONS {
-        return Err("range() exceeded maximum iterations (1,000,000)".to_string());
-    }
-
-    Ok(Value::Vector(result))
+    Ok((start, end, step))
 }
 
 /// Get the length of an array, vector, or tensor
@@ -203,7 +214,7 @@ pub fn reverse(args: &[Value], _env: &mut Environment) -> Result<Value, String>
             )
             .map_err(|e| format!("Failed to create reversed tensor: {}", e))?;
 
-            Ok(Value::Tensor(reversed))
+            Ok(Value::Tensor(Box::new(reversed)))
         }
         Value::ComplexTensor(tensor) => {
             // Only support 1D tensors (vectors)
@@ -223,7 +234,7 @@ pub fn reverse(args: &[Value], _env: &mut Environment) -> Result<Value, String>
             )
             .map_err(|e| format!("Failed to create reversed tensor: {}", e))?;
 
-            Ok(Value::ComplexTensor(reversed))
+            Ok(Value::ComplexTensor(Box::new(reversed)))
         }
         Value::String(s) => {
             // Bonus: also support string reversal
@@ -3,14 +3,16 @@
 //! This module provides array transformation operations:
 //! - zip(array1, array2) - Combine two arrays into pairs
 //! - flatten(nestedArray, depth?) - Flatten nested arrays
-//! - take(array, n) - Take first n elements
+//! - take(array, n) - Take first n elements (lazily for sequences and generators)
 //! - drop(array, n) - Skip first n elements
 //! - slice(array, start, end?) - Extract subarray
 //! - unique(array) - Remove duplicates
 //! - chunk(array, size) - Split into chunks
 
+use achronyme_types::sequence::{Sequence, SequenceSource, SequenceStage};
 use achronyme_types::value::Value;
 use achronyme_types::Environment;
+use std::rc::Rc;
 
 /// Combine two arrays element-wise into an array of pairs
 ///
@@ -109,26 +111,43 @@ fn flatten_recursive(array: &[Value], depth: usize) -> Vec<Value> {
 /// - take([1, 2], 5) => [1, 2] (returns all if n > length)
 /// - take([], 3) => []
 /// - take([1, 2, 3], 0) => []
+/// - take(gen, 3) => sequence of the generator's next 3 values
 ///
-/// Performance: O(min(n, length))
+/// Performance: O(min(n, length)); O(1) for sequences and generators
 pub fn take(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
+    // Lazy input stays lazy: only the first n elements will ever be pulled
+    let lazy = match &args[0] {
+        Value::Sequence(seq) => Some((**seq).clone()),
+        Value::Generator(gen) => Some(Sequence::new(SequenceSource::Generator(gen.clone()))),
+        _ => None,
+    };
+    if let Some(sequence) = lazy {
+        let n = take_count(&args[1])?;
+        return Ok(Value::Sequence(Rc::new(sequence.then(SequenceStage::Take(n)))));
+    }
+
     let array = match &args[0] {
         Value::Vector(v) => v,
         _ => return Err("take() requires an array as first argument".to_string()),
     };
 
-    let n = match &args[1] {
+    let n = take_count(&args[1])?;
+
+    let take_count = n.min(array.len());
+    Ok(Value::Vector(array[..take_count].to_vec()))
+}
+
+/// Element count for take(), a non-negative integer
+pub(crate) fn take_count(value: &Value) -> Result<usize, String> {
+    match value {
         Value::Number(num) => {
             if *num < 0.0 || *num != num.floor() {
                 return Err("take() count must be a non-negative integer".to_string());
             }
-            *num as usize
+            Ok(*num as usize)
         }
-        _ => return Err("take() count must be a number".to_string()),
-    };
-
-    let take_count = n.min(array.len());
-    Ok(Value::Vector(array[..take_count].to_vec()))
+        _ => Err("take() count must be a number".to_string()),
+    }
 }
 
 /// Skip the first n elements from an array
@@ -10,7 +10,7 @@ macro_rules! unary_math_fn {
                 let data: Vec<f64> = t.data().iter().map(|&x| $f(x)).collect();
                 let result = achronyme_types::tensor::RealTensor::new(data, t.shape().to_vec())
                     .map_err(|e| format!("{}(): {}", $name, e))?;
-                Ok(achronyme_types::value::Value::Tensor(result))
+                Ok(achronyme_types::value::Value::Tensor(Box::new(result)))
             }
 
             // Legacy Vector support (backward compatibility)
@@ -36,7 +36,7 @@ fn real(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             let data: Vec<f64> = t.data().iter().map(|c| c.re).collect();
             let tensor = achronyme_types::tensor::RealTensor::new(data, t.shape().to_vec())
                 .map_err(|e| format!("real(): {}", e))?;
-            Ok(Value::Tensor(tensor))
+            Ok(Value::Tensor(Box::new(tensor)))
         }
 
         // Legacy Vector support (backward compatibility)
@@ -67,14 +67,14 @@ fn imag(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             let data = vec![0.0; t.size()];
             let tensor = achronyme_types::tensor::RealTensor::new(data, t.shape().to_vec())
                 .map_err(|e| format!("imag(): {}", e))?;
-            Ok(Value::Tensor(tensor))
+            Ok(Value::Tensor(Box::new(tensor)))
         }
         Value::ComplexTensor(t) => {
             // Extract imaginary parts from complex tensor
             let data: Vec<f64> = t.data().iter().map(|c| c.im).collect();
             let tensor = achronyme_types::tensor::RealTensor::new(data, t.shape().to_vec())
                 .map_err(|e| format!("imag(): {}", e))?;
-            Ok(Value::Tensor(tensor))
+            Ok(Value::Tensor(Box::new(tensor)))
         }
 
         // Legacy Vector support (backward compatibility)
@@ -109,7 +109,9 @@ fn conj(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             }
             Ok(Value::Vector(conjugates))
         }
-        _ => Err("conj() requires a number, complex number, or vector".to_string()),
+        Value::Tensor(_) => Ok(args[0].clone()),
+        Value::ComplexTensor(t) => Ok(Value::ComplexTensor(Box::new(t.conj()))),
+        _ => Err("conj() requires a number, complex number, vector, or tensor".to_string()),
     }
 }
 
@@ -117,6 +119,7 @@ fn arg(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
     match &args[0] {
         Value::Number(x) => Ok(Value::Number(if *x >= 0.0 { 0.0 } else { std::f64::consts::PI })),
         Value::Complex(c) => Ok(Value::Number(c.im.atan2(c.re))),
-        _ => Err("arg() requires a number or complex number".to_string()),
+        Value::ComplexTensor(t) => Ok(Value::Tensor(Box::new(t.phase()))),
+        _ => Err("arg() requires a number, complex number, or complex tensor".to_string()),
     }
 }
@@ -1,6 +1,22 @@
 use crate::functions::FunctionRegistry;
 use achronyme_types::value::Value;
 use achronyme_types::Environment;
+use achronyme_types::complex::Complex;
+use achronyme_types::tensor::{complex_kernels, RealTensor};
+
+/// Longest signal a builtin builds from a requested length (128 MiB of f64)
+///
+/// Lengths come straight from user code; past this a typo or a hostile
+/// script would stall the evaluator in one allocation it can't interrupt.
+const MAX_GENERATED_LEN: usize = 1 << 24;
+
+/// `n` as a length a builtin may allocate
+fn generated_len(name: &str, n: usize) -> Result<usize, String> {
+    if n > MAX_GENERATED_LEN {
+        return Err(format!("{}() length {} exceeds the maximum of {}", name, n, MAX_GENERATED_LEN));
+    }
+    Ok(n)
+}
 
 pub fn register_functions(registry: &mut FunctionRegistry) {
     // FFT functions
@@ -8,11 +24,18 @@ pub fn register_functions(registry: &mut FunctionRegistry) {
     registry.register("ifft", ifft, 1);
     registry.register("fft_mag", fft_mag, 1);
     registry.register("fft_phase", fft_phase, 1);
+    registry.register("rfft", rfft, 1);
+    registry.register("irfft", irfft, 2);
 
     // Convolution
     registry.register("conv", conv, 2);
     registry.register("conv_fft", conv_fft, 2);
 
+    // Short-time Fourier transform
+    registry.register("stft", stft, -1); // Variadic: 3 to 5 args
+    registry.register("istft", istft, -1); // Variadic: 3 to 5 args
+    registry.register("spectrogram", spectrogram, -1); // Variadic: 3 to 5 args
+
     // Window functions
     registry.register("hanning", hanning, 1);
     registry.register("hamming", hamming, 1);
@@ -34,7 +57,7 @@ fn fft(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             }
             let spectrum = achronyme_dsp::fft::fft_real(t.data());
             let result = achronyme_types::tensor::ComplexTensor::vector(spectrum);
-            Ok(Value::ComplexTensor(result))
+            Ok(Value::ComplexTensor(Box::new(result)))
         }
 
         // Legacy Vector support (backward compatibility)
@@ -45,7 +68,7 @@ fn fft(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             let tensor = Value::to_real_tensor(vec).map_err(|e| e.to_string())?;
             let spectrum = achronyme_dsp::fft::fft_real(tensor.data());
             let result = achronyme_types::tensor::ComplexTensor::vector(spectrum);
-            Ok(Value::ComplexTensor(result))
+            Ok(Value::ComplexTensor(Box::new(result)))
         }
 
         _ => Err("fft() requires a vector or tensor".to_string()),
@@ -61,7 +84,7 @@ fn ifft(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             }
             let real_data = achronyme_dsp::fft::ifft_real(t.data());
             let result = achronyme_types::tensor::RealTensor::vector(real_data);
-            Ok(Value::Tensor(result))
+            Ok(Value::Tensor(Box::new(result)))
         }
 
         // Legacy Vector support (backward compatibility)
@@ -72,13 +95,20 @@ fn ifft(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             let tensor = Value::to_complex_tensor(vec).map_err(|e| e.to_string())?;
             let real_data = achronyme_dsp::fft::ifft_real(tensor.data());
             let result = achronyme_types::tensor::RealTensor::vector(real_data);
-            Ok(Value::Tensor(result))
+            Ok(Value::Tensor(Box::new(result)))
         }
 
         _ => Err("ifft() requires a complex vector or complex tensor".to_string()),
     }
 }
 
+/// Real vector of `kernel` applied to each bin of `spectrum`
+fn spectrum_map(spectrum: &[Complex], kernel: fn(&[Complex], &mut [f64])) -> RealTensor {
+    let mut values = vec![0.0; spectrum.len()];
+    kernel(spectrum, &mut values);
+    RealTensor::vector(values)
+}
+
 fn fft_mag(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
     match &args[0] {
         // Tensor support (optimized path) - Real input
@@ -87,9 +117,8 @@ fn fft_mag(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
                 return Err("fft_mag() requires a rank-1 tensor (vector)".to_string());
             }
             let spectrum = achronyme_dsp::fft::fft_real(t.data());
-            let magnitudes: Vec<f64> = spectrum.iter().map(|c| c.norm()).collect();
-            let result = achronyme_types::tensor::RealTensor::vector(magnitudes);
-            Ok(Value::Tensor(result))
+            let result = spectrum_map(&spectrum, complex_kernels::abs);
+            Ok(Value::Tensor(Box::new(result)))
         }
 
         // Tensor support (optimized path) - Complex input
@@ -97,9 +126,8 @@ fn fft_mag(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             if !t.is_vector() {
                 return Err("fft_mag() requires a rank-1 tensor (vector)".to_string());
             }
-            let magnitudes: Vec<f64> = t.data().iter().map(|c| c.norm()).collect();
-            let result = achronyme_types::tensor::RealTensor::vector(magnitudes);
-            Ok(Value::Tensor(result))
+            let result = spectrum_map(t.data(), complex_kernels::abs);
+            Ok(Value::Tensor(Box::new(result)))
         }
 
         // Legacy Vector support (backward compatibility)
@@ -109,15 +137,13 @@ fn fft_mag(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             }
             if vec.iter().any(|v| matches!(v, Value::Complex(_))) {
                 let tensor = Value::to_complex_tensor(vec).map_err(|e| e.to_string())?;
-                let magnitudes: Vec<f64> = tensor.data().iter().map(|c| c.norm()).collect();
-                let result = achronyme_types::tensor::RealTensor::vector(magnitudes);
-                Ok(Value::Tensor(result))
+                let result = spectrum_map(tensor.data(), complex_kernels::abs);
+                Ok(Value::Tensor(Box::new(result)))
             } else {
                 let tensor = Value::to_real_tensor(vec).map_err(|e| e.to_string())?;
                 let spectrum = achronyme_dsp::fft::fft_real(tensor.data());
-                let magnitudes: Vec<f64> = spectrum.iter().map(|c| c.norm()).collect();
-                let result = achronyme_types::tensor::RealTensor::vector(magnitudes);
-                Ok(Value::Tensor(result))
+                let result = spectrum_map(&spectrum, complex_kernels::abs);
+                Ok(Value::Tensor(Box::new(result)))
             }
         }
 
@@ -133,9 +159,8 @@ fn fft_phase(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
                 return Err("fft_phase() requires a rank-1 tensor (vector)".to_string());
             }
             let spectrum = achronyme_dsp::fft::fft_real(t.data());
-            let phases: Vec<f64> = spectrum.iter().map(|c| c.arg()).collect();
-            let result = achronyme_types::tensor::RealTensor::vector(phases);
-            Ok(Value::Tensor(result))
+            let result = spectrum_map(&spectrum, complex_kernels::phase);
+            Ok(Value::Tensor(Box::new(result)))
         }
 
         // Tensor support (optimized path) - Complex input
@@ -143,9 +168,8 @@ fn fft_phase(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             if !t.is_vector() {
                 return Err("fft_phase() requires a rank-1 tensor (vector)".to_string());
             }
-            let phases: Vec<f64> = t.data().iter().map(|c| c.arg()).collect();
-            let result = achronyme_types::tensor::RealTensor::vector(phases);
-            Ok(Value::Tensor(result))
+            let result = spectrum_map(t.data(), complex_kernels::phase);
+            Ok(Value::Tensor(Box::new(result)))
         }
 
         // Legacy Vector support (backward compatibility)
@@ -155,15 +179,13 @@ fn fft_phase(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             }
             if vec.iter().any(|v| matches!(v, Value::Complex(_))) {
                 let tensor = Value::to_complex_tensor(vec).map_err(|e| e.to_string())?;
-                let phases: Vec<f64> = tensor.data().iter().map(|c| c.arg()).collect();
-                let result = achronyme_types::tensor::RealTensor::vector(phases);
-                Ok(Value::Tensor(result))
+                let result = spectrum_map(tensor.data(), complex_kernels::phase);
+                Ok(Value::Tensor(Box::new(result)))
             } else {
                 let tensor = Value::to_real_tensor(vec).map_err(|e| e.to_string())?;
                 let spectrum = achronyme_dsp::fft::fft_real(tensor.data());
-                let phases: Vec<f64> = spectrum.iter().map(|c| c.arg()).collect();
-                let result = achronyme_types::tensor::RealTensor::vector(phases);
-                Ok(Value::Tensor(result))
+                let result = spectrum_map(&spectrum, complex_kernels::phase);
+                Ok(Value::Tensor(Box::new(result)))
             }
         }
 
@@ -171,6 +193,64 @@ fn fft_phase(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
     }
 }
 
+fn rfft(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
+    match &args[0] {
+        // Tensor support (optimized path)
+        Value::Tensor(t) => {
+            if !t.is_vector() {
+                return Err("rfft() requires a rank-1 tensor (vector)".to_string());
+            }
+            let spectrum = achronyme_dsp::fft::rfft(t.data());
+            let result = achronyme_types::tensor::ComplexTensor::vector(spectrum);
+            Ok(Value::ComplexTensor(Box::new(result)))
+        }
+
+        // Legacy Vector support (backward compatibility)
+        Value::Vector(vec) => {
+            if !Value::is_numeric_vector(vec) {
+                return Err("rfft() requires a numeric vector".to_string());
+            }
+            let tensor = Value::to_real_tensor(vec).map_err(|e| e.to_string())?;
+            let spectrum = achronyme_dsp::fft::rfft(tensor.data());
+            let result = achronyme_types::tensor::ComplexTensor::vector(spectrum);
+            Ok(Value::ComplexTensor(Box::new(result)))
+        }
+
+        _ => Err("rfft() requires a real vector or tensor".to_string()),
+    }
+}
+
+fn irfft(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
+    let n = match &args[1] {
+        Value::Number(n) if *n >= 0.0 && n.fract() == 0.0 => generated_len("irfft", *n as usize)?,
+        _ => return Err("irfft() requires a non-negative integer signal length".to_string()),
+    };
+
+    let real_data = match &args[0] {
+        // Tensor support (optimized path)
+        Value::ComplexTensor(t) => {
+            if !t.is_vector() {
+                return Err("irfft() requires a rank-1 tensor (vector)".to_string());
+            }
+            achronyme_dsp::fft::irfft(t.data(), n)?
+        }
+
+        // Legacy Vector support (backward compatibility)
+        Value::Vector(vec) => {
+            if !Value::is_numeric_vector(vec) {
+                return Err("irfft() requires a numeric vector".to_string());
+            }
+            let tensor = Value::to_complex_tensor(vec).map_err(|e| e.to_string())?;
+            achronyme_dsp::fft::irfft(tensor.data(), n)?
+        }
+
+        _ => return Err("irfft() requires a complex vector or complex tensor".to_string()),
+    };
+
+    let result = achronyme_types::tensor::RealTensor::vector(real_data);
+    Ok(Value::Tensor(Box::new(result)))
+}
+
 fn conv(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
     match (&args[0], &args[1]) {
         // Tensor support (optimized path)
@@ -178,9 +258,9 @@ fn conv(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             if !signal_t.is_vector() || !kernel_t.is_vector() {
                 return Err("conv() requires rank-1 tensors (vectors)".to_string());
             }
-            let result = achronyme_dsp::convolution::convolve(signal_t.data(), kernel_t.data());
+            let result = achronyme_dsp::convolution::convolve_auto(signal_t.data(), kernel_t.data());
             let tensor = achronyme_types::tensor::RealTensor::vector(result);
-            Ok(Value::Tensor(tensor))
+            Ok(Value::Tensor(Box::new(tensor)))
         }
 
         // Legacy Vector support (backward compatibility)
@@ -190,9 +270,9 @@ fn conv(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             }
             let signal_t = Value::to_real_tensor(signal_vec).map_err(|e| e.to_string())?;
             let kernel_t = Value::to_real_tensor(kernel_vec).map_err(|e| e.to_string())?;
-            let result = achronyme_dsp::convolution::convolve(signal_t.data(), kernel_t.data());
+            let result = achronyme_dsp::convolution::convolve_auto(signal_t.data(), kernel_t.data());
             let tensor = achronyme_types::tensor::RealTensor::vector(result);
-            Ok(Value::Tensor(tensor))
+            Ok(Value::Tensor(Box::new(tensor)))
         }
 
         _ => Err("conv() requires two vectors or tensors".to_string()),
@@ -208,7 +288,7 @@ fn conv_fft(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             }
             let result = achronyme_dsp::convolution::convolve_fft(signal_t.data(), kernel_t.data());
             let tensor = achronyme_types::tensor::RealTensor::vector(result);
-            Ok(Value::Tensor(tensor))
+            Ok(Value::Tensor(Box::new(tensor)))
         }
 
         // Legacy Vector support (backward compatibility)
@@ -220,22 +300,100 @@ fn conv_fft(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             let kernel_t = Value::to_real_tensor(kernel_vec).map_err(|e| e.to_string())?;
             let result = achronyme_dsp::convolution::convolve_fft(signal_t.data(), kernel_t.data());
             let tensor = achronyme_types::tensor::RealTensor::vector(result);
-            Ok(Value::Tensor(tensor))
+            Ok(Value::Tensor(Box::new(tensor)))
         }
 
         _ => Err("conv_fft() requires two vectors or tensors".to_string()),
     }
 }
 
+/// Parsed `(signal, frame_len, hop[, window[, extra]])` arguments of the STFT family
+struct StftArgs {
+    frame_len: usize,
+    hop: usize,
+    window: achronyme_dsp::WindowKind,
+    /// Channel axis (stft, spectrogram) or output length (istft)
+    extra: Option<usize>,
+}
+
+fn stft_args(name: &str, args: &[Value], extra: &str) -> Result<StftArgs, String> {
+    if !(3..=5).contains(&args.len()) {
+        return Err(format!("{}() takes 3 to 5 arguments, got {}", name, args.len()));
+    }
+    let count = |value: &Value, what: &str| match value {
+        Value::Number(n) if *n >= 0.0 && n.fract() == 0.0 => generated_len(name, *n as usize),
+        _ => Err(format!("{}() requires a non-negative integer {}", name, what)),
+    };
+
+    let window = match args.get(3) {
+        None => achronyme_dsp::WindowKind::Hanning,
+        Some(Value::String(window)) => achronyme_dsp::WindowKind::from_name(window)?,
+        Some(_) => return Err(format!("{}() requires a window name as 4th argument", name)),
+    };
+    Ok(StftArgs {
+        frame_len: count(&args[1], "frame length")?,
+        hop: count(&args[2], "hop size")?,
+        window,
+        extra: args.get(4).map(|value| count(value, extra)).transpose()?,
+    })
+}
+
+/// Real signal argument: a vector or [channels, samples] tensor, or a numeric vector
+fn real_signal(name: &str, value: &Value) -> Result<achronyme_types::tensor::RealTensor, String> {
+    match value {
+        Value::Tensor(t) => Ok(*t.clone()),
+        Value::Vector(vec) if Value::is_numeric_vector(vec) => {
+            Value::to_real_tensor(vec).map_err(|e| e.to_string())
+        }
+        _ => Err(format!("{}() requires a real vector or tensor signal", name)),
+    }
+}
+
+fn stft(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
+    let options = stft_args("stft", args, "channel axis")?;
+    let signal = real_signal("stft", &args[0])?;
+    let spectrum = achronyme_dsp::stft::stft(
+        &signal,
+        options.frame_len,
+        options.hop,
+        options.window,
+        options.extra.unwrap_or(0),
+    )?;
+    Ok(Value::ComplexTensor(Box::new(spectrum)))
+}
+
+fn spectrogram(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
+    let options = stft_args("spectrogram", args, "channel axis")?;
+    let signal = real_signal("spectrogram", &args[0])?;
+    let power = achronyme_dsp::stft::spectrogram(
+        &signal,
+        options.frame_len,
+        options.hop,
+        options.window,
+        options.extra.unwrap_or(0),
+    )?;
+    Ok(Value::Tensor(Box::new(power)))
+}
+
+fn istft(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
+    let options = stft_args("istft", args, "signal length")?;
+    let spectrum = match &args[0] {
+        Value::ComplexTensor(t) => t,
+        _ => return Err("istft() requires a complex [frames, bins] or [channels, frames, bins] tensor".to_string()),
+    };
+    let signal = achronyme_dsp::stft::istft(spectrum, options.frame_len, options.hop, options.window, options.extra)?;
+    Ok(Value::Tensor(Box::new(signal)))
+}
+
 fn hanning(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
     match &args[0] {
         Value::Number(n) => {
             if *n < 0.0 || n.fract() != 0.0 {
                 return Err("hanning() requires a non-negative integer".to_string());
             }
-            let window = achronyme_dsp::windows::hanning_window(*n as usize);
+            let window = achronyme_dsp::windows::hanning_window(generated_len("hanning", *n as usize)?);
             let tensor = achronyme_types::tensor::RealTensor::vector(window);
-            Ok(Value::Tensor(tensor))
+            Ok(Value::Tensor(Box::new(tensor)))
         }
         _ => Err("hanning() requires a number (window size)".to_string()),
     }
@@ -247,9 +405,9 @@ fn hamming(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             if *n < 0.0 || n.fract() != 0.0 {
                 return Err("hamming() requires a non-negative integer".to_string());
             }
-            let window = achronyme_dsp::windows::hamming_window(*n as usize);
+            let window = achronyme_dsp::windows::hamming_window(generated_len("hamming", *n as usize)?);
             let tensor = achronyme_types::tensor::RealTensor::vector(window);
-            Ok(Value::Tensor(tensor))
+            Ok(Value::Tensor(Box::new(tensor)))
         }
         _ => Err("hamming() requires a number (window size)".to_string()),
     }
@@ -261,9 +419,9 @@ fn blackman(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             if *n < 0.0 || n.fract() != 0.0 {
                 return Err("blackman() requires a non-negative integer".to_string());
             }
-            let window = achronyme_dsp::windows::blackman_window(*n as usize);
+            let window = achronyme_dsp::windows::blackman_window(generated_len("blackman", *n as usize)?);
             let tensor = achronyme_types::tensor::RealTensor::vector(window);
-            Ok(Value::Tensor(tensor))
+            Ok(Value::Tensor(Box::new(tensor)))
         }
         _ => Err("blackman() requires a number (window size)".to_string()),
     }
@@ -275,9 +433,9 @@ fn rectangular(args: &[Value], _env: &mut Environment) -> Result<Value, String>
             if *n < 0.0 || n.fract() != 0.0 {
                 return Err("rectangular() requires a non-negative integer".to_string());
             }
-            let window = achronyme_dsp::windows::rectangular_window(*n as usize);
+            let window = achronyme_dsp::windows::rectangular_window(generated_len("rectangular", *n as usize)?);
             let tensor = achronyme_types::tensor::RealTensor::vector(window);
-            Ok(Value::Tensor(tensor))
+            Ok(Value::Tensor(Box::new(tensor)))
         }
         _ => Err("rectangular() requires a number (window size)".to_string()),
     }
@@ -289,13 +447,13 @@ fn linspace(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             if *n < 2.0 || n.fract() != 0.0 {
                 return Err("linspace() requires n >= 2 as integer".to_string());
             }
-            let count = *n as usize;
+            let count = generated_len("linspace", *n as usize)?;
             let step = (end - start) / (*n - 1.0);
             let data: Vec<f64> = (0..count)
                 .map(|i| start + step * i as f64)
                 .collect();
             let tensor = achronyme_types::tensor::RealTensor::vector(data);
-            Ok(Value::Tensor(tensor))
+            Ok(Value::Tensor(Box::new(tensor)))
         }
         _ => Err("linspace() requires three numbers (start, end, count)".to_string()),
     }
@@ -1,8 +1,7 @@
-use crate::function_modules::graphs::helpers::{build_adjacency_list, build_undirected_adjacency_list, extract_node_ids};
+use crate::function_modules::graphs::csr::{graph_of, NodeIndex};
 use achronyme_types::value::Value;
 use achronyme_types::Environment;
 use std::cmp::Ordering;
-use std::collections::HashSet;
 
 /// Connected Components - Find all connected components in a graph
 pub fn connected_components(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
@@ -11,40 +10,31 @@ pub fn connected_components(args: &[Value], _env: &mut Environment) -> Result<Va
         _ => return Err("connected_components() requires a network record as first argument".to_string()),
     };
 
-    // Get all nodes
-    let node_ids = extract_node_ids(network)?;
+    let graph = graph_of(network)?;
 
-    // Get edges and build adjacency list using weak connectivity
-    // (treat all edges as undirected for component analysis)
-    let edges_vec = match network.get("edges") {
-        Some(Value::Vector(v)) => v,
-        _ => return Err("Network must have an 'edges' field with a vector".to_string()),
-    };
-
-    let adj_list = build_undirected_adjacency_list(edges_vec)?;
+    // Use weak connectivity (treat all edges as undirected for component analysis)
+    let adjacency = graph.undirected();
 
     // Find connected components using DFS
-    let mut visited: HashSet<String> = HashSet::new();
+    let mut visited = vec![false; graph.num_nodes()];
     let mut components: Vec<Value> = Vec::new();
 
-    for node in &node_ids {
-        if !visited.contains(node) {
+    for node in 0..graph.num_nodes() as NodeIndex {
+        if !visited[node as usize] {
             let mut component = Vec::new();
-            let mut stack = vec![node.clone()];
+            let mut stack = vec![node];
 
             while let Some(current) = stack.pop() {
-                if visited.contains(&current) {
+                if visited[current as usize] {
                     continue;
                 }
 
-                visited.insert(current.clone());
-                component.push(Value::String(current.clone()));
+                visited[current as usize] = true;
+                component.push(graph.name_value(current));
 
-                if let Some(neighbors) = adj_list.get(&current) {
-                    for neighbor in neighbors {
-                        if !visited.contains(neighbor) {
-                            stack.push(neighbor.clone());
-                        }
+                for &neighbor in adjacency.neighbors(current) {
+                    if !visited[neighbor as usize] {
+                        stack.push(neighbor);
                     }
                 }
             }
@@ -69,43 +59,35 @@ pub fn is_connected(args: &[Value], _env: &mut Environment) -> Result<Value, Str
         _ => return Err("is_connected() requires a network record as first argument".to_string()),
     };
 
-    // Get all nodes
-    let node_ids = extract_node_ids(network)?;
+    let graph = graph_of(network)?;
 
     // Empty graph is considered connected
-    if node_ids.is_empty() {
+    if graph.num_nodes() == 0 {
         return Ok(Value::Boolean(true));
     }
 
-    // Get edges and build adjacency list
-    let edges_vec = match network.get("edges") {
-        Some(Value::Vector(v)) => v,
-        _ => return Err("Network must have an 'edges' field with a vector".to_string()),
-    };
-
-    let adj_list = build_adjacency_list(edges_vec)?;
+    let adjacency = graph.out();
 
     // DFS from first node to see if all nodes are reachable
-    let start_node = &node_ids[0];
-    let mut visited: HashSet<String> = HashSet::new();
-    let mut stack = vec![start_node.clone()];
+    let mut visited = vec![false; graph.num_nodes()];
+    let mut visited_count = 0;
+    let mut stack: Vec<NodeIndex> = vec![0];
 
     while let Some(current) = stack.pop() {
-        if visited.contains(&current) {
+        if visited[current as usize] {
             continue;
         }
 
-        visited.insert(current.clone());
+        visited[current as usize] = true;
+        visited_count += 1;
 
-        if let Some(neighbors) = adj_list.get(&current) {
-            for neighbor in neighbors {
-                if !visited.contains(neighbor) {
-                    stack.push(neighbor.clone());
-                }
+        for &neighbor in adjacency.neighbors(current) {
+            if !visited[neighbor as usize] {
+                stack.push(neighbor);
             }
         }
     }
 
     // Graph is connected if all nodes were visited
-    Ok(Value::Boolean(visited.len() == node_ids.len()))
+    Ok(Value::Boolean(visited_count == graph.num_nodes()))
 }
@@ -0,0 +1,445 @@
+//! Compact graph representation shared by the graph algorithms
+//!
+//! A network value stays a record (`{nodes, edges}`) so field access,
+//! printing and persistence keep working, but the algorithms never walk it
+//! directly. `graph_of` turns it into a `Graph`: nodes get dense indices and
+//! adjacency is stored in CSR form (one offsets array plus flat target and
+//! edge-index arrays), so traversals index vectors instead of hashing names.
+//!
+//! Building a `Graph` costs one pass over the edges. `network()` builds it
+//! up front and every algorithm looks it up in a small per-thread cache keyed
+//! by a fingerprint of the network's topology and weights. A hit is checked
+//! edge by edge against the network, so a collision can never return the
+//! wrong graph, and a sequence of calls on the same network (PERT's forward/backward passes, repeated
+//! `dijkstra` queries) pays the construction once.
+
+use achronyme_types::value::Value;
+use achronyme_types::Symbol;
+use std::borrow::Cow;
+use std::cell::{OnceCell, RefCell};
+use std::collections::hash_map::DefaultHasher;
+use std::collections::{HashMap, VecDeque};
+use std::hash::{Hash, Hasher};
+use std::rc::Rc;
+
+/// Dense node index inside a `Graph`
+pub type NodeIndex = u32;
+
+/// Networks kept per thread; enough for a few networks used side by side
+const CACHE_CAPACITY: usize = 4;
+
+/// Weight bits used for edges without a numeric weight, in the fingerprint
+/// and when checking a cached graph against its network
+const NO_WEIGHT: u64 = u64::MAX;
+
+thread_local! {
+    static GRAPH_CACHE: RefCell<VecDeque<(u64, Rc<Graph>)>> = RefCell::new(VecDeque::new());
+}
+
+/// Adjacency in CSR form: the neighbors of `u` are
+/// `targets[offsets[u]..offsets[u + 1]]`, in edge order
+pub struct Adjacency {
+    offsets: Vec<u32>,
+    targets: Vec<NodeIndex>,
+    edges: Vec<u32>,
+}
+
+impl Adjacency {
+    /// Build from `(from, to, edge)` triples with a stable counting sort, so
+    /// each node's neighbors keep the order their edges were listed in
+    fn build(num_nodes: usize, arcs: &[(NodeIndex, NodeIndex, u32)]) -> Self {
+        let mut offsets = vec![0u32; num_nodes + 1];
+        for &(from, _, _) in arcs {
+            offsets[from as usize + 1] += 1;
+        }
+        for i in 0..num_nodes {
+            offsets[i + 1] += offsets[i];
+        }
+
+        let mut cursor = offsets.clone();
+        let mut targets = vec![0; arcs.len()];
+        let mut edges = vec![0; arcs.len()];
+        for &(from, to, edge) in arcs {
+            let slot = cursor[from as usize] as usize;
+            targets[slot] = to;
+            edges[slot] = edge;
+            cursor[from as usize] += 1;
+        }
+
+        Adjacency { offsets, targets, edges }
+    }
+
+    /// Neighbors of `node`
+    pub fn neighbors(&self, node: NodeIndex) -> &[NodeIndex] {
+        &self.targets[self.range(node)]
+    }
+
+    /// Indices (into the network's edge list) of the arcs leaving `node`,
+    /// parallel to `neighbors(node)`
+    pub fn edges(&self, node: NodeIndex) -> &[u32] {
+        &self.edges[self.range(node)]
+    }
+
+    fn range(&self, node: NodeIndex) -> std::ops::Range<usize> {
+        self.offsets[node as usize] as usize..self.offsets[node as usize + 1] as usize
+    }
+}
+
+/// A network with dense node indices and CSR adjacency
+pub struct Graph {
+    /// Node IDs by index: nodes in order of first appearance in the edge
+    /// list, then isolated nodes sorted by name
+    pub nodes: Vec<Cow<'static, str>>,
+    /// Edge endpoints, which are interned identifiers
+    index: HashMap<Symbol, NodeIndex>,
+    /// Nodes only listed in the nodes record; their IDs are runtime strings
+    /// and are not interned
+    isolated: HashMap<String, NodeIndex>,
+    /// Per-edge endpoints and weight, in edge-list order
+    pub sources: Vec<NodeIndex>,
+    pub targets: Vec<NodeIndex>,
+    /// `weight` property of each edge, NaN when missing or non-numeric
+    pub weights: Vec<f64>,
+    /// Per-edge direction, kept to check cache hits exactly
+    directed: Vec<bool>,
+    /// Whether any edge is directed
+    pub has_directed: bool,
+    out: Adjacency,
+    undirected: OnceCell<Adjacency>,
+    predecessors: OnceCell<Adjacency>,
+}
+
+impl Graph {
+    fn build(
+        nodes_record: &HashMap<String, Value>,
+        edges: &[Value],
+        weights: Vec<f64>,
+    ) -> Result<Self, String> {
+        fn intern(symbol: Symbol, nodes: &mut Vec<Cow<'static, str>>, index: &mut HashMap<Symbol, NodeIndex>) -> NodeIndex {
+            *index.entry(symbol).or_insert_with(|| {
+                nodes.push(Cow::Borrowed(symbol.as_str()));
+                (nodes.len() - 1) as NodeIndex
+            })
+        }
+
+        let mut nodes = Vec::new();
+        let mut index: HashMap<Symbol, NodeIndex> = HashMap::with_capacity(nodes_record.len());
+
+        let mut sources = Vec::with_capacity(edges.len());
+        let mut targets = Vec::with_capacity(edges.len());
+        let mut directed = Vec::with_capacity(edges.len());
+        for edge in edges {
+            match edge {
+                Value::Edge { from, to, directed: d, .. } => {
+                    sources.push(intern(*from, &mut nodes, &mut index));
+                    targets.push(intern(*to, &mut nodes, &mut index));
+                    directed.push(*d);
+                }
+                _ => return Err("Invalid edge in edges vector".to_string()),
+            }
+        }
+
+        // A name that was never interned can't be an edge endpoint
+        let mut isolated_names: Vec<&String> = nodes_record
+            .keys()
+            .filter(|name| Symbol::lookup(name).map_or(true, |symbol| !index.contains_key(&symbol)))
+            .collect();
+        isolated_names.sort();
+        let mut isolated = HashMap::with_capacity(isolated_names.len());
+        for name in isolated_names {
+            isolated.insert(name.clone(), nodes.len() as NodeIndex);
+            nodes.push(Cow::Owned(name.clone()));
+        }
+
+        let mut arcs = Vec::with_capacity(edges.len() * 2);
+        for e in 0..sources.len() {
+            arcs.push((sources[e], targets[e], e as u32));
+            if !directed[e] {
+                arcs.push((targets[e], sources[e], e as u32));
+            }
+        }
+        let out = Adjacency::build(nodes.len(), &arcs);
+        let has_directed = directed.iter().any(|&d| d);
+
+        Ok(Graph {
+            nodes,
+            index,
+            isolated,
+            sources,
+            targets,
+            weights,
+            directed,
+            has_directed,
+            out,
+            undirected: OnceCell::new(),
+            predecessors: OnceCell::new(),
+        })
+    }
+
+    pub fn num_nodes(&self) -> usize {
+        self.nodes.len()
+    }
+
+    pub fn num_edges(&self) -> usize {
+        self.sources.len()
+    }
+
+    /// Index of a node, if it is part of the graph
+    pub fn index_of(&self, node: &str) -> Option<NodeIndex> {
+        Symbol::lookup(node)
+            .and_then(|symbol| self.index.get(&symbol))
+            .or_else(|| self.isolated.get(node))
+            .copied()
+    }
+
+    /// Name of the node at `index`
+    pub fn name(&self, index: NodeIndex) -> &str {
+        &self.nodes[index as usize]
+    }
+
+    /// Node ID as a runtime string value
+    pub fn name_value(&self, index: NodeIndex) -> Value {
+        Value::String(self.name(index).to_string())
+    }
+
+    /// Successors following edge direction; undirected edges go both ways
+    pub fn out(&self) -> &Adjacency {
+        &self.out
+    }
+
+    /// Every edge in both directions (weak connectivity)
+    pub fn undirected(&self) -> &Adjacency {
+        self.undirected.get_or_init(|| {
+            let mut arcs = Vec::with_capacity(self.num_edges() * 2);
+            for e in 0..self.num_edges() {
+                arcs.push((self.sources[e], self.targets[e], e as u32));
+                arcs.push((self.targets[e], self.sources[e], e as u32));
+            }
+            Adjacency::build(self.num_nodes(), &arcs)
+        })
+    }
+
+    /// `from` for every edge `from -> to`, listed under `to` (the PERT
+    /// reading of an edge list: every edge is a precedence constraint)
+    pub fn predecessors(&self) -> &Adjacency {
+        self.predecessors.get_or_init(|| {
+            let arcs: Vec<_> = (0..self.num_edges())
+                .map(|e| (self.targets[e], self.sources[e], e as u32))
+                .collect();
+            Adjacency::build(self.num_nodes(), &arcs)
+        })
+    }
+
+    /// Whether every edge has a positive numeric weight
+    pub fn has_positive_weights(&self) -> bool {
+        self.weights.iter().all(|&w| w > 0.0)
+    }
+
+    /// Whether this graph is exactly what `build` would make of the network
+    ///
+    /// A fingerprint match only makes a hit likely; this compares every edge
+    /// (endpoints, direction, weight bits) and the isolated node set.
+    fn matches(&self, nodes_record: &HashMap<String, Value>, edges: &[Value], weights: &[f64]) -> bool {
+        if edges.len() != self.num_edges() {
+            return false;
+        }
+        let endpoint = |symbol: &Symbol| self.index.get(symbol).copied();
+        let same_edges = edges.iter().zip(weights).enumerate().all(|(e, (edge, &weight))| match edge {
+            Value::Edge { from, to, directed, .. } => {
+                endpoint(from) == Some(self.sources[e])
+                    && endpoint(to) == Some(self.targets[e])
+                    && *directed == self.directed[e]
+                    && weight_bits(weight) == weight_bits(self.weights[e])
+            }
+            _ => false,
+        });
+        if !same_edges {
+            return false;
+        }
+
+        // Every edge endpoint is in `index`, so the node sets agree when each
+        // name in the record is known and the isolated ones are all of them
+        let mut isolated_seen = 0;
+        for name in nodes_record.keys() {
+            if Symbol::lookup(name).map_or(false, |symbol| self.index.contains_key(&symbol)) {
+                continue;
+            }
+            if !self.isolated.contains_key(name) {
+                return false;
+            }
+            isolated_seen += 1;
+        }
+        isolated_seen == self.isolated.len()
+    }
+}
+
+fn weight_bits(weight: f64) -> u64 {
+    if weight.is_nan() { NO_WEIGHT } else { weight.to_bits() }
+}
+
+/// The compact graph for a network record, from the cache when the same
+/// network was seen before
+pub fn graph_of(network: &HashMap<String, Value>) -> Result<Rc<Graph>, String> {
+    let nodes_record = match network.get("nodes") {
+        Some(Value::Record(nodes)) => nodes,
+        _ => return Err("Network must have 'nodes' field with a record".to_string()),
+    };
+    let edges = match network.get("edges") {
+        Some(Value::Vector(v)) => v,
+        _ => return Err("Network must have an 'edges' field with a vector".to_string()),
+    };
+
+    let (key, weights) = fingerprint(nodes_record, edges)?;
+
+    let cached = GRAPH_CACHE.with(|cache| {
+        let mut cache = cache.borrow_mut();
+        let position = cache
+            .iter()
+            .position(|(k, graph)| *k == key && graph.matches(nodes_record, edges, &weights))?;
+        // Move to the front so the least recently used network is evicted
+        let entry = cache.remove(position)?;
+        let graph = entry.1.clone();
+        cache.push_front(entry);
+        Some(graph)
+    });
+    if let Some(graph) = cached {
+        return Ok(graph);
+    }
+
+    let graph = Rc::new(Graph::build(nodes_record, edges, weights)?);
+    GRAPH_CACHE.with(|cache| {
+        let mut cache = cache.borrow_mut();
+        cache.push_front((key, graph.clone()));
+        cache.truncate(CACHE_CAPACITY);
+    });
+    Ok(graph)
+}
+
+/// Hash of everything a `Graph` is built from, plus the edge weights
+///
+/// Edge endpoints hash as interned symbol handles, so this is a single pass
+/// of integer hashing; node IDs are combined order-independently because
+/// record iteration order is unspecified.
+fn fingerprint(nodes_record: &HashMap<String, Value>, edges: &[Value]) -> Result<(u64, Vec<f64>), String> {
+    let mut hasher = DefaultHasher::new();
+    let mut weights = Vec::with_capacity(edges.len());
+
+    edges.len().hash(&mut hasher);
+    for edge in edges {
+        match edge {
+            Value::Edge { from, to, directed, properties } => {
+                let weight = match properties.get("weight") {
+                    Some(Value::Number(w)) => *w,
+                    _ => f64::NAN,
+                };
+                from.id().hash(&mut hasher);
+                to.id().hash(&mut hasher);
+                directed.hash(&mut hasher);
+                weight_bits(weight).hash(&mut hasher);
+                weights.push(weight);
+            }
+            _ => return Err("Invalid edge in edges vector".to_string()),
+        }
+    }
+
+    let mut node_sum: u64 = 0;
+    for name in nodes_record.keys() {
+        let mut node_hasher = DefaultHasher::new();
+        name.hash(&mut node_hasher);
+        node_sum = node_sum.wrapping_add(node_hasher.finish());
+    }
+    nodes_record.len().hash(&mut hasher);
+    node_sum.hash(&mut hasher);
+
+    Ok((hasher.finish(), weights))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn edge(from: &str, to: &str, directed: bool, weight: Option<f64>) -> Value {
+        let mut properties = HashMap::new();
+        if let Some(w) = weight {
+            properties.insert("weight".to_string(), Value::Number(w));
+        }
+        Value::Edge { from: from.into(), to: to.into(), directed, properties: Box::new(properties) }
+    }
+
+    fn network(edges: Vec<Value>, isolated: &[&str]) -> HashMap<String, Value> {
+        let mut nodes = HashMap::new();
+        for e in &edges {
+            if let Value::Edge { from, to, .. } = e {
+                nodes.insert(from.to_string(), Value::Record(Box::new(HashMap::new())));
+                nodes.insert(to.to_string(), Value::Record(Box::new(HashMap::new())));
+            }
+        }
+        for name in isolated {
+            nodes.insert(name.to_string(), Value::Record(Box::new(HashMap::new())));
+        }
+        let mut network = HashMap::new();
+        network.insert("nodes".to_string(), Value::Record(Box::new(nodes)));
+        network.insert("edges".to_string(), Value::Vector(edges));
+        network
+    }
+
+    #[test]
+    fn test_csr_adjacency_keeps_edge_order() {
+        let net = network(
+            vec![edge("A", "C", true, None), edge("A", "B", true, None), edge("B", "C", false, None)],
+            &["Z"],
+        );
+        let graph = graph_of(&net).unwrap();
+        let name = |i: &NodeIndex| graph.name(*i).to_string();
+
+        assert_eq!(graph.nodes.iter().map(|s| s.to_string()).collect::<Vec<_>>(), ["A", "C", "B", "Z"]);
+        let a = graph.index_of("A").unwrap();
+        let c = graph.index_of("C").unwrap();
+        assert_eq!(graph.out().neighbors(a).iter().map(name).collect::<Vec<_>>(), ["C", "B"]);
+        // The undirected B <> C edge is also an arc C -> B
+        assert_eq!(graph.out().neighbors(c).iter().map(name).collect::<Vec<_>>(), ["B"]);
+        assert_eq!(graph.predecessors().neighbors(c).iter().map(name).collect::<Vec<_>>(), ["A", "B"]);
+        assert!(graph.out().neighbors(graph.index_of("Z").unwrap()).is_empty());
+    }
+
+    #[test]
+    fn test_graph_cache_reuses_identical_networks() {
+        let first = graph_of(&network(vec![edge("P", "Q", true, Some(2.0))], &[])).unwrap();
+        let again = graph_of(&network(vec![edge("P", "Q", true, Some(2.0))], &[])).unwrap();
+        assert!(Rc::ptr_eq(&first, &again));
+
+        let reweighted = graph_of(&network(vec![edge("P", "Q", true, Some(3.0))], &[])).unwrap();
+        assert!(!Rc::ptr_eq(&first, &reweighted));
+        assert_eq!(reweighted.weights, vec![3.0]);
+
+        let with_isolated = graph_of(&network(vec![edge("P", "Q", true, Some(2.0))], &["R"])).unwrap();
+        assert_eq!(with_isolated.num_nodes(), 3);
+    }
+
+    #[test]
+    fn test_cache_hits_are_checked_exactly() {
+        let parts = |net: &HashMap<String, Value>| match (&net["nodes"], &net["edges"]) {
+            (Value::Record(nodes), Value::Vector(edges)) => (nodes.as_ref().clone(), edges.clone()),
+            _ => unreachable!(),
+        };
+        let (nodes, edges) = parts(&network(vec![edge("M", "N", true, Some(1.0))], &["O"]));
+        let graph = Graph::build(&nodes, &edges, vec![1.0]).unwrap();
+        assert!(graph.matches(&nodes, &edges, &[1.0]));
+
+        // Same edge count and node count, different content
+        let (n, e) = parts(&network(vec![edge("N", "M", true, Some(1.0))], &["O"]));
+        assert!(!graph.matches(&n, &e, &[1.0]));
+        let (n, e) = parts(&network(vec![edge("M", "N", false, Some(1.0))], &["O"]));
+        assert!(!graph.matches(&n, &e, &[1.0]));
+        assert!(!graph.matches(&nodes, &edges, &[f64::NAN]));
+        let (n, e) = parts(&network(vec![edge("M", "N", true, Some(1.0))], &["P"]));
+        assert!(!graph.matches(&n, &e, &[1.0]));
+    }
+
+    #[test]
+    fn test_missing_weights_are_nan() {
+        let graph = graph_of(&network(vec![edge("U", "V", false, None)], &[])).unwrap();
+        assert!(graph.weights[0].is_nan());
+        assert!(!graph.has_positive_weights());
+    }
+}
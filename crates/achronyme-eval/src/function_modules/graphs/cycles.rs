@@ -1,7 +1,7 @@
-use crate::function_modules::graphs::helpers::{build_adjacency_list, extract_node_ids};
+use crate::function_modules::graphs::csr::{graph_of, Graph, NodeIndex};
 use achronyme_types::value::Value;
 use achronyme_types::Environment;
-use std::collections::{HashMap, HashSet};
+use std::collections::HashMap;
 
 /// Has Cycle - Detect if graph contains a cycle
 pub fn has_cycle(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
@@ -10,130 +10,112 @@ pub fn has_cycle(args: &[Value], _env: &mut Environment) -> Result<Value, String
         _ => return Err("has_cycle() requires a network record as first argument".to_string()),
     };
 
-    // Get edges
-    let edges_vec = match network.get("edges") {
-        Some(Value::Vector(v)) => v,
-        _ => return Err("Network must have an 'edges' field with a vector".to_string()),
-    };
-
-    // Get all nodes
-    let node_ids = extract_node_ids(network)?;
+    Ok(Value::Boolean(network_has_cycle(network)?))
+}
 
-    // Build adjacency list
-    let adj_list = build_adjacency_list(edges_vec)?;
+/// Cycle check on a borrowed network, for callers that already hold the
+/// record (topological sort, PERT validation) and must not clone it
+pub(crate) fn network_has_cycle(network: &HashMap<String, Value>) -> Result<bool, String> {
+    let graph = graph_of(network)?;
 
     // Check if graph has any directed edges
-    let has_directed = edges_vec.iter().any(|e| matches!(e, Value::Edge { directed: true, .. }));
-
-    if has_directed {
+    if graph.has_directed {
         // For directed graphs, use DFS with three colors (white, gray, black)
-        detect_cycle_directed(&node_ids, &adj_list)
+        Ok(detect_cycle_directed(&graph))
     } else {
         // For undirected graphs, use DFS with parent tracking
-        detect_cycle_undirected(&node_ids, &adj_list)
+        Ok(detect_cycle_undirected(&graph))
     }
 }
 
 /// Detect cycle in directed graph using DFS with three colors
-fn detect_cycle_directed(nodes: &[String], adj_list: &HashMap<String, Vec<String>>) -> Result<Value, String> {
-    #[derive(PartialEq)]
+///
+/// The DFS keeps an explicit stack of (node, next neighbor position) so long
+/// dependency chains cannot overflow the call stack.
+fn detect_cycle_directed(graph: &Graph) -> bool {
+    #[derive(Clone, Copy, PartialEq)]
     enum Color {
         White, // Not visited
         Gray,  // Currently being explored
         Black, // Fully explored
     }
 
-    let mut colors: HashMap<String, Color> = HashMap::new();
+    let adjacency = graph.out();
+    let mut colors = vec![Color::White; graph.num_nodes()];
+    let mut stack: Vec<(NodeIndex, usize)> = Vec::new();
 
-    // Initialize all nodes as white
-    for node in nodes {
-        colors.insert(node.clone(), Color::White);
-    }
+    // Check all components
+    for root in 0..graph.num_nodes() as NodeIndex {
+        if colors[root as usize] != Color::White {
+            continue;
+        }
 
-    fn dfs_directed(
-        node: &str,
-        colors: &mut HashMap<String, Color>,
-        adj_list: &HashMap<String, Vec<String>>,
-    ) -> bool {
         // Mark as gray (currently exploring)
-        colors.insert(node.to_string(), Color::Gray);
-
-        // Visit neighbors
-        if let Some(neighbors) = adj_list.get(node) {
-            for neighbor in neighbors {
-                match colors.get(neighbor) {
-                    Some(Color::Gray) => {
-                        // Back edge found - cycle detected!
-                        return true;
-                    }
-                    Some(Color::White) => {
-                        if dfs_directed(neighbor, colors, adj_list) {
-                            return true;
-                        }
-                    }
-                    Some(Color::Black) => {
-                        // Already fully explored, skip
-                    }
-                    None => {
-                        // Node not in graph, skip
-                    }
-                }
+        colors[root as usize] = Color::Gray;
+        stack.push((root, 0));
+
+        while let Some((node, position)) = stack.last_mut() {
+            let neighbors = adjacency.neighbors(*node);
+            if *position == neighbors.len() {
+                // Mark as black (fully explored)
+                colors[*node as usize] = Color::Black;
+                stack.pop();
+                continue;
             }
-        }
-
-        // Mark as black (fully explored)
-        colors.insert(node.to_string(), Color::Black);
-        false
-    }
 
-    // Check all components
-    for node in nodes {
-        if colors.get(node) == Some(&Color::White) {
-            if dfs_directed(node, &mut colors, adj_list) {
-                return Ok(Value::Boolean(true));
+            let neighbor = neighbors[*position];
+            *position += 1;
+            match colors[neighbor as usize] {
+                // Back edge found - cycle detected!
+                Color::Gray => return true,
+                Color::White => {
+                    colors[neighbor as usize] = Color::Gray;
+                    stack.push((neighbor, 0));
+                }
+                // Already fully explored, skip
+                Color::Black => {}
             }
         }
     }
 
-    Ok(Value::Boolean(false))
+    false
 }
 
 /// Detect cycle in undirected graph using DFS with parent tracking
-fn detect_cycle_undirected(nodes: &[String], adj_list: &HashMap<String, Vec<String>>) -> Result<Value, String> {
-    let mut visited: HashSet<String> = HashSet::new();
-
-    fn dfs_undirected(
-        node: &str,
-        parent: Option<&str>,
-        visited: &mut HashSet<String>,
-        adj_list: &HashMap<String, Vec<String>>,
-    ) -> bool {
-        visited.insert(node.to_string());
-
-        if let Some(neighbors) = adj_list.get(node) {
-            for neighbor in neighbors {
-                if !visited.contains(neighbor) {
-                    if dfs_undirected(neighbor, Some(node), visited, adj_list) {
-                        return true;
-                    }
-                } else if Some(neighbor.as_str()) != parent {
-                    // Visited neighbor that's not the parent - cycle found!
-                    return true;
-                }
-            }
+fn detect_cycle_undirected(graph: &Graph) -> bool {
+    let adjacency = graph.out();
+    let mut visited = vec![false; graph.num_nodes()];
+    // (node, parent node, next neighbor position)
+    let mut stack: Vec<(NodeIndex, Option<NodeIndex>, usize)> = Vec::new();
+
+    // Check all components
+    for root in 0..graph.num_nodes() as NodeIndex {
+        if visited[root as usize] {
+            continue;
         }
 
-        false
-    }
+        visited[root as usize] = true;
+        stack.push((root, None, 0));
 
-    // Check all components
-    for node in nodes {
-        if !visited.contains(node) {
-            if dfs_undirected(node, None, &mut visited, adj_list) {
-                return Ok(Value::Boolean(true));
+        while let Some((node, parent, position)) = stack.last_mut() {
+            let neighbors = adjacency.neighbors(*node);
+            if *position == neighbors.len() {
+                stack.pop();
+                continue;
+            }
+
+            let neighbor = neighbors[*position];
+            *position += 1;
+            if !visited[neighbor as usize] {
+                let node = *node;
+                visited[neighbor as usize] = true;
+                stack.push((neighbor, Some(node), 0));
+            } else if Some(neighbor) != *parent {
+                // Visited neighbor that's not the parent - cycle found!
+                return true;
             }
         }
     }
 
-    Ok(Value::Boolean(false))
+    false
 }
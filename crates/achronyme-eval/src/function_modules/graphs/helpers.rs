@@ -1,74 +1,20 @@
+use super::csr::{Graph, NodeIndex};
 use achronyme_types::value::Value;
 use std::collections::HashMap;
 
-/// Extract node IDs from a network
-pub fn extract_node_ids(network: &HashMap<String, Value>) -> Result<Vec<String>, String> {
+/// Validate that a node exists in the network
+pub fn validate_node_exists(network: &HashMap<String, Value>, node_id: &str) -> Result<(), String> {
     match network.get("nodes") {
-        Some(Value::Record(nodes)) => {
-            // Keys of the nodes record are the node IDs
-            Ok(nodes.keys().cloned().collect())
-        }
+        Some(Value::Record(nodes)) if nodes.contains_key(node_id) => Ok(()),
+        Some(Value::Record(_)) => Err(format!("Node '{}' not found in network", node_id)),
         _ => Err("Network must have 'nodes' field with a record".to_string()),
     }
 }
 
-/// Build adjacency list from network edges
-pub fn build_adjacency_list(edges: &[Value]) -> Result<HashMap<String, Vec<String>>, String> {
-    let mut adj_list: HashMap<String, Vec<String>> = HashMap::new();
-
-    for edge in edges {
-        match edge {
-            Value::Edge { from, to, directed, .. } => {
-                // Add forward edge
-                adj_list.entry(from.clone())
-                    .or_insert_with(Vec::new)
-                    .push(to.clone());
-
-                // For undirected edges, add reverse edge
-                if !directed {
-                    adj_list.entry(to.clone())
-                        .or_insert_with(Vec::new)
-                        .push(from.clone());
-                }
-            }
-            _ => return Err("Invalid edge in edges vector".to_string()),
-        }
-    }
-
-    Ok(adj_list)
-}
-
-/// Build adjacency list treating all edges as undirected (weak connectivity)
-/// Used for connected_components to find weakly connected components
-pub fn build_undirected_adjacency_list(edges: &[Value]) -> Result<HashMap<String, Vec<String>>, String> {
-    let mut adj_list: HashMap<String, Vec<String>> = HashMap::new();
-
-    for edge in edges {
-        match edge {
-            Value::Edge { from, to, .. } => {
-                // Always add both directions (weak connectivity)
-                adj_list.entry(from.clone())
-                    .or_insert_with(Vec::new)
-                    .push(to.clone());
-
-                adj_list.entry(to.clone())
-                    .or_insert_with(Vec::new)
-                    .push(from.clone());
-            }
-            _ => return Err("Invalid edge in edges vector".to_string()),
-        }
-    }
-
-    Ok(adj_list)
-}
-
-/// Validate that a node exists in the network
-pub fn validate_node_exists(network: &HashMap<String, Value>, node_id: &str) -> Result<(), String> {
-    let node_ids = extract_node_ids(network)?;
-    if !node_ids.contains(&node_id.to_string()) {
-        return Err(format!("Node '{}' not found in network", node_id));
-    }
-    Ok(())
+/// Validate that a node exists in the network, returning its dense index
+pub fn validate_node_index(network: &HashMap<String, Value>, graph: &Graph, node_id: &str) -> Result<NodeIndex, String> {
+    validate_node_exists(network, node_id)?;
+    graph.index_of(node_id).ok_or_else(|| format!("Node '{}' not found in network", node_id))
 }
 
 /// Validate that all edges have a specific property with correct type
@@ -2,6 +2,7 @@
 
 use crate::functions::FunctionRegistry;
 
+pub mod csr;
 pub mod helpers;
 pub mod network;
 pub mod traversal;
@@ -1,40 +1,40 @@
-use crate::function_modules::graphs::helpers::{extract_node_ids, validate_mst_requirements};
+use crate::function_modules::graphs::csr::{graph_of, NodeIndex};
+use crate::function_modules::graphs::helpers::{validate_mst_requirements, validate_node_index};
 use achronyme_types::value::Value;
 use achronyme_types::Environment;
 use std::cmp::Ordering;
-use std::collections::{BinaryHeap, HashMap, HashSet};
+use std::collections::{BinaryHeap, HashMap};
 
 /// Union-Find (Disjoint Set Union) data structure for Kruskal's algorithm
 struct UnionFind {
-    parent: HashMap<String, String>,
-    rank: HashMap<String, usize>,
+    parent: Vec<NodeIndex>,
+    rank: Vec<usize>,
 }
 
 impl UnionFind {
-    fn new(nodes: &[String]) -> Self {
-        let mut parent = HashMap::new();
-        let mut rank = HashMap::new();
-
-        for node in nodes {
-            parent.insert(node.clone(), node.clone());
-            rank.insert(node.clone(), 0);
+    fn new(num_nodes: usize) -> Self {
+        UnionFind {
+            parent: (0..num_nodes as NodeIndex).collect(),
+            rank: vec![0; num_nodes],
         }
-
-        UnionFind { parent, rank }
     }
 
-    fn find(&mut self, node: &str) -> String {
-        if self.parent.get(node).map(|p| p.as_str()) != Some(node) {
-            let parent = self.parent.get(node).unwrap().clone();
-            let root = self.find(&parent);
-            self.parent.insert(node.to_string(), root.clone());
-            root
-        } else {
-            node.to_string()
+    fn find(&mut self, node: NodeIndex) -> NodeIndex {
+        // Find the root, then compress the path behind us
+        let mut root = node;
+        while self.parent[root as usize] != root {
+            root = self.parent[root as usize];
         }
+        let mut current = node;
+        while self.parent[current as usize] != root {
+            let next = self.parent[current as usize];
+            self.parent[current as usize] = root;
+            current = next;
+        }
+        root
     }
 
-    fn union(&mut self, node1: &str, node2: &str) -> bool {
+    fn union(&mut self, node1: NodeIndex, node2: NodeIndex) -> bool {
         let root1 = self.find(node1);
         let root2 = self.find(node2);
 
@@ -42,29 +42,29 @@ impl UnionFind {
             return false; // Already in same set (would create cycle)
         }
 
-        let rank1 = self.rank.get(&root1).copied().unwrap_or(0);
-        let rank2 = self.rank.get(&root2).copied().unwrap_or(0);
+        let rank1 = self.rank[root1 as usize];
+        let rank2 = self.rank[root2 as usize];
 
         if rank1 < rank2 {
-            self.parent.insert(root1, root2);
+            self.parent[root1 as usize] = root2;
         } else if rank1 > rank2 {
-            self.parent.insert(root2, root1);
+            self.parent[root2 as usize] = root1;
         } else {
-            self.parent.insert(root2, root1.clone());
-            self.rank.insert(root1, rank1 + 1);
+            self.parent[root2 as usize] = root1;
+            self.rank[root1 as usize] = rank1 + 1;
         }
 
         true
     }
 }
 
-/// Edge struct for MST algorithms
-#[derive(Clone)]
+/// Edge struct for MST algorithms; `edge` indexes the network's edge list
+#[derive(Clone, Copy)]
 struct WeightedEdge {
-    from: String,
-    to: String,
+    from: NodeIndex,
+    to: NodeIndex,
     weight: f64,
-    edge_value: Value,
+    edge: u32,
 }
 
 impl Eq for WeightedEdge {}
@@ -106,47 +106,32 @@ pub fn kruskal(args: &[Value], _env: &mut Environment) -> Result<Value, String>
         _ => return Err("Network must have an 'edges' field with a vector".to_string()),
     };
 
+    let graph = graph_of(network)?;
+
     // Validate MST requirements (undirected + weighted)
-    validate_mst_requirements(edges_vec, "kruskal")?;
-
-    // Get all nodes
-    let node_ids = extract_node_ids(network)?;
-
-    // Extract and sort edges by weight
-    let mut weighted_edges: Vec<WeightedEdge> = Vec::new();
-
-    for edge in edges_vec {
-        match edge {
-            Value::Edge { from, to, properties, .. } => {
-                let weight = match properties.get("weight") {
-                    Some(Value::Number(w)) => *w,
-                    _ => unreachable!(), // Already validated
-                };
-
-                weighted_edges.push(WeightedEdge {
-                    from: from.clone(),
-                    to: to.clone(),
-                    weight,
-                    edge_value: edge.clone(),
-                });
-            }
-            _ => return Err("Invalid edge in edges vector".to_string()),
-        }
+    if graph.has_directed || !graph.has_positive_weights() {
+        validate_mst_requirements(edges_vec, "kruskal")?;
     }
 
-    // Sort edges by weight (ascending order)
-    weighted_edges.sort_by(|a, b| a.weight.partial_cmp(&b.weight).unwrap_or(Ordering::Equal));
+    // Sort edges by weight (ascending order, ties keep edge-list order)
+    let mut order: Vec<u32> = (0..graph.num_edges() as u32).collect();
+    order.sort_by(|&a, &b| {
+        graph.weights[a as usize]
+            .partial_cmp(&graph.weights[b as usize])
+            .unwrap_or(Ordering::Equal)
+    });
 
     // Kruskal's algorithm using Union-Find
-    let mut uf = UnionFind::new(&node_ids);
+    let mut uf = UnionFind::new(graph.num_nodes());
     let mut mst_edges = Vec::new();
     let mut total_weight = 0.0;
 
-    for edge in weighted_edges {
+    for edge in order {
         // Try to add edge to MST (will succeed if it doesn't create a cycle)
-        if uf.union(&edge.from, &edge.to) {
-            total_weight += edge.weight;
-            mst_edges.push(edge.edge_value);
+        let e = edge as usize;
+        if uf.union(graph.sources[e], graph.targets[e]) {
+            total_weight += graph.weights[e];
+            mst_edges.push(edges_vec[e].clone());
         }
     }
 
@@ -155,7 +140,7 @@ pub fn kruskal(args: &[Value], _env: &mut Environment) -> Result<Value, String>
     result.insert("edges".to_string(), Value::Vector(mst_edges));
     result.insert("total_weight".to_string(), Value::Number(total_weight));
 
-    Ok(Value::Record(result))
+    Ok(Value::Record(Box::new(result)))
 }
 
 /// Prim's algorithm - Minimum Spanning Tree
@@ -171,7 +156,8 @@ pub fn prim(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
     };
 
     // Validate start node exists
-    crate::function_modules::graphs::helpers::validate_node_exists(network, start_node)?;
+    let graph = graph_of(network)?;
+    let start_node = validate_node_index(network, &graph, start_node)?;
 
     // Get edges
     let edges_vec = match network.get("edges") {
@@ -180,82 +166,55 @@ pub fn prim(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
     };
 
     // Validate MST requirements (undirected + weighted)
-    validate_mst_requirements(edges_vec, "prim")?;
-
-    // Build adjacency list with edges and weights
-    let mut adj_list: HashMap<String, Vec<(String, f64, Value)>> = HashMap::new();
-
-    for edge in edges_vec {
-        match edge {
-            Value::Edge { from, to, properties, .. } => {
-                let weight = match properties.get("weight") {
-                    Some(Value::Number(w)) => *w,
-                    _ => unreachable!(), // Already validated
-                };
-
-                // Undirected graph: add both directions
-                adj_list
-                    .entry(from.clone())
-                    .or_insert_with(Vec::new)
-                    .push((to.clone(), weight, edge.clone()));
-
-                adj_list
-                    .entry(to.clone())
-                    .or_insert_with(Vec::new)
-                    .push((from.clone(), weight, edge.clone()));
-            }
-            _ => return Err("Invalid edge in edges vector".to_string()),
-        }
+    if graph.has_directed || !graph.has_positive_weights() {
+        validate_mst_requirements(edges_vec, "prim")?;
     }
 
+    // All edges are undirected, so the CSR adjacency lists both directions
+    let adjacency = graph.out();
+
     // Prim's algorithm using priority queue
-    let mut visited = HashSet::new();
+    let mut visited = vec![false; graph.num_nodes()];
     let mut heap = BinaryHeap::new();
     let mut mst_edges = Vec::new();
     let mut total_weight = 0.0;
 
+    let push_edges = |node: NodeIndex, heap: &mut BinaryHeap<WeightedEdge>, visited: &[bool]| {
+        let neighbors = adjacency.neighbors(node);
+        for (&neighbor, &edge) in neighbors.iter().zip(adjacency.edges(node)) {
+            if !visited[neighbor as usize] {
+                heap.push(WeightedEdge {
+                    from: node,
+                    to: neighbor,
+                    weight: graph.weights[edge as usize],
+                    edge,
+                });
+            }
+        }
+    };
+
     // Start from the given node
-    visited.insert(start_node.clone());
+    visited[start_node as usize] = true;
 
     // Add all edges from start node to heap
-    if let Some(neighbors) = adj_list.get(start_node) {
-        for (neighbor, weight, edge) in neighbors {
-            heap.push(WeightedEdge {
-                from: start_node.clone(),
-                to: neighbor.clone(),
-                weight: *weight,
-                edge_value: edge.clone(),
-            });
-        }
-    }
+    push_edges(start_node, &mut heap, &visited);
 
     // Process edges in order of weight
     while let Some(edge) = heap.pop() {
         // Skip if destination already visited
-        if visited.contains(&edge.to) {
+        if visited[edge.to as usize] {
             continue;
         }
 
         // Add node to visited set
-        visited.insert(edge.to.clone());
+        visited[edge.to as usize] = true;
 
         // Add edge to MST
         total_weight += edge.weight;
-        mst_edges.push(edge.edge_value);
+        mst_edges.push(edges_vec[edge.edge as usize].clone());
 
         // Add all edges from newly added node
-        if let Some(neighbors) = adj_list.get(&edge.to) {
-            for (neighbor, weight, neighbor_edge) in neighbors {
-                if !visited.contains(neighbor) {
-                    heap.push(WeightedEdge {
-                        from: edge.to.clone(),
-                        to: neighbor.clone(),
-                        weight: *weight,
-                        edge_value: neighbor_edge.clone(),
-                    });
-                }
-            }
-        }
+        push_edges(edge.to, &mut heap, &visited);
     }
 
     // Build result record
@@ -263,5 +222,5 @@ pub fn prim(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
     result.insert("edges".to_string(), Value::Vector(mst_edges));
     result.insert("total_weight".to_string(), Value::Number(total_weight));
 
-    Ok(Value::Record(result))
+    Ok(Value::Record(Box::new(result)))
 }
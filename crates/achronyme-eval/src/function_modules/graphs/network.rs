@@ -1,3 +1,4 @@
+use super::csr::graph_of;
 use achronyme_types::value::Value;
 use achronyme_types::Environment;
 use std::collections::{HashMap, HashSet};
@@ -16,6 +17,8 @@ use std::collections::{HashMap, HashSet};
 /// - Nodes referenced in edges but not in properties will have empty properties {}
 /// - Nodes in properties but not in edges are allowed (isolated nodes)
 /// - Node properties are flexible - any record structure is accepted
+/// - The compact graph used by the algorithms is built here and cached, so
+///   the first algorithm call on the network does not pay for it
 pub fn network(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
     // Validate argument count
     if args.is_empty() || args.len() > 2 {
@@ -58,18 +61,18 @@ pub fn network(args: &[Value], _env: &mut Environment) -> Result<Value, String>
     };
 
     // Step 1: Extract nodes referenced in edges
-    let mut all_nodes = HashSet::new();
+    let mut all_nodes: HashSet<&str> = HashSet::new();
     for edge in edges_vec.iter() {
         if let Value::Edge { from, to, .. } = edge {
-            all_nodes.insert(from.clone());
-            all_nodes.insert(to.clone());
+            all_nodes.insert(from.as_str());
+            all_nodes.insert(to.as_str());
         }
     }
 
     // Step 2: Add nodes from properties (includes isolated nodes)
     if let Some(props) = node_props {
         for node_id in props.keys() {
-            all_nodes.insert(node_id.clone());
+            all_nodes.insert(node_id.as_str());
         }
     }
 
@@ -79,23 +82,25 @@ pub fn network(args: &[Value], _env: &mut Environment) -> Result<Value, String>
     for node_id in all_nodes {
         let node_data = if let Some(props) = node_props {
             // Use provided properties if available
-            props.get(&node_id)
+            props.get(node_id)
                 .cloned()
-                .unwrap_or(Value::Record(HashMap::new()))
+                .unwrap_or(Value::Record(Box::new(HashMap::new())))
         } else {
             // No properties provided, use empty record
-            Value::Record(HashMap::new())
+            Value::Record(Box::new(HashMap::new()))
         };
 
-        nodes_record.insert(node_id, node_data);
+        nodes_record.insert(node_id.to_string(), node_data);
     }
 
     // Step 4: Build the network record
     let mut network_map = HashMap::new();
-    network_map.insert("nodes".to_string(), Value::Record(nodes_record));
+    network_map.insert("nodes".to_string(), Value::Record(Box::new(nodes_record)));
     network_map.insert("edges".to_string(), Value::Vector(edges_vec.clone()));
 
-    Ok(Value::Record(network_map))
+    graph_of(&network_map)?;
+
+    Ok(Value::Record(Box::new(network_map)))
 }
 
 /// Extract nodes from a network
@@ -136,40 +141,23 @@ pub fn neighbors(args: &[Value], _env: &mut Environment) -> Result<Value, String
         _ => return Err("neighbors() requires a string node ID as second argument".to_string()),
     };
 
-    // Get edges from network
-    let edges_vec = match network.get("edges") {
-        Some(Value::Vector(v)) => v,
-        _ => return Err("Network must have an 'edges' field with a vector".to_string()),
-    };
+    let graph = graph_of(network)?;
 
-    // Collect unique neighbors
+    // Collect unique neighbors (undirected edges are listed both ways)
     let mut neighbor_set = HashSet::new();
-
-    for edge in edges_vec.iter() {
-        match edge {
-            Value::Edge { from, to, directed, .. } => {
-                // If edge is from our node, add 'to' as neighbor
-                if from == node_id {
-                    neighbor_set.insert(to.clone());
-                }
-                // If edge is to our node and undirected, add 'from' as neighbor
-                if to == node_id && !directed {
-                    neighbor_set.insert(from.clone());
-                }
-                // If edge is to our node and directed, don't add 'from'
-                // (directed edges only go one way)
-            }
-            _ => return Err("edges vector must contain only Edge values".to_string()),
+    if let Some(node) = graph.index_of(node_id) {
+        for &neighbor in graph.out().neighbors(node) {
+            neighbor_set.insert(graph.name(neighbor));
         }
     }
 
     // Convert to sorted vector of strings
-    let mut neighbors_list: Vec<String> = neighbor_set.into_iter().collect();
+    let mut neighbors_list: Vec<&str> = neighbor_set.into_iter().collect();
     neighbors_list.sort();
 
     let neighbors_values: Vec<Value> = neighbors_list
         .into_iter()
-        .map(Value::String)
+        .map(|node| Value::String(node.to_string()))
         .collect();
 
     Ok(Value::Vector(neighbors_values))
@@ -188,32 +176,16 @@ pub fn degree(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
         _ => return Err("degree() requires a string node ID as second argument".to_string()),
     };
 
-    // Get edges from network
-    let edges_vec = match network.get("edges") {
-        Some(Value::Vector(v)) => v,
-        _ => return Err("Network must have an 'edges' field with a vector".to_string()),
-    };
+    let graph = graph_of(network)?;
 
     // Count edges connected to this node
-    let mut edge_count = 0;
-
-    for edge in edges_vec.iter() {
-        match edge {
-            Value::Edge { from, to, .. } => {
-                // Count edge if it's from our node
-                if from == node_id {
-                    edge_count += 1;
-                }
-                // Count edge if it's to our node
-                // For directed edges, this is in-degree
-                // For undirected edges, we already counted it above, so skip
-                else if to == node_id {
-                    edge_count += 1;
-                }
-            }
-            _ => return Err("edges vector must contain only Edge values".to_string()),
-        }
-    }
+    // (an edge from or to the node counts once, self-loops included)
+    let edge_count = match graph.index_of(node_id) {
+        Some(node) => (0..graph.num_edges())
+            .filter(|&e| graph.sources[e] == node || graph.targets[e] == node)
+            .count(),
+        None => 0,
+    };
 
     Ok(Value::Number(edge_count as f64))
 }
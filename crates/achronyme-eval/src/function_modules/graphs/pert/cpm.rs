@@ -1,10 +1,16 @@
 // PERT/CPM - Critical Path Method (Costos)
+//
+// The passes work on the network's compact graph (dense node indices, CSR
+// adjacency) and write their results into the node records of a network
+// they own, so chaining them (backward_pass -> forward_pass, calculate_slack
+// -> backward_pass) never copies the edge list more than once.
 
 use achronyme_types::value::Value;
 use achronyme_types::Environment;
 use std::collections::HashMap;
-use super::super::helpers::build_adjacency_list;
-use super::super::topological::topological_sort;
+use super::super::csr::{graph_of, Graph, NodeIndex};
+use super::super::cycles::network_has_cycle;
+use super::super::topological::topological_order;
 use super::validation::{validate_dag, validate_node_durations, get_node_duration};
 use super::state_detection::{has_es_ef_data, has_ls_lf_data};
 
@@ -17,91 +23,7 @@ pub fn forward_pass(args: &[Value], _env: &mut Environment) -> Result<Value, Str
         _ => return Err("forward_pass() requires a network record".to_string()),
     };
 
-    // Validate DAG and durations
-    validate_dag(network, _env)?;
-    validate_node_durations(network)?;
-
-    // Get nodes and edges
-    let nodes_record = match network.get("nodes") {
-        Some(Value::Record(r)) => r,
-        _ => return Err("Network must have 'nodes' field".to_string()),
-    };
-
-    let edges_vec = match network.get("edges") {
-        Some(Value::Vector(v)) => v,
-        _ => return Err("Network must have 'edges' field".to_string()),
-    };
-
-    // Build reverse adjacency list (predecessors)
-    let mut predecessors: HashMap<String, Vec<String>> = HashMap::new();
-    for edge in edges_vec {
-        if let Value::Edge { from, to, .. } = edge {
-            predecessors.entry(to.clone())
-                .or_insert_with(Vec::new)
-                .push(from.clone());
-        }
-    }
-
-    // Get topological order
-    let topo_order = match topological_sort(&[Value::Record(network.clone())], _env)? {
-        Value::Vector(v) => v,
-        _ => return Err("Failed to get topological order".to_string()),
-    };
-
-    // Calculate ES and EF for each node in topological order
-    let mut es_map: HashMap<String, f64> = HashMap::new();
-    let mut ef_map: HashMap<String, f64> = HashMap::new();
-
-    for node_val in topo_order {
-        let node_id = match node_val {
-            Value::String(s) => s,
-            _ => return Err("Invalid node in topological order".to_string()),
-        };
-
-        let node_props = match nodes_record.get(&node_id) {
-            Some(Value::Record(p)) => p,
-            _ => return Err(format!("Node '{}' not found", node_id)),
-        };
-
-        let duration = get_node_duration(node_props)?;
-
-        // ES = max(EF of all predecessors), or 0 if no predecessors
-        let es = if let Some(preds) = predecessors.get(&node_id) {
-            let mut max_ef: f64 = 0.0;
-            for pred in preds {
-                if let Some(pred_ef) = ef_map.get(pred) {
-                    max_ef = max_ef.max(*pred_ef);
-                }
-            }
-            max_ef
-        } else {
-            0.0 // Start nodes have ES = 0
-        };
-
-        let ef = es + duration;
-
-        es_map.insert(node_id.clone(), es);
-        ef_map.insert(node_id.clone(), ef);
-    }
-
-    // Build new network with ES and EF added to nodes
-    let mut new_nodes = HashMap::new();
-    for (node_id, node_data) in nodes_record {
-        let mut new_props = match node_data {
-            Value::Record(p) => p.clone(),
-            _ => HashMap::new(),
-        };
-
-        new_props.insert("ES".to_string(), Value::Number(*es_map.get(node_id.as_str()).unwrap()));
-        new_props.insert("EF".to_string(), Value::Number(*ef_map.get(node_id.as_str()).unwrap()));
-
-        new_nodes.insert(node_id.clone(), Value::Record(new_props));
-    }
-
-    let mut new_network = network.clone();
-    new_network.insert("nodes".to_string(), Value::Record(new_nodes));
-
-    Ok(Value::Record(new_network))
+    Ok(Value::Record(Box::new(with_early_times(*network.clone())?)))
 }
 
 /// Backward pass: Calculate Late Start (LS) and Late Finish (LF) for all tasks
@@ -114,39 +36,53 @@ pub fn backward_pass(args: &[Value], _env: &mut Environment) -> Result<Value, St
         _ => return Err("backward_pass() requires a network record".to_string()),
     };
 
-    // Auto-calculate forward pass if ES/EF data is missing
-    let network_with_es_ef = if !has_es_ef_data(network) {
-        match forward_pass(&[Value::Record(network.clone())], _env)? {
-            Value::Record(n) => n,
-            _ => return Err("Failed to calculate forward pass".to_string()),
-        }
-    } else {
-        network.clone()
-    };
+    Ok(Value::Record(Box::new(with_late_times(*network.clone())?)))
+}
 
-    // Validate that network has ES/EF (from forward_pass)
-    let nodes_record = match network_with_es_ef.get("nodes") {
-        Some(Value::Record(r)) => r,
-        _ => return Err("Network must have 'nodes' field".to_string()),
+/// Calculate slack (float) for all tasks
+/// Slack = LS - ES (or LF - EF)
+/// Auto-calculates forward_pass and backward_pass if ES/EF or LS/LF data is missing
+pub fn calculate_slack(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
+    let network = match &args[0] {
+        Value::Record(map) => map,
+        _ => return Err("calculate_slack() requires a network record".to_string()),
     };
 
-    let edges_vec = match network_with_es_ef.get("edges") {
-        Some(Value::Vector(v)) => v,
-        _ => return Err("Network must have 'edges' field".to_string()),
-    };
+    Ok(Value::Record(Box::new(with_slack(*network.clone())?)))
+}
+
+/// `network` with ES and EF added to every node
+pub(super) fn with_early_times(mut network: HashMap<String, Value>) -> Result<HashMap<String, Value>, String> {
+    // Validate DAG and durations
+    validate_dag(&network)?;
+    validate_node_durations(&network)?;
 
-    // Build adjacency list (successors)
-    let adj_list = build_adjacency_list(edges_vec)?;
+    let graph = graph_of(&network)?;
+    let (es, ef) = early_times(&network, &graph)?;
 
-    // Get topological order (reversed for backward pass)
-    let topo_order = match topological_sort(&[Value::Record(network_with_es_ef.clone())], _env)? {
-        Value::Vector(mut v) => {
-            v.reverse();
-            v
-        }
-        _ => return Err("Failed to get topological order".to_string()),
+    annotate_nodes(&mut network, &graph, &[("ES", &es), ("EF", &ef)])?;
+    Ok(network)
+}
+
+/// `network` with LS and LF added to every node (and ES/EF if missing)
+pub(super) fn with_late_times(network: HashMap<String, Value>) -> Result<HashMap<String, Value>, String> {
+    // Auto-calculate forward pass if ES/EF data is missing
+    let mut network = if !has_es_ef_data(&network) {
+        with_early_times(network)?
+    } else {
+        network
     };
 
+    if network_has_cycle(&network)? {
+        return Err(
+            "topological_sort() requires a Directed Acyclic Graph (DAG), but the graph contains cycles"
+                .to_string(),
+        );
+    }
+
+    let graph = graph_of(&network)?;
+    let nodes_record = nodes_of(&network)?;
+
     // Find project completion time (max EF)
     let project_completion = nodes_record.values()
         .filter_map(|node_data| {
@@ -159,117 +95,150 @@ pub fn backward_pass(args: &[Value], _env: &mut Environment) -> Result<Value, St
         })
         .fold(0.0, f64::max);
 
-    // Calculate LS and LF for each node in reverse topological order
-    let mut ls_map: HashMap<String, f64> = HashMap::new();
-    let mut lf_map: HashMap<String, f64> = HashMap::new();
-
-    for node_val in topo_order {
-        let node_id = match node_val {
-            Value::String(s) => s,
-            _ => return Err("Invalid node in topological order".to_string()),
-        };
-
-        let node_props = match nodes_record.get(&node_id) {
-            Some(Value::Record(p)) => p,
-            _ => return Err(format!("Node '{}' not found", node_id)),
-        };
+    let order = schedule_order(&graph)?;
+    let durations = node_durations(nodes_record, &graph)?;
 
-        let duration = get_node_duration(node_props)?;
+    // Calculate LS and LF for each node in reverse topological order
+    let successors = graph.out();
+    let mut ls = vec![0.0; graph.num_nodes()];
+    let mut lf = vec![0.0; graph.num_nodes()];
 
+    for &node in order.iter().rev() {
         // LF = min(LS of all successors), or project_completion if no successors
-        let lf = if let Some(succs) = adj_list.get(&node_id) {
-            let mut min_ls = f64::INFINITY;
-            for succ in succs {
-                if let Some(succ_ls) = ls_map.get(succ) {
-                    min_ls = min_ls.min(*succ_ls);
-                }
-            }
-            if min_ls == f64::INFINITY {
-                project_completion
-            } else {
-                min_ls
-            }
-        } else {
-            project_completion // End nodes have LF = project completion
-        };
-
-        let ls = lf - duration;
-
-        ls_map.insert(node_id.clone(), ls);
-        lf_map.insert(node_id.clone(), lf);
+        let min_ls = successors
+            .neighbors(node)
+            .iter()
+            .map(|&succ| ls[succ as usize])
+            .fold(f64::INFINITY, f64::min);
+        let finish = if min_ls == f64::INFINITY { project_completion } else { min_ls };
+
+        lf[node as usize] = finish;
+        ls[node as usize] = finish - durations[node as usize];
     }
 
-    // Build new network with LS and LF added to nodes
-    let mut new_nodes = HashMap::new();
-    for (node_id, node_data) in nodes_record {
-        let mut new_props = match node_data {
-            Value::Record(p) => p.clone(),
-            _ => HashMap::new(),
-        };
-
-        new_props.insert("LS".to_string(), Value::Number(*ls_map.get(node_id.as_str()).unwrap()));
-        new_props.insert("LF".to_string(), Value::Number(*lf_map.get(node_id.as_str()).unwrap()));
-
-        new_nodes.insert(node_id.clone(), Value::Record(new_props));
-    }
-
-    let mut new_network = network_with_es_ef.clone();
-    new_network.insert("nodes".to_string(), Value::Record(new_nodes));
-
-    Ok(Value::Record(new_network))
+    annotate_nodes(&mut network, &graph, &[("LS", &ls), ("LF", &lf)])?;
+    Ok(network)
 }
 
-/// Calculate slack (float) for all tasks
-/// Slack = LS - ES (or LF - EF)
-/// Auto-calculates forward_pass and backward_pass if ES/EF or LS/LF data is missing
-pub fn calculate_slack(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
-    let network = match &args[0] {
-        Value::Record(map) => map,
-        _ => return Err("calculate_slack() requires a network record".to_string()),
-    };
-
+/// `network` with slack added to every node (and ES/EF/LS/LF if missing)
+pub(super) fn with_slack(network: HashMap<String, Value>) -> Result<HashMap<String, Value>, String> {
     // Auto-calculate backward pass if LS/LF data is missing
-    // (backward_pass will auto-calculate forward_pass if ES/EF is also missing)
-    let network_with_all_data = if !has_ls_lf_data(network) {
-        match backward_pass(&[Value::Record(network.clone())], _env)? {
-            Value::Record(n) => n,
-            _ => return Err("Failed to calculate backward pass".to_string()),
-        }
+    // (with_late_times will auto-calculate the forward pass if ES/EF is also missing)
+    let mut network = if !has_ls_lf_data(&network) {
+        with_late_times(network)?
     } else {
-        network.clone()
+        network
     };
 
-    let nodes_record = match network_with_all_data.get("nodes") {
+    let nodes_record = match network.get_mut("nodes") {
         Some(Value::Record(r)) => r,
         _ => return Err("Network must have 'nodes' field".to_string()),
     };
 
     // Calculate slack for each node
-    let mut new_nodes = HashMap::new();
-    for (node_id, node_data) in nodes_record {
-        let mut new_props = match node_data {
-            Value::Record(p) => p.clone(),
-            _ => HashMap::new(),
+    for (node_id, node_data) in nodes_record.iter_mut() {
+        let props = match node_data {
+            Value::Record(p) => p,
+            _ => return Err(format!("Node '{}' missing ES", node_id)),
         };
 
-        let es = match new_props.get("ES") {
+        let es = match props.get("ES") {
             Some(Value::Number(n)) => *n,
             _ => return Err(format!("Node '{}' missing ES", node_id)),
         };
 
-        let ls = match new_props.get("LS") {
+        let ls = match props.get("LS") {
             Some(Value::Number(n)) => *n,
             _ => return Err(format!("Node '{}' missing LS", node_id)),
         };
 
-        let slack = ls - es;
-        new_props.insert("slack".to_string(), Value::Number(slack));
+        props.insert("slack".to_string(), Value::Number(ls - es));
+    }
+
+    Ok(network)
+}
+
+/// ES and EF by node index; the network must already be validated as a DAG
+pub(super) fn early_times(network: &HashMap<String, Value>, graph: &Graph) -> Result<(Vec<f64>, Vec<f64>), String> {
+    let order = schedule_order(graph)?;
+    let durations = node_durations(nodes_of(network)?, graph)?;
+
+    // Calculate ES and EF for each node in topological order
+    let predecessors = graph.predecessors();
+    let mut es = vec![0.0; graph.num_nodes()];
+    let mut ef = vec![0.0; graph.num_nodes()];
 
-        new_nodes.insert(node_id.clone(), Value::Record(new_props));
+    for node in order {
+        // ES = max(EF of all predecessors), or 0 if no predecessors
+        let start = predecessors
+            .neighbors(node)
+            .iter()
+            .map(|&pred| ef[pred as usize])
+            .fold(0.0, f64::max);
+
+        es[node as usize] = start;
+        ef[node as usize] = start + durations[node as usize];
     }
 
-    let mut new_network = network_with_all_data.clone();
-    new_network.insert("nodes".to_string(), Value::Record(new_nodes));
+    Ok((es, ef))
+}
+
+fn nodes_of(network: &HashMap<String, Value>) -> Result<&HashMap<String, Value>, String> {
+    match network.get("nodes") {
+        Some(Value::Record(r)) => Ok(r),
+        _ => Err("Network must have 'nodes' field".to_string()),
+    }
+}
+
+/// Topological order that must cover every node
+///
+/// Kahn's algorithm never releases the endpoints of an undirected edge, so
+/// a short order means the network is not a proper precedence graph.
+fn schedule_order(graph: &Graph) -> Result<Vec<NodeIndex>, String> {
+    let order = topological_order(graph);
+    if order.len() != graph.num_nodes() {
+        return Err("PERT requires all edges to be directed (use -> edges)".to_string());
+    }
+    Ok(order)
+}
+
+/// Duration of every node, by node index
+fn node_durations(nodes_record: &HashMap<String, Value>, graph: &Graph) -> Result<Vec<f64>, String> {
+    graph
+        .nodes
+        .iter()
+        .map(|node_id| match nodes_record.get(node_id.as_ref()) {
+            Some(Value::Record(props)) => get_node_duration(props),
+            _ => Err(format!("Node '{}' not found", node_id)),
+        })
+        .collect()
+}
+
+/// Write per-node columns (by node index) into the node records, in place
+fn annotate_nodes(
+    network: &mut HashMap<String, Value>,
+    graph: &Graph,
+    columns: &[(&str, &[f64])],
+) -> Result<(), String> {
+    let nodes_record = match network.get_mut("nodes") {
+        Some(Value::Record(r)) => r,
+        _ => return Err("Network must have 'nodes' field".to_string()),
+    };
+
+    for (node_id, node_data) in nodes_record.iter_mut() {
+        let index = graph
+            .index_of(node_id)
+            .ok_or_else(|| format!("Node '{}' not found", node_id))? as usize;
+
+        if !matches!(node_data, Value::Record(_)) {
+            *node_data = Value::Record(Box::new(HashMap::new()));
+        }
+        if let Value::Record(props) = node_data {
+            for (name, values) in columns {
+                props.insert(name.to_string(), Value::Number(values[index]));
+            }
+        }
+    }
 
-    Ok(Value::Record(new_network))
+    Ok(())
 }
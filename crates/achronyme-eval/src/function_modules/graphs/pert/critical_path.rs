@@ -2,156 +2,159 @@
 
 use achronyme_types::value::Value;
 use achronyme_types::Environment;
-use std::collections::{HashMap, HashSet};
+use std::borrow::Cow;
+use std::collections::HashMap;
+use std::rc::Rc;
+use super::super::csr::{graph_of, Graph, NodeIndex};
+use super::super::topological::topological_order;
 use super::state_detection::has_slack_data;
-use super::cpm::calculate_slack;
-
-/// Find one complete critical path from start to finish
-/// Returns a single path (vector of node IDs) following nodes with slack = 0
-/// Auto-calculates all prerequisites (forward_pass, backward_pass, calculate_slack) if missing
-pub fn critical_path(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
-    let network = match &args[0] {
-        Value::Record(map) => map,
-        _ => return Err("critical_path() requires a network record".to_string()),
-    };
+use super::cpm::with_slack;
+
+/// Critical nodes of a network with slack data, on its compact graph
+struct CriticalNetwork {
+    graph: Rc<Graph>,
+    /// slack ~= 0, by node index
+    critical: Vec<bool>,
+    /// Critical node with ES = 0 where paths start
+    start: NodeIndex,
+    /// Critical nodes with EF = project duration, by node index
+    is_end: Vec<bool>,
+}
 
-    // Auto-calculate slack if missing
-    // (calculate_slack will auto-calculate forward_pass and backward_pass if needed)
-    let network_with_slack = if !has_slack_data(network) {
-        match calculate_slack(&[Value::Record(network.clone())], _env)? {
-            Value::Record(n) => n,
-            _ => return Err("Failed to calculate slack".to_string()),
+impl CriticalNetwork {
+    fn new(network: &HashMap<String, Value>) -> Result<Self, String> {
+        let nodes_record = match network.get("nodes") {
+            Some(Value::Record(r)) => r,
+            _ => return Err("Network must have 'nodes' field".to_string()),
+        };
+        let graph = graph_of(network)?;
+
+        let number = |index: usize, field: &str| match nodes_record.get(graph.nodes[index].as_ref()) {
+            Some(Value::Record(props)) => match props.get(field) {
+                Some(Value::Number(n)) => Some(*n),
+                _ => None,
+            },
+            _ => None,
+        };
+
+        // Find nodes with slack ~= 0 (critical nodes)
+        let epsilon = 1e-6;
+        let critical: Vec<bool> = (0..graph.num_nodes())
+            .map(|i| number(i, "slack").map_or(false, |slack| slack.abs() < epsilon))
+            .collect();
+
+        // Find start node (ES = 0 and is critical)
+        let start = (0..graph.num_nodes())
+            .find(|&i| critical[i] && number(i, "ES").map_or(false, |es| es.abs() < epsilon))
+            .ok_or("No critical start node found (ES=0)")? as NodeIndex;
+
+        // Find project duration to identify end nodes
+        let project_duration = (0..graph.num_nodes())
+            .filter_map(|i| number(i, "EF"))
+            .fold(0.0, f64::max);
+
+        // Find end nodes (EF = project_duration and is critical)
+        let is_end: Vec<bool> = (0..graph.num_nodes())
+            .map(|i| critical[i] && number(i, "EF").map_or(false, |ef| (ef - project_duration).abs() < epsilon))
+            .collect();
+
+        if !is_end.iter().any(|&end| end) {
+            return Err("No critical end node found".to_string());
         }
-    } else {
-        network.clone()
-    };
-
-    let nodes_record = match network_with_slack.get("nodes") {
-        Some(Value::Record(r)) => r,
-        _ => return Err("Network must have 'nodes' field".to_string()),
-    };
-
-    let edges_vec = match network_with_slack.get("edges") {
-        Some(Value::Vector(v)) => v,
-        _ => return Err("Network must have 'edges' field".to_string()),
-    };
-
-    // Find nodes with slack ~= 0 (critical nodes)
-    let epsilon = 1e-6;
-    let mut critical_nodes_set: HashSet<String> = HashSet::new();
 
-    for (node_id, node_data) in nodes_record {
-        if let Value::Record(props) = node_data {
-            if let Some(Value::Number(slack)) = props.get("slack") {
-                if slack.abs() < epsilon {
-                    critical_nodes_set.insert(node_id.clone());
-                }
-            }
-        }
+        Ok(CriticalNetwork { graph, critical, start, is_end })
     }
 
-    // Build adjacency list for critical nodes only
-    let mut critical_adj: HashMap<String, Vec<String>> = HashMap::new();
-    for edge in edges_vec {
-        if let Value::Edge { from, to, .. } = edge {
-            if critical_nodes_set.contains(from) && critical_nodes_set.contains(to) {
-                critical_adj.entry(from.clone())
-                    .or_insert_with(Vec::new)
-                    .push(to.clone());
-            }
-        }
+    /// First successor of `node` at or after adjacency slot `from` along an
+    /// edge between two critical nodes (followed as written, from -> to)
+    /// that passes `accept`, with the slot to resume from next time
+    fn next_successor(&self, node: NodeIndex, from: usize, accept: impl Fn(NodeIndex) -> bool) -> Option<(usize, NodeIndex)> {
+        let adjacency = self.graph.out();
+        let neighbors = adjacency.neighbors(node);
+        let edges = adjacency.edges(node);
+        (from..neighbors.len())
+            .find(|&slot| {
+                let next = neighbors[slot];
+                self.graph.sources[edges[slot] as usize] == node
+                    && self.critical[node as usize]
+                    && self.critical[next as usize]
+                    && accept(next)
+            })
+            .map(|slot| (slot + 1, neighbors[slot]))
     }
 
-    // Find start node (ES = 0 and is critical)
-    let mut start_node: Option<String> = None;
-    for (node_id, node_data) in nodes_record {
-        if critical_nodes_set.contains(node_id.as_str()) {
-            if let Value::Record(props) = node_data {
-                if let Some(Value::Number(es)) = props.get("ES") {
-                    if es.abs() < epsilon {
-                        start_node = Some(node_id.clone());
-                        break;
-                    }
-                }
-            }
-        }
+    fn path_value(&self, path: &[NodeIndex]) -> Value {
+        Value::Vector(path.iter().map(|&node| self.graph.name_value(node)).collect())
     }
+}
 
-    let start = start_node.ok_or("No critical start node found (ES=0)")?;
-
-    // Find project duration to identify end nodes
-    let project_duration = nodes_record.values()
-        .filter_map(|node_data| {
-            if let Value::Record(props) = node_data {
-                if let Some(Value::Number(ef)) = props.get("EF") {
-                    return Some(*ef);
-                }
-            }
-            None
-        })
-        .fold(0.0, f64::max);
-
-    // Find end nodes (EF = project_duration and is critical)
-    let mut end_nodes: Vec<String> = Vec::new();
-    for (node_id, node_data) in nodes_record {
-        if critical_nodes_set.contains(node_id.as_str()) {
-            if let Value::Record(props) = node_data {
-                if let Some(Value::Number(ef)) = props.get("EF") {
-                    if (ef - project_duration).abs() < epsilon {
-                        end_nodes.push(node_id.clone());
-                    }
-                }
-            }
-        }
+/// The network itself when it already has slack data, otherwise an
+/// annotated copy (calculate_slack auto-calculates the passes it needs)
+fn network_with_slack(network: &HashMap<String, Value>) -> Result<Cow<'_, HashMap<String, Value>>, String> {
+    if has_slack_data(network) {
+        Ok(Cow::Borrowed(network))
+    } else {
+        Ok(Cow::Owned(with_slack(network.clone())?))
     }
+}
 
-    if end_nodes.is_empty() {
-        return Err("No critical end node found".to_string());
-    }
+/// Find one complete critical path from start to finish
+/// Returns a single path (vector of node IDs) following nodes with slack = 0
+/// Auto-calculates all prerequisites (forward_pass, backward_pass, calculate_slack) if missing
+pub fn critical_path(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
+    let network = match &args[0] {
+        Value::Record(map) => map,
+        _ => return Err("critical_path() requires a network record".to_string()),
+    };
 
-    // DFS to find one complete path from start to any end node
-    fn dfs_find_path(
-        current: &str,
-        end_nodes: &[String],
-        adj: &HashMap<String, Vec<String>>,
-        path: &mut Vec<String>,
-        visited: &mut HashSet<String>,
-    ) -> bool {
-        path.push(current.to_string());
-        visited.insert(current.to_string());
+    network_critical_path(network)
+}
 
+/// `critical_path` on a borrowed network
+pub(super) fn network_critical_path(network: &HashMap<String, Value>) -> Result<Value, String> {
+    let network = network_with_slack(network)?;
+    let critical = CriticalNetwork::new(&network)?;
+    let num_nodes = critical.graph.num_nodes();
+
+    // DFS to find one complete path from start to any end node, with an
+    // explicit stack. In a DAG a node that cannot reach an end node from one
+    // path cannot reach it from any other, so dead ends are never retried.
+    let mut dead_end = vec![false; num_nodes];
+    let mut on_path = vec![false; num_nodes];
+    let mut path = vec![critical.start];
+    let mut positions = vec![0usize];
+    on_path[critical.start as usize] = true;
+
+    while let Some(&current) = path.last() {
         // Check if we reached an end node
-        if end_nodes.contains(&current.to_string()) {
-            return true;
+        if critical.is_end[current as usize] {
+            return Ok(critical.path_value(&path));
         }
 
-        // Explore neighbors
-        if let Some(neighbors) = adj.get(current) {
-            for neighbor in neighbors {
-                if !visited.contains(neighbor) {
-                    if dfs_find_path(neighbor, end_nodes, adj, path, visited) {
-                        return true;
-                    }
-                }
+        // Explore the next untried neighbor
+        let position = positions.last_mut().unwrap();
+        let next = critical.next_successor(current, *position, |next| {
+            !on_path[next as usize] && !dead_end[next as usize]
+        });
+
+        match next {
+            Some((resume, next)) => {
+                *position = resume;
+                on_path[next as usize] = true;
+                path.push(next);
+                positions.push(0);
+            }
+            None => {
+                // Backtrack
+                dead_end[current as usize] = true;
+                on_path[current as usize] = false;
+                path.pop();
+                positions.pop();
             }
         }
-
-        // Backtrack
-        path.pop();
-        visited.remove(current);
-        false
     }
 
-    let mut path = Vec::new();
-    let mut visited = HashSet::new();
-
-    if !dfs_find_path(&start, &end_nodes, &critical_adj, &mut path, &mut visited) {
-        return Err("Could not find complete critical path from start to end".to_string());
-    }
-
-    // Convert to Value::Vector
-    let path_values: Vec<Value> = path.into_iter().map(Value::String).collect();
-    Ok(Value::Vector(path_values))
+    Err("Could not find complete critical path from start to end".to_string())
 }
 
 /// Find all complete critical paths from start to finish
@@ -164,144 +167,61 @@ pub fn all_critical_paths(args: &[Value], _env: &mut Environment) -> Result<Valu
         _ => return Err("all_critical_paths() requires a network record".to_string()),
     };
 
-    // Auto-calculate slack if missing
-    let network_with_slack = if !has_slack_data(network) {
-        match calculate_slack(&[Value::Record(network.clone())], _env)? {
-            Value::Record(n) => n,
-            _ => return Err("Failed to calculate slack".to_string()),
-        }
-    } else {
-        network.clone()
-    };
-
-    let nodes_record = match network_with_slack.get("nodes") {
-        Some(Value::Record(r)) => r,
-        _ => return Err("Network must have 'nodes' field".to_string()),
-    };
-
-    let edges_vec = match network_with_slack.get("edges") {
-        Some(Value::Vector(v)) => v,
-        _ => return Err("Network must have 'edges' field".to_string()),
-    };
-
-    // Find nodes with slack ~= 0 (critical nodes)
-    let epsilon = 1e-6;
-    let mut critical_nodes_set: HashSet<String> = HashSet::new();
-
-    for (node_id, node_data) in nodes_record {
-        if let Value::Record(props) = node_data {
-            if let Some(Value::Number(slack)) = props.get("slack") {
-                if slack.abs() < epsilon {
-                    critical_nodes_set.insert(node_id.clone());
-                }
-            }
-        }
-    }
-
-    // Build adjacency list for critical nodes only
-    let mut critical_adj: HashMap<String, Vec<String>> = HashMap::new();
-    for edge in edges_vec {
-        if let Value::Edge { from, to, .. } = edge {
-            if critical_nodes_set.contains(from) && critical_nodes_set.contains(to) {
-                critical_adj.entry(from.clone())
-                    .or_insert_with(Vec::new)
-                    .push(to.clone());
-            }
-        }
-    }
-
-    // Find start node (ES = 0 and is critical)
-    let mut start_node: Option<String> = None;
-    for (node_id, node_data) in nodes_record {
-        if critical_nodes_set.contains(node_id.as_str()) {
-            if let Value::Record(props) = node_data {
-                if let Some(Value::Number(es)) = props.get("ES") {
-                    if es.abs() < epsilon {
-                        start_node = Some(node_id.clone());
-                        break;
-                    }
-                }
-            }
-        }
-    }
-
-    let start = start_node.ok_or("No critical start node found (ES=0)")?;
-
-    // Find project duration to identify end nodes
-    let project_duration = nodes_record.values()
-        .filter_map(|node_data| {
-            if let Value::Record(props) = node_data {
-                if let Some(Value::Number(ef)) = props.get("EF") {
-                    return Some(*ef);
-                }
-            }
-            None
-        })
-        .fold(0.0, f64::max);
-
-    // Find end nodes (EF = project_duration and is critical)
-    let mut end_nodes: Vec<String> = Vec::new();
-    for (node_id, node_data) in nodes_record {
-        if critical_nodes_set.contains(node_id.as_str()) {
-            if let Value::Record(props) = node_data {
-                if let Some(Value::Number(ef)) = props.get("EF") {
-                    if (ef - project_duration).abs() < epsilon {
-                        end_nodes.push(node_id.clone());
-                    }
-                }
-            }
-        }
-    }
-
-    if end_nodes.is_empty() {
-        return Err("No critical end node found".to_string());
+    let network = network_with_slack(network)?;
+    let critical = CriticalNetwork::new(&network)?;
+    let num_nodes = critical.graph.num_nodes();
+
+    // Which nodes can reach an end node along critical edges, computed in
+    // reverse topological order so the enumeration below only walks
+    // branches that produce a path
+    let mut reaches_end = vec![false; num_nodes];
+    for &node in topological_order(&critical.graph).iter().rev() {
+        let reaches = critical.is_end[node as usize]
+            || critical.next_successor(node, 0, |next| reaches_end[next as usize]).is_some();
+        reaches_end[node as usize] = reaches;
     }
 
     // DFS to find ALL complete paths from start to any end node
-    fn dfs_find_all_paths(
-        current: &str,
-        end_nodes: &[String],
-        adj: &HashMap<String, Vec<String>>,
-        path: &mut Vec<String>,
-        visited: &mut HashSet<String>,
-        all_paths: &mut Vec<Vec<String>>,
-    ) {
-        path.push(current.to_string());
-        visited.insert(current.to_string());
-
-        // Check if we reached an end node
-        if end_nodes.contains(&current.to_string()) {
-            all_paths.push(path.clone());
+    let mut all_paths = Vec::new();
+    let mut on_path = vec![false; num_nodes];
+    let mut path = vec![critical.start];
+    let mut positions = vec![0usize];
+    on_path[critical.start as usize] = true;
+
+    while let Some(&current) = path.last() {
+        let next = if critical.is_end[current as usize] {
+            // Check if we reached an end node
+            all_paths.push(critical.path_value(&path));
+            None
         } else {
-            // Explore neighbors
-            if let Some(neighbors) = adj.get(current) {
-                for neighbor in neighbors {
-                    if !visited.contains(neighbor) {
-                        dfs_find_all_paths(neighbor, end_nodes, adj, path, visited, all_paths);
-                    }
-                }
+            let position = positions.last_mut().unwrap();
+            let next = critical.next_successor(current, *position, |next| {
+                !on_path[next as usize] && reaches_end[next as usize]
+            });
+            if let Some((resume, _)) = next {
+                *position = resume;
+            }
+            next
+        };
+
+        match next {
+            Some((_, next)) => {
+                on_path[next as usize] = true;
+                path.push(next);
+                positions.push(0);
+            }
+            None => {
+                // Backtrack
+                on_path[current as usize] = false;
+                path.pop();
+                positions.pop();
             }
         }
-
-        // Backtrack
-        path.pop();
-        visited.remove(current);
     }
 
-    let mut all_paths = Vec::new();
-    let mut path = Vec::new();
-    let mut visited = HashSet::new();
-
-    dfs_find_all_paths(&start, &end_nodes, &critical_adj, &mut path, &mut visited, &mut all_paths);
-
     if all_paths.is_empty() {
         return Err("Could not find any critical path from start to end".to_string());
     }
 
-    // Convert to Value::Vector of Value::Vector
-    let paths_values: Vec<Value> = all_paths.into_iter()
-        .map(|p| Value::Vector(p.into_iter().map(Value::String).collect()))
-        .collect();
-
-    Ok(Value::Vector(paths_values))
+    Ok(Value::Vector(all_paths))
 }
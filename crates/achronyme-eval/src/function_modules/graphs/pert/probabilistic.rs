@@ -4,10 +4,10 @@ use achronyme_types::value::Value;
 use achronyme_types::Environment;
 use std::collections::HashMap;
 use super::validation::{validate_dag, validate_probabilistic_properties};
-use super::cpm::calculate_slack;
-use super::critical_path::critical_path;
+use super::cpm::with_slack;
+use super::critical_path::network_critical_path;
 use super::statistics::{normal_cdf, inverse_normal_cdf};
-use super::project::project_duration;
+use super::project::network_duration;
 
 /// Calculate expected time using PERT formula: te = (op + 4*mo + pe) / 6
 pub fn expected_time(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
@@ -72,19 +72,28 @@ pub fn project_variance(args: &[Value], _env: &mut Environment) -> Result<Value,
         _ => return Err("project_variance() requires a network record".to_string()),
     };
 
+    Ok(Value::Number(network_variance(network)?))
+}
+
+/// `project_variance` on a borrowed network
+fn network_variance(network: &HashMap<String, Value>) -> Result<f64, String> {
     // Validate probabilistic properties
-    validate_dag(network, _env)?;
+    validate_dag(network)?;
     validate_probabilistic_properties(network)?;
 
     // Get critical path (auto-calculates all prerequisites if needed)
-    let critical_nodes = critical_path(&[Value::Record(network.clone())], _env)?;
+    let critical_nodes = network_critical_path(network)?;
 
     let nodes_record = match network.get("nodes") {
         Some(Value::Record(r)) => r,
         _ => return Err("Network must have 'nodes' field".to_string()),
     };
 
-    // Sum variances of critical path tasks
+    Ok(path_variance(nodes_record, &critical_nodes))
+}
+
+/// Sum of the task variances along a critical path
+fn path_variance(nodes_record: &HashMap<String, Value>, critical_nodes: &Value) -> f64 {
     let mut total_variance = 0.0;
 
     if let Value::Vector(critical) = critical_nodes {
@@ -94,7 +103,7 @@ pub fn project_variance(args: &[Value], _env: &mut Environment) -> Result<Value,
                 _ => continue,
             };
 
-            if let Some(Value::Record(props)) = nodes_record.get(&node_id) {
+            if let Some(Value::Record(props)) = nodes_record.get(node_id) {
                 let op = match props.get("op") {
                     Some(Value::Number(n)) => *n,
                     _ => continue,
@@ -115,7 +124,7 @@ pub fn project_variance(args: &[Value], _env: &mut Environment) -> Result<Value,
         }
     }
 
-    Ok(Value::Number(total_variance))
+    total_variance
 }
 
 /// Calculate project standard deviation
@@ -142,15 +151,8 @@ pub fn completion_probability(args: &[Value], _env: &mut Environment) -> Result<
     };
 
     // Calculate project duration (te) and standard deviation
-    let te = match project_duration(&[Value::Record(network.clone())], _env)? {
-        Value::Number(n) => n,
-        _ => return Err("Failed to calculate project duration".to_string()),
-    };
-
-    let std_dev = match project_std_dev(&[Value::Record(network.clone())], _env)? {
-        Value::Number(n) => n,
-        _ => return Err("Failed to calculate project standard deviation".to_string()),
-    };
+    let te = network_duration(network)?;
+    let std_dev = network_variance(network)?.sqrt();
 
     if std_dev == 0.0 {
         // Deterministic: probability is 0 if target < te, 1 if target >= te
@@ -183,15 +185,8 @@ pub fn time_for_probability(args: &[Value], _env: &mut Environment) -> Result<Va
     }
 
     // Calculate project duration (te) and standard deviation
-    let te = match project_duration(&[Value::Record(network.clone())], _env)? {
-        Value::Number(n) => n,
-        _ => return Err("Failed to calculate project duration".to_string()),
-    };
-
-    let std_dev = match project_std_dev(&[Value::Record(network.clone())], _env)? {
-        Value::Number(n) => n,
-        _ => return Err("Failed to calculate project standard deviation".to_string()),
-    };
+    let te = network_duration(network)?;
+    let std_dev = network_variance(network)?.sqrt();
 
     if std_dev == 0.0 {
         // Deterministic: return te
@@ -217,16 +212,13 @@ pub fn pert_analysis(args: &[Value], _env: &mut Environment) -> Result<Value, St
     };
 
     // Calculate network with all properties (auto-calculates prerequisites)
-    let network_with_slack = match calculate_slack(&[Value::Record(network.clone())], _env)? {
-        Value::Record(n) => n,
-        _ => return Err("Failed to calculate slack".to_string()),
-    };
+    let network_with_slack = with_slack(*network.clone())?;
 
     // Get critical path
-    let critical_path_nodes = critical_path(&[Value::Record(network_with_slack.clone())], _env)?;
+    let critical_path_nodes = network_critical_path(&network_with_slack)?;
 
     // Calculate project duration
-    let duration = project_duration(&[Value::Record(network_with_slack.clone())], _env)?;
+    let duration = network_duration(&network_with_slack)?;
 
     // Check if network has probabilistic properties (op, mo, pe)
     let has_probabilistic = if let Some(Value::Record(nodes)) = network.get("nodes") {
@@ -241,19 +233,29 @@ pub fn pert_analysis(args: &[Value], _env: &mut Environment) -> Result<Value, St
         false
     };
 
+    // Variance along the critical path found above
+    let variance = if has_probabilistic {
+        validate_probabilistic_properties(network)?;
+        match network_with_slack.get("nodes") {
+            Some(Value::Record(nodes)) => Some(path_variance(nodes, &critical_path_nodes)),
+            _ => None,
+        }
+    } else {
+        None
+    };
+
     // Build result record
     let mut result = HashMap::new();
-    result.insert("network".to_string(), Value::Record(network_with_slack.clone()));
     result.insert("critical_path".to_string(), critical_path_nodes);
-    result.insert("duration".to_string(), duration);
+    result.insert("duration".to_string(), Value::Number(duration));
 
     // Add probabilistic analysis if applicable
-    if has_probabilistic {
-        let variance = project_variance(&[Value::Record(network.clone())], _env)?;
-        let std_dev = project_std_dev(&[Value::Record(network.clone())], _env)?;
-        result.insert("variance".to_string(), variance);
-        result.insert("std_dev".to_string(), std_dev);
+    if let Some(variance) = variance {
+        result.insert("variance".to_string(), Value::Number(variance));
+        result.insert("std_dev".to_string(), Value::Number(variance.sqrt()));
     }
 
-    Ok(Value::Record(result))
+    result.insert("network".to_string(), Value::Record(Box::new(network_with_slack)));
+
+    Ok(Value::Record(Box::new(result)))
 }
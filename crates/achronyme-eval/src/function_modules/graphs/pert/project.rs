@@ -2,8 +2,10 @@
 
 use achronyme_types::value::Value;
 use achronyme_types::Environment;
+use std::collections::HashMap;
+use super::super::csr::graph_of;
 use super::validation::{validate_dag, validate_node_durations};
-use super::cpm::forward_pass;
+use super::cpm::early_times;
 
 /// Calculate total project duration (max EF across all nodes)
 pub fn project_duration(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
@@ -12,32 +14,19 @@ pub fn project_duration(args: &[Value], _env: &mut Environment) -> Result<Value,
         _ => return Err("project_duration() requires a network record".to_string()),
     };
 
+    Ok(Value::Number(network_duration(network)?))
+}
+
+/// Max EF of a borrowed network; runs the forward pass on the compact graph
+/// without building an annotated copy of the network
+pub(super) fn network_duration(network: &HashMap<String, Value>) -> Result<f64, String> {
     // Validate and calculate
-    validate_dag(network, _env)?;
+    validate_dag(network)?;
     validate_node_durations(network)?;
 
-    // Run forward pass to get EF values
-    let network_with_times = forward_pass(&[Value::Record(network.clone())], _env)?;
-
-    let nodes_record = match network_with_times {
-        Value::Record(ref map) => match map.get("nodes") {
-            Some(Value::Record(r)) => r,
-            _ => return Err("Invalid network structure".to_string()),
-        },
-        _ => return Err("Invalid network structure".to_string()),
-    };
+    let graph = graph_of(network)?;
+    let (_, ef) = early_times(network, &graph)?;
 
     // Find max EF
-    let max_ef = nodes_record.values()
-        .filter_map(|node_data| {
-            if let Value::Record(props) = node_data {
-                if let Some(Value::Number(ef)) = props.get("EF") {
-                    return Some(*ef);
-                }
-            }
-            None
-        })
-        .fold(0.0, f64::max);
-
-    Ok(Value::Number(max_ef))
+    Ok(ef.into_iter().fold(0.0, f64::max))
 }
@@ -1,17 +1,15 @@
 // PERT Validation Functions
 
 use achronyme_types::value::Value;
-use achronyme_types::Environment;
 use std::collections::HashMap;
-use super::super::cycles::has_cycle;
+use super::super::cycles::network_has_cycle;
 
 /// Validate that network is a DAG (required for PERT)
-pub(super) fn validate_dag(network: &HashMap<String, Value>, _env: &mut Environment) -> Result<(), String> {
-    match has_cycle(&[Value::Record(network.clone())], _env)? {
-        Value::Boolean(true) => {
-            Err("PERT requires a Directed Acyclic Graph (DAG), but the network contains cycles".to_string())
-        }
-        _ => Ok(()),
+pub(super) fn validate_dag(network: &HashMap<String, Value>) -> Result<(), String> {
+    if network_has_cycle(network)? {
+        Err("PERT requires a Directed Acyclic Graph (DAG), but the network contains cycles".to_string())
+    } else {
+        Ok(())
     }
 }
 
@@ -22,7 +20,7 @@ pub(super) fn validate_node_durations(network: &HashMap<String, Value>) -> Resul
         _ => return Err("Network must have 'nodes' field with a record".to_string()),
     };
 
-    for (node_id, node_data) in nodes_record {
+    for (node_id, node_data) in nodes_record.iter() {
         match node_data {
             Value::Record(props) => {
                 // Try to get duration using same priority logic as get_node_duration
@@ -58,7 +56,7 @@ pub(super) fn validate_probabilistic_properties(network: &HashMap<String, Value>
         _ => return Err("Network must have 'nodes' field with a record".to_string()),
     };
 
-    for (node_id, node_data) in nodes_record {
+    for (node_id, node_data) in nodes_record.iter() {
         match node_data {
             Value::Record(props) => {
                 // Check for op, mo, pe
@@ -1,13 +1,14 @@
-use crate::function_modules::graphs::helpers::{validate_edge_weights, validate_node_exists};
+use crate::function_modules::graphs::csr::{graph_of, NodeIndex};
+use crate::function_modules::graphs::helpers::{validate_edge_weights, validate_node_index};
 use achronyme_types::value::Value;
 use achronyme_types::Environment;
 use std::cmp::Ordering;
 use std::collections::{BinaryHeap, HashMap};
 
 /// State for Dijkstra's priority queue
-#[derive(Clone)]
+#[derive(Clone, Copy)]
 struct DijkstraState {
-    node: String,
+    node: NodeIndex,
     distance: f64,
 }
 
@@ -37,6 +38,9 @@ impl PartialOrd for DijkstraState {
 }
 
 /// Dijkstra - Find shortest path in weighted graph
+///
+/// Runs on the network's CSR adjacency with a binary heap and dense
+/// distance/parent arrays (lazy deletion: stale heap entries are skipped).
 pub fn dijkstra(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
     let network = match &args[0] {
         Value::Record(map) => map,
@@ -54,105 +58,76 @@ pub fn dijkstra(args: &[Value], _env: &mut Environment) -> Result<Value, String>
     };
 
     // Validate nodes exist
-    validate_node_exists(network, start_node)?;
-    validate_node_exists(network, end_node)?;
-
-    // Get edges and validate weights
-    let edges_vec = match network.get("edges") {
-        Some(Value::Vector(v)) => v,
-        _ => return Err("Network must have an 'edges' field with a vector".to_string()),
-    };
-
-    validate_edge_weights(edges_vec)?;
-
-    // Build weighted adjacency list
-    let mut adj_list: HashMap<String, Vec<(String, f64)>> = HashMap::new();
-
-    for edge in edges_vec {
-        match edge {
-            Value::Edge { from, to, directed, properties } => {
-                let weight = match properties.get("weight") {
-                    Some(Value::Number(w)) => *w,
-                    _ => unreachable!(), // Already validated
-                };
-
-                adj_list
-                    .entry(from.clone())
-                    .or_insert_with(Vec::new)
-                    .push((to.clone(), weight));
-
-                if !directed {
-                    adj_list
-                        .entry(to.clone())
-                        .or_insert_with(Vec::new)
-                        .push((from.clone(), weight));
-                }
-            }
-            _ => return Err("Invalid edge in edges vector".to_string()),
+    let graph = graph_of(network)?;
+    let start_node = validate_node_index(network, &graph, start_node)?;
+    let end_node = validate_node_index(network, &graph, end_node)?;
+
+    // Validate weights; the edge scan only runs to report the offending edge
+    if !graph.has_positive_weights() {
+        if let Some(Value::Vector(edges_vec)) = network.get("edges") {
+            validate_edge_weights(edges_vec)?;
         }
     }
 
+    let adjacency = graph.out();
+
     // Dijkstra's algorithm
-    let mut distances: HashMap<String, f64> = HashMap::new();
-    let mut parent: HashMap<String, String> = HashMap::new();
+    let mut distances = vec![f64::INFINITY; graph.num_nodes()];
+    let mut parent: Vec<Option<NodeIndex>> = vec![None; graph.num_nodes()];
     let mut heap = BinaryHeap::new();
 
-    distances.insert(start_node.clone(), 0.0);
+    distances[start_node as usize] = 0.0;
     heap.push(DijkstraState {
-        node: start_node.clone(),
+        node: start_node,
         distance: 0.0,
     });
 
     while let Some(DijkstraState { node, distance }) = heap.pop() {
         // Skip if we've found a better path
-        if let Some(&d) = distances.get(&node) {
-            if distance > d {
-                continue;
-            }
+        if distance > distances[node as usize] {
+            continue;
         }
 
         // If we reached the end node, we're done
-        if &node == end_node {
+        if node == end_node {
             break;
         }
 
         // Explore neighbors
-        if let Some(neighbors) = adj_list.get(&node) {
-            for (neighbor, edge_weight) in neighbors {
-                let new_distance = distance + edge_weight;
-
-                let is_better = distances.get(neighbor).map_or(true, |&d| new_distance < d);
-
-                if is_better {
-                    distances.insert(neighbor.clone(), new_distance);
-                    parent.insert(neighbor.clone(), node.clone());
-                    heap.push(DijkstraState {
-                        node: neighbor.clone(),
-                        distance: new_distance,
-                    });
-                }
+        let neighbors = adjacency.neighbors(node);
+        let edges = adjacency.edges(node);
+        for (&neighbor, &edge) in neighbors.iter().zip(edges) {
+            let new_distance = distance + graph.weights[edge as usize];
+
+            if new_distance < distances[neighbor as usize] {
+                distances[neighbor as usize] = new_distance;
+                parent[neighbor as usize] = Some(node);
+                heap.push(DijkstraState {
+                    node: neighbor,
+                    distance: new_distance,
+                });
             }
         }
     }
 
     // Check if path was found
-    let found = distances.contains_key(end_node);
-    let total_distance = distances.get(end_node).copied().unwrap_or(f64::INFINITY);
+    let total_distance = distances[end_node as usize];
+    let found = total_distance.is_finite();
 
     // Reconstruct path
     let path = if found {
         let mut path_nodes = Vec::new();
-        let mut current = end_node.clone();
+        let mut current = end_node;
 
-        path_nodes.push(current.clone());
+        path_nodes.push(current);
 
-        while let Some(prev) = parent.get(&current) {
-            path_nodes.push(prev.clone());
-            current = prev.clone();
+        while let Some(prev) = parent[current as usize] {
+            path_nodes.push(prev);
+            current = prev;
         }
 
         path_nodes.reverse();
-        path_nodes.into_iter().map(Value::String).collect()
+        path_nodes.into_iter().map(|node| graph.name_value(node)).collect()
     } else {
         Vec::new()
     };
@@ -163,5 +138,5 @@ pub fn dijkstra(args: &[Value], _env: &mut Environment) -> Result<Value, String>
     result.insert("distance".to_string(), Value::Number(total_distance));
     result.insert("found".to_string(), Value::Boolean(found));
 
-    Ok(Value::Record(result))
+    Ok(Value::Record(Box::new(result)))
 }
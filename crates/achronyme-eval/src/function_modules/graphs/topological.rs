@@ -1,8 +1,8 @@
-use crate::function_modules::graphs::cycles::has_cycle;
-use crate::function_modules::graphs::helpers::{build_adjacency_list, extract_node_ids};
+use crate::function_modules::graphs::csr::{graph_of, Graph, NodeIndex};
+use crate::function_modules::graphs::cycles::network_has_cycle;
 use achronyme_types::value::Value;
 use achronyme_types::Environment;
-use std::collections::{HashMap, VecDeque};
+use std::collections::VecDeque;
 
 /// Topological Sort - Order nodes in a DAG such that for every edge u -> v, u comes before v
 pub fn topological_sort(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
@@ -12,66 +12,56 @@ pub fn topological_sort(args: &[Value], _env: &mut Environment) -> Result<Value,
     };
 
     // Check if graph has cycles (must be DAG)
-    match has_cycle(&[args[0].clone()], _env)? {
-        Value::Boolean(true) => {
-            return Err(
-                "topological_sort() requires a Directed Acyclic Graph (DAG), but the graph contains cycles"
-                    .to_string(),
-            );
-        }
-        _ => {}
+    if network_has_cycle(network)? {
+        return Err(
+            "topological_sort() requires a Directed Acyclic Graph (DAG), but the graph contains cycles"
+                .to_string(),
+        );
     }
 
-    // Get all nodes
-    let node_ids = extract_node_ids(network)?;
+    let graph = graph_of(network)?;
+    let result = topological_order(&graph)
+        .into_iter()
+        .map(|node| graph.name_value(node))
+        .collect();
 
-    // Get edges and build adjacency list
-    let edges_vec = match network.get("edges") {
-        Some(Value::Vector(v)) => v,
-        _ => return Err("Network must have an 'edges' field with a vector".to_string()),
-    };
+    Ok(Value::Vector(result))
+}
 
-    let adj_list = build_adjacency_list(edges_vec)?;
+/// Kahn's algorithm (BFS-based topological sort) on dense node indices
+///
+/// The graph must already be known to be acyclic; nodes on a cycle would
+/// simply be missing from the result.
+pub(crate) fn topological_order(graph: &Graph) -> Vec<NodeIndex> {
+    let adjacency = graph.out();
 
-    // Kahn's algorithm (BFS-based topological sort)
     // Calculate in-degree for each node
-    let mut in_degree: HashMap<String, usize> = HashMap::new();
-    for node in &node_ids {
-        in_degree.insert(node.clone(), 0);
-    }
-
-    for neighbors in adj_list.values() {
-        for neighbor in neighbors {
-            *in_degree.entry(neighbor.clone()).or_insert(0) += 1;
+    let mut in_degree = vec![0usize; graph.num_nodes()];
+    for node in 0..graph.num_nodes() as NodeIndex {
+        for &neighbor in adjacency.neighbors(node) {
+            in_degree[neighbor as usize] += 1;
         }
     }
 
     // Queue of nodes with in-degree 0
-    let mut queue: VecDeque<String> = VecDeque::new();
-    for (node, &degree) in &in_degree {
-        if degree == 0 {
-            queue.push_back(node.clone());
-        }
-    }
+    let mut queue: VecDeque<NodeIndex> = (0..graph.num_nodes() as NodeIndex)
+        .filter(|&node| in_degree[node as usize] == 0)
+        .collect();
 
     // Process nodes in topological order
-    let mut result = Vec::new();
+    let mut order = Vec::with_capacity(graph.num_nodes());
 
     while let Some(node) = queue.pop_front() {
-        result.push(Value::String(node.clone()));
+        order.push(node);
 
         // Reduce in-degree of neighbors
-        if let Some(neighbors) = adj_list.get(&node) {
-            for neighbor in neighbors {
-                if let Some(degree) = in_degree.get_mut(neighbor) {
-                    *degree -= 1;
-                    if *degree == 0 {
-                        queue.push_back(neighbor.clone());
-                    }
-                }
+        for &neighbor in adjacency.neighbors(node) {
+            in_degree[neighbor as usize] -= 1;
+            if in_degree[neighbor as usize] == 0 {
+                queue.push_back(neighbor);
             }
         }
     }
 
-    Ok(Value::Vector(result))
+    order
 }
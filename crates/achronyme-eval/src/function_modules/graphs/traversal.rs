@@ -1,7 +1,8 @@
-use crate::function_modules::graphs::helpers::{build_adjacency_list, validate_node_exists};
+use crate::function_modules::graphs::csr::{graph_of, NodeIndex};
+use crate::function_modules::graphs::helpers::validate_node_index;
 use achronyme_types::value::Value;
 use achronyme_types::Environment;
-use std::collections::{HashMap, HashSet, VecDeque};
+use std::collections::{HashMap, VecDeque};
 
 /// BFS (Breadth-First Search) - Returns nodes in BFS order
 pub fn bfs(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
@@ -16,34 +17,26 @@ pub fn bfs(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
     };
 
     // Validate start node exists
-    validate_node_exists(network, start_node)?;
-
-    // Get edges and build adjacency list
-    let edges_vec = match network.get("edges") {
-        Some(Value::Vector(v)) => v,
-        _ => return Err("Network must have an 'edges' field with a vector".to_string()),
-    };
-
-    let adj_list = build_adjacency_list(edges_vec)?;
+    let graph = graph_of(network)?;
+    let start_node = validate_node_index(network, &graph, start_node)?;
+    let adjacency = graph.out();
 
     // BFS implementation
-    let mut visited = HashSet::new();
+    let mut visited = vec![false; graph.num_nodes()];
     let mut queue = VecDeque::new();
     let mut result = Vec::new();
 
-    queue.push_back(start_node.clone());
-    visited.insert(start_node.clone());
+    queue.push_back(start_node);
+    visited[start_node as usize] = true;
 
     while let Some(current) = queue.pop_front() {
-        result.push(Value::String(current.clone()));
+        result.push(graph.name_value(current));
 
         // Visit neighbors
-        if let Some(neighbors) = adj_list.get(&current) {
-            for neighbor in neighbors {
-                if !visited.contains(neighbor) {
-                    visited.insert(neighbor.clone());
-                    queue.push_back(neighbor.clone());
-                }
+        for &neighbor in adjacency.neighbors(current) {
+            if !visited[neighbor as usize] {
+                visited[neighbor as usize] = true;
+                queue.push_back(neighbor);
             }
         }
     }
@@ -64,37 +57,29 @@ pub fn dfs(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
     };
 
     // Validate start node exists
-    validate_node_exists(network, start_node)?;
-
-    // Get edges and build adjacency list
-    let edges_vec = match network.get("edges") {
-        Some(Value::Vector(v)) => v,
-        _ => return Err("Network must have an 'edges' field with a vector".to_string()),
-    };
-
-    let adj_list = build_adjacency_list(edges_vec)?;
+    let graph = graph_of(network)?;
+    let start_node = validate_node_index(network, &graph, start_node)?;
+    let adjacency = graph.out();
 
     // DFS implementation using stack
-    let mut visited = HashSet::new();
+    let mut visited = vec![false; graph.num_nodes()];
     let mut stack = Vec::new();
     let mut result = Vec::new();
 
-    stack.push(start_node.clone());
+    stack.push(start_node);
 
     while let Some(current) = stack.pop() {
-        if visited.contains(&current) {
+        if visited[current as usize] {
             continue;
         }
 
-        visited.insert(current.clone());
-        result.push(Value::String(current.clone()));
+        visited[current as usize] = true;
+        result.push(graph.name_value(current));
 
         // Visit neighbors (in reverse order to maintain left-to-right traversal)
-        if let Some(neighbors) = adj_list.get(&current) {
-            for neighbor in neighbors.iter().rev() {
-                if !visited.contains(neighbor) {
-                    stack.push(neighbor.clone());
-                }
+        for &neighbor in adjacency.neighbors(current).iter().rev() {
+            if !visited[neighbor as usize] {
+                stack.push(neighbor);
             }
         }
     }
@@ -120,40 +105,32 @@ pub fn bfs_path(args: &[Value], _env: &mut Environment) -> Result<Value, String>
     };
 
     // Validate nodes exist
-    validate_node_exists(network, start_node)?;
-    validate_node_exists(network, end_node)?;
-
-    // Get edges and build adjacency list
-    let edges_vec = match network.get("edges") {
-        Some(Value::Vector(v)) => v,
-        _ => return Err("Network must have an 'edges' field with a vector".to_string()),
-    };
-
-    let adj_list = build_adjacency_list(edges_vec)?;
+    let graph = graph_of(network)?;
+    let start_node = validate_node_index(network, &graph, start_node)?;
+    let end_node = validate_node_index(network, &graph, end_node)?;
+    let adjacency = graph.out();
 
     // BFS with parent tracking for path reconstruction
-    let mut visited = HashSet::new();
+    let mut visited = vec![false; graph.num_nodes()];
     let mut queue = VecDeque::new();
-    let mut parent: HashMap<String, String> = HashMap::new();
+    let mut parent: Vec<Option<NodeIndex>> = vec![None; graph.num_nodes()];
 
-    queue.push_back(start_node.clone());
-    visited.insert(start_node.clone());
+    queue.push_back(start_node);
+    visited[start_node as usize] = true;
 
     let mut found = false;
 
     while let Some(current) = queue.pop_front() {
-        if &current == end_node {
+        if current == end_node {
             found = true;
             break;
         }
 
-        if let Some(neighbors) = adj_list.get(&current) {
-            for neighbor in neighbors {
-                if !visited.contains(neighbor) {
-                    visited.insert(neighbor.clone());
-                    parent.insert(neighbor.clone(), current.clone());
-                    queue.push_back(neighbor.clone());
-                }
+        for &neighbor in adjacency.neighbors(current) {
+            if !visited[neighbor as usize] {
+                visited[neighbor as usize] = true;
+                parent[neighbor as usize] = Some(current);
+                queue.push_back(neighbor);
             }
         }
     }
@@ -161,17 +138,17 @@ pub fn bfs_path(args: &[Value], _env: &mut Environment) -> Result<Value, String>
     // Reconstruct path if found
     let path = if found {
         let mut path_nodes = Vec::new();
-        let mut current = end_node.clone();
+        let mut current = end_node;
 
-        path_nodes.push(current.clone());
+        path_nodes.push(current);
 
-        while let Some(prev) = parent.get(&current) {
-            path_nodes.push(prev.clone());
-            current = prev.clone();
+        while let Some(prev) = parent[current as usize] {
+            path_nodes.push(prev);
+            current = prev;
         }
 
         path_nodes.reverse();
-        path_nodes.into_iter().map(Value::String).collect()
+        path_nodes.into_iter().map(|node| graph.name_value(node)).collect()
     } else {
         Vec::new()
     };
@@ -181,5 +158,5 @@ pub fn bfs_path(args: &[Value], _env: &mut Environment) -> Result<Value, String>
     result.insert("path".to_string(), Value::Vector(path));
     result.insert("found".to_string(), Value::Boolean(found));
 
-    Ok(Value::Record(result))
+    Ok(Value::Record(Box::new(result)))
 }
@@ -3,6 +3,7 @@
 /// This module provides functions for:
 /// - Environment persistence: save_env() and restore_env() for saving/loading REPL sessions
 /// - File inspection: env_info() for viewing metadata without loading
+/// - Incremental checkpoints: save_env({checkpoint: true}) and compact_env()
 ///
 /// File Format: .ach (Achronyme Archive)
 /// - Custom 64-byte header with magic bytes and version info
@@ -14,6 +15,7 @@ use crate::functions::FunctionRegistry;
 use achronyme_types::value::Value;
 use achronyme_types::Environment;
 use achronyme_env::{save_environment, restore_environment, get_metadata};
+use achronyme_env::{checkpoint_environment, compact_archive};
 use achronyme_env::{SaveOptions, RestoreOptions, RestoreMode};
 use std::collections::HashMap;
 
@@ -22,6 +24,22 @@ pub fn register_functions(registry: &mut FunctionRegistry) {
     registry.register("save_env", save_env, 1); // save_env(path) or save_env(record_with_options)
     registry.register("restore_env", restore_env, 1); // restore_env(path) or restore_env(record_with_options)
     registry.register("env_info", env_info, 1); // env_info(path) - get metadata without loading
+    registry.register("compact_env", compact_env, 1); // compact_env(path) - fold checkpoint deltas
+}
+
+/// Builtins that read or write files
+pub const FILE_BUILTINS: &[&str] = &["save_env", "restore_env", "env_info", "compact_env"];
+
+/// Replace the file builtins with ones that fail, for hosts whose users
+/// must not touch the host's disk (`achronyme serve`)
+pub fn disable_functions(registry: &mut FunctionRegistry) {
+    for name in FILE_BUILTINS {
+        registry.register(name, disabled, 1);
+    }
+}
+
+fn disabled(_args: &[Value], _env: &mut Environment) -> Result<Value, String> {
+    Err("File I/O builtins (save_env, restore_env, env_info, compact_env) are disabled here".to_string())
 }
 
 // ============================================================================
@@ -36,16 +54,20 @@ pub fn register_functions(registry: &mut FunctionRegistry) {
 ///   save_env({path: "session.ach", description: "My analysis", tags: ["experiment", "2024"]})
 ///   save_env({path: "session.ach", include_only: ["x", "y", "result"]})
 ///   save_env({path: "session.ach", exclude: ["temp_*", "debug_var"]})
+///   save_env({path: "session.ach", checkpoint: true})
 ///
 /// Options (when passing a record):
 ///   - path: String - File path (required)
 ///   - compress: Boolean - Enable compression (default: true)
 ///   - compression_level: Number - Zstd level 1-22 (default: 3)
+///   - compression_threads: Number - Zstd worker threads for large tensors, 0-64 (default: 0 = inline)
 ///   - description: String - Description of the file
 ///   - tags: Vector of strings - Tags for categorization
 ///   - include_only: Vector of strings - Only save these variables
 ///   - exclude: Vector of strings - Exclude these variables (supports "prefix_*" patterns)
 ///   - allow_overwrite: Boolean - Allow overwriting existing file (default: false)
+///   - checkpoint: Boolean - Append only new or changed bindings to an existing
+///     file instead of rewriting it; implies allow_overwrite (default: false)
 ///
 /// Returns: Boolean (true on success)
 fn save_env(args: &[Value], env: &mut Environment) -> Result<Value, String> {
@@ -54,10 +76,10 @@ fn save_env(args: &[Value], env: &mut Environment) -> Result<Value, String> {
     }
 
     // Parse arguments - can be either a string path or a record with options
-    let (path, options) = match &args[0] {
+    let (path, options, checkpoint) = match &args[0] {
         Value::String(p) => {
             // Simple case: just a path
-            (p.clone(), SaveOptions::default())
+            (p.clone(), SaveOptions::default(), false)
         }
         Value::Record(map) => {
             // Extract path from record
@@ -84,6 +106,14 @@ fn save_env(args: &[Value], env: &mut Environment) -> Result<Value, String> {
                 opts.compression_level = *n as i32;
             }
 
+            // compression_threads: Number
+            if let Some(Value::Number(n)) = map.get("compression_threads") {
+                if *n < 0.0 || *n > 64.0 || n.fract() != 0.0 {
+                    return Err("compression_threads must be an integer between 0 and 64".to_string());
+                }
+                opts.compression_threads = *n as u32;
+            }
+
             // description: String
             if let Some(Value::String(desc)) = map.get("description") {
                 opts.description = Some(desc.clone());
@@ -127,14 +157,22 @@ fn save_env(args: &[Value], env: &mut Environment) -> Result<Value, String> {
                 opts.allow_overwrite = *b;
             }
 
-            (path, opts)
+            // checkpoint: Boolean
+            let checkpoint = matches!(map.get("checkpoint"), Some(Value::Boolean(true)));
+
+            (path, opts, checkpoint)
         }
         _ => return Err("save_env() argument must be a String path or Record with options".to_string()),
     };
 
     // Save the current environment
-    save_environment(env, &path, options)
-        .map_err(|e| format!("Failed to save environment: {}", e))?;
+    if checkpoint {
+        checkpoint_environment(env, &path, options)
+            .map_err(|e| format!("Failed to checkpoint environment: {}", e))?;
+    } else {
+        save_environment(env, &path, options)
+            .map_err(|e| format!("Failed to save environment: {}", e))?;
+    }
 
     Ok(Value::Boolean(true))
 }
@@ -282,7 +320,7 @@ fn restore_env(args: &[Value], env: &mut Environment) -> Result<Value, String> {
                 namespace_record.insert(name, value);
             }
 
-            if let Err(e) = env.define(namespace_name.clone(), Value::Record(namespace_record)) {
+            if let Err(e) = env.define(namespace_name.clone(), Value::Record(Box::new(namespace_record))) {
                 return Err(format!("Failed to create namespace '{}': {}", namespace_name, e));
             }
         }
@@ -351,7 +389,29 @@ fn env_info(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
         record.insert(key, Value::String(value));
     }
 
-    Ok(Value::Record(record))
+    Ok(Value::Record(Box::new(record)))
+}
+
+/// Rewrite a checkpointed .ach file without its superseded delta segments
+///
+/// Usage:
+///   compact_env("session.ach")
+///
+/// Returns: Record with the file size before and after, in bytes
+fn compact_env(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
+    let path = match args.first() {
+        Some(Value::String(p)) => p,
+        Some(_) => return Err("compact_env() argument must be a String path".to_string()),
+        None => return Err("compact_env() requires 1 argument (path)".to_string()),
+    };
+
+    let (before, after) = compact_archive(path)
+        .map_err(|e| format!("Failed to compact environment file: {}", e))?;
+
+    let mut record = HashMap::new();
+    record.insert("bytes_before".to_string(), Value::Number(before as f64));
+    record.insert("bytes_after".to_string(), Value::Number(after as f64));
+    Ok(Value::Record(Box::new(record)))
 }
 
 #[cfg(test)]
@@ -416,7 +476,7 @@ mod tests {
         let mut map = HashMap::new();
         map.insert("compress".to_string(), Value::Boolean(true));
 
-        let result = save_env(&[Value::Record(map)], &mut env);
+        let result = save_env(&[Value::Record(Box::new(map))], &mut env);
         assert!(result.is_err());
         assert!(result.unwrap_err().contains("must contain 'path'"));
     }
@@ -428,11 +488,31 @@ mod tests {
         map.insert("path".to_string(), Value::String("test.ach".to_string()));
         map.insert("compression_level".to_string(), Value::Number(99.0));
 
-        let result = save_env(&[Value::Record(map)], &mut env);
+        let result = save_env(&[Value::Record(Box::new(map))], &mut env);
         assert!(result.is_err());
         assert!(result.unwrap_err().contains("between 1 and 22"));
     }
 
+    #[test]
+    fn test_save_env_compression_threads_validation() {
+        let mut env = Environment::new();
+        let mut map = HashMap::new();
+        map.insert("path".to_string(), Value::String("test.ach".to_string()));
+        map.insert("compression_threads".to_string(), Value::Number(1.5));
+
+        let result = save_env(&[Value::Record(Box::new(map))], &mut env);
+        assert!(result.is_err());
+        assert!(result.unwrap_err().contains("between 0 and 64"));
+    }
+
+    #[test]
+    fn test_compact_env_path_must_be_string() {
+        let mut env = Environment::new();
+        let result = compact_env(&[Value::Number(1.0)], &mut env);
+        assert!(result.is_err());
+        assert!(result.unwrap_err().contains("must be a String"));
+    }
+
     #[test]
     fn test_restore_env_requires_argument() {
         let mut env = Environment::new();
@@ -448,7 +528,7 @@ mod tests {
         map.insert("path".to_string(), Value::String("test.ach".to_string()));
         map.insert("mode".to_string(), Value::String("invalid_mode".to_string()));
 
-        let result = restore_env(&[Value::Record(map)], &mut env);
+        let result = restore_env(&[Value::Record(Box::new(map))], &mut env);
         assert!(result.is_err());
         assert!(result.unwrap_err().contains("Invalid mode"));
     }
@@ -460,7 +540,7 @@ mod tests {
         map.insert("path".to_string(), Value::String("test.ach".to_string()));
         map.insert("mode".to_string(), Value::String("namespace".to_string()));
 
-        let result = restore_env(&[Value::Record(map)], &mut env);
+        let result = restore_env(&[Value::Record(Box::new(map))], &mut env);
         assert!(result.is_err());
         assert!(result.unwrap_err().contains("requires 'namespace'"));
     }
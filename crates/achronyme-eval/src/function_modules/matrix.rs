@@ -6,6 +6,7 @@ pub fn register_functions(registry: &mut FunctionRegistry) {
     registry.register("transpose", transpose, 1);
     registry.register("det", det, 1);
     registry.register("trace", trace, 1);
+    registry.register("matmul", matmul, 2);
 }
 
 // Implementations
@@ -18,24 +19,64 @@ fn transpose(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
                 return Err("transpose() requires a rank-2 tensor (matrix)".to_string());
             }
             let result = t.transpose().map_err(|e| e.to_string())?;
-            Ok(Value::Tensor(result))
+            Ok(Value::Tensor(Box::new(result)))
         }
         Value::ComplexTensor(t) => {
             if !t.is_matrix() {
                 return Err("transpose() requires a rank-2 tensor (matrix)".to_string());
             }
             let result = t.transpose().map_err(|e| e.to_string())?;
-            Ok(Value::ComplexTensor(result))
+            Ok(Value::ComplexTensor(Box::new(result)))
         }
         _ => Err("transpose() requires a tensor".to_string()),
     }
 }
 
+/// Matrix product; unlike `*`, also for complex matrices
+fn matmul(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
+    const NOT_MATRICES: &str = "matmul() requires two rank-2 tensors (matrices)";
+
+    match (&args[0], &args[1]) {
+        (Value::Tensor(a), Value::Tensor(b)) => {
+            if !a.is_matrix() || !b.is_matrix() {
+                return Err(NOT_MATRICES.to_string());
+            }
+            achronyme_linalg::matmul(a, b).map(Value::from)
+        }
+        (Value::ComplexTensor(a), Value::ComplexTensor(b)) => {
+            if !a.is_matrix() || !b.is_matrix() {
+                return Err(NOT_MATRICES.to_string());
+            }
+            achronyme_linalg::matmul_complex(a, b).map(Value::from)
+        }
+        // Type promotion: real matrix → complex
+        (Value::Tensor(a), Value::ComplexTensor(b)) => {
+            if !a.is_matrix() || !b.is_matrix() {
+                return Err(NOT_MATRICES.to_string());
+            }
+            achronyme_linalg::matmul_complex(&a.to_complex(), b).map(Value::from)
+        }
+        (Value::ComplexTensor(a), Value::Tensor(b)) => {
+            if !a.is_matrix() || !b.is_matrix() {
+                return Err(NOT_MATRICES.to_string());
+            }
+            achronyme_linalg::matmul_complex(a, &b.to_complex()).map(Value::from)
+        }
+        _ => Err(NOT_MATRICES.to_string()),
+    }
+}
+
 fn det(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
     match &args[0] {
+        // A [batch, n, n] stack gives the vector of its determinants
+        Value::Tensor(t) if t.rank() == 3 => {
+            achronyme_linalg::determinant_batch(t)
+                .map(Value::from)
+                .map_err(|e| format!("Determinant failed: {}", e))
+        }
         Value::Tensor(t) => {
             if !t.is_matrix() {
-                return Err("det() requires a rank-2 tensor (matrix)".to_string());
+                return Err("det() requires a rank-2 tensor (matrix) or a rank-3 stack of matrices".to_string());
             }
             let determinant = t.determinant()
                 .map_err(|e| format!("Determinant failed: {}", e))?;
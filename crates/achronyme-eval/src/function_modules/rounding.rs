@@ -43,14 +43,11 @@ fn abs(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
             let data: Vec<f64> = t.data().iter().map(|&x| x.abs()).collect();
             let result = achronyme_types::tensor::RealTensor::new(data, t.shape().to_vec())
                 .map_err(|e| format!("abs(): {}", e))?;
-            Ok(Value::Tensor(result))
+            Ok(Value::Tensor(Box::new(result)))
         }
         Value::ComplexTensor(t) => {
             // For complex tensor, abs returns real tensor of magnitudes
-            let data: Vec<f64> = t.data().iter().map(|c| c.norm()).collect();
-            let result = achronyme_types::tensor::RealTensor::new(data, t.shape().to_vec())
-                .map_err(|e| format!("abs(): {}", e))?;
-            Ok(Value::Tensor(result))
+            Ok(Value::Tensor(Box::new(t.abs())))
         }
 
         // Legacy Vector support (backward compatibility)
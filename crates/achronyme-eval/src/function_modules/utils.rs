@@ -93,8 +93,9 @@ fn get_type_name(value: &Value) -> String {
         }
         Value::Null => "null".to_string(),
         Value::Generator(_) => "Generator".to_string(),
+        Value::Sequence(_) => "Sequence".to_string(),
         Value::GeneratorYield(_) => "GeneratorYield".to_string(),
-        Value::Error { .. } => "Error".to_string(),
+        Value::Error(_) => "Error".to_string(),
     }
 }
 
@@ -212,11 +213,12 @@ fn format_value(value: &Value) -> String {
         }
         Value::Null => "null".to_string(),
         Value::Generator(_) => "<generator>".to_string(),
+        Value::Sequence(_) => "<sequence>".to_string(),
         Value::GeneratorYield(_) => "<generator-yield>".to_string(),
-        Value::Error { message, kind, .. } => {
-            match kind {
-                Some(k) => format!("Error({}: {})", k, message),
-                None => format!("Error({})", message),
+        Value::Error(error) => {
+            match &error.kind {
+                Some(k) => format!("Error({}: {})", k, error.message),
+                None => format!("Error({})", error.message),
             }
         }
     }
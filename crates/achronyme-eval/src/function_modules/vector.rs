@@ -57,7 +57,7 @@ fn cross(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
         // Tensor support (optimized path)
         (Value::Tensor(t1), Value::Tensor(t2)) => {
             let result = t1.cross(t2).map_err(|e| e.to_string())?;
-            Ok(Value::Tensor(result))
+            Ok(Value::Tensor(Box::new(result)))
         }
         // Legacy Vector support (backward compatibility)
         (Value::Vector(vec1), Value::Vector(vec2)) => {
@@ -113,14 +113,14 @@ fn normalize(args: &[Value], _env: &mut Environment) -> Result<Value, String> {
                 return Err("normalize() requires a rank-1 tensor (vector)".to_string());
             }
             let result = t.normalize().map_err(|e| e.to_string())?;
-            Ok(Value::Tensor(result))
+            Ok(Value::Tensor(Box::new(result)))
         }
         Value::ComplexTensor(t) => {
             if !t.is_vector() {
                 return Err("normalize() requires a rank-1 tensor (vector)".to_string());
             }
             let result = t.normalize().map_err(|e| e.to_string())?;
-            Ok(Value::ComplexTensor(result))
+            Ok(Value::ComplexTensor(Box::new(result)))
         }
         // Legacy Vector support (backward compatibility)
         Value::Vector(vec) => {
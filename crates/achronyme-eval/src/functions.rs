@@ -1,6 +1,7 @@
 use achronyme_types::value::Value;
-use achronyme_types::Environment;
+use achronyme_types::{Environment, Symbol};
 use std::collections::HashMap;
+use std::sync::{Arc, OnceLock};
 
 use crate::function_modules;
 
@@ -10,9 +11,13 @@ use crate::function_modules;
 pub type BuiltinFunction = fn(&[Value], &mut Environment) -> Result<Value, String>;
 
 /// Registry for built-in mathematical functions
+///
+/// Entries are plain function pointers, so the registry is `Send + Sync`;
+/// [`FunctionRegistry::shared`] builds it once per process and every
+/// evaluator holds the same `Arc`.
 #[derive(Clone)]
 pub struct FunctionRegistry {
-    functions: HashMap<String, (BuiltinFunction, i32)>, // (function, arity) -1 = variadic
+    functions: HashMap<Symbol, (BuiltinFunction, i32)>, // (function, arity) -1 = variadic
 }
 
 impl FunctionRegistry {
@@ -25,6 +30,12 @@ impl FunctionRegistry {
         registry
     }
 
+    /// The process-wide registry of standard functions, built on first use
+    pub fn shared() -> Arc<FunctionRegistry> {
+        static SHARED: OnceLock<Arc<FunctionRegistry>> = OnceLock::new();
+        Arc::clone(SHARED.get_or_init(|| Arc::new(FunctionRegistry::new())))
+    }
+
     /// Register all standard math functions by delegating to modules
     fn register_all_modules(&mut self) {
         function_modules::array::register_functions(self);
@@ -45,32 +56,41 @@ impl FunctionRegistry {
 
     /// Register a function
     pub fn register(&mut self, name: &str, func: BuiltinFunction, arity: i32) {
-        self.functions.insert(name.to_string(), (func, arity));
+        self.functions.insert(Symbol::intern(name), (func, arity));
     }
 
     /// Check if a function is defined
     pub fn has(&self, name: &str) -> bool {
-        self.functions.contains_key(name)
+        Symbol::lookup(name).map_or(false, |symbol| self.has_symbol(symbol))
+    }
+
+    /// Check if a function is defined, by interned name
+    pub fn has_symbol(&self, name: Symbol) -> bool {
+        self.functions.contains_key(&name)
     }
 
     /// Get function arity (-1 for variadic)
     pub fn arity(&self, name: &str) -> Option<i32> {
-        self.functions.get(name).map(|(_, arity)| *arity)
+        self.get(name).map(|(_, arity)| arity)
     }
 
     /// Get function pointer and arity
     pub fn get(&self, name: &str) -> Option<(BuiltinFunction, i32)> {
-        self.functions.get(name).copied()
+        Symbol::lookup(name).and_then(|symbol| self.get_symbol(symbol))
+    }
+
+    /// Get function pointer and arity, by interned name
+    pub fn get_symbol(&self, name: Symbol) -> Option<(BuiltinFunction, i32)> {
+        self.functions.get(&name).copied()
     }
 
     /// Call a function with access to the environment
     pub fn call(&self, name: &str, args: &[Value], env: &mut Environment) -> Result<Value, String> {
         let (func, arity) = self
-            .functions
             .get(name)
             .ok_or_else(|| format!("Unknown function: {}", name))?;
 
-        if *arity >= 0 && args.len() != *arity as usize {
+        if arity >= 0 && args.len() != arity as usize {
             return Err(format!(
                 "Function {} expects {} arguments, got {}",
                 name,
@@ -2,6 +2,7 @@ use achronyme_parser::ast::AstNode;
 use achronyme_types::value::Value;
 
 use crate::evaluator::Evaluator;
+use crate::profiler::Phase;
 use crate::type_checker;
 
 /// Evaluate an assignment statement
@@ -28,22 +29,7 @@ pub fn evaluate_assignment(
     // Dispatch based on target type
     match target {
         // Simple variable: x = 20
-        AstNode::VariableRef(name) => {
-            // Check type annotation before assignment (if one exists)
-            if let Some(expected_type) = evaluator.environment().get_type_annotation(name) {
-                type_checker::check_type(&new_value, &expected_type).map_err(|_| {
-                    format!(
-                        "Type error: cannot assign {} to variable '{}' of type {}",
-                        type_checker::infer_type(&new_value).to_string(),
-                        name,
-                        expected_type.to_string()
-                    )
-                })?;
-            }
-
-            evaluator.environment_mut().assign(name, new_value.clone())?;
-            Ok(new_value)
-        }
+        AstNode::VariableRef(name) => assign_to_variable(evaluator, name, new_value),
 
         // Field access: config.valor = 30
         AstNode::FieldAccess { record, field } => {
@@ -85,6 +71,30 @@ pub fn evaluate_assignment(
     }
 }
 
+/// Assign to a simple variable: x = 20
+///
+/// Enforces the variable's type annotation (if it was declared with one).
+pub(crate) fn assign_to_variable(
+    evaluator: &mut Evaluator,
+    name: &str,
+    new_value: Value,
+) -> Result<Value, String> {
+    // Check type annotation before assignment (if one exists)
+    if let Some(expected_type) = evaluator.environment().get_type_annotation(name) {
+        evaluator.profile_phase(Phase::TypeCheck, |_| type_checker::check_type(&new_value, &expected_type)).map_err(|_| {
+            format!(
+                "Type error: cannot assign {} to variable '{}' of type {}",
+                type_checker::infer_type(&new_value).to_string(),
+                name,
+                expected_type.to_string()
+            )
+        })?;
+    }
+
+    evaluator.environment_mut().assign(name, new_value.clone())?;
+    Ok(new_value)
+}
+
 /// Assign to a record field: config.valor = 30
 fn assign_to_field(
     evaluator: &mut Evaluator,
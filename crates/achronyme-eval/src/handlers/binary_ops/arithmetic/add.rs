@@ -8,11 +8,12 @@ pub fn apply_add(left: Value, right: Value) -> Result<Value, String> {
         (Value::Complex(a), Value::Complex(b)) => Ok(Value::Complex(a + b)),
 
         // Tensor support (optimized path)
+        // Operands are owned temporaries, so the result reuses one of their buffers
         (Value::Tensor(a), Value::Tensor(b)) => {
-            a.add(&b).map(Value::Tensor).map_err(|e| e.to_string())
+            a.add_owned(*b).map(Value::from).map_err(|e| e.to_string())
         }
         (Value::ComplexTensor(a), Value::ComplexTensor(b)) => {
-            a.add(&b).map(Value::ComplexTensor).map_err(|e| e.to_string())
+            a.add_owned(*b).map(Value::from).map_err(|e| e.to_string())
         }
 
         // Type promotion: Number → Complex
@@ -36,13 +37,13 @@ pub fn apply_add(left: Value, right: Value) -> Result<Value, String> {
                     let tensor_a = Value::to_complex_tensor(a).map_err(|_| "Type conversion error")?;
                     let tensor_b = Value::to_complex_tensor(b).map_err(|_| "Type conversion error")?;
                     let result = tensor_a.add(&tensor_b).map_err(|e| e.to_string())?;
-                    Ok(Value::ComplexTensor(result))
+                    Ok(Value::ComplexTensor(Box::new(result)))
                 } else {
                     // Real tensor addition
                     let tensor_a = Value::to_real_tensor(a).map_err(|_| "Type conversion error")?;
                     let tensor_b = Value::to_real_tensor(b).map_err(|_| "Type conversion error")?;
                     let result = tensor_a.add(&tensor_b).map_err(|e| e.to_string())?;
-                    Ok(Value::Tensor(result))
+                    Ok(Value::Tensor(Box::new(result)))
                 }
             } else {
                 Err("Vector addition requires numeric vectors".to_string())
@@ -102,39 +103,38 @@ pub fn apply_add(left: Value, right: Value) -> Result<Value, String> {
         }
 
         // Broadcasting: Tensor + Scalar
-        (Value::Tensor(t), Value::Number(scalar)) => {
-            Ok(Value::Tensor(t.add_scalar(scalar)))
-        }
-        (Value::Number(scalar), Value::Tensor(t)) => {
-            Ok(Value::Tensor(t.add_scalar(scalar)))
+        (Value::Tensor(mut t), Value::Number(scalar))
+        | (Value::Number(scalar), Value::Tensor(mut t)) => {
+            t.add_scalar_assign(scalar);
+            Ok(Value::Tensor(t))
         }
 
         // Broadcasting: Tensor + Complex
         (Value::Tensor(t), Value::Complex(c)) => {
             // Convert real tensor to complex tensor, then add
-            let ct = t.to_complex();
-            Ok(Value::ComplexTensor(ct.add_scalar(c)))
+            let mut ct = t.to_complex();
+            ct.add_scalar_assign(c);
+            Ok(Value::ComplexTensor(Box::new(ct)))
         }
         (Value::Complex(c), Value::Tensor(t)) => {
             // Convert real tensor to complex tensor, then add
-            let ct = t.to_complex();
-            Ok(Value::ComplexTensor(ct.add_scalar(c)))
+            let mut ct = t.to_complex();
+            ct.add_scalar_assign(c);
+            Ok(Value::ComplexTensor(Box::new(ct)))
         }
 
         // Broadcasting: ComplexTensor + Scalar
-        (Value::ComplexTensor(ct), Value::Number(scalar)) => {
-            Ok(Value::ComplexTensor(ct.add_scalar(Complex::from_real(scalar))))
-        }
-        (Value::Number(scalar), Value::ComplexTensor(ct)) => {
-            Ok(Value::ComplexTensor(ct.add_scalar(Complex::from_real(scalar))))
+        (Value::ComplexTensor(mut ct), Value::Number(scalar))
+        | (Value::Number(scalar), Value::ComplexTensor(mut ct)) => {
+            ct.add_scalar_assign(Complex::from_real(scalar));
+            Ok(Value::ComplexTensor(ct))
         }
 
         // Broadcasting: ComplexTensor + Complex
-        (Value::ComplexTensor(ct), Value::Complex(c)) => {
-            Ok(Value::ComplexTensor(ct.add_scalar(c)))
-        }
-        (Value::Complex(c), Value::ComplexTensor(ct)) => {
-            Ok(Value::ComplexTensor(ct.add_scalar(c)))
+        (Value::ComplexTensor(mut ct), Value::Complex(c))
+        | (Value::Complex(c), Value::ComplexTensor(mut ct)) => {
+            ct.add_scalar_assign(c);
+            Ok(Value::ComplexTensor(ct))
         }
 
         // String concatenation (String + String)
@@ -1,6 +1,6 @@
 use achronyme_types::complex::Complex;
 use achronyme_types::value::Value;
-use achronyme_types::tensor::{RealTensor, ComplexTensor};
+use achronyme_types::tensor::ComplexTensor;
 
 pub fn apply_divide(left: Value, right: Value) -> Result<Value, String> {
     match (left, right) {
@@ -14,11 +14,12 @@ pub fn apply_divide(left: Value, right: Value) -> Result<Value, String> {
         (Value::Complex(a), Value::Complex(b)) => Ok(Value::Complex(a / b)),
 
         // Tensor support (optimized path)
+        // Operands are owned temporaries, so the result reuses one of their buffers
         (Value::Tensor(a), Value::Tensor(b)) => {
-            a.div(&b).map(Value::Tensor).map_err(|e| e.to_string())
+            a.div_owned(*b).map(Value::from).map_err(|e| e.to_string())
         }
         (Value::ComplexTensor(a), Value::ComplexTensor(b)) => {
-            a.div(&b).map(Value::ComplexTensor).map_err(|e| e.to_string())
+            a.div_owned(*b).map(Value::from).map_err(|e| e.to_string())
         }
 
         // Type promotion: Number → Complex
@@ -42,13 +43,13 @@ pub fn apply_divide(left: Value, right: Value) -> Result<Value, String> {
                     let tensor_a = Value::to_complex_tensor(a).map_err(|_| "Type conversion error")?;
                     let tensor_b = Value::to_complex_tensor(b).map_err(|_| "Type conversion error")?;
                     let result = tensor_a.div(&tensor_b).map_err(|e| e.to_string())?;
-                    Ok(Value::ComplexTensor(result))
+                    Ok(Value::ComplexTensor(Box::new(result)))
                 } else {
                     // Real tensor division
                     let tensor_a = Value::to_real_tensor(a).map_err(|_| "Type conversion error")?;
                     let tensor_b = Value::to_real_tensor(b).map_err(|_| "Type conversion error")?;
                     let result = tensor_a.div(&tensor_b).map_err(|e| e.to_string())?;
-                    Ok(Value::Tensor(result))
+                    Ok(Value::Tensor(Box::new(result)))
                 }
             } else {
                 Err("Vector division requires numeric vectors".to_string())
@@ -114,28 +115,27 @@ pub fn apply_divide(left: Value, right: Value) -> Result<Value, String> {
         }
 
         // Broadcasting: Tensor / Scalar
-        (Value::Tensor(t), Value::Number(scalar)) => {
-            t.div_scalar(scalar).map(Value::Tensor)
+        (Value::Tensor(mut t), Value::Number(scalar)) => {
+            t.div_scalar_assign(scalar)?;
+            Ok(Value::Tensor(t))
         }
-        (Value::Number(scalar), Value::Tensor(t)) => {
-            // scalar / tensor = scalar * (1 / tensor)
-            // We need to compute element-wise: scalar / each_element
-            let data: Vec<f64> = t.data().iter().map(|&x| {
+        (Value::Number(scalar), Value::Tensor(mut t)) => {
+            // scalar / tensor: element-wise scalar / each_element
+            t.map_in_place(|&x| {
                 if x == 0.0 {
                     f64::INFINITY // Or could return error
                 } else {
                     scalar / x
                 }
-            }).collect();
-            RealTensor::new(data, t.shape().to_vec())
-                .map(Value::Tensor)
-                .map_err(|e| e.to_string())
+            });
+            Ok(Value::Tensor(t))
         }
 
         // Broadcasting: Tensor / Complex
         (Value::Tensor(t), Value::Complex(c)) => {
-            let ct = t.to_complex();
-            ct.div_scalar(c).map(Value::ComplexTensor)
+            let mut ct = t.to_complex();
+            ct.div_scalar_assign(c)?;
+            Ok(Value::ComplexTensor(Box::new(ct)))
         }
         (Value::Complex(c), Value::Tensor(t)) => {
             // c / tensor: element-wise c / each_element
@@ -147,44 +147,42 @@ pub fn apply_divide(left: Value, right: Value) -> Result<Value, String> {
                 }
             }).collect();
             ComplexTensor::new(data, t.shape().to_vec())
-                .map(Value::ComplexTensor)
+                .map(Value::from)
                 .map_err(|e| e.to_string())
         }
 
         // Broadcasting: ComplexTensor / Scalar
-        (Value::ComplexTensor(ct), Value::Number(scalar)) => {
-            ct.div_scalar(Complex::from_real(scalar)).map(Value::ComplexTensor)
+        (Value::ComplexTensor(mut ct), Value::Number(scalar)) => {
+            ct.div_scalar_assign(Complex::from_real(scalar))?;
+            Ok(Value::ComplexTensor(ct))
         }
-        (Value::Number(scalar), Value::ComplexTensor(ct)) => {
+        (Value::Number(scalar), Value::ComplexTensor(mut ct)) => {
             // scalar / tensor: element-wise scalar / each_element
-            let data: Vec<Complex> = ct.data().iter().map(|c| {
+            ct.map_in_place(|c| {
                 if c.re == 0.0 && c.im == 0.0 {
                     Complex::new(f64::INFINITY, 0.0)
                 } else {
                     Complex::from_real(scalar) / *c
                 }
-            }).collect();
-            ComplexTensor::new(data, ct.shape().to_vec())
-                .map(Value::ComplexTensor)
-                .map_err(|e| e.to_string())
+            });
+            Ok(Value::ComplexTensor(ct))
         }
 
         // Broadcasting: ComplexTensor / Complex
-        (Value::ComplexTensor(ct), Value::Complex(c)) => {
-            ct.div_scalar(c).map(Value::ComplexTensor)
+        (Value::ComplexTensor(mut ct), Value::Complex(c)) => {
+            ct.div_scalar_assign(c)?;
+            Ok(Value::ComplexTensor(ct))
         }
-        (Value::Complex(c), Value::ComplexTensor(ct)) => {
+        (Value::Complex(c), Value::ComplexTensor(mut ct)) => {
             // c / tensor: element-wise c / each_element
-            let data: Vec<Complex> = ct.data().iter().map(|elem| {
+            ct.map_in_place(|elem| {
                 if elem.re == 0.0 && elem.im == 0.0 {
                     Complex::new(f64::INFINITY, 0.0)
                 } else {
                     c / *elem
                 }
-            }).collect();
-            ComplexTensor::new(data, ct.shape().to_vec())
-                .map(Value::ComplexTensor)
-                .map_err(|e| e.to_string())
+            });
+            Ok(Value::ComplexTensor(ct))
         }
 
         _ => Err("Incompatible types for division".to_string()),
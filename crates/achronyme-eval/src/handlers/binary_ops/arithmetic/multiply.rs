@@ -10,18 +10,17 @@ pub fn apply_multiply(left: Value, right: Value) -> Result<Value, String> {
         (Value::Tensor(a), Value::Tensor(b)) => {
             // If both are matrices, do matrix multiplication
             if a.is_matrix() && b.is_matrix() {
-                a.matmul(&b)
-                    .map(Value::Tensor)
-                    .map_err(|e| e.to_string())
+                achronyme_linalg::matmul(&a, &b).map(Value::from)
             } else {
                 // Otherwise, do element-wise multiplication (Hadamard product)
-                a.mul(&b)
-                    .map(Value::Tensor)
+                a.mul_owned(*b)
+                    .map(Value::from)
                     .map_err(|e| e.to_string())
             }
         }
+        // Element-wise; complex matrix products go through matmul()
         (Value::ComplexTensor(a), Value::ComplexTensor(b)) => {
-            a.mul(&b).map(Value::ComplexTensor).map_err(|e| e.to_string())
+            a.mul_owned(*b).map(Value::from).map_err(|e| e.to_string())
         }
 
         // Type promotion: Number → Complex
@@ -45,13 +44,13 @@ pub fn apply_multiply(left: Value, right: Value) -> Result<Value, String> {
                     let tensor_a = Value::to_complex_tensor(a).map_err(|_| "Type conversion error")?;
                     let tensor_b = Value::to_complex_tensor(b).map_err(|_| "Type conversion error")?;
                     let result = tensor_a.mul(&tensor_b).map_err(|e| e.to_string())?;
-                    Ok(Value::ComplexTensor(result))
+                    Ok(Value::ComplexTensor(Box::new(result)))
                 } else {
                     // Real tensor multiplication
                     let tensor_a = Value::to_real_tensor(a).map_err(|_| "Type conversion error")?;
                     let tensor_b = Value::to_real_tensor(b).map_err(|_| "Type conversion error")?;
                     let result = tensor_a.mul(&tensor_b).map_err(|e| e.to_string())?;
-                    Ok(Value::Tensor(result))
+                    Ok(Value::Tensor(Box::new(result)))
                 }
             } else {
                 Err("Vector multiplication requires numeric vectors".to_string())
@@ -111,37 +110,36 @@ pub fn apply_multiply(left: Value, right: Value) -> Result<Value, String> {
         }
 
         // Broadcasting: Tensor * Scalar
-        (Value::Tensor(t), Value::Number(scalar)) => {
-            Ok(Value::Tensor(t.mul_scalar(scalar)))
-        }
-        (Value::Number(scalar), Value::Tensor(t)) => {
-            Ok(Value::Tensor(t.mul_scalar(scalar)))
+        (Value::Tensor(mut t), Value::Number(scalar))
+        | (Value::Number(scalar), Value::Tensor(mut t)) => {
+            t.mul_scalar_assign(scalar);
+            Ok(Value::Tensor(t))
         }
 
         // Broadcasting: Tensor * Complex
         (Value::Tensor(t), Value::Complex(c)) => {
-            let ct = t.to_complex();
-            Ok(Value::ComplexTensor(ct.mul_scalar(c)))
+            let mut ct = t.to_complex();
+            ct.mul_scalar_assign(c);
+            Ok(Value::ComplexTensor(Box::new(ct)))
         }
         (Value::Complex(c), Value::Tensor(t)) => {
-            let ct = t.to_complex();
-            Ok(Value::ComplexTensor(ct.mul_scalar(c)))
+            let mut ct = t.to_complex();
+            ct.mul_scalar_assign(c);
+            Ok(Value::ComplexTensor(Box::new(ct)))
         }
 
         // Broadcasting: ComplexTensor * Scalar
-        (Value::ComplexTensor(ct), Value::Number(scalar)) => {
-            Ok(Value::ComplexTensor(ct.mul_scalar(Complex::from_real(scalar))))
-        }
-        (Value::Number(scalar), Value::ComplexTensor(ct)) => {
-            Ok(Value::ComplexTensor(ct.mul_scalar(Complex::from_real(scalar))))
+        (Value::ComplexTensor(mut ct), Value::Number(scalar))
+        | (Value::Number(scalar), Value::ComplexTensor(mut ct)) => {
+            ct.mul_scalar_assign(Complex::from_real(scalar));
+            Ok(Value::ComplexTensor(ct))
         }
 
         // Broadcasting: ComplexTensor * Complex
-        (Value::ComplexTensor(ct), Value::Complex(c)) => {
-            Ok(Value::ComplexTensor(ct.mul_scalar(c)))
-        }
-        (Value::Complex(c), Value::ComplexTensor(ct)) => {
-            Ok(Value::ComplexTensor(ct.mul_scalar(c)))
+        (Value::ComplexTensor(mut ct), Value::Complex(c))
+        | (Value::Complex(c), Value::ComplexTensor(mut ct)) => {
+            ct.mul_scalar_assign(c);
+            Ok(Value::ComplexTensor(ct))
         }
 
         // String broadcasting: String * Number (repetition)
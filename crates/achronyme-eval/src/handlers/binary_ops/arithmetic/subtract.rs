@@ -7,11 +7,12 @@ pub fn apply_subtract(left: Value, right: Value) -> Result<Value, String> {
         (Value::Complex(a), Value::Complex(b)) => Ok(Value::Complex(a - b)),
 
         // Tensor support (optimized path)
+        // Operands are owned temporaries, so the result reuses one of their buffers
         (Value::Tensor(a), Value::Tensor(b)) => {
-            a.sub(&b).map(Value::Tensor).map_err(|e| e.to_string())
+            a.sub_owned(*b).map(Value::from).map_err(|e| e.to_string())
         }
         (Value::ComplexTensor(a), Value::ComplexTensor(b)) => {
-            a.sub(&b).map(Value::ComplexTensor).map_err(|e| e.to_string())
+            a.sub_owned(*b).map(Value::from).map_err(|e| e.to_string())
         }
 
         // Type promotion: Number → Complex
@@ -35,13 +36,13 @@ pub fn apply_subtract(left: Value, right: Value) -> Result<Value, String> {
                     let tensor_a = Value::to_complex_tensor(a).map_err(|_| "Type conversion error")?;
                     let tensor_b = Value::to_complex_tensor(b).map_err(|_| "Type conversion error")?;
                     let result = tensor_a.sub(&tensor_b).map_err(|e| e.to_string())?;
-                    Ok(Value::ComplexTensor(result))
+                    Ok(Value::ComplexTensor(Box::new(result)))
                 } else {
                     // Real tensor subtraction
                     let tensor_a = Value::to_real_tensor(a).map_err(|_| "Type conversion error")?;
                     let tensor_b = Value::to_real_tensor(b).map_err(|_| "Type conversion error")?;
                     let result = tensor_a.sub(&tensor_b).map_err(|e| e.to_string())?;
-                    Ok(Value::Tensor(result))
+                    Ok(Value::Tensor(Box::new(result)))
                 }
             } else {
                 Err("Vector subtraction requires numeric vectors".to_string())
@@ -101,41 +102,45 @@ pub fn apply_subtract(left: Value, right: Value) -> Result<Value, String> {
         }
 
         // Broadcasting: Tensor - Scalar
-        (Value::Tensor(t), Value::Number(scalar)) => {
-            Ok(Value::Tensor(t.sub_scalar(scalar)))
+        (Value::Tensor(mut t), Value::Number(scalar)) => {
+            t.sub_scalar_assign(scalar);
+            Ok(Value::Tensor(t))
         }
-        (Value::Number(scalar), Value::Tensor(t)) => {
-            // scalar - tensor = -(tensor - scalar)
-            Ok(Value::Tensor(t.sub_scalar(scalar).negate()))
+        (Value::Number(scalar), Value::Tensor(mut t)) => {
+            t.rsub_scalar_assign(scalar);
+            Ok(Value::Tensor(t))
         }
 
         // Broadcasting: Tensor - Complex
         (Value::Tensor(t), Value::Complex(c)) => {
-            let ct = t.to_complex();
-            Ok(Value::ComplexTensor(ct.sub_scalar(c)))
+            let mut ct = t.to_complex();
+            ct.sub_scalar_assign(c);
+            Ok(Value::ComplexTensor(Box::new(ct)))
         }
         (Value::Complex(c), Value::Tensor(t)) => {
-            // c - tensor = -(tensor - c)
-            let ct = t.to_complex();
-            Ok(Value::ComplexTensor(ct.sub_scalar(c).negate()))
+            let mut ct = t.to_complex();
+            ct.rsub_scalar_assign(c);
+            Ok(Value::ComplexTensor(Box::new(ct)))
         }
 
         // Broadcasting: ComplexTensor - Scalar
-        (Value::ComplexTensor(ct), Value::Number(scalar)) => {
-            Ok(Value::ComplexTensor(ct.sub_scalar(Complex::from_real(scalar))))
+        (Value::ComplexTensor(mut ct), Value::Number(scalar)) => {
+            ct.sub_scalar_assign(Complex::from_real(scalar));
+            Ok(Value::ComplexTensor(ct))
         }
-        (Value::Number(scalar), Value::ComplexTensor(ct)) => {
-            // scalar - tensor = -(tensor - scalar)
-            Ok(Value::ComplexTensor(ct.sub_scalar(Complex::from_real(scalar)).negate()))
+        (Value::Number(scalar), Value::ComplexTensor(mut ct)) => {
+            ct.rsub_scalar_assign(Complex::from_real(scalar));
+            Ok(Value::ComplexTensor(ct))
         }
 
         // Broadcasting: ComplexTensor - Complex
-        (Value::ComplexTensor(ct), Value::Complex(c)) => {
-            Ok(Value::ComplexTensor(ct.sub_scalar(c)))
+        (Value::ComplexTensor(mut ct), Value::Complex(c)) => {
+            ct.sub_scalar_assign(c);
+            Ok(Value::ComplexTensor(ct))
         }
-        (Value::Complex(c), Value::ComplexTensor(ct)) => {
-            // c - tensor = -(tensor - c)
-            Ok(Value::ComplexTensor(ct.sub_scalar(c).negate()))
+        (Value::Complex(c), Value::ComplexTensor(mut ct)) => {
+            ct.rsub_scalar_assign(c);
+            Ok(Value::ComplexTensor(ct))
         }
 
         _ => Err("Incompatible types for subtraction".to_string()),
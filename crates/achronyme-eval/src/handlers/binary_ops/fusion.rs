@@ -0,0 +1,298 @@
+//! Fused evaluation of chained element-wise tensor arithmetic
+//!
+//! `a*x + b*y - c` normally materializes a full-size tensor for every
+//! operator. When fusion mode is on, a chain of `+ - * /` is flattened to
+//! postfix, its operands are evaluated once, and if every tensor operand has
+//! the same shape the whole chain runs in a single pass over memory, block by
+//! block, with cache-resident temporaries.
+//!
+//! Chains that can't be fused (mixed shapes, matrix products, complex
+//! values, ...) are replayed operator by operator on the already-evaluated
+//! operands, so results are identical to the tree-walker. The one observable
+//! difference is ordering: all operands of a chain are evaluated before any
+//! of its operators run.
+
+use achronyme_parser::ast::{AstNode, BinaryOp};
+use achronyme_types::tensor::RealTensor;
+use achronyme_types::value::Value;
+
+use crate::evaluator::Evaluator;
+
+/// Elements processed per block; temporaries of this size stay in L1
+const BLOCK: usize = 256;
+
+/// Postfix step over the chain's operands
+enum Step {
+    Operand(usize),
+    Op(BinaryOp),
+}
+
+/// Operand of the fused program after constant folding
+#[derive(Clone, Copy)]
+enum Term {
+    Scalar(f64),
+    Tensor(usize),
+}
+
+/// Fused program step
+enum Fused {
+    Push(Term),
+    Op(BinaryOp),
+}
+
+/// Operators that act element-wise on same-shape tensors
+fn is_elementwise(op: &BinaryOp) -> bool {
+    matches!(op, BinaryOp::Add | BinaryOp::Subtract | BinaryOp::Multiply | BinaryOp::Divide)
+}
+
+/// Whether `left op right` is a chain of at least two element-wise operators
+pub fn is_fusible_chain(op: &BinaryOp, left: &AstNode, right: &AstNode) -> bool {
+    let is_chain = |node: &AstNode| matches!(node, AstNode::BinaryOp { op, .. } if is_elementwise(op));
+    is_elementwise(op) && (is_chain(left) || is_chain(right))
+}
+
+/// Flatten a chain into postfix steps, collecting operands in evaluation order
+fn flatten<'a>(node: &'a AstNode, steps: &mut Vec<Step>, operands: &mut Vec<&'a AstNode>) {
+    match node {
+        AstNode::BinaryOp { op, left, right } if is_elementwise(op) => {
+            flatten(left, steps, operands);
+            flatten(right, steps, operands);
+            steps.push(Step::Op(op.clone()));
+        }
+        _ => {
+            steps.push(Step::Operand(operands.len()));
+            operands.push(node);
+        }
+    }
+}
+
+/// Evaluate `left op right` as one fused chain
+pub fn evaluate_fused(
+    evaluator: &mut Evaluator,
+    op: &BinaryOp,
+    left: &AstNode,
+    right: &AstNode,
+) -> Result<Value, String> {
+    let mut steps = Vec::new();
+    let mut operands = Vec::new();
+    flatten(left, &mut steps, &mut operands);
+    flatten(right, &mut steps, &mut operands);
+    steps.push(Step::Op(op.clone()));
+
+    let values = operands
+        .into_iter()
+        .map(|node| evaluator.evaluate(node))
+        .collect::<Result<Vec<_>, _>>()?;
+
+    match plan(&steps, &values) {
+        Some((program, shape)) => run(&program, &values, shape),
+        None => replay(&steps, values),
+    }
+}
+
+/// Apply the steps one operator at a time, exactly like the tree-walker
+fn replay(steps: &[Step], values: Vec<Value>) -> Result<Value, String> {
+    let mut values: Vec<Option<Value>> = values.into_iter().map(Some).collect();
+    let mut stack: Vec<Value> = Vec::with_capacity(values.len());
+
+    for step in steps {
+        match step {
+            Step::Operand(i) => stack.push(values[*i].take().expect("operand used once")),
+            Step::Op(op) => {
+                let right = stack.pop().expect("postfix stack underflow");
+                let left = stack.pop().expect("postfix stack underflow");
+                stack.push(super::apply(op, left, right)?);
+            }
+        }
+    }
+
+    Ok(stack.pop().expect("postfix stack underflow"))
+}
+
+/// Check that the chain can run fused and fold its scalar-only parts
+///
+/// Returns `None` for anything the element-wise kernel can't reproduce
+/// exactly: non-numeric or complex operands, differing tensor shapes,
+/// matrix × matrix (a matmul), scalar division by zero (an error), or a
+/// chain with no tensor at all.
+fn plan(steps: &[Step], values: &[Value]) -> Option<(Vec<Fused>, Vec<usize>)> {
+    let mut shape: Option<&[usize]> = None;
+    let mut program = Vec::with_capacity(steps.len());
+    // Mirrors the runtime stack: Some(x) for a foldable scalar, None for a tensor
+    let mut kinds: Vec<Option<f64>> = Vec::with_capacity(values.len());
+
+    for step in steps {
+        match step {
+            Step::Operand(i) => match &values[*i] {
+                Value::Number(n) => {
+                    program.push(Fused::Push(Term::Scalar(*n)));
+                    kinds.push(Some(*n));
+                }
+                Value::Tensor(t) => {
+                    match shape {
+                        Some(s) if s != t.shape() => return None,
+                        _ => shape = Some(t.shape()),
+                    }
+                    program.push(Fused::Push(Term::Tensor(*i)));
+                    kinds.push(None);
+                }
+                _ => return None,
+            },
+            Step::Op(op) => {
+                let right = kinds.pop()?;
+                let left = kinds.pop()?;
+                match (left, right) {
+                    (Some(a), Some(b)) => {
+                        // Fold scalar subexpressions up front
+                        let folded = match op {
+                            BinaryOp::Add => a + b,
+                            BinaryOp::Subtract => a - b,
+                            BinaryOp::Multiply => a * b,
+                            BinaryOp::Divide if b != 0.0 => a / b,
+                            _ => return None,
+                        };
+                        program.pop();
+                        program.pop();
+                        program.push(Fused::Push(Term::Scalar(folded)));
+                        kinds.push(Some(folded));
+                        continue;
+                    }
+                    (None, None) if *op == BinaryOp::Multiply && shape?.len() == 2 => return None,
+                    (None, Some(b)) if *op == BinaryOp::Divide && b == 0.0 => return None,
+                    _ => {}
+                }
+                program.push(Fused::Op(op.clone()));
+                kinds.push(None);
+            }
+        }
+    }
+
+    match kinds.pop()? {
+        None => Some((program, shape?.to_vec())),
+        Some(_) => None,
+    }
+}
+
+/// Slot on the block evaluation stack
+#[derive(Clone, Copy)]
+enum Slot {
+    Scalar(f64),
+    Input(usize),
+    Buffer(usize),
+}
+
+/// Run a planned program over all elements, one block at a time
+fn run(program: &[Fused], values: &[Value], shape: Vec<usize>) -> Result<Value, String> {
+    let inputs: Vec<&[f64]> = values
+        .iter()
+        .map(|v| match v {
+            Value::Tensor(t) => t.data(),
+            _ => &[],
+        })
+        .collect();
+    let len: usize = shape.iter().product();
+
+    let mut out = Vec::with_capacity(len);
+    let mut buffers: Vec<Vec<f64>> = Vec::new();
+    let mut free: Vec<usize> = Vec::new();
+    let mut stack: Vec<Slot> = Vec::with_capacity(program.len());
+
+    for start in (0..len).step_by(BLOCK) {
+        let end = (start + BLOCK).min(len);
+        let n = end - start;
+
+        for step in program {
+            match step {
+                Fused::Push(Term::Scalar(x)) => stack.push(Slot::Scalar(*x)),
+                Fused::Push(Term::Tensor(i)) => stack.push(Slot::Input(*i)),
+                Fused::Op(op) => {
+                    let right = stack.pop().expect("postfix stack underflow");
+                    let left = stack.pop().expect("postfix stack underflow");
+
+                    // Write into an operand's buffer when there is one
+                    let dst = match (left, right) {
+                        (Slot::Buffer(b), _) | (_, Slot::Buffer(b)) => b,
+                        _ => free.pop().unwrap_or_else(|| {
+                            buffers.push(vec![0.0; BLOCK]);
+                            buffers.len() - 1
+                        }),
+                    };
+                    let mut acc = std::mem::take(&mut buffers[dst]);
+                    let source = |slot: Slot| match slot {
+                        Slot::Scalar(x) => Source::Scalar(x),
+                        Slot::Input(i) => Source::Slice(&inputs[i][start..end]),
+                        Slot::Buffer(b) if b == dst => Source::Dst,
+                        Slot::Buffer(b) => Source::Slice(&buffers[b][..n]),
+                    };
+                    let scalar_left = matches!(left, Slot::Scalar(_));
+                    apply_block(op, &mut acc[..n], source(left), source(right), scalar_left);
+                    buffers[dst] = acc;
+
+                    // Release the other operand's buffer
+                    for slot in [left, right] {
+                        if let Slot::Buffer(b) = slot {
+                            if b != dst {
+                                free.push(b);
+                            }
+                        }
+                    }
+                    stack.push(Slot::Buffer(dst));
+                }
+            }
+        }
+
+        match stack.pop() {
+            Some(Slot::Buffer(b)) => {
+                out.extend_from_slice(&buffers[b][..n]);
+                free.push(b);
+            }
+            _ => return Err("Fused evaluation produced no tensor".to_string()),
+        }
+    }
+
+    RealTensor::new(out, shape)
+        .map(Value::from)
+        .map_err(|e| e.to_string())
+}
+
+/// Where an operand's block comes from
+#[derive(Clone, Copy)]
+enum Source<'a> {
+    Scalar(f64),
+    Slice(&'a [f64]),
+    /// The destination buffer itself (the result overwrites this operand)
+    Dst,
+}
+
+/// dst = left op right over one block, matching the tensor handlers' semantics
+fn apply_block(op: &BinaryOp, dst: &mut [f64], left: Source, right: Source, scalar_left: bool) {
+    match op {
+        BinaryOp::Add => combine(|a, b| a + b, dst, left, right),
+        BinaryOp::Subtract => combine(|a, b| a - b, dst, left, right),
+        BinaryOp::Multiply => combine(|a, b| a * b, dst, left, right),
+        // scalar / tensor maps zero elements to infinity
+        BinaryOp::Divide if scalar_left => {
+            combine(|a, b| if b == 0.0 { f64::INFINITY } else { a / b }, dst, left, right)
+        }
+        BinaryOp::Divide => combine(|a, b| a / b, dst, left, right),
+        _ => unreachable!("only element-wise operators are fused"),
+    }
+}
+
+/// Monomorphized block loop; each arm is a flat, vectorizable loop
+#[inline(always)]
+fn combine(f: impl Fn(f64, f64) -> f64, dst: &mut [f64], left: Source, right: Source) {
+    match (left, right) {
+        (Source::Dst, Source::Dst) => dst.iter_mut().for_each(|x| *x = f(*x, *x)),
+        (Source::Dst, Source::Scalar(b)) => dst.iter_mut().for_each(|x| *x = f(*x, b)),
+        (Source::Dst, Source::Slice(s)) => dst.iter_mut().zip(s).for_each(|(x, &b)| *x = f(*x, b)),
+        (Source::Scalar(a), Source::Dst) => dst.iter_mut().for_each(|x| *x = f(a, *x)),
+        (Source::Slice(s), Source::Dst) => dst.iter_mut().zip(s).for_each(|(x, &a)| *x = f(a, *x)),
+        (Source::Scalar(a), Source::Scalar(b)) => dst.fill(f(a, b)),
+        (Source::Scalar(a), Source::Slice(s)) => dst.iter_mut().zip(s).for_each(|(x, &b)| *x = f(a, b)),
+        (Source::Slice(s), Source::Scalar(b)) => dst.iter_mut().zip(s).for_each(|(x, &a)| *x = f(a, b)),
+        (Source::Slice(l), Source::Slice(r)) => {
+            dst.iter_mut().zip(l.iter().zip(r)).for_each(|(x, (&a, &b))| *x = f(a, b))
+        }
+    }
+}
@@ -5,6 +5,7 @@ mod utils;
 mod arithmetic;
 mod comparison;
 mod logical;
+pub mod fusion;
 
 use arithmetic::{
     apply_add, apply_subtract, apply_multiply, apply_divide, apply_power, apply_modulo
@@ -6,6 +6,9 @@ use std::collections::HashMap;
 
 use crate::evaluator::Evaluator;
 
+use super::generator::{self, Resumed};
+use super::sequence::Pull;
+
 /// Evaluate an if expression
 pub fn evaluate_if(
     evaluator: &mut Evaluator,
@@ -89,7 +92,7 @@ pub fn evaluate_piecewise(
 
 /// Helper to convert Value to bool
 /// Boolean values map directly, numbers: 0 = false, != 0 = true
-fn value_to_bool(value: &Value) -> Result<bool, String> {
+pub(crate) fn value_to_bool(value: &Value) -> Result<bool, String> {
     match value {
         Value::Boolean(b) => Ok(*b),
         Value::Number(n) => Ok(*n != 0.0),
@@ -106,8 +109,8 @@ pub fn evaluate_generate_block(
     // Capture current environment for the generator
     let captured_env = evaluator.environment().clone();
 
-    // Create generator state
-    let state = GeneratorState::new(captured_env, statements.to_vec());
+    // Create generator state with the body lowered to a resumable program
+    let state = GeneratorState::new(captured_env, generator::lower(statements));
 
     // Return generator value
     let gen_rc = Rc::new(RefCell::new(state));
@@ -137,8 +140,11 @@ pub fn evaluate_for_in(
             // Return the generator itself - we'll handle .next() specially
             return evaluate_generator_for_in(evaluator, variable, gen_rc.clone(), body);
         }
+        Value::Sequence(seq) => {
+            return evaluate_sequence_for_in(evaluator, variable, Pull::new(seq), body);
+        }
         _ => {
-            return Err("for-in requires an iterable (object with next method or generator)".to_string());
+            return Err("for-in requires an iterable (object with next method, generator or sequence)".to_string());
         }
     };
 
@@ -215,35 +221,16 @@ fn evaluate_generator_for_in(
     let mut last_value = Value::Null;
 
     loop {
-        // Resume the generator
-        let result = resume_generator(evaluator, &gen_rc)?;
-
-        // Check if done
-        let result_record = match &result {
-            Value::Record(map) => map,
-            _ => {
+        // Resume the generator; no {value, done} record is built
+        let value = match generator::next_value(evaluator, &gen_rc) {
+            Ok(Some(value)) => value,
+            Ok(None) => break,
+            Err(e) => {
                 evaluator.environment_mut().pop_scope();
-                return Err("Generator next() must return {value: T, done: Boolean}".to_string());
-            }
-        };
-
-        let done = match result_record.get("done") {
-            Some(Value::Boolean(b)) => *b,
-            _ => {
-                evaluator.environment_mut().pop_scope();
-                return Err("Generator next() must return {done: Boolean}".to_string());
+                return Err(e);
             }
         };
 
-        if done {
-            break;
-        }
-
-        let value = result_record
-            .get("value")
-            .cloned()
-            .ok_or_else(|| "Generator next() must return {value: T}".to_string())?;
-
         // Bind loop variable
         evaluator.environment_mut().define(variable.to_string(), value)?;
 
@@ -261,67 +248,54 @@ fn evaluate_generator_for_in(
     Ok(last_value)
 }
 
-/// Resume a generator and return the next {value, done} result
-pub fn resume_generator(
+/// Helper to evaluate for-in loop over a lazy sequence
+fn evaluate_sequence_for_in(
     evaluator: &mut Evaluator,
-    gen: &Rc<RefCell<GeneratorState>>,
+    variable: &str,
+    mut pull: Pull,
+    body: &AstNode,
 ) -> Result<Value, String> {
-    let mut state = gen.borrow_mut();
-
-    // If already done, return sticky value
-    if state.done {
-        let return_val = state.return_value.as_ref()
-            .map(|v| (**v).clone())
-            .unwrap_or(Value::Null);
-        return Ok(make_iterator_result(return_val, true));
-    }
+    // Create new scope for loop
+    evaluator.environment_mut().push_scope();
 
-    // Swap environments: save evaluator's current env, use generator's env
-    let saved_env = std::mem::replace(evaluator.environment_mut(), state.env.clone());
+    let mut last_value = Value::Null;
 
-    // Save and set generator context
-    let saved_in_generator = evaluator.in_generator;
-    evaluator.in_generator = true;
+    loop {
+        let value = match pull.next(evaluator) {
+            Ok(Some(value)) => value,
+            Ok(None) => break,
+            Err(e) => {
+                evaluator.environment_mut().pop_scope();
+                return Err(e);
+            }
+        };
 
-    // Execute until yield or end
-    let result = execute_until_yield(evaluator, &mut state);
+        // Bind loop variable
+        evaluator.environment_mut().define(variable.to_string(), value)?;
 
-    // Restore generator context
-    evaluator.in_generator = saved_in_generator;
+        // Execute body
+        last_value = evaluator.evaluate(body)?;
 
-    // Restore saved environment
-    state.env = std::mem::replace(evaluator.environment_mut(), saved_env);
+        // Check for early return
+        if matches!(last_value, Value::EarlyReturn(_)) {
+            evaluator.environment_mut().pop_scope();
+            return Ok(last_value);
+        }
+    }
 
-    result
+    evaluator.environment_mut().pop_scope();
+    Ok(last_value)
 }
 
-/// Execute generator statements until a yield, return, or end
-fn execute_until_yield(
+/// Resume a generator and return the next {value, done} result
+pub fn resume_generator(
     evaluator: &mut Evaluator,
-    state: &mut GeneratorState,
+    gen: &Rc<RefCell<GeneratorState>>,
 ) -> Result<Value, String> {
-    // Continue execution from current position
-    while state.position < state.statements.len() {
-        let stmt = state.statements[state.position].clone();
-        state.position += 1;
-
-        let result = evaluator.evaluate(&stmt)?;
-
-        // Check for generator yield marker
-        if let Value::GeneratorYield(yielded_value) = result {
-            return Ok(make_iterator_result(*yielded_value, false));
-        }
-
-        // Check for early return in nested code
-        if let Value::EarlyReturn(inner) = result {
-            state.mark_done(Some(*inner.clone()));
-            return Ok(make_iterator_result(*inner, true));
-        }
+    match generator::resume(evaluator, gen)? {
+        Resumed::Yielded(value) => Ok(make_iterator_result(value, false)),
+        Resumed::Returned(value) => Ok(make_iterator_result(value, true)),
     }
-
-    // Generator exhausted naturally (no explicit return)
-    state.mark_done(Some(Value::Null));
-    Ok(make_iterator_result(Value::Null, true))
 }
 
 /// Create an iterator result record {value: T, done: Boolean}
@@ -329,7 +303,7 @@ fn make_iterator_result(value: Value, done: bool) -> Value {
     let mut map = HashMap::new();
     map.insert("value".to_string(), value);
     map.insert("done".to_string(), Value::Boolean(done));
-    Value::Record(map)
+    Value::Record(Box::new(map))
 }
 
 /// Evaluate a throw statement
@@ -343,16 +317,10 @@ pub fn evaluate_throw(
     // Convert the thrown value into a Value::Error
     let error_value = match thrown_value {
         // If it's already an Error, preserve it (for re-throws)
-        Value::Error { message, kind, source } => {
-            Value::Error { message, kind, source }
-        }
+        Value::Error(error) => Value::Error(error),
         // If it's a String, wrap in Error with no kind
         Value::String(msg) => {
-            Value::Error {
-                message: msg,
-                kind: None,
-                source: None,
-            }
+            Value::error(msg, None)
         }
         // If it's a Record, try to extract message and kind fields
         Value::Record(ref map) => {
@@ -365,28 +333,20 @@ pub fn evaluate_throw(
                 Some(Value::String(s)) => Some(s.clone()),
                 _ => None,
             };
-            Value::Error {
-                message,
-                kind,
-                source: None,
-            }
+            Value::error(message, kind)
         }
         // For other values, convert to string
         other => {
-            Value::Error {
-                message: format!("{:?}", other),
-                kind: None,
-                source: None,
-            }
+            Value::error(format!("{:?}", other), None)
         }
     };
 
     // Format the error for propagation
     let error_string = match &error_value {
-        Value::Error { message, kind, .. } => {
-            match kind {
-                Some(k) => format!("Thrown: {} - {}", k, message),
-                None => format!("Thrown: {}", message),
+        Value::Error(error) => {
+            match &error.kind {
+                Some(k) => format!("Thrown: {} - {}", k, error.message),
+                None => format!("Thrown: {}", error.message),
             }
         }
         _ => "Thrown: Unknown error".to_string(),
@@ -405,6 +365,9 @@ pub fn evaluate_try_catch(
     error_param: &str,
     catch_block: &AstNode,
 ) -> Result<Value, String> {
+    // Blocks the error unwound out of leave their scopes behind
+    let depth = evaluator.environment().scope_depth();
+
     // Evaluate the try block
     match evaluator.evaluate(try_block) {
         Ok(value) => {
@@ -418,8 +381,13 @@ pub fn evaluate_try_catch(
                 _ => Ok(value),
             }
         }
+        // A timed-out evaluation must stop, not run the catch block
+        Err(error_string) if evaluator.deadline_passed() => Err(error_string),
         Err(error_string) => {
             // An error was thrown - handle it in the catch block
+            while evaluator.environment().scope_depth() > depth {
+                evaluator.environment_mut().pop_scope();
+            }
 
             // Parse the error string to create an Error value
             let error_value = parse_error_string(&error_string);
@@ -452,24 +420,12 @@ fn parse_error_string(error_string: &str) -> Value {
         if let Some(dash_pos) = rest.find(" - ") {
             let kind = rest[..dash_pos].to_string();
             let message = rest[dash_pos + 3..].to_string();
-            Value::Error {
-                message,
-                kind: Some(kind),
-                source: None,
-            }
+            Value::error(message, Some(kind))
         } else {
-            Value::Error {
-                message: rest.to_string(),
-                kind: None,
-                source: None,
-            }
+            Value::error(rest.to_string(), None)
         }
     } else {
         // Generic error (not from throw)
-        Value::Error {
-            message: error_string.to_string(),
-            kind: Some("RuntimeError".to_string()),
-            source: None,
-        }
+        Value::error(error_string.to_string(), Some("RuntimeError".to_string()))
     }
 }
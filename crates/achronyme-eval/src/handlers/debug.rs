@@ -101,21 +101,25 @@ fn describe_value(value: &Value, indent: usize) -> String {
 
         Value::Generator(gen_rc) => {
             let state = gen_rc.borrow();
-            format!("Generator(position: {}, done: {}, statements: {})",
-                state.position, state.done, state.statements.len())
+            format!("Generator(pc: {}, done: {}, ops: {})",
+                state.pc, state.done, state.program.len())
+        }
+
+        Value::Sequence(seq) => {
+            format!("Sequence(stages: {})", seq.stages.len())
         }
 
         Value::GeneratorYield(inner) => {
             format!("GeneratorYield({})", describe_value(inner, indent))
         }
 
-        Value::Error { message, kind, source } => {
-            let kind_str = kind.as_deref().unwrap_or("Unknown");
-            let source_str = match source {
+        Value::Error(error) => {
+            let kind_str = error.kind.as_deref().unwrap_or("Unknown");
+            let source_str = match &error.source {
                 Some(src) => format!(" (source: {})", describe_value(src, indent + 1)),
                 None => String::new(),
             };
-            format!("Error({}: {}){}",  kind_str, message, source_str)
+            format!("Error({}: {}){}",  kind_str, error.message, source_str)
         }
     }
 }
@@ -152,7 +156,7 @@ fn format_ast_node(node: &AstNode, indent: usize) -> String {
         AstNode::StringLiteral(s) => format!("{:?}", s),
         AstNode::ComplexLiteral { re, im } => format!("{}+{}i", re, im),
 
-        AstNode::VariableRef(name) => name.clone(),
+        AstNode::VariableRef(name) | AstNode::LocalRef { name, .. } => name.to_string(),
         AstNode::SelfReference => "self".to_string(),
         AstNode::RecReference => "rec".to_string(),
 
@@ -82,6 +82,7 @@ pub fn dispatch(evaluator: &mut Evaluator, name: &str, args: &[AstNode]) -> Resu
                 arg_values.push(evaluator.evaluate(arg)?);
             }
             // Apply lambda function
+            evaluator.profile_name(name, &var_value);
             let func_clone = func.clone();
             return evaluator.apply_lambda(&func_clone, arg_values);
         }
@@ -93,6 +94,13 @@ pub fn dispatch(evaluator: &mut Evaluator, name: &str, args: &[AstNode]) -> Resu
         "filter" => return super::hof::handle_filter(evaluator, args),
         "reduce" => return super::hof::handle_reduce(evaluator, args),
         "pipe" => return super::hof::handle_pipe(evaluator, args),
+        // Lazy sequences
+        "lazy" => return super::sequence::handle_lazy(evaluator, args),
+        "collect" => return super::sequence::handle_collect(evaluator, args),
+        // Parallel variants for pure lambdas
+        "pmap" => return super::parallel::handle_pmap(evaluator, args),
+        "pfilter" => return super::parallel::handle_pfilter(evaluator, args),
+        "preduce" => return super::parallel::handle_preduce(evaluator, args),
         // Tier 2 predicates
         "any" => return super::hof::handle_any(evaluator, args),
         "all" => return super::hof::handle_all(evaluator, args),
@@ -172,5 +180,5 @@ pub fn dispatch(evaluator: &mut Evaluator, name: &str, args: &[AstNode]) -> Resu
     }
 
     // Call the resolved function with access to the environment
-    func(&arg_values, evaluator.environment_mut())
+    evaluator.profile_builtin(name, |evaluator| func(&arg_values, evaluator.environment_mut()))
 }
@@ -4,6 +4,7 @@ use achronyme_types::function::Function;
 use achronyme_types::value::Value;
 
 use crate::evaluator::Evaluator;
+use crate::profiler::Phase;
 use crate::tco;
 
 /// Evaluate a lambda expression with typed parameters and return type
@@ -19,10 +20,13 @@ pub fn evaluate_lambda_with_return_type(
     let param_names: Vec<String> = params.iter().map(|(name, _)| name.clone()).collect();
     let param_types: Vec<Option<TypeAnnotation>> = params.iter().map(|(_, ty)| ty.clone()).collect();
 
+    // Locals of the body are read by slot instead of by name
+    let body = crate::resolver::resolve_lambda(&param_names, body);
+
     // Create a Function value with type annotations including return type
-    let function = Function::new_typed(param_names, param_types, return_type, body.clone(), closure_env);
+    let function = Function::new_typed(param_names, param_types, return_type, body, closure_env);
 
-    Ok(Value::Function(function))
+    Ok(Value::from(function))
 }
 
 /// Apply a lambda function to arguments
@@ -33,52 +37,30 @@ pub fn apply_lambda(
 ) -> Result<Value, String> {
     match function {
         Function::UserDefined { params, param_types, return_type, body, closure_env } => {
-            // Check arity
-            if args.len() != params.len() {
-                return Err(format!(
-                    "Lambda expects {} arguments, got {}",
-                    params.len(),
-                    args.len()
-                ));
-            }
-
-            // Type check arguments
-            for (i, (arg, param_type)) in args.iter().zip(param_types.iter()).enumerate() {
-                if let Some(expected_type) = param_type {
-                    crate::type_checker::check_type(arg, expected_type)
-                        .map_err(|_| format!(
-                            "Type error: argument {} (parameter '{}') expected {}, got {}",
-                            i + 1,
-                            params[i],
-                            expected_type.to_string(),
-                            crate::type_checker::infer_type(arg).to_string()
-                        ))?;
+            evaluator.profile_function(function, |evaluator| {
+                // Proven numeric signature: no type checks, unboxed arithmetic
+                if let Some(result) = evaluator.specialized_call(function, &args) {
+                    return Ok(result);
                 }
-            }
 
-            // TAIL CALL OPTIMIZATION (TCO):
-            // Check if this function is tail-recursive
-            let is_tail_recursive = tco::is_tail_recursive_function(body);
+                evaluator.profile_phase(Phase::TypeCheck, |_| check_arguments(params, param_types, &args))?;
 
-            let result = if is_tail_recursive {
-                // Use iterative execution for tail-recursive functions
-                apply_lambda_tco(evaluator, function, args)
-            } else {
-                // Use regular recursive execution
-                apply_lambda_regular(evaluator, params, param_types, return_type, body, closure_env, args)
-            }?;
-
-            // Type check return value
-            if let Some(expected_return) = return_type {
-                crate::type_checker::check_type(&result, expected_return)
-                    .map_err(|_| format!(
-                        "Type error: function return type expected {}, got {}",
-                        expected_return.to_string(),
-                        crate::type_checker::infer_type(&result).to_string()
-                    ))?;
-            }
+                let result = if let Some(chunk) = evaluator.compiled_body(function) {
+                    // Bytecode mode: run the compiled body on the VM
+                    crate::vm::call_function(evaluator, function, &chunk, args)
+                } else if tco::is_tail_recursive_function(body) {
+                    // TAIL CALL OPTIMIZATION (TCO):
+                    // Use iterative execution for tail-recursive functions
+                    apply_lambda_tco(evaluator, function, args)
+                } else {
+                    // Use regular recursive execution
+                    apply_lambda_regular(evaluator, function, params, body, closure_env, args)
+                }?;
 
-            Ok(result)
+                evaluator.profile_phase(Phase::TypeCheck, |_| check_return_type(return_type, &result))?;
+
+                Ok(result)
+            })
         }
         Function::Builtin(name) => {
             // Built-in functions can be called directly through the registry
@@ -103,7 +85,7 @@ pub fn apply_lambda(
                 }
 
                 // Call the builtin function directly with the evaluated arguments
-                func(&args, evaluator.environment_mut())
+                evaluator.profile_builtin(name, |evaluator| func(&args, evaluator.environment_mut()))
             } else {
                 Err(format!("Unknown built-in function: {}", name))
             }
@@ -111,13 +93,57 @@ pub fn apply_lambda(
     }
 }
 
+/// Check the arity and parameter types of a call to a user-defined function
+pub(crate) fn check_arguments(
+    params: &[String],
+    param_types: &[Option<TypeAnnotation>],
+    args: &[Value],
+) -> Result<(), String> {
+    // Check arity
+    if args.len() != params.len() {
+        return Err(format!(
+            "Lambda expects {} arguments, got {}",
+            params.len(),
+            args.len()
+        ));
+    }
+
+    // Type check arguments
+    for (i, (arg, param_type)) in args.iter().zip(param_types.iter()).enumerate() {
+        if let Some(expected_type) = param_type {
+            crate::type_checker::check_type(arg, expected_type)
+                .map_err(|_| format!(
+                    "Type error: argument {} (parameter '{}') expected {}, got {}",
+                    i + 1,
+                    params[i],
+                    expected_type.to_string(),
+                    crate::type_checker::infer_type(arg).to_string()
+                ))?;
+        }
+    }
+
+    Ok(())
+}
+
+/// Type check the result of a user-defined function against its return type
+pub(crate) fn check_return_type(return_type: &Option<TypeAnnotation>, result: &Value) -> Result<(), String> {
+    if let Some(expected_return) = return_type {
+        crate::type_checker::check_type(result, expected_return)
+            .map_err(|_| format!(
+                "Type error: function return type expected {}, got {}",
+                expected_return.to_string(),
+                crate::type_checker::infer_type(result).to_string()
+            ))?;
+    }
+    Ok(())
+}
+
 /// Regular (non-TCO) lambda application
 /// This is the original implementation, used when TCO doesn't apply
 fn apply_lambda_regular(
     evaluator: &mut Evaluator,
+    function: &Function,
     params: &[String],
-    param_types: &[Option<TypeAnnotation>],
-    return_type: &Option<TypeAnnotation>,
     body: &AstNode,
     closure_env: &std::rc::Rc<std::cell::RefCell<achronyme_types::Environment>>,
     args: Vec<Value>,
@@ -135,9 +161,8 @@ fn apply_lambda_regular(
     *evaluator.environment_mut() = closure_env.borrow().clone();
 
     // Inject the current function as 'rec' for recursive calls
-    // We need to reconstruct the function for rec binding
-    let function = Function::new_typed(params.to_vec(), param_types.to_vec(), return_type.clone(), body.clone(), closure_env.clone());
-    evaluator.environment_mut().define("rec".to_string(), Value::Function(function))?;
+    // (cloning the function shares its body instead of copying the AST)
+    evaluator.environment_mut().define("rec".to_string(), Value::from(function.clone()))?;
 
     // If 'self' was available in the calling context, inject it (for record methods)
     if let Some(self_val) = self_value {
@@ -188,7 +213,7 @@ fn apply_lambda_tco(
     *evaluator.environment_mut() = closure_env.borrow().clone();
 
     // Inject 'rec' for recursive calls
-    evaluator.environment_mut().define("rec".to_string(), Value::Function(function.clone()))?;
+    evaluator.environment_mut().define("rec".to_string(), Value::from(function.clone()))?;
 
     // Inject 'self' if available
     if let Some(self_val) = self_value {
@@ -208,8 +233,12 @@ fn apply_lambda_tco(
             evaluator.environment_mut().define(param.clone(), arg.clone())?;
         }
 
-        // Evaluate the body with TCO mode enabled
-        let value = evaluator.evaluate(body)?;
+        // Evaluate the body with TCO mode enabled; on error, still leave
+        // TCO mode and restore the caller's environment below
+        let value = match evaluator.evaluate(body) {
+            Ok(value) => value,
+            Err(err) => break Err(err),
+        };
 
         // Pop parameter scope
         evaluator.environment_mut().pop_scope();
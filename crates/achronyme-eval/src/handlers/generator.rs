@@ -0,0 +1,240 @@
+//! Generator bodies as resumable programs
+//!
+//! `lower` turns a `generate { ... }` body into the flat op list stored in
+//! `GeneratorState` (see `achronyme_types::generator`): statements without a
+//! `yield` stay whole, while the blocks, `while` and `if` statements and
+//! for-in loops that contain one become scope ops and jumps. `run` executes
+//! ops from the saved program counter until the next yield, so a yield in
+//! the middle of a loop resumes exactly where it left off.
+//!
+//! A yield nested in any other construct (a `try` block, a `match` arm)
+//! still suspends the generator, but the rest of that construct is skipped
+//! when it resumes.
+
+use achronyme_parser::ast::AstNode;
+use achronyme_types::generator::{GeneratorIterator, GeneratorOp};
+use achronyme_types::value::{GeneratorState, Value};
+use std::cell::RefCell;
+use std::rc::Rc;
+
+use crate::evaluator::Evaluator;
+
+use super::control_flow::value_to_bool;
+
+/// Outcome of resuming a generator
+pub(crate) enum Resumed {
+    /// Suspended at a yield with this value
+    Yielded(Value),
+    /// Finished, now or earlier, with this (sticky) return value
+    Returned(Value),
+}
+
+/// Lower a generator body into its resumable program
+pub(crate) fn lower(statements: &[AstNode]) -> Rc<[GeneratorOp]> {
+    let mut ops = Vec::new();
+    for statement in statements {
+        lower_statement(statement, &mut ops);
+    }
+    ops.into()
+}
+
+fn lower_statement(node: &AstNode, ops: &mut Vec<GeneratorOp>) {
+    if !contains_yield(node) {
+        ops.push(GeneratorOp::Eval(node.clone()));
+        return;
+    }
+
+    match node {
+        AstNode::Yield { value } => ops.push(GeneratorOp::Yield((**value).clone())),
+        AstNode::Sequence { statements } | AstNode::DoBlock { statements } => {
+            ops.push(GeneratorOp::PushScope);
+            for statement in statements {
+                lower_statement(statement, ops);
+            }
+            ops.push(GeneratorOp::PopScope);
+        }
+        AstNode::WhileLoop { condition, body } => {
+            let test = ops.len();
+            ops.push(GeneratorOp::JumpUnless { condition: (**condition).clone(), target: 0 });
+            lower_statement(body, ops);
+            ops.push(GeneratorOp::Jump(test));
+            patch_to_here(ops, test);
+        }
+        AstNode::If { condition, then_expr, else_expr } => {
+            let test = ops.len();
+            ops.push(GeneratorOp::JumpUnless { condition: (**condition).clone(), target: 0 });
+            lower_statement(then_expr, ops);
+            let skip_else = ops.len();
+            ops.push(GeneratorOp::Jump(0));
+            patch_to_here(ops, test);
+            lower_statement(else_expr, ops);
+            patch_to_here(ops, skip_else);
+        }
+        AstNode::ForInLoop { variable, iterable, body } => {
+            // One scope for the loop variable, as in evaluate_for_in
+            ops.push(GeneratorOp::IterStart((**iterable).clone()));
+            ops.push(GeneratorOp::PushScope);
+            let next = ops.len();
+            ops.push(GeneratorOp::IterNext { variable: variable.clone(), exit: 0 });
+            lower_statement(body, ops);
+            ops.push(GeneratorOp::Jump(next));
+            patch_to_here(ops, next);
+            ops.push(GeneratorOp::PopScope);
+        }
+        _ => ops.push(GeneratorOp::Eval(node.clone())),
+    }
+}
+
+/// Point the jump at `at` to the next op to be emitted
+fn patch_to_here(ops: &mut [GeneratorOp], at: usize) {
+    let target = ops.len();
+    match &mut ops[at] {
+        GeneratorOp::JumpUnless { target: t, .. } | GeneratorOp::IterNext { exit: t, .. } => *t = target,
+        GeneratorOp::Jump(t) => *t = target,
+        _ => unreachable!("only jumps are patched"),
+    }
+}
+
+/// Does a statement yield from this generator? Lambdas and nested generate
+/// blocks are their own bodies, so they are not searched.
+fn contains_yield(node: &AstNode) -> bool {
+    match node {
+        AstNode::Yield { .. } => true,
+        AstNode::Sequence { statements } | AstNode::DoBlock { statements } => {
+            statements.iter().any(contains_yield)
+        }
+        AstNode::WhileLoop { body, .. } | AstNode::ForInLoop { body, .. } => contains_yield(body),
+        AstNode::If { then_expr, else_expr, .. } => contains_yield(then_expr) || contains_yield(else_expr),
+        AstNode::TryCatch { try_block, catch_block, .. } => {
+            contains_yield(try_block) || contains_yield(catch_block)
+        }
+        AstNode::Match { arms, .. } => arms.iter().any(|arm| contains_yield(&arm.body)),
+        _ => false,
+    }
+}
+
+/// Resume a generator until its next yield or return
+///
+/// The generator's environment is swapped in for the evaluator's, not
+/// copied: it keeps the generator's variables and open block scopes between
+/// resumes.
+pub(crate) fn resume(evaluator: &mut Evaluator, gen: &Rc<RefCell<GeneratorState>>) -> Result<Resumed, String> {
+    let mut state = gen.borrow_mut();
+
+    // If already done, return sticky value
+    if state.done {
+        let return_val = state.return_value.as_ref().map(|v| (**v).clone()).unwrap_or(Value::Null);
+        return Ok(Resumed::Returned(return_val));
+    }
+
+    let state = &mut *state;
+    std::mem::swap(evaluator.environment_mut(), &mut state.env);
+
+    // Save and set generator context
+    let saved_in_generator = evaluator.in_generator;
+    evaluator.in_generator = true;
+
+    let result = run(evaluator, state);
+
+    evaluator.in_generator = saved_in_generator;
+    std::mem::swap(evaluator.environment_mut(), &mut state.env);
+
+    result
+}
+
+/// Next yielded value of a generator, or None once it has returned
+pub(crate) fn next_value(evaluator: &mut Evaluator, gen: &Rc<RefCell<GeneratorState>>) -> Result<Option<Value>, String> {
+    match resume(evaluator, gen)? {
+        Resumed::Yielded(value) => Ok(Some(value)),
+        Resumed::Returned(_) => Ok(None),
+    }
+}
+
+/// Run ops from the saved program counter to the next yield, return or the
+/// end of the body; the evaluator must already be in the generator's env
+fn run(evaluator: &mut Evaluator, state: &mut GeneratorState) -> Result<Resumed, String> {
+    let program = state.program.clone();
+
+    while let Some(op) = program.get(state.pc) {
+        state.pc += 1;
+
+        match op {
+            GeneratorOp::Eval(statement) => match evaluator.evaluate(statement)? {
+                // A yield inside a construct that was not lowered
+                Value::GeneratorYield(yielded) => return Ok(Resumed::Yielded(*yielded)),
+                Value::EarlyReturn(inner) => {
+                    state.mark_done(Some((*inner).clone()));
+                    return Ok(Resumed::Returned(*inner));
+                }
+                _ => {}
+            },
+            GeneratorOp::Yield(value) => return Ok(Resumed::Yielded(evaluator.evaluate(value)?)),
+            GeneratorOp::JumpUnless { condition, target } => {
+                let cond_val = evaluator.evaluate(condition)?;
+                if !value_to_bool(&cond_val)? {
+                    state.pc = *target;
+                }
+            }
+            GeneratorOp::Jump(target) => state.pc = *target,
+            GeneratorOp::PushScope => evaluator.environment_mut().push_scope(),
+            GeneratorOp::PopScope => evaluator.environment_mut().pop_scope(),
+            GeneratorOp::IterStart(iterable) => {
+                let iterator = match evaluator.evaluate(iterable)? {
+                    Value::Record(map) => match map.get("next") {
+                        Some(Value::Function(next)) => GeneratorIterator::Next(next.clone()),
+                        Some(_) => return Err("next must be a function".to_string()),
+                        None => return Err("Iterable must have a 'next' method".to_string()),
+                    },
+                    Value::Generator(gen) => GeneratorIterator::Generator(gen),
+                    Value::Sequence(_) => {
+                        return Err(
+                            "for-in over a sequence cannot yield inside a generator; collect() it first".to_string(),
+                        )
+                    }
+                    _ => {
+                        return Err("for-in requires an iterable (object with next method, generator or sequence)".to_string())
+                    }
+                };
+                state.iterators.push(iterator);
+            }
+            GeneratorOp::IterNext { variable, exit } => {
+                let item = match state.iterators.last() {
+                    Some(GeneratorIterator::Next(next)) => {
+                        let result = evaluator.apply_lambda(next, vec![])?;
+                        next_item(&result)?
+                    }
+                    Some(GeneratorIterator::Generator(gen)) => next_value(evaluator, gen)?,
+                    None => return Err("for-in iterator missing from generator state".to_string()),
+                };
+                match item {
+                    Some(item) => evaluator.environment_mut().define(variable.clone(), item)?,
+                    None => {
+                        state.iterators.pop();
+                        state.pc = *exit;
+                    }
+                }
+            }
+        }
+    }
+
+    // Generator exhausted naturally (no explicit return)
+    state.mark_done(Some(Value::Null));
+    Ok(Resumed::Returned(Value::Null))
+}
+
+/// Item of an iterator result record, or None once it is done
+pub(crate) fn next_item(result: &Value) -> Result<Option<Value>, String> {
+    let record = match result {
+        Value::Record(map) => map,
+        _ => return Err("next() must return {value: T, done: Boolean}".to_string()),
+    };
+    match record.get("done") {
+        Some(Value::Boolean(true)) => Ok(None),
+        Some(Value::Boolean(false)) => record
+            .get("value")
+            .cloned()
+            .map(Some)
+            .ok_or_else(|| "next() must return {value: T}".to_string()),
+        _ => Err("next() must return {done: Boolean}".to_string()),
+    }
+}
@@ -1,16 +1,23 @@
 use achronyme_parser::ast::AstNode;
+use achronyme_types::function::Function;
+use achronyme_types::sequence::SequenceStage;
 use achronyme_types::value::Value;
 
 use crate::evaluator::Evaluator;
 
+use super::sequence::{filter_predicate, finish, map_function, sequence_of, truthy, Pull};
+
 /// Higher-Order Functions Handler
 ///
 /// This module contains implementations of:
 /// - map, filter, reduce, pipe (original HOFs)
 /// - any, all, find, findIndex, count (Tier 2 predicates)
+///
+/// Single-collection HOFs read their collection through a `sequence::Pull`,
+/// so nested map / filter / range calls fuse into one loop.
 
 /// Helper: Convert a collection (Vector, Tensor, or ComplexTensor) to Vec<Value>
-fn collection_to_vec(collection: Value) -> Result<Vec<Value>, String> {
+pub(crate) fn collection_to_vec(collection: Value) -> Result<Vec<Value>, String> {
     match collection {
         Value::Vector(v) => Ok(v),
         Value::Tensor(t) => {
@@ -31,13 +38,22 @@ fn collection_to_vec(collection: Value) -> Result<Vec<Value>, String> {
 ///   map(f, [1,2,3]) → applies f(x) to each element
 ///   map(f, [1,2], [3,4]) → applies f(x,y) to pairs
 ///
-/// Supports Vector, Tensor, and ComplexTensor.
+/// Supports Vector, Tensor, ComplexTensor, generators and sequences.
 /// Truncates to shortest collection.
+///
+/// With one collection the result is lazy when the collection is (a
+/// generator or sequence) and a Vector otherwise.
 pub fn handle_map(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value, String> {
     if args.len() < 2 {
         return Err("map requires at least 2 arguments: function and collection(s)".to_string());
     }
 
+    if args.len() == 2 {
+        let func = map_function(evaluator, &args[0])?;
+        let (sequence, lazy) = sequence_of(evaluator, &args[1])?;
+        return finish(evaluator, sequence.then(SequenceStage::Map(func)), lazy);
+    }
+
     // Evaluate first argument (must be a function)
     let func_value = evaluator.evaluate(&args[0])?;
     let func = match func_value {
@@ -53,6 +69,15 @@ pub fn handle_map(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value,
         collections.push(vec);
     }
 
+    map_collections(evaluator, &func, collections)
+}
+
+/// Apply `func` element-wise across already-evaluated collections
+pub(crate) fn map_collections(
+    evaluator: &mut Evaluator,
+    func: &Function,
+    collections: Vec<Vec<Value>>,
+) -> Result<Value, String> {
     // Check arity matches number of collections
     if func.arity() != collections.len() {
         return Err(format!(
@@ -75,7 +100,7 @@ pub fn handle_map(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value,
         }
 
         // Apply function
-        let result = evaluator.apply_lambda(&func, func_args)?;
+        let result = evaluator.apply_lambda(func, func_args)?;
         results.push(result);
     }
 
@@ -86,32 +111,28 @@ pub fn handle_map(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value,
 /// filter(predicate, collection) - Filter elements
 ///
 /// Returns elements where predicate returns true (non-zero).
-/// Supports Vector, Tensor, and ComplexTensor.
+/// Supports Vector, Tensor, ComplexTensor, generators and sequences; the
+/// result is lazy when the collection is.
 pub fn handle_filter(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value, String> {
     if args.len() != 2 {
         return Err("filter requires 2 arguments: predicate and collection".to_string());
     }
 
-    // Evaluate first argument (must be a function)
-    let predicate_value = evaluator.evaluate(&args[0])?;
-    let predicate = match predicate_value {
-        Value::Function(f) => f,
-        _ => return Err("First argument to filter must be a function".to_string()),
-    };
-
-    // Predicate must be unary
-    if predicate.arity() != 1 {
-        return Err("filter predicate must take exactly 1 argument".to_string());
-    }
-
-    // Evaluate second argument (collection)
-    let collection_value = evaluator.evaluate(&args[1])?;
-    let collection = collection_to_vec(collection_value)?;
+    let predicate = filter_predicate(evaluator, &args[0])?;
+    let (sequence, lazy) = sequence_of(evaluator, &args[1])?;
+    finish(evaluator, sequence.then(SequenceStage::Filter(predicate)), lazy)
+}
 
+/// Keep the elements of an already-evaluated collection that satisfy `predicate`
+pub(crate) fn filter_collection(
+    evaluator: &mut Evaluator,
+    predicate: &Function,
+    collection: Vec<Value>,
+) -> Result<Value, String> {
     let mut results = Vec::new();
     for elem in collection {
         // Apply predicate
-        let result = evaluator.apply_lambda(&predicate, vec![elem.clone()])?;
+        let result = evaluator.apply_lambda(predicate, vec![elem.clone()])?;
 
         // Check result (boolean or non-zero number = true)
         let should_include = match result {
@@ -131,7 +152,7 @@ pub fn handle_filter(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Valu
 /// reduce(f, init, collection) - Reduce collection to single value
 ///
 /// Applies f(accumulator, element) repeatedly.
-/// Supports Vector, Tensor, and ComplexTensor.
+/// Supports Vector, Tensor, ComplexTensor, generators and sequences.
 /// Initial value can be any type.
 pub fn handle_reduce(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value, String> {
     if args.len() != 3 {
@@ -153,12 +174,25 @@ pub fn handle_reduce(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Valu
     // Evaluate second argument (initial value)
     let mut accumulator = evaluator.evaluate(&args[1])?;
 
-    // Evaluate third argument (collection)
-    let collection_value = evaluator.evaluate(&args[2])?;
-    let collection = collection_to_vec(collection_value)?;
+    // Fold the collection as it is pulled
+    let (sequence, _) = sequence_of(evaluator, &args[2])?;
+    let mut pull = Pull::new(&sequence);
+    while let Some(elem) = pull.next(evaluator)? {
+        accumulator = evaluator.apply_lambda(&func, vec![accumulator, elem])?;
+    }
 
+    Ok(accumulator)
+}
+
+/// Fold an already-evaluated collection onto `accumulator` with `func`
+pub(crate) fn reduce_collection(
+    evaluator: &mut Evaluator,
+    func: &Function,
+    mut accumulator: Value,
+    collection: Vec<Value>,
+) -> Result<Value, String> {
     for elem in collection {
-        let result = evaluator.apply_lambda(&func, vec![accumulator, elem])?;
+        let result = evaluator.apply_lambda(func, vec![accumulator, elem])?;
         accumulator = result;
     }
 
@@ -202,6 +236,9 @@ pub fn handle_pipe(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value,
 // Tier 2: Predicate Functions
 // ============================================================================
 
+/// Error when a predicate returns neither a boolean nor a number
+const PREDICATE_RESULT_ERROR: &str = "Predicate must return boolean or number";
+
 /// any(collection, predicate) - Check if any element satisfies predicate
 ///
 /// Returns true if at least one element matches, false otherwise.
@@ -217,8 +254,8 @@ pub fn handle_any(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value,
     }
 
     // Evaluate collection
-    let coll_value = evaluator.evaluate(&args[0])?;
-    let collection = collection_to_vec(coll_value)?;
+    let (sequence, _) = sequence_of(evaluator, &args[0])?;
+    let mut collection = Pull::new(&sequence);
 
     // Evaluate predicate (must be a function)
     let predicate_value = evaluator.evaluate(&args[1])?;
@@ -233,18 +270,10 @@ pub fn handle_any(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value,
     }
 
     // Test each element (short-circuit on first true)
-    for item in collection {
+    while let Some(item) = collection.next(evaluator)? {
         let result = evaluator.apply_lambda(&predicate, vec![item])?;
-        match result {
-            Value::Boolean(true) => return Ok(Value::Boolean(true)),
-            Value::Boolean(false) => continue,
-            Value::Number(n) => {
-                // Truthiness: non-zero is true
-                if n != 0.0 {
-                    return Ok(Value::Boolean(true));
-                }
-            }
-            _ => return Err("Predicate must return boolean or number".to_string()),
+        if truthy(&result, PREDICATE_RESULT_ERROR)? {
+            return Ok(Value::Boolean(true));
         }
     }
 
@@ -267,8 +296,8 @@ pub fn handle_all(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value,
     }
 
     // Evaluate collection
-    let coll_value = evaluator.evaluate(&args[0])?;
-    let collection = collection_to_vec(coll_value)?;
+    let (sequence, _) = sequence_of(evaluator, &args[0])?;
+    let mut collection = Pull::new(&sequence);
 
     // Evaluate predicate (must be a function)
     let predicate_value = evaluator.evaluate(&args[1])?;
@@ -283,18 +312,10 @@ pub fn handle_all(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value,
     }
 
     // Test each element (short-circuit on first false)
-    for item in collection {
+    while let Some(item) = collection.next(evaluator)? {
         let result = evaluator.apply_lambda(&predicate, vec![item])?;
-        match result {
-            Value::Boolean(false) => return Ok(Value::Boolean(false)),
-            Value::Boolean(true) => continue,
-            Value::Number(n) => {
-                // Truthiness: zero is false
-                if n == 0.0 {
-                    return Ok(Value::Boolean(false));
-                }
-            }
-            _ => return Err("Predicate must return boolean or number".to_string()),
+        if !truthy(&result, PREDICATE_RESULT_ERROR)? {
+            return Ok(Value::Boolean(false));
         }
     }
 
@@ -314,8 +335,8 @@ pub fn handle_find(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value,
     }
 
     // Evaluate collection
-    let coll_value = evaluator.evaluate(&args[0])?;
-    let collection = collection_to_vec(coll_value)?;
+    let (sequence, _) = sequence_of(evaluator, &args[0])?;
+    let mut collection = Pull::new(&sequence);
 
     // Evaluate predicate (must be a function)
     let predicate_value = evaluator.evaluate(&args[1])?;
@@ -330,18 +351,10 @@ pub fn handle_find(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value,
     }
 
     // Find first matching element
-    for item in collection {
+    while let Some(item) = collection.next(evaluator)? {
         let result = evaluator.apply_lambda(&predicate, vec![item.clone()])?;
-        match result {
-            Value::Boolean(true) => return Ok(item),
-            Value::Boolean(false) => continue,
-            Value::Number(n) => {
-                // Truthiness: non-zero is true
-                if n != 0.0 {
-                    return Ok(item);
-                }
-            }
-            _ => return Err("Predicate must return boolean or number".to_string()),
+        if truthy(&result, PREDICATE_RESULT_ERROR)? {
+            return Ok(item);
         }
     }
 
@@ -361,8 +374,8 @@ pub fn handle_find_index(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<
     }
 
     // Evaluate collection
-    let coll_value = evaluator.evaluate(&args[0])?;
-    let collection = collection_to_vec(coll_value)?;
+    let (sequence, _) = sequence_of(evaluator, &args[0])?;
+    let mut collection = Pull::new(&sequence);
 
     // Evaluate predicate (must be a function)
     let predicate_value = evaluator.evaluate(&args[1])?;
@@ -377,19 +390,13 @@ pub fn handle_find_index(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<
     }
 
     // Find first matching index
-    for (index, item) in collection.iter().enumerate() {
-        let result = evaluator.apply_lambda(&predicate, vec![item.clone()])?;
-        match result {
-            Value::Boolean(true) => return Ok(Value::Number(index as f64)),
-            Value::Boolean(false) => continue,
-            Value::Number(n) => {
-                // Truthiness: non-zero is true
-                if n != 0.0 {
-                    return Ok(Value::Number(index as f64));
-                }
-            }
-            _ => return Err("Predicate must return boolean or number".to_string()),
+    let mut index = 0;
+    while let Some(item) = collection.next(evaluator)? {
+        let result = evaluator.apply_lambda(&predicate, vec![item])?;
+        if truthy(&result, PREDICATE_RESULT_ERROR)? {
+            return Ok(Value::Number(index as f64));
         }
+        index += 1;
     }
 
     Ok(Value::Number(-1.0)) // Not found
@@ -408,8 +415,8 @@ pub fn handle_count(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value
     }
 
     // Evaluate collection
-    let coll_value = evaluator.evaluate(&args[0])?;
-    let collection = collection_to_vec(coll_value)?;
+    let (sequence, _) = sequence_of(evaluator, &args[0])?;
+    let mut collection = Pull::new(&sequence);
 
     // Evaluate predicate (must be a function)
     let predicate_value = evaluator.evaluate(&args[1])?;
@@ -425,18 +432,10 @@ pub fn handle_count(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value
 
     // Count matching elements
     let mut count = 0;
-    for item in collection {
+    while let Some(item) = collection.next(evaluator)? {
         let result = evaluator.apply_lambda(&predicate, vec![item])?;
-        match result {
-            Value::Boolean(true) => count += 1,
-            Value::Boolean(false) => continue,
-            Value::Number(n) => {
-                // Truthiness: non-zero is true
-                if n != 0.0 {
-                    count += 1;
-                }
-            }
-            _ => return Err("Predicate must return boolean or number".to_string()),
+        if truthy(&result, PREDICATE_RESULT_ERROR)? {
+            count += 1;
         }
     }
 
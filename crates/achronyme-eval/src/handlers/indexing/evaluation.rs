@@ -27,12 +27,17 @@ pub fn evaluate_index_access(
         evaluated_indices.push(evaluate_index_arg(evaluator, idx)?);
     }
 
+    index_value(&obj_value, &evaluated_indices)
+}
+
+/// Apply already evaluated indices to a value
+pub(crate) fn index_value(obj_value: &Value, evaluated_indices: &[EvaluatedIndex]) -> Result<Value, String> {
     // Apply the indexing based on the object type
     match obj_value {
-        Value::Vector(ref vec) => index_vector(vec, &evaluated_indices),
-        Value::Tensor(ref tensor) => index_tensor(tensor, &evaluated_indices),
-        Value::ComplexTensor(ref tensor) => index_complex_tensor(tensor, &evaluated_indices),
-        Value::String(ref s) => index_string(s, &evaluated_indices),
+        Value::Vector(vec) => index_vector(vec, evaluated_indices),
+        Value::Tensor(tensor) => index_tensor(tensor, evaluated_indices),
+        Value::ComplexTensor(tensor) => index_complex_tensor(tensor, evaluated_indices),
+        Value::String(s) => index_string(s, evaluated_indices),
         _ => Err(format!("Cannot index into {:?}", obj_value)),
     }
 }
@@ -45,36 +50,39 @@ fn evaluate_index_arg(
     match arg {
         IndexArg::Single(expr) => {
             let value = evaluator.evaluate(expr)?;
-            match value {
-                Value::Number(n) => {
-                    let idx = n as isize;
-                    Ok(EvaluatedIndex::Single(idx))
-                }
-                _ => Err("Index must be a number".to_string()),
-            }
+            single_index(&value)
         }
         IndexArg::Range { start, end } => {
-            let start_idx = if let Some(start_expr) = start {
-                let value = evaluator.evaluate(start_expr)?;
-                match value {
-                    Value::Number(n) => Some(n as isize),
-                    _ => return Err("Range start must be a number".to_string()),
-                }
-            } else {
-                None
+            let start_value = match start {
+                Some(start_expr) => Some(evaluator.evaluate(start_expr)?),
+                None => None,
             };
+            let start_idx = range_bound(start_value.as_ref(), "start")?;
 
-            let end_idx = if let Some(end_expr) = end {
-                let value = evaluator.evaluate(end_expr)?;
-                match value {
-                    Value::Number(n) => Some(n as isize),
-                    _ => return Err("Range end must be a number".to_string()),
-                }
-            } else {
-                None
+            let end_value = match end {
+                Some(end_expr) => Some(evaluator.evaluate(end_expr)?),
+                None => None,
             };
+            let end_idx = range_bound(end_value.as_ref(), "end")?;
 
             Ok(EvaluatedIndex::Range { start: start_idx, end: end_idx })
         }
     }
 }
+
+/// Convert the value of a single index argument
+pub(crate) fn single_index(value: &Value) -> Result<EvaluatedIndex, String> {
+    match value {
+        Value::Number(n) => Ok(EvaluatedIndex::Single(*n as isize)),
+        _ => Err("Index must be a number".to_string()),
+    }
+}
+
+/// Convert the value of an optional range bound (`which` is "start" or "end")
+pub(crate) fn range_bound(value: Option<&Value>, which: &str) -> Result<Option<isize>, String> {
+    match value {
+        Some(Value::Number(n)) => Ok(Some(*n as isize)),
+        Some(_) => Err(format!("Range {} must be a number", which)),
+        None => Ok(None),
+    }
+}
@@ -24,3 +24,5 @@ mod tensor;
 
 // Re-export the public API
 pub use evaluation::evaluate_index_access;
+pub(crate) use evaluation::{index_value, range_bound, single_index};
+pub(crate) use types::EvaluatedIndex;
@@ -58,138 +58,63 @@ fn index_complex_tensor_element(tensor: &ComplexTensor, indices: &[EvaluatedInde
 }
 
 /// Extract a sub-tensor from complex tensor by fixing some dimensions
+///
+/// Fixing leading dimensions selects a contiguous block, so tensor results
+/// share the source tensor's storage.
 fn extract_complex_subtensor(tensor: &ComplexTensor, fixed_coords: &[usize]) -> Result<Value, String> {
-    let shape = tensor.shape();
-
-    // Calculate the shape of the result (remaining dimensions)
-    let result_shape: Vec<usize> = shape[fixed_coords.len()..].to_vec();
-
-    // Calculate how many elements we need
-    let result_size: usize = result_shape.iter().product();
-    let mut result_data = Vec::with_capacity(result_size);
-
-    // Generate all combinations for the remaining dimensions
-    let mut remaining_coords = vec![0; result_shape.len()];
-
-    loop {
-        // Build full coordinates
-        let mut full_coords = fixed_coords.to_vec();
-        full_coords.extend_from_slice(&remaining_coords);
-
-        // Get the element
-        match tensor.get(&full_coords) {
-            Ok(&val) => result_data.push(val),
-            Err(e) => return Err(format!("Invalid coordinates {:?} for tensor: {}", full_coords, e)),
-        }
-
-        // Increment remaining_coords
-        let mut carry = true;
-        for i in (0..remaining_coords.len()).rev() {
-            if carry {
-                remaining_coords[i] += 1;
-                if remaining_coords[i] < result_shape[i] {
-                    carry = false;
-                } else {
-                    remaining_coords[i] = 0;
-                }
-            }
-        }
-
-        if carry {
-            break; // We've iterated through all combinations
-        }
+    let mut view = tensor.view();
+    for &coord in fixed_coords {
+        view = view
+            .index_axis(0, coord)
+            .map_err(|e| format!("Invalid coordinates {:?} for tensor: {}", fixed_coords, e))?;
     }
 
-    // Create the result tensor
-    if result_shape.len() == 1 {
+    if view.rank() == 1 {
         // Return as vector for 1D
-        Ok(Value::Vector(result_data.iter().map(|&c| Value::Complex(c)).collect()))
+        Ok(Value::Vector(view.iter().map(|&c| Value::Complex(c)).collect()))
     } else {
-        ComplexTensor::new(result_data, result_shape)
-            .map(Value::ComplexTensor)
-            .map_err(|e| format!("Failed to create subtensor: {}", e))
+        Ok(Value::ComplexTensor(Box::new(view.to_tensor())))
     }
 }
 
 /// Slice a complex tensor
+///
+/// Each index narrows a strided view in O(1); only 1D and non-contiguous
+/// results copy elements.
 fn slice_complex_tensor(tensor: &ComplexTensor, indices: &[EvaluatedIndex]) -> Result<Value, String> {
     let shape = tensor.shape();
+    let mut view = tensor.view();
+    // Axis of `view` the next index applies to: single indices drop theirs
+    let mut axis = 0;
 
-    // Build ranges for each dimension
-    let mut ranges = Vec::new();
     for (i, idx) in indices.iter().enumerate() {
-        match idx {
+        let narrowed = match idx {
             EvaluatedIndex::Single(n) => {
                 let actual = normalize_index(*n, shape[i])?;
-                ranges.push((actual, actual + 1));
+                view.index_axis(axis, actual)
             }
             EvaluatedIndex::Range { start, end } => {
                 let (s, e) = normalize_range(*start, *end, shape[i])?;
-                ranges.push((s, e));
+                axis += 1;
+                view.slice_axis(axis - 1, s, e)
             }
-        }
-    }
-
-    // Add full ranges for remaining dimensions
-    for i in indices.len()..shape.len() {
-        ranges.push((0, shape[i]));
-    }
-
-    // Calculate result shape (exclude single-index dimensions)
-    let mut result_shape = Vec::new();
-    for (i, idx) in indices.iter().enumerate() {
-        if let EvaluatedIndex::Range { .. } = idx {
-            result_shape.push(ranges[i].1 - ranges[i].0);
-        }
-    }
-    // Add remaining full dimensions
-    for i in indices.len()..shape.len() {
-        result_shape.push(ranges[i].1 - ranges[i].0);
-    }
-
-    // Extract data
-    let result_size: usize = result_shape.iter().product();
-    let mut result_data = Vec::with_capacity(result_size);
-
-    // Generate coordinates within the ranges
-    let mut coords = ranges.iter().map(|(s, _)| *s).collect::<Vec<_>>();
-
-    loop {
-        // Get element at current coordinates
-        match tensor.get(&coords) {
-            Ok(&val) => result_data.push(val),
-            Err(e) => return Err(format!("Invalid coordinates {:?} for tensor: {}", coords, e)),
-        }
-
-        // Increment coordinates
-        let mut carry = true;
-        for i in (0..coords.len()).rev() {
-            if carry {
-                coords[i] += 1;
-                if coords[i] < ranges[i].1 {
-                    carry = false;
-                } else {
-                    coords[i] = ranges[i].0;
-                }
-            }
-        }
-
-        if carry {
-            break;
-        }
+        };
+        view = narrowed.map_err(|e| format!("Invalid slice of tensor with shape {:?}: {}", shape, e))?;
     }
 
     // Create result
+    let result_shape = view.shape();
     if result_shape.is_empty() || (result_shape.len() == 1 && result_shape[0] == 1) {
         // Single element
-        Ok(Value::Complex(result_data[0]))
+        view.iter()
+            .next()
+            .map(|&c| Value::Complex(c))
+            .ok_or_else(|| "Slice produced no elements".to_string())
     } else if result_shape.len() == 1 {
         // Vector
-        Ok(Value::Vector(result_data.iter().map(|&c| Value::Complex(c)).collect()))
+        Ok(Value::Vector(view.iter().map(|&c| Value::Complex(c)).collect()))
     } else {
         // Tensor
-        ComplexTensor::new(result_data, result_shape)
-            .map(Value::ComplexTensor)
-            .map_err(|e| format!("Failed to create sliced tensor: {}", e))
+        Ok(Value::ComplexTensor(Box::new(view.to_tensor())))
     }
 }
@@ -32,7 +32,7 @@ pub fn index_vector(vec: &[Value], indices: &[EvaluatedIndex]) -> Result<Value,
                         unreachable!()
                     }
                 }).collect();
-                return Ok(Value::Tensor(RealTensor::vector(nums)));
+                return Ok(Value::Tensor(Box::new(RealTensor::vector(nums))));
             }
 
             Ok(Value::Vector(slice.to_vec()))
@@ -2,6 +2,7 @@ use achronyme_parser::ast::AstNode;
 use achronyme_types::complex::Complex;
 use achronyme_types::tensor::RealTensor;
 use achronyme_types::value::Value;
+use achronyme_types::Symbol;
 
 use crate::evaluator::Evaluator;
 
@@ -34,6 +35,11 @@ pub fn evaluate_array(evaluator: &mut Evaluator, elements: &[achronyme_parser::a
         return Ok(Value::Vector(vec![]));
     }
 
+    // Data literals: rows of number literals go straight into a tensor
+    if let Some(value) = numeric_literal_array(elements) {
+        return value;
+    }
+
     // Evaluate ALL elements, expanding spreads
     let mut values = Vec::new();
     for element in elements {
@@ -44,27 +50,106 @@ pub fn evaluate_array(evaluator: &mut Evaluator, elements: &[achronyme_parser::a
             }
             ArrayElement::Spread(node) => {
                 let spread_value = evaluator.evaluate(node)?;
-                match spread_value {
-                    Value::Vector(vec) => {
-                        values.extend(vec);
-                    }
-                    Value::Tensor(tensor) => {
-                        if tensor.shape().len() == 1 {
-                            for &val in tensor.data() {
-                                values.push(Value::Number(val));
-                            }
-                        } else {
-                            return Err("Cannot spread multi-dimensional Tensor in array. Use concat() or reshape() instead.".to_string());
-                        }
-                    }
-                    _ => {
-                        return Err(format!("Cannot spread non-iterable value in array context. Got: {:?}", spread_value));
-                    }
+                spread_into(&mut values, spread_value)?;
+            }
+        }
+    }
+
+    build_array(values)
+}
+
+/// Value of a number literal, possibly negated (`-1` parses as `Negate(1)`)
+fn number_literal(node: &AstNode) -> Option<f64> {
+    use achronyme_parser::ast::UnaryOp;
+
+    match node {
+        AstNode::Number(n) => Some(*n),
+        AstNode::UnaryOp { op: UnaryOp::Negate, operand } => match **operand {
+            AstNode::Number(n) => Some(-n),
+            _ => None,
+        },
+        _ => None,
+    }
+}
+
+/// Numbers of an array literal made only of number literals
+fn number_literals(elements: &[achronyme_parser::ast::ArrayElement]) -> Option<Vec<f64>> {
+    use achronyme_parser::ast::ArrayElement;
+
+    elements
+        .iter()
+        .map(|element| match element {
+            ArrayElement::Single(node) => number_literal(node),
+            ArrayElement::Spread(_) => None,
+        })
+        .collect()
+}
+
+/// Fast path of `evaluate_array` for literals of plain numbers
+///
+/// `[1, 2, 3]` and `[[1, 2], [3, 4]]` get the same values `build_array` would
+/// give them, without evaluating every element into a `Value` first; large
+/// matrices are filled directly into the tensor's buffer. Returns `None` for
+/// anything else (an element that is not a number literal, ragged rows, ...).
+fn numeric_literal_array(elements: &[achronyme_parser::ast::ArrayElement]) -> Option<Result<Value, String>> {
+    use achronyme_parser::ast::ArrayElement;
+
+    if let Some(numbers) = number_literals(elements) {
+        return Some(Ok(Value::Vector(numbers.into_iter().map(Value::Number).collect())));
+    }
+
+    let mut cols = None;
+    let mut data = Vec::new();
+    for element in elements {
+        let row = match element {
+            ArrayElement::Single(AstNode::ArrayLiteral(row)) => row,
+            _ => return None,
+        };
+        if row.is_empty() || *cols.get_or_insert(row.len()) != row.len() {
+            return None;
+        }
+        if data.is_empty() {
+            data.reserve(elements.len() * row.len());
+        }
+        for element in row {
+            match element {
+                ArrayElement::Single(node) => data.push(number_literal(node)?),
+                ArrayElement::Spread(_) => return None,
+            }
+        }
+    }
+
+    let shape = vec![elements.len(), cols?];
+    Some(RealTensor::new(data, shape).map(Value::from).map_err(|e| e.to_string()))
+}
+
+/// Expand a spread element (`...expr`) of an array literal into `values`
+pub(crate) fn spread_into(values: &mut Vec<Value>, spread_value: Value) -> Result<(), String> {
+    match spread_value {
+        Value::Vector(vec) => {
+            values.extend(vec);
+        }
+        Value::Tensor(tensor) => {
+            if tensor.shape().len() == 1 {
+                for &val in tensor.data() {
+                    values.push(Value::Number(val));
                 }
+            } else {
+                return Err("Cannot spread multi-dimensional Tensor in array. Use concat() or reshape() instead.".to_string());
             }
         }
+        _ => {
+            return Err(format!("Cannot spread non-iterable value in array context. Got: {:?}", spread_value));
+        }
     }
+    Ok(())
+}
 
+/// Build the value of an array literal from its (already spread) elements
+///
+/// Applies the same promotions as array literals: tensors of tensors, numeric
+/// vectors of vectors to matrices, and number/complex promotion.
+pub(crate) fn build_array(values: Vec<Value>) -> Result<Value, String> {
     // Handle empty result after spreading
     if values.is_empty() {
         return Ok(Value::Vector(vec![]));
@@ -112,7 +197,8 @@ pub fn evaluate_array(evaluator: &mut Evaluator, elements: &[achronyme_parser::a
 
     // For simple arrays (even if all numbers), keep them as Vector for better UX
     // Only create Tensor when explicitly needed (matrices, multi-dimensional arrays)
-    // This ensures that [1, 2, 3] remains a Vector, not auto-promoted to Tensor
+    // This ensures that [1, 2, 3] remains a Vector, not auto-promoted to Tensor,
+    // whatever its length: a literal's type never depends on how many elements it has
 
     // Validate type homogeneity and apply type promotion for generic vectors
     validate_and_promote_vector(values)
@@ -186,7 +272,7 @@ fn combine_tensors_to_higher_dimension(tensors: Vec<Value>) -> Result<Value, Str
     new_shape.extend_from_slice(&first_shape);
 
     RealTensor::new(all_data, new_shape)
-        .map(Value::Tensor)
+        .map(Value::from)
         .map_err(|e| e.to_string())
 }
 
@@ -233,7 +319,7 @@ fn convert_vector_of_vectors_to_tensor(vectors: Vec<Value>) -> Result<Value, Str
         }
 
         ComplexTensor::new(data, vec![num_rows, num_cols])
-            .map(Value::ComplexTensor)
+            .map(Value::from)
             .map_err(|e| e.to_string())
     } else {
         // Create real tensor
@@ -251,7 +337,7 @@ fn convert_vector_of_vectors_to_tensor(vectors: Vec<Value>) -> Result<Value, Str
         }
 
         RealTensor::new(data, vec![num_rows, num_cols])
-            .map(Value::Tensor)
+            .map(Value::from)
             .map_err(|e| e.to_string())
     }
 }
@@ -280,7 +366,7 @@ pub fn evaluate_record(evaluator: &mut Evaluator, fields: &[achronyme_parser::as
                 let spread_value = evaluator.evaluate(node)?;
                 match spread_value {
                     Value::Record(spread_record) => {
-                        for (key, value) in spread_record {
+                        for (key, value) in *spread_record {
                             record.insert(key, value);
                         }
                     }
@@ -292,15 +378,15 @@ pub fn evaluate_record(evaluator: &mut Evaluator, fields: &[achronyme_parser::as
         }
     }
 
-    Ok(Value::Record(record))
+    Ok(Value::Record(Box::new(record)))
 }
 
 /// Evaluate an edge literal
 /// Note: from and to are pure identifiers (strings), never evaluated as variables
 pub fn evaluate_edge(
     evaluator: &mut Evaluator,
-    from: &str,
-    to: &str,
+    from: Symbol,
+    to: Symbol,
     directed: bool,
     metadata: &Option<Box<AstNode>>,
 ) -> Result<Value, String> {
@@ -316,12 +402,12 @@ pub fn evaluate_edge(
             _ => return Err("Edge metadata must be a record".to_string()),
         }
     } else {
-        HashMap::new()
+        Box::new(HashMap::new())
     };
 
     Ok(Value::Edge {
-        from: from.to_string(),
-        to: to.to_string(),
+        from,
+        to,
         directed,
         properties,
     })
@@ -6,6 +6,8 @@
 pub mod binary_ops;
 pub mod unary_ops;
 pub mod hof;
+pub mod sequence;
+pub mod parallel;
 pub mod numerical;
 pub mod optimization;
 pub mod function_call;
@@ -16,6 +18,7 @@ pub mod literals;
 pub mod variables;
 pub mod assignment;
 pub mod control_flow;
+pub mod generator;
 pub mod functions;
 pub mod indexing;
 pub mod pattern_matching;
@@ -2,6 +2,7 @@ use achronyme_parser::ast::AstNode;
 use achronyme_types::value::Value;
 
 use crate::evaluator::Evaluator;
+use crate::native::NativeEvaluator;
 
 /// Numerical Calculus Handler
 ///
@@ -31,7 +32,7 @@ pub fn handle_diff(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value,
     };
 
     use achronyme_numerical::diff_central;
-    let result = diff_central(evaluator, &func, x, h)?;
+    let result = diff_central(&mut NativeEvaluator::new(evaluator), &func, x, h)?;
     Ok(Value::Number(result))
 }
 
@@ -58,7 +59,7 @@ pub fn handle_diff2(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value
     };
 
     use achronyme_numerical::diff2_central;
-    let result = diff2_central(evaluator, &func, x, h)?;
+    let result = diff2_central(&mut NativeEvaluator::new(evaluator), &func, x, h)?;
     Ok(Value::Number(result))
 }
 
@@ -85,7 +86,7 @@ pub fn handle_diff3(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value
     };
 
     use achronyme_numerical::diff3_central;
-    let result = diff3_central(evaluator, &func, x, h)?;
+    let result = diff3_central(&mut NativeEvaluator::new(evaluator), &func, x, h)?;
     Ok(Value::Number(result))
 }
 
@@ -122,7 +123,7 @@ pub fn handle_gradient(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Va
     };
 
     use achronyme_numerical::gradient as gradient_calc;
-    let result = gradient_calc(evaluator, &func, &point_vec, h)?;
+    let result = gradient_calc(&mut NativeEvaluator::new(evaluator), &func, &point_vec, h)?;
     Ok(Value::Vector(result.into_iter().map(Value::Number).collect()))
 }
 
@@ -154,7 +155,7 @@ pub fn handle_integral(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Va
     };
 
     use achronyme_numerical::trapz;
-    let result = trapz(evaluator, &func, a, b, n)?;
+    let result = trapz(&mut NativeEvaluator::new(evaluator), &func, a, b, n)?;
     Ok(Value::Number(result))
 }
 
@@ -186,7 +187,7 @@ pub fn handle_simpson(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Val
     };
 
     use achronyme_numerical::simpson;
-    let result = simpson(evaluator, &func, a, b, n)?;
+    let result = simpson(&mut NativeEvaluator::new(evaluator), &func, a, b, n)?;
     Ok(Value::Number(result))
 }
 
@@ -218,7 +219,7 @@ pub fn handle_romberg(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Val
     };
 
     use achronyme_numerical::romberg;
-    let result = romberg(evaluator, &func, a, b, tol, 20)?;
+    let result = romberg(&mut NativeEvaluator::new(evaluator), &func, a, b, tol, 20)?;
     Ok(Value::Number(result))
 }
 
@@ -245,7 +246,7 @@ pub fn handle_quad(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value,
     };
 
     use achronyme_numerical::quad;
-    let result = quad(evaluator, &func, a, b, 1e-10)?;
+    let result = quad(&mut NativeEvaluator::new(evaluator), &func, a, b, 1e-10)?;
     Ok(Value::Number(result))
 }
 
@@ -277,7 +278,7 @@ pub fn handle_solve(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value
     };
 
     use achronyme_numerical::bisect;
-    let result = bisect(evaluator, &func, a, b, tol)?;
+    let result = bisect(&mut NativeEvaluator::new(evaluator), &func, a, b, tol)?;
     Ok(Value::Number(result))
 }
 
@@ -315,7 +316,7 @@ pub fn handle_newton(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Valu
     };
 
     use achronyme_numerical::newton;
-    let result = newton(evaluator, &func, &dfunc, x0, tol, max_iter)?;
+    let result = newton(&mut NativeEvaluator::new(evaluator), &func, &dfunc, x0, tol, max_iter)?;
     Ok(Value::Number(result))
 }
 
@@ -352,6 +353,6 @@ pub fn handle_secant(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Valu
     };
 
     use achronyme_numerical::secant;
-    let result = secant(evaluator, &func, x0, x1, tol, max_iter)?;
+    let result = secant(&mut NativeEvaluator::new(evaluator), &func, x0, x1, tol, max_iter)?;
     Ok(Value::Number(result))
 }
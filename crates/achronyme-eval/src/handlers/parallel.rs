@@ -0,0 +1,542 @@
+//! Parallel map / filter / reduce over numeric collections
+//!
+//! `pmap(f, xs)`, `pfilter(p, xs)` and `preduce(f, init, xs)` return exactly
+//! what `map`, `filter` and `reduce` would. When `xs` is a large tensor (or
+//! vector of numbers) and `f` is pure, the elements are split into chunks
+//! that worker threads claim from a shared counter, so fast threads pick up
+//! the slack of slow ones. Each worker runs its own `Evaluator` with a copy
+//! of the lambda rebuilt from its body and captured values, and the
+//! caller's deadline.
+//!
+//! A lambda is run in parallel when its body only evaluates expressions
+//! (arithmetic, `if`/`piecewise`, `let`, indexing, builtin calls, `rec`) and
+//! it captures only numbers, booleans, complex numbers, strings, tensors or
+//! builtin functions. Assignments, `mut` declarations, nested lambdas,
+//! records, generators, captured user functions and I/O builtins such as
+//! `print` all keep the call sequential, as does any element whose result
+//! isn't a number, boolean or complex number.
+//!
+//! `preduce` requires `f` to be associative: each chunk is folded on its own
+//! and the chunk results are then folded onto `init` in order.
+
+use std::cell::RefCell;
+use std::collections::HashMap;
+use std::ops::Range;
+use std::rc::Rc;
+use std::sync::atomic::{AtomicBool, AtomicUsize, Ordering};
+use std::time::Instant;
+
+use achronyme_parser::ast::{ArrayElement, AstNode, IndexArg};
+use achronyme_parser::type_annotation::TypeAnnotation;
+use achronyme_types::complex::Complex;
+use achronyme_types::function::Function;
+use achronyme_types::tensor::{ComplexTensor, RealTensor};
+use achronyme_types::value::Value;
+use achronyme_types::Environment;
+
+use super::hof::{collection_to_vec, filter_collection, map_collections, reduce_collection};
+use crate::evaluator::Evaluator;
+
+/// Collections shorter than this run sequentially
+const PARALLEL_MIN_ELEMENTS: usize = 4096;
+
+/// Smallest chunk a worker claims at once
+const MIN_CHUNK: usize = 256;
+
+/// Chunks per worker; more chunks balance uneven per-element cost better
+const CHUNKS_PER_THREAD: usize = 8;
+
+/// Builtins with side effects, never called from worker threads
+const IMPURE_BUILTINS: &[&str] = &["print", "save_env", "restore_env", "env_info", "compact_env"];
+
+/// pmap(f, collection) - Parallel map for pure unary lambdas
+pub fn handle_pmap(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value, String> {
+    if args.len() != 2 {
+        return Err("pmap requires 2 arguments: function and collection".to_string());
+    }
+    let func = expect_function(evaluator.evaluate(&args[0])?, "pmap")?;
+    let collection = evaluator.evaluate(&args[1])?;
+
+    if let Some((lambda, inputs)) = prepare(evaluator, &func, 1, &collection) {
+        let outcome = run_chunks(&lambda, inputs.len(), worker_count(), |worker, function, range| {
+            inputs[range]
+                .iter()
+                .map(|x| {
+                    let result = worker.apply_lambda(function, vec![x.to_value()]).map_err(Failure::Error)?;
+                    Scalar::from_value(&result).ok_or(Failure::Unportable)
+                })
+                .collect::<Result<Vec<_>, _>>()
+        });
+        match outcome {
+            Ok(chunks) => {
+                return Ok(Value::Vector(chunks.into_iter().flatten().map(Scalar::to_value).collect()));
+            }
+            Err(Failure::Error(e)) => return Err(e),
+            Err(Failure::Unportable) => {}
+        }
+    }
+
+    map_collections(evaluator, &func, vec![collection_to_vec(collection)?])
+}
+
+/// pfilter(predicate, collection) - Parallel filter for pure predicates
+pub fn handle_pfilter(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value, String> {
+    if args.len() != 2 {
+        return Err("pfilter requires 2 arguments: predicate and collection".to_string());
+    }
+    let predicate = expect_function(evaluator.evaluate(&args[0])?, "pfilter")?;
+    if predicate.arity() != 1 {
+        return Err("pfilter predicate must take exactly 1 argument".to_string());
+    }
+    let collection = evaluator.evaluate(&args[1])?;
+
+    if let Some((lambda, inputs)) = prepare(evaluator, &predicate, 1, &collection) {
+        let outcome = run_chunks(&lambda, inputs.len(), worker_count(), |worker, function, range| {
+            let mut kept = Vec::new();
+            for x in &inputs[range] {
+                match worker.apply_lambda(function, vec![x.to_value()]).map_err(Failure::Error)? {
+                    Value::Boolean(true) => kept.push(*x),
+                    Value::Number(n) if n != 0.0 => kept.push(*x),
+                    Value::Boolean(false) | Value::Number(_) => {}
+                    _ => {
+                        return Err(Failure::Error(
+                            "filter predicate must return a boolean or number".to_string(),
+                        ))
+                    }
+                }
+            }
+            Ok(kept)
+        });
+        match outcome {
+            Ok(chunks) => {
+                return Ok(Value::Vector(chunks.into_iter().flatten().map(Scalar::to_value).collect()));
+            }
+            Err(Failure::Error(e)) => return Err(e),
+            Err(Failure::Unportable) => {}
+        }
+    }
+
+    filter_collection(evaluator, &predicate, collection_to_vec(collection)?)
+}
+
+/// preduce(f, init, collection) - Parallel reduce for pure associative lambdas
+pub fn handle_preduce(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value, String> {
+    if args.len() != 3 {
+        return Err("preduce requires 3 arguments: function, initial value, and collection".to_string());
+    }
+    let func = expect_function(evaluator.evaluate(&args[0])?, "preduce")?;
+    if func.arity() != 2 {
+        return Err("preduce function must take exactly 2 arguments".to_string());
+    }
+    let init = evaluator.evaluate(&args[1])?;
+    let collection = evaluator.evaluate(&args[2])?;
+
+    if let Some((lambda, inputs)) = prepare(evaluator, &func, 2, &collection) {
+        let outcome = run_chunks(&lambda, inputs.len(), worker_count(), |worker, function, range| {
+            let chunk = &inputs[range];
+            let mut acc = chunk[0].to_value();
+            for x in &chunk[1..] {
+                acc = worker.apply_lambda(function, vec![acc, x.to_value()]).map_err(Failure::Error)?;
+            }
+            Scalar::from_value(&acc).ok_or(Failure::Unportable)
+        });
+        match outcome {
+            Ok(partials) => {
+                let partials = partials.into_iter().map(Scalar::to_value).collect();
+                return reduce_collection(evaluator, &func, init, partials);
+            }
+            Err(Failure::Error(e)) => return Err(e),
+            Err(Failure::Unportable) => {}
+        }
+    }
+
+    reduce_collection(evaluator, &func, init, collection_to_vec(collection)?)
+}
+
+fn expect_function(value: Value, name: &str) -> Result<Rc<Function>, String> {
+    match value {
+        Value::Function(f) => Ok(f),
+        _ => Err(format!("First argument to {} must be a function", name)),
+    }
+}
+
+/// The portable lambda and scalar inputs, when the call is worth running in parallel
+fn prepare(
+    evaluator: &Evaluator,
+    func: &Function,
+    arity: usize,
+    collection: &Value,
+) -> Option<(PortableLambda, Vec<Scalar>)> {
+    if func.arity() != arity || worker_count() < 2 {
+        return None;
+    }
+    let inputs: Vec<Scalar> = match collection {
+        Value::Tensor(t) if t.size() >= PARALLEL_MIN_ELEMENTS => t.data().iter().map(|&n| Scalar::Number(n)).collect(),
+        Value::ComplexTensor(t) if t.size() >= PARALLEL_MIN_ELEMENTS => {
+            t.data().iter().map(|&c| Scalar::Complex(c)).collect()
+        }
+        Value::Vector(v) if v.len() >= PARALLEL_MIN_ELEMENTS => v.iter().map(Scalar::from_value).collect::<Option<_>>()?,
+        _ => return None,
+    };
+    Some((PortableLambda::capture(evaluator, func)?, inputs))
+}
+
+fn worker_count() -> usize {
+    std::thread::available_parallelism().map(|n| n.get()).unwrap_or(1)
+}
+
+/// Why a worker stopped
+enum Failure {
+    /// The lambda failed; the sequential form would report the same error
+    Error(String),
+    /// A result can't leave the worker thread; rerun sequentially
+    Unportable,
+}
+
+/// Run `work` over `0..len` in chunks claimed by up to `threads` workers
+///
+/// Returns the chunk results in order, or the failure of the lowest failing
+/// chunk. Chunks are claimed in increasing order and a claimed chunk always
+/// finishes, so that is the failure a sequential pass would hit first.
+fn run_chunks<R, F>(lambda: &PortableLambda, len: usize, threads: usize, work: F) -> Result<Vec<R>, Failure>
+where
+    R: Send,
+    F: Fn(&mut Evaluator, &Function, Range<usize>) -> Result<R, Failure> + Sync,
+{
+    let threads = threads.min(len.div_ceil(MIN_CHUNK)).max(1);
+    let chunk = (len / (threads * CHUNKS_PER_THREAD)).max(MIN_CHUNK);
+    let chunk_count = len.div_ceil(chunk);
+
+    let next = AtomicUsize::new(0);
+    let abort = AtomicBool::new(false);
+
+    let mut done: Vec<(usize, Result<R, Failure>)> = std::thread::scope(|scope| {
+        let handles: Vec<_> = (0..threads)
+            .map(|_| {
+                scope.spawn(|| {
+                    let mut done = Vec::new();
+                    let Ok((mut worker, function)) = lambda.instantiate() else {
+                        abort.store(true, Ordering::Relaxed);
+                        done.push((0, Err(Failure::Unportable)));
+                        return done;
+                    };
+                    while !abort.load(Ordering::Relaxed) {
+                        let index = next.fetch_add(1, Ordering::Relaxed);
+                        if index >= chunk_count {
+                            break;
+                        }
+                        let range = index * chunk..((index + 1) * chunk).min(len);
+                        let result = work(&mut worker, &function, range);
+                        if result.is_err() {
+                            abort.store(true, Ordering::Relaxed);
+                        }
+                        done.push((index, result));
+                    }
+                    done
+                })
+            })
+            .collect();
+
+        handles
+            .into_iter()
+            .flat_map(|handle| handle.join().unwrap_or_else(|panic| std::panic::resume_unwind(panic)))
+            .collect()
+    });
+
+    done.sort_by_key(|(index, _)| *index);
+    done.into_iter().map(|(_, result)| result).collect()
+}
+
+/// Element value that can cross threads
+#[derive(Clone, Copy)]
+enum Scalar {
+    Number(f64),
+    Boolean(bool),
+    Complex(Complex),
+}
+
+impl Scalar {
+    fn from_value(value: &Value) -> Option<Self> {
+        match value {
+            Value::Number(n) => Some(Scalar::Number(*n)),
+            Value::Boolean(b) => Some(Scalar::Boolean(*b)),
+            Value::Complex(c) => Some(Scalar::Complex(*c)),
+            _ => None,
+        }
+    }
+
+    fn to_value(self) -> Value {
+        match self {
+            Scalar::Number(n) => Value::Number(n),
+            Scalar::Boolean(b) => Value::Boolean(b),
+            Scalar::Complex(c) => Value::Complex(c),
+        }
+    }
+}
+
+/// Captured value that can cross threads
+enum Portable {
+    Scalar(Scalar),
+    String(String),
+    Tensor(RealTensor),
+    ComplexTensor(ComplexTensor),
+    Builtin(String),
+}
+
+impl Portable {
+    fn from_value(value: Value) -> Option<Self> {
+        match value {
+            Value::String(s) => Some(Portable::String(s)),
+            Value::Tensor(t) => Some(Portable::Tensor(*t)),
+            Value::ComplexTensor(t) => Some(Portable::ComplexTensor(*t)),
+            Value::Function(f) => match &*f {
+                Function::Builtin(name) => Some(Portable::Builtin(name.clone())),
+                _ => None,
+            },
+            other => Scalar::from_value(&other).map(Portable::Scalar),
+        }
+    }
+
+    fn to_value(&self) -> Value {
+        match self {
+            Portable::Scalar(s) => s.to_value(),
+            Portable::String(s) => Value::String(s.clone()),
+            Portable::Tensor(t) => Value::Tensor(Box::new(t.clone())),
+            Portable::ComplexTensor(t) => Value::ComplexTensor(Box::new(t.clone())),
+            Portable::Builtin(name) => Value::from(Function::Builtin(name.clone())),
+        }
+    }
+}
+
+/// A pure lambda detached from its closure environment
+struct PortableLambda {
+    params: Vec<String>,
+    param_types: Vec<Option<TypeAnnotation>>,
+    return_type: Option<TypeAnnotation>,
+    body: AstNode,
+    captures: Vec<(String, Portable)>,
+    imports: HashMap<String, (String, String)>,
+    bytecode_mode: bool,
+    fusion_mode: bool,
+    deadline: Option<Instant>,
+}
+
+impl PortableLambda {
+    /// Detach `func` if its body is pure and everything it captures is portable
+    fn capture(evaluator: &Evaluator, func: &Function) -> Option<Self> {
+        let Function::UserDefined { params, param_types, return_type, body, closure_env } = func else {
+            return None;
+        };
+
+        let mut checker = PurityChecker {
+            params,
+            env: &closure_env.borrow(),
+            captures: Vec::new(),
+        };
+        if !checker.visit(body) {
+            return None;
+        }
+        let captures = checker.captures;
+
+        Some(Self {
+            params: params.clone(),
+            param_types: param_types.clone(),
+            return_type: return_type.clone(),
+            body: (**body).clone(),
+            captures,
+            imports: evaluator.imported_modules.clone(),
+            bytecode_mode: evaluator.bytecode_mode,
+            fusion_mode: evaluator.fusion_mode,
+            deadline: evaluator.deadline(),
+        })
+    }
+
+    /// A fresh evaluator and the rebuilt lambda, for one worker thread
+    fn instantiate(&self) -> Result<(Evaluator, Function), String> {
+        let mut evaluator = Evaluator::new();
+        evaluator.imported_modules = self.imports.clone();
+        evaluator.bytecode_mode = self.bytecode_mode;
+        evaluator.fusion_mode = self.fusion_mode;
+        evaluator.set_deadline(self.deadline);
+
+        let mut env = Environment::new();
+        for (name, value) in &self.captures {
+            env.define(name.clone(), value.to_value())?;
+        }
+
+        let function = Function::UserDefined {
+            params: self.params.clone(),
+            param_types: self.param_types.clone(),
+            return_type: self.return_type.clone(),
+            body: Rc::new(self.body.clone()),
+            closure_env: Rc::new(RefCell::new(env)),
+        };
+        Ok((evaluator, function))
+    }
+}
+
+/// Whitelist walk over a lambda body, collecting the captures it reads
+struct PurityChecker<'a> {
+    params: &'a [String],
+    env: &'a Environment,
+    captures: Vec<(String, Portable)>,
+}
+
+impl PurityChecker<'_> {
+    fn visit(&mut self, node: &AstNode) -> bool {
+        match node {
+            AstNode::Number(_)
+            | AstNode::Boolean(_)
+            | AstNode::StringLiteral(_)
+            | AstNode::Null
+            | AstNode::ComplexLiteral { .. }
+            | AstNode::RecReference => true,
+            AstNode::BinaryOp { left, right, .. } => self.visit(left) && self.visit(right),
+            AstNode::UnaryOp { operand, .. } => self.visit(operand),
+            AstNode::If { condition, then_expr, else_expr } => {
+                self.visit(condition) && self.visit(then_expr) && self.visit(else_expr)
+            }
+            AstNode::Piecewise { cases, default } => {
+                cases.iter().all(|(cond, value)| self.visit(cond) && self.visit(value))
+                    && default.as_ref().map_or(true, |d| self.visit(d))
+            }
+            AstNode::FunctionCall { name, args } => self.name(name) && args.iter().all(|a| self.visit(a)),
+            AstNode::CallExpression { callee, args } => {
+                let callee_ok = match &**callee {
+                    AstNode::RecReference => true,
+                    AstNode::VariableRef(name) => self.name(name),
+                    _ => false,
+                };
+                callee_ok && args.iter().all(|a| self.visit(a))
+            }
+            AstNode::ArrayLiteral(elements) => elements.iter().all(|e| match e {
+                ArrayElement::Single(node) => self.visit(node),
+                ArrayElement::Spread(node) => self.visit(node),
+            }),
+            AstNode::VariableDecl { initializer, .. } => self.visit(initializer),
+            AstNode::VariableRef(name) | AstNode::LocalRef { name, .. } => self.name(name),
+            AstNode::IndexAccess { object, indices } => {
+                self.visit(object)
+                    && indices.iter().all(|index| match index {
+                        IndexArg::Single(node) => self.visit(node),
+                        IndexArg::Range { start, end } => {
+                            start.as_ref().map_or(true, |n| self.visit(n)) && end.as_ref().map_or(true, |n| self.visit(n))
+                        }
+                    })
+            }
+            AstNode::Sequence { statements } | AstNode::DoBlock { statements } => {
+                statements.iter().all(|s| self.visit(s))
+            }
+            AstNode::Return { value } => self.visit(value),
+            _ => false,
+        }
+    }
+
+    /// A referenced or called name: parameters and unbound names (locals,
+    /// constants, builtins) resolve the same in a worker; captured names
+    /// must be portable
+    fn name(&mut self, name: &str) -> bool {
+        if self.params.iter().any(|p| p == name) {
+            return true;
+        }
+        if IMPURE_BUILTINS.contains(&name) {
+            return false;
+        }
+        if self.captures.iter().any(|(captured, _)| captured == name) || !self.env.has(name) {
+            return true;
+        }
+        match self.env.get(name).ok().and_then(Portable::from_value) {
+            Some(value) => {
+                self.captures.push((name.to_string(), value));
+                true
+            }
+            None => false,
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn lambda(source: &str) -> (Evaluator, Function) {
+        let mut evaluator = Evaluator::new();
+        match evaluator.eval_str(source).unwrap() {
+            Value::Function(f) => (evaluator, (*f).clone()),
+            other => panic!("Expected Function, got {:?}", other),
+        }
+    }
+
+    fn square_all(lambda: &PortableLambda, inputs: &[f64], threads: usize) -> Result<Vec<Vec<f64>>, Failure> {
+        run_chunks(lambda, inputs.len(), threads, |worker, function, range| {
+            inputs[range]
+                .iter()
+                .map(|&x| match worker.apply_lambda(function, vec![Value::Number(x)]) {
+                    Ok(Value::Number(n)) => Ok(n),
+                    Ok(_) => Err(Failure::Unportable),
+                    Err(e) => Err(Failure::Error(e)),
+                })
+                .collect()
+        })
+    }
+
+    #[test]
+    fn test_workers_preserve_order() {
+        let (evaluator, func) = lambda("let k = 2\nx => x * x + k");
+        let portable = PortableLambda::capture(&evaluator, &func).unwrap();
+        assert_eq!(portable.captures.len(), 1);
+
+        let inputs: Vec<f64> = (0..5000).map(|i| i as f64).collect();
+        let Ok(chunks) = square_all(&portable, &inputs, 4) else {
+            panic!("parallel run failed");
+        };
+        let flat: Vec<f64> = chunks.into_iter().flatten().collect();
+        assert_eq!(flat, inputs.iter().map(|x| x * x + 2.0).collect::<Vec<_>>());
+    }
+
+    #[test]
+    fn test_lowest_failing_chunk_wins() {
+        let (evaluator, func) = lambda("x => if (x >= 3000) { undefined_fn(x) } else { x }");
+        let portable = PortableLambda::capture(&evaluator, &func).unwrap();
+
+        let inputs: Vec<f64> = (0..5000).map(|i| i as f64).collect();
+        let sequential = {
+            let (mut evaluator, func) = lambda("x => if (x >= 3000) { undefined_fn(x) } else { x }");
+            evaluator.apply_lambda(&func, vec![Value::Number(3000.0)]).unwrap_err()
+        };
+        match square_all(&portable, &inputs, 4) {
+            Err(Failure::Error(e)) => assert_eq!(e, sequential),
+            _ => panic!("expected the lambda error"),
+        }
+    }
+
+    #[test]
+    fn test_workers_keep_the_deadline() {
+        let (mut evaluator, func) = lambda("x => x + 1");
+        let deadline = Instant::now() + std::time::Duration::from_secs(60);
+        evaluator.set_deadline(Some(deadline));
+        let portable = PortableLambda::capture(&evaluator, &func).unwrap();
+        let Ok((worker, _)) = portable.instantiate() else {
+            panic!("instantiate failed");
+        };
+        assert_eq!(worker.deadline(), Some(deadline));
+    }
+
+    #[test]
+    fn test_impure_lambdas_are_not_portable() {
+        for source in [
+            "mut n = 0\nx => do { n = n + 1; x }",
+            "x => do { print(x); x }",
+            "let f = y => y\nx => f(x)",
+            "x => y => x + y",
+            "let r = { a: 1 }\nx => r.a + x",
+        ] {
+            let (evaluator, func) = lambda(source);
+            assert!(PortableLambda::capture(&evaluator, &func).is_none(), "portable: {}", source);
+        }
+
+        // Builtins, constants and rec are fine
+        let (evaluator, func) = lambda("let g = sqrt\nx => if (x < 1) { g(pi) } else { rec(x - 1) }");
+        assert!(PortableLambda::capture(&evaluator, &func).is_some());
+    }
+}
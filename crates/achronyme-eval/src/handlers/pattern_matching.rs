@@ -131,7 +131,8 @@ fn match_type(value: &Value, type_name: &str) -> Result<Option<HashMap<String, V
         (Value::Record(_), "Record") => true,
         (Value::Edge { .. }, "Edge") => true,
         (Value::Generator(_), "Generator") => true,
-        (Value::Error { .. }, "Error") => true,
+        (Value::Sequence(_), "Sequence") => true,
+        (Value::Error(_), "Error") => true,
         (Value::Null, "Null") => true,
         _ => false,
     };
@@ -148,14 +149,14 @@ fn match_record(value: &Value, fields: &[(String, Pattern)]) -> Result<Option<Ha
     let record_map = match value {
         Value::Record(map) => map,
         // Also handle Error values as they have named fields
-        Value::Error { message, kind, source } => {
+        Value::Error(error) => {
             // Create a temporary map for error fields
             let mut map = HashMap::new();
-            map.insert("message".to_string(), Value::String(message.clone()));
-            if let Some(k) = kind {
+            map.insert("message".to_string(), Value::String(error.message.clone()));
+            if let Some(k) = &error.kind {
                 map.insert("kind".to_string(), Value::String(k.clone()));
             }
-            if let Some(src) = source {
+            if let Some(src) = &error.source {
                 map.insert("source".to_string(), (**src).clone());
             }
             // We need to return early here because we're creating a temporary
@@ -0,0 +1,295 @@
+//! Lazy sequences and the pull loop behind `map` / `filter` / `reduce`
+//!
+//! Every collection a HOF consumes is read through a [`Pull`]: a cursor over
+//! a range, vector, tensor or generator plus the map / filter / take stages
+//! of a [`Sequence`]. Elements are pulled one at a time through all stages,
+//! so a chain of HOFs runs as one loop and never builds the intermediate
+//! vectors.
+//!
+//! Chains are fused from the call syntax: in
+//! `reduce(f, 0, map(g, filter(p, range(0, 1e8))))` the inner `map`,
+//! `filter` and `range` calls are not evaluated to vectors; they become the
+//! stages and source of the sequence `reduce` folds. Each element reaches
+//! `g` right after passing `p`, where an eager chain would run `p` over the
+//! whole range first; only lambdas with side effects can tell.
+//!
+//! `map` and `filter` return a `Value::Sequence` instead of a vector when
+//! their input is already lazy (a generator, a sequence or `lazy(...)`);
+//! `collect` materializes one.
+
+use achronyme_parser::ast::AstNode;
+use achronyme_types::function::Function;
+use achronyme_types::sequence::{Sequence, SequenceSource, SequenceStage};
+use achronyme_types::value::{GeneratorState, Value};
+use std::cell::RefCell;
+use std::rc::Rc;
+
+use crate::evaluator::Evaluator;
+use crate::function_modules::array::core::range_bounds;
+use crate::function_modules::array::transform::take_count;
+
+use super::generator::next_value;
+
+/// Cursor over the elements of a sequence source
+enum Cursor {
+    Range { current: f64, end: f64, step: f64 },
+    /// A Vector, Tensor or ComplexTensor read by flat index
+    Collection { value: Value, index: usize },
+    Generator(Rc<RefCell<GeneratorState>>),
+}
+
+impl Cursor {
+    fn new(source: &SequenceSource) -> Self {
+        match source {
+            SequenceSource::Range { start, end, step } => {
+                Cursor::Range { current: *start, end: *end, step: *step }
+            }
+            SequenceSource::Collection(value) => Cursor::Collection { value: value.clone(), index: 0 },
+            SequenceSource::Generator(gen) => Cursor::Generator(gen.clone()),
+        }
+    }
+
+    fn next(&mut self, evaluator: &mut Evaluator) -> Result<Option<Value>, String> {
+        match self {
+            Cursor::Range { current, end, step } => {
+                // Same accumulation as range(), so both yield identical numbers
+                let more = if *step > 0.0 { *current < *end } else { *current > *end };
+                if !more {
+                    return Ok(None);
+                }
+                let value = *current;
+                *current += *step;
+                Ok(Some(Value::Number(value)))
+            }
+            Cursor::Collection { value, index } => {
+                let element = match value {
+                    Value::Vector(v) => v.get(*index).cloned(),
+                    Value::Tensor(t) => t.data().get(*index).map(|&n| Value::Number(n)),
+                    Value::ComplexTensor(ct) => ct.data().get(*index).map(|&c| Value::Complex(c)),
+                    _ => None,
+                };
+                *index += 1;
+                Ok(element)
+            }
+            Cursor::Generator(gen) => next_value(evaluator, gen),
+        }
+    }
+}
+
+/// Stage state while pulling: takes count down what they still let through
+enum PullStage {
+    Map(Rc<Function>),
+    Filter(Rc<Function>),
+    Take(usize),
+}
+
+/// One pass over a sequence
+pub(crate) struct Pull {
+    cursor: Cursor,
+    stages: Vec<PullStage>,
+    /// Set once the source is drained or a take has let its last element by,
+    /// so the source is never pulled past what the stages can use
+    exhausted: bool,
+}
+
+impl Pull {
+    pub(crate) fn new(sequence: &Sequence) -> Self {
+        let stages: Vec<PullStage> = sequence
+            .stages
+            .iter()
+            .map(|stage| match stage {
+                SequenceStage::Map(f) => PullStage::Map(f.clone()),
+                SequenceStage::Filter(p) => PullStage::Filter(p.clone()),
+                SequenceStage::Take(n) => PullStage::Take(*n),
+            })
+            .collect();
+        let exhausted = stages.iter().any(|s| matches!(s, PullStage::Take(0)));
+        Self { cursor: Cursor::new(&sequence.source), stages, exhausted }
+    }
+
+    /// Next element that makes it through every stage
+    pub(crate) fn next(&mut self, evaluator: &mut Evaluator) -> Result<Option<Value>, String> {
+        'pull: loop {
+            if self.exhausted {
+                return Ok(None);
+            }
+            let mut value = match self.cursor.next(evaluator)? {
+                Some(value) => value,
+                None => {
+                    self.exhausted = true;
+                    return Ok(None);
+                }
+            };
+
+            for stage in &mut self.stages {
+                match stage {
+                    PullStage::Map(f) => value = evaluator.apply_lambda(f, vec![value])?,
+                    PullStage::Filter(p) => {
+                        let keep = evaluator.apply_lambda(p, vec![value.clone()])?;
+                        if !truthy(&keep, "filter predicate must return a boolean or number")? {
+                            continue 'pull;
+                        }
+                    }
+                    PullStage::Take(remaining) => {
+                        *remaining -= 1;
+                        if *remaining == 0 {
+                            self.exhausted = true;
+                        }
+                    }
+                }
+            }
+            return Ok(Some(value));
+        }
+    }
+
+    /// Pull every remaining element
+    pub(crate) fn collect(mut self, evaluator: &mut Evaluator) -> Result<Vec<Value>, String> {
+        let mut values = Vec::new();
+        while let Some(value) = self.next(evaluator)? {
+            values.push(value);
+        }
+        Ok(values)
+    }
+}
+
+/// Predicate result as a boolean (boolean, or non-zero number)
+pub(crate) fn truthy(value: &Value, error: &str) -> Result<bool, String> {
+    match value {
+        Value::Boolean(b) => Ok(*b),
+        Value::Number(n) => Ok(*n != 0.0),
+        _ => Err(error.to_string()),
+    }
+}
+
+/// Sequence over an evaluated value, and whether it is lazy
+///
+/// Generators and sequences are lazy; vectors and tensors are not.
+pub(crate) fn sequence_of_value(value: Value) -> Result<(Sequence, bool), String> {
+    match value {
+        Value::Vector(_) | Value::Tensor(_) | Value::ComplexTensor(_) => {
+            Ok((Sequence::new(SequenceSource::Collection(value)), false))
+        }
+        Value::Generator(gen) => Ok((Sequence::new(SequenceSource::Generator(gen)), true)),
+        Value::Sequence(seq) => Ok(((*seq).clone(), true)),
+        _ => Err("Expected a vector or tensor".to_string()),
+    }
+}
+
+/// Sequence for a HOF's collection argument, fusing nested `range`, `map`,
+/// `filter`, `take` and `lazy` calls instead of evaluating them
+///
+/// The flag says whether the result should stay lazy: true when the chain
+/// bottoms out in a generator, a sequence or `lazy(...)`.
+pub(crate) fn sequence_of(evaluator: &mut Evaluator, node: &AstNode) -> Result<(Sequence, bool), String> {
+    if let Some((name, args)) = named_call(node) {
+        // A variable of the same name shadows the builtin, so call it normally
+        if !evaluator.environment().has(name) {
+            match (name, args.len()) {
+                ("range", 2) | ("range", 3) => {
+                    let mut bounds = Vec::with_capacity(args.len());
+                    for arg in args {
+                        bounds.push(evaluator.evaluate(arg)?);
+                    }
+                    let (start, end, step) = range_bounds(&bounds)?;
+                    return Ok((Sequence::new(SequenceSource::Range { start, end, step }), false));
+                }
+                ("map", 2) => {
+                    let func = map_function(evaluator, &args[0])?;
+                    let (inner, lazy) = sequence_of(evaluator, &args[1])?;
+                    return Ok((inner.then(SequenceStage::Map(func)), lazy));
+                }
+                ("filter", 2) => {
+                    let predicate = filter_predicate(evaluator, &args[0])?;
+                    let (inner, lazy) = sequence_of(evaluator, &args[1])?;
+                    return Ok((inner.then(SequenceStage::Filter(predicate)), lazy));
+                }
+                ("take", 2) => {
+                    let (inner, lazy) = sequence_of(evaluator, &args[0])?;
+                    let count = take_count(&evaluator.evaluate(&args[1])?)?;
+                    return Ok((inner.then(SequenceStage::Take(count)), lazy));
+                }
+                ("lazy", 1) => {
+                    let (inner, _) = sequence_of(evaluator, &args[0])?;
+                    return Ok((inner, true));
+                }
+                _ => {}
+            }
+        }
+    }
+
+    let value = evaluator.evaluate(node)?;
+    sequence_of_value(value)
+}
+
+/// Name and arguments of a call to a function by name: `f(x)` parses as a
+/// call expression on a variable reference
+fn named_call(node: &AstNode) -> Option<(&str, &[AstNode])> {
+    match node {
+        AstNode::FunctionCall { name, args } => Some((name.as_str(), args.as_slice())),
+        AstNode::CallExpression { callee, args } => match callee.as_ref() {
+            AstNode::VariableRef(name) => Some((name.as_str(), args.as_slice())),
+            _ => None,
+        },
+        _ => None,
+    }
+}
+
+/// Evaluate map's function argument, which must take one element
+pub(crate) fn map_function(evaluator: &mut Evaluator, node: &AstNode) -> Result<Rc<Function>, String> {
+    let func = match evaluator.evaluate(node)? {
+        Value::Function(f) => f,
+        _ => return Err("First argument to map must be a function".to_string()),
+    };
+    if func.arity() != 1 {
+        return Err(format!(
+            "Function arity ({}) must match number of collections (1)",
+            func.arity()
+        ));
+    }
+    Ok(func)
+}
+
+/// Evaluate filter's predicate argument, which must take one element
+pub(crate) fn filter_predicate(evaluator: &mut Evaluator, node: &AstNode) -> Result<Rc<Function>, String> {
+    let predicate = match evaluator.evaluate(node)? {
+        Value::Function(f) => f,
+        _ => return Err("First argument to filter must be a function".to_string()),
+    };
+    if predicate.arity() != 1 {
+        return Err("filter predicate must take exactly 1 argument".to_string());
+    }
+    Ok(predicate)
+}
+
+/// The sequence as a value: lazy input stays lazy, anything else is pulled
+/// into a vector
+pub(crate) fn finish(evaluator: &mut Evaluator, sequence: Sequence, lazy: bool) -> Result<Value, String> {
+    if lazy {
+        Ok(Value::Sequence(Rc::new(sequence)))
+    } else {
+        Ok(Value::Vector(Pull::new(&sequence).collect(evaluator)?))
+    }
+}
+
+/// lazy(collection) - Sequence over a collection, range or generator
+///
+/// Nothing is computed until the sequence is consumed, so
+/// `lazy(range(0, 1e9))` costs nothing until it is pulled.
+pub fn handle_lazy(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value, String> {
+    if args.len() != 1 {
+        return Err("lazy requires 1 argument: a collection, range or generator".to_string());
+    }
+    let (sequence, _) = sequence_of(evaluator, &args[0])?;
+    Ok(Value::Sequence(Rc::new(sequence)))
+}
+
+/// collect(sequence) - Pull every element of a sequence into a vector
+///
+/// Vectors and tensors are returned as vectors of their elements.
+pub fn handle_collect(evaluator: &mut Evaluator, args: &[AstNode]) -> Result<Value, String> {
+    if args.len() != 1 {
+        return Err("collect requires 1 argument: a sequence".to_string());
+    }
+    let (sequence, _) = sequence_of(evaluator, &args[0])?;
+    finish(evaluator, sequence, false)
+}
@@ -14,8 +14,14 @@ fn apply_negate(operand: Value) -> Result<Value, String> {
     match operand {
         Value::Number(n) => Ok(Value::Number(-n)),
         Value::Complex(c) => Ok(Value::Complex(Complex::new(-c.re, -c.im))),
-        Value::Tensor(t) => Ok(Value::Tensor(t.negate())),
-        Value::ComplexTensor(ct) => Ok(Value::ComplexTensor(ct.negate())),
+        Value::Tensor(mut t) => {
+            t.negate_assign();
+            Ok(Value::Tensor(t))
+        }
+        Value::ComplexTensor(mut ct) => {
+            ct.negate_assign();
+            Ok(Value::ComplexTensor(ct))
+        }
         Value::Vector(vec) => {
             if !Value::is_numeric_vector(&vec) {
                 return Err("Cannot negate a non-numeric vector".to_string());
@@ -3,8 +3,10 @@ use achronyme_parser::TypeAnnotation;
 use achronyme_types::complex::Complex;
 use achronyme_types::function::Function;
 use achronyme_types::value::Value;
+use achronyme_types::Symbol;
 
 use crate::evaluator::Evaluator;
+use crate::profiler::Phase;
 use crate::type_checker;
 
 /// Evaluate a variable declaration (let statement) with optional type checking
@@ -15,23 +17,69 @@ pub fn evaluate_declaration(
     initializer: &AstNode,
 ) -> Result<Value, String> {
     // Evaluate the initializer
-    let mut value = evaluator.evaluate(initializer)?;
+    let value = evaluator.evaluate(initializer)?;
 
-    // Type check if annotation is provided
-    if let Some(expected_type) = type_annotation {
-        // Resolve type aliases before checking
-        let resolved_type = evaluator.resolve_type(expected_type);
+    declare(evaluator, name, type_annotation.as_ref(), value, false)
+}
 
-        // Special case: if type is Function and value is a function, enrich with type info
-        value = enrich_function_with_type(value, &resolved_type);
+/// Declare an already evaluated `let`/`mut` variable in the current scope
+///
+/// Shared by the tree-walking handlers and the bytecode VM.
+pub(crate) fn declare(
+    evaluator: &mut Evaluator,
+    name: &str,
+    type_annotation: Option<&TypeAnnotation>,
+    value: Value,
+    mutable: bool,
+) -> Result<Value, String> {
+    // Frames of a function are named after the first variable it is bound to
+    evaluator.profile_name(name, &value);
+
+    match type_annotation {
+        Some(expected_type) => {
+            // Resolve type aliases before checking
+            let resolved_type = evaluator.resolve_type(expected_type);
+            let value = evaluator.profile_phase(Phase::TypeCheck, |_| check_declared_type(name, &resolved_type, value))?;
+
+            if mutable {
+                // Define as mutable variable with resolved type annotation (enforced on assignment)
+                evaluator.environment_mut().define_mutable_typed(
+                    name.to_string(),
+                    value.clone(),
+                    resolved_type,
+                )?;
+            } else {
+                evaluator.environment_mut().define(name.to_string(), value.clone())?;
+            }
 
-        type_checker::check_type(&value, &resolved_type).map_err(|err| {
-            format!("Type error: variable '{}' {}", name, err.replace("Type mismatch: ", ""))
-        })?;
+            // Return the value (not the MutableRef wrapper)
+            Ok(value)
+        }
+        None => {
+            if mutable {
+                evaluator.environment_mut().define_mutable(name.to_string(), value.clone())?;
+            } else {
+                evaluator.environment_mut().define(name.to_string(), value.clone())?;
+            }
+            Ok(value)
+        }
     }
+}
 
-    // Define the variable in the environment (immutable)
-    evaluator.environment_mut().define(name.to_string(), value.clone())?;
+/// Type check the initial value of a declaration against its (resolved) annotation
+///
+/// Function values are enriched with the annotation's parameter and return types.
+pub(crate) fn check_declared_type(
+    name: &str,
+    resolved_type: &TypeAnnotation,
+    value: Value,
+) -> Result<Value, String> {
+    // Special case: if type is Function and value is a function, enrich with type info
+    let value = enrich_function_with_type(value, resolved_type);
+
+    type_checker::check_type(&value, resolved_type).map_err(|err| {
+        format!("Type error: variable '{}' {}", name, err.replace("Type mismatch: ", ""))
+    })?;
 
     Ok(value)
 }
@@ -42,7 +90,7 @@ fn enrich_function_with_type(value: Value, expected_type: &TypeAnnotation) -> Va
     // Only enrich if the expected type is a Function type
     if let TypeAnnotation::Function { params: expected_params, return_type: expected_return } = expected_type {
         if let Value::Function(ref func) = value {
-            if let Function::UserDefined { params, param_types, return_type, body, closure_env } = func {
+            if let Function::UserDefined { params, param_types, return_type, body, closure_env } = &**func {
                 // Check if we need to enrich the parameter types
                 let needs_enrichment = param_types.iter().any(|t| t.is_none()) || return_type.is_none();
 
@@ -76,7 +124,7 @@ fn enrich_function_with_type(value: Value, expected_type: &TypeAnnotation) -> Va
                         closure_env.clone(),
                     );
 
-                    return Value::Function(enriched_func);
+                    return Value::from(enriched_func);
                 }
             }
         }
@@ -94,42 +142,21 @@ pub fn evaluate_mutable_declaration(
     initializer: &AstNode,
 ) -> Result<Value, String> {
     // Evaluate the initializer
-    let mut value = evaluator.evaluate(initializer)?;
-
-    // Type check if annotation is provided
-    if let Some(expected_type) = type_annotation {
-        // Resolve type aliases before checking
-        let resolved_type = evaluator.resolve_type(expected_type);
-
-        // Special case: if type is Function and value is a function, enrich with type info
-        value = enrich_function_with_type(value, &resolved_type);
-
-        type_checker::check_type(&value, &resolved_type).map_err(|err| {
-            format!("Type error: variable '{}' {}", name, err.replace("Type mismatch: ", ""))
-        })?;
-
-        // Define as mutable variable with resolved type annotation (enforced on assignment)
-        evaluator.environment_mut().define_mutable_typed(
-            name.to_string(),
-            value.clone(),
-            resolved_type,
-        )?;
-    } else {
-        // Define as mutable variable without type annotation
-        evaluator.environment_mut().define_mutable(name.to_string(), value.clone())?;
-    }
+    let value = evaluator.evaluate(initializer)?;
 
-    // Return the value (not the MutableRef wrapper)
-    Ok(value)
+    declare(evaluator, name, type_annotation.as_ref(), value, true)
 }
 
 /// Evaluate a variable reference
-pub fn evaluate_reference(evaluator: &Evaluator, name: &str) -> Result<Value, String> {
-    // Check if it's a variable first
-    if evaluator.environment().has(name) {
-        return evaluator.environment().get(name);
+pub fn evaluate_reference(evaluator: &Evaluator, symbol: Symbol) -> Result<Value, String> {
+    // Check if it's a variable first; the symbol was interned by the parser,
+    // so this never hashes the name
+    if let Some(value) = evaluator.environment().lookup_symbol(symbol) {
+        return value;
     }
 
+    let name = symbol.as_str();
+
     // Special case for imaginary unit 'i'
     if name.to_lowercase() == "i" {
         return Ok(Value::Complex(Complex::new(0.0, 1.0)));
@@ -141,29 +168,51 @@ pub fn evaluate_reference(evaluator: &Evaluator, name: &str) -> Result<Value, St
     }
 
     // Check if it's a built-in function (dynamic check from registry)
-    if evaluator.functions().has(name) {
+    if evaluator.functions().has_symbol(symbol) {
         use achronyme_types::function::Function;
-        return Ok(Value::Function(Function::builtin(name.to_string())));
+        return Ok(Value::from(Function::builtin(name.to_string())));
     }
 
     // Check if it's a special form function (functions that require special evaluation)
     if is_special_form(name) {
         use achronyme_types::function::Function;
-        return Ok(Value::Function(Function::builtin(name.to_string())));
+        return Ok(Value::from(Function::builtin(name.to_string())));
     }
 
     // Not found
     Err(format!("Undefined variable or constant: {}", name))
 }
 
+/// Evaluate a reference resolved to a slot of the enclosing function call
+///
+/// Falls back to the lookup by name when the slot doesn't hold the binding.
+pub fn evaluate_local_reference(
+    evaluator: &Evaluator,
+    symbol: Symbol,
+    depth: u32,
+    index: u32,
+) -> Result<Value, String> {
+    match evaluator.environment().get_slot(depth as usize, index as usize, symbol) {
+        Some(value) => value,
+        None => evaluate_reference(evaluator, symbol),
+    }
+}
+
 /// Check if a name corresponds to a special form function
 /// These are functions that require special evaluation (lazy evaluation, evaluator access, etc.)
 /// and are not registered in the standard FunctionRegistry
-fn is_special_form(name: &str) -> bool {
+///
+/// The bytecode compiler leaves calls to these names to the tree-walker, so
+/// new special forms in `function_call::dispatch` must be listed here too.
+pub(crate) fn is_special_form(name: &str) -> bool {
     matches!(
         name,
         // Higher-order functions (require lazy evaluation)
         "map" | "filter" | "reduce" | "pipe" |
+        // Lazy sequences (fuse the calls nested in their argument)
+        "lazy" | "collect" |
+        // Parallel HOFs (evaluate the lambda on worker threads)
+        "pmap" | "pfilter" | "preduce" |
         // Tier 2 array predicates (require lambda evaluation)
         "any" | "all" | "find" | "findIndex" | "count" |
         // Numerical calculus functions (require evaluator for lambda evaluation)
@@ -4,7 +4,11 @@ pub mod functions;
 pub mod tco;
 pub mod modules;
 pub mod type_checker;
+pub mod vm;
+pub mod native;
+pub mod profiler;
 mod handlers;
+mod resolver;
 mod function_modules;
 
 // Re-exports for convenience
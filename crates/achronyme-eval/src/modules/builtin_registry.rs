@@ -6,9 +6,17 @@
 // - Modules: Domain-specific functions requiring import
 // ============================================================================
 
+use std::sync::{Arc, OnceLock};
+
 use super::{Module, ModuleRegistry};
 use crate::functions::FunctionRegistry;
 
+/// The process-wide built-in module registry, built on first use
+pub fn shared_builtin_registry() -> Arc<ModuleRegistry> {
+    static SHARED: OnceLock<Arc<ModuleRegistry>> = OnceLock::new();
+    Arc::clone(SHARED.get_or_init(|| Arc::new(create_builtin_registry())))
+}
+
 /// Create and populate a module registry with all built-in functions
 ///
 /// Organizes functions into:
@@ -17,8 +25,8 @@ use crate::functions::FunctionRegistry;
 pub fn create_builtin_registry() -> ModuleRegistry {
     let mut registry = ModuleRegistry::new();
 
-    // Create a temporary FunctionRegistry to access all built-in functions
-    let func_registry = FunctionRegistry::new();
+    // The shared FunctionRegistry gives access to all built-in functions
+    let func_registry = FunctionRegistry::shared();
 
     // Register prelude functions (always available)
     register_prelude(&mut registry, &func_registry);
@@ -163,6 +171,7 @@ fn register_linalg_module(registry: &mut ModuleRegistry, func_registry: &Functio
     register_to_module(&mut module, func_registry, "transpose");
     register_to_module(&mut module, func_registry, "det");
     register_to_module(&mut module, func_registry, "trace");
+    register_to_module(&mut module, func_registry, "matmul");
 
     registry.register_module(module);
 }
@@ -175,6 +184,8 @@ fn register_dsp_module(registry: &mut ModuleRegistry, func_registry: &FunctionRe
     register_to_module(&mut module, func_registry, "ifft");
     register_to_module(&mut module, func_registry, "fft_mag");
     register_to_module(&mut module, func_registry, "fft_phase");
+    register_to_module(&mut module, func_registry, "rfft");
+    register_to_module(&mut module, func_registry, "irfft");
 
     // Convolution
     register_to_module(&mut module, func_registry, "conv");
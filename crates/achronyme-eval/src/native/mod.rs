@@ -0,0 +1,765 @@
+//! Native compilation of pure scalar lambdas
+//!
+//! Numerical routines (`diff`, `integral`, `quad`, `solve`, `newton`, ...)
+//! sample their lambda thousands of times. Going through the tree-walker
+//! costs a scope push/pop, environment lookups and `Value` boxing per
+//! sample, so lambdas built only from arithmetic, comparisons, `if` /
+//! `piecewise`, immutable `let`s, math builtins and captured numbers are
+//! compiled into a flat stack program over `f64`:
+//!
+//! ```text
+//! let k = 2
+//! x => k * sin(x) + x ^ 2
+//!
+//!    0  Const 2
+//!    1  Arg 0
+//!    2  Unary sin
+//!    3  Mul
+//!    4  Arg 0
+//!    5  Const 2
+//!    6  Pow
+//!    7  Add
+//! ```
+//!
+//! Calls to `rec` run on the same machine: a call in tail position reuses
+//! its frame, any other pushes one.
+//!
+//! Captured values are read once, when the program is compiled; a
+//! [`NativeEvaluator`] lives for one builtin call, and nothing can reassign
+//! them while it runs. Programs kept across calls (see [`specialize`]) only
+//! capture immutable bindings. Lambdas that don't qualify, and any sample
+//! that would raise an error (division by zero, an out-of-range index, a
+//! `piecewise` with no matching case), go through the interpreter, so
+//! results and error messages are unchanged.
+
+pub(crate) mod specialize;
+
+use std::cell::RefCell;
+use std::rc::Rc;
+use std::time::Instant;
+
+use achronyme_parser::ast::{AstNode, BinaryOp, IndexArg, UnaryOp};
+use achronyme_parser::type_annotation::TypeAnnotation;
+use achronyme_types::function::Function;
+use achronyme_types::value::Value;
+use achronyme_types::{Environment, LambdaEvaluator};
+
+use crate::evaluator::{Evaluator, DEADLINE_STRIDE};
+
+/// Stack machine instruction over `f64`; booleans are 0.0 / 1.0
+#[derive(Debug, Clone, Copy)]
+enum Op {
+    Const(f64),
+    /// Scalar parameter
+    Arg(usize),
+    /// Element of the vector parameter (`p[k]` in `eval_vec_at` mode)
+    Element(usize),
+    Load(usize),
+    Store(usize),
+    Pop,
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Mod,
+    Pow,
+    Neg,
+    Not,
+    Gt,
+    Lt,
+    Gte,
+    Lte,
+    Eq,
+    Neq,
+    And,
+    Or,
+    Unary(fn(f64) -> f64),
+    Binary(fn(f64, f64) -> f64),
+    /// Fold the top `n` values with min / max
+    Min(usize),
+    Max(usize),
+    Jump(usize),
+    JumpIfFalse(usize),
+    /// Call this lambda with the top `n` values as arguments
+    Rec(usize),
+    /// `Rec` in tail position: rebind the arguments and start over
+    TailRec(usize),
+    /// No fast result; rerun this sample on the interpreter
+    Bail,
+}
+
+/// Static type of a compiled expression
+#[derive(Debug, Clone, Copy, PartialEq)]
+enum Kind {
+    Number,
+    Boolean,
+}
+
+/// How the lambda receives its arguments
+#[derive(Debug, Clone, Copy, PartialEq)]
+enum Params {
+    /// `(x, y, ...) => ...` called with one number per parameter
+    Scalars(usize),
+    /// `p => ...` called with a single numeric vector
+    Vector,
+}
+
+/// Nested `rec` calls deeper than this go back to the interpreter
+const MAX_REC_DEPTH: usize = 100_000;
+
+/// Caller state saved by `Op::Rec`
+#[derive(Debug, Clone, Copy)]
+struct Frame {
+    return_pc: usize,
+    args: usize,
+    slots: usize,
+}
+
+/// A lambda compiled to a stack program over `f64`
+#[derive(Debug)]
+pub struct NativeLambda {
+    params: Params,
+    code: Vec<Op>,
+    locals: usize,
+    stack: Vec<f64>,
+    slots: Vec<f64>,
+    frames: Vec<Frame>,
+}
+
+impl NativeLambda {
+    /// Compile a lambda taking one number per parameter
+    pub fn compile(evaluator: &Evaluator, func: &Function) -> Option<Self> {
+        Self::compile_with(evaluator, func, false, false)
+    }
+
+    /// Compile a single-parameter lambda that receives a numeric vector
+    pub fn compile_vector(evaluator: &Evaluator, func: &Function) -> Option<Self> {
+        Self::compile_with(evaluator, func, true, false)
+    }
+
+    /// Compile a lambda whose parameters are all annotated `Number`, to be
+    /// kept for every later call of the same closure
+    ///
+    /// Mutable captures are refused, since they may change between calls.
+    pub fn compile_specialized(evaluator: &Evaluator, func: &Function) -> Option<Self> {
+        let Function::UserDefined { param_types, .. } = func else {
+            return None;
+        };
+        if !param_types.iter().all(|t| matches!(t, Some(TypeAnnotation::Number))) {
+            return None;
+        }
+        Self::compile_with(evaluator, func, false, true)
+    }
+
+    fn compile_with(evaluator: &Evaluator, func: &Function, vector: bool, stable: bool) -> Option<Self> {
+        let Function::UserDefined { params, param_types, return_type, body, closure_env } = func else {
+            return None;
+        };
+        let is_number = |t: &Option<TypeAnnotation>| matches!(t, None | Some(TypeAnnotation::Number));
+        if !is_number(return_type) || (vector && params.len() != 1) {
+            return None;
+        }
+        if !vector && !param_types.iter().all(is_number) {
+            return None;
+        }
+        if vector && param_types[0].is_some() {
+            return None;
+        }
+
+        let env = closure_env.borrow();
+        let mut compiler = Compiler {
+            evaluator,
+            env: &env,
+            params,
+            vector,
+            stable,
+            scopes: Vec::new(),
+            locals: 0,
+            code: Vec::new(),
+        };
+        if compiler.expr(body)? != Kind::Number {
+            return None;
+        }
+        compiler.mark_tail_calls();
+
+        Some(Self {
+            params: if vector { Params::Vector } else { Params::Scalars(params.len()) },
+            code: compiler.code,
+            locals: compiler.locals,
+            stack: Vec::new(),
+            slots: Vec::new(),
+            frames: Vec::new(),
+        })
+    }
+
+    /// Run the program; `None` means the interpreter must handle this call
+    pub fn call(&mut self, args: &[f64]) -> Option<f64> {
+        self.call_until(args, None)
+    }
+
+    /// `call`, bailing out at a recursion once `deadline` has passed so that
+    /// the interpreter reports the timeout
+    pub fn call_until(&mut self, args: &[f64], deadline: Option<Instant>) -> Option<f64> {
+        if let Params::Scalars(arity) = self.params {
+            if args.len() != arity {
+                return None;
+            }
+        }
+        self.stack.clear();
+        self.slots.clear();
+        self.slots.resize(self.locals, 0.0);
+        self.frames.clear();
+
+        let stack = &mut self.stack;
+        let slots = &mut self.slots;
+        let frames = &mut self.frames;
+        let truthy = |x: f64| x != 0.0;
+        let flag = |b: bool| if b { 1.0 } else { 0.0 };
+
+        // Scalar arguments live at the bottom of the current frame's stack
+        if let Params::Scalars(_) = self.params {
+            stack.extend_from_slice(args);
+        }
+        let mut arg_base = 0;
+        let mut slot_base = 0;
+        let mut ticks = 0u32;
+        let mut past_deadline = || {
+            ticks = ticks.wrapping_add(1);
+            ticks % DEADLINE_STRIDE == 0 && deadline.map_or(false, |deadline| Instant::now() >= deadline)
+        };
+
+        let mut pc = 0;
+        loop {
+            if pc == self.code.len() {
+                let result = stack.pop()?;
+                let Some(frame) = frames.pop() else {
+                    return Some(result);
+                };
+                stack.truncate(arg_base);
+                stack.push(result);
+                slots.truncate(slot_base);
+                (pc, arg_base, slot_base) = (frame.return_pc, frame.args, frame.slots);
+                continue;
+            }
+            let op = self.code[pc];
+            pc += 1;
+            match op {
+                Op::Const(x) => stack.push(x),
+                Op::Arg(i) => {
+                    let x = stack[arg_base + i];
+                    stack.push(x);
+                }
+                Op::Element(i) => stack.push(*args.get(i)?),
+                Op::Load(i) => stack.push(slots[slot_base + i]),
+                Op::Store(i) => slots[slot_base + i] = stack.pop()?,
+                Op::Pop => {
+                    stack.pop()?;
+                }
+                Op::Neg => {
+                    let x = stack.pop()?;
+                    stack.push(-x);
+                }
+                Op::Not => {
+                    let x = stack.pop()?;
+                    stack.push(flag(!truthy(x)));
+                }
+                Op::Unary(f) => {
+                    let x = stack.pop()?;
+                    stack.push(f(x));
+                }
+                Op::Min(n) | Op::Max(n) => {
+                    let start = stack.len().checked_sub(n)?;
+                    let mut acc = stack[start];
+                    for &x in &stack[start + 1..] {
+                        if matches!(op, Op::Min(_)) && x < acc || matches!(op, Op::Max(_)) && x > acc {
+                            acc = x;
+                        }
+                    }
+                    stack.truncate(start);
+                    stack.push(acc);
+                }
+                Op::Jump(target) => pc = target,
+                Op::JumpIfFalse(target) => {
+                    if !truthy(stack.pop()?) {
+                        pc = target;
+                    }
+                }
+                Op::Rec(n) => {
+                    if frames.len() >= MAX_REC_DEPTH || past_deadline() {
+                        return None;
+                    }
+                    frames.push(Frame { return_pc: pc, args: arg_base, slots: slot_base });
+                    arg_base = stack.len().checked_sub(n)?;
+                    slot_base = slots.len();
+                    slots.resize(slot_base + self.locals, 0.0);
+                    pc = 0;
+                }
+                Op::TailRec(n) => {
+                    if past_deadline() {
+                        return None;
+                    }
+                    let start = stack.len().checked_sub(n)?;
+                    stack.copy_within(start.., arg_base);
+                    stack.truncate(arg_base + n);
+                    pc = 0;
+                }
+                Op::Bail => return None,
+                binary => {
+                    let b = stack.pop()?;
+                    let a = stack.pop()?;
+                    stack.push(match binary {
+                        Op::Add => a + b,
+                        Op::Sub => a - b,
+                        Op::Mul => a * b,
+                        Op::Div if b == 0.0 => return None,
+                        Op::Div => a / b,
+                        Op::Mod if b == 0.0 => return None,
+                        Op::Mod => a % b,
+                        Op::Pow => a.powf(b),
+                        Op::Gt => flag(a > b),
+                        Op::Lt => flag(a < b),
+                        Op::Gte => flag(a >= b),
+                        Op::Lte => flag(a <= b),
+                        Op::Eq => flag(a == b),
+                        Op::Neq => flag(a != b),
+                        Op::And => flag(truthy(a) && truthy(b)),
+                        Op::Or => flag(truthy(a) || truthy(b)),
+                        Op::Binary(f) => f(a, b),
+                        _ => unreachable!("non-binary op {:?}", binary),
+                    });
+                }
+            }
+        }
+    }
+}
+
+/// Math builtins with an exact `f64` equivalent
+fn unary_builtin(name: &str) -> Option<fn(f64) -> f64> {
+    Some(match name {
+        "sin" => f64::sin,
+        "cos" => f64::cos,
+        "tan" => f64::tan,
+        "asin" => f64::asin,
+        "acos" => f64::acos,
+        "atan" => f64::atan,
+        "sinh" => f64::sinh,
+        "cosh" => f64::cosh,
+        "tanh" => f64::tanh,
+        "exp" => f64::exp,
+        "ln" | "log" => f64::ln,
+        "log10" => f64::log10,
+        "log2" => f64::log2,
+        "sqrt" => f64::sqrt,
+        "cbrt" => f64::cbrt,
+        "floor" => f64::floor,
+        "ceil" => f64::ceil,
+        "round" => f64::round,
+        "trunc" => f64::trunc,
+        "abs" => f64::abs,
+        "deg" => f64::to_degrees,
+        "rad" => f64::to_radians,
+        "sign" => |x: f64| {
+            if x > 0.0 {
+                1.0
+            } else if x < 0.0 {
+                -1.0
+            } else {
+                0.0
+            }
+        },
+        _ => return None,
+    })
+}
+
+fn binary_builtin(name: &str) -> Option<fn(f64, f64) -> f64> {
+    Some(match name {
+        "pow" => f64::powf,
+        "atan2" => f64::atan2,
+        _ => return None,
+    })
+}
+
+/// Single-pass compiler from a lambda body to [`Op`]s
+struct Compiler<'a> {
+    evaluator: &'a Evaluator,
+    env: &'a Environment,
+    params: &'a [String],
+    vector: bool,
+    /// The program outlives this call, so captures must not change
+    stable: bool,
+    /// Immutable `let` bindings of the enclosing blocks, innermost last
+    scopes: Vec<Vec<(String, usize)>>,
+    locals: usize,
+    code: Vec<Op>,
+}
+
+impl Compiler<'_> {
+    fn emit(&mut self, op: Op) -> usize {
+        self.code.push(op);
+        self.code.len() - 1
+    }
+
+    fn patch(&mut self, at: usize) {
+        let target = self.code.len();
+        match &mut self.code[at] {
+            Op::Jump(t) | Op::JumpIfFalse(t) => *t = target,
+            _ => unreachable!("patching a non-jump"),
+        }
+    }
+
+    /// Turn each `rec` call whose result is the lambda's result into a
+    /// `TailRec`: nothing runs after it but jumps to the end of the program
+    fn mark_tail_calls(&mut self) {
+        let end = self.code.len();
+        for pc in 0..end {
+            let Op::Rec(n) = self.code[pc] else {
+                continue;
+            };
+            let mut next = pc + 1;
+            while let Some(Op::Jump(target)) = self.code.get(next) {
+                next = *target;
+            }
+            if next == end {
+                self.code[pc] = Op::TailRec(n);
+            }
+        }
+    }
+
+    fn number(&mut self, node: &AstNode) -> Option<()> {
+        (self.expr(node)? == Kind::Number).then_some(())
+    }
+
+    /// Conditions accept numbers and booleans, like `value_to_bool`
+    fn condition(&mut self, node: &AstNode) -> Option<()> {
+        self.expr(node).map(|_| ())
+    }
+
+    fn expr(&mut self, node: &AstNode) -> Option<Kind> {
+        match node {
+            AstNode::Number(n) => {
+                self.emit(Op::Const(*n));
+                Some(Kind::Number)
+            }
+            AstNode::Boolean(b) => {
+                self.emit(Op::Const(if *b { 1.0 } else { 0.0 }));
+                Some(Kind::Boolean)
+            }
+            AstNode::VariableRef(name) | AstNode::LocalRef { name, .. } => self.variable(name),
+            AstNode::BinaryOp { op, left, right } => self.binary(op, left, right),
+            AstNode::UnaryOp { op: UnaryOp::Negate, operand } => {
+                self.number(operand)?;
+                self.emit(Op::Neg);
+                Some(Kind::Number)
+            }
+            AstNode::UnaryOp { op: UnaryOp::Not, operand } => {
+                self.condition(operand)?;
+                self.emit(Op::Not);
+                Some(Kind::Boolean)
+            }
+            AstNode::If { condition, then_expr, else_expr } => {
+                self.condition(condition)?;
+                let skip_then = self.emit(Op::JumpIfFalse(0));
+                let then_kind = self.expr(then_expr)?;
+                let skip_else = self.emit(Op::Jump(0));
+                self.patch(skip_then);
+                let else_kind = self.expr(else_expr)?;
+                self.patch(skip_else);
+                (then_kind == else_kind).then_some(then_kind)
+            }
+            AstNode::Piecewise { cases, default } => {
+                let mut kind = None;
+                let mut exits = Vec::new();
+                for (condition, value) in cases {
+                    self.condition(condition)?;
+                    let next = self.emit(Op::JumpIfFalse(0));
+                    let case_kind = self.expr(value)?;
+                    if kind.replace(case_kind).is_some_and(|k| k != case_kind) {
+                        return None;
+                    }
+                    exits.push(self.emit(Op::Jump(0)));
+                    self.patch(next);
+                }
+                match default {
+                    Some(value) => {
+                        let default_kind = self.expr(value)?;
+                        if kind.replace(default_kind).is_some_and(|k| k != default_kind) {
+                            return None;
+                        }
+                    }
+                    // No case matched: the interpreter reports the error
+                    None => {
+                        self.emit(Op::Bail);
+                    }
+                }
+                for exit in exits {
+                    self.patch(exit);
+                }
+                kind
+            }
+            AstNode::FunctionCall { name, args } => self.call(name, args),
+            AstNode::CallExpression { callee, args } => match &**callee {
+                AstNode::VariableRef(name) => self.call(name, args),
+                AstNode::RecReference => self.rec(args),
+                _ => None,
+            },
+            AstNode::IndexAccess { object, indices } if self.vector => {
+                // Only `p[k]` with a literal index on the vector parameter
+                let (AstNode::VariableRef(name) | AstNode::LocalRef { name, .. }, [IndexArg::Single(index)]) = (&**object, indices.as_slice()) else {
+                    return None;
+                };
+                let AstNode::Number(k) = **index else {
+                    return None;
+                };
+                if name != &self.params[0] || self.local(name).is_some() || k < 0.0 || k.fract() != 0.0 {
+                    return None;
+                }
+                self.emit(Op::Element(k as usize));
+                Some(Kind::Number)
+            }
+            AstNode::DoBlock { statements } | AstNode::Sequence { statements } => self.block(statements),
+            _ => None,
+        }
+    }
+
+    fn block(&mut self, statements: &[AstNode]) -> Option<Kind> {
+        let (last, init) = statements.split_last()?;
+        self.scopes.push(Vec::new());
+        for statement in init {
+            match statement {
+                AstNode::VariableDecl { name, type_annotation, initializer } => {
+                    // Shadowing rules are left to the interpreter
+                    let shadows = self.local(name).is_some() || self.params.contains(name);
+                    if shadows || !matches!(type_annotation, None | Some(TypeAnnotation::Number)) {
+                        return None;
+                    }
+                    self.number(initializer)?;
+                    let slot = self.locals;
+                    self.locals += 1;
+                    self.emit(Op::Store(slot));
+                    self.scopes.last_mut()?.push((name.clone(), slot));
+                }
+                other => {
+                    self.expr(other)?;
+                    self.emit(Op::Pop);
+                }
+            }
+        }
+        if matches!(last, AstNode::VariableDecl { .. }) {
+            return None;
+        }
+        let kind = self.expr(last)?;
+        self.scopes.pop();
+        Some(kind)
+    }
+
+    fn local(&self, name: &str) -> Option<usize> {
+        self.scopes
+            .iter()
+            .rev()
+            .find_map(|scope| scope.iter().rev().find(|(n, _)| n == name).map(|&(_, slot)| slot))
+    }
+
+    /// Locals, then parameters, then captured numbers, then constants
+    fn variable(&mut self, name: &str) -> Option<Kind> {
+        if let Some(slot) = self.local(name) {
+            self.emit(Op::Load(slot));
+            return Some(Kind::Number);
+        }
+        if let Some(i) = self.params.iter().position(|p| p == name) {
+            if self.vector {
+                return None;
+            }
+            self.emit(Op::Arg(i));
+            return Some(Kind::Number);
+        }
+        if self.env.has(name) {
+            if self.stable && self.env.is_mutable(name) {
+                return None;
+            }
+            return match self.env.get(name).ok()? {
+                Value::Number(n) => {
+                    self.emit(Op::Const(n));
+                    Some(Kind::Number)
+                }
+                Value::Boolean(b) => {
+                    self.emit(Op::Const(if b { 1.0 } else { 0.0 }));
+                    Some(Kind::Boolean)
+                }
+                _ => None,
+            };
+        }
+        if name.to_lowercase() == "i" {
+            return None;
+        }
+        let constant = self.evaluator.constants().get(name).ok()?;
+        self.emit(Op::Const(constant));
+        Some(Kind::Number)
+    }
+
+    fn call(&mut self, name: &str, args: &[AstNode]) -> Option<Kind> {
+        // Parameters, locals and captured values shadow the builtins
+        let name = if self.local(name).is_some() || self.params.iter().any(|p| p == name) {
+            return None;
+        } else if self.env.has(name) {
+            if self.stable && self.env.is_mutable(name) {
+                return None;
+            }
+            match self.env.get(name).ok()? {
+                Value::Function(f) => match &*f {
+                    Function::Builtin(builtin) => builtin.clone(),
+                    _ => return None,
+                },
+                _ => return None,
+            }
+        } else {
+            name.to_string()
+        };
+
+        for arg in args {
+            self.number(arg)?;
+        }
+        let op = match (name.as_str(), args.len()) {
+            ("min", n) if n >= 2 => Op::Min(n),
+            ("max", n) if n >= 2 => Op::Max(n),
+            (name, 1) => Op::Unary(unary_builtin(name)?),
+            (name, 2) => Op::Binary(binary_builtin(name)?),
+            _ => return None,
+        };
+        self.emit(op);
+        Some(Kind::Number)
+    }
+
+    /// `rec(...)`: a call of this lambda, whose result is a number since
+    /// the whole body must be one
+    fn rec(&mut self, args: &[AstNode]) -> Option<Kind> {
+        if self.vector || args.len() != self.params.len() {
+            return None;
+        }
+        for arg in args {
+            self.number(arg)?;
+        }
+        self.emit(Op::Rec(args.len()));
+        Some(Kind::Number)
+    }
+
+    fn binary(&mut self, op: &BinaryOp, left: &AstNode, right: &AstNode) -> Option<Kind> {
+        let (code, result) = match op {
+            BinaryOp::Add => (Op::Add, Kind::Number),
+            BinaryOp::Subtract => (Op::Sub, Kind::Number),
+            BinaryOp::Multiply => (Op::Mul, Kind::Number),
+            BinaryOp::Divide => (Op::Div, Kind::Number),
+            BinaryOp::Modulo => (Op::Mod, Kind::Number),
+            BinaryOp::Power => (Op::Pow, Kind::Number),
+            BinaryOp::Gt => (Op::Gt, Kind::Boolean),
+            BinaryOp::Lt => (Op::Lt, Kind::Boolean),
+            BinaryOp::Gte => (Op::Gte, Kind::Boolean),
+            BinaryOp::Lte => (Op::Lte, Kind::Boolean),
+            BinaryOp::Eq | BinaryOp::Neq => {
+                // Same-kind operands only, like `apply_eq`
+                let left_kind = self.expr(left)?;
+                if self.expr(right)? != left_kind {
+                    return None;
+                }
+                self.emit(if *op == BinaryOp::Eq { Op::Eq } else { Op::Neq });
+                return Some(Kind::Boolean);
+            }
+            BinaryOp::And | BinaryOp::Or => {
+                // Both sides are evaluated, like `apply_and` / `apply_or`
+                self.condition(left)?;
+                self.condition(right)?;
+                self.emit(if *op == BinaryOp::And { Op::And } else { Op::Or });
+                return Some(Kind::Boolean);
+            }
+        };
+        self.number(left)?;
+        self.number(right)?;
+        self.emit(code);
+        Some(result)
+    }
+}
+
+/// [`LambdaEvaluator`] that runs compiled lambdas natively and everything
+/// else on the wrapped [`Evaluator`]
+///
+/// Meant to live for a single numerical builtin call; each distinct lambda
+/// it sees is compiled once, on first use.
+pub struct NativeEvaluator<'a> {
+    evaluator: &'a mut Evaluator,
+    compiled: Vec<Compiled>,
+}
+
+/// Compilation result for one lambda, keyed by body and closure identity
+struct Compiled {
+    body: Rc<AstNode>,
+    env: Rc<RefCell<Environment>>,
+    vector: bool,
+    native: Option<NativeLambda>,
+}
+
+impl<'a> NativeEvaluator<'a> {
+    pub fn new(evaluator: &'a mut Evaluator) -> Self {
+        Self {
+            evaluator,
+            compiled: Vec::new(),
+        }
+    }
+
+    /// Whether `func` runs natively when called with `vector` arguments
+    pub fn is_native(&mut self, func: &Function, vector: bool) -> bool {
+        self.lookup(func, vector).is_some()
+    }
+
+    fn lookup(&mut self, func: &Function, vector: bool) -> Option<&mut NativeLambda> {
+        let Function::UserDefined { body, closure_env, .. } = func else {
+            return None;
+        };
+        let position = self
+            .compiled
+            .iter()
+            .position(|c| c.vector == vector && Rc::ptr_eq(&c.body, body) && Rc::ptr_eq(&c.env, closure_env));
+        let index = match position {
+            Some(index) => index,
+            None => {
+                let native = if vector {
+                    NativeLambda::compile_vector(self.evaluator, func)
+                } else {
+                    NativeLambda::compile(self.evaluator, func)
+                };
+                self.compiled.push(Compiled {
+                    body: body.clone(),
+                    env: closure_env.clone(),
+                    vector,
+                    native,
+                });
+                self.compiled.len() - 1
+            }
+        };
+        self.compiled[index].native.as_mut()
+    }
+}
+
+impl LambdaEvaluator for NativeEvaluator<'_> {
+    fn eval_at(&mut self, func: &Function, x: f64) -> Result<f64, String> {
+        let deadline = self.evaluator.deadline();
+        match self.lookup(func, false).and_then(|native| native.call_until(&[x], deadline)) {
+            Some(y) => Ok(y),
+            None => self.evaluator.eval_at(func, x),
+        }
+    }
+
+    fn eval_vec_at(&mut self, func: &Function, point: &[f64]) -> Result<f64, String> {
+        let deadline = self.evaluator.deadline();
+        match self.lookup(func, true).and_then(|native| native.call_until(point, deadline)) {
+            Some(y) => Ok(y),
+            None => self.evaluator.eval_vec_at(func, point),
+        }
+    }
+
+    fn eval_at_nd(&mut self, func: &Function, args: &[f64]) -> Result<f64, String> {
+        let deadline = self.evaluator.deadline();
+        match self.lookup(func, false).and_then(|native| native.call_until(args, deadline)) {
+            Some(y) => Ok(y),
+            None => self.evaluator.eval_at_nd(func, args),
+        }
+    }
+}
@@ -0,0 +1,87 @@
+//! Check-free calls of lambdas with a proven numeric signature
+//!
+//! When every parameter of a lambda is annotated `Number` and its body
+//! compiles to a [`NativeLambda`], the compiler has proven that the body
+//! returns a number for any numeric arguments. A call whose arguments are
+//! all numbers then skips the parameter and return type checks, the scope
+//! set-up and the `Value` arithmetic of the tree-walker:
+//!
+//! ```text
+//! let hypot = (x: Number, y: Number): Number => sqrt(x ^ 2 + y ^ 2)
+//! let fact = (n: Number): Number => if(n <= 1, 1, n * rec(n - 1))
+//! ```
+//!
+//! Programs are compiled on the first call of each closure and cached with
+//! it, so a library of annotated functions pays the compilation once. A
+//! call the program can't finish (division by zero, too deep a recursion)
+//! or one with a non-number argument takes the regular path, so results and
+//! error messages are unchanged. `rec` calls inside a native program don't
+//! go back through `apply_lambda`, so the profiler only sees the outer call.
+
+use std::cell::RefCell;
+use std::rc::Rc;
+
+use achronyme_parser::ast::AstNode;
+use achronyme_types::function::Function;
+use achronyme_types::value::Value;
+use achronyme_types::Environment;
+
+use crate::evaluator::Evaluator;
+
+use super::NativeLambda;
+
+/// Upper bound on cached specialized closures before the cache is reset
+const MAX_SPECIALIZED_FUNCTIONS: usize = 1024;
+
+/// Lambdas with more parameters than this are never specialized
+const MAX_SPECIALIZED_ARITY: usize = 8;
+
+/// Specialization of one closure, keyed by body and closure identity
+pub(crate) struct Specialized {
+    /// Kept alive so their addresses can't be reused by another closure
+    _body: Rc<AstNode>,
+    _env: Rc<RefCell<Environment>>,
+    /// None if the body can't be compiled
+    native: Option<NativeLambda>,
+}
+
+impl Evaluator {
+    /// Result of calling `function` on its specialized path, or None when
+    /// the call must go through the regular one
+    pub(crate) fn specialized_call(&mut self, function: &Function, args: &[Value]) -> Option<Value> {
+        let Function::UserDefined { params, param_types, body, closure_env, .. } = function else {
+            return None;
+        };
+        if params.is_empty() || params.len() > MAX_SPECIALIZED_ARITY || args.len() != params.len() {
+            return None;
+        }
+        // Only annotated lambdas are worth a cache lookup
+        if param_types.iter().any(Option::is_none) {
+            return None;
+        }
+
+        let mut numbers = [0.0; MAX_SPECIALIZED_ARITY];
+        for (slot, arg) in numbers.iter_mut().zip(args) {
+            match arg {
+                Value::Number(n) => *slot = *n,
+                _ => return None,
+            }
+        }
+
+        let key = (Rc::as_ptr(body) as usize, Rc::as_ptr(closure_env) as usize);
+        if !self.specialized_functions.contains_key(&key) {
+            let native = NativeLambda::compile_specialized(self, function);
+            if self.specialized_functions.len() >= MAX_SPECIALIZED_FUNCTIONS {
+                self.specialized_functions.clear();
+            }
+            self.specialized_functions.insert(
+                key,
+                Specialized { _body: body.clone(), _env: closure_env.clone(), native },
+            );
+        }
+
+        let deadline = self.deadline;
+        let native = self.specialized_functions.get_mut(&key)?.native.as_mut()?;
+        native.call_until(&numbers[..args.len()], deadline).map(Value::Number)
+    }
+}
@@ -0,0 +1,407 @@
+//! Evaluator profiler
+//!
+//! With profiling enabled (`Evaluator::set_profiling`), every call to a
+//! user-defined function or a registry builtin is timed as a frame on a call
+//! stack. Each frame's time is split into inclusive time (the whole call)
+//! and exclusive time (the call minus the frames it called), and the tensor
+//! buffers it allocated are counted the same way. Time spent parsing,
+//! evaluating and type checking is accumulated separately.
+//!
+//! Results come out as a table sorted by exclusive time ([`Profiler::report`])
+//! and as folded stacks ([`Profiler::folded_stacks`]), one `a;b;c <µs>` line
+//! per call path, the input format of flamegraph tools.
+//!
+//! When profiling is disabled the hooks reduce to a check of
+//! `Evaluator::profiler`, and tensor allocation counting is off.
+
+use achronyme_parser::ast::AstNode;
+use achronyme_types::function::Function;
+use achronyme_types::tensor::allocations;
+use achronyme_types::value::Value;
+use std::collections::HashMap;
+use std::fmt::Write;
+use std::rc::Rc;
+use std::time::{Duration, Instant};
+
+use crate::evaluator::Evaluator;
+
+/// Name of the frame for top-level statements
+const SCRIPT_FRAME: &str = "<script>";
+/// Name of user-defined functions that were never bound to a name
+const ANONYMOUS_FRAME: &str = "<lambda>";
+
+/// What a profiled frame is
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum CallKind {
+    /// Top-level statements of `eval_str`
+    Script,
+    /// User-defined function
+    Function,
+    /// Module or FunctionRegistry builtin
+    Builtin,
+}
+
+impl CallKind {
+    fn label(self) -> &'static str {
+        match self {
+            CallKind::Script => "script",
+            CallKind::Function => "function",
+            CallKind::Builtin => "builtin",
+        }
+    }
+}
+
+/// Totals for one function or builtin
+#[derive(Debug, Clone)]
+pub struct ProfileEntry {
+    pub name: String,
+    pub kind: CallKind,
+    pub calls: u64,
+    /// Time from call to return; recursive calls are counted once
+    pub inclusive: Duration,
+    /// Inclusive time minus the time of the frames it called
+    pub exclusive: Duration,
+    /// Tensor buffers allocated by the function itself
+    pub tensor_allocations: u64,
+    /// Frames of this entry currently on the stack
+    active: u32,
+}
+
+/// Time by evaluation phase
+#[derive(Debug, Clone, Copy, Default)]
+pub struct PhaseTimes {
+    pub parse: Duration,
+    /// Evaluation of top-level statements, without type checking
+    pub evaluate: Duration,
+    pub type_check: Duration,
+}
+
+/// Evaluation phase timed with `Evaluator::profile_phase`
+#[derive(Debug, Clone, Copy)]
+pub(crate) enum Phase {
+    Parse,
+    TypeCheck,
+}
+
+/// One node of the call tree behind the folded stacks
+struct StackNode {
+    entry: usize,
+    parent: Option<usize>,
+    exclusive: Duration,
+}
+
+/// A call in progress
+struct Frame {
+    entry: usize,
+    node: usize,
+    start: Instant,
+    children: Duration,
+    allocations_at_start: u64,
+    child_allocations: u64,
+}
+
+/// Call-stack profiler attached to an `Evaluator`
+pub struct Profiler {
+    entries: Vec<ProfileEntry>,
+    /// Entry index by name, one map per `CallKind`
+    entry_ids: [HashMap<String, usize>; 3],
+    nodes: Vec<StackNode>,
+    node_ids: HashMap<(Option<usize>, usize), usize>,
+    stack: Vec<Frame>,
+    /// Names of user-defined functions, keyed by the address of their body
+    /// (the body is kept alive so the address can't be reused)
+    function_names: HashMap<usize, (Rc<AstNode>, usize)>,
+    parse: Duration,
+    evaluate: Duration,
+    type_check: Duration,
+    allocations_at_start: u64,
+}
+
+impl Profiler {
+    /// Empty profile; counting starts now
+    pub fn new() -> Self {
+        Self {
+            entries: Vec::new(),
+            entry_ids: Default::default(),
+            nodes: Vec::new(),
+            node_ids: HashMap::new(),
+            stack: Vec::new(),
+            function_names: HashMap::new(),
+            parse: Duration::ZERO,
+            evaluate: Duration::ZERO,
+            type_check: Duration::ZERO,
+            allocations_at_start: allocations::allocation_count(),
+        }
+    }
+
+    fn entry_id(&mut self, kind: CallKind, name: &str) -> usize {
+        if let Some(&id) = self.entry_ids[kind as usize].get(name) {
+            return id;
+        }
+        let id = self.entries.len();
+        self.entries.push(ProfileEntry {
+            name: name.to_string(),
+            kind,
+            calls: 0,
+            inclusive: Duration::ZERO,
+            exclusive: Duration::ZERO,
+            tensor_allocations: 0,
+            active: 0,
+        });
+        self.entry_ids[kind as usize].insert(name.to_string(), id);
+        id
+    }
+
+    /// Remember the name a user-defined function was bound to
+    ///
+    /// The first name sticks, so `let g = f` keeps profiling f's body as f.
+    pub(crate) fn name_function(&mut self, function: &Function, name: &str) {
+        if let Function::UserDefined { body, .. } = function {
+            let key = Rc::as_ptr(body) as usize;
+            if !self.function_names.contains_key(&key) {
+                let entry = self.entry_id(CallKind::Function, name);
+                self.function_names.insert(key, (body.clone(), entry));
+            }
+        }
+    }
+
+    fn function_entry(&mut self, function: &Function) -> usize {
+        match function {
+            Function::UserDefined { body, .. } => match self.function_names.get(&(Rc::as_ptr(body) as usize)) {
+                Some(&(_, entry)) => entry,
+                None => self.entry_id(CallKind::Function, ANONYMOUS_FRAME),
+            },
+            Function::Builtin(name) => self.entry_id(CallKind::Builtin, name),
+        }
+    }
+
+    fn enter(&mut self, entry: usize) {
+        let parent = self.stack.last().map(|frame| frame.node);
+        let node = match self.node_ids.get(&(parent, entry)) {
+            Some(&node) => node,
+            None => {
+                let node = self.nodes.len();
+                self.nodes.push(StackNode { entry, parent, exclusive: Duration::ZERO });
+                self.node_ids.insert((parent, entry), node);
+                node
+            }
+        };
+        self.entries[entry].active += 1;
+        self.stack.push(Frame {
+            entry,
+            node,
+            start: Instant::now(),
+            children: Duration::ZERO,
+            allocations_at_start: allocations::allocation_count(),
+            child_allocations: 0,
+        });
+    }
+
+    fn exit(&mut self) -> Duration {
+        let frame = self.stack.pop().expect("profiler exit without a matching enter");
+        let elapsed = frame.start.elapsed();
+        let exclusive = elapsed.saturating_sub(frame.children);
+        let allocated = allocations::allocation_count() - frame.allocations_at_start;
+
+        let entry = &mut self.entries[frame.entry];
+        entry.calls += 1;
+        entry.exclusive += exclusive;
+        entry.tensor_allocations += allocated - frame.child_allocations;
+        entry.active -= 1;
+        if entry.active == 0 {
+            entry.inclusive += elapsed;
+        }
+        self.nodes[frame.node].exclusive += exclusive;
+
+        if let Some(parent) = self.stack.last_mut() {
+            parent.children += elapsed;
+            parent.child_allocations += allocated;
+        }
+        elapsed
+    }
+
+    /// Totals per function and builtin, most exclusive time first
+    pub fn entries(&self) -> Vec<ProfileEntry> {
+        let mut entries: Vec<ProfileEntry> = self.entries.iter().filter(|e| e.calls > 0).cloned().collect();
+        entries.sort_by(|a, b| b.exclusive.cmp(&a.exclusive).then_with(|| a.name.cmp(&b.name)));
+        entries
+    }
+
+    /// Totals for one function or builtin by name
+    pub fn entry(&self, name: &str) -> Option<ProfileEntry> {
+        self.entries.iter().find(|e| e.name == name && e.calls > 0).cloned()
+    }
+
+    /// Time spent parsing, evaluating and type checking
+    pub fn phases(&self) -> PhaseTimes {
+        PhaseTimes {
+            parse: self.parse,
+            evaluate: self.evaluate.saturating_sub(self.type_check),
+            type_check: self.type_check,
+        }
+    }
+
+    /// Tensor buffers allocated since profiling started
+    pub fn tensor_allocations(&self) -> u64 {
+        allocations::allocation_count() - self.allocations_at_start
+    }
+
+    /// Phase times followed by a table of functions and builtins, sorted by
+    /// exclusive time
+    pub fn report(&self) -> String {
+        let phases = self.phases();
+        let mut out = String::new();
+        let _ = writeln!(out, "Profile");
+        let _ = writeln!(out, "  parse       {:>12}", format_ms(phases.parse));
+        let _ = writeln!(out, "  evaluate    {:>12}", format_ms(phases.evaluate));
+        let _ = writeln!(out, "  type check  {:>12}", format_ms(phases.type_check));
+        let _ = writeln!(out, "  tensor allocations: {}", self.tensor_allocations());
+        let _ = writeln!(out);
+        let _ = writeln!(
+            out,
+            "{:>10} {:>14} {:>14} {:>10}  {:<9} {}",
+            "calls", "inclusive", "exclusive", "tensors", "kind", "name"
+        );
+        for entry in self.entries() {
+            let _ = writeln!(
+                out,
+                "{:>10} {:>14} {:>14} {:>10}  {:<9} {}",
+                entry.calls,
+                format_ms(entry.inclusive),
+                format_ms(entry.exclusive),
+                entry.tensor_allocations,
+                entry.kind.label(),
+                entry.name
+            );
+        }
+        out
+    }
+
+    /// Folded stacks: one `caller;callee <exclusive µs>` line per call path
+    ///
+    /// Feed to `flamegraph.pl`, inferno or speedscope.
+    pub fn folded_stacks(&self) -> String {
+        let mut lines: Vec<(String, u128)> = Vec::new();
+        for (id, node) in self.nodes.iter().enumerate() {
+            let micros = node.exclusive.as_micros();
+            if micros == 0 {
+                continue;
+            }
+            let mut names = Vec::new();
+            let mut current = Some(id);
+            while let Some(i) = current {
+                names.push(self.entries[self.nodes[i].entry].name.as_str());
+                current = self.nodes[i].parent;
+            }
+            names.reverse();
+            lines.push((names.join(";"), micros));
+        }
+        lines.sort();
+
+        let mut out = String::new();
+        for (stack, micros) in lines {
+            let _ = writeln!(out, "{} {}", stack, micros);
+        }
+        out
+    }
+}
+
+impl Default for Profiler {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+fn format_ms(duration: Duration) -> String {
+    format!("{:.3} ms", duration.as_secs_f64() * 1000.0)
+}
+
+/// Profiling hooks
+///
+/// Each hook runs its closure directly when profiling is off.
+impl Evaluator {
+    /// Run `f` as a frame of the given user-defined function or builtin
+    #[inline]
+    pub(crate) fn profile_function<T>(&mut self, function: &Function, f: impl FnOnce(&mut Self) -> T) -> T {
+        match self.profiler.as_mut() {
+            None => f(self),
+            Some(profiler) => {
+                let entry = profiler.function_entry(function);
+                self.profiled(entry, f)
+            }
+        }
+    }
+
+    /// Run `f` as a frame of the named registry builtin
+    #[inline]
+    pub(crate) fn profile_builtin<T>(&mut self, name: &str, f: impl FnOnce(&mut Self) -> T) -> T {
+        match self.profiler.as_mut() {
+            None => f(self),
+            Some(profiler) => {
+                let entry = profiler.entry_id(CallKind::Builtin, name);
+                self.profiled(entry, f)
+            }
+        }
+    }
+
+    /// Run top-level statements, timed as the evaluate phase
+    ///
+    /// Nested calls (an `eval_str` from inside a running program) are part
+    /// of the frame that made them.
+    #[inline]
+    pub(crate) fn profile_script<T>(&mut self, f: impl FnOnce(&mut Self) -> T) -> T {
+        match self.profiler.as_mut() {
+            Some(profiler) if profiler.stack.is_empty() => {
+                let entry = profiler.entry_id(CallKind::Script, SCRIPT_FRAME);
+                profiler.enter(entry);
+                let result = f(self);
+                if let Some(profiler) = self.profiler.as_mut() {
+                    let elapsed = profiler.exit();
+                    profiler.evaluate += elapsed;
+                }
+                result
+            }
+            _ => f(self),
+        }
+    }
+
+    /// Run `f`, adding its time to a phase
+    #[inline]
+    pub(crate) fn profile_phase<T>(&mut self, phase: Phase, f: impl FnOnce(&mut Self) -> T) -> T {
+        if self.profiler.is_none() {
+            return f(self);
+        }
+        let start = Instant::now();
+        let result = f(self);
+        if let Some(profiler) = self.profiler.as_mut() {
+            match phase {
+                Phase::Parse => profiler.parse += start.elapsed(),
+                Phase::TypeCheck => profiler.type_check += start.elapsed(),
+            }
+        }
+        result
+    }
+
+    /// Remember the name a function value is bound to or called by, for
+    /// its frames
+    #[inline]
+    pub(crate) fn profile_name(&mut self, name: &str, value: &Value) {
+        if let (Some(profiler), Value::Function(function)) = (self.profiler.as_mut(), value) {
+            profiler.name_function(function, name);
+        }
+    }
+
+    fn profiled<T>(&mut self, entry: usize, f: impl FnOnce(&mut Self) -> T) -> T {
+        if let Some(profiler) = self.profiler.as_mut() {
+            profiler.enter(entry);
+        }
+        let result = f(self);
+        // The closure may have turned profiling off
+        if let Some(profiler) = self.profiler.as_mut() {
+            if !profiler.stack.is_empty() {
+                profiler.exit();
+            }
+        }
+        result
+    }
+}
@@ -0,0 +1,568 @@
+//! Lexical slot resolution of lambda bodies
+//!
+//! A call of a user-defined function binds its parameters, in order, in a
+//! fresh scope, and every block of the body (`Sequence`, `do { }`, a for-in
+//! loop, a catch clause, a match arm) runs in one more scope on top. For
+//! most references it is therefore known when the lambda is created which
+//! scope, and which slot in it, holds the binding: a parameter, or a `let` /
+//! `mut` that is a statement of an enclosing block. Those references become
+//! `AstNode::LocalRef { depth, index }` and are read with
+//! `Environment::get_slot`, without searching any scope by name.
+//!
+//! Everything else stays a `VariableRef` looked up by name:
+//! - free variables (globals, captures, builtins)
+//! - names a scope may bind at a slot that isn't known statically: a `let`
+//!   inside a loop body or an `if` branch, pattern variables, imports, and
+//!   any name at all in a scope where `restore_env` runs
+//! - references inside nested lambdas and generate blocks, which are
+//!   resolved when they are created (generators run on their own scopes)
+//! - assignment targets and callees, whose handlers work by name
+//!
+//! A resolved slot is still checked to hold the expected name when it is
+//! read; a mismatch falls back to the lookup by name.
+
+use achronyme_parser::ast::{
+    ArrayElement, AstNode, IndexArg, MatchArm, Pattern, RecordFieldOrSpread, VectorPatternElement,
+};
+use achronyme_types::Symbol;
+
+/// Builtins that define bindings in the scope they are called from
+const BINDING_BUILTINS: &[&str] = &["restore_env"];
+
+/// What the resolver knows about one runtime scope
+#[derive(Default)]
+struct Scope {
+    /// Names bound at a known slot, in slot order
+    slots: Vec<Symbol>,
+    /// Names that may be bound here at a slot that isn't known
+    uncertain: Vec<Symbol>,
+    /// A binding may already sit at an unknown slot, so new ones can't be
+    /// given a slot either
+    shifted: bool,
+    /// Any name may be bound here
+    opaque: bool,
+}
+
+impl Scope {
+    /// A binding made exactly once, after the previous ones
+    ///
+    /// Redefining a name replaces its slot in place, so a name that already
+    /// has a slot keeps it.
+    fn bind(&mut self, name: Symbol) {
+        if self.slots.contains(&name) {
+            return;
+        }
+        if self.shifted || self.opaque || self.uncertain.contains(&name) {
+            self.bind_uncertain(name);
+        } else {
+            self.slots.push(name);
+        }
+    }
+
+    /// A binding that may happen, more than once or at an unknown slot
+    fn bind_uncertain(&mut self, name: Symbol) {
+        if self.slots.contains(&name) {
+            return;
+        }
+        if !self.uncertain.contains(&name) {
+            self.uncertain.push(name);
+        }
+        self.shifted = true;
+    }
+}
+
+/// Resolve the body of a lambda with these parameters
+pub(crate) fn resolve_lambda(params: &[String], body: &AstNode) -> AstNode {
+    let mut scope = Scope::default();
+    for param in params {
+        scope.bind(Symbol::intern(param));
+    }
+    Resolver { scopes: vec![scope] }.statement(body)
+}
+
+/// Resolve a subtree that runs in scopes the resolver knows nothing about
+///
+/// Used for bytecode `Eval` nodes, which the VM tree-walks under a scope of
+/// captured registers: only bindings of blocks inside `node` keep a slot,
+/// and slots resolved for the enclosing function body are undone.
+pub(crate) fn resolve_detached(node: &AstNode) -> AstNode {
+    let outside = Scope { opaque: true, ..Scope::default() };
+    Resolver { scopes: vec![outside] }.expr(node)
+}
+
+struct Resolver {
+    /// Innermost scope last; never empty
+    scopes: Vec<Scope>,
+}
+
+impl Resolver {
+    fn current(&mut self) -> &mut Scope {
+        self.scopes.last_mut().expect("the resolver always has a scope")
+    }
+
+    fn reference(&self, name: Symbol) -> AstNode {
+        for (depth, scope) in self.scopes.iter().rev().enumerate() {
+            if let Some(index) = scope.slots.iter().position(|&slot| slot == name) {
+                if let (Ok(depth), Ok(index)) = (u32::try_from(depth), u32::try_from(index)) {
+                    return AstNode::LocalRef { name, depth, index };
+                }
+                break;
+            }
+            if scope.opaque || scope.uncertain.contains(&name) {
+                break;
+            }
+        }
+        AstNode::VariableRef(name)
+    }
+
+    /// `statements` run in order in a new scope
+    fn block(&mut self, statements: &[AstNode]) -> Vec<AstNode> {
+        self.scopes.push(Scope::default());
+        let statements = statements.iter().map(|statement| self.statement(statement)).collect();
+        self.scopes.pop();
+        statements
+    }
+
+    /// `nodes` run in a new scope that starts as `scope`, possibly repeatedly
+    fn scoped<const N: usize>(&mut self, scope: Scope, nodes: [&AstNode; N]) -> [AstNode; N] {
+        self.scopes.push(scope);
+        nodes.iter().for_each(|node| self.mark(node));
+        let resolved = nodes.map(|node| self.expr(node));
+        self.scopes.pop();
+        resolved
+    }
+
+    /// `node` runs once in the current scope, after the statements before it
+    fn statement(&mut self, node: &AstNode) -> AstNode {
+        match node {
+            AstNode::VariableDecl { name, type_annotation, initializer } => {
+                self.mark(initializer);
+                let initializer = Box::new(self.expr(initializer));
+                self.current().bind(Symbol::intern(name));
+                AstNode::VariableDecl { name: name.clone(), type_annotation: type_annotation.clone(), initializer }
+            }
+            AstNode::MutableDecl { name, type_annotation, initializer } => {
+                self.mark(initializer);
+                let initializer = Box::new(self.expr(initializer));
+                self.current().bind(Symbol::intern(name));
+                AstNode::MutableDecl { name: name.clone(), type_annotation: type_annotation.clone(), initializer }
+            }
+            _ => {
+                self.mark(node);
+                self.expr(node)
+            }
+        }
+    }
+
+    /// Mark what `node` may bind in the current scope as uncertain before
+    /// resolving it: in a loop, a reference can run after a binding that
+    /// comes later in the source
+    fn mark(&mut self, node: &AstNode) {
+        match node {
+            AstNode::VariableDecl { name, initializer, .. } | AstNode::MutableDecl { name, initializer, .. } => {
+                self.mark(initializer);
+                self.current().bind_uncertain(Symbol::intern(name));
+            }
+            AstNode::Import { items, .. } => {
+                for item in items {
+                    self.current().bind_uncertain(Symbol::intern(item.local_name()));
+                }
+            }
+            AstNode::FunctionCall { name, args } => {
+                if BINDING_BUILTINS.contains(&name.as_str()) {
+                    self.current().opaque = true;
+                }
+                args.iter().for_each(|arg| self.mark(arg));
+            }
+            AstNode::CallExpression { callee, args } => {
+                if let AstNode::VariableRef(name) = &**callee {
+                    if BINDING_BUILTINS.contains(&name.as_str()) {
+                        self.current().opaque = true;
+                    }
+                }
+                self.mark(callee);
+                args.iter().for_each(|arg| self.mark(arg));
+            }
+
+            // Their bindings go to scopes of their own
+            AstNode::Sequence { .. } | AstNode::DoBlock { .. } | AstNode::Lambda { .. } | AstNode::GenerateBlock { .. } => {}
+            AstNode::ForInLoop { iterable, .. } => self.mark(iterable),
+            AstNode::TryCatch { try_block, .. } => self.mark(try_block),
+            AstNode::Match { value, .. } => self.mark(value),
+
+            _ => for_each_child(node, |child| self.mark(child)),
+        }
+    }
+
+    fn boxed(&mut self, node: &AstNode) -> Box<AstNode> {
+        Box::new(self.expr(node))
+    }
+
+    /// `node` with its references resolved, evaluated in the current scope
+    fn expr(&mut self, node: &AstNode) -> AstNode {
+        match node {
+            AstNode::VariableRef(name) | AstNode::LocalRef { name, .. } => self.reference(*name),
+
+            AstNode::VariableDecl { name, type_annotation, initializer } => {
+                let initializer = self.boxed(initializer);
+                self.current().bind_uncertain(Symbol::intern(name));
+                AstNode::VariableDecl { name: name.clone(), type_annotation: type_annotation.clone(), initializer }
+            }
+            AstNode::MutableDecl { name, type_annotation, initializer } => {
+                let initializer = self.boxed(initializer);
+                self.current().bind_uncertain(Symbol::intern(name));
+                AstNode::MutableDecl { name: name.clone(), type_annotation: type_annotation.clone(), initializer }
+            }
+
+            AstNode::Sequence { statements } => AstNode::Sequence { statements: self.block(statements) },
+            AstNode::DoBlock { statements } => AstNode::DoBlock { statements: self.block(statements) },
+            AstNode::ForInLoop { variable, iterable, body } => {
+                let iterable = self.boxed(iterable);
+                let mut scope = Scope::default();
+                scope.bind(Symbol::intern(variable));
+                let [body] = self.scoped(scope, [body]);
+                AstNode::ForInLoop { variable: variable.clone(), iterable, body: Box::new(body) }
+            }
+            AstNode::TryCatch { try_block, error_param, catch_block } => {
+                let try_block = self.boxed(try_block);
+                let mut scope = Scope::default();
+                scope.bind(Symbol::intern(error_param));
+                let [catch_block] = self.scoped(scope, [catch_block]);
+                AstNode::TryCatch { try_block, error_param: error_param.clone(), catch_block: Box::new(catch_block) }
+            }
+            AstNode::Match { value, arms } => {
+                let value = self.boxed(value);
+                let arms = arms.iter().map(|arm| self.arm(arm)).collect();
+                AstNode::Match { value, arms }
+            }
+
+            // Resolved on their own when they are created
+            AstNode::Lambda { .. } | AstNode::GenerateBlock { .. } => node.clone(),
+
+            // Their handlers look the name up themselves
+            AstNode::Assignment { target, value } => {
+                AstNode::Assignment { target: target.clone(), value: self.boxed(value) }
+            }
+            AstNode::CallExpression { callee, args } => {
+                let callee = match &**callee {
+                    AstNode::VariableRef(_) => callee.clone(),
+                    _ => self.boxed(callee),
+                };
+                AstNode::CallExpression { callee, args: args.iter().map(|arg| self.expr(arg)).collect() }
+            }
+
+            AstNode::Number(_)
+            | AstNode::Boolean(_)
+            | AstNode::StringLiteral(_)
+            | AstNode::Null
+            | AstNode::ComplexLiteral { .. }
+            | AstNode::SelfReference
+            | AstNode::RecReference
+            | AstNode::Import { .. }
+            | AstNode::Export { .. }
+            | AstNode::TypeAlias { .. } => node.clone(),
+
+            AstNode::BinaryOp { op, left, right } => {
+                AstNode::BinaryOp { op: op.clone(), left: self.boxed(left), right: self.boxed(right) }
+            }
+            AstNode::UnaryOp { op, operand } => AstNode::UnaryOp { op: op.clone(), operand: self.boxed(operand) },
+            AstNode::If { condition, then_expr, else_expr } => AstNode::If {
+                condition: self.boxed(condition),
+                then_expr: self.boxed(then_expr),
+                else_expr: self.boxed(else_expr),
+            },
+            AstNode::Piecewise { cases, default } => AstNode::Piecewise {
+                cases: cases
+                    .iter()
+                    .map(|(condition, expression)| (self.boxed(condition), self.boxed(expression)))
+                    .collect(),
+                default: default.as_ref().map(|default| self.boxed(default)),
+            },
+            AstNode::WhileLoop { condition, body } => {
+                AstNode::WhileLoop { condition: self.boxed(condition), body: self.boxed(body) }
+            }
+            AstNode::FunctionCall { name, args } => {
+                AstNode::FunctionCall { name: name.clone(), args: args.iter().map(|arg| self.expr(arg)).collect() }
+            }
+            AstNode::ArrayLiteral(elements) => AstNode::ArrayLiteral(
+                elements
+                    .iter()
+                    .map(|element| match element {
+                        ArrayElement::Single(expr) => ArrayElement::Single(self.expr(expr)),
+                        ArrayElement::Spread(expr) => ArrayElement::Spread(self.boxed(expr)),
+                    })
+                    .collect(),
+            ),
+            AstNode::RecordLiteral(fields) => AstNode::RecordLiteral(
+                fields
+                    .iter()
+                    .map(|field| match field {
+                        RecordFieldOrSpread::Field { name, value } => {
+                            RecordFieldOrSpread::Field { name: name.clone(), value: self.expr(value) }
+                        }
+                        RecordFieldOrSpread::MutableField { name, value } => {
+                            RecordFieldOrSpread::MutableField { name: name.clone(), value: self.expr(value) }
+                        }
+                        RecordFieldOrSpread::Spread(expr) => RecordFieldOrSpread::Spread(self.boxed(expr)),
+                    })
+                    .collect(),
+            ),
+            AstNode::FieldAccess { record, field } => {
+                AstNode::FieldAccess { record: self.boxed(record), field: field.clone() }
+            }
+            AstNode::IndexAccess { object, indices } => AstNode::IndexAccess {
+                object: self.boxed(object),
+                indices: indices
+                    .iter()
+                    .map(|index| match index {
+                        IndexArg::Single(expr) => IndexArg::Single(self.boxed(expr)),
+                        IndexArg::Range { start, end } => IndexArg::Range {
+                            start: start.as_ref().map(|start| self.boxed(start)),
+                            end: end.as_ref().map(|end| self.boxed(end)),
+                        },
+                    })
+                    .collect(),
+            },
+            AstNode::Return { value } => AstNode::Return { value: self.boxed(value) },
+            AstNode::Yield { value } => AstNode::Yield { value: self.boxed(value) },
+            AstNode::Throw { value } => AstNode::Throw { value: self.boxed(value) },
+            AstNode::Edge { from, to, directed, metadata } => AstNode::Edge {
+                from: *from,
+                to: *to,
+                directed: *directed,
+                metadata: metadata.as_ref().map(|metadata| self.boxed(metadata)),
+            },
+        }
+    }
+
+    /// A match arm: guard and body run in a scope holding the pattern
+    /// variables, bound in no particular order
+    fn arm(&mut self, arm: &MatchArm) -> MatchArm {
+        let mut scope = Scope::default();
+        let mut names = Vec::new();
+        pattern_names(&arm.pattern, &mut names);
+        for name in names {
+            scope.bind_uncertain(Symbol::intern(name));
+        }
+
+        self.scopes.push(scope);
+        if let Some(guard) = &arm.guard {
+            self.mark(guard);
+        }
+        self.mark(&arm.body);
+        let guard = arm.guard.as_ref().map(|guard| self.boxed(guard));
+        let body = self.boxed(&arm.body);
+        self.scopes.pop();
+
+        MatchArm { pattern: arm.pattern.clone(), guard, body }
+    }
+}
+
+/// Names a pattern binds
+fn pattern_names<'a>(pattern: &'a Pattern, out: &mut Vec<&'a str>) {
+    match pattern {
+        Pattern::Variable(name) => out.push(name),
+        Pattern::Record { fields } => fields.iter().for_each(|(_, pattern)| pattern_names(pattern, out)),
+        Pattern::Vector { elements } => {
+            for element in elements {
+                match element {
+                    VectorPatternElement::Pattern(pattern) => pattern_names(pattern, out),
+                    VectorPatternElement::Rest(name) => out.push(name),
+                }
+            }
+        }
+        Pattern::Literal(_) | Pattern::Wildcard | Pattern::Type(_) => {}
+    }
+}
+
+/// Call `f` on each direct child expression of `node`
+fn for_each_child(node: &AstNode, mut f: impl FnMut(&AstNode)) {
+    match node {
+        AstNode::Number(_)
+        | AstNode::Boolean(_)
+        | AstNode::StringLiteral(_)
+        | AstNode::Null
+        | AstNode::ComplexLiteral { .. }
+        | AstNode::VariableRef(_)
+        | AstNode::LocalRef { .. }
+        | AstNode::SelfReference
+        | AstNode::RecReference
+        | AstNode::Import { .. }
+        | AstNode::Export { .. }
+        | AstNode::TypeAlias { .. } => {}
+
+        AstNode::BinaryOp { left, right, .. } => {
+            f(left);
+            f(right);
+        }
+        AstNode::UnaryOp { operand, .. } => f(operand),
+        AstNode::If { condition, then_expr, else_expr } => {
+            f(condition);
+            f(then_expr);
+            f(else_expr);
+        }
+        AstNode::Piecewise { cases, default } => {
+            for (condition, expression) in cases {
+                f(condition);
+                f(expression);
+            }
+            if let Some(default) = default {
+                f(default);
+            }
+        }
+        AstNode::FunctionCall { args, .. } => args.iter().for_each(f),
+        AstNode::CallExpression { callee, args } => {
+            f(callee);
+            args.iter().for_each(f);
+        }
+        AstNode::ArrayLiteral(elements) => {
+            for element in elements {
+                match element {
+                    ArrayElement::Single(expr) => f(expr),
+                    ArrayElement::Spread(expr) => f(expr),
+                }
+            }
+        }
+        AstNode::RecordLiteral(fields) => {
+            for field in fields {
+                match field {
+                    RecordFieldOrSpread::Field { value, .. } | RecordFieldOrSpread::MutableField { value, .. } => f(value),
+                    RecordFieldOrSpread::Spread(expr) => f(expr),
+                }
+            }
+        }
+        AstNode::FieldAccess { record, .. } => f(record),
+        AstNode::VariableDecl { initializer, .. } | AstNode::MutableDecl { initializer, .. } => f(initializer),
+        AstNode::Assignment { target, value } => {
+            f(target);
+            f(value);
+        }
+        AstNode::Return { value } | AstNode::Yield { value } | AstNode::Throw { value } => f(value),
+        AstNode::Lambda { body, .. } => f(body),
+        AstNode::Edge { metadata, .. } => {
+            if let Some(metadata) = metadata {
+                f(metadata);
+            }
+        }
+        AstNode::IndexAccess { object, indices } => {
+            f(object);
+            for index in indices {
+                match index {
+                    IndexArg::Single(expr) => f(expr),
+                    IndexArg::Range { start, end } => start.iter().chain(end.iter()).for_each(|expr| f(expr)),
+                }
+            }
+        }
+        AstNode::Sequence { statements } | AstNode::DoBlock { statements } | AstNode::GenerateBlock { statements } => {
+            statements.iter().for_each(f)
+        }
+        AstNode::WhileLoop { condition, body } => {
+            f(condition);
+            f(body);
+        }
+        AstNode::ForInLoop { iterable, body, .. } => {
+            f(iterable);
+            f(body);
+        }
+        AstNode::TryCatch { try_block, catch_block, .. } => {
+            f(try_block);
+            f(catch_block);
+        }
+        AstNode::Match { value, arms } => {
+            f(value);
+            for arm in arms {
+                if let Some(guard) = &arm.guard {
+                    f(guard);
+                }
+                f(&arm.body);
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use achronyme_parser::parse;
+
+    /// Body of the single lambda in `source`, resolved
+    fn resolved(source: &str) -> AstNode {
+        let program = parse(source).unwrap();
+        let Some(AstNode::Lambda { params, body, .. }) = program.first() else {
+            panic!("expected a lambda, got {:?}", program)
+        };
+        let params: Vec<String> = params.iter().map(|(name, _)| name.clone()).collect();
+        resolve_lambda(&params, body)
+    }
+
+    /// (depth, index) of every resolved reference to `name`, None for lookups by name
+    fn slots_of(node: &AstNode, name: &str, out: &mut Vec<Option<(u32, u32)>>) {
+        match node {
+            AstNode::LocalRef { name: n, depth, index } if n == name => out.push(Some((*depth, *index))),
+            AstNode::VariableRef(n) if n == name => out.push(None),
+            _ => for_each_child(node, |child| slots_of(child, name, out)),
+        }
+    }
+
+    fn slots(source: &str, name: &str) -> Vec<Option<(u32, u32)>> {
+        let mut out = Vec::new();
+        slots_of(&resolved(source), name, &mut out);
+        out
+    }
+
+    #[test]
+    fn test_parameters_and_block_locals() {
+        assert_eq!(slots("(a, b) => a + b", "b"), vec![Some((0, 1))]);
+        assert_eq!(
+            slots("(a, b) => do { let s = a + b; do { s * a } }", "a"),
+            vec![Some((1, 0)), Some((2, 0))]
+        );
+        assert_eq!(slots("(a, b) => do { let s = a + b; do { s * a } }", "s"), vec![Some((1, 0))]);
+    }
+
+    #[test]
+    fn test_reference_before_local_sees_outer_binding() {
+        // The first `x` runs before the block binds its own `x`
+        assert_eq!(slots("x => do { let y = x; let x = 2; x + y }", "x"), vec![Some((1, 0)), Some((0, 1))]);
+    }
+
+    #[test]
+    fn test_loop_and_branch_bindings_stay_by_name() {
+        // A single-statement loop body or branch declares into the block's scope
+        assert_eq!(slots("x => do { while (x < 3) { let x = 5 }\nx }", "x"), vec![None, None]);
+        assert_eq!(slots("x => do { if (x > 0) { let y = 1 } else { 0 }\ny }", "y"), vec![None]);
+        assert_eq!(slots("(n) => do { for (k in range(n)) { k }\nn }", "k"), vec![Some((0, 0))]);
+        // Assignment targets stay names
+        assert_eq!(
+            slots("x => do { mut t = 0\nwhile (t < x) { t = t + 1 }\nt }", "t"),
+            vec![Some((0, 0)), None, Some((0, 0)), Some((0, 0))]
+        );
+    }
+
+    #[test]
+    fn test_free_variables_nested_lambdas_and_binding_builtins() {
+        assert_eq!(slots("x => x + y", "y"), vec![None]);
+        // Nested lambdas are resolved when they are created
+        assert_eq!(slots("x => (z => x + z)", "x"), vec![None]);
+        assert_eq!(slots("x => do { restore_env(\"s.ach\")\nx }", "x"), vec![None]);
+    }
+
+    #[test]
+    fn test_match_arms_and_catch() {
+        assert_eq!(slots("v => match v { [a, b] => a + v, _ => v }", "v"), vec![Some((0, 0)), Some((1, 0)), Some((1, 0))]);
+        assert_eq!(slots("v => match v { [a, b] => a + v, _ => v }", "a"), vec![None]);
+        assert_eq!(slots("v => try { v } catch(e) { e.message }", "e"), vec![Some((0, 0))]);
+    }
+
+    #[test]
+    fn test_detached_keeps_only_inner_slots() {
+        let body = resolved("x => do { let s = x\ns + x }");
+        let detached = resolve_detached(&body);
+        let mut x = Vec::new();
+        slots_of(&detached, "x", &mut x);
+        let mut s = Vec::new();
+        slots_of(&detached, "s", &mut s);
+        assert_eq!(x, vec![None, None]);
+        assert_eq!(s, vec![Some((0, 0))]);
+    }
+}
@@ -84,7 +84,7 @@ pub fn is_tail_position(node: &AstNode) -> bool {
         | AstNode::ComplexLiteral { .. } => true,
 
         // Variable references are in tail position
-        AstNode::VariableRef(_) => true,
+        AstNode::VariableRef(_) | AstNode::LocalRef { .. } => true,
         AstNode::SelfReference => true,
 
         // Lambda is in tail position
@@ -80,7 +80,7 @@ fn test_do_block_with_tail_call() {
             },
             AstNode::CallExpression {
                 callee: Box::new(AstNode::RecReference),
-                args: vec![AstNode::VariableRef("x".to_string())],
+                args: vec![AstNode::VariableRef("x".into())],
             },
         ],
     };
@@ -102,7 +102,7 @@ fn test_do_block_with_non_tail_call() {
                 op: BinaryOp::Add,
                 left: Box::new(AstNode::CallExpression {
                     callee: Box::new(AstNode::RecReference),
-                    args: vec![AstNode::VariableRef("x".to_string())],
+                    args: vec![AstNode::VariableRef("x".into())],
                 }),
                 right: Box::new(AstNode::Number(1.0)),
             },
@@ -173,7 +173,7 @@ fn test_piecewise_with_tail_calls() {
         cases: vec![
             (
                 Box::new(AstNode::Boolean(true)),
-                Box::new(AstNode::VariableRef("x".to_string())),
+                Box::new(AstNode::VariableRef("x".into())),
             )
         ],
         default: Some(Box::new(AstNode::CallExpression {
@@ -83,7 +83,7 @@ pub(crate) fn matches_type(value: &Value, expected: &TypeAnnotation) -> bool {
         TypeAnnotation::Generator => matches!(value, Value::Generator(_)),
 
         // Error type (opaque, accepts any error value)
-        TypeAnnotation::Error => matches!(value, Value::Error { .. }),
+        TypeAnnotation::Error => matches!(value, Value::Error(_)),
 
         // Function type (opaque, accepts any function without signature checking)
         TypeAnnotation::AnyFunction => matches!(value, Value::Function(_)),
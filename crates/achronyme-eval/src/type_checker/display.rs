@@ -24,8 +24,9 @@ pub(crate) fn get_value_type_name(value: &Value) -> String {
         Value::MutableRef(_) => "MutableRef".to_string(),
         Value::Null => "null".to_string(),
         Value::Generator(_) => "Generator".to_string(),
+        Value::Sequence(_) => "Sequence".to_string(),
         Value::GeneratorYield(_) => "GeneratorYield (internal)".to_string(),
-        Value::Error { .. } => "Error".to_string(),
+        Value::Error(_) => "Error".to_string(),
     }
 }
 
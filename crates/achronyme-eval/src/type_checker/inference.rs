@@ -56,9 +56,10 @@ pub fn infer_type(value: &Value) -> TypeAnnotation {
         Value::MutableRef(_) => unreachable!("MutableRef should be dereferenced"),
         // Generator type - represents an iterator
         Value::Generator(_) => TypeAnnotation::Any, // TODO: Add Generator type annotation
+        Value::Sequence(_) => TypeAnnotation::Any,
         // GeneratorYield is internal marker - should not appear in type inference
         Value::GeneratorYield(_) => TypeAnnotation::Any,
         // Error type - represents an error value
-        Value::Error { .. } => TypeAnnotation::Error,
+        Value::Error(_) => TypeAnnotation::Error,
     }
 }
@@ -136,7 +136,7 @@ mod tests {
         let mut actual_fields = HashMap::new();
         actual_fields.insert("name".to_string(), Value::String("John".into()));
         actual_fields.insert("age".to_string(), Value::Number(30.0));
-        let value = Value::Record(actual_fields);
+        let value = Value::Record(Box::new(actual_fields));
 
         assert!(check_type(&value, &record_type).is_ok());
     }
@@ -156,7 +156,7 @@ mod tests {
             "email".to_string(),
             Value::String("john@example.com".into()),
         ); // Another extra field
-        let value = Value::Record(actual_fields);
+        let value = Value::Record(Box::new(actual_fields));
 
         // Should match because all required fields are present with correct types
         assert!(check_type(&value, &record_type).is_ok());
@@ -174,7 +174,7 @@ mod tests {
         let mut actual_fields = HashMap::new();
         actual_fields.insert("name".to_string(), Value::String("John".into()));
         // Missing "age" field
-        let value = Value::Record(actual_fields);
+        let value = Value::Record(Box::new(actual_fields));
 
         assert!(check_type(&value, &record_type).is_err());
     }
@@ -189,7 +189,7 @@ mod tests {
 
         let mut actual_fields = HashMap::new();
         actual_fields.insert("name".to_string(), Value::Number(42.0)); // Wrong type
-        let value = Value::Record(actual_fields);
+        let value = Value::Record(Box::new(actual_fields));
 
         assert!(check_type(&value, &record_type).is_err());
     }
@@ -214,9 +214,9 @@ mod tests {
 
         let mut outer_value = HashMap::new();
         outer_value.insert("name".to_string(), Value::String("John".into()));
-        outer_value.insert("address".to_string(), Value::Record(inner_value));
+        outer_value.insert("address".to_string(), Value::Record(Box::new(inner_value)));
 
-        let value = Value::Record(outer_value);
+        let value = Value::Record(Box::new(outer_value));
 
         assert!(check_type(&value, &outer_record).is_ok());
     }
@@ -224,7 +224,7 @@ mod tests {
     #[test]
     fn test_real_tensor_type_no_shape() {
         let tensor = RealTensor::new(vec![1.0, 2.0, 3.0], vec![3]).unwrap();
-        let value = Value::Tensor(tensor);
+        let value = Value::Tensor(Box::new(tensor));
 
         let tensor_type = TypeAnnotation::Tensor {
             element_type: Box::new(TypeAnnotation::Number),
@@ -237,7 +237,7 @@ mod tests {
     #[test]
     fn test_real_tensor_type_with_exact_shape() {
         let tensor = RealTensor::new(vec![1.0, 2.0, 3.0, 4.0, 5.0, 6.0], vec![2, 3]).unwrap();
-        let value = Value::Tensor(tensor);
+        let value = Value::Tensor(Box::new(tensor));
 
         let tensor_type = TypeAnnotation::Tensor {
             element_type: Box::new(TypeAnnotation::Number),
@@ -257,7 +257,7 @@ mod tests {
     #[test]
     fn test_real_tensor_type_with_wildcard_shape() {
         let tensor = RealTensor::new(vec![1.0, 2.0, 3.0, 4.0, 5.0, 6.0], vec![2, 3]).unwrap();
-        let value = Value::Tensor(tensor);
+        let value = Value::Tensor(Box::new(tensor));
 
         // Wildcard for first dimension
         let tensor_type = TypeAnnotation::Tensor {
@@ -287,7 +287,7 @@ mod tests {
     #[test]
     fn test_real_tensor_wrong_rank() {
         let tensor = RealTensor::new(vec![1.0, 2.0, 3.0], vec![3]).unwrap(); // 1D
-        let value = Value::Tensor(tensor);
+        let value = Value::Tensor(Box::new(tensor));
 
         let tensor_type = TypeAnnotation::Tensor {
             element_type: Box::new(TypeAnnotation::Number),
@@ -304,7 +304,7 @@ mod tests {
             vec![2],
         )
         .unwrap();
-        let value = Value::ComplexTensor(tensor);
+        let value = Value::ComplexTensor(Box::new(tensor));
 
         let tensor_type = TypeAnnotation::Tensor {
             element_type: Box::new(TypeAnnotation::Complex),
@@ -324,7 +324,7 @@ mod tests {
     #[test]
     fn test_function_type_basic() {
         let func = create_test_function(2);
-        let value = Value::Function(func);
+        let value = Value::from(func);
 
         let func_type = TypeAnnotation::Function {
             params: vec![Some(TypeAnnotation::Number), Some(TypeAnnotation::String)],
@@ -337,7 +337,7 @@ mod tests {
     #[test]
     fn test_function_type_wrong_param_count() {
         let func = create_test_function(2);
-        let value = Value::Function(func);
+        let value = Value::from(func);
 
         let func_type = TypeAnnotation::Function {
             params: vec![
@@ -354,7 +354,7 @@ mod tests {
     #[test]
     fn test_function_type_empty_params() {
         let func = create_test_function(5);
-        let value = Value::Function(func);
+        let value = Value::from(func);
 
         // Empty params means no checking of parameter count
         let func_type = TypeAnnotation::Function {
@@ -434,7 +434,7 @@ mod tests {
     #[test]
     fn test_infer_type_tensor() {
         let tensor = RealTensor::new(vec![1.0, 2.0, 3.0], vec![3]).unwrap();
-        let value = Value::Tensor(tensor);
+        let value = Value::Tensor(Box::new(tensor));
 
         let inferred = infer_type(&value);
         match inferred {
@@ -454,7 +454,7 @@ mod tests {
         let mut fields = HashMap::new();
         fields.insert("name".to_string(), Value::String("John".into()));
         fields.insert("age".to_string(), Value::Number(30.0));
-        let value = Value::Record(fields);
+        let value = Value::Record(Box::new(fields));
 
         let inferred = infer_type(&value);
         match inferred {
@@ -504,7 +504,7 @@ mod tests {
         // Record with value field matches
         let mut record_value = HashMap::new();
         record_value.insert("value".to_string(), Value::Number(42.0));
-        assert!(check_type(&Value::Record(record_value), &union).is_ok());
+        assert!(check_type(&Value::Record(Box::new(record_value)), &union).is_ok());
 
         // Number doesn't match
         assert!(check_type(&Value::Number(42.0), &union).is_err());
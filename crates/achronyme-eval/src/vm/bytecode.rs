@@ -0,0 +1,173 @@
+use achronyme_parser::ast::{AstNode, BinaryOp, UnaryOp};
+use achronyme_parser::type_annotation::TypeAnnotation;
+use achronyme_types::value::Value;
+use achronyme_types::Symbol;
+use std::fmt;
+
+/// Register index inside a frame
+pub type Reg = u16;
+
+/// Index into one of the chunk's side tables (constants, names, nodes, ...)
+pub type Index = u32;
+
+/// A single VM instruction
+///
+/// Operands are register indices into the current frame; larger payloads
+/// (constants, names, AST subtrees) live in side tables of the `Chunk` and
+/// are referenced by index, which keeps instructions small and `Copy`-cheap.
+#[derive(Debug, Clone)]
+pub enum Instr {
+    /// regs[dst] = constants[index]
+    LoadConst { dst: Reg, index: Index },
+    /// regs[dst] = regs[src]
+    Move { dst: Reg, src: Reg },
+    /// regs[dst] = new mutable cell holding regs[src] (`mut` local)
+    NewCell { dst: Reg, src: Reg },
+    /// regs[dst] = contents of the cell in regs[cell]
+    LoadCell { dst: Reg, cell: Reg },
+    /// cell in regs[cell] = regs[src]
+    StoreCell { cell: Reg, src: Reg },
+
+    /// regs[dst] = variable/constant/builtin `name` from the environment
+    LoadName { dst: Reg, name: Symbol },
+    /// Assign regs[src] to the environment variable `names[name]`
+    StoreName { name: Index, src: Reg },
+    /// Declare `names[name]` in the environment (`let`/`mut` outside any block)
+    DefineName { dst: Reg, name: Index, src: Reg, mutable: bool, ty: Option<Index> },
+    /// Type check (and enrich) the value of a typed `let` local in place
+    CheckDecl { reg: Reg, name: Index, ty: Index },
+
+    /// regs[dst] = regs[lhs] <op> regs[rhs]
+    Binary { op: BinaryOp, dst: Reg, lhs: Reg, rhs: Reg },
+    /// regs[dst] = <op> regs[src]
+    Unary { op: UnaryOp, dst: Reg, src: Reg },
+
+    /// pc = target
+    Jump { target: Index },
+    /// if !truthy(regs[cond]) { pc = target }
+    JumpIfFalse { cond: Reg, target: Index },
+
+    /// regs[dst] = call named function `names[name]` with regs[args..args+argc]
+    CallName { dst: Reg, name: Index, args: Reg, argc: u16 },
+    /// regs[dst] = call the local `names[name]` held in regs[callee]
+    CallLocal { dst: Reg, callee: Reg, name: Index, args: Reg, argc: u16 },
+    /// regs[dst] = call the function value in regs[callee]
+    CallValue { dst: Reg, callee: Reg, args: Reg, argc: u16 },
+    /// regs[dst] = rec(regs[args..args+argc]) (function chunks only)
+    CallRec { dst: Reg, args: Reg, argc: u16 },
+    /// Restart the current function with regs[args..args+argc] as parameters
+    TailCallRec { args: Reg, argc: u16 },
+
+    /// regs[dst] = regs[object][indices[spec]]
+    Index { dst: Reg, object: Reg, spec: Index },
+    /// regs[dst] = regs[object].names[field]
+    Field { dst: Reg, object: Reg, field: Index },
+    /// regs[dst] = array literal built from arrays[spec]
+    MakeArray { dst: Reg, spec: Index },
+
+    /// regs[dst] = tree-walking evaluation of nodes[node], with the locals in
+    /// captures[captures] made visible to it
+    Eval { dst: Reg, node: Index, captures: Index },
+
+    /// Fail with the message names[message]
+    Fail { message: Index },
+    /// Leave the frame with regs[src]
+    Return { src: Reg },
+}
+
+/// One operand of an index expression
+#[derive(Debug, Clone)]
+pub enum IndexOperand {
+    Single(Reg),
+    Range { start: Option<Reg>, end: Option<Reg> },
+}
+
+/// A local made visible to a tree-walked subtree
+#[derive(Debug, Clone)]
+pub struct Capture {
+    pub name: Index,
+    pub reg: Reg,
+    /// `mut` locals are shared by binding the cell itself
+    pub is_cell: bool,
+}
+
+/// Compiled bytecode for a top-level statement or a function body
+#[derive(Debug, Clone, Default)]
+pub struct Chunk {
+    pub code: Vec<Instr>,
+    pub constants: Vec<Value>,
+    pub names: Vec<String>,
+    pub(crate) nodes: Vec<AstNode>,
+    pub(crate) types: Vec<TypeAnnotation>,
+    pub(crate) captures: Vec<Vec<Capture>>,
+    pub(crate) indices: Vec<Vec<IndexOperand>>,
+    /// Array literal elements: (register, is_spread)
+    pub(crate) arrays: Vec<Vec<(Reg, bool)>>,
+    /// Number of registers a frame running this chunk needs
+    pub num_registers: usize,
+    /// Number of parameters (function chunks)
+    pub arity: usize,
+    /// Whether any instruction reads or writes the environment; function
+    /// frames that don't can skip installing the closure environment
+    pub needs_env: bool,
+}
+
+impl Chunk {
+    /// Number of instructions that fall back to the tree-walking evaluator
+    pub fn fallback_count(&self) -> usize {
+        self.code.iter().filter(|i| matches!(i, Instr::Eval { .. })).count()
+    }
+
+    /// Whether the whole chunk is a single delegation to the tree-walker
+    /// (running it would only add overhead)
+    pub fn is_single_fallback(&self) -> bool {
+        matches!(self.code.as_slice(), [Instr::Eval { .. }, Instr::Return { .. }])
+    }
+}
+
+impl fmt::Display for Chunk {
+    /// Human-readable disassembly (for debugging and tests)
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        writeln!(f, "; registers: {}, arity: {}, needs_env: {}", self.num_registers, self.arity, self.needs_env)?;
+        for (pc, instr) in self.code.iter().enumerate() {
+            write!(f, "{:4}  ", pc)?;
+            match instr {
+                Instr::LoadConst { dst, index } => writeln!(f, "LOADK     r{} {:?}", dst, self.constants[*index as usize])?,
+                Instr::Move { dst, src } => writeln!(f, "MOVE      r{} r{}", dst, src)?,
+                Instr::NewCell { dst, src } => writeln!(f, "NEWCELL   r{} r{}", dst, src)?,
+                Instr::LoadCell { dst, cell } => writeln!(f, "LOADCELL  r{} r{}", dst, cell)?,
+                Instr::StoreCell { cell, src } => writeln!(f, "STORECELL r{} r{}", cell, src)?,
+                Instr::LoadName { dst, name } => writeln!(f, "LOADNAME  r{} {}", dst, name)?,
+                Instr::StoreName { name, src } => writeln!(f, "STORENAME {} r{}", self.names[*name as usize], src)?,
+                Instr::DefineName { dst, name, src, mutable, .. } => {
+                    writeln!(f, "DEFINE    r{} {}{} r{}", dst, if *mutable { "mut " } else { "" }, self.names[*name as usize], src)?
+                }
+                Instr::CheckDecl { reg, name, .. } => writeln!(f, "CHECKDECL r{} {}", reg, self.names[*name as usize])?,
+                Instr::Binary { op, dst, lhs, rhs } => writeln!(f, "{:<9} r{} r{} r{}", format!("{:?}", op).to_uppercase(), dst, lhs, rhs)?,
+                Instr::Unary { op, dst, src } => writeln!(f, "{:<9} r{} r{}", format!("{:?}", op).to_uppercase(), dst, src)?,
+                Instr::Jump { target } => writeln!(f, "JUMP      {}", target)?,
+                Instr::JumpIfFalse { cond, target } => writeln!(f, "JUMPIFNOT r{} {}", cond, target)?,
+                Instr::CallName { dst, name, args, argc } => {
+                    writeln!(f, "CALLNAME  r{} {} r{}..+{}", dst, self.names[*name as usize], args, argc)?
+                }
+                Instr::CallLocal { dst, callee, args, argc, .. } => writeln!(f, "CALLLOCAL r{} r{} r{}..+{}", dst, callee, args, argc)?,
+                Instr::CallValue { dst, callee, args, argc } => writeln!(f, "CALLVALUE r{} r{} r{}..+{}", dst, callee, args, argc)?,
+                Instr::CallRec { dst, args, argc } => writeln!(f, "CALLREC   r{} r{}..+{}", dst, args, argc)?,
+                Instr::TailCallRec { args, argc } => writeln!(f, "TAILREC   r{}..+{}", args, argc)?,
+                Instr::Index { dst, object, spec } => writeln!(f, "INDEX     r{} r{} {:?}", dst, object, self.indices[*spec as usize])?,
+                Instr::Field { dst, object, field } => writeln!(f, "FIELD     r{} r{} {}", dst, object, self.names[*field as usize])?,
+                Instr::MakeArray { dst, spec } => writeln!(f, "ARRAY     r{} {:?}", dst, self.arrays[*spec as usize])?,
+                Instr::Eval { dst, node, captures } => {
+                    let names: Vec<&str> = self.captures[*captures as usize]
+                        .iter()
+                        .map(|c| self.names[c.name as usize].as_str())
+                        .collect();
+                    writeln!(f, "EVAL      r{} #{} captures {:?}", dst, node, names)?
+                }
+                Instr::Fail { message } => writeln!(f, "FAIL      {:?}", self.names[*message as usize])?,
+                Instr::Return { src } => writeln!(f, "RETURN    r{}", src)?,
+            }
+        }
+        Ok(())
+    }
+}
@@ -0,0 +1,626 @@
+use std::collections::{BTreeSet, HashMap};
+
+use achronyme_parser::ast::{ArrayElement, AstNode, IndexArg, RecordFieldOrSpread};
+use achronyme_types::complex::Complex;
+use achronyme_types::value::Value;
+
+use super::bytecode::{Capture, Chunk, Index, IndexOperand, Instr, Reg};
+use crate::handlers::variables::is_special_form;
+
+/// A local variable living in a register of the current frame
+struct Local {
+    name: String,
+    reg: Reg,
+    /// `mut` locals hold a shared cell (`Value::MutableRef`) in their register
+    mutable: bool,
+}
+
+/// Compile a top-level statement into a chunk
+///
+/// Declarations outside of any block still go to the environment (they are
+/// globals); declarations inside blocks become registers.
+///
+/// Returns an error for constructs the compiler refuses to handle; callers
+/// are expected to fall back to the tree-walking evaluator in that case.
+pub fn compile_statement(node: &AstNode) -> Result<Chunk, String> {
+    let mut compiler = Compiler::new(false);
+    let dst = compiler.alloc()?;
+    compiler.expr(node, dst, false)?;
+    compiler.emit(Instr::Return { src: dst });
+    Ok(compiler.finish())
+}
+
+/// Compile the body of a user-defined function into a chunk
+///
+/// Parameters occupy registers `0..params.len()`.
+pub fn compile_function(params: &[String], body: &AstNode) -> Result<Chunk, String> {
+    let mut compiler = Compiler::new(true);
+    for param in params {
+        let reg = compiler.alloc()?;
+        compiler.locals.push(Local { name: param.clone(), reg, mutable: false });
+    }
+    compiler.chunk.arity = params.len();
+
+    let dst = compiler.alloc()?;
+    compiler.expr(body, dst, true)?;
+    compiler.emit(Instr::Return { src: dst });
+    Ok(compiler.finish())
+}
+
+/// Single-pass compiler from AST to register bytecode
+///
+/// Temporaries are allocated stack-like above the locals of the enclosing
+/// blocks, so a block's registers are released when it ends. Anything without
+/// a native lowering is emitted as an `Eval` of the original subtree.
+struct Compiler {
+    chunk: Chunk,
+    locals: Vec<Local>,
+    name_indices: HashMap<String, Index>,
+    /// Number of enclosing blocks (`Sequence` / `do { }`)
+    depth: usize,
+    in_function: bool,
+    next_reg: usize,
+}
+
+impl Compiler {
+    fn new(in_function: bool) -> Self {
+        Self {
+            chunk: Chunk::default(),
+            locals: Vec::new(),
+            name_indices: HashMap::new(),
+            depth: 0,
+            in_function,
+            next_reg: 0,
+        }
+    }
+
+    fn finish(self) -> Chunk {
+        self.chunk
+    }
+
+    // ------------------------------------------------------------------
+    // Helpers
+    // ------------------------------------------------------------------
+
+    fn alloc(&mut self) -> Result<Reg, String> {
+        let reg = self.next_reg;
+        if reg >= Reg::MAX as usize {
+            return Err("Too many registers in compiled chunk".to_string());
+        }
+        self.next_reg += 1;
+        self.chunk.num_registers = self.chunk.num_registers.max(self.next_reg);
+        Ok(reg as Reg)
+    }
+
+    fn emit(&mut self, instr: Instr) -> usize {
+        self.chunk.code.push(instr);
+        self.chunk.code.len() - 1
+    }
+
+    fn here(&self) -> Index {
+        self.chunk.code.len() as Index
+    }
+
+    /// Point the jump at `at` to the current end of the code
+    fn patch(&mut self, at: usize) {
+        let here = self.here();
+        match &mut self.chunk.code[at] {
+            Instr::Jump { target } | Instr::JumpIfFalse { target, .. } => *target = here,
+            _ => unreachable!("patching a non-jump instruction"),
+        }
+    }
+
+    fn constant(&mut self, value: Value) -> Index {
+        self.chunk.constants.push(value);
+        (self.chunk.constants.len() - 1) as Index
+    }
+
+    fn name(&mut self, name: &str) -> Index {
+        if let Some(&index) = self.name_indices.get(name) {
+            return index;
+        }
+        let index = self.chunk.names.len() as Index;
+        self.chunk.names.push(name.to_string());
+        self.name_indices.insert(name.to_string(), index);
+        index
+    }
+
+    fn load_const(&mut self, dst: Reg, value: Value) {
+        let index = self.constant(value);
+        self.emit(Instr::LoadConst { dst, index });
+    }
+
+    fn resolve(&self, name: &str) -> Option<&Local> {
+        self.locals.iter().rev().find(|local| local.name == name)
+    }
+
+    /// Declarations outside any block (and outside functions) define globals
+    fn is_global_scope(&self) -> bool {
+        !self.in_function && self.depth == 0
+    }
+
+    /// Compile `node` into some register and return it
+    ///
+    /// Immutable locals are used in place; everything else goes into a fresh
+    /// temporary that stays allocated until the caller resets `next_reg`.
+    fn operand(&mut self, node: &AstNode) -> Result<Reg, String> {
+        if let AstNode::VariableRef(name) | AstNode::LocalRef { name, .. } = node {
+            if let Some(local) = self.resolve(name) {
+                if !local.mutable {
+                    return Ok(local.reg);
+                }
+            }
+        }
+        let tmp = self.alloc()?;
+        self.expr(node, tmp, false)?;
+        Ok(tmp)
+    }
+
+    /// Compile call arguments into consecutive registers
+    fn arguments(&mut self, args: &[AstNode]) -> Result<(Reg, u16), String> {
+        let base = self.next_reg as Reg;
+        for arg in args {
+            let reg = self.alloc()?;
+            self.expr(arg, reg, false)?;
+        }
+        let argc = u16::try_from(args.len()).map_err(|_| "Too many arguments in compiled call".to_string())?;
+        Ok((base, argc))
+    }
+
+    // ------------------------------------------------------------------
+    // Expressions
+    // ------------------------------------------------------------------
+
+    /// Compile `node` so that its value ends up in `dst`
+    ///
+    /// `tail` marks the tail position of a function body, where calls to
+    /// `rec` become jumps.
+    fn expr(&mut self, node: &AstNode, dst: Reg, tail: bool) -> Result<(), String> {
+        let mark = self.next_reg;
+        let result = self.expr_inner(node, dst, tail);
+        self.next_reg = mark;
+        result
+    }
+
+    fn expr_inner(&mut self, node: &AstNode, dst: Reg, tail: bool) -> Result<(), String> {
+        match node {
+            AstNode::Number(n) => self.load_const(dst, Value::Number(*n)),
+            AstNode::Boolean(b) => self.load_const(dst, Value::Boolean(*b)),
+            AstNode::StringLiteral(s) => self.load_const(dst, Value::String(s.clone())),
+            AstNode::ComplexLiteral { re, im } => self.load_const(dst, Value::Complex(Complex::new(*re, *im))),
+            AstNode::Null => self.load_const(dst, Value::Null),
+
+            AstNode::VariableRef(name) | AstNode::LocalRef { name, .. } => match self.resolve(name) {
+                Some(local) if local.mutable => {
+                    let cell = local.reg;
+                    self.emit(Instr::LoadCell { dst, cell });
+                }
+                Some(local) => {
+                    let src = local.reg;
+                    if src != dst {
+                        self.emit(Instr::Move { dst, src });
+                    }
+                }
+                None => {
+                    self.chunk.needs_env = true;
+                    self.emit(Instr::LoadName { dst, name: *name });
+                }
+            },
+
+            AstNode::BinaryOp { op, left, right } => {
+                let lhs = self.operand(left)?;
+                let rhs = self.operand(right)?;
+                self.emit(Instr::Binary { op: op.clone(), dst, lhs, rhs });
+            }
+            AstNode::UnaryOp { op, operand } => {
+                let src = self.operand(operand)?;
+                self.emit(Instr::Unary { op: op.clone(), dst, src });
+            }
+
+            AstNode::If { condition, then_expr, else_expr } => {
+                let cond = self.operand(condition)?;
+                let jump_else = self.emit(Instr::JumpIfFalse { cond, target: 0 });
+                self.expr(then_expr, dst, tail)?;
+                let jump_end = self.emit(Instr::Jump { target: 0 });
+                self.patch(jump_else);
+                self.expr(else_expr, dst, tail)?;
+                self.patch(jump_end);
+            }
+            AstNode::Piecewise { cases, default } => {
+                let mut jumps_end = Vec::with_capacity(cases.len());
+                for (condition, expression) in cases {
+                    let mark = self.next_reg;
+                    let cond = self.operand(condition)?;
+                    self.next_reg = mark;
+                    let jump_next = self.emit(Instr::JumpIfFalse { cond, target: 0 });
+                    self.expr(expression, dst, tail)?;
+                    jumps_end.push(self.emit(Instr::Jump { target: 0 }));
+                    self.patch(jump_next);
+                }
+                match default {
+                    Some(default_expr) => self.expr(default_expr, dst, tail)?,
+                    None => {
+                        let message = self.name("piecewise: no condition was true and no default value provided");
+                        self.emit(Instr::Fail { message });
+                    }
+                }
+                for jump in jumps_end {
+                    self.patch(jump);
+                }
+            }
+            AstNode::WhileLoop { condition, body } => {
+                self.load_const(dst, Value::Number(0.0));
+                let top = self.here();
+                let mark = self.next_reg;
+                let cond = self.operand(condition)?;
+                self.next_reg = mark;
+                let jump_end = self.emit(Instr::JumpIfFalse { cond, target: 0 });
+                self.expr(body, dst, false)?;
+                self.emit(Instr::Jump { target: top });
+                self.patch(jump_end);
+            }
+
+            AstNode::Sequence { statements } | AstNode::DoBlock { statements } => {
+                self.block(statements, dst, tail)?;
+            }
+
+            AstNode::VariableDecl { .. } | AstNode::MutableDecl { .. } if self.is_global_scope() => {
+                self.global_declaration(node, dst)?;
+            }
+            AstNode::VariableDecl { .. } | AstNode::MutableDecl { .. } => {
+                // A declaration that is not a statement of a block (e.g. the
+                // single statement of an `if` branch) defines into whatever
+                // scope is current; registers can't express that.
+                return Err("declaration outside of a block".to_string());
+            }
+
+            AstNode::Assignment { target, value } => match target.as_ref() {
+                AstNode::VariableRef(name) => {
+                    let local = self.resolve(name).map(|local| (local.reg, local.mutable));
+                    self.expr(value, dst, false)?;
+                    match local {
+                        Some((cell, true)) => {
+                            self.emit(Instr::StoreCell { cell, src: dst });
+                        }
+                        Some((_, false)) => {
+                            let message = self.name(&format!("Cannot assign to immutable variable '{}'", name));
+                            self.emit(Instr::Fail { message });
+                        }
+                        None => {
+                            let name = self.name(name);
+                            self.chunk.needs_env = true;
+                            self.emit(Instr::StoreName { name, src: dst });
+                        }
+                    }
+                }
+                _ => self.delegate(node, dst)?,
+            },
+
+            AstNode::Return { value } if self.in_function => {
+                self.expr(value, dst, true)?;
+                self.emit(Instr::Return { src: dst });
+            }
+
+            AstNode::CallExpression { callee, args } => match callee.as_ref() {
+                AstNode::RecReference if self.in_function => {
+                    let (base, argc) = self.arguments(args)?;
+                    if tail {
+                        self.emit(Instr::TailCallRec { args: base, argc });
+                    } else {
+                        self.emit(Instr::CallRec { dst, args: base, argc });
+                    }
+                }
+                AstNode::VariableRef(name) => self.named_call(node, name, args, dst)?,
+                // Method calls need `self` injection and generator handling
+                AstNode::FieldAccess { .. } | AstNode::RecReference => self.delegate(node, dst)?,
+                _ => {
+                    let callee = self.operand(callee)?;
+                    let (base, argc) = self.arguments(args)?;
+                    self.emit(Instr::CallValue { dst, callee, args: base, argc });
+                }
+            },
+            AstNode::FunctionCall { name, args } => self.named_call(node, name, args, dst)?,
+
+            AstNode::IndexAccess { object, indices } => {
+                let object = self.operand(object)?;
+                let mut operands = Vec::with_capacity(indices.len());
+                for index in indices {
+                    operands.push(match index {
+                        IndexArg::Single(expr) => IndexOperand::Single(self.operand(expr)?),
+                        IndexArg::Range { start, end } => IndexOperand::Range {
+                            start: start.as_deref().map(|e| self.operand(e)).transpose()?,
+                            end: end.as_deref().map(|e| self.operand(e)).transpose()?,
+                        },
+                    });
+                }
+                self.chunk.indices.push(operands);
+                let spec = (self.chunk.indices.len() - 1) as Index;
+                self.emit(Instr::Index { dst, object, spec });
+            }
+            AstNode::FieldAccess { record, field } => {
+                let object = self.operand(record)?;
+                let field = self.name(field);
+                self.emit(Instr::Field { dst, object, field });
+            }
+            AstNode::ArrayLiteral(elements) => {
+                let mut spec = Vec::with_capacity(elements.len());
+                for element in elements {
+                    spec.push(match element {
+                        ArrayElement::Single(expr) => (self.operand(expr)?, false),
+                        ArrayElement::Spread(expr) => (self.operand(expr)?, true),
+                    });
+                }
+                self.chunk.arrays.push(spec);
+                let spec = (self.chunk.arrays.len() - 1) as Index;
+                self.emit(Instr::MakeArray { dst, spec });
+            }
+
+            AstNode::Import { .. } | AstNode::Export { .. } if !self.is_global_scope() => {
+                return Err("import/export inside a compiled block".to_string());
+            }
+
+            _ => self.delegate(node, dst)?,
+        }
+        Ok(())
+    }
+
+    /// Calls by name follow `function_call::dispatch`: locals holding
+    /// functions are called directly, special forms (which need their AST
+    /// arguments) and dotted method calls are left to the tree-walker, and
+    /// everything else is resolved at run time.
+    fn named_call(&mut self, node: &AstNode, name: &str, args: &[AstNode], dst: Reg) -> Result<(), String> {
+        if name.contains('.') {
+            return self.delegate(node, dst);
+        }
+
+        if let Some(local) = self.resolve(name) {
+            let (reg, mutable) = (local.reg, local.mutable);
+            let callee = if mutable {
+                let tmp = self.alloc()?;
+                self.emit(Instr::LoadCell { dst: tmp, cell: reg });
+                tmp
+            } else {
+                reg
+            };
+            let name = self.name(name);
+            let (base, argc) = self.arguments(args)?;
+            self.emit(Instr::CallLocal { dst, callee, name, args: base, argc });
+            return Ok(());
+        }
+
+        if is_special_form(name) {
+            return self.delegate(node, dst);
+        }
+
+        let name = self.name(name);
+        let (base, argc) = self.arguments(args)?;
+        self.chunk.needs_env = true;
+        self.emit(Instr::CallName { dst, name, args: base, argc });
+        Ok(())
+    }
+
+    // ------------------------------------------------------------------
+    // Statements
+    // ------------------------------------------------------------------
+
+    fn block(&mut self, statements: &[AstNode], dst: Reg, tail: bool) -> Result<(), String> {
+        if statements.is_empty() {
+            return Err("Empty block".to_string());
+        }
+
+        let saved_locals = self.locals.len();
+        let mark = self.next_reg;
+        self.depth += 1;
+
+        let last = statements.len() - 1;
+        let mut result = Ok(());
+        for (i, statement) in statements.iter().enumerate() {
+            result = self.statement(statement, dst, tail && i == last);
+            if result.is_err() {
+                break;
+            }
+        }
+
+        self.depth -= 1;
+        self.next_reg = mark;
+        self.locals.truncate(saved_locals);
+        result
+    }
+
+    /// Compile a statement of a block; declarations become locals
+    fn statement(&mut self, node: &AstNode, dst: Reg, tail: bool) -> Result<(), String> {
+        match node {
+            AstNode::VariableDecl { name, type_annotation, initializer } => {
+                // The local is only visible after its initializer
+                let reg = self.alloc()?;
+                self.expr(initializer, reg, false)?;
+                if let Some(ty) = type_annotation {
+                    self.chunk.types.push(ty.clone());
+                    let ty = (self.chunk.types.len() - 1) as Index;
+                    let name = self.name(name);
+                    self.emit(Instr::CheckDecl { reg, name, ty });
+                }
+                self.locals.push(Local { name: name.clone(), reg, mutable: false });
+                self.emit(Instr::Move { dst, src: reg });
+                Ok(())
+            }
+            AstNode::MutableDecl { type_annotation: Some(_), .. } => {
+                // Typed cells would need their annotation enforced on every store
+                Err("typed mutable local".to_string())
+            }
+            AstNode::MutableDecl { name, type_annotation: None, initializer } => {
+                let reg = self.alloc()?;
+                self.expr(initializer, dst, false)?;
+                self.emit(Instr::NewCell { dst: reg, src: dst });
+                self.locals.push(Local { name: name.clone(), reg, mutable: true });
+                Ok(())
+            }
+            _ => self.expr(node, dst, tail),
+        }
+    }
+
+    /// `let`/`mut` at the top level of a file or REPL line
+    fn global_declaration(&mut self, node: &AstNode, dst: Reg) -> Result<(), String> {
+        let (name, type_annotation, initializer, mutable) = match node {
+            AstNode::VariableDecl { name, type_annotation, initializer } => (name, type_annotation, initializer, false),
+            AstNode::MutableDecl { name, type_annotation, initializer } => (name, type_annotation, initializer, true),
+            _ => unreachable!("not a declaration"),
+        };
+
+        let src = self.operand(initializer)?;
+        let ty = type_annotation.as_ref().map(|ty| {
+            self.chunk.types.push(ty.clone());
+            (self.chunk.types.len() - 1) as Index
+        });
+        let name = self.name(name);
+        self.chunk.needs_env = true;
+        self.emit(Instr::DefineName { dst, name, src, mutable, ty });
+        Ok(())
+    }
+
+    /// Leave `node` to the tree-walker, exposing the locals it mentions
+    fn delegate(&mut self, node: &AstNode, dst: Reg) -> Result<(), String> {
+        let mut mentioned = BTreeSet::new();
+        collect_names(node, &mut mentioned);
+
+        let mut captures = Vec::new();
+        for name in &mentioned {
+            if let Some(local) = self.resolve(name) {
+                let (reg, is_cell) = (local.reg, local.mutable);
+                captures.push(Capture { name: self.name(name), reg, is_cell });
+            }
+        }
+
+        // Run under the capture scope, not the function's own scopes
+        self.chunk.nodes.push(crate::resolver::resolve_detached(node));
+        self.chunk.captures.push(captures);
+        let node = (self.chunk.nodes.len() - 1) as Index;
+        let captures = (self.chunk.captures.len() - 1) as Index;
+        self.chunk.needs_env = true;
+        self.emit(Instr::Eval { dst, node, captures });
+        Ok(())
+    }
+}
+
+/// Collect every name `node` may look up in the environment
+///
+/// Conservative: binders (lambda parameters, pattern variables) are included
+/// too, which at worst captures a local that is shadowed anyway.
+fn collect_names(node: &AstNode, out: &mut BTreeSet<String>) {
+    match node {
+        AstNode::Number(_)
+        | AstNode::Boolean(_)
+        | AstNode::StringLiteral(_)
+        | AstNode::Null
+        | AstNode::ComplexLiteral { .. }
+        | AstNode::SelfReference
+        | AstNode::RecReference
+        | AstNode::TypeAlias { .. }
+        | AstNode::Import { .. } => {}
+
+        AstNode::VariableRef(name) | AstNode::LocalRef { name, .. } => {
+            out.insert(name.to_string());
+        }
+        AstNode::FunctionCall { name, args } => {
+            // Dotted calls look up their first segment
+            let head = name.split('.').next().unwrap_or(name);
+            out.insert(head.to_string());
+            args.iter().for_each(|arg| collect_names(arg, out));
+        }
+        AstNode::Export { items } => {
+            out.extend(items.iter().map(|item| item.name.clone()));
+        }
+
+        AstNode::BinaryOp { left, right, .. } => {
+            collect_names(left, out);
+            collect_names(right, out);
+        }
+        AstNode::UnaryOp { operand, .. } => collect_names(operand, out),
+        AstNode::If { condition, then_expr, else_expr } => {
+            collect_names(condition, out);
+            collect_names(then_expr, out);
+            collect_names(else_expr, out);
+        }
+        AstNode::Piecewise { cases, default } => {
+            for (condition, expression) in cases {
+                collect_names(condition, out);
+                collect_names(expression, out);
+            }
+            if let Some(default_expr) = default {
+                collect_names(default_expr, out);
+            }
+        }
+        AstNode::CallExpression { callee, args } => {
+            collect_names(callee, out);
+            args.iter().for_each(|arg| collect_names(arg, out));
+        }
+        AstNode::ArrayLiteral(elements) => {
+            for element in elements {
+                match element {
+                    ArrayElement::Single(expr) => collect_names(expr, out),
+                    ArrayElement::Spread(expr) => collect_names(expr, out),
+                }
+            }
+        }
+        AstNode::RecordLiteral(fields) => {
+            for field in fields {
+                match field {
+                    RecordFieldOrSpread::Field { value, .. } | RecordFieldOrSpread::MutableField { value, .. } => {
+                        collect_names(value, out)
+                    }
+                    RecordFieldOrSpread::Spread(expr) => collect_names(expr, out),
+                }
+            }
+        }
+        AstNode::FieldAccess { record, .. } => collect_names(record, out),
+        AstNode::VariableDecl { initializer, .. } | AstNode::MutableDecl { initializer, .. } => {
+            collect_names(initializer, out)
+        }
+        AstNode::Assignment { target, value } => {
+            collect_names(target, out);
+            collect_names(value, out);
+        }
+        AstNode::Return { value } | AstNode::Yield { value } | AstNode::Throw { value } => collect_names(value, out),
+        AstNode::Lambda { body, .. } => collect_names(body, out),
+        AstNode::Edge { metadata, .. } => {
+            if let Some(metadata) = metadata {
+                collect_names(metadata, out);
+            }
+        }
+        AstNode::IndexAccess { object, indices } => {
+            collect_names(object, out);
+            for index in indices {
+                match index {
+                    IndexArg::Single(expr) => collect_names(expr, out),
+                    IndexArg::Range { start, end } => {
+                        start.iter().chain(end.iter()).for_each(|expr| collect_names(expr, out));
+                    }
+                }
+            }
+        }
+        AstNode::Sequence { statements } | AstNode::DoBlock { statements } | AstNode::GenerateBlock { statements } => {
+            statements.iter().for_each(|statement| collect_names(statement, out));
+        }
+        AstNode::WhileLoop { condition, body } => {
+            collect_names(condition, out);
+            collect_names(body, out);
+        }
+        AstNode::ForInLoop { iterable, body, .. } => {
+            collect_names(iterable, out);
+            collect_names(body, out);
+        }
+        AstNode::TryCatch { try_block, catch_block, .. } => {
+            collect_names(try_block, out);
+            collect_names(catch_block, out);
+        }
+        AstNode::Match { value, arms } => {
+            collect_names(value, out);
+            for arm in arms {
+                if let Some(guard) = &arm.guard {
+                    collect_names(guard, out);
+                }
+                collect_names(&arm.body, out);
+            }
+        }
+    }
+}
@@ -0,0 +1,404 @@
+use achronyme_parser::ast::{AstNode, BinaryOp, UnaryOp};
+use achronyme_types::function::Function;
+use achronyme_types::value::Value;
+
+use super::bytecode::{Chunk, IndexOperand, Instr, Reg};
+use crate::evaluator::Evaluator;
+use crate::handlers;
+use crate::profiler::Phase;
+
+/// Allocate a frame for `chunk` with `args` in the parameter registers
+pub(crate) fn new_frame(chunk: &Chunk, args: Vec<Value>) -> Vec<Value> {
+    let mut regs = Vec::with_capacity(chunk.num_registers.max(args.len()));
+    regs.extend(args);
+    regs.resize(chunk.num_registers.max(regs.len()), Value::Null);
+    regs
+}
+
+/// Execute `chunk` in the frame `regs` until it returns
+///
+/// `function` is the function whose body the chunk is (function chunks only);
+/// `rec` calls re-enter the same chunk with a fresh frame.
+///
+/// A tree-walked subtree that produces an early return (or a generator
+/// yield) ends the frame with that marker, exactly as it would propagate
+/// through the enclosing blocks in the tree-walker.
+pub(crate) fn run(
+    evaluator: &mut Evaluator,
+    chunk: &Chunk,
+    regs: &mut [Value],
+    function: Option<&Function>,
+) -> Result<Value, String> {
+    let code = &chunk.code;
+    let mut pc = 0usize;
+    evaluator.check_deadline()?;
+
+    loop {
+        match &code[pc] {
+            Instr::LoadConst { dst, index } => {
+                regs[*dst as usize] = chunk.constants[*index as usize].clone();
+            }
+            Instr::Move { dst, src } => {
+                regs[*dst as usize] = regs[*src as usize].clone();
+            }
+            Instr::NewCell { dst, src } => {
+                regs[*dst as usize] = Value::new_mutable(regs[*src as usize].clone());
+            }
+            Instr::LoadCell { dst, cell } => {
+                regs[*dst as usize] = regs[*cell as usize].deref()?;
+            }
+            Instr::StoreCell { cell, src } => {
+                let value = regs[*src as usize].clone();
+                regs[*cell as usize].assign(value)?;
+            }
+
+            Instr::LoadName { dst, name } => {
+                regs[*dst as usize] = handlers::variables::evaluate_reference(evaluator, *name)?;
+            }
+            Instr::StoreName { name, src } => {
+                let name = &chunk.names[*name as usize];
+                let value = regs[*src as usize].clone();
+                handlers::assignment::assign_to_variable(evaluator, name, value)?;
+            }
+            Instr::DefineName { dst, name, src, mutable, ty } => {
+                let name = &chunk.names[*name as usize];
+                let type_annotation = ty.map(|ty| &chunk.types[ty as usize]);
+                let value = regs[*src as usize].clone();
+                regs[*dst as usize] = handlers::variables::declare(evaluator, name, type_annotation, value, *mutable)?;
+            }
+            Instr::CheckDecl { reg, name, ty } => {
+                let name = &chunk.names[*name as usize];
+                let resolved_type = evaluator.resolve_type(&chunk.types[*ty as usize]);
+                let value = std::mem::replace(&mut regs[*reg as usize], Value::Null);
+                regs[*reg as usize] = evaluator.profile_phase(Phase::TypeCheck, |_| {
+                    handlers::variables::check_declared_type(name, &resolved_type, value)
+                })?;
+            }
+
+            Instr::Binary { op, dst, lhs, rhs } => {
+                let fast = match (&regs[*lhs as usize], &regs[*rhs as usize]) {
+                    (Value::Number(a), Value::Number(b)) => numeric_binary(op, *a, *b),
+                    _ => None,
+                };
+                regs[*dst as usize] = match fast {
+                    Some(value) => value,
+                    None => {
+                        let left = regs[*lhs as usize].clone();
+                        let right = regs[*rhs as usize].clone();
+                        handlers::binary_ops::apply(op, left, right)?
+                    }
+                };
+            }
+            Instr::Unary { op, dst, src } => {
+                regs[*dst as usize] = match (op, &regs[*src as usize]) {
+                    (UnaryOp::Negate, Value::Number(n)) => Value::Number(-n),
+                    (_, operand) => handlers::unary_ops::apply(op, operand.clone())?,
+                };
+            }
+
+            Instr::Jump { target } => {
+                // Backward jumps close loops
+                if (*target as usize) <= pc {
+                    evaluator.check_deadline()?;
+                }
+                pc = *target as usize;
+                continue;
+            }
+            Instr::JumpIfFalse { cond, target } => {
+                let truthy = match &regs[*cond as usize] {
+                    Value::Boolean(b) => *b,
+                    other => handlers::control_flow::value_to_bool(other)?,
+                };
+                if !truthy {
+                    pc = *target as usize;
+                    continue;
+                }
+            }
+
+            Instr::CallName { dst, name, args, argc } => {
+                let name = &chunk.names[*name as usize];
+                let args = take_args(regs, *args, *argc);
+                regs[*dst as usize] = call_named(evaluator, name, args)?;
+            }
+            Instr::CallLocal { dst, callee, name, args, argc } => {
+                let name = &chunk.names[*name as usize];
+                let callee = regs[*callee as usize].clone();
+                let args = take_args(regs, *args, *argc);
+                regs[*dst as usize] = call_local(evaluator, name, callee, args)?;
+            }
+            Instr::CallValue { dst, callee, args, argc } => {
+                let callee = regs[*callee as usize].clone();
+                let args = take_args(regs, *args, *argc);
+                regs[*dst as usize] = call_value(evaluator, callee, args)?;
+            }
+            Instr::CallRec { dst, args, argc } => {
+                let function = function.ok_or_else(|| "'rec' can only be used inside functions".to_string())?;
+                let args = take_args(regs, *args, *argc);
+                regs[*dst as usize] = call_rec(evaluator, chunk, function, args)?;
+            }
+            Instr::TailCallRec { args, argc } => {
+                let function = function.ok_or_else(|| "'rec' can only be used inside functions".to_string())?;
+                let args = take_args(regs, *args, *argc);
+                if let Function::UserDefined { params, param_types, .. } = function {
+                    if args.len() != params.len() {
+                        return Err(format!(
+                            "Tail call arity mismatch: expected {} arguments, got {}",
+                            params.len(),
+                            args.len()
+                        ));
+                    }
+                    evaluator.profile_phase(Phase::TypeCheck, |_| {
+                        handlers::functions::check_arguments(params, param_types, &args)
+                    })?;
+                }
+                // Rebind the parameters and restart the body
+                for (reg, arg) in regs.iter_mut().zip(args) {
+                    *reg = arg;
+                }
+                evaluator.check_deadline()?;
+                pc = 0;
+                continue;
+            }
+
+            Instr::Index { dst, object, spec } => {
+                let mut indices = Vec::with_capacity(chunk.indices[*spec as usize].len());
+                for operand in &chunk.indices[*spec as usize] {
+                    indices.push(match operand {
+                        IndexOperand::Single(reg) => handlers::indexing::single_index(&regs[*reg as usize])?,
+                        IndexOperand::Range { start, end } => handlers::indexing::EvaluatedIndex::Range {
+                            start: handlers::indexing::range_bound(start.map(|r| &regs[r as usize]), "start")?,
+                            end: handlers::indexing::range_bound(end.map(|r| &regs[r as usize]), "end")?,
+                        },
+                    });
+                }
+                regs[*dst as usize] = handlers::indexing::index_value(&regs[*object as usize], &indices)?;
+            }
+            Instr::Field { dst, object, field } => {
+                let field = &chunk.names[*field as usize];
+                regs[*dst as usize] = match &regs[*object as usize] {
+                    // Fast path: read the field without copying the whole record
+                    Value::Record(map) => map
+                        .get(field)
+                        .ok_or_else(|| format!("Field '{}' not found in record", field))?
+                        .deref()?,
+                    other => Evaluator::access_field(other.clone(), field)?,
+                };
+            }
+            Instr::MakeArray { dst, spec } => {
+                let elements = &chunk.arrays[*spec as usize];
+                let mut values = Vec::with_capacity(elements.len());
+                for (reg, is_spread) in elements {
+                    let value = regs[*reg as usize].clone();
+                    if *is_spread {
+                        handlers::literals::spread_into(&mut values, value)?;
+                    } else {
+                        values.push(value);
+                    }
+                }
+                regs[*dst as usize] = handlers::literals::build_array(values)?;
+            }
+
+            Instr::Eval { dst, node, captures } => {
+                let value = eval_node(evaluator, chunk, regs, &chunk.nodes[*node as usize], *captures as usize)?;
+                if matches!(value, Value::EarlyReturn(_) | Value::GeneratorYield(_)) {
+                    return Ok(value);
+                }
+                regs[*dst as usize] = value;
+            }
+
+            Instr::Fail { message } => {
+                return Err(chunk.names[*message as usize].clone());
+            }
+            Instr::Return { src } => {
+                return Ok(std::mem::replace(&mut regs[*src as usize], Value::Null));
+            }
+        }
+        pc += 1;
+    }
+}
+
+/// Number-only fast path for binary operators
+///
+/// Returns `None` whenever the generic handler must decide (including the
+/// division/modulo by zero errors), so results and messages stay identical.
+#[inline]
+fn numeric_binary(op: &BinaryOp, a: f64, b: f64) -> Option<Value> {
+    Some(match op {
+        BinaryOp::Add => Value::Number(a + b),
+        BinaryOp::Subtract => Value::Number(a - b),
+        BinaryOp::Multiply => Value::Number(a * b),
+        BinaryOp::Divide if b != 0.0 => Value::Number(a / b),
+        BinaryOp::Modulo if b != 0.0 => Value::Number(a % b),
+        BinaryOp::Power => Value::Number(a.powf(b)),
+        BinaryOp::Gt => Value::Boolean(a > b),
+        BinaryOp::Lt => Value::Boolean(a < b),
+        BinaryOp::Gte => Value::Boolean(a >= b),
+        BinaryOp::Lte => Value::Boolean(a <= b),
+        BinaryOp::Eq => Value::Boolean(a == b),
+        BinaryOp::Neq => Value::Boolean(a != b),
+        _ => return None,
+    })
+}
+
+/// Move call arguments out of their (temporary) registers
+fn take_args(regs: &mut [Value], base: Reg, argc: u16) -> Vec<Value> {
+    let base = base as usize;
+    regs[base..base + argc as usize]
+        .iter_mut()
+        .map(|reg| std::mem::replace(reg, Value::Null))
+        .collect()
+}
+
+/// Tree-walk a delegated subtree with the captured locals in scope
+fn eval_node(
+    evaluator: &mut Evaluator,
+    chunk: &Chunk,
+    regs: &[Value],
+    node: &AstNode,
+    captures: usize,
+) -> Result<Value, String> {
+    let captures = &chunk.captures[captures];
+    if captures.is_empty() {
+        return evaluator.evaluate(node);
+    }
+
+    evaluator.environment_mut().push_scope();
+
+    let mut bound = Ok(());
+    for capture in captures {
+        let name = chunk.names[capture.name as usize].clone();
+        let value = regs[capture.reg as usize].clone();
+        bound = if capture.is_cell {
+            evaluator.environment_mut().bind_cell(name, value)
+        } else {
+            evaluator.environment_mut().define(name, value)
+        };
+        if bound.is_err() {
+            break;
+        }
+    }
+    let result = bound.and_then(|_| evaluator.evaluate(node));
+
+    evaluator.environment_mut().pop_scope();
+    result
+}
+
+/// Call a function by name, following `function_call::dispatch` for
+/// non-special-form names
+fn call_named(evaluator: &mut Evaluator, name: &str, args: Vec<Value>) -> Result<Value, String> {
+    // Check if it's a constant (zero arguments)
+    if args.is_empty() && evaluator.constants().has(name) {
+        return Ok(Value::Number(evaluator.constants().get(name)?));
+    }
+
+    // Check if it's a lambda stored in a variable
+    if evaluator.environment().has(name) {
+        let value = evaluator.environment().get(name)?;
+        evaluator.profile_name(name, &value);
+        if let Value::Function(func) = value {
+            return evaluator.apply_lambda(&func, args);
+        }
+    }
+
+    call_builtin(evaluator, name, args)
+}
+
+/// Call a local by name (the local shadows any variable of that name)
+fn call_local(evaluator: &mut Evaluator, name: &str, callee: Value, args: Vec<Value>) -> Result<Value, String> {
+    // Constants win over variables for zero-argument calls, as in dispatch
+    if args.is_empty() && evaluator.constants().has(name) {
+        return Ok(Value::Number(evaluator.constants().get(name)?));
+    }
+
+    evaluator.profile_name(name, &callee);
+    match callee {
+        Value::Function(func) => evaluator.apply_lambda(&func, args),
+        _ => call_builtin(evaluator, name, args),
+    }
+}
+
+/// Call the result of an arbitrary callee expression
+fn call_value(evaluator: &mut Evaluator, callee: Value, args: Vec<Value>) -> Result<Value, String> {
+    match callee {
+        Value::Function(func) => match &*func {
+            Function::Builtin(name) if handlers::variables::is_special_form(name) => {
+                call_special_form(evaluator, name, args)
+            }
+            Function::Builtin(name) => call_named(evaluator, name, args),
+            _ => evaluator.apply_lambda(&func, args),
+        },
+        _ => Err("CallExpression requires a function, got non-function value".to_string()),
+    }
+}
+
+/// Call a module or registry function
+fn call_builtin(evaluator: &mut Evaluator, name: &str, args: Vec<Value>) -> Result<Value, String> {
+    let function_info = if let Some((func, arity)) = evaluator.module_registry().resolve(name, evaluator.imported_modules()) {
+        Some((func, arity))
+    } else if evaluator.functions().has(name) {
+        evaluator.functions().get(name)
+    } else {
+        None
+    };
+
+    let (func, expected_arity) = function_info
+        .ok_or_else(|| format!("Unknown function or constant: {}", name))?;
+
+    // Check arity (if not variadic)
+    if expected_arity >= 0 && args.len() != expected_arity as usize {
+        return Err(format!(
+            "Function {} expects {} arguments, got {}",
+            name,
+            expected_arity,
+            args.len()
+        ));
+    }
+
+    evaluator.profile_builtin(name, |evaluator| func(&args, evaluator.environment_mut()))
+}
+
+/// Call a special form with already evaluated arguments
+///
+/// Special forms take AST arguments, so the values are bound to hidden
+/// variables (names no program can spell) and passed as references to them.
+fn call_special_form(evaluator: &mut Evaluator, name: &str, args: Vec<Value>) -> Result<Value, String> {
+    evaluator.environment_mut().push_scope();
+
+    let mut nodes = Vec::with_capacity(args.len());
+    let mut bound = Ok(());
+    for (i, arg) in args.into_iter().enumerate() {
+        let hidden = format!("#arg{}", i);
+        bound = evaluator.environment_mut().define(hidden.clone(), arg);
+        if bound.is_err() {
+            break;
+        }
+        nodes.push(AstNode::VariableRef(hidden.as_str().into()));
+    }
+    let result = bound.and_then(|_| handlers::function_call::dispatch(evaluator, name, &nodes));
+
+    evaluator.environment_mut().pop_scope();
+    result
+}
+
+/// `rec(...)` from inside a compiled body: re-enter the same chunk
+///
+/// The environment already is the function's own, so only a new frame is
+/// needed.
+fn call_rec(evaluator: &mut Evaluator, chunk: &Chunk, function: &Function, args: Vec<Value>) -> Result<Value, String> {
+    let Function::UserDefined { params, param_types, return_type, .. } = function else {
+        return Err("'rec' can only be used inside functions".to_string());
+    };
+
+    evaluator.profile_function(function, |evaluator| {
+        evaluator.profile_phase(Phase::TypeCheck, |_| handlers::functions::check_arguments(params, param_types, &args))?;
+
+        let mut regs = new_frame(chunk, args);
+        let result = match run(evaluator, chunk, &mut regs, Some(function))? {
+            Value::EarlyReturn(value) => *value,
+            other => other,
+        };
+
+        evaluator.profile_phase(Phase::TypeCheck, |_| handlers::functions::check_return_type(return_type, &result))?;
+        Ok(result)
+    })
+}
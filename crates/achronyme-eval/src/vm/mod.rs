@@ -0,0 +1,147 @@
+//! Bytecode compiler and register VM
+//!
+//! An opt-in alternative to tree-walking for hot code: top-level statements
+//! and user-defined function bodies are compiled into a flat instruction
+//! list over a register frame, so locals, loop counters and arithmetic no
+//! longer go through `Environment` lookups and scope cloning.
+//!
+//! ```text
+//! n => do { mut acc = 0; mut i = 0; while (i < n) { acc = acc + i; i = i + 1 }; acc }
+//!
+//!    0  LOADK     r1 Number(0.0)
+//!    1  NEWCELL   r2 r1            ; mut acc
+//!    ...
+//!    5  LOADCELL  r5 r3
+//!    6  LT        r4 r5 r0         ; i < n
+//!    7  JUMPIFNOT r4 17
+//!    ...
+//!   16  JUMP      5
+//!   17  LOADCELL  r1 r2
+//!   18  RETURN    r1
+//! ```
+//!
+//! The compiler is deliberately partial: any construct without a native
+//! lowering (records, lambdas, match, try/catch, generators, special-form
+//! calls such as `map`, ...) is emitted as an `Eval` instruction that hands
+//! the original subtree back to the tree-walker, with the locals it mentions
+//! made visible in a temporary scope. Bodies the compiler refuses outright
+//! simply keep running on the tree-walker, so enabling the VM never changes
+//! which programs are accepted.
+//!
+//! Enable it with [`Evaluator::set_bytecode_mode`].
+
+mod bytecode;
+mod compiler;
+mod machine;
+
+use std::rc::Rc;
+
+use achronyme_parser::ast::AstNode;
+use achronyme_types::function::Function;
+use achronyme_types::value::Value;
+
+pub use bytecode::{Capture, Chunk, Index, IndexOperand, Instr, Reg};
+pub use compiler::{compile_function, compile_statement};
+
+use crate::evaluator::Evaluator;
+use crate::tco;
+
+/// Upper bound on cached compiled function bodies before the cache is reset
+const MAX_COMPILED_FUNCTIONS: usize = 1024;
+
+impl Evaluator {
+    /// Evaluate a top-level statement on the VM, falling back to the
+    /// tree-walker when the compiler refuses it (or would only delegate)
+    pub(crate) fn evaluate_compiled(&mut self, node: &AstNode) -> Result<Value, String> {
+        let chunk = match compile_statement(node) {
+            Ok(chunk) if !chunk.is_single_fallback() => chunk,
+            _ => return self.evaluate(node),
+        };
+
+        let mut regs = machine::new_frame(&chunk, Vec::new());
+        machine::run(self, &chunk, &mut regs, None)
+    }
+
+    /// The compiled body of a user-defined function, if bytecode mode is on
+    /// and the compiler accepts it
+    ///
+    /// Tail-recursive bodies that would still delegate part of their code keep
+    /// using the tree-walker's TCO loop, since delegated `rec` calls can't be
+    /// turned into jumps.
+    pub(crate) fn compiled_body(&mut self, function: &Function) -> Option<Rc<Chunk>> {
+        if !self.bytecode_mode {
+            return None;
+        }
+        let Function::UserDefined { params, body, .. } = function else {
+            return None;
+        };
+
+        let key = Rc::as_ptr(body) as usize;
+        if let Some((_, compiled)) = self.compiled_functions.get(&key) {
+            return compiled.clone();
+        }
+
+        let compiled = compile_function(params, body)
+            .ok()
+            .filter(|chunk| chunk.fallback_count() == 0 || !tco::is_tail_recursive_function(body))
+            .map(Rc::new);
+
+        if self.compiled_functions.len() >= MAX_COMPILED_FUNCTIONS {
+            self.compiled_functions.clear();
+        }
+        // Keep the body alive so its address can't be reused by another function
+        self.compiled_functions.insert(key, (body.clone(), compiled.clone()));
+        compiled
+    }
+}
+
+/// Run a user-defined function's compiled body
+///
+/// Arity and parameter types have already been checked by `apply_lambda`.
+/// When the chunk touches the environment, the closure environment is
+/// installed with `rec` and `self` exactly as the tree-walker does; otherwise
+/// the frame runs without touching the environment at all.
+pub(crate) fn call_function(
+    evaluator: &mut Evaluator,
+    function: &Function,
+    chunk: &Chunk,
+    args: Vec<Value>,
+) -> Result<Value, String> {
+    let Function::UserDefined { closure_env, .. } = function else {
+        return Err("Only user-defined functions can be compiled".to_string());
+    };
+
+    // Compiled frames handle `rec` tail calls themselves
+    let saved_tco = evaluator.is_tco_mode();
+    evaluator.set_tco_mode(false);
+
+    let saved_env = if chunk.needs_env {
+        let saved_env = evaluator.environment().clone();
+
+        // Check if 'self' is defined in the current environment (for record methods)
+        let self_value = saved_env.get("self").ok();
+
+        *evaluator.environment_mut() = closure_env.borrow().clone();
+        evaluator.environment_mut().define("rec".to_string(), Value::from(function.clone()))?;
+        if let Some(self_val) = self_value {
+            evaluator.environment_mut().define("self".to_string(), self_val)?;
+        }
+        Some(saved_env)
+    } else {
+        None
+    };
+
+    let mut regs = machine::new_frame(chunk, args);
+    let result = machine::run(evaluator, chunk, &mut regs, Some(function));
+
+    if let Some(saved_env) = saved_env {
+        *evaluator.environment_mut() = saved_env;
+    }
+    evaluator.set_tco_mode(saved_tco);
+
+    // Check if the result is an EarlyReturn - unwrap it
+    match result {
+        Ok(Value::EarlyReturn(value)) => Ok(*value),
+        other => other,
+    }
+}
@@ -0,0 +1,178 @@
+use achronyme_eval::vm::{compile_function, compile_statement};
+use achronyme_eval::Evaluator;
+use achronyme_parser::parse;
+use achronyme_types::value::Value;
+
+fn eval_tree(source: &str) -> Result<Value, String> {
+    let mut evaluator = Evaluator::new();
+    evaluator.eval_str(source)
+}
+
+fn eval_vm(source: &str) -> Result<Value, String> {
+    let mut evaluator = Evaluator::new();
+    evaluator.set_bytecode_mode(true);
+    evaluator.eval_str(source)
+}
+
+/// Evaluate with both the tree-walker and the VM and require identical results
+fn eval_both(source: &str) -> Result<Value, String> {
+    let tree = eval_tree(source);
+    let vm = eval_vm(source);
+    assert_eq!(tree, vm, "tree-walker and VM disagree on: {}", source);
+    vm
+}
+
+// ========================================================================
+// Differential tests: VM results match the tree-walker
+// ========================================================================
+
+#[test]
+fn test_vm_arithmetic_and_globals() {
+    assert_eq!(eval_both("2 + 3 * 4 ^ 2 - 10 % 3").unwrap(), Value::Number(49.0));
+    assert_eq!(eval_both("let x = 5\nlet y = x * 2\ny - x").unwrap(), Value::Number(5.0));
+    assert_eq!(eval_both("mut x = 1\nx = x + 41\nx").unwrap(), Value::Number(42.0));
+    assert_eq!(eval_both("-pi < 0 && !(1 > 2)").unwrap(), Value::Boolean(true));
+}
+
+#[test]
+fn test_vm_while_loop_with_mut_locals() {
+    let source = r#"
+        let sum_to = n => do {
+            mut acc = 0
+            mut i = 1
+            while (i <= n) {
+                acc = acc + i
+                i = i + 1
+            }
+            acc
+        }
+        sum_to(1000)
+    "#;
+    assert_eq!(eval_both(source).unwrap(), Value::Number(500500.0));
+}
+
+#[test]
+fn test_vm_while_loop_value() {
+    assert_eq!(eval_both("mut i = 0\nwhile (i < 3) { i = i + 1 }").unwrap(), Value::Number(3.0));
+    assert_eq!(eval_both("while (false) { 1 }").unwrap(), Value::Number(0.0));
+}
+
+#[test]
+fn test_vm_recursion() {
+    let fib = "let fib = n => if (n < 2) { n } else { rec(n - 1) + rec(n - 2) }\nfib(15)";
+    assert_eq!(eval_both(fib).unwrap(), Value::Number(610.0));
+
+    let fact = "let fact = (n, acc) => if (n <= 1) { acc } else { rec(n - 1, acc * n) }\nfact(10, 1)";
+    assert_eq!(eval_both(fact).unwrap(), Value::Number(3628800.0));
+}
+
+#[test]
+fn test_vm_deep_tail_recursion() {
+    // Tail calls become jumps, so this must not overflow the stack
+    let source = "let count = (n, acc) => if (n == 0) { acc } else { rec(n - 1, acc + 1) }\ncount(100000, 0)";
+    assert_eq!(eval_vm(source).unwrap(), Value::Number(100000.0));
+}
+
+#[test]
+fn test_vm_closures_capture_locals() {
+    let source = r#"
+        let make_adder = n => do {
+            let k = n * 2
+            x => x + k
+        }
+        let add10 = make_adder(5)
+        add10(1)
+    "#;
+    assert_eq!(eval_both(source).unwrap(), Value::Number(11.0));
+}
+
+#[test]
+fn test_vm_mut_cell_shared_with_delegated_code() {
+    // The lambda passed to map is tree-walked; its writes must reach the cell
+    let source = r#"
+        let total = xs => do {
+            mut acc = 0
+            map(x => do { acc = acc + x; x }, xs)
+            acc
+        }
+        total([1, 2, 3, 4])
+    "#;
+    assert_eq!(eval_both(source).unwrap(), Value::Number(10.0));
+}
+
+#[test]
+fn test_vm_early_return() {
+    let source = r#"
+        let find_first = (xs, target) => do {
+            mut i = 0
+            while (i < 10) {
+                if (xs[i] == target) { return i } else { 0 }
+                i = i + 1
+            }
+            -1
+        }
+        find_first([4, 8, 15, 16, 23, 42, 0, 0, 0, 0], 16)
+    "#;
+    assert_eq!(eval_both(source).unwrap(), Value::Number(3.0));
+}
+
+#[test]
+fn test_vm_arrays_indexing_and_fields() {
+    assert_eq!(eval_both("let f = v => [0, ...v, v[1]]\nf([1, 2])").unwrap(), eval_tree("[0, 1, 2, 2]").unwrap());
+    assert_eq!(eval_both("let f = x => [[x, 1], [2, x]]\nf(3)[1, 0]").unwrap(), Value::Number(2.0));
+    assert_eq!(eval_both("let p = { x: 1, y: 2 }\nlet f = r => r.x + r.y\nf(p)").unwrap(), Value::Number(3.0));
+    // Slices are compared against the tree-walker inside eval_both
+    assert!(eval_both("let f = v => v[1..3]\nf([1, 2, 3, 4])").is_ok());
+}
+
+#[test]
+fn test_vm_builtins_and_piecewise() {
+    assert_eq!(eval_both("let f = x => sqrt(x) + abs(-x)\nf(16)").unwrap(), Value::Number(20.0));
+    let source = "let sign = x => piecewise([x < 0, -1], [x > 0, 1], 0)\n[sign(-3), sign(0), sign(2)]";
+    assert_eq!(eval_both(source).unwrap(), eval_tree("[-1, 0, 1]").unwrap());
+}
+
+#[test]
+fn test_vm_typed_declarations() {
+    assert_eq!(eval_both("let f = x => do { let y: Number = x + 1; y }\nf(1)").unwrap(), Value::Number(2.0));
+    let err = eval_both("let f = x => do { let y: Number = \"s\"; y }\nf(1)").unwrap_err();
+    assert!(err.contains("Type error: variable 'y'"), "unexpected error: {}", err);
+}
+
+#[test]
+fn test_vm_errors_match_tree_walker() {
+    assert!(eval_both("let f = x => x / 0\nf(1)").is_err());
+    assert!(eval_both("let f = x => do { let y = 1; y = 2; y }\nf(1)").is_err());
+    assert!(eval_both("let f = (a, b) => a + b\nf(1)").is_err());
+    assert!(eval_both("let f = x => x + undefined_name\nf(1)").is_err());
+}
+
+// ========================================================================
+// Compiler tests
+// ========================================================================
+
+#[test]
+fn test_compiler_lowers_loops_natively() {
+    let body = &parse("do { mut acc = 0; mut i = 0; while (i < n) { acc = acc + i; i = i + 1 }; acc }").unwrap()[0];
+    let chunk = compile_function(&["n".to_string()], body).unwrap();
+
+    assert_eq!(chunk.arity, 1);
+    assert_eq!(chunk.fallback_count(), 0);
+    // Locals live in registers: the environment is never touched
+    assert!(!chunk.needs_env);
+}
+
+#[test]
+fn test_compiler_delegates_unsupported_nodes() {
+    let stmt = &parse("match 1 { 1 => \"one\", _ => \"other\" }").unwrap()[0];
+    let chunk = compile_statement(stmt).unwrap();
+
+    assert!(chunk.is_single_fallback());
+    assert!(chunk.needs_env);
+}
+
+#[test]
+fn test_compiler_refuses_typed_mut_locals() {
+    let body = &parse("do { mut x: Number = 1; x }").unwrap()[0];
+    assert!(compile_function(&[], body).is_err());
+}
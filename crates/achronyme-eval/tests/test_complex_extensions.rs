@@ -88,6 +88,63 @@ fn test_complex_vector_multiplication() {
     }
 }
 
+#[test]
+fn test_complex_matrix_multiplication() {
+    let mut evaluator = Evaluator::new();
+
+    // `*` is element-wise on complex tensors; matmul() multiplies matrices
+    let result = evaluator.eval_str("matmul([[1+i, 2i], [3, 1-i]], [[2, 0], [i, 1]])").unwrap();
+
+    match result {
+        Value::ComplexTensor(ct) => {
+            assert_eq!(ct.shape(), &[2, 2]);
+            // (1+i)*2 + 2i*i = 2i
+            assert_eq!(ct.data()[0], Complex::new(0.0, 2.0));
+            assert_eq!(ct.data()[1], Complex::new(0.0, 2.0));
+            // 3*2 + (1-i)*i = 7 + i
+            assert_eq!(ct.data()[2], Complex::new(7.0, 1.0));
+            assert_eq!(ct.data()[3], Complex::new(1.0, -1.0));
+        }
+        _ => panic!("Expected ComplexTensor, got {:?}", result),
+    }
+}
+
+#[test]
+fn test_complex_matrix_star_is_elementwise() {
+    let mut evaluator = Evaluator::new();
+
+    let result = evaluator.eval_str("[[1+i, 2i], [3, 1-i]] * [[2, 0], [i, 1]]").unwrap();
+
+    match result {
+        Value::ComplexTensor(ct) => {
+            assert_eq!(ct.shape(), &[2, 2]);
+            assert_eq!(ct.data()[0], Complex::new(2.0, 2.0));
+            assert_eq!(ct.data()[1], Complex::new(0.0, 0.0));
+            assert_eq!(ct.data()[2], Complex::new(0.0, 3.0));
+            assert_eq!(ct.data()[3], Complex::new(1.0, -1.0));
+        }
+        _ => panic!("Expected ComplexTensor, got {:?}", result),
+    }
+}
+
+#[test]
+fn test_matmul_promotes_real_matrices() {
+    let mut evaluator = Evaluator::new();
+
+    let result = evaluator.eval_str("matmul([[1, 2], [3, 4]], [[i, 0], [0, 1]])").unwrap();
+
+    match result {
+        Value::ComplexTensor(ct) => {
+            assert_eq!(ct.data()[0], Complex::new(0.0, 1.0));
+            assert_eq!(ct.data()[1], Complex::new(2.0, 0.0));
+            assert_eq!(ct.data()[2], Complex::new(0.0, 3.0));
+            assert_eq!(ct.data()[3], Complex::new(4.0, 0.0));
+        }
+        _ => panic!("Expected ComplexTensor, got {:?}", result),
+    }
+    assert!(evaluator.eval_str("matmul([1, 2], [3, 4])").is_err());
+}
+
 #[test]
 fn test_real_to_complex_promotion() {
     let mut evaluator = Evaluator::new();
@@ -121,6 +121,82 @@ fn test_fft_phase() {
     }
 }
 
+#[test]
+fn test_rfft_half_spectrum() {
+    let result = eval("rfft([1, 2, 3, 4, 5, 6])").unwrap();
+    if let Value::ComplexTensor(t) = result {
+        assert_eq!(t.data().len(), 4);
+        assert!((t.data()[0].re - 21.0).abs() < 1e-10);
+    } else {
+        panic!("Expected ComplexTensor, got {:?}", result);
+    }
+}
+
+#[test]
+fn test_rfft_irfft_roundtrip() {
+    let result = eval("irfft(rfft([1, 2, 3, 4, 5]), 5)").unwrap();
+    if let Value::Tensor(t) = result {
+        assert_eq!(t.data().len(), 5);
+        for (i, x) in t.data().iter().enumerate() {
+            assert!((x - (i + 1) as f64).abs() < 1e-10);
+        }
+    } else {
+        panic!("Expected Tensor, got {:?}", result);
+    }
+}
+
+#[test]
+fn test_irfft_length_mismatch() {
+    assert!(eval("irfft(rfft([1, 2, 3, 4]), 8)").is_err());
+}
+
+#[test]
+fn test_stft_shape() {
+    let result = eval("stft(linspace(0, 1, 100), 16, 8)").unwrap();
+    if let Value::ComplexTensor(t) = result {
+        // 1 + ceil((100 - 16) / 8) frames of 16 / 2 + 1 bins
+        assert_eq!(t.shape(), &[12, 9]);
+    } else {
+        panic!("Expected ComplexTensor, got {:?}", result);
+    }
+}
+
+#[test]
+fn test_stft_istft_roundtrip() {
+    let result = eval(r#"
+        let x = linspace(-1, 1, 64);
+        istft(stft(x, 16, 4, "hamming"), 16, 4, "hamming", 64)
+    "#).unwrap();
+    if let Value::Tensor(t) = result {
+        assert_eq!(t.data().len(), 64);
+        for (i, x) in t.data().iter().enumerate() {
+            assert!((x - (-1.0 + 2.0 * i as f64 / 63.0)).abs() < 1e-9);
+        }
+    } else {
+        panic!("Expected Tensor, got {:?}", result);
+    }
+}
+
+#[test]
+fn test_spectrogram_channels() {
+    let result = eval(r#"spectrogram([[1, 0, 0, 0, 1, 0, 0, 0], [0, 1, 0, 1, 0, 1, 0, 1]], 4, 4, "rectangular", 0)"#).unwrap();
+    if let Value::Tensor(t) = result {
+        assert_eq!(t.shape(), &[2, 2, 3]);
+        // An impulse at the frame start has a flat power spectrum
+        assert_eq!(&t.data()[..3], &[1.0, 1.0, 1.0]);
+    } else {
+        panic!("Expected Tensor, got {:?}", result);
+    }
+}
+
+#[test]
+fn test_stft_errors() {
+    assert!(eval("stft([1, 2, 3], 4)").is_err());
+    assert!(eval("stft([1, 2, 3], 4, 0)").is_err());
+    assert!(eval(r#"stft([1, 2, 3], 4, 2, "kaiser")"#).is_err());
+    assert!(eval("istft([1, 2, 3], 4, 2)").is_err());
+}
+
 #[test]
 fn test_conv_basic() {
     let result = eval("conv([1, 2, 3], [1, 1])").unwrap();
@@ -148,6 +224,14 @@ fn test_linspace_error_less_than_2() {
     assert!(result.unwrap_err().contains("n >= 2"));
 }
 
+#[test]
+fn test_generated_length_is_capped() {
+    for source in ["linspace(0, 1, 1e12)", "hanning(1e12)", "irfft([1, 2], 1e12)"] {
+        let err = eval(source).unwrap_err();
+        assert!(err.contains("exceeds the maximum"), "{}: {}", source, err);
+    }
+}
+
 #[test]
 fn test_window_functions_accessible() {
     let result = eval(r#"
@@ -178,3 +262,20 @@ fn test_linspace_as_first_class_value() {
         panic!("Expected Tensor, got {:?}", result);
     }
 }
+
+#[test]
+fn test_spectrum_conj_and_arg() {
+    let spectrum = eval("fft([1, 2, 3, 4, 5])").unwrap();
+    let conjugated = eval("conj(fft([1, 2, 3, 4, 5]))").unwrap();
+    let phases = eval("arg(fft([1, 2, 3, 4, 5]))").unwrap();
+    match (spectrum, conjugated, phases) {
+        (Value::ComplexTensor(s), Value::ComplexTensor(c), Value::Tensor(p)) => {
+            assert_eq!(c.shape(), s.shape());
+            for ((z, zc), phase) in s.data().iter().zip(c.data()).zip(p.data()) {
+                assert_eq!(*zc, z.conjugate());
+                assert_eq!(*phase, z.phase());
+            }
+        }
+        other => panic!("Expected complex spectra and a phase tensor, got {:?}", other),
+    }
+}
@@ -76,3 +76,59 @@ fn test_comparison() {
     let result = eval("5 < 3").unwrap();
     assert_eq!(result, Value::Boolean(false));
 }
+
+#[test]
+fn test_numeric_matrix_literal() {
+    // Built directly from the literals; same value as the general path
+    let literal = eval("[[1, -2.5], [3, 4e-1]]").unwrap();
+    let computed = eval("[[1, -(2.5)], [3, 0.4 + 0]]").unwrap();
+    assert_eq!(literal, computed);
+    match literal {
+        Value::Tensor(t) => {
+            assert_eq!(t.shape(), &[2, 2]);
+            assert_eq!(t.data(), &[1.0, -2.5, 3.0, 0.4]);
+        }
+        _ => panic!("Expected tensor"),
+    }
+
+    // Ragged rows and non-literal elements keep the general behavior
+    assert!(matches!(eval("[[1, 2], [3]]").unwrap(), Value::Vector(_)));
+    assert_eq!(eval("[-1, 2]").unwrap(), Value::Vector(vec![Value::Number(-1.0), Value::Number(2.0)]));
+}
+
+#[test]
+fn test_det_of_matrix_stack() {
+    // One determinant per matrix of a [batch, n, n] tensor
+    let result = eval("det([[[4, 7], [2, 6]], [[1, 2], [3, 4]], [[2, 0], [0, 2]]])").unwrap();
+    match result {
+        Value::Tensor(t) => {
+            assert_eq!(t.shape(), &[3]);
+            assert_eq!(t.data(), &[10.0, -2.0, 4.0]);
+        }
+        _ => panic!("Expected tensor"),
+    }
+    assert_eq!(eval("det([[4, 7], [2, 6]])").unwrap(), Value::Number(10.0));
+    assert!(eval("det([[[1, 2, 3], [4, 5, 6]]])").is_err());
+}
+
+#[test]
+fn test_large_numeric_vector_stays_vector() {
+    // A literal's type doesn't depend on its length, so `Vector` annotations
+    // and vector patterns keep working on data-sized arrays
+    let literal = format!("[{}]", (0..2000).map(|i| i.to_string()).collect::<Vec<_>>().join(", "));
+    match eval(&literal).unwrap() {
+        Value::Vector(v) => {
+            assert_eq!(v.len(), 2000);
+            assert_eq!(v[1999], Value::Number(1999.0));
+        }
+        other => panic!("Expected vector, got {:?}", other),
+    }
+
+    let spread = format!("[...{}, 1]", literal);
+    assert!(matches!(eval(&spread).unwrap(), Value::Vector(_)));
+
+    let annotated = format!("((v: Vector) => v[0])({})", literal);
+    assert_eq!(eval(&annotated).unwrap(), Value::Number(0.0));
+    let pattern = format!("match {} {{ [first, ...rest] => first + 1 }}", literal);
+    assert_eq!(eval(&pattern).unwrap(), Value::Number(1.0));
+}
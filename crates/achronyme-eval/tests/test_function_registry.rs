@@ -11,6 +11,7 @@ fn test_all_dsp_functions_accessible() {
     let functions = vec![
         "fft", "ifft", "fft_mag", "fft_phase",
         "conv", "conv_fft",
+        "stft", "istft", "spectrogram",
         "hanning", "hamming", "blackman", "rectangular",
         "linspace"
     ];
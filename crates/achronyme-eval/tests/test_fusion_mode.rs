@@ -0,0 +1,69 @@
+use achronyme_eval::Evaluator;
+use achronyme_types::value::Value;
+
+fn eval_plain(source: &str) -> Result<Value, String> {
+    let mut evaluator = Evaluator::new();
+    evaluator.eval_str(source)
+}
+
+fn eval_fused(source: &str) -> Result<Value, String> {
+    let mut evaluator = Evaluator::new();
+    evaluator.set_fusion_mode(true);
+    evaluator.eval_str(source)
+}
+
+/// Evaluate with and without fusion and require identical results
+fn eval_both(source: &str) -> Result<Value, String> {
+    let plain = eval_plain(source);
+    let fused = eval_fused(source);
+    assert_eq!(plain, fused, "fused and plain evaluation disagree on: {}", source);
+    fused
+}
+
+const SIGNALS: &str = r#"
+    let x = linspace(0, 1, 1000)
+    let y = linspace(1, 2, 1000)
+"#;
+
+#[test]
+fn test_fused_chain_matches_plain() {
+    let source = format!("{}\n2 * x + 3 * y - 0.5", SIGNALS);
+    let result = eval_both(&source).unwrap();
+    match result {
+        Value::Tensor(t) => {
+            assert_eq!(t.shape(), &[1000]);
+            assert!((t.data()[0] - 2.5).abs() < 1e-12);
+        }
+        other => panic!("Expected Tensor, got {:?}", other),
+    }
+}
+
+#[test]
+fn test_fused_scalar_folding_and_division() {
+    eval_both(&format!("{}\n(2 + 3) * x / y - x / 4", SIGNALS)).unwrap();
+    eval_both(&format!("{}\n1 / (x - 0.5) + y", SIGNALS)).unwrap();
+    eval_both(&format!("{}\n2 / (x - x) + y", SIGNALS)).unwrap();
+}
+
+#[test]
+fn test_fusion_falls_back_for_unfusible_chains() {
+    // Broadcasting, matrix products and complex values replay operator by operator
+    eval_both("[[1, 2], [3, 4]] + [[10, 20]] * 2").unwrap();
+    eval_both("[[1, 2], [3, 4]] * [[5, 6], [7, 8]] + 1").unwrap();
+    eval_both("[1, 2] * i + i").unwrap();
+    eval_both("1 + 2 * 3 - 4").unwrap();
+}
+
+#[test]
+fn test_fusion_preserves_errors() {
+    assert!(eval_both("[1, 2, 3] / 0 + 1").is_err());
+    assert!(eval_both("[1, 2, 3] + [1, 2] * 2").is_err());
+}
+
+#[test]
+fn test_fusion_mode_toggle() {
+    let mut evaluator = Evaluator::new();
+    assert!(!evaluator.is_fusion_mode());
+    evaluator.set_fusion_mode(true);
+    assert!(evaluator.is_fusion_mode());
+}
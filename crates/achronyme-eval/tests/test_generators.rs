@@ -7,10 +7,8 @@
 /// - generator.next() - Resume generator and get next value
 /// - Iterator protocol: {value: T, done: Boolean}
 ///
-/// KNOWN LIMITATION: Yields inside nested control structures (while, if) are not
-/// fully supported yet. The current implementation uses simple position tracking
-/// which doesn't preserve the execution context within nested structures.
-/// This will be improved in a future version with proper continuation support.
+/// Generator bodies are lowered to resumable programs, so yields may appear
+/// inside while loops, if branches, blocks and for-in loops.
 
 use achronyme_eval::Evaluator;
 use achronyme_types::value::Value;
@@ -93,7 +91,6 @@ fn test_generator_sticky_done() {
 // ============================================================================
 
 #[test]
-#[ignore = "yields inside while loops not yet supported - needs continuation-based execution"]
 fn test_generator_with_mutable_state() {
     let result = eval(r#"
         let countdown = (n) => generate {
@@ -122,7 +119,6 @@ fn test_generator_with_mutable_state() {
 }
 
 #[test]
-#[ignore = "yields inside while loops not yet supported - needs continuation-based execution"]
 fn test_generator_preserves_state() {
     let result = eval(r#"
         let counter = () => generate {
@@ -204,7 +200,6 @@ fn test_generator_return_ends_iteration() {
 // ============================================================================
 
 #[test]
-#[ignore = "yields inside while loops not yet supported - needs continuation-based execution"]
 fn test_fibonacci_generator() {
     let result = eval(r#"
         let fibonacci = () => generate {
@@ -250,7 +245,6 @@ fn test_fibonacci_generator() {
 // ============================================================================
 
 #[test]
-#[ignore = "yields inside while loops not yet supported - needs continuation-based execution"]
 fn test_for_in_with_generator() {
     let result = eval(r#"
         let range = (n) => generate {
@@ -312,7 +306,6 @@ fn test_for_in_empty_iterator() {
 }
 
 #[test]
-#[ignore = "yields inside while loops not yet supported - needs continuation-based execution"]
 fn test_for_in_with_early_return() {
     let result = eval(r#"
         let range = (n) => generate {
@@ -342,7 +335,6 @@ fn test_for_in_with_early_return() {
 // ============================================================================
 
 #[test]
-#[ignore = "yields inside while loops not yet supported - needs continuation-based execution"]
 fn test_map_over_generator() {
     let result = eval(r#"
         let range = (n) => generate {
@@ -382,7 +374,6 @@ fn test_map_over_generator() {
 }
 
 #[test]
-#[ignore = "yields inside while loops not yet supported - needs continuation-based execution"]
 fn test_collect_generator() {
     let result = eval(r#"
         let range = (n) => generate {
@@ -446,7 +437,6 @@ fn test_generator_next_no_args() {
 // ============================================================================
 
 #[test]
-#[ignore = "yields inside while loops not yet supported - needs continuation-based execution"]
 fn test_multiple_generator_instances() {
     let result = eval(r#"
         let counter = () => generate {
@@ -514,3 +504,114 @@ fn test_generator_yields_vectors() {
     "#).unwrap();
     assert_eq!(result, Value::Number(7.0));  // 1 + 6
 }
+
+// ============================================================================
+// Yields Nested in Control Flow
+// ============================================================================
+
+#[test]
+fn test_yield_in_if_branches() {
+    let result = eval(r#"
+        let parity = (n) => generate {
+            mut i = 0
+            while(i < n) {
+                if(i % 2 == 0) {
+                    yield "even"
+                } else {
+                    yield "odd"
+                }
+                i = i + 1
+            }
+        }
+        let g = parity(3)
+        [g.next().value, g.next().value, g.next().value, g.next().done]
+    "#).unwrap();
+
+    assert_eq!(result, Value::Vector(vec![
+        Value::String("even".to_string()),
+        Value::String("odd".to_string()),
+        Value::String("even".to_string()),
+        Value::Boolean(true),
+    ]));
+}
+
+#[test]
+fn test_yield_in_nested_loops() {
+    let result = eval(r#"
+        let pairs = (n) => generate {
+            mut i = 0
+            while(i < n) {
+                mut j = 0
+                while(j < i) {
+                    yield i * 10 + j
+                    j = j + 1
+                }
+                i = i + 1
+            }
+        }
+        mut found = []
+        for(p in pairs(4)) {
+            found = [...found, p]
+        }
+        found
+    "#).unwrap();
+
+    assert_eq!(result, Value::Vector(
+        [10.0, 20.0, 21.0, 30.0, 31.0, 32.0].iter().map(|&n| Value::Number(n)).collect()
+    ));
+}
+
+#[test]
+fn test_yield_inside_for_in_over_generator() {
+    let result = eval(r#"
+        let count = (n) => generate {
+            mut i = 0
+            while(i < n) {
+                yield i
+                i = i + 1
+            }
+        }
+        let squares = (source) => generate {
+            for(x in source) {
+                let sq = x * x
+                yield sq
+            }
+            return -1
+        }
+        let g = squares(count(3))
+        [g.next().value, g.next().value, g.next().value, g.next().value, g.next().done]
+    "#).unwrap();
+
+    assert_eq!(result, Value::Vector(vec![
+        Value::Number(0.0),
+        Value::Number(1.0),
+        Value::Number(4.0),
+        Value::Number(-1.0),
+        Value::Boolean(true),
+    ]));
+}
+
+#[test]
+fn test_return_inside_loop_ends_generator() {
+    let result = eval(r#"
+        let upTo = (limit) => generate {
+            mut i = 0
+            while(true) {
+                if(i == limit) {
+                    return "stop"
+                }
+                yield i
+                i = i + 1
+            }
+        }
+        let g = upTo(2)
+        [g.next().value, g.next().value, g.next().value, g.next().value]
+    "#).unwrap();
+
+    assert_eq!(result, Value::Vector(vec![
+        Value::Number(0.0),
+        Value::Number(1.0),
+        Value::String("stop".to_string()),
+        Value::String("stop".to_string()),
+    ]));
+}
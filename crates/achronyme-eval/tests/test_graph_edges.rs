@@ -403,7 +403,7 @@ fn test_network_backward_compatibility() {
                     assert_eq!(nodes.len(), 3);
 
                     // All nodes should have empty properties
-                    for (_id, props) in nodes {
+                    for (_id, props) in nodes.iter() {
                         match props {
                             Value::Record(p) => assert_eq!(p.len(), 0),
                             _ => panic!("Expected record"),
@@ -0,0 +1,197 @@
+mod test_common;
+use test_common::eval;
+use achronyme_eval::functions::FunctionRegistry;
+use achronyme_types::value::Value;
+use achronyme_types::Environment;
+use std::collections::HashMap;
+
+// ============================================================================
+// PERT / CPM Tests
+// ============================================================================
+
+// A(3) -> B(2) -> D(2)
+//      -> C(4) ->
+// Duration 9, critical path A -> C -> D, B has 2 units of slack
+const PROJECT: &str = r#"
+    let g = network([A -> B, A -> C, B -> D, C -> D], {
+        A: {duration: 3},
+        B: {duration: 2},
+        C: {duration: 4},
+        D: {duration: 2}
+    })
+"#;
+
+fn eval_project(expr: &str) -> Value {
+    eval(&format!("{}\n{}", PROJECT, expr)).unwrap()
+}
+
+fn strings(value: &Value) -> Vec<String> {
+    match value {
+        Value::Vector(items) => items
+            .iter()
+            .map(|item| match item {
+                Value::String(s) => s.clone(),
+                other => panic!("Expected string, got {:?}", other),
+            })
+            .collect(),
+        other => panic!("Expected vector, got {:?}", other),
+    }
+}
+
+#[test]
+fn test_project_duration() {
+    assert_eq!(eval_project("project_duration(g)"), Value::Number(9.0));
+}
+
+#[test]
+fn test_forward_pass_times() {
+    let result = eval_project(r#"
+        let f = forward_pass(g)
+        [f.nodes.A.ES, f.nodes.B.ES, f.nodes.C.EF, f.nodes.D.ES, f.nodes.D.EF]
+    "#);
+    match result {
+        Value::Vector(v) => assert_eq!(
+            v,
+            vec![Value::Number(0.0), Value::Number(3.0), Value::Number(7.0), Value::Number(7.0), Value::Number(9.0)]
+        ),
+        Value::Tensor(t) => assert_eq!(t.data(), &[0.0, 3.0, 7.0, 7.0, 9.0]),
+        other => panic!("Expected vector, got {:?}", other),
+    }
+}
+
+#[test]
+fn test_backward_pass_computes_forward_pass() {
+    let result = eval_project(r#"
+        let b = backward_pass(g)
+        [b.nodes.A.LS, b.nodes.B.LF, b.nodes.B.LS, b.nodes.D.LF, b.nodes.B.EF]
+    "#);
+    match result {
+        Value::Vector(v) => assert_eq!(
+            v,
+            vec![Value::Number(0.0), Value::Number(7.0), Value::Number(5.0), Value::Number(9.0), Value::Number(5.0)]
+        ),
+        Value::Tensor(t) => assert_eq!(t.data(), &[0.0, 7.0, 5.0, 9.0, 5.0]),
+        other => panic!("Expected vector, got {:?}", other),
+    }
+}
+
+#[test]
+fn test_calculate_slack() {
+    assert_eq!(eval_project("calculate_slack(g).nodes.B.slack"), Value::Number(2.0));
+    assert_eq!(eval_project("calculate_slack(g).nodes.C.slack"), Value::Number(0.0));
+}
+
+#[test]
+fn test_critical_path() {
+    assert_eq!(strings(&eval_project("critical_path(g)")), vec!["A", "C", "D"]);
+}
+
+#[test]
+fn test_all_critical_paths_parallel_branches() {
+    let result = eval(r#"
+        let g = network([S -> X, S -> Y, X -> T, Y -> T], {
+            S: {duration: 1},
+            X: {duration: 2},
+            Y: {duration: 2},
+            T: {duration: 1}
+        })
+        all_critical_paths(g)
+    "#).unwrap();
+
+    match result {
+        Value::Vector(paths) => {
+            let mut paths: Vec<Vec<String>> = paths.iter().map(strings).collect();
+            paths.sort();
+            assert_eq!(paths, vec![vec!["S", "X", "T"], vec!["S", "Y", "T"]]);
+        }
+        other => panic!("Expected vector of paths, got {:?}", other),
+    }
+}
+
+#[test]
+fn test_critical_path_through_zero_duration_task() {
+    // Both branches are critical; the path follows the first listed edge
+    let result = eval(r#"
+        let g = network([A -> B, A -> C, B -> E, C -> D, E -> D], {
+            A: {duration: 1},
+            B: {duration: 3},
+            C: {duration: 3},
+            E: {duration: 0},
+            D: {duration: 1}
+        })
+        critical_path(g)
+    "#).unwrap();
+
+    assert_eq!(strings(&result), vec!["A", "B", "E", "D"]);
+}
+
+#[test]
+fn test_pert_analysis_probabilistic() {
+    let result = eval(r#"
+        let g = network([A -> B], {
+            A: {op: 1, mo: 2, pe: 9},
+            B: {op: 2, mo: 3, pe: 4}
+        })
+        pert_analysis(g)
+    "#).unwrap();
+
+    match result {
+        Value::Record(r) => {
+            // te(A) = (1 + 8 + 9) / 6 = 3, te(B) = (2 + 12 + 4) / 6 = 3
+            assert_eq!(r.get("duration"), Some(&Value::Number(6.0)));
+            // ((9 - 1) / 6)^2 + ((4 - 2) / 6)^2 = 64/36 + 4/36
+            match r.get("variance") {
+                Some(Value::Number(v)) => assert!((v - 68.0 / 36.0).abs() < 1e-12),
+                other => panic!("Expected variance, got {:?}", other),
+            }
+            assert_eq!(strings(r.get("critical_path").unwrap()), vec!["A", "B"]);
+            assert!(matches!(r.get("network"), Some(Value::Record(_))));
+        }
+        other => panic!("Expected record, got {:?}", other),
+    }
+}
+
+#[test]
+fn test_pert_rejects_cycles() {
+    let result = eval(r#"
+        let g = network([A -> B, B -> A], {A: {duration: 1}, B: {duration: 1}})
+        forward_pass(g)
+    "#);
+    assert!(result.unwrap_err().contains("Directed Acyclic Graph"));
+}
+
+#[test]
+fn test_pert_long_chain() {
+    // A 50k-task chain: the passes and the critical path search must not
+    // recurse per task
+    let n = 50_000;
+    let registry = FunctionRegistry::new();
+    let mut env = Environment::new();
+
+    let edges: Vec<Value> = (0..n - 1)
+        .map(|i| Value::Edge {
+            from: format!("t{}", i).into(),
+            to: format!("t{}", i + 1).into(),
+            directed: true,
+            properties: Box::new(HashMap::new()),
+        })
+        .collect();
+    let mut props = HashMap::new();
+    for i in 0..n {
+        let mut task = HashMap::new();
+        task.insert("duration".to_string(), Value::Number(1.0));
+        props.insert(format!("t{}", i), Value::Record(Box::new(task)));
+    }
+
+    let network = registry
+        .call("network", &[Value::Vector(edges), Value::Record(Box::new(props))], &mut env)
+        .unwrap();
+    assert_eq!(
+        registry.call("project_duration", &[network.clone()], &mut env).unwrap(),
+        Value::Number(n as f64)
+    );
+    match registry.call("critical_path", &[network], &mut env).unwrap() {
+        Value::Vector(path) => assert_eq!(path.len(), n),
+        other => panic!("Expected path, got {:?}", other),
+    }
+}
@@ -78,3 +78,43 @@ fn test_env_info_with_nonexistent_file() {
     // Should fail with an appropriate error
     assert!(result.is_err());
 }
+
+#[test]
+fn test_checkpoint_and_compact_env() {
+    use std::env::temp_dir;
+    use std::time::{SystemTime, UNIX_EPOCH};
+
+    let timestamp = SystemTime::now()
+        .duration_since(UNIX_EPOCH)
+        .unwrap()
+        .as_nanos();
+    let temp_path = temp_dir().join(format!("test_checkpoint_{}.ach", timestamp));
+    let path = temp_path.to_string_lossy();
+
+    let source = format!(
+        "let data = linspace(0, 1, 5000)\n\
+         save_env({{path: \"{path}\", checkpoint: true}})\n\
+         let x = 1\n\
+         save_env({{path: \"{path}\", checkpoint: true}})\n\
+         let x = 2\n\
+         save_env({{path: \"{path}\", checkpoint: true}})\n\
+         compact_env(\"{path}\")",
+        path = path
+    );
+    let mut evaluator = Evaluator::new();
+    let result = evaluator.eval_str(&source);
+
+    let restored = achronyme_env::restore_environment(&temp_path, Default::default());
+    let _ = std::fs::remove_file(&temp_path);
+
+    match result.unwrap() {
+        Value::Record(stats) => match (&stats["bytes_before"], &stats["bytes_after"]) {
+            (Value::Number(before), Value::Number(after)) => assert!(after <= before),
+            other => panic!("Expected sizes, got {:?}", other),
+        },
+        other => panic!("Expected Record, got {:?}", other),
+    }
+    let restored = restored.unwrap();
+    assert_eq!(restored.get("x").unwrap(), Value::Number(2.0));
+    assert!(restored.has("data"));
+}
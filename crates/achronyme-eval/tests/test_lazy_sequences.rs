@@ -0,0 +1,174 @@
+/// Integration tests for lazy sequences and fused HOF chains
+///
+/// - map / filter / reduce chains over range() run as a single pull loop
+/// - lazy(...) builds a sequence; collect(...) materializes one
+/// - generators and sequences stay lazy through map, filter and take
+
+use achronyme_eval::Evaluator;
+use achronyme_types::value::Value;
+
+fn eval(source: &str) -> Result<Value, String> {
+    let mut evaluator = Evaluator::new();
+    evaluator.eval_str(source)
+}
+
+fn numbers(value: Value) -> Vec<f64> {
+    match value {
+        Value::Vector(v) => v
+            .into_iter()
+            .map(|x| match x {
+                Value::Number(n) => n,
+                other => panic!("Expected Number, got {:?}", other),
+            })
+            .collect(),
+        other => panic!("Expected Vector, got {:?}", other),
+    }
+}
+
+#[test]
+fn test_fused_chain_matches_eager() {
+    let fused = eval("reduce((a, b) => a + b, 0, map(x => x ^ 2, filter(x => x % 3 == 0, range(0, 100))))");
+    let eager = eval(r#"
+        let xs = range(0, 100)
+        let kept = filter(x => x % 3 == 0, xs)
+        let squares = map(x => x ^ 2, kept)
+        reduce((a, b) => a + b, 0, squares)
+    "#);
+    assert_eq!(fused.unwrap(), eager.unwrap());
+
+    // Fused map / filter without a consumer still return vectors
+    let fused = eval("map(x => x * 2, filter(x => x > 2, range(0, 6)))").unwrap();
+    assert_eq!(numbers(fused), vec![6.0, 8.0, 10.0]);
+    let tensor = eval("filter(x => x > 1, [1, 2, 3])").unwrap();
+    assert_eq!(numbers(tensor), vec![2.0, 3.0]);
+}
+
+#[test]
+fn test_fused_range_is_not_materialized() {
+    // range() on its own refuses more than a million elements
+    assert!(eval("range(0, 2000000)").is_err());
+
+    let result = eval("reduce((a, b) => a + b, 0, take(range(0, 1e12), 4))").unwrap();
+    assert_eq!(result, Value::Number(6.0));
+
+    let result = eval("count(take(range(0, 1e12), 6), x => x % 2 == 0)").unwrap();
+    assert_eq!(result, Value::Number(3.0));
+
+    let result = eval("find(map(x => x * 3, range(0, 1e12)), x => x > 10)").unwrap();
+    assert_eq!(result, Value::Number(12.0));
+}
+
+#[test]
+fn test_predicates_over_fused_chains() {
+    assert_eq!(eval("any(map(x => x * 2, range(0, 5)), x => x == 6)").unwrap(), Value::Boolean(true));
+    assert_eq!(eval("all(filter(x => x > 2, range(0, 10)), x => x > 2)").unwrap(), Value::Boolean(true));
+    assert_eq!(eval("findIndex(map(x => x - 5, range(0, 10)), x => x == 0)").unwrap(), Value::Number(5.0));
+}
+
+#[test]
+fn test_lazy_and_collect() {
+    let result = eval(r#"
+        let s = map(x => x + 1, lazy(range(0, 1e9)))
+        [typeof(s), typeof(take(s, 3))]
+    "#).unwrap();
+    assert_eq!(result, Value::Vector(vec![
+        Value::String("Sequence".to_string()),
+        Value::String("Sequence".to_string()),
+    ]));
+
+    let result = eval("collect(take(filter(x => x % 2 == 1, lazy(range(0, 1e9))), 4))").unwrap();
+    assert_eq!(numbers(result), vec![1.0, 3.0, 5.0, 7.0]);
+
+    // A sequence over a range or vector can be consumed more than once
+    let result = eval(r#"
+        let s = map(x => x * 10, lazy([1, 2, 3]))
+        [reduce((a, b) => a + b, 0, s), reduce((a, b) => a + b, 0, s)]
+    "#).unwrap();
+    assert_eq!(numbers(result), vec![60.0, 60.0]);
+
+    // collect of a plain collection is a vector of its elements
+    assert_eq!(numbers(eval("collect([4, 5])").unwrap()), vec![4.0, 5.0]);
+}
+
+#[test]
+fn test_generator_sequences() {
+    let result = eval(r#"
+        let gen = () => generate {
+            yield 1
+            yield 2
+            yield 3
+            yield 4
+        }
+        collect(map(x => x * x, gen()))
+    "#).unwrap();
+    assert_eq!(numbers(result), vec![1.0, 4.0, 9.0, 16.0]);
+
+    // take stops pulling once it has its elements: the generator resumes
+    // right after them
+    let result = eval(r#"
+        let gen = () => generate {
+            yield 1
+            yield 2
+            yield 3
+            yield 4
+        }
+        let g = gen()
+        let firstTwo = collect(take(g, 2))
+        [firstTwo[0], firstTwo[1], g.next().value]
+    "#).unwrap();
+    assert_eq!(numbers(result), vec![1.0, 2.0, 3.0]);
+
+    let result = eval(r#"
+        let gen = () => generate {
+            yield 5
+            yield 6
+        }
+        reduce((a, b) => a + b, 0, filter(x => x > 5, gen()))
+    "#).unwrap();
+    assert_eq!(result, Value::Number(6.0));
+}
+
+#[test]
+fn test_take_from_infinite_generator() {
+    let result = eval(r#"
+        let naturals = () => generate {
+            mut n = 0
+            while(true) {
+                yield n
+                n = n + 1
+            }
+        }
+        collect(take(filter(x => x % 3 == 0, map(x => x * x, naturals())), 4))
+    "#).unwrap();
+    assert_eq!(numbers(result), vec![0.0, 9.0, 36.0, 81.0]);
+}
+
+#[test]
+fn test_for_in_over_sequence() {
+    let result = eval(r#"
+        mut total = 0
+        for(x in map(x => x * 2, lazy(range(0, 5)))) {
+            total = total + x
+        }
+        total
+    "#).unwrap();
+    assert_eq!(result, Value::Number(20.0));
+}
+
+#[test]
+fn test_shadowed_names_are_not_fused() {
+    let result = eval(r#"
+        let range = (a, b) => [b, a]
+        map(x => x + 1, range(1, 2))
+    "#).unwrap();
+    assert_eq!(numbers(result), vec![3.0, 2.0]);
+}
+
+#[test]
+fn test_sequence_errors() {
+    assert!(eval("collect(filter(x => \"yes\", lazy([1, 2])))").is_err());
+    assert!(eval("map((a, b) => a + b, lazy([1, 2]))").is_err());
+    assert!(eval("take(lazy([1, 2]), -1)").is_err());
+    assert!(eval("reduce((a, b) => a + b, 0, 5)").is_err());
+    assert!(eval("lazy(1, 2)").is_err());
+}
@@ -0,0 +1,167 @@
+use achronyme_eval::native::NativeLambda;
+use achronyme_eval::Evaluator;
+use achronyme_types::function::Function;
+use achronyme_types::value::Value;
+use achronyme_types::LambdaEvaluator;
+
+fn eval(source: &str) -> Result<Value, String> {
+    let mut evaluator = Evaluator::new();
+    evaluator.eval_str(source)
+}
+
+fn lambda(evaluator: &mut Evaluator, source: &str) -> Function {
+    match evaluator.eval_str(source).unwrap() {
+        Value::Function(f) => (*f).clone(),
+        other => panic!("Expected Function, got {:?}", other),
+    }
+}
+
+/// Native results must agree bit-for-bit with the interpreter
+fn assert_matches_interpreter(setup: &str, source: &str, points: &[f64]) {
+    let mut evaluator = Evaluator::new();
+    let func = lambda(&mut evaluator, &format!("{}\n{}", setup, source));
+    let mut native = NativeLambda::compile(&evaluator, &func)
+        .unwrap_or_else(|| panic!("`{}` should compile", source));
+
+    for &x in points {
+        let expected = evaluator.eval_at(&func, x).unwrap();
+        assert_eq!(native.call(&[x]), Some(expected), "`{}` at {}", source, x);
+    }
+}
+
+const POINTS: &[f64] = &[-2.5, -1.0, 0.0, 0.25, 1.0, 3.0];
+
+#[test]
+fn test_arithmetic_and_builtins() {
+    assert_matches_interpreter("", "x => x ^ 2 - 3 * x + 1", POINTS);
+    assert_matches_interpreter("", "x => sin(x) * cos(x) + exp(-x ^ 2)", POINTS);
+    assert_matches_interpreter("", "x => sqrt(abs(x)) + atan2(x, 2) + pow(2, x)", POINTS);
+    assert_matches_interpreter("", "x => max(x, 0, -x / 2) + min(x, 1) + PI * e", POINTS);
+}
+
+#[test]
+fn test_captures_and_locals() {
+    assert_matches_interpreter("let k = 3\nlet w = 0.5", "x => k * sin(w * x)", POINTS);
+    assert_matches_interpreter("", "x => do { let a = x * 2; let b = a + 1; a * b }", POINTS);
+}
+
+#[test]
+fn test_conditionals() {
+    assert_matches_interpreter("", "x => if(x > 0, x, -x)", POINTS);
+    assert_matches_interpreter("", "x => piecewise([x < 0, -x], [x < 1 && x != 0.25, x ^ 2], 1)", POINTS);
+    assert_matches_interpreter("", "x => if(!(x >= 1) || x == 3, 1, 0)", POINTS);
+}
+
+#[test]
+fn test_multiple_parameters() {
+    let mut evaluator = Evaluator::new();
+    let func = lambda(&mut evaluator, "(x, y) => x * y + y ^ 2");
+    let mut native = NativeLambda::compile(&evaluator, &func).unwrap();
+    assert_eq!(native.call(&[2.0, 3.0]), Some(15.0));
+    assert_eq!(native.call(&[2.0]), None);
+}
+
+#[test]
+fn test_rec_calls() {
+    assert_matches_interpreter("", "n => if(n <= 1, 1, n * rec(n - 1))", &[0.0, 1.0, 5.0, 10.0]);
+    assert_matches_interpreter("", "n => if(n < 2, n, rec(n - 1) + rec(n - 2))", &[0.0, 1.0, 12.0]);
+
+    // Tail calls reuse their frame, so depth is not limited
+    let mut evaluator = Evaluator::new();
+    let func = lambda(&mut evaluator, "(n, acc) => if(n == 0, acc, rec(n - 1, acc + n))");
+    let mut native = NativeLambda::compile(&evaluator, &func).unwrap();
+    assert_eq!(native.call(&[1e6, 0.0]), Some(500000500000.0));
+
+    // Deep non-tail recursion goes back to the interpreter
+    let func = lambda(&mut evaluator, "n => if(n == 0, 0, 1 + rec(n - 1))");
+    let mut native = NativeLambda::compile(&evaluator, &func).unwrap();
+    assert_eq!(native.call(&[1000.0]), Some(1000.0));
+    assert_eq!(native.call(&[1e6]), None);
+}
+
+#[test]
+fn test_vector_parameter() {
+    let mut evaluator = Evaluator::new();
+    let func = lambda(&mut evaluator, "p => p[0] ^ 2 + 3 * p[1]");
+    assert!(NativeLambda::compile(&evaluator, &func).is_none());
+
+    let mut native = NativeLambda::compile_vector(&evaluator, &func).unwrap();
+    assert_eq!(native.call(&[2.0, 1.0]), Some(7.0));
+    // Out-of-range index goes back to the interpreter
+    assert_eq!(native.call(&[2.0]), None);
+}
+
+#[test]
+fn test_unsupported_lambdas_are_refused() {
+    let mut evaluator = Evaluator::new();
+    for source in [
+        "x => f(x)",
+        "x => x + v",
+        "x => \"text\"",
+        "x => x > 1",
+        "x => if(x > 0, 1, true)",
+        "x => x + i",
+        "(x: Vector) => x",
+        "x => do { mut a = x; a = a + 1; a }",
+    ] {
+        let func = lambda(&mut evaluator, &format!("let f = x => x + 1\nlet v = [1, 2]\n{}", source));
+        assert!(NativeLambda::compile(&evaluator, &func).is_none(), "`{}` should be refused", source);
+    }
+}
+
+#[test]
+fn test_runtime_errors_fall_back() {
+    let mut evaluator = Evaluator::new();
+    let func = lambda(&mut evaluator, "x => 1 / x + piecewise([x > 5, 1])");
+    let mut native = NativeLambda::compile(&evaluator, &func).unwrap();
+    assert_eq!(native.call(&[0.0]), None);
+    assert_eq!(native.call(&[1.0]), None);
+    assert_eq!(native.call(&[10.0]), Some(1.1));
+}
+
+#[test]
+fn test_numerical_routines_use_native_path() {
+    let result = eval("let k = 2\nintegral(x => k * x ^ 2, 0, 3, 1000)").unwrap();
+    match result {
+        Value::Number(n) => assert!((n - 18.0).abs() < 1e-3),
+        other => panic!("Expected Number, got {:?}", other),
+    }
+
+    let result = eval("solve(x => x ^ 2 - 2, 0, 2, 1e-10)").unwrap();
+    match result {
+        Value::Number(n) => assert!((n - 2f64.sqrt()).abs() < 1e-8),
+        other => panic!("Expected Number, got {:?}", other),
+    }
+
+    let result = eval("gradient(p => p[0] ^ 2 + 3 * p[1], [1, 2], 1e-5)").unwrap();
+    match result {
+        Value::Vector(v) => {
+            assert_eq!(v.len(), 2);
+            match (&v[0], &v[1]) {
+                (Value::Number(a), Value::Number(b)) => {
+                    assert!((a - 2.0).abs() < 1e-4);
+                    assert!((b - 3.0).abs() < 1e-4);
+                }
+                other => panic!("Expected numbers, got {:?}", other),
+            }
+        }
+        Value::Tensor(t) => {
+            assert!((t.data()[0] - 2.0).abs() < 1e-4);
+            assert!((t.data()[1] - 3.0).abs() < 1e-4);
+        }
+        other => panic!("Expected Vector, got {:?}", other),
+    }
+}
+
+#[test]
+fn test_interpreter_errors_are_preserved() {
+    let err = eval("diff(x => 1 / (x - 1), 1, 0)").unwrap_err();
+    assert!(err.contains("Division by zero"), "{}", err);
+
+    // Lambdas outside the native subset still work
+    let source = "let f = x => x ^ 2\nintegral(x => f(x), 0, 3, 1000)";
+    match eval(source).unwrap() {
+        Value::Number(n) => assert!((n - 9.0).abs() < 1e-3),
+        other => panic!("Expected Number, got {:?}", other),
+    }
+}
@@ -0,0 +1,65 @@
+use achronyme_eval::Evaluator;
+use achronyme_types::value::Value;
+
+fn eval(source: &str) -> Result<Value, String> {
+    let mut evaluator = Evaluator::new();
+    evaluator.eval_str(source)
+}
+
+/// Large enough to take the parallel path
+const DATA: &str = "let xs = linspace(0, 1, 5000)";
+
+#[test]
+fn test_pmap_matches_map() {
+    let source = format!("{}\nlet k = 3\n", DATA);
+    let parallel = eval(&format!("{}pmap(x => sin(x) * k + x ^ 2, xs)", source)).unwrap();
+    let sequential = eval(&format!("{}map(x => sin(x) * k + x ^ 2, xs)", source)).unwrap();
+    assert_eq!(parallel, sequential);
+
+    match parallel {
+        Value::Vector(v) => assert_eq!(v.len(), 5000),
+        other => panic!("Expected Vector, got {:?}", other),
+    }
+}
+
+#[test]
+fn test_pfilter_matches_filter() {
+    let parallel = eval(&format!("{}\npfilter(x => x > 0.25 && x < 0.5, xs)", DATA)).unwrap();
+    let sequential = eval(&format!("{}\nfilter(x => x > 0.25 && x < 0.5, xs)", DATA)).unwrap();
+    assert_eq!(parallel, sequential);
+}
+
+#[test]
+fn test_preduce_associative() {
+    let source = "let xs = range(0, 10000)\npreduce((a, b) => a + b, 0, xs)";
+    assert_eq!(eval(source).unwrap(), Value::Number(49995000.0));
+
+    let source = "let xs = range(0, 10000)\npreduce((a, b) => max(a, b), -1, xs)";
+    assert_eq!(eval(source).unwrap(), Value::Number(9999.0));
+}
+
+#[test]
+fn test_parallel_hofs_fall_back_for_impure_lambdas() {
+    // A mut capture written by the lambda must see every element, in order
+    let source = format!("{}\nmut total = 0\npmap(x => do {{ total = total + 1; x }}, xs)\ntotal", DATA);
+    assert_eq!(eval(&source).unwrap(), Value::Number(5000.0));
+
+    // Captured user functions and non-scalar results run sequentially
+    let source = format!("{}\nlet f = x => x * 2\nlen(pmap(x => f(x), xs))", DATA);
+    assert_eq!(eval(&source).unwrap(), Value::Number(5000.0));
+    let source = format!("{}\nlen(pmap(x => [x, x], xs))", DATA);
+    assert_eq!(eval(&source).unwrap(), Value::Number(5000.0));
+
+    // Small collections
+    assert_eq!(eval("pmap(x => x + 1, [1, 2, 3])").unwrap(), eval("map(x => x + 1, [1, 2, 3])").unwrap());
+}
+
+#[test]
+fn test_parallel_hofs_report_errors() {
+    let err = eval(&format!("{}\npfilter(x => \"no\", xs)", DATA)).unwrap_err();
+    assert!(err.contains("boolean or number"), "unexpected error: {}", err);
+
+    assert!(eval("pmap((a, b) => a, [1, 2])").is_err());
+    assert!(eval("preduce(x => x, 0, [1, 2])").is_err());
+    assert!(eval("pmap(1, [1, 2])").is_err());
+}
@@ -0,0 +1,145 @@
+/// Integration tests for the evaluator profiler
+///
+/// - calls to named functions, lambdas and builtins are counted
+/// - exclusive time never exceeds inclusive time
+/// - folded stacks follow the call paths
+/// - tensor allocations and phases are recorded
+/// - nothing is recorded while profiling is off
+
+use achronyme_eval::profiler::CallKind;
+use achronyme_eval::Evaluator;
+use achronyme_types::value::Value;
+
+fn profiled(source: &str) -> Evaluator {
+    let mut evaluator = Evaluator::new();
+    evaluator.set_profiling(true);
+    evaluator.eval_str(source).unwrap();
+    evaluator
+}
+
+#[test]
+fn test_counts_user_functions_and_builtins() {
+    let evaluator = profiled(r#"
+        let square = x => x * x
+        let total = n => reduce((a, b) => a + b, 0, map(square, range(0, n)))
+        total(10) + sqrt(16)
+    "#);
+    let profiler = evaluator.profiler().unwrap();
+
+    let square = profiler.entry("square").unwrap();
+    assert_eq!(square.kind, CallKind::Function);
+    assert_eq!(square.calls, 10);
+
+    assert_eq!(profiler.entry("total").unwrap().calls, 1);
+    // The reducer is never bound to a name
+    assert_eq!(profiler.entry("<lambda>").unwrap().calls, 10);
+
+    let sqrt = profiler.entry("sqrt").unwrap();
+    assert_eq!(sqrt.kind, CallKind::Builtin);
+    assert_eq!(sqrt.calls, 1);
+
+    assert_eq!(profiler.entry("<script>").unwrap().kind, CallKind::Script);
+}
+
+#[test]
+fn test_inclusive_and_exclusive_time() {
+    let evaluator = profiled(r#"
+        let fib = n => if(n < 2, n, rec(n - 1) + rec(n - 2))
+        let outer = () => fib(12)
+        outer()
+    "#);
+    let profiler = evaluator.profiler().unwrap();
+
+    let outer = profiler.entry("outer").unwrap();
+    let fib = profiler.entry("fib").unwrap();
+    assert!(fib.calls > 100);
+    assert!(outer.exclusive <= outer.inclusive);
+    assert!(fib.exclusive <= fib.inclusive);
+    // Recursive calls are counted once in inclusive time
+    assert!(fib.inclusive <= outer.inclusive);
+
+    // Entries come out sorted by exclusive time
+    let entries = profiler.entries();
+    assert!(entries.windows(2).all(|w| w[0].exclusive >= w[1].exclusive));
+}
+
+#[test]
+fn test_folded_stacks_follow_call_paths() {
+    let evaluator = profiled(r#"
+        let inner = x => sum(linspace(0, x, 2000))
+        let outer = x => inner(x) + inner(x + 1)
+        outer(1)
+    "#);
+    let folded = evaluator.profiler().unwrap().folded_stacks();
+
+    assert!(!folded.is_empty());
+    for line in folded.lines() {
+        let (stack, micros) = line.rsplit_once(' ').unwrap();
+        assert!(stack.starts_with("<script>"));
+        assert!(micros.parse::<u64>().unwrap() > 0);
+    }
+    assert!(folded.lines().all(|line| !line.contains("inner;outer")));
+    assert!(folded.contains("<script>;outer;inner"));
+}
+
+#[test]
+fn test_tensor_allocations_and_phases() {
+    let evaluator = profiled(r#"
+        let base = linspace(0, 1, 4)
+        let make = () => base * 2
+        let typed: Number = 2
+        make()
+        make()
+    "#);
+    let profiler = evaluator.profiler().unwrap();
+
+    assert!(profiler.tensor_allocations() >= 3);
+    let make = profiler.entry("make").unwrap();
+    assert_eq!(make.calls, 2);
+    // base is shared, so each product is a new buffer allocated by make
+    assert_eq!(make.tensor_allocations, 2);
+    assert_eq!(profiler.entry("linspace").unwrap().tensor_allocations, 1);
+
+    let phases = profiler.phases();
+    assert!(phases.parse > std::time::Duration::ZERO);
+    assert!(phases.evaluate > std::time::Duration::ZERO);
+    assert!(phases.type_check > std::time::Duration::ZERO);
+
+    let report = profiler.report();
+    assert!(report.contains("type check"));
+    assert!(report.contains("make"));
+}
+
+#[test]
+fn test_profiling_off_records_nothing() {
+    let mut evaluator = Evaluator::new();
+    assert!(!evaluator.is_profiling());
+    assert_eq!(evaluator.eval_str("let f = x => x + 1\nf(1)").unwrap(), Value::Number(2.0));
+    assert!(evaluator.profiler().is_none());
+
+    // Errors inside a profiled call still close its frame
+    evaluator.set_profiling(true);
+    assert!(evaluator.eval_str("let g = x => x + undefinedName\ng(1)").is_err());
+    assert_eq!(evaluator.eval_str("abs(-1)").unwrap(), Value::Number(1.0));
+    let profiler = evaluator.profiler().unwrap();
+    assert_eq!(profiler.entry("g").unwrap().calls, 1);
+    assert_eq!(profiler.entry("<script>").unwrap().calls, 2);
+    assert!(profiler.folded_stacks().lines().all(|line| !line.contains("g;abs")));
+
+    evaluator.set_profiling(false);
+    assert!(evaluator.profiler().is_none());
+}
+
+#[test]
+fn test_profiling_bytecode_mode() {
+    let mut evaluator = Evaluator::new();
+    evaluator.set_bytecode_mode(true);
+    evaluator.set_profiling(true);
+    evaluator.eval_str(r#"
+        let double = x => x * 2
+        double(1) + double(2) + abs(-3)
+    "#).unwrap();
+    let profiler = evaluator.profiler().unwrap();
+    assert_eq!(profiler.entry("double").unwrap().calls, 2);
+    assert_eq!(profiler.entry("abs").unwrap().calls, 1);
+}
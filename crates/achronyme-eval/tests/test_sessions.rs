@@ -0,0 +1,217 @@
+/// Integration tests for forked sessions and the thread-safe evaluator core
+///
+/// - forks see the base bindings but not each other's mutations
+/// - closures over `mut` cells and generators are copied per fork
+/// - builtin registries and parsed ASTs are shared across threads
+/// - deadlines stop runaway evaluations; file builtins can be disabled
+
+use std::sync::Arc;
+use std::time::{Duration, Instant};
+
+use achronyme_eval::constants::ConstantsRegistry;
+use achronyme_eval::functions::FunctionRegistry;
+use achronyme_eval::modules::ModuleRegistry;
+use achronyme_eval::Evaluator;
+use achronyme_parser::ParseCache;
+use achronyme_types::tensor::{ComplexTensor, RealTensor};
+use achronyme_types::value::Value;
+
+const PRELUDE: &str = r#"
+    let square = x => x ^ 2
+    mut counter = 0
+    let bump = () => do {
+        counter = counter + 1
+    }
+    let counting = () => generate {
+        mut n = 0
+        while (true) {
+            n = n + 1
+            yield n
+        }
+    }
+    let naturals = counting()
+"#;
+
+fn warm_base() -> Evaluator {
+    let mut base = Evaluator::new();
+    base.eval_prelude(PRELUDE).unwrap();
+    base
+}
+
+#[test]
+fn test_fork_isolates_mutable_state() {
+    let base = warm_base();
+    let mut first = base.fork();
+    let mut second = base.fork();
+
+    assert_eq!(first.eval_str("bump()\nbump()\ncounter").unwrap(), Value::Number(2.0));
+    assert_eq!(second.eval_str("bump()\ncounter").unwrap(), Value::Number(1.0));
+    assert_eq!(base.fork().eval_str("counter").unwrap(), Value::Number(0.0));
+
+    // Generators resume independently
+    assert_eq!(first.eval_str("naturals.next().value").unwrap(), Value::Number(1.0));
+    assert_eq!(first.eval_str("naturals.next().value").unwrap(), Value::Number(2.0));
+    assert_eq!(second.eval_str("naturals.next().value").unwrap(), Value::Number(1.0));
+}
+
+#[test]
+fn test_fork_keeps_bindings_and_modes() {
+    let mut base = warm_base();
+    base.set_bytecode_mode(true);
+    let mut session = base.fork();
+
+    assert_eq!(session.eval_str("square(12)").unwrap(), Value::Number(144.0));
+    // New definitions stay in the session
+    session.eval_str("let cube = x => x ^ 3").unwrap();
+    assert!(session.environment().has("cube"));
+    assert!(!base.environment().has("cube"));
+    assert!(session.is_bytecode_mode());
+}
+
+#[test]
+fn test_registries_are_shared() {
+    let a = Evaluator::new();
+    let b = Evaluator::new();
+    assert!(std::ptr::eq(a.functions(), b.functions()));
+    assert!(std::ptr::eq(a.constants(), b.constants()));
+    assert!(std::ptr::eq(a.module_registry(), b.module_registry()));
+
+    // A private registry is copied on write, leaving the shared one intact
+    fn seven(_: &[Value], _: &mut achronyme_types::Environment) -> Result<Value, String> {
+        Ok(Value::Number(7.0))
+    }
+    let mut custom = Evaluator::new();
+    custom.functions_mut().register("seven_private", seven, 0);
+    assert!(custom.functions().has("seven_private"));
+    assert!(!a.functions().has("seven_private"));
+}
+
+#[test]
+fn test_shared_core_is_send_and_sync() {
+    fn assert_send_sync<T: Send + Sync>() {}
+    assert_send_sync::<Arc<FunctionRegistry>>();
+    assert_send_sync::<Arc<ConstantsRegistry>>();
+    assert_send_sync::<Arc<ModuleRegistry>>();
+    assert_send_sync::<ParseCache>();
+    assert_send_sync::<RealTensor>();
+    assert_send_sync::<ComplexTensor>();
+}
+
+#[test]
+fn test_sessions_on_threads_share_parsed_prelude() {
+    let mut cache = ParseCache::new();
+    let prelude = cache.parse(PRELUDE).unwrap();
+    let frozen = RealTensor::vector(vec![1.0, 2.0, 3.0]);
+
+    let workers: Vec<_> = (0..3)
+        .map(|worker| {
+            let mut cache = cache.clone();
+            let prelude = Arc::clone(&prelude);
+            let frozen = frozen.clone();
+            std::thread::spawn(move || {
+                // The prelude is a cache hit: same AST, no parsing
+                assert!(Arc::ptr_eq(&cache.parse(PRELUDE).unwrap(), &prelude));
+
+                let mut base = Evaluator::new();
+                *base.parse_cache_mut() = cache;
+                base.eval_prelude(PRELUDE).unwrap();
+                base.environment_mut().define("weights".to_string(), Value::from(frozen)).unwrap();
+
+                (0..4)
+                    .map(|session| {
+                        let mut session_eval = base.fork();
+                        for _ in 0..session {
+                            session_eval.eval_str("bump()").unwrap();
+                        }
+                        // Values hold `Rc`s and stay on their thread
+                        let total = match session_eval.eval_str("sum(weights) + counter").unwrap() {
+                            Value::Number(n) => n,
+                            other => panic!("worker {}: expected a number, got {:?}", worker, other),
+                        };
+                        (session, total)
+                    })
+                    .collect::<Vec<_>>()
+            })
+        })
+        .collect();
+
+    for handle in workers {
+        for (session, total) in handle.join().unwrap() {
+            assert_eq!(total, 6.0 + session as f64);
+        }
+    }
+}
+
+#[test]
+fn test_prelude_bindings_persist() {
+    let mut evaluator = Evaluator::new();
+    evaluator.eval_prelude("let a = 2\nlet b = a * 3").unwrap();
+    assert_eq!(evaluator.eval_str("a + b").unwrap(), Value::Number(8.0));
+
+    // eval_str keeps scoping multi-statement programs
+    evaluator.eval_str("let c = 1\nlet d = 2").unwrap();
+    assert!(!evaluator.environment().has("c"));
+}
+
+#[test]
+fn test_deadline_stops_runaway_evaluation() {
+    let mut evaluator = Evaluator::new();
+    evaluator.eval_str("let spin = (n: Number) => rec(n + 1)").unwrap();
+    let programs = [
+        "while (true) { 1 }",
+        "let f = n => if (n < 0, 0, rec(n + 1))\nf(0)",
+        "spin(0)",
+        "try { while (true) { 1 } } catch (e) { 0 }",
+    ];
+    for bytecode in [false, true] {
+        evaluator.set_bytecode_mode(bytecode);
+        for program in programs {
+            evaluator.set_deadline(Some(Instant::now() + Duration::from_millis(50)));
+            let err = evaluator.eval_str(program).unwrap_err();
+            assert!(err.contains("timed out"), "{}: {}", program, err);
+        }
+    }
+
+    // The session is still usable once the limit is lifted
+    evaluator.set_deadline(None);
+    assert_eq!(evaluator.eval_str("2 + 3").unwrap(), Value::Number(5.0));
+}
+
+#[test]
+fn test_file_builtins_can_be_disabled() {
+    let mut base = warm_base();
+    base.disable_file_io();
+    let mut session = base.fork();
+    let err = session.eval_str("save_env(\"/tmp/achronyme_disabled.ach\")").unwrap_err();
+    assert!(err.contains("disabled"), "{}", err);
+    assert!(!std::path::Path::new("/tmp/achronyme_disabled.ach").exists());
+
+    // Modules imported before file access was disabled stay importable
+    let dir = std::env::temp_dir().join(format!("achronyme_sessions_{}", std::process::id()));
+    std::fs::create_dir_all(&dir).unwrap();
+    std::fs::write(dir.join("ten.soc"), "let ten = 10\nexport { ten }\n").unwrap();
+    std::fs::write(dir.join("eleven.soc"), "let eleven = 11\nexport { eleven }\n").unwrap();
+    let import = |name: &str| format!("import {{ {} }} from \"{}\"", name, dir.join(name).display());
+    let mut base = warm_base();
+    base.eval_str(&import("ten")).unwrap();
+    base.disable_file_io();
+    let mut session = base.fork();
+    session.eval_str(&import("ten")).unwrap();
+    assert!(session.eval_str(&import("eleven")).unwrap_err().contains("file access is disabled"));
+    std::fs::remove_dir_all(&dir).unwrap();
+
+    // Sessions leave nothing in the on-disk AST cache
+    let cache_dir = std::env::temp_dir().join(format!("achronyme_ast_cache_{}", std::process::id()));
+    std::fs::create_dir_all(&cache_dir).unwrap();
+    let mut base = warm_base();
+    base.parse_cache_mut().set_disk_cache(Some(cache_dir.clone()));
+    base.disable_file_io();
+    let mut session = base.fork();
+    session.eval_str("let untrusted = 41 + 1").unwrap();
+    assert_eq!(session.eval_str("untrusted").unwrap(), Value::Number(42.0));
+    assert_eq!(std::fs::read_dir(&cache_dir).unwrap().count(), 0);
+    std::fs::remove_dir_all(&cache_dir).unwrap();
+
+    // Other evaluators keep the shared registry untouched
+    assert!(Evaluator::new().eval_str("env_info(\"/nonexistent.ach\")").unwrap_err().find("disabled").is_none());
+}
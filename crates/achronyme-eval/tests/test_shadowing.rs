@@ -270,3 +270,70 @@ fn test_shadowing_preserves_closure_semantics() {
     let result = eval_with_evaluator(&mut evaluator, "scale(5)").unwrap();
     assert_eq!(result, Value::Number(10.0)); // Still 5 * 2, not 5 * 10
 }
+
+// ========================================================================
+// Shadowing inside lambda bodies (locals are read by slot)
+// ========================================================================
+
+#[test]
+fn test_lambda_locals_shadow_parameters_per_block() {
+    let result = eval(
+        "let f = (x, y) => do {
+            let a = x + y
+            let b = do { let x = a * 10; x + y }
+            let x = b + 1
+            [a, b, x, y]
+        }
+        f(1, 2)",
+    )
+    .unwrap();
+    match result {
+        Value::Vector(v) => assert_eq!(to_f64_vec(&v), vec![3.0, 32.0, 33.0, 2.0]),
+        other => panic!("Expected vector, got {:?}", other),
+    }
+}
+
+#[test]
+fn test_lambda_locals_in_loops_match_and_catch() {
+    // A loop body that redeclares a name each iteration
+    assert_eq!(
+        eval(
+            "let upto = n => generate { mut i = 0\nwhile (i < n) { yield i\ni = i + 1 } }
+            let f = n => do { mut acc = 0\nfor (k in upto(n)) { let sq = k * k\nacc = acc + sq }\nacc }
+            f(4)"
+        )
+        .unwrap(),
+        Value::Number(14.0)
+    );
+    // A while body declaring into the enclosing block's scope
+    assert_eq!(
+        eval("let f = x => do { mut i = 0\nlet y = x\nwhile (i < 3) { i = i + 1 }\ny + i }\nf(10)").unwrap(),
+        Value::Number(13.0)
+    );
+    assert_eq!(
+        eval("let f = v => match v { [a, b] => a + b, x => x }\nf([2, 5]) + f(1)").unwrap(),
+        Value::Number(8.0)
+    );
+    assert_eq!(
+        eval("let f = x => try { throw x } catch(e) { let x = 1\nx }\nf(7)").unwrap(),
+        Value::Number(1.0)
+    );
+}
+
+#[test]
+fn test_lambda_locals_captured_by_nested_closures() {
+    assert_eq!(
+        eval("let make = k => do { let step = k * 2\n(x => x + step + k) }\nlet g = make(3)\ng(1)").unwrap(),
+        Value::Number(10.0)
+    );
+    assert_eq!(
+        eval("let f = xs => do { let base = 100\nreduce((acc, x) => acc + x + base, 0, xs) }\nf([1, 2, 3])").unwrap(),
+        Value::Number(306.0)
+    );
+}
+
+#[test]
+fn test_failed_try_block_does_not_leak_its_scope() {
+    let err = eval("let f = x => try { do { let q = 1\nthrow \"boom\" } } catch(e) { q }\nf(0)").unwrap_err();
+    assert!(err.contains("q"), "{}", err);
+}
@@ -0,0 +1,93 @@
+/// Integration tests for calls specialized on proven numeric signatures
+///
+/// - all-`Number` lambdas give the same results as unannotated ones
+/// - `rec` runs natively, with tail calls in constant space
+/// - wrong argument types and runtime errors keep their messages
+/// - mutable captures are read on every call
+
+use achronyme_eval::Evaluator;
+use achronyme_types::value::Value;
+
+fn eval(source: &str) -> Result<Value, String> {
+    let mut evaluator = Evaluator::new();
+    evaluator.eval_str(source)
+}
+
+#[test]
+fn test_annotated_matches_unannotated() {
+    let annotated = eval(r#"
+        let hypot = (x: Number, y: Number): Number => sqrt(x ^ 2 + y ^ 2)
+        let smooth = (x: Number) => do { let a = sin(x); a * a + if(x > 0, x, -x) }
+        [hypot(3, 4), smooth(0.5), smooth(-2)]
+    "#);
+    let plain = eval(r#"
+        let hypot = (x, y) => sqrt(x ^ 2 + y ^ 2)
+        let smooth = x => do { let a = sin(x); a * a + if(x > 0, x, -x) }
+        [hypot(3, 4), smooth(0.5), smooth(-2)]
+    "#);
+    assert_eq!(annotated.unwrap(), plain.unwrap());
+}
+
+#[test]
+fn test_recursive_functions() {
+    let result = eval(r#"
+        let fact = (n: Number): Number => if(n <= 1, 1, n * rec(n - 1))
+        let fib = (n: Number): Number => if(n < 2, n, rec(n - 1) + rec(n - 2))
+        [fact(10), fib(20)]
+    "#).unwrap();
+    assert_eq!(result, Value::Vector(vec![Value::Number(3628800.0), Value::Number(6765.0)]));
+
+    let result = eval(r#"
+        let total = (n: Number, acc: Number): Number => if(n == 0, acc, rec(n - 1, acc + n))
+        total(1000000, 0)
+    "#).unwrap();
+    assert_eq!(result, Value::Number(500000500000.0));
+}
+
+#[test]
+fn test_type_errors_are_kept() {
+    let err = eval(r#"
+        let double = (x: Number): Number => x * 2
+        double("two")
+    "#).unwrap_err();
+    assert!(err.contains("parameter 'x'"), "{}", err);
+
+    // Vectors still broadcast through an unannotated lambda
+    let result = eval("let double = x => x * 2\ndouble([1, 2])").unwrap();
+    assert_eq!(result, Value::Vector(vec![Value::Number(2.0), Value::Number(4.0)]));
+}
+
+#[test]
+fn test_runtime_errors_fall_back() {
+    let annotated = eval("let f = (x: Number): Number => 1 / x\nf(0)");
+    let plain = eval("let f = x => 1 / x\nf(0)");
+    assert_eq!(annotated, plain);
+    assert!(annotated.is_err());
+
+    // A non-numeric result is not specialized
+    let result = eval("let positive = (x: Number) => x > 0\npositive(2)").unwrap();
+    assert_eq!(result, Value::Boolean(true));
+}
+
+#[test]
+fn test_mutable_captures_are_read_each_call() {
+    let result = eval(r#"
+        mut k = 2
+        let scale = (x: Number): Number => k * x
+        let first = scale(10)
+        k = 3
+        [first, scale(10)]
+    "#).unwrap();
+    assert_eq!(result, Value::Vector(vec![Value::Number(20.0), Value::Number(30.0)]));
+}
+
+#[test]
+fn test_specialized_in_bytecode_mode() {
+    let mut evaluator = Evaluator::new();
+    evaluator.set_bytecode_mode(true);
+    let result = evaluator.eval_str(r#"
+        let cube = (x: Number): Number => x * x * x
+        cube(3) + cube(-1)
+    "#).unwrap();
+    assert_eq!(result, Value::Number(26.0));
+}
@@ -316,3 +316,45 @@ fn test_import_and_local_definition() {
         _ => panic!("Expected number result"),
     }
 }
+
+// ============================================================================
+// Module and Parse Cache Tests
+// ============================================================================
+
+#[test]
+fn test_module_cache_reloads_changed_file() {
+    let dir = std::env::temp_dir().join(format!("achronyme-module-cache-{}", std::process::id()));
+    std::fs::create_dir_all(&dir).unwrap();
+    let module = dir.join("scale.soc");
+    let import = format!("import {{ scale }} from \"{}\"", dir.join("scale").display());
+
+    std::fs::write(&module, "let scale = x => x * 2\nexport { scale }\n").unwrap();
+    let mut evaluator = Evaluator::new();
+    evaluator.eval_str(&import).unwrap();
+    assert_eq!(evaluator.eval_str("scale(5)").unwrap(), Value::Number(10.0));
+
+    // Unchanged file: the evaluated exports are reused without re-parsing
+    let misses = evaluator.parse_cache().misses();
+    evaluator.eval_str(&import).unwrap();
+    assert_eq!(evaluator.parse_cache().misses(), misses);
+
+    // Rewritten file: the module is evaluated again
+    std::fs::write(&module, "let scale = x => x * 100\nexport { scale }\n").unwrap();
+    evaluator.eval_str(&import).unwrap();
+    assert_eq!(evaluator.eval_str("scale(5)").unwrap(), Value::Number(500.0));
+
+    std::fs::remove_dir_all(&dir).unwrap();
+}
+
+#[test]
+fn test_eval_str_reuses_parsed_source() {
+    let mut evaluator = Evaluator::new();
+    evaluator.eval_str("mut total = 0").unwrap();
+
+    for _ in 0..3 {
+        evaluator.eval_str("total = total + 1").unwrap();
+    }
+
+    assert_eq!(evaluator.eval_str("total").unwrap(), Value::Number(3.0));
+    assert_eq!(evaluator.parse_cache().hits(), 2);
+}
@@ -0,0 +1,94 @@
+use achronyme_linalg::{determinant_batch, determinant_nd, inverse, inverse_batch, lu, lu_decomposition, solve_system, svd_decomposition};
+use achronyme_types::tensor::RealTensor;
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion};
+
+/// Diagonally dominant, so LU never hits a near-singular pivot
+fn matrix(n: usize) -> RealTensor {
+    let mut data: Vec<f64> = (0..n * n).map(|i| ((i * 7919) % 1000) as f64 / 1000.0).collect();
+    for i in 0..n {
+        data[i * n + i] += n as f64;
+    }
+    RealTensor::matrix(n, n, data).unwrap()
+}
+
+fn bench_lu(c: &mut Criterion) {
+    let mut group = c.benchmark_group("linalg/lu");
+    for n in [16, 64, 256] {
+        let a = matrix(n);
+        group.bench_with_input(BenchmarkId::from_parameter(n), &a, |bench, a| {
+            bench.iter(|| lu_decomposition(black_box(a)).unwrap())
+        });
+    }
+    group.finish();
+}
+
+fn bench_svd(c: &mut Criterion) {
+    let mut group = c.benchmark_group("linalg/svd");
+    for n in [16, 64, 128] {
+        let a = matrix(n);
+        group.bench_with_input(BenchmarkId::from_parameter(n), &a, |bench, a| {
+            bench.iter(|| svd_decomposition(black_box(a)).unwrap())
+        });
+    }
+    group.finish();
+}
+
+/// 32 right-hand sides against one matrix: refactorizing per solve vs
+/// factoring once
+fn bench_repeated_solve(c: &mut Criterion) {
+    let mut group = c.benchmark_group("linalg/solve_32_rhs");
+    for n in [64, 256] {
+        let a = matrix(n);
+        let rhs: Vec<RealTensor> = (0..32)
+            .map(|k| RealTensor::vector((0..n).map(|i| ((i + k) % 7) as f64).collect()))
+            .collect();
+
+        group.bench_with_input(BenchmarkId::new("solve_system", n), &a, |bench, a| {
+            bench.iter(|| {
+                for b in &rhs {
+                    black_box(solve_system(a, b).unwrap());
+                }
+            })
+        });
+        group.bench_with_input(BenchmarkId::new("lu_once", n), &a, |bench, a| {
+            bench.iter(|| {
+                let factor = lu(a).unwrap();
+                for b in &rhs {
+                    black_box(factor.solve(b).unwrap());
+                }
+            })
+        });
+        group.bench_with_input(BenchmarkId::new("lu_batch", n), &a, |bench, a| {
+            bench.iter(|| black_box(lu(a).unwrap().solve_batch(&rhs).unwrap()))
+        });
+    }
+    group.finish();
+}
+
+/// 10 000 small matrices: one call per matrix vs one batched call
+fn bench_batched(c: &mut Criterion) {
+    let mut group = c.benchmark_group("linalg/batch_10000");
+    for n in [3, 6] {
+        let batch = 10_000;
+        let single = matrix(n);
+        let stack = RealTensor::new(single.data().repeat(batch), vec![batch, n, n]).unwrap();
+        let matrices: Vec<RealTensor> = (0..batch).map(|_| single.clone()).collect();
+
+        group.bench_with_input(BenchmarkId::new("det_loop", n), &matrices, |bench, matrices| {
+            bench.iter(|| matrices.iter().map(|m| determinant_nd(m).unwrap()).sum::<f64>())
+        });
+        group.bench_with_input(BenchmarkId::new("det_batch", n), &stack, |bench, stack| {
+            bench.iter(|| determinant_batch(black_box(stack)).unwrap())
+        });
+        group.bench_with_input(BenchmarkId::new("inverse_loop", n), &matrices, |bench, matrices| {
+            bench.iter(|| matrices.iter().map(|m| inverse(m).unwrap()).count())
+        });
+        group.bench_with_input(BenchmarkId::new("inverse_batch", n), &stack, |bench, stack| {
+            bench.iter(|| inverse_batch(black_box(stack)).unwrap())
+        });
+    }
+    group.finish();
+}
+
+criterion_group!(benches, bench_lu, bench_svd, bench_repeated_solve, bench_batched);
+criterion_main!(benches);
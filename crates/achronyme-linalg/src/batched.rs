@@ -0,0 +1,631 @@
+//! Batched linear algebra over stacks of matrices
+//!
+//! A `[batch, m, n]` tensor is `batch` row-major m×n matrices laid end to
+//! end. Every function here runs one operation over the whole stack and
+//! returns the results stacked the same way, so a script handles thousands
+//! of small matrices in one call instead of one `map` step each.
+//!
+//! Square matrices up to 8×8 (determinant, inverse, solve, LU) go through
+//! `SmallLu<N>`, a partial-pivoting LU on stack arrays whose loops the
+//! compiler unrolls for each `N`. Larger matrices, and QR / SVD /
+//! eigenvalues, use faer on zero-copy views of each matrix. Large batches
+//! are split across threads.
+
+use achronyme_types::complex::Complex;
+use achronyme_types::tensor::{ComplexTensor, RealTensor};
+use faer::complex_native::c64;
+
+use crate::factorizations::lu_of_view;
+use crate::interop::{slice_view, write_row_major};
+
+/// Below this much work (batch · n³) a batch runs on the calling thread
+const PARALLEL_MIN_WORK: usize = 1 << 16;
+
+// ============================================================================
+// Small-matrix kernel
+// ============================================================================
+
+/// Partial-pivoting LU of an N×N matrix on the stack, P · A = L · U
+///
+/// `N` is a constant, so the loops are unrolled per order and the factors
+/// never leave the stack.
+struct SmallLu<const N: usize> {
+    /// L below the diagonal (unit diagonal implied), U on and above it
+    lu: [[f64; N]; N],
+    /// Row i of P · A is row perm[i] of A
+    perm: [usize; N],
+    sign: f64,
+}
+
+impl<const N: usize> SmallLu<N> {
+    fn factor(a: &[f64]) -> Self {
+        let mut lu = [[0.0; N]; N];
+        let mut perm = [0; N];
+        for i in 0..N {
+            lu[i].copy_from_slice(&a[i * N..(i + 1) * N]);
+            perm[i] = i;
+        }
+        let mut sign = 1.0;
+
+        for k in 0..N {
+            let mut pivot_row = k;
+            for i in k + 1..N {
+                if lu[i][k].abs() > lu[pivot_row][k].abs() {
+                    pivot_row = i;
+                }
+            }
+            if pivot_row != k {
+                lu.swap(pivot_row, k);
+                perm.swap(pivot_row, k);
+                sign = -sign;
+            }
+
+            let pivot = lu[k][k];
+            if pivot == 0.0 {
+                continue;
+            }
+            for i in k + 1..N {
+                let factor = lu[i][k] / pivot;
+                lu[i][k] = factor;
+                for j in k + 1..N {
+                    lu[i][j] -= factor * lu[k][j];
+                }
+            }
+        }
+
+        Self { lu, perm, sign }
+    }
+
+    fn determinant(&self) -> f64 {
+        (0..N).fold(self.sign, |det, i| det * self.lu[i][i])
+    }
+
+    fn is_singular(&self) -> bool {
+        (0..N).any(|i| self.lu[i][i] == 0.0)
+    }
+
+    /// x = A⁻¹ · b: forward substitution with L, then back with U
+    fn solve(&self, b: &[f64], x: &mut [f64]) {
+        let mut y = [0.0; N];
+        for i in 0..N {
+            let mut value = b[self.perm[i]];
+            for k in 0..i {
+                value -= self.lu[i][k] * y[k];
+            }
+            y[i] = value;
+        }
+        for i in (0..N).rev() {
+            let mut value = y[i];
+            for k in i + 1..N {
+                value -= self.lu[i][k] * y[k];
+            }
+            y[i] = value / self.lu[i][i];
+        }
+        x.copy_from_slice(&y);
+    }
+
+    /// A⁻¹ into a row-major N×N buffer, one column of the identity at a time
+    fn inverse(&self, out: &mut [f64]) {
+        for j in 0..N {
+            let mut e = [0.0; N];
+            e[j] = 1.0;
+            let mut column = [0.0; N];
+            self.solve(&e, &mut column);
+            for i in 0..N {
+                out[i * N + j] = column[i];
+            }
+        }
+    }
+
+    /// L, U (row-major N×N each) and the permutation
+    fn write_factors(&self, l: &mut [f64], u: &mut [f64], perm: &mut [f64]) {
+        for i in 0..N {
+            for j in 0..N {
+                l[i * N + j] = if i == j { 1.0 } else if i > j { self.lu[i][j] } else { 0.0 };
+                u[i * N + j] = if i <= j { self.lu[i][j] } else { 0.0 };
+            }
+            perm[i] = self.perm[i] as f64;
+        }
+    }
+}
+
+/// Evaluate `$small` with `$lu` bound to the `SmallLu` of `$m` when the
+/// order `$n` has an unrolled kernel, `$general` otherwise
+macro_rules! small_lu {
+    ($n:expr, $m:expr, |$lu:ident| $small:expr, $general:expr) => {
+        match $n {
+            1 => {
+                let $lu = SmallLu::<1>::factor($m);
+                $small
+            }
+            2 => {
+                let $lu = SmallLu::<2>::factor($m);
+                $small
+            }
+            3 => {
+                let $lu = SmallLu::<3>::factor($m);
+                $small
+            }
+            4 => {
+                let $lu = SmallLu::<4>::factor($m);
+                $small
+            }
+            5 => {
+                let $lu = SmallLu::<5>::factor($m);
+                $small
+            }
+            6 => {
+                let $lu = SmallLu::<6>::factor($m);
+                $small
+            }
+            7 => {
+                let $lu = SmallLu::<7>::factor($m);
+                $small
+            }
+            8 => {
+                let $lu = SmallLu::<8>::factor($m);
+                $small
+            }
+            _ => $general,
+        }
+    };
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/// Determinant of every matrix in a `[batch, n, n]` stack, as a `[batch]`
+/// vector
+///
+/// # Example
+/// ```
+/// use achronyme_linalg::determinant_batch;
+/// use achronyme_types::tensor::RealTensor;
+///
+/// let stack = RealTensor::new(vec![
+///     4.0, 7.0, 2.0, 6.0,
+///     1.0, 2.0, 3.0, 4.0,
+/// ], vec![2, 2, 2]).unwrap();
+///
+/// let dets = determinant_batch(&stack).unwrap();
+/// assert_eq!(dets.data(), &[10.0, -2.0]);
+/// ```
+pub fn determinant_batch(a: &RealTensor) -> Result<RealTensor, String> {
+    let (batch, n) = square_stack(a, "Batched determinant")?;
+    let data = a.data();
+    let mut out = vec![0.0; batch];
+
+    for_each_matrix(batch, n * n * n, &mut out, 1, |k, det| {
+        let m = &data[k * n * n..(k + 1) * n * n];
+        det[0] = small_lu!(n, m, |lu| lu.determinant(), lu_of_view(slice_view(m, n, n)).determinant());
+        Ok(())
+    })?;
+
+    Ok(RealTensor::vector(out))
+}
+
+/// Inverse of every matrix in a `[batch, n, n]` stack
+///
+/// Fails if any matrix has an exactly zero pivot, naming its index.
+pub fn inverse_batch(a: &RealTensor) -> Result<RealTensor, String> {
+    let (batch, n) = square_stack(a, "Batched inverse")?;
+    let data = a.data();
+    let mut out = vec![0.0; batch * n * n];
+
+    for_each_matrix(batch, n * n * n, &mut out, n * n, |k, inv| {
+        let m = &data[k * n * n..(k + 1) * n * n];
+        small_lu!(
+            n,
+            m,
+            |lu| {
+                regular(lu.is_singular(), k)?;
+                lu.inverse(inv);
+                Ok(())
+            },
+            {
+                let factor = lu_of_view(slice_view(m, n, n));
+                regular(factor.is_singular(), k)?;
+                inv.copy_from_slice(factor.inverse()?.data());
+                Ok(())
+            }
+        )
+    })?;
+
+    stacked(out, vec![batch, n, n])
+}
+
+/// Solve Aₖ · xₖ = bₖ for a `[batch, n, n]` stack `a` and a `[batch, n]`
+/// stack of right-hand sides `b`, returning the `[batch, n]` solutions
+pub fn solve_system_batch(a: &RealTensor, b: &RealTensor) -> Result<RealTensor, String> {
+    let (batch, n) = square_stack(a, "Batched solve")?;
+    if b.shape() != [batch, n] {
+        return Err(format!(
+            "Batched solve: right-hand sides must have shape [{}, {}], got {:?}",
+            batch, n, b.shape()
+        ));
+    }
+    let (data, rhs) = (a.data(), b.data());
+    let mut out = vec![0.0; batch * n];
+
+    for_each_matrix(batch, n * n * n, &mut out, n, |k, x| {
+        let m = &data[k * n * n..(k + 1) * n * n];
+        let b = &rhs[k * n..(k + 1) * n];
+        small_lu!(
+            n,
+            m,
+            |lu| {
+                regular(lu.is_singular(), k)?;
+                lu.solve(b, x);
+                Ok(())
+            },
+            {
+                let factor = lu_of_view(slice_view(m, n, n));
+                regular(factor.is_singular(), k)?;
+                x.copy_from_slice(factor.solve(&RealTensor::vector(b.to_vec()))?.data());
+                Ok(())
+            }
+        )
+    })?;
+
+    stacked(out, vec![batch, n])
+}
+
+/// LU decomposition with partial pivoting of every matrix in a
+/// `[batch, n, n]` stack
+///
+/// Returns the stacked `[batch, n, n]` L and U factors and one row
+/// permutation per matrix, with the meaning of `lu_decomposition`'s.
+pub fn lu_decomposition_batch(a: &RealTensor) -> Result<(RealTensor, RealTensor, Vec<Vec<usize>>), String> {
+    let (batch, n) = square_stack(a, "Batched LU decomposition")?;
+    let data = a.data();
+    let nn = n * n;
+
+    // Per matrix: L, then U, then the permutation (as f64)
+    let item = 2 * nn + n;
+    let mut out = vec![0.0; batch * item];
+
+    for_each_matrix(batch, n * n * n, &mut out, item, |k, chunk| {
+        let m = &data[k * nn..(k + 1) * nn];
+        let (l, rest) = chunk.split_at_mut(nn);
+        let (u, perm) = rest.split_at_mut(nn);
+        small_lu!(
+            n,
+            m,
+            |lu| {
+                lu.write_factors(l, u, perm);
+                Ok(())
+            },
+            {
+                let factor = lu_of_view(slice_view(m, n, n));
+                l.copy_from_slice(factor.l()?.data());
+                u.copy_from_slice(factor.u()?.data());
+                for (slot, &row) in perm.iter_mut().zip(&factor.permutation()) {
+                    *slot = row as f64;
+                }
+                Ok(())
+            }
+        )
+    })?;
+
+    let mut l = Vec::with_capacity(batch * nn);
+    let mut u = Vec::with_capacity(batch * nn);
+    let mut permutations = Vec::with_capacity(batch);
+    for chunk in out.chunks_exact(item.max(1)).take(batch) {
+        l.extend_from_slice(&chunk[..nn]);
+        u.extend_from_slice(&chunk[nn..2 * nn]);
+        permutations.push(chunk[2 * nn..].iter().map(|&row| row as usize).collect());
+    }
+
+    Ok((stacked(l, vec![batch, n, n])?, stacked(u, vec![batch, n, n])?, permutations))
+}
+
+/// Thin QR decomposition of every matrix in a `[batch, m, n]` stack
+///
+/// Returns Q as `[batch, m, k]` and R as `[batch, k, n]`, k = min(m, n).
+pub fn qr_decomposition_batch(a: &RealTensor) -> Result<(RealTensor, RealTensor), String> {
+    let (batch, m, n) = stack(a, "Batched QR decomposition")?;
+    let k = m.min(n);
+    let data = a.data();
+
+    let item = m * k + k * n;
+    let mut out = vec![0.0; batch * item];
+
+    for_each_matrix(batch, m * n * k, &mut out, item, |index, chunk| {
+        let qr = slice_view(&data[index * m * n..(index + 1) * m * n], m, n).qr();
+        let (q, r) = chunk.split_at_mut(m * k);
+        write_row_major(qr.compute_thin_q().as_ref(), q);
+        write_row_major(qr.compute_thin_r().as_ref(), r);
+        Ok(())
+    })?;
+
+    let (q, r) = split_items(&out, batch, [m * k, k * n]);
+    Ok((stacked(q, vec![batch, m, k])?, stacked(r, vec![batch, k, n])?))
+}
+
+/// Thin SVD of every matrix in a `[batch, m, n]` stack
+///
+/// Returns U as `[batch, m, k]`, the singular values as `[batch, k]` and
+/// Vᵀ as `[batch, k, n]`, k = min(m, n).
+pub fn svd_decomposition_batch(a: &RealTensor) -> Result<(RealTensor, RealTensor, RealTensor), String> {
+    let (batch, m, n) = stack(a, "Batched SVD")?;
+    let k = m.min(n);
+    let data = a.data();
+
+    let item = m * k + k + k * n;
+    let mut out = vec![0.0; batch * item];
+
+    for_each_matrix(batch, m * n * k, &mut out, item, |index, chunk| {
+        let svd = slice_view(&data[index * m * n..(index + 1) * m * n], m, n).thin_svd();
+        let (u, rest) = chunk.split_at_mut(m * k);
+        let (s, vt) = rest.split_at_mut(k);
+        write_row_major(svd.u(), u);
+        let sigma = svd.s_diagonal();
+        for (i, slot) in s.iter_mut().enumerate() {
+            *slot = sigma.read(i);
+        }
+        write_row_major(svd.v().transpose(), vt);
+        Ok(())
+    })?;
+
+    let (u, s, vt) = {
+        let (u, rest) = split_items(&out, batch, [m * k, k + k * n]);
+        let (s, vt) = split_items(&rest, batch, [k, k * n]);
+        (u, s, vt)
+    };
+    Ok((
+        stacked(u, vec![batch, m, k])?,
+        stacked(s, vec![batch, k])?,
+        stacked(vt, vec![batch, k, n])?,
+    ))
+}
+
+/// Eigenvalues of every matrix in a `[batch, n, n]` stack, as a
+/// `[batch, n]` complex tensor
+pub fn eigenvalues_batch(a: &RealTensor) -> Result<ComplexTensor, String> {
+    let (batch, n) = square_stack(a, "Batched eigenvalues")?;
+    let data = a.data();
+
+    // Real and imaginary parts interleaved
+    let mut out = vec![0.0; batch * 2 * n];
+
+    for_each_matrix(batch, n * n * n, &mut out, 2 * n, |k, chunk| {
+        let evd = slice_view(&data[k * n * n..(k + 1) * n * n], n, n).eigendecomposition::<c64>();
+        let values = evd.s().column_vector();
+        for i in 0..n {
+            let value = values.read(i);
+            chunk[2 * i] = value.re;
+            chunk[2 * i + 1] = value.im;
+        }
+        Ok(())
+    })?;
+
+    let values = out.chunks_exact(2).map(|pair| Complex::new(pair[0], pair[1])).collect();
+    ComplexTensor::new(values, vec![batch, n]).map_err(|e| e.to_string())
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/// (batch, rows, cols) of a rank-3 stack
+fn stack(a: &RealTensor, operation: &str) -> Result<(usize, usize, usize), String> {
+    match a.shape() {
+        &[batch, rows, cols] => Ok((batch, rows, cols)),
+        shape => Err(format!("{} requires a [batch, m, n] tensor, got shape {:?}", operation, shape)),
+    }
+}
+
+/// (batch, n) of a rank-3 stack of square matrices
+fn square_stack(a: &RealTensor, operation: &str) -> Result<(usize, usize), String> {
+    match a.shape() {
+        &[batch, rows, cols] if rows == cols => Ok((batch, rows)),
+        shape => Err(format!("{} requires a [batch, n, n] tensor, got shape {:?}", operation, shape)),
+    }
+}
+
+fn regular(singular: bool, index: usize) -> Result<(), String> {
+    if singular {
+        return Err(format!("Matrix {} in the batch is singular", index));
+    }
+    Ok(())
+}
+
+fn stacked(data: Vec<f64>, shape: Vec<usize>) -> Result<RealTensor, String> {
+    RealTensor::new(data, shape).map_err(|e| e.to_string())
+}
+
+/// Split per-matrix records of `[first, second]` elements into two stacks
+fn split_items(out: &[f64], batch: usize, [first, second]: [usize; 2]) -> (Vec<f64>, Vec<f64>) {
+    let mut a = Vec::with_capacity(batch * first);
+    let mut b = Vec::with_capacity(batch * second);
+    if first + second > 0 {
+        for chunk in out.chunks_exact(first + second) {
+            a.extend_from_slice(&chunk[..first]);
+            b.extend_from_slice(&chunk[first..]);
+        }
+    }
+    (a, b)
+}
+
+/// Run `kernel(k, chunk)` for every matrix k of the batch, where `chunk`
+/// is the k-th `item`-element slice of `out`
+///
+/// `work` is the cost of one matrix (≈ n³); batches worth less than
+/// `PARALLEL_MIN_WORK` run on the calling thread. On failure the error of
+/// the lowest-indexed failing matrix is returned.
+fn for_each_matrix<F>(batch: usize, work: usize, out: &mut [f64], item: usize, kernel: F) -> Result<(), String>
+where
+    F: Fn(usize, &mut [f64]) -> Result<(), String> + Sync,
+{
+    if batch == 0 {
+        return Ok(());
+    }
+    if item == 0 {
+        // Nothing to write (0×0 matrices): still validate each matrix
+        return (0..batch).try_for_each(|k| kernel(k, &mut []));
+    }
+
+    let threads = if batch.saturating_mul(work.max(1)) >= PARALLEL_MIN_WORK {
+        std::thread::available_parallelism().map_or(1, |t| t.get()).min(batch)
+    } else {
+        1
+    };
+
+    let run = |first: usize, chunk: &mut [f64]| -> Result<(), String> {
+        for (offset, slot) in chunk.chunks_exact_mut(item).enumerate() {
+            kernel(first + offset, slot)?;
+        }
+        Ok(())
+    };
+
+    if threads <= 1 {
+        return run(0, out);
+    }
+
+    let per_thread = batch.div_ceil(threads);
+    let results: Vec<Result<(), String>> = std::thread::scope(|scope| {
+        let handles: Vec<_> = out
+            .chunks_mut(per_thread * item)
+            .enumerate()
+            .map(|(panel, chunk)| {
+                let run = &run;
+                scope.spawn(move || run(panel * per_thread, chunk))
+            })
+            .collect();
+        handles
+            .into_iter()
+            .map(|handle| handle.join().unwrap_or_else(|_| Err("Batched kernel panicked".to_string())))
+            .collect()
+    });
+    results.into_iter().collect()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::{determinant_nd, inverse, lu_decomposition, qr_decomposition, svd_decomposition};
+    use approx::assert_relative_eq;
+
+    /// `batch` well-conditioned n×n matrices, stacked
+    fn stack_of(batch: usize, n: usize) -> RealTensor {
+        let mut data = Vec::with_capacity(batch * n * n);
+        for k in 0..batch {
+            for i in 0..n {
+                for j in 0..n {
+                    let value = ((k * 31 + i * 7 + j * 13) % 17) as f64 / 4.0 - 2.0;
+                    data.push(if i == j { value + n as f64 } else { value });
+                }
+            }
+        }
+        RealTensor::new(data, vec![batch, n, n]).unwrap()
+    }
+
+    fn matrix_at(a: &RealTensor, k: usize) -> RealTensor {
+        let (rows, cols) = (a.shape()[1], a.shape()[2]);
+        RealTensor::matrix(rows, cols, a.data()[k * rows * cols..(k + 1) * rows * cols].to_vec()).unwrap()
+    }
+
+    fn assert_close(got: &[f64], expected: &[f64]) {
+        assert_eq!(got.len(), expected.len());
+        for (g, e) in got.iter().zip(expected) {
+            assert_relative_eq!(*g, *e, epsilon = 1e-9);
+        }
+    }
+
+    #[test]
+    fn test_determinant_and_inverse_match_single_matrix() {
+        // Unrolled kernels (1..=8) and the faer path (10)
+        for n in [1, 2, 3, 4, 6, 10] {
+            let a = stack_of(5, n);
+            let dets = determinant_batch(&a).unwrap();
+            let inverses = inverse_batch(&a).unwrap();
+            assert_eq!(inverses.shape(), &[5, n, n]);
+
+            for k in 0..5 {
+                let single = matrix_at(&a, k);
+                assert_relative_eq!(dets.data()[k], determinant_nd(&single).unwrap(), epsilon = 1e-9);
+                assert_close(matrix_at(&inverses, k).data(), inverse(&single).unwrap().data());
+            }
+        }
+    }
+
+    #[test]
+    fn test_solve_batch() {
+        for n in [3, 9] {
+            let a = stack_of(4, n);
+            let b = RealTensor::new((0..4 * n).map(|i| i as f64 - 3.0).collect(), vec![4, n]).unwrap();
+            let x = solve_system_batch(&a, &b).unwrap();
+
+            for k in 0..4 {
+                let ax = matrix_at(&a, k)
+                    .matmul(&RealTensor::matrix(n, 1, x.data()[k * n..(k + 1) * n].to_vec()).unwrap())
+                    .unwrap();
+                assert_close(ax.data(), &b.data()[k * n..(k + 1) * n]);
+            }
+        }
+    }
+
+    #[test]
+    fn test_lu_batch_matches_single_matrix() {
+        for n in [3, 9] {
+            let a = stack_of(3, n);
+            let (l, u, perms) = lu_decomposition_batch(&a).unwrap();
+            for k in 0..3 {
+                let (l1, u1, p1) = lu_decomposition(&matrix_at(&a, k)).unwrap();
+                assert_close(matrix_at(&l, k).data(), l1.data());
+                assert_close(matrix_at(&u, k).data(), u1.data());
+                assert_eq!(perms[k], p1);
+            }
+        }
+    }
+
+    #[test]
+    fn test_qr_svd_eigenvalues_batch() {
+        let a = RealTensor::new((0..3 * 4 * 2).map(|i| ((i * 5) % 7) as f64 - 1.0).collect(), vec![3, 4, 2]).unwrap();
+        let (q, r) = qr_decomposition_batch(&a).unwrap();
+        let (u, s, vt) = svd_decomposition_batch(&a).unwrap();
+        assert_eq!((q.shape(), r.shape()), (&[3, 4, 2][..], &[3, 2, 2][..]));
+        assert_eq!((u.shape(), s.shape(), vt.shape()), (&[3, 4, 2][..], &[3, 2][..], &[3, 2, 2][..]));
+
+        for k in 0..3 {
+            let (q1, r1) = qr_decomposition(&matrix_at(&a, k)).unwrap();
+            assert_close(matrix_at(&q, k).data(), q1.data());
+            assert_close(matrix_at(&r, k).data(), r1.data());
+            let (_, s1, _) = svd_decomposition(&matrix_at(&a, k)).unwrap();
+            assert_close(&s.data()[k * 2..(k + 1) * 2], &s1);
+        }
+
+        let square = stack_of(2, 3);
+        let eigs = eigenvalues_batch(&square).unwrap();
+        assert_eq!(eigs.shape(), &[2, 3]);
+        let single = crate::eigenvalues(&matrix_at(&square, 1)).unwrap();
+        assert_eq!(&eigs.data()[3..], &single[..]);
+    }
+
+    #[test]
+    fn test_large_batch_runs_in_parallel_chunks() {
+        // Enough work to be split across threads where more than one exists
+        let a = stack_of(5000, 3);
+        let dets = determinant_batch(&a).unwrap();
+        for k in [0, 2499, 4999] {
+            assert_relative_eq!(dets.data()[k], determinant_nd(&matrix_at(&a, k)).unwrap(), epsilon = 1e-9);
+        }
+    }
+
+    #[test]
+    fn test_errors() {
+        assert!(determinant_batch(&RealTensor::eye(3)).is_err());
+        assert!(inverse_batch(&RealTensor::zeros(vec![2, 2, 3])).is_err());
+
+        // The second matrix is singular
+        let mut data = stack_of(3, 2).data().to_vec();
+        data[4..8].copy_from_slice(&[1.0, 2.0, 2.0, 4.0]);
+        let a = RealTensor::new(data, vec![3, 2, 2]).unwrap();
+        assert_eq!(inverse_batch(&a).unwrap_err(), "Matrix 1 in the batch is singular");
+        assert_eq!(determinant_batch(&a).unwrap().data()[1], 0.0);
+
+        let b = RealTensor::zeros(vec![3, 3]);
+        assert!(solve_system_batch(&a, &b).is_err());
+    }
+}
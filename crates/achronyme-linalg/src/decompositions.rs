@@ -1,43 +1,7 @@
 use achronyme_types::tensor::RealTensor;
-use faer::prelude::*;
 
-/// Convert Achronyme RealTensor to faer Mat
-fn tensor_to_faer_mat(tensor: &RealTensor) -> Mat<f64> {
-    assert!(tensor.is_matrix());
-    let rows = tensor.rows();
-    let cols = tensor.cols();
-    Mat::from_fn(rows, cols, |i, j| tensor.get_matrix(i, j).unwrap())
-}
-
-/// Convert faer Mat to Achronyme RealTensor
-fn faer_mat_to_tensor(mat: Mat<f64>) -> Result<RealTensor, String> {
-    let rows = mat.nrows();
-    let cols = mat.ncols();
-    let mut data = Vec::with_capacity(rows * cols);
-
-    for i in 0..rows {
-        for j in 0..cols {
-            data.push(mat.read(i, j));
-        }
-    }
-
-    RealTensor::matrix(rows, cols, data).map_err(|e| e.to_string())
-}
-
-/// Convert faer MatRef to Achronyme RealTensor
-fn faer_mat_ref_to_tensor(mat: MatRef<f64>) -> Result<RealTensor, String> {
-    let rows = mat.nrows();
-    let cols = mat.ncols();
-    let mut data = Vec::with_capacity(rows * cols);
-
-    for i in 0..rows {
-        for j in 0..cols {
-            data.push(mat.read(i, j));
-        }
-    }
-
-    RealTensor::matrix(rows, cols, data).map_err(|e| e.to_string())
-}
+use crate::factorizations::{cholesky, lu};
+use crate::interop::{mat_to_tensor, mat_view};
 
 /// LU Decomposition with Partial Pivoting
 ///
@@ -64,22 +28,8 @@ pub fn lu_decomposition(tensor: &RealTensor) -> Result<(RealTensor, RealTensor,
         return Err("LU decomposition requires square matrix".to_string());
     }
 
-    let mat = tensor_to_faer_mat(tensor);
-    let lu = mat.partial_piv_lu();
-
-    let l = lu.compute_l();
-    let u = lu.compute_u();
-    let p = lu.row_permutation();
-
-    // Convert permutation to vector
-    let perm_vec: Vec<usize> = (0..tensor.rows())
-        .map(|i| p.arrays().0[i])
-        .collect();
-
-    let l_tensor = faer_mat_to_tensor(l)?;
-    let u_tensor = faer_mat_to_tensor(u)?;
-
-    Ok((l_tensor, u_tensor, perm_vec))
+    let factor = lu(tensor)?;
+    Ok((factor.l()?, factor.u()?, factor.permutation()))
 }
 
 /// Cholesky Decomposition
@@ -107,15 +57,7 @@ pub fn cholesky_decomposition(tensor: &RealTensor) -> Result<RealTensor, String>
         return Err("Cholesky decomposition requires square matrix".to_string());
     }
 
-    let mat = tensor_to_faer_mat(tensor);
-
-    // Perform Cholesky decomposition
-    let chol = mat
-        .cholesky(faer::Side::Lower)
-        .map_err(|_| "Cholesky decomposition failed (matrix not positive definite?)".to_string())?;
-
-    let l = chol.compute_l();
-    faer_mat_to_tensor(l)
+    cholesky(tensor)?.l()
 }
 
 /// QR Decomposition
@@ -139,16 +81,14 @@ pub fn cholesky_decomposition(tensor: &RealTensor) -> Result<RealTensor, String>
 /// let (q, r) = qr_decomposition(&a).unwrap();
 /// ```
 pub fn qr_decomposition(tensor: &RealTensor) -> Result<(RealTensor, RealTensor), String> {
-    let mat = tensor_to_faer_mat(tensor);
-
     // Perform QR decomposition
-    let qr = mat.qr();
+    let qr = mat_view(tensor)?.qr();
 
     let q = qr.compute_thin_q();
     let r = qr.compute_thin_r();
 
-    let q_tensor = faer_mat_to_tensor(q)?;
-    let r_tensor = faer_mat_to_tensor(r)?;
+    let q_tensor = mat_to_tensor(q.as_ref())?;
+    let r_tensor = mat_to_tensor(r.as_ref())?;
 
     Ok((q_tensor, r_tensor))
 }
@@ -177,18 +117,16 @@ pub fn qr_decomposition(tensor: &RealTensor) -> Result<(RealTensor, RealTensor),
 /// let (u, s, vt) = svd_decomposition(&a).unwrap();
 /// ```
 pub fn svd_decomposition(tensor: &RealTensor) -> Result<(RealTensor, Vec<f64>, RealTensor), String> {
-    let mat = tensor_to_faer_mat(tensor);
-
     // Perform SVD
-    let svd = mat.thin_svd();
+    let svd = mat_view(tensor)?.thin_svd();
 
     let u = svd.u();
     let s = svd.s_diagonal();
     let v = svd.v();
 
     // Convert V to V^T by transposing during extraction
-    let u_tensor = faer_mat_ref_to_tensor(u)?;
-    let vt_tensor = faer_mat_ref_to_tensor(v.transpose().as_ref())?;
+    let u_tensor = mat_to_tensor(u)?;
+    let vt_tensor = mat_to_tensor(v.transpose())?;
 
     // Extract singular values
     let singular_values: Vec<f64> = (0..s.nrows())
@@ -3,13 +3,7 @@ use achronyme_types::complex::Complex;
 use faer::prelude::*;
 use faer::complex_native::c64;
 
-/// Convert Achronyme RealTensor to faer Mat
-fn tensor_to_faer_mat(tensor: &RealTensor) -> Mat<f64> {
-    assert!(tensor.is_matrix());
-    let rows = tensor.rows();
-    let cols = tensor.cols();
-    Mat::from_fn(rows, cols, |i, j| tensor.get_matrix(i, j).unwrap())
-}
+use crate::interop::mat_view;
 
 /// Compute eigenvalues of a square matrix
 ///
@@ -38,10 +32,8 @@ pub fn eigenvalues(tensor: &RealTensor) -> Result<Vec<Complex>, String> {
         return Err("Eigenvalue computation requires square matrix".to_string());
     }
 
-    let mat = tensor_to_faer_mat(tensor);
-
     // Compute eigenvalue decomposition
-    let evd = mat.eigendecomposition::<c64>();
+    let evd = mat_view(tensor)?.eigendecomposition::<c64>();
     let eigenvals = evd.s().column_vector();
 
     // Convert to Achronyme Complex
@@ -83,10 +75,8 @@ pub fn eigenvectors(tensor: &RealTensor) -> Result<(Vec<Complex>, RealTensor), S
         return Err("Eigenvector computation requires square matrix".to_string());
     }
 
-    let mat = tensor_to_faer_mat(tensor);
-
     // Compute eigenvalue decomposition
-    let evd = mat.eigendecomposition::<c64>();
+    let evd = mat_view(tensor)?.eigendecomposition::<c64>();
     let eigenvals = evd.s().column_vector();
     let eigenvecs_complex = evd.u();
 
@@ -131,7 +121,7 @@ pub fn power_iteration(tensor: &RealTensor, max_iterations: usize, tolerance: f6
         return Err("Power iteration requires square matrix".to_string());
     }
 
-    let mat = tensor_to_faer_mat(tensor);
+    let mat = mat_view(tensor)?.to_owned();
     let n = mat.nrows();
 
     // Initialize with random vector
@@ -182,7 +172,7 @@ pub fn qr_eigenvalues(tensor: &RealTensor, max_iterations: usize, tolerance: f64
         return Err("QR eigenvalue algorithm requires square matrix".to_string());
     }
 
-    let mut a = tensor_to_faer_mat(tensor);
+    let mut a = mat_view(tensor)?.to_owned();
 
     for _ in 0..max_iterations {
         let qr = a.qr();
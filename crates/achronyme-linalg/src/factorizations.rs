@@ -0,0 +1,340 @@
+//! Reusable matrix factorizations
+//!
+//! `lu(&a)` and `cholesky(&a)` factor a matrix once and return a value that
+//! solves any number of right-hand sides against it: a vector, a matrix of
+//! column right-hand sides, or a batch of vectors. Each solve costs two
+//! triangular substitutions (O(n²) per right-hand side) instead of the O(n³)
+//! factorization `solve_system` pays on every call.
+//!
+//! # Example
+//! ```
+//! use achronyme_linalg::lu;
+//! use achronyme_types::tensor::RealTensor;
+//!
+//! let a = RealTensor::matrix(2, 2, vec![3.0, 1.0, 1.0, 2.0]).unwrap();
+//! let factor = lu(&a).unwrap();
+//!
+//! for b in [vec![9.0, 8.0], vec![4.0, 3.0]] {
+//!     let x = factor.solve(&RealTensor::vector(b)).unwrap();
+//!     assert_eq!(x.size(), 2);
+//! }
+//! ```
+
+use achronyme_types::tensor::RealTensor;
+use faer::prelude::*;
+use faer::solvers::{Cholesky, PartialPivLu};
+
+use crate::interop::{col_view, mat_to_tensor, mat_view};
+
+/// LU factorization with partial pivoting, P · A = L · U
+#[derive(Debug, Clone)]
+pub struct LuFactorization {
+    lu: PartialPivLu<f64>,
+    /// Diagonal of U, kept for the determinant and the singularity check
+    u_diagonal: Vec<f64>,
+    /// Sign of the row permutation (+1 even, -1 odd)
+    permutation_sign: f64,
+}
+
+/// Cholesky factorization of a symmetric positive-definite matrix, A = L · Lᵀ
+#[derive(Debug, Clone)]
+pub struct CholeskyFactorization {
+    cholesky: Cholesky<f64>,
+    /// Diagonal of L, kept for the determinant
+    l_diagonal: Vec<f64>,
+}
+
+/// Factor a square matrix as P · A = L · U
+///
+/// Singular matrices factor fine (their determinant is 0); solving against
+/// them is an error.
+pub fn lu(a: &RealTensor) -> Result<LuFactorization, String> {
+    if !a.is_square() {
+        return Err("LU factorization requires square matrix".to_string());
+    }
+
+    Ok(lu_of_view(mat_view(a)?))
+}
+
+/// `lu` on a square faer view (one matrix of a batch, say)
+pub(crate) fn lu_of_view(mat: MatRef<'_, f64>) -> LuFactorization {
+    let lu = mat.partial_piv_lu();
+    let u = lu.compute_u();
+    let u_diagonal = (0..u.nrows()).map(|i| u.read(i, i)).collect();
+    let permutation_sign = permutation_sign(lu.row_permutation().arrays().0);
+
+    LuFactorization { lu, u_diagonal, permutation_sign }
+}
+
+/// Factor a symmetric positive-definite matrix as A = L · Lᵀ
+///
+/// Only the lower triangle of `a` is read.
+pub fn cholesky(a: &RealTensor) -> Result<CholeskyFactorization, String> {
+    if !a.is_square() {
+        return Err("Cholesky decomposition requires square matrix".to_string());
+    }
+
+    let cholesky = mat_view(a)?
+        .cholesky(faer::Side::Lower)
+        .map_err(|_| "Cholesky decomposition failed (matrix not positive definite?)".to_string())?;
+    let l = cholesky.compute_l();
+    let l_diagonal = (0..l.nrows()).map(|i| l.read(i, i)).collect();
+
+    Ok(CholeskyFactorization { cholesky, l_diagonal })
+}
+
+impl LuFactorization {
+    /// Order of the factored matrix
+    pub fn dim(&self) -> usize {
+        self.u_diagonal.len()
+    }
+
+    /// det(A) = sign(P) · Π Uᵢᵢ, in O(n)
+    pub fn determinant(&self) -> f64 {
+        self.permutation_sign * self.u_diagonal.iter().product::<f64>()
+    }
+
+    /// True when a pivot is exactly zero
+    pub fn is_singular(&self) -> bool {
+        self.u_diagonal.iter().any(|&d| d == 0.0)
+    }
+
+    /// Solve A · x = b for a vector `b`, or A · X = B for a matrix `b`
+    /// whose columns are right-hand sides
+    pub fn solve(&self, b: &RealTensor) -> Result<RealTensor, String> {
+        self.check_regular()?;
+        solve_tensor(|rhs| self.lu.solve(rhs), self.dim(), b)
+    }
+
+    /// Solve against every vector in `rhs`, as one multi-column solve
+    pub fn solve_batch(&self, rhs: &[RealTensor]) -> Result<Vec<RealTensor>, String> {
+        self.check_regular()?;
+        solve_batch(|packed| self.lu.solve(packed), self.dim(), rhs)
+    }
+
+    /// A⁻¹, from the existing factors
+    pub fn inverse(&self) -> Result<RealTensor, String> {
+        self.check_regular()?;
+        let n = self.dim();
+        mat_to_tensor(self.lu.solve(&Mat::<f64>::identity(n, n)).as_ref())
+    }
+
+    /// L (unit lower triangular) as a tensor
+    pub fn l(&self) -> Result<RealTensor, String> {
+        mat_to_tensor(self.lu.compute_l().as_ref())
+    }
+
+    /// U (upper triangular) as a tensor
+    pub fn u(&self) -> Result<RealTensor, String> {
+        mat_to_tensor(self.lu.compute_u().as_ref())
+    }
+
+    /// Row permutation: row `i` of P · A is row `permutation()[i]` of A
+    pub fn permutation(&self) -> Vec<usize> {
+        self.lu.row_permutation().arrays().0.to_vec()
+    }
+
+    fn check_regular(&self) -> Result<(), String> {
+        if self.is_singular() {
+            return Err("Matrix is singular".to_string());
+        }
+        Ok(())
+    }
+}
+
+impl CholeskyFactorization {
+    /// Order of the factored matrix
+    pub fn dim(&self) -> usize {
+        self.l_diagonal.len()
+    }
+
+    /// det(A) = (Π Lᵢᵢ)², in O(n)
+    pub fn determinant(&self) -> f64 {
+        let product: f64 = self.l_diagonal.iter().product();
+        product * product
+    }
+
+    /// Solve A · x = b for a vector `b`, or A · X = B for a matrix `b`
+    /// whose columns are right-hand sides
+    pub fn solve(&self, b: &RealTensor) -> Result<RealTensor, String> {
+        solve_tensor(|rhs| self.cholesky.solve(rhs), self.dim(), b)
+    }
+
+    /// Solve against every vector in `rhs`, as one multi-column solve
+    pub fn solve_batch(&self, rhs: &[RealTensor]) -> Result<Vec<RealTensor>, String> {
+        solve_batch(|packed| self.cholesky.solve(packed), self.dim(), rhs)
+    }
+
+    /// A⁻¹, from the existing factor
+    pub fn inverse(&self) -> Result<RealTensor, String> {
+        let n = self.dim();
+        mat_to_tensor(self.cholesky.solve(&Mat::<f64>::identity(n, n)).as_ref())
+    }
+
+    /// L (lower triangular) as a tensor
+    pub fn l(&self) -> Result<RealTensor, String> {
+        mat_to_tensor(self.cholesky.compute_l().as_ref())
+    }
+}
+
+/// Solve for a vector or a matrix of right-hand sides
+///
+/// `solve` is the factorization's multi-column solve; vectors go through it
+/// as n×1 matrices.
+fn solve_tensor(solve: impl Fn(&Mat<f64>) -> Mat<f64>, n: usize, b: &RealTensor) -> Result<RealTensor, String> {
+    if b.is_vector() {
+        check_rows(n, b.size())?;
+        let x = solve(&col_view(b)?.to_owned());
+        return Ok(RealTensor::vector(x.col_as_slice(0).to_vec()));
+    }
+
+    let rhs = mat_view(b).map_err(|_| "Right-hand side must be a vector or a matrix".to_string())?;
+    check_rows(n, rhs.nrows())?;
+    mat_to_tensor(solve(&rhs.to_owned()).as_ref())
+}
+
+/// Pack the vectors as columns of one matrix, solve once, and split the
+/// solution back into vectors
+fn solve_batch(solve: impl Fn(&Mat<f64>) -> Mat<f64>, n: usize, rhs: &[RealTensor]) -> Result<Vec<RealTensor>, String> {
+    for b in rhs {
+        if !b.is_vector() {
+            return Err("Batch right-hand sides must be vectors".to_string());
+        }
+        check_rows(n, b.size())?;
+    }
+
+    let packed = Mat::from_fn(n, rhs.len(), |i, j| rhs[j].data()[i]);
+    let x = solve(&packed);
+    Ok((0..rhs.len())
+        .map(|j| RealTensor::vector(x.col_as_slice(j).to_vec()))
+        .collect())
+}
+
+fn check_rows(n: usize, rows: usize) -> Result<(), String> {
+    if rows != n {
+        return Err(format!(
+            "Dimension mismatch: matrix has {} rows but right-hand side has {}",
+            n, rows
+        ));
+    }
+    Ok(())
+}
+
+/// +1 for an even permutation, -1 for an odd one (by cycle decomposition)
+fn permutation_sign(perm: &[usize]) -> f64 {
+    let mut visited = vec![false; perm.len()];
+    let mut swaps = 0;
+
+    for i in 0..perm.len() {
+        if !visited[i] && perm[i] != i {
+            let mut j = i;
+            while !visited[j] {
+                visited[j] = true;
+                j = perm[j];
+                swaps += 1;
+            }
+            swaps -= 1; // Each cycle of length n requires n-1 swaps
+        }
+    }
+
+    if swaps % 2 == 1 { -1.0 } else { 1.0 }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use approx::assert_relative_eq;
+
+    fn spd() -> RealTensor {
+        RealTensor::matrix(3, 3, vec![
+            4.0, 2.0, 1.0,
+            2.0, 3.0, 1.0,
+            1.0, 1.0, 2.0
+        ]).unwrap()
+    }
+
+    fn assert_solves(a: &RealTensor, x: &RealTensor, b: &RealTensor) {
+        let ax = a.matmul(&x.reshape(vec![x.shape()[0], x.size() / x.shape()[0]]).unwrap()).unwrap();
+        for (got, expected) in ax.data().iter().zip(b.data()) {
+            assert_relative_eq!(*got, *expected, epsilon = 1e-10);
+        }
+    }
+
+    #[test]
+    fn test_lu_solves_many_rhs() {
+        let a = RealTensor::matrix(3, 3, vec![
+            0.0, 2.0, 1.0,
+            4.0, 3.0, 3.0,
+            8.0, 7.0, 9.0
+        ]).unwrap();
+        let factor = lu(&a).unwrap();
+
+        for b in [vec![1.0, 2.0, 3.0], vec![-1.0, 0.5, 4.0]] {
+            let b = RealTensor::vector(b);
+            assert_solves(&a, &factor.solve(&b).unwrap(), &b);
+        }
+
+        // A matrix of right-hand sides and a batch give the same columns
+        let b = RealTensor::matrix(3, 2, vec![1.0, -1.0, 2.0, 0.5, 3.0, 4.0]).unwrap();
+        let x = factor.solve(&b).unwrap();
+        assert_solves(&a, &x, &b);
+        let batch = factor.solve_batch(&[
+            RealTensor::vector(vec![1.0, 2.0, 3.0]),
+            RealTensor::vector(vec![-1.0, 0.5, 4.0]),
+        ]).unwrap();
+        for i in 0..3 {
+            assert_relative_eq!(batch[0].data()[i], x.get_matrix(i, 0).unwrap(), epsilon = 1e-12);
+            assert_relative_eq!(batch[1].data()[i], x.get_matrix(i, 1).unwrap(), epsilon = 1e-12);
+        }
+    }
+
+    #[test]
+    fn test_lu_determinant_and_inverse() {
+        let a = RealTensor::matrix(3, 3, vec![
+            1.0, 2.0, 3.0,
+            0.0, 1.0, 4.0,
+            5.0, 6.0, 0.0
+        ]).unwrap();
+        let factor = lu(&a).unwrap();
+        assert_relative_eq!(factor.determinant(), 1.0, epsilon = 1e-10);
+
+        let product = a.matmul(&factor.inverse().unwrap()).unwrap();
+        let identity = RealTensor::eye(3);
+        for (got, expected) in product.data().iter().zip(identity.data()) {
+            assert_relative_eq!(*got, *expected, epsilon = 1e-10);
+        }
+    }
+
+    #[test]
+    fn test_lu_singular() {
+        let a = RealTensor::matrix(2, 2, vec![1.0, 2.0, 2.0, 4.0]).unwrap();
+        let factor = lu(&a).unwrap();
+
+        assert!(factor.is_singular());
+        assert_eq!(factor.determinant(), 0.0);
+        assert!(factor.solve(&RealTensor::vector(vec![1.0, 2.0])).is_err());
+    }
+
+    #[test]
+    fn test_cholesky_solves_and_determinant() {
+        let a = spd();
+        let factor = cholesky(&a).unwrap();
+        assert_relative_eq!(factor.determinant(), lu(&a).unwrap().determinant(), epsilon = 1e-10);
+
+        let b = RealTensor::vector(vec![1.0, 2.0, 3.0]);
+        assert_solves(&a, &factor.solve(&b).unwrap(), &b);
+        let batch = factor.solve_batch(&[b.clone(), b.clone()]).unwrap();
+        assert_eq!(batch.len(), 2);
+        assert_solves(&a, &batch[1], &b);
+    }
+
+    #[test]
+    fn test_invalid_inputs() {
+        assert!(lu(&RealTensor::matrix(2, 3, vec![0.0; 6]).unwrap()).is_err());
+        assert!(cholesky(&RealTensor::matrix(2, 2, vec![1.0, 2.0, 2.0, 1.0]).unwrap()).is_err());
+
+        let factor = lu(&spd()).unwrap();
+        assert!(factor.solve(&RealTensor::vector(vec![1.0, 2.0])).is_err());
+        assert!(factor.solve_batch(&[RealTensor::eye(3)]).is_err());
+    }
+}
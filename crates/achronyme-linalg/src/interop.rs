@@ -0,0 +1,87 @@
+//! Conversions between Achronyme tensors and faer matrices
+//!
+//! `RealTensor` matrices are stored row-major in one contiguous buffer, so
+//! faer can read them in place through a strided `MatRef`: no copy is made
+//! going in. Results computed by faer are owned, column-major `Mat`s and are
+//! copied once (column by column) into a new tensor coming out.
+
+use achronyme_types::tensor::RealTensor;
+use faer::prelude::*;
+
+/// Borrow a matrix tensor as a faer view, without copying
+pub fn mat_view(tensor: &RealTensor) -> Result<MatRef<'_, f64>, String> {
+    if !tensor.is_matrix() {
+        return Err(format!("Expected a matrix, got a rank-{} tensor", tensor.rank()));
+    }
+    Ok(slice_view(tensor.data(), tensor.rows(), tensor.cols()))
+}
+
+/// Borrow a vector tensor as an n×1 faer view, without copying
+pub fn col_view(tensor: &RealTensor) -> Result<MatRef<'_, f64>, String> {
+    if !tensor.is_vector() {
+        return Err(format!("Expected a vector, got a rank-{} tensor", tensor.rank()));
+    }
+    Ok(faer::mat::from_column_major_slice::<f64>(tensor.data(), tensor.size(), 1))
+}
+
+/// View a row-major `rows`×`cols` buffer (one matrix of a stack, say) as
+/// a faer matrix, without copying
+pub fn slice_view(data: &[f64], rows: usize, cols: usize) -> MatRef<'_, f64> {
+    faer::mat::from_row_major_slice::<f64>(data, rows, cols)
+}
+
+/// Copy a faer matrix (owned or view, any strides) into a matrix tensor
+pub fn mat_to_tensor(mat: MatRef<'_, f64>) -> Result<RealTensor, String> {
+    let mut data = vec![0.0; mat.nrows() * mat.ncols()];
+    write_row_major(mat, &mut data);
+    RealTensor::matrix(mat.nrows(), mat.ncols(), data).map_err(|e| e.to_string())
+}
+
+/// Copy a faer matrix into a row-major buffer of exactly rows·cols elements
+pub fn write_row_major(mat: MatRef<'_, f64>, out: &mut [f64]) {
+    let cols = mat.ncols();
+    debug_assert_eq!(out.len(), mat.nrows() * cols);
+
+    // Column-outer, so owned (column-major) results are read sequentially
+    for j in 0..cols {
+        for i in 0..mat.nrows() {
+            out[i * cols + j] = mat.read(i, j);
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_mat_view_is_zero_copy() {
+        let a = RealTensor::matrix(2, 3, vec![1.0, 2.0, 3.0, 4.0, 5.0, 6.0]).unwrap();
+        let view = mat_view(&a).unwrap();
+
+        assert_eq!((view.nrows(), view.ncols()), (2, 3));
+        assert_eq!(view.read(1, 0), 4.0);
+        assert_eq!(view.read(0, 2), 3.0);
+        assert_eq!((view.row_stride(), view.col_stride()), (3, 1));
+    }
+
+    #[test]
+    fn test_round_trip() {
+        let a = RealTensor::matrix(3, 2, vec![1.0, -2.0, 3.5, 4.0, 0.0, 6.0]).unwrap();
+
+        // Through a view, an owned column-major copy and a transposed view
+        assert_eq!(mat_to_tensor(mat_view(&a).unwrap()).unwrap(), a);
+        assert_eq!(mat_to_tensor(mat_view(&a).unwrap().to_owned().as_ref()).unwrap(), a);
+        let t = mat_to_tensor(mat_view(&a).unwrap().transpose()).unwrap();
+        assert_eq!(t.shape(), &[2, 3]);
+        assert_eq!(t.data(), &[1.0, 3.5, 0.0, -2.0, 4.0, 6.0]);
+    }
+
+    #[test]
+    fn test_views_check_rank() {
+        let v = RealTensor::vector(vec![1.0, 2.0]);
+        assert!(mat_view(&v).is_err());
+        assert_eq!(col_view(&v).unwrap().nrows(), 2);
+        assert!(col_view(&RealTensor::eye(2)).is_err());
+    }
+}
@@ -2,17 +2,31 @@
 //!
 //! Provides advanced linear algebra operations using faer (100% Rust, WASM-compatible):
 //! - Matrix decompositions (LU, QR, Cholesky, SVD)
+//! - Reusable LU / Cholesky factorizations for many right-hand sides
+//! - Batched variants over `[batch, n, n]` stacks of matrices
 //! - Eigenvalue decomposition
 //! - Matrix inversion
 //! - Linear system solving
+//! - Matrix products (faer GEMM for large sizes)
 //!
-//! Migrated to faer for maximum performance and WASM compatibility
+//! Migrated to faer for maximum performance and WASM compatibility.
+//! Tensors are handed to faer as zero-copy row-major views (`interop`).
 
+pub mod interop;
 pub mod decompositions;
+pub mod factorizations;
+pub mod batched;
 pub mod eigenvalues;
 pub mod solvers;
+pub mod products;
 
 // Re-exports for convenience
 pub use decompositions::{lu_decomposition, qr_decomposition, cholesky_decomposition, svd_decomposition};
+pub use factorizations::{lu, cholesky, LuFactorization, CholeskyFactorization};
+pub use batched::{
+    determinant_batch, inverse_batch, solve_system_batch, lu_decomposition_batch,
+    qr_decomposition_batch, svd_decomposition_batch, eigenvalues_batch,
+};
 pub use eigenvalues::{eigenvalues, eigenvectors, power_iteration, qr_eigenvalues, eigen_symmetric};
 pub use solvers::{inverse, solve_system, determinant_nd, is_symmetric, is_positive_definite};
+pub use products::{matmul, matmul_complex, FAER_MATMUL_THRESHOLD};
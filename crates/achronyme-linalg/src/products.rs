@@ -0,0 +1,153 @@
+use achronyme_types::complex::Complex;
+use achronyme_types::tensor::{ComplexTensor, RealTensor};
+use faer::linalg::matmul::matmul as faer_matmul;
+use faer::Parallelism;
+
+/// Products with at least this many multiply-adds (m·n·p) go to faer's
+/// parallel GEMM; smaller ones use the blocked kernel in achronyme-types
+pub const FAER_MATMUL_THRESHOLD: usize = 1 << 24;
+
+/// (m, n, p) when `a` (m×n) times `b` (n×p) is large enough for faer
+///
+/// Invalid shapes return `None` so the tensor kernel reports the error.
+fn faer_dims(a_shape: &[usize], b_shape: &[usize]) -> Option<(usize, usize, usize)> {
+    match (a_shape, b_shape) {
+        (&[m, n], &[n2, p]) if n == n2 && m * n * p >= FAER_MATMUL_THRESHOLD => Some((m, n, p)),
+        _ => None,
+    }
+}
+
+/// out = out + beta·(a·b) (or just beta·(a·b)) on row-major buffers, using faer
+///
+/// With `keep = false` the previous contents of `out` are ignored.
+fn gemm(out: &mut [f64], a: &[f64], b: &[f64], (m, n, p): (usize, usize, usize), keep: bool, beta: f64) {
+    let lhs = faer::mat::from_row_major_slice::<f64>(a, m, n);
+    let rhs = faer::mat::from_row_major_slice::<f64>(b, n, p);
+    let acc = faer::mat::from_row_major_slice_mut::<f64>(out, m, p);
+    faer_matmul(acc, lhs, rhs, keep.then_some(1.0), beta, Parallelism::Rayon(0));
+}
+
+/// Matrix multiplication with size-based dispatch
+///
+/// Small and medium products use `RealTensor::matmul` (blocked, threaded);
+/// large ones are handed to faer's parallel GEMM without copying the
+/// operands.
+///
+/// # Example
+/// ```
+/// use achronyme_linalg::matmul;
+/// use achronyme_types::tensor::RealTensor;
+///
+/// let a = RealTensor::matrix(2, 2, vec![1.0, 2.0, 3.0, 4.0]).unwrap();
+/// let b = RealTensor::eye(2);
+/// let c = matmul(&a, &b).unwrap();
+/// assert_eq!(c.data(), a.data());
+/// ```
+pub fn matmul(a: &RealTensor, b: &RealTensor) -> Result<RealTensor, String> {
+    let Some(dims) = faer_dims(a.shape(), b.shape()) else {
+        return a.matmul(b).map_err(|e| e.to_string());
+    };
+    let (m, _, p) = dims;
+
+    let mut data = vec![0.0; m * p];
+    gemm(&mut data, a.data(), b.data(), dims, false, 1.0);
+    RealTensor::matrix(m, p, data).map_err(|e| e.to_string())
+}
+
+/// Complex matrix multiplication with size-based dispatch
+///
+/// Large products are split into real and imaginary planes and computed
+/// as four real GEMMs on faer:
+/// re = Ar·Br − Ai·Bi, im = Ar·Bi + Ai·Br.
+pub fn matmul_complex(a: &ComplexTensor, b: &ComplexTensor) -> Result<ComplexTensor, String> {
+    let Some(dims) = faer_dims(a.shape(), b.shape()) else {
+        return a.matmul(b).map_err(|e| e.to_string());
+    };
+    let (m, _, p) = dims;
+
+    let (a_re, a_im): (Vec<f64>, Vec<f64>) = a.data().iter().map(|c| (c.re, c.im)).unzip();
+    let (b_re, b_im): (Vec<f64>, Vec<f64>) = b.data().iter().map(|c| (c.re, c.im)).unzip();
+
+    let mut re = vec![0.0; m * p];
+    gemm(&mut re, &a_re, &b_re, dims, false, 1.0);
+    gemm(&mut re, &a_im, &b_im, dims, true, -1.0);
+
+    let mut im = vec![0.0; m * p];
+    gemm(&mut im, &a_re, &b_im, dims, false, 1.0);
+    gemm(&mut im, &a_im, &b_re, dims, true, 1.0);
+
+    let data = re.into_iter().zip(im).map(|(re, im)| Complex::new(re, im)).collect();
+    ComplexTensor::new(data, vec![m, p]).map_err(|e| e.to_string())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use approx::assert_relative_eq;
+
+    #[test]
+    fn test_matmul_small_uses_tensor_kernel() {
+        let a = RealTensor::matrix(2, 3, vec![1.0, 2.0, 3.0, 4.0, 5.0, 6.0]).unwrap();
+        let b = RealTensor::matrix(3, 2, vec![7.0, 8.0, 9.0, 10.0, 11.0, 12.0]).unwrap();
+
+        let c = matmul(&a, &b).unwrap();
+        assert_eq!(c.shape(), &[2, 2]);
+        assert_eq!(c.data(), &[58.0, 64.0, 139.0, 154.0]);
+    }
+
+    #[test]
+    fn test_matmul_dimension_mismatch() {
+        let a = RealTensor::matrix(2, 3, vec![0.0; 6]).unwrap();
+        assert!(matmul(&a, &a).is_err());
+        assert!(matmul(&a, &RealTensor::vector(vec![1.0, 2.0, 3.0])).is_err());
+    }
+
+    #[test]
+    fn test_faer_gemm_matches_kernel() {
+        let (m, n, p) = (5, 7, 3);
+        let a: Vec<f64> = (0..m * n).map(|i| (i % 9) as f64 - 4.0).collect();
+        let b: Vec<f64> = (0..n * p).map(|i| (i % 5) as f64 * 0.5).collect();
+
+        let mut out = vec![0.0; m * p];
+        gemm(&mut out, &a, &b, (m, n, p), false, 1.0);
+
+        let expected = RealTensor::matrix(m, n, a).unwrap()
+            .matmul(&RealTensor::matrix(n, p, b).unwrap())
+            .unwrap();
+        for (x, y) in out.iter().zip(expected.data()) {
+            assert_relative_eq!(*x, *y, epsilon = 1e-12);
+        }
+    }
+
+    #[test]
+    fn test_matmul_large_dispatches_to_faer() {
+        // Just above the threshold, so the faer path runs
+        let n = 257;
+        let a: Vec<f64> = (0..n * n).map(|i| ((i * 3) % 7) as f64 - 3.0).collect();
+        let b: Vec<f64> = (0..n * n).map(|i| ((i * 5) % 11) as f64 - 5.0).collect();
+        let a = RealTensor::matrix(n, n, a).unwrap();
+        let b = RealTensor::matrix(n, n, b).unwrap();
+        assert!(n * n * n >= FAER_MATMUL_THRESHOLD);
+
+        let fast = matmul(&a, &b).unwrap();
+        let reference = a.matmul(&b).unwrap();
+        for (x, y) in fast.data().iter().zip(reference.data()) {
+            assert_relative_eq!(*x, *y, epsilon = 1e-9);
+        }
+    }
+
+    #[test]
+    fn test_matmul_complex_small() {
+        let a = ComplexTensor::new(
+            vec![Complex::new(1.0, 1.0), Complex::new(0.0, 2.0)],
+            vec![1, 2],
+        ).unwrap();
+        let b = ComplexTensor::new(
+            vec![Complex::new(2.0, 0.0), Complex::new(0.0, 1.0)],
+            vec![2, 1],
+        ).unwrap();
+
+        let c = matmul_complex(&a, &b).unwrap();
+        assert_eq!(c.data(), &[Complex::new(0.0, 2.0)]);
+    }
+}
@@ -1,41 +1,7 @@
 use achronyme_types::tensor::RealTensor;
-use faer::prelude::*;
 
-/// Convert Achronyme RealTensor (matrix) to faer Mat
-fn tensor_to_faer_mat(tensor: &RealTensor) -> Mat<f64> {
-    assert!(tensor.is_matrix());
-    let rows = tensor.rows();
-    let cols = tensor.cols();
-    Mat::from_fn(rows, cols, |i, j| tensor.get_matrix(i, j).unwrap())
-}
-
-/// Convert faer Mat to Achronyme RealTensor (matrix)
-fn faer_mat_to_tensor(mat: Mat<f64>) -> Result<RealTensor, String> {
-    let rows = mat.nrows();
-    let cols = mat.ncols();
-    let mut data = Vec::with_capacity(rows * cols);
-
-    for i in 0..rows {
-        for j in 0..cols {
-            data.push(mat.read(i, j));
-        }
-    }
-
-    RealTensor::matrix(rows, cols, data).map_err(|e| e.to_string())
-}
-
-/// Convert Achronyme RealTensor (vector) to faer Col
-fn tensor_to_faer_col(tensor: &RealTensor) -> Col<f64> {
-    assert!(tensor.is_vector());
-    let data = tensor.data();
-    Col::from_fn(data.len(), |i| data[i])
-}
-
-/// Convert faer Col to Achronyme RealTensor (vector)
-fn faer_col_to_tensor(col: Col<f64>) -> RealTensor {
-    let data: Vec<f64> = (0..col.nrows()).map(|i| col.read(i)).collect();
-    RealTensor::vector(data)
-}
+use crate::factorizations::lu;
+use crate::interop::mat_view;
 
 /// Compute determinant of a square matrix (NxN)
 ///
@@ -65,43 +31,8 @@ pub fn determinant_nd(tensor: &RealTensor) -> Result<f64, String> {
         return Err("Determinant requires square matrix".to_string());
     }
 
-    let mat = tensor_to_faer_mat(tensor);
-
-    // Use LU decomposition to compute determinant
-    let lu = mat.partial_piv_lu();
-
-    // Compute determinant from LU: det(A) = det(P) * det(L) * det(U)
-    // det(L) = 1 (unit diagonal), det(U) = product of diagonal elements
-    let u = lu.compute_u();
-    let mut det = 1.0;
-    for i in 0..u.nrows() {
-        det *= u.read(i, i);
-    }
-
-    // Account for permutation sign
-    // Count number of swaps to determine sign
-    let perm = lu.row_permutation();
-    let perm_indices = perm.arrays().0;
-    let mut swaps = 0;
-    let mut visited = vec![false; perm_indices.len()];
-
-    for i in 0..perm_indices.len() {
-        if !visited[i] && perm_indices[i] != i {
-            let mut j = i;
-            while !visited[j] {
-                visited[j] = true;
-                j = perm_indices[j];
-                swaps += 1;
-            }
-            swaps -= 1; // Each cycle of length n requires n-1 swaps
-        }
-    }
-
-    if swaps % 2 == 1 {
-        det = -det;
-    }
-
-    Ok(det)
+    // det(A) = det(P) * det(L) * det(U), with det(L) = 1
+    Ok(lu(tensor)?.determinant())
 }
 
 /// Compute the inverse of a square matrix
@@ -131,25 +62,19 @@ pub fn inverse(tensor: &RealTensor) -> Result<RealTensor, String> {
         return Err("Inverse requires square matrix".to_string());
     }
 
-    let mat = tensor_to_faer_mat(tensor);
-    let n = mat.nrows();
-
-    // Create identity matrix
-    let identity = Mat::<f64>::identity(n, n);
-
     // Solve A * X = I to get X = A^(-1)
-    let lu = mat.partial_piv_lu();
-    let inv = lu.solve(&identity);
-
-    faer_mat_to_tensor(inv)
+    lu(tensor)?.inverse()
 }
 
 /// Solve a linear system Ax = b
 ///
 /// Finds vector x that satisfies A * x = b
 ///
+/// Factors `a` on every call; to solve many right-hand sides against the
+/// same matrix, factor it once with [`lu`](crate::lu) and reuse the result.
+///
 /// # Arguments
-/// * `a` - Coefficient matrix (m x n rank-2 tensor)
+/// * `a` - Square coefficient matrix (rank-2 tensor)
 /// * `b` - Right-hand side vector (rank-1 tensor)
 ///
 /// # Returns
@@ -165,7 +90,7 @@ pub fn inverse(tensor: &RealTensor) -> Result<RealTensor, String> {
 ///     1.0, 2.0
 /// ]).unwrap();
 ///
-/// let b = RealTensor::vector(vec![9.0, 8.0]).unwrap();
+/// let b = RealTensor::vector(vec![9.0, 8.0]);
 ///
 /// let x = solve_system(&a, &b).unwrap();
 /// // x should be [2.0, 3.0]
@@ -182,14 +107,8 @@ pub fn solve_system(a: &RealTensor, b: &RealTensor) -> Result<RealTensor, String
         ));
     }
 
-    let a_mat = tensor_to_faer_mat(a);
-    let b_col = tensor_to_faer_col(b);
-
     // Use LU decomposition to solve the system
-    let lu = a_mat.partial_piv_lu();
-    let x = lu.solve(&b_col);
-
-    Ok(faer_col_to_tensor(x))
+    lu(a)?.solve(b)
 }
 
 /// Check if a matrix is symmetric within a tolerance
@@ -232,10 +151,11 @@ pub fn is_positive_definite(tensor: &RealTensor) -> bool {
         return false;
     }
 
-    let mat = tensor_to_faer_mat(tensor);
-
     // Try Cholesky decomposition
-    mat.cholesky(faer::Side::Lower).is_ok()
+    match mat_view(tensor) {
+        Ok(mat) => mat.cholesky(faer::Side::Lower).is_ok(),
+        Err(_) => false,
+    }
 }
 
 #[cfg(test)]
@@ -1,4 +1,6 @@
-#[derive(Debug, Clone, PartialEq)]
+use serde::{Deserialize, Serialize};
+
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum BinaryOp {
     // Arithmetic
     Add,
@@ -21,7 +23,7 @@ pub enum BinaryOp {
     Or,  // ||
 }
 
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum UnaryOp {
     Negate, // -x
     Not,    // !x
@@ -29,8 +31,9 @@ pub enum UnaryOp {
 
 // Import TypeAnnotation from local module (avoids circular dependency)
 use crate::type_annotation::TypeAnnotation;
+use crate::symbol::Symbol;
 
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum AstNode {
     Number(f64),
     Boolean(bool),
@@ -90,7 +93,7 @@ pub enum AstNode {
     Return {
         value: Box<AstNode>,  // Expression to return
     },
-    VariableRef(String),
+    VariableRef(Symbol),
     SelfReference, // 'self' keyword for use in records
     RecReference,  // 'rec' keyword for recursive function calls
     /// Lambda with optional type annotations (gradual typing)
@@ -102,8 +105,8 @@ pub enum AstNode {
         body: Box<AstNode>,
     },
     Edge {
-        from: String,
-        to: String,
+        from: Symbol,
+        to: Symbol,
         directed: bool,
         metadata: Option<Box<AstNode>>,
     },
@@ -183,17 +186,26 @@ pub enum AstNode {
         value: Box<AstNode>,
         arms: Vec<MatchArm>,
     },
+    // Variable reference resolved to a slot of the enclosing function call:
+    // the binding at `index` of the scope `depth` levels above the reference.
+    // Never produced by the parser; the evaluator resolves lambda bodies into
+    // it when the lambda is created (kept last so serialized ASTs stay stable)
+    LocalRef {
+        name: Symbol,
+        depth: u32,
+        index: u32,
+    },
 }
 
 /// Represents an array element - can be a single expression or a spread expression
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum ArrayElement {
     Single(AstNode),        // Regular element: expr
     Spread(Box<AstNode>),   // Spread element: ...expr
 }
 
 /// Represents a record field or spread expression
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum RecordFieldOrSpread {
     Field { name: String, value: AstNode },         // Immutable field: key: value
     MutableField { name: String, value: AstNode },  // Mutable field: mut key: value
@@ -201,7 +213,7 @@ pub enum RecordFieldOrSpread {
 }
 
 /// Represents an indexing argument - can be a single expression or a range
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum IndexArg {
     Single(Box<AstNode>),  // Single index: tensor[5]
     Range {                // Range slice: tensor[1..5], tensor[..5], tensor[1..], tensor[..]
@@ -212,7 +224,7 @@ pub enum IndexArg {
 
 /// Represents an import item - can be a simple identifier or an aliased import
 /// Examples: foo, foo as bar
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct ImportItem {
     pub name: String,           // The original name in the module
     pub alias: Option<String>,  // Optional alias (for "as" imports)
@@ -227,7 +239,7 @@ impl ImportItem {
 
 /// Pattern for pattern matching
 /// Used in match expressions to destructure and test values
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum Pattern {
     /// Literal pattern: matches exact values (42, "hello", true)
     Literal(LiteralPattern),
@@ -253,7 +265,7 @@ pub enum Pattern {
 }
 
 /// Literal pattern variants
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum LiteralPattern {
     Number(f64),
     String(String),
@@ -261,7 +273,7 @@ pub enum LiteralPattern {
 }
 
 /// Vector pattern element: either a pattern or a rest pattern
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum VectorPatternElement {
     /// Regular pattern element
     Pattern(Pattern),
@@ -270,7 +282,7 @@ pub enum VectorPatternElement {
 }
 
 /// Match arm: a single case in a match expression
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct MatchArm {
     pub pattern: Pattern,
     pub guard: Option<Box<AstNode>>,  // Optional if condition
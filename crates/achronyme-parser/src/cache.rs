@@ -0,0 +1,311 @@
+//! Parse cache
+//!
+//! `ParseCache` keeps the AST of every source it has parsed, keyed by a hash
+//! of the source text, so re-parsing the same program (a module imported
+//! again, a service evaluating the same template) is a hash lookup. ASTs are
+//! handed out as `Arc<Vec<AstNode>>` and shared between callers; cloning the
+//! cache shares them too, so a cache warmed on one thread can seed
+//! evaluators on others.
+//!
+//! With a disk directory set, misses also look for a serialized AST written
+//! by an earlier process before parsing, so cold starts skip the parser too.
+//! The disk cache is best-effort: unreadable, stale or corrupt files are
+//! treated as misses, and write failures are ignored.
+
+use serde::{Deserialize, Serialize};
+use std::collections::{HashMap, VecDeque};
+use std::fs;
+use std::path::{Path, PathBuf};
+use std::sync::Arc;
+
+use crate::ast::AstNode;
+use crate::{fast_parser, pest_parser};
+
+/// Sources kept in memory before the oldest is evicted
+const DEFAULT_CAPACITY: usize = 256;
+
+/// Version of the on-disk entry layout
+const DISK_FORMAT_VERSION: u32 = 1;
+
+/// Extension of on-disk entries
+const DISK_EXTENSION: &str = "ast";
+
+/// Content-hash keyed cache of parsed programs
+#[derive(Debug, Clone)]
+pub struct ParseCache {
+    entries: HashMap<u64, Entry>,
+    /// Hashes in insertion order, oldest first
+    order: VecDeque<u64>,
+    capacity: usize,
+    disk_dir: Option<PathBuf>,
+    hits: usize,
+    misses: usize,
+}
+
+#[derive(Debug, Clone)]
+struct Entry {
+    /// Kept to tell hash collisions apart from hits
+    source: Arc<str>,
+    statements: Arc<Vec<AstNode>>,
+}
+
+/// On-disk entry, as written
+#[derive(Serialize)]
+struct DiskEntryRef<'a> {
+    format: u32,
+    parser_version: &'a str,
+    source: &'a str,
+    statements: &'a [AstNode],
+}
+
+/// On-disk entry, as read back
+#[derive(Deserialize)]
+struct DiskEntry {
+    format: u32,
+    parser_version: String,
+    source: String,
+    statements: Vec<AstNode>,
+}
+
+impl ParseCache {
+    /// Create an in-memory cache with the default capacity
+    pub fn new() -> Self {
+        Self::with_capacity(DEFAULT_CAPACITY)
+    }
+
+    /// Create an in-memory cache holding at most `capacity` sources
+    pub fn with_capacity(capacity: usize) -> Self {
+        Self {
+            entries: HashMap::new(),
+            order: VecDeque::new(),
+            capacity: capacity.max(1),
+            disk_dir: None,
+            hits: 0,
+            misses: 0,
+        }
+    }
+
+    /// Also persist parsed ASTs under `dir` (created on first write), or
+    /// stop using the disk with `None`
+    pub fn set_disk_cache(&mut self, dir: Option<PathBuf>) {
+        self.disk_dir = dir;
+    }
+
+    /// Directory of the on-disk cache, if enabled
+    pub fn disk_cache(&self) -> Option<&Path> {
+        self.disk_dir.as_deref()
+    }
+
+    /// Parse `source`, reusing a cached AST when the same text was parsed
+    /// before
+    ///
+    /// Parse errors are not cached.
+    pub fn parse(&mut self, source: &str) -> Result<Arc<Vec<AstNode>>, String> {
+        let hash = content_hash(source);
+
+        if let Some(entry) = self.entries.get(&hash) {
+            if &*entry.source == source {
+                self.hits += 1;
+                return Ok(Arc::clone(&entry.statements));
+            }
+        }
+        self.misses += 1;
+
+        let statements = match self.read_disk(hash, source) {
+            Some(statements) => statements,
+            None => {
+                let statements = parse_source(source)?;
+                self.write_disk(hash, source, &statements);
+                statements
+            }
+        };
+
+        let statements = Arc::new(statements);
+        self.insert(hash, source, Arc::clone(&statements));
+        Ok(statements)
+    }
+
+    /// Number of sources held in memory
+    pub fn len(&self) -> usize {
+        self.entries.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.entries.is_empty()
+    }
+
+    /// Lookups answered from memory
+    pub fn hits(&self) -> usize {
+        self.hits
+    }
+
+    /// Lookups that had to read the disk cache or parse
+    pub fn misses(&self) -> usize {
+        self.misses
+    }
+
+    /// Drop every in-memory entry (the disk cache is left alone)
+    pub fn clear(&mut self) {
+        self.entries.clear();
+        self.order.clear();
+    }
+
+    fn insert(&mut self, hash: u64, source: &str, statements: Arc<Vec<AstNode>>) {
+        let entry = Entry { source: source.into(), statements };
+        if self.entries.insert(hash, entry).is_some() {
+            // Hash collision replaced the old source; its order slot is reused
+            return;
+        }
+        self.order.push_back(hash);
+        while self.order.len() > self.capacity {
+            if let Some(oldest) = self.order.pop_front() {
+                self.entries.remove(&oldest);
+            }
+        }
+    }
+
+    fn disk_path(&self, hash: u64) -> Option<PathBuf> {
+        self.disk_dir
+            .as_ref()
+            .map(|dir| dir.join(format!("{:016x}.{}", hash, DISK_EXTENSION)))
+    }
+
+    fn read_disk(&self, hash: u64, source: &str) -> Option<Vec<AstNode>> {
+        let bytes = fs::read(self.disk_path(hash)?).ok()?;
+        let entry: DiskEntry = rmp_serde::from_slice(&bytes).ok()?;
+        let current = entry.format == DISK_FORMAT_VERSION
+            && entry.parser_version == env!("CARGO_PKG_VERSION")
+            && entry.source == source;
+        current.then_some(entry.statements)
+    }
+
+    fn write_disk(&self, hash: u64, source: &str, statements: &[AstNode]) {
+        let path = match self.disk_path(hash) {
+            Some(path) => path,
+            None => return,
+        };
+        let entry = DiskEntryRef {
+            format: DISK_FORMAT_VERSION,
+            parser_version: env!("CARGO_PKG_VERSION"),
+            source,
+            statements,
+        };
+        let bytes = match rmp_serde::to_vec(&entry) {
+            Ok(bytes) => bytes,
+            Err(_) => return,
+        };
+
+        // Write then rename, so a concurrent reader never sees half a file
+        let tmp = path.with_extension(format!("{}.{}.tmp", DISK_EXTENSION, std::process::id()));
+        let written = path
+            .parent()
+            .map_or(Ok(()), fs::create_dir_all)
+            .and_then(|_| fs::write(&tmp, &bytes))
+            .and_then(|_| fs::rename(&tmp, &path));
+        if written.is_err() {
+            let _ = fs::remove_file(&tmp);
+        }
+    }
+}
+
+impl Default for ParseCache {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+/// Parse with the hand-written parser; on failure the Pest parser has the
+/// final say, so error messages (and any input the two disagree on) are the
+/// reference grammar's
+fn parse_source(source: &str) -> Result<Vec<AstNode>, String> {
+    fast_parser::parse(source).or_else(|_| pest_parser::parse(source))
+}
+
+/// 64-bit FNV-1a hash of the source text
+///
+/// Stable across processes and Rust versions, so it can name disk entries.
+pub fn content_hash(source: &str) -> u64 {
+    const OFFSET_BASIS: u64 = 0xcbf2_9ce4_8422_2325;
+    const PRIME: u64 = 0x0000_0100_0000_01b3;
+
+    source.bytes().fold(OFFSET_BASIS, |hash, byte| (hash ^ byte as u64).wrapping_mul(PRIME))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_repeated_source_shares_ast() {
+        let mut cache = ParseCache::new();
+        let first = cache.parse("let x = 2 + 3 * 4").unwrap();
+        let second = cache.parse("let x = 2 + 3 * 4").unwrap();
+
+        assert!(Arc::ptr_eq(&first, &second));
+        assert_eq!((cache.hits(), cache.misses()), (1, 1));
+        assert_eq!(*first, pest_parser::parse("let x = 2 + 3 * 4").unwrap());
+    }
+
+    #[test]
+    fn test_parse_errors_are_not_cached() {
+        let mut cache = ParseCache::new();
+        assert!(cache.parse("let = ").is_err());
+        assert!(cache.parse("let = ").is_err());
+        assert!(cache.is_empty());
+        assert_eq!(cache.misses(), 2);
+    }
+
+    #[test]
+    fn test_capacity_evicts_oldest() {
+        let mut cache = ParseCache::with_capacity(2);
+        let one = cache.parse("1").unwrap();
+        cache.parse("2").unwrap();
+        cache.parse("3").unwrap();
+
+        assert_eq!(cache.len(), 2);
+        assert!(!Arc::ptr_eq(&one, &cache.parse("1").unwrap()));
+        assert!(Arc::ptr_eq(&cache.parse("3").unwrap(), &cache.parse("3").unwrap()));
+    }
+
+    #[test]
+    fn test_disk_cache_round_trip() {
+        let dir = std::env::temp_dir().join(format!("achronyme-parse-cache-{}", std::process::id()));
+        let source = "let f = (x: Number): Number => x^2\nmatch f(3) { 9 => \"nine\", _ => [1, ...[2]] }";
+
+        let mut writer = ParseCache::new();
+        writer.set_disk_cache(Some(dir.clone()));
+        let parsed = writer.parse(source).unwrap();
+        let file = dir.join(format!("{:016x}.{}", content_hash(source), DISK_EXTENSION));
+        assert!(file.exists());
+
+        // A fresh cache (new process) reads the serialized AST back
+        let mut reader = ParseCache::new();
+        reader.set_disk_cache(Some(dir.clone()));
+        assert_eq!(reader.read_disk(content_hash(source), source).as_ref(), Some(&*parsed));
+        assert_eq!(*reader.parse(source).unwrap(), *parsed);
+
+        // A file for another source under the same name is ignored
+        assert_eq!(reader.read_disk(content_hash(source), "let y = 1"), None);
+
+        fs::remove_dir_all(&dir).unwrap();
+    }
+
+    #[test]
+    fn test_clone_shares_asts_across_threads() {
+        let mut cache = ParseCache::new();
+        let warm = cache.parse("let f = x => x + 1").unwrap();
+
+        let mut copy = cache.clone();
+        let shared = std::thread::spawn(move || copy.parse("let f = x => x + 1").unwrap())
+            .join()
+            .unwrap();
+        assert!(Arc::ptr_eq(&warm, &shared));
+    }
+
+    #[test]
+    fn test_content_hash_is_stable() {
+        assert_eq!(content_hash(""), 0xcbf2_9ce4_8422_2325);
+        assert_eq!(content_hash("a"), 0xaf63_dc4c_8601_ec8c);
+        assert_ne!(content_hash("x + 1"), content_hash("x + 2"));
+    }
+}
@@ -0,0 +1,586 @@
+// Binary operators are parsed by a single Pratt loop over the precedence
+// levels of the grammar's rule chain (logical_or > logical_and > comparison >
+// edge > additive > multiplicative); unary, power and postfix_expression
+// below them keep their own rules.
+
+use super::{Built, FastParser};
+use crate::ast::{AstNode, BinaryOp, IndexArg, UnaryOp};
+use crate::symbol::Symbol;
+
+fn binary(op: BinaryOp, left: Built, right: Built) -> Built {
+    Ok(AstNode::BinaryOp {
+        op,
+        left: Box::new(left?),
+        right: Box::new(right?),
+    })
+}
+
+/// Precedence level of a binary operator, loosest first
+#[derive(Debug, Clone, Copy, PartialEq, Eq, PartialOrd, Ord)]
+enum Level {
+    LogicalOr,
+    LogicalAnd,
+    Comparison,
+    Edge,
+    Additive,
+    Multiplicative,
+    /// A unary expression: binds tighter than every binary operator
+    Operand,
+}
+
+impl Level {
+    /// Levels in the order the grammar tries their operators after an
+    /// operand: the innermost rule's loop first
+    const INNER_FIRST: [Level; 6] = [
+        Level::Multiplicative,
+        Level::Additive,
+        Level::Edge,
+        Level::Comparison,
+        Level::LogicalAnd,
+        Level::LogicalOr,
+    ];
+
+    /// The next tighter level: what the right operand is parsed at
+    fn tighter(self) -> Level {
+        match self {
+            Level::LogicalOr => Level::LogicalAnd,
+            Level::LogicalAnd => Level::Comparison,
+            Level::Comparison => Level::Edge,
+            Level::Edge => Level::Additive,
+            Level::Additive => Level::Multiplicative,
+            Level::Multiplicative | Level::Operand => Level::Operand,
+        }
+    }
+
+    /// Whether an operator of this level can take `left`, whose topmost
+    /// operator is at `left_level`, as its left operand
+    ///
+    /// `comparison` and `edge` match at most once (`a ~ (op ~ b)?`), so they
+    /// need a strictly tighter left operand; the other levels are
+    /// left-associative repetitions.
+    fn accepts(self, left_level: Level) -> bool {
+        match self {
+            Level::Comparison | Level::Edge => left_level > self,
+            _ => left_level >= self,
+        }
+    }
+}
+
+impl<'a> FastParser<'a> {
+    /// expr = { logical_or }
+    pub(crate) fn expr(&mut self) -> Option<Built> {
+        self.rule("expr", |p| p.binary_expr(Level::LogicalOr))
+    }
+
+    /// Expression whose operators are all at `min` or tighter
+    ///
+    /// Equivalent to the rule of that level in the grammar: after each
+    /// operand the operators of the open levels are tried innermost first,
+    /// and an operator whose right operand fails to parse is backtracked so
+    /// the next level can try, exactly like the nested `(op ~ operand)*`
+    /// repetitions do.
+    fn binary_expr(&mut self, min: Level) -> Option<Built> {
+        let start = self.pos;
+        let mut left = self.unary()?;
+        let mut left_level = Level::Operand;
+
+        'operators: loop {
+            let save = self.pos;
+            self.skip();
+            let op_start = self.pos;
+
+            for level in Level::INNER_FIRST {
+                if level < min {
+                    break;
+                }
+                if !level.accepts(left_level) {
+                    continue;
+                }
+                self.pos = op_start;
+
+                if level == Level::Edge {
+                    match self.edge_tail(start, save, left) {
+                        Ok(edge) => left = edge,
+                        Err(from) => {
+                            left = from;
+                            continue;
+                        }
+                    }
+                } else {
+                    let op = match self.binary_op(level) {
+                        Some(op) => op,
+                        None => continue,
+                    };
+                    self.skip();
+                    match self.binary_expr(level.tighter()) {
+                        Some(right) => left = binary(op, left, right),
+                        None => continue,
+                    }
+                }
+
+                left_level = level;
+                continue 'operators;
+            }
+
+            self.pos = save;
+            return Some(left);
+        }
+    }
+
+    /// Operator of a left-associative or comparison level
+    fn binary_op(&mut self, level: Level) -> Option<BinaryOp> {
+        match level {
+            Level::LogicalOr => self.logical_or_op(),
+            Level::LogicalAnd => self.logical_and_op(),
+            Level::Comparison => self.cmp_op(),
+            Level::Additive => self.add_op(),
+            Level::Multiplicative => self.mult_op(),
+            Level::Edge | Level::Operand => None,
+        }
+    }
+
+    fn logical_or_op(&mut self) -> Option<BinaryOp> {
+        self.rule("logical_or_op", |p| p.expect("||").map(|_| BinaryOp::Or))
+    }
+
+    fn logical_and_op(&mut self) -> Option<BinaryOp> {
+        self.rule("logical_and_op", |p| p.expect("&&").map(|_| BinaryOp::And))
+    }
+
+    /// cmp_op = { "==" | "!=" | ">=" | "<=" | ">" | "<" }
+    fn cmp_op(&mut self) -> Option<BinaryOp> {
+        self.rule("cmp_op", |p| {
+            let op = match (p.peek()?, p.peek_at(1)) {
+                (b'=', Some(b'=')) => BinaryOp::Eq,
+                (b'!', Some(b'=')) => BinaryOp::Neq,
+                (b'>', Some(b'=')) => BinaryOp::Gte,
+                (b'<', Some(b'=')) => BinaryOp::Lte,
+                (b'>', _) => BinaryOp::Gt,
+                (b'<', _) => BinaryOp::Lt,
+                _ => return None,
+            };
+            p.pos += if matches!(op, BinaryOp::Gt | BinaryOp::Lt) { 1 } else { 2 };
+            Some(op)
+        })
+    }
+
+    /// The `(edge_op ~ additive ~ (":" ~ additive)?)?` tail of
+    /// edge = { additive ~ (edge_op ~ additive ~ (":" ~ additive)?)? }
+    ///
+    /// `from` spans `from_start..from_end`. Gives `from` back if no edge
+    /// follows.
+    fn edge_tail(&mut self, from_start: usize, from_end: usize, from: Built) -> Result<Built, Built> {
+        let op_start = self.pos;
+        let directed = match self.edge_op() {
+            Some(directed) => directed,
+            None => return Err(from),
+        };
+        self.skip();
+        let to_start = self.pos;
+        let to = match self.binary_expr(Level::Additive) {
+            Some(to) => to,
+            None => {
+                self.pos = op_start;
+                return Err(from);
+            }
+        };
+        let to_end = self.pos;
+
+        let save = self.pos;
+        self.skip();
+        let metadata = if self.eat(":") {
+            self.skip();
+            match self.binary_expr(Level::Additive) {
+                Some(meta) => Some(meta),
+                None => {
+                    self.pos = save;
+                    None
+                }
+            }
+        } else {
+            self.pos = save;
+            None
+        };
+        let end = self.pos;
+
+        // Edge endpoints must be bare identifiers; this is a build-time
+        // check in the Pest pipeline, evaluated in the same order.
+        let from = self.edge_endpoint(from_start, from_end, from);
+        let to = self.edge_endpoint(to_start, to_end, to);
+        self.pos = end;
+
+        Ok((|| {
+            let from = from?;
+            let to = to?;
+            let metadata = match metadata {
+                Some(meta) => Some(Box::new(meta?)),
+                None => None,
+            };
+            Ok(AstNode::Edge { from: Symbol::intern(&from), to: Symbol::intern(&to), directed, metadata })
+        })())
+    }
+
+    /// edge_op = { "->" | "<>" }
+    fn edge_op(&mut self) -> Option<bool> {
+        self.rule("edge_op", |p| {
+            if p.eat("->") {
+                Some(true)
+            } else if p.eat("<>") {
+                Some(false)
+            } else {
+                None
+            }
+        })
+    }
+
+    /// Mirror of `extract_identifier`: descend through single-child rules
+    /// (unary operators included) down to the primary.
+    fn edge_endpoint(&mut self, start: usize, end: usize, built: Built) -> Built<String> {
+        built?;
+
+        self.pos = start;
+        loop {
+            if self.peek() == Some(b'-') || self.peek() == Some(b'!') {
+                let save = self.pos;
+                self.pos += 1;
+                self.skip();
+                if self.unary_starts_here() {
+                    continue;
+                }
+                self.pos = save;
+            }
+            break;
+        }
+
+        let kind = self.primary_kind();
+        if self.pos != end {
+            return Err("Edge nodes must be simple identifiers, not expressions".to_string());
+        }
+        match kind {
+            Some(("identifier", name)) => Ok(name.to_string()),
+            Some((rule, _)) => Err(format!("Edge nodes must be identifiers, got: {}", rule)),
+            None => Err("Edge nodes must be simple identifiers, not expressions".to_string()),
+        }
+    }
+
+    /// Whether a `unary` can be parsed at the current position (used only to
+    /// replay the structure of an already matched edge endpoint)
+    fn unary_starts_here(&mut self) -> bool {
+        let save = self.pos;
+        let ok = self.unary().is_some();
+        self.pos = save;
+        ok
+    }
+
+    fn add_op(&mut self) -> Option<BinaryOp> {
+        self.rule("add_op", |p| match p.peek()? {
+            b'+' => {
+                p.pos += 1;
+                Some(BinaryOp::Add)
+            }
+            b'-' => {
+                p.pos += 1;
+                Some(BinaryOp::Subtract)
+            }
+            _ => None,
+        })
+    }
+
+    fn mult_op(&mut self) -> Option<BinaryOp> {
+        self.rule("mult_op", |p| {
+            let op = match p.peek()? {
+                b'*' => BinaryOp::Multiply,
+                b'/' => BinaryOp::Divide,
+                b'%' => BinaryOp::Modulo,
+                _ => return None,
+            };
+            p.pos += 1;
+            Some(op)
+        })
+    }
+
+    /// unary = { "-" ~ unary | "!" ~ unary | power }
+    fn unary(&mut self) -> Option<Built> {
+        self.rule("unary", |p| {
+            let op = match p.peek() {
+                Some(b'-') => Some(UnaryOp::Negate),
+                Some(b'!') => Some(UnaryOp::Not),
+                _ => None,
+            };
+            if let Some(op) = op {
+                let save = p.pos;
+                p.pos += 1;
+                p.skip();
+                if let Some(operand) = p.unary() {
+                    return Some(operand.map(|operand| AstNode::UnaryOp { op, operand: Box::new(operand) }));
+                }
+                p.pos = save;
+            }
+            p.power()
+        })
+    }
+
+    /// power = { postfix_expression ~ ("^" ~ power)? }  (right-associative)
+    fn power(&mut self) -> Option<Built> {
+        self.rule("power", |p| {
+            let base = p.postfix_expression()?;
+            let save = p.pos;
+            p.skip();
+            if p.eat("^") {
+                p.skip();
+                if let Some(exponent) = p.power() {
+                    return Some(binary(BinaryOp::Power, base, exponent));
+                }
+            }
+            p.pos = save;
+            Some(base)
+        })
+    }
+
+    /// postfix_expression = { primary ~ postfix_op* }
+    pub(crate) fn postfix_expression(&mut self) -> Option<Built> {
+        if let Some((start, _, _)) = self.postfix_memo {
+            if start == self.pos {
+                let (_, end, built) = self.postfix_memo.take().unwrap();
+                self.pos = end;
+                return Some(built);
+            }
+        }
+
+        self.rule("postfix_expression", |p| {
+            let mut ast = p.primary()?;
+            loop {
+                let save = p.pos;
+                p.skip();
+                match p.postfix_op(ast) {
+                    Ok(next) => ast = next,
+                    Err(prev) => {
+                        p.pos = save;
+                        return Some(prev);
+                    }
+                }
+            }
+        })
+    }
+
+    /// postfix_op = { call_op | index_op | field_op }
+    ///
+    /// Returns the extended expression, or gives the operand back if no
+    /// operator matched.
+    fn postfix_op(&mut self, ast: Built) -> Result<Built, Built> {
+        let start = self.pos;
+        let result = match self.peek() {
+            Some(b'(') => match self.call_op() {
+                Some(args) => Ok(Self::apply_call(ast, args)),
+                None => Err(ast),
+            },
+            Some(b'[') => match self.index_op() {
+                Some(indices) => Ok((|| {
+                    Ok(AstNode::IndexAccess {
+                        object: Box::new(ast?),
+                        indices: indices?,
+                    })
+                })()),
+                None => Err(ast),
+            },
+            Some(b'.') => match self.field_op() {
+                Some(field) => Ok(ast.map(|record| AstNode::FieldAccess {
+                    record: Box::new(record),
+                    field: field.to_string(),
+                })),
+                None => Err(ast),
+            },
+            _ => Err(ast),
+        };
+        if result.is_err() {
+            self.pos = start;
+            self.rule::<()>("postfix_op", |_| None);
+        }
+        result
+    }
+
+    /// Build a call, converting the functional `if(c, a, b)` and
+    /// `piecewise(...)` forms like `build_postfix_expression`
+    fn apply_call(callee: Built, args: Built<Vec<AstNode>>) -> Built {
+        let callee = callee?;
+        let args = args?;
+
+        if let AstNode::VariableRef(ref name) = callee {
+            if name == "if" {
+                if args.len() != 3 {
+                    return Err(format!("if() requires 3 arguments, got {}", args.len()));
+                }
+                let mut args = args.into_iter();
+                return Ok(AstNode::If {
+                    condition: Box::new(args.next().unwrap()),
+                    then_expr: Box::new(args.next().unwrap()),
+                    else_expr: Box::new(args.next().unwrap()),
+                });
+            }
+            if name == "piecewise" {
+                return build_piecewise(args);
+            }
+        }
+
+        Ok(AstNode::CallExpression {
+            callee: Box::new(callee),
+            args,
+        })
+    }
+
+    /// call_op = { "(" ~ (expr ~ ("," ~ expr)*)? ~ ")" }
+    fn call_op(&mut self) -> Option<Built<Vec<AstNode>>> {
+        self.rule("call_op", |p| {
+            p.expect("(")?;
+            p.skip();
+            let args = p.comma_list(Self::expr);
+            p.skip();
+            p.expect(")")?;
+            Some(args.into_iter().collect())
+        })
+    }
+
+    /// `(item ~ ("," ~ item)*)?` on a single line
+    pub(crate) fn comma_list<T>(&mut self, item: fn(&mut Self) -> Option<T>) -> Vec<T> {
+        let mut items = Vec::new();
+        let save = self.pos;
+        match item(self) {
+            Some(first) => items.push(first),
+            None => {
+                self.pos = save;
+                return items;
+            }
+        }
+        loop {
+            let save = self.pos;
+            self.skip();
+            if self.eat(",") {
+                self.skip();
+                if let Some(next) = item(self) {
+                    items.push(next);
+                    continue;
+                }
+            }
+            self.pos = save;
+            return items;
+        }
+    }
+
+    /// index_op = { "[" ~ access_arg ~ ("," ~ access_arg)* ~ "]" }
+    fn index_op(&mut self) -> Option<Built<Vec<IndexArg>>> {
+        self.rule("index_op", |p| {
+            p.expect("[")?;
+            p.skip();
+            let args = p.comma_list(Self::access_arg);
+            if args.is_empty() {
+                return None;
+            }
+            p.skip();
+            p.expect("]")?;
+            Some(args.into_iter().collect())
+        })
+    }
+
+    /// access_arg = { range_expr | expr }
+    /// range_expr = { expr ~ ".." ~ expr | expr ~ ".." | ".." ~ expr | ".." }
+    fn access_arg(&mut self) -> Option<Built<IndexArg>> {
+        self.rule("access_arg", |p| {
+            let start = p.pos;
+            if let Some(first) = p.expr() {
+                let after_first = p.pos;
+                p.skip();
+                if p.eat("..") {
+                    let after_dots = p.pos;
+                    p.skip();
+                    let end = match p.expr() {
+                        Some(end) => Some(end),
+                        None => {
+                            p.pos = after_dots;
+                            None
+                        }
+                    };
+                    return Some((|| {
+                        Ok(IndexArg::Range {
+                            start: Some(Box::new(first?)),
+                            end: match end {
+                                Some(end) => Some(Box::new(end?)),
+                                None => None,
+                            },
+                        })
+                    })());
+                }
+                p.pos = after_first;
+                return Some(first.map(|node| IndexArg::Single(Box::new(node))));
+            }
+
+            p.pos = start;
+            if p.eat("..") {
+                let after_dots = p.pos;
+                p.skip();
+                return match p.expr() {
+                    Some(end) => Some(end.map(|end| IndexArg::Range { start: None, end: Some(Box::new(end)) })),
+                    None => {
+                        p.pos = after_dots;
+                        Some(Ok(IndexArg::Range { start: None, end: None }))
+                    }
+                };
+            }
+            None
+        })
+    }
+
+    /// field_op = { "." ~ field_identifier }
+    fn field_op(&mut self) -> Option<&'a str> {
+        self.rule("field_op", |p| {
+            p.expect(".")?;
+            p.skip();
+            p.field_identifier()
+        })
+    }
+}
+
+/// Convert `piecewise([cond, value], ..., default)` into a Piecewise node
+fn build_piecewise(args: Vec<AstNode>) -> Built {
+    use crate::ast::ArrayElement;
+
+    if args.is_empty() {
+        return Err("piecewise() requires at least one argument".to_string());
+    }
+
+    let mut cases = Vec::new();
+    let mut default = None;
+    let count = args.len();
+
+    for (i, arg) in args.into_iter().enumerate() {
+        match arg {
+            AstNode::ArrayLiteral(elems) => {
+                if elems.len() != 2 {
+                    return Err(format!(
+                        "piecewise() case must have exactly 2 elements [condition, value], got {}",
+                        elems.len()
+                    ));
+                }
+
+                let mut elems = elems.into_iter();
+                let mut single = || match elems.next().unwrap() {
+                    ArrayElement::Single(node) => Ok(node),
+                    ArrayElement::Spread(_) => Err("piecewise() does not support spread in case arrays".to_string()),
+                };
+                let condition = single()?;
+                let value = single()?;
+                cases.push((Box::new(condition), Box::new(value)));
+            }
+            other => {
+                if i != count - 1 {
+                    return Err(format!(
+                        "piecewise() default value must be the last argument (argument {} is not a case)",
+                        i + 1
+                    ));
+                }
+                default = Some(Box::new(other));
+            }
+        }
+    }
+
+    Ok(AstNode::Piecewise { cases, default })
+}
@@ -0,0 +1,241 @@
+// ============================================================================
+// Hand-written Parser for Achronyme SOC Language
+// ============================================================================
+// A single-pass parser that accepts exactly what grammar.pest accepts (same
+// ordered choices, same implicit whitespace, same quirks) and builds the AST
+// directly instead of materialising a Pest pair tree first:
+// - scanner.rs lexes on demand: whitespace, comments, keywords, identifiers,
+//   numbers and strings are matched as byte slices of the input, so no token
+//   or intermediate String is allocated for anything the AST doesn't keep
+// - binary operators go through one Pratt loop over the grammar's precedence
+//   levels instead of a call per level for every operand
+// - `sequence | statement` is parsed once (the first statement is shared)
+// - the postfix expression that starts an assignment candidate is reused
+//   when the statement turns out to be a plain expression
+// - purely numeric array literals are scanned by a dedicated fast path
+//
+// The AST is identical to the Pest pipeline's; tests/test_fast_parser_conformance.rs
+// checks both parsers against each other.
+// ============================================================================
+
+mod scanner;
+mod statements;
+mod expressions;
+mod primary;
+mod types;
+mod patterns;
+
+use crate::ast::AstNode;
+
+/// Result of building an AST node for a successfully matched rule.
+///
+/// Parsing (which rule matched) and building (turning the match into an
+/// AstNode) are separate concerns in the Pest pipeline: a build error such
+/// as `if()` with the wrong number of arguments only surfaces once the whole
+/// program has parsed. The fast parser keeps that separation by carrying
+/// build errors inside successful matches.
+pub(crate) type Built<T = AstNode> = Result<T, String>;
+
+/// Parse a SOC expression string into an AST
+pub fn parse(input: &str) -> Result<Vec<AstNode>, String> {
+    let mut parser = FastParser::new(input);
+    match parser.program() {
+        Some(built) => built,
+        None => Err(format!("Parse error: {}", parser.error_message())),
+    }
+}
+
+pub(crate) struct FastParser<'a> {
+    pub(crate) src: &'a str,
+    pub(crate) bytes: &'a [u8],
+    pub(crate) pos: usize,
+
+    // Pest-compatible error tracking: the furthest position at which a rule
+    // failed, and the (outermost) rules attempted there.
+    attempt_pos: usize,
+    attempts: Vec<&'static str>,
+
+    // Single-entry memo for `postfix_expression` (start, end, result).
+    pub(crate) postfix_memo: Option<(usize, usize, Built)>,
+}
+
+impl<'a> FastParser<'a> {
+    pub(crate) fn new(src: &'a str) -> Self {
+        FastParser {
+            src,
+            bytes: src.as_bytes(),
+            pos: 0,
+            attempt_pos: 0,
+            attempts: Vec::new(),
+            postfix_memo: None,
+        }
+    }
+
+    /// Run `f` as the grammar rule `name`.
+    ///
+    /// On failure the position is restored and the attempt is recorded the
+    /// same way Pest records it, so error messages list the same rules.
+    #[inline]
+    pub(crate) fn rule<T>(&mut self, name: &'static str, f: impl FnOnce(&mut Self) -> Option<T>) -> Option<T> {
+        let start = self.pos;
+        let (index, prev) = if start == self.attempt_pos {
+            (self.attempts.len(), self.attempts.len())
+        } else {
+            (0, 0)
+        };
+
+        let result = f(self);
+        if result.is_none() {
+            self.pos = start;
+            self.track(name, start, index, prev);
+        }
+        result
+    }
+
+    fn track(&mut self, name: &'static str, start: usize, index: usize, prev: usize) {
+        if start < self.attempt_pos {
+            return;
+        }
+
+        // A single child attempt at the same position is more precise than
+        // the parent rule, so keep it.
+        let current = if start == self.attempt_pos { self.attempts.len() } else { 0 };
+        if current > prev && current - prev == 1 {
+            return;
+        }
+
+        if start == self.attempt_pos {
+            self.attempts.truncate(index);
+        } else {
+            self.attempts.clear();
+            self.attempt_pos = start;
+        }
+        self.attempts.push(name);
+    }
+
+    /// Format the furthest failure like Pest does
+    fn error_message(&self) -> String {
+        let pos = self.attempt_pos.min(self.src.len());
+        let line_start = self.src[..pos].rfind('\n').map(|i| i + 1).unwrap_or(0);
+        let line_end = self.src[pos..].find('\n').map(|i| pos + i).unwrap_or(self.src.len());
+        let line_no = self.src[..line_start].matches('\n').count() + 1;
+        let col = self.src[line_start..pos].chars().count() + 1;
+        let line = self.src[line_start..line_end].trim_end_matches('\r');
+
+        let mut expected: Vec<&str> = Vec::new();
+        for name in &self.attempts {
+            if !expected.contains(name) {
+                expected.push(name);
+            }
+        }
+        let message = match expected.len() {
+            0 => "unknown parsing error".to_string(),
+            1 => format!("expected {}", expected[0]),
+            2 => format!("expected {} or {}", expected[0], expected[1]),
+            n => format!("expected {}, or {}", expected[..n - 1].join(", "), expected[n - 1]),
+        };
+
+        let spacing = " ".repeat(line_no.to_string().len());
+        format!(
+            "{s}--> {l}:{c}\n{s} |\n{l} | {line}\n{s} | {u}^---\n{s} |\n{s} = {m}",
+            s = spacing,
+            l = line_no,
+            c = col,
+            line = line,
+            u = " ".repeat(col - 1),
+            m = message,
+        )
+    }
+
+    // ------------------------------------------------------------------------
+    // program = { SOI ~ NEWLINE* ~ top_level_expr* ~ NEWLINE* ~ EOI }
+    // ------------------------------------------------------------------------
+
+    fn program(&mut self) -> Option<Built<Vec<AstNode>>> {
+        self.rule("program", |p| {
+            p.skip_nl();
+
+            let mut statements = Vec::new();
+            loop {
+                let save = p.pos;
+                if !statements.is_empty() {
+                    p.skip();
+                }
+                match p.top_level_expr() {
+                    Some(node) => statements.push(node),
+                    None => {
+                        p.pos = save;
+                        break;
+                    }
+                }
+            }
+
+            p.skip_nl();
+            p.rule("EOI", |p| if p.at_end() { Some(()) } else { None })?;
+
+            Some(statements.into_iter().collect())
+        })
+    }
+
+    /// top_level_expr = { sequence | statement }
+    fn top_level_expr(&mut self) -> Option<Built> {
+        self.rule("top_level_expr", |p| p.sequence_or_statement())
+    }
+
+    /// `sequence | statement`, sharing the parse of the first statement.
+    ///
+    /// sequence = { statement ~ (statement_sep ~ statement)+ ~ statement_sep_opt }
+    ///
+    /// Returns a `Sequence` node for two or more statements and the bare
+    /// statement otherwise, matching `build_sequence`/`build_block`.
+    pub(crate) fn sequence_or_statement(&mut self) -> Option<Built> {
+        let first = self.statement()?;
+        let mut statements = vec![first];
+
+        loop {
+            let save = self.pos;
+            self.skip();
+            if self.statement_sep() {
+                self.skip();
+                if let Some(stmt) = self.statement() {
+                    statements.push(stmt);
+                    continue;
+                }
+            }
+            self.pos = save;
+            break;
+        }
+
+        if statements.len() == 1 {
+            return statements.pop();
+        }
+
+        // statement_sep_opt
+        let save = self.pos;
+        self.skip();
+        if !self.statement_sep() {
+            self.pos = save;
+        }
+
+        Some(
+            statements
+                .into_iter()
+                .collect::<Result<Vec<_>, _>>()
+                .map(|statements| AstNode::Sequence { statements }),
+        )
+    }
+
+    /// statement_sep = _{ (";" ~ NEWLINE*) | NEWLINE+ }
+    fn statement_sep(&mut self) -> bool {
+        if self.eat(";") {
+            self.skip_nl();
+            true
+        } else if self.peek() == Some(b'\n') {
+            self.pos += 1;
+            self.skip_nl();
+            true
+        } else {
+            false
+        }
+    }
+}
@@ -0,0 +1,202 @@
+// Match expressions and patterns.
+
+use super::scanner::process_escape_sequences;
+use super::{Built, FastParser};
+use crate::ast::{AstNode, LiteralPattern, MatchArm, Pattern, VectorPatternElement};
+
+const TYPE_PATTERNS: &[&str] = &[
+    "Number", "Boolean", "String", "Complex", "Generator", "Function", "Error", "Tensor", "Vector",
+    "Record", "Edge", "Null",
+];
+
+impl<'a> FastParser<'a> {
+    /// match_expr = { "match" ~ expr ~ "{" ~ NEWLINE* ~ match_arm ~ (NEWLINE* ~ "," ~ NEWLINE* ~ match_arm)*
+    ///              ~ (NEWLINE* ~ ",")? ~ NEWLINE* ~ "}" }
+    pub(crate) fn match_expr(&mut self) -> Option<Built> {
+        self.rule("match_expr", |p| {
+            p.expect("match")?;
+            p.skip();
+            let value = p.expr()?;
+            p.skip();
+            p.expect("{")?;
+            p.skip_nl();
+            let arms = p.nl_comma_list(Self::match_arm);
+            if arms.is_empty() {
+                return None;
+            }
+
+            let save = p.pos;
+            p.skip_nl();
+            if !p.eat(",") {
+                p.pos = save;
+            }
+            p.skip_nl();
+            p.expect("}")?;
+
+            Some((|| {
+                Ok(AstNode::Match {
+                    value: Box::new(value?),
+                    arms: arms.into_iter().collect::<Result<Vec<_>, _>>()?,
+                })
+            })())
+        })
+    }
+
+    /// match_arm = { pattern ~ guard_clause? ~ "=>" ~ NEWLINE* ~ expr }
+    fn match_arm(&mut self) -> Option<Built<MatchArm>> {
+        self.rule("match_arm", |p| {
+            let pattern = p.pattern()?;
+
+            let save = p.pos;
+            p.skip();
+            let guard = match p.guard_clause() {
+                Some(guard) => Some(guard),
+                None => {
+                    p.pos = save;
+                    None
+                }
+            };
+
+            p.skip();
+            p.expect("=>")?;
+            p.skip_nl();
+            let body = p.expr()?;
+
+            Some((|| {
+                Ok(MatchArm {
+                    pattern: pattern?,
+                    guard: guard.transpose()?.map(Box::new),
+                    body: Box::new(body?),
+                })
+            })())
+        })
+    }
+
+    /// guard_clause = { "if" ~ "(" ~ expr ~ ")" }
+    fn guard_clause(&mut self) -> Option<Built> {
+        self.rule("guard_clause", |p| {
+            p.expect("if")?;
+            p.skip();
+            p.expect("(")?;
+            p.skip();
+            let condition = p.expr()?;
+            p.skip();
+            p.expect(")")?;
+            Some(condition)
+        })
+    }
+
+    /// pattern = { record_pattern | vector_pattern | literal_pattern | type_pattern
+    ///           | wildcard_pattern | variable_pattern }
+    fn pattern(&mut self) -> Option<Built<Pattern>> {
+        self.rule("pattern", |p| {
+            match p.peek()? {
+                b'{' => {
+                    if let Some(pattern) = p.record_pattern() {
+                        return Some(pattern);
+                    }
+                }
+                b'[' => {
+                    if let Some(pattern) = p.vector_pattern() {
+                        return Some(pattern);
+                    }
+                }
+                _ => {}
+            }
+
+            if let Some(literal) = p.literal_pattern() {
+                return Some(literal);
+            }
+
+            if let Some(name) = p.rule("type_pattern", |p| {
+                TYPE_PATTERNS
+                    .iter()
+                    .find(|name| p.looking_at(name))
+                    .and_then(|name| p.eat_word(name).then_some(*name))
+            }) {
+                return Some(Ok(Pattern::Type(name.to_string())));
+            }
+
+            if p.rule("wildcard_pattern", |p| p.expect("_")).is_some() {
+                return Some(Ok(Pattern::Wildcard));
+            }
+
+            let name = p.rule("variable_pattern", |p| p.identifier())?;
+            Some(Ok(Pattern::Variable(name.to_string())))
+        })
+    }
+
+    /// literal_pattern = { boolean | string_literal | number }
+    fn literal_pattern(&mut self) -> Option<Built<Pattern>> {
+        self.rule("literal_pattern", |p| {
+            if let Some(value) = p.boolean() {
+                return Some(Ok(Pattern::Literal(LiteralPattern::Boolean(value))));
+            }
+            if let Some(raw) = p.string_literal() {
+                return Some(Ok(Pattern::Literal(LiteralPattern::String(process_escape_sequences(raw)))));
+            }
+            let text = p.number()?;
+            Some(
+                text.parse::<f64>()
+                    .map(|n| Pattern::Literal(LiteralPattern::Number(n)))
+                    .map_err(|e| format!("Failed to parse number in pattern: {}", e)),
+            )
+        })
+    }
+
+    /// record_pattern = { "{" ~ NEWLINE* ~ (record_pattern_field ~ (NEWLINE* ~ "," ~ NEWLINE* ~ record_pattern_field)*)? ~ NEWLINE* ~ "}" }
+    fn record_pattern(&mut self) -> Option<Built<Pattern>> {
+        self.rule("record_pattern", |p| {
+            p.expect("{")?;
+            p.skip_nl();
+            let fields = p.nl_comma_list(Self::record_pattern_field);
+            p.skip_nl();
+            p.expect("}")?;
+            Some(fields.into_iter().collect::<Result<Vec<_>, _>>().map(|fields| Pattern::Record { fields }))
+        })
+    }
+
+    /// record_pattern_field = { identifier ~ ":" ~ pattern | identifier }
+    fn record_pattern_field(&mut self) -> Option<Built<(String, Pattern)>> {
+        self.rule("record_pattern_field", |p| {
+            let name = p.identifier()?.to_string();
+            let save = p.pos;
+            p.skip();
+            if p.eat(":") {
+                p.skip();
+                if let Some(pattern) = p.pattern() {
+                    return Some(pattern.map(|pattern| (name, pattern)));
+                }
+            }
+            p.pos = save;
+            Some(Ok((name.clone(), Pattern::Variable(name))))
+        })
+    }
+
+    /// vector_pattern = { "[" ~ NEWLINE* ~ (vector_pattern_element ~ (NEWLINE* ~ "," ~ NEWLINE* ~ vector_pattern_element)*)? ~ NEWLINE* ~ "]" }
+    fn vector_pattern(&mut self) -> Option<Built<Pattern>> {
+        self.rule("vector_pattern", |p| {
+            p.expect("[")?;
+            p.skip_nl();
+            let elements = p.nl_comma_list(Self::vector_pattern_element);
+            p.skip_nl();
+            p.expect("]")?;
+            Some(elements.into_iter().collect::<Result<Vec<_>, _>>().map(|elements| Pattern::Vector { elements }))
+        })
+    }
+
+    /// vector_pattern_element = { rest_pattern | pattern }
+    /// rest_pattern = { "..." ~ identifier }
+    fn vector_pattern_element(&mut self) -> Option<Built<VectorPatternElement>> {
+        self.rule("vector_pattern_element", |p| {
+            if let Some(name) = p.rule("rest_pattern", |p| {
+                p.expect("...")?;
+                p.skip();
+                p.identifier()
+            }) {
+                return Some(Ok(VectorPatternElement::Rest(name.to_string())));
+            }
+            p.pattern().map(|pattern| pattern.map(VectorPatternElement::Pattern))
+        })
+    }
+}
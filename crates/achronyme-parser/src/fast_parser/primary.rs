@@ -0,0 +1,619 @@
+// Primary expressions: literals, collections, blocks, control flow and
+// lambdas.
+
+use super::scanner::{is_alnum, process_escape_sequences};
+use super::{Built, FastParser};
+use crate::ast::{ArrayElement, AstNode, RecordFieldOrSpread, UnaryOp};
+use crate::symbol::Symbol;
+use crate::type_annotation::TypeAnnotation;
+
+type Param = (String, Option<TypeAnnotation>);
+
+impl<'a> FastParser<'a> {
+    /// primary = { boolean | string_literal | null_literal | complex | number
+    ///           | control_flow_expr | record | array | do_block | lambda
+    ///           | self_ref | rec_ref | identifier | "(" ~ expr ~ ")" }
+    pub(crate) fn primary(&mut self) -> Option<Built> {
+        self.rule("primary", |p| p.primary_alternatives()).map(|(node, _, _)| node)
+    }
+
+    /// Parse a primary and report which alternative matched (and the
+    /// identifier text for `identifier`); used for edge endpoint checks
+    pub(crate) fn primary_kind(&mut self) -> Option<(&'static str, &'a str)> {
+        self.rule("primary", |p| p.primary_alternatives()).map(|(_, kind, text)| (kind, text))
+    }
+
+    fn primary_alternatives(&mut self) -> Option<(Built, &'static str, &'a str)> {
+        let first = self.peek()?;
+
+        // Alternatives that cannot start with `first` are skipped; they would
+        // fail without consuming anything.
+        if first == b't' || first == b'f' {
+            if let Some(value) = self.boolean() {
+                return Some((Ok(AstNode::Boolean(value)), "boolean", ""));
+            }
+        }
+
+        if first == b'"' {
+            if let Some(raw) = self.string_literal() {
+                return Some((Ok(AstNode::StringLiteral(process_escape_sequences(raw))), "string_literal", ""));
+            }
+        }
+
+        if first == b'n' && self.rule("null_literal", |p| p.eat_word_skipping("null").then_some(())).is_some() {
+            return Some((Ok(AstNode::Null), "null_literal", ""));
+        }
+
+        if first == b'-' || first.is_ascii_digit() {
+            if let Some(node) = self.complex() {
+                return Some((node, "complex", ""));
+            }
+            if let Some(text) = self.number() {
+                let node = text
+                    .parse::<f64>()
+                    .map(AstNode::Number)
+                    .map_err(|e| format!("Failed to parse number: {}", e));
+                return Some((node, "number", ""));
+            }
+        }
+
+        if matches!(first, b'i' | b'w' | b'f' | b't' | b'm') {
+            if let Some(node) = self.control_flow_expr() {
+                return Some((node, "control_flow_expr", ""));
+            }
+        }
+
+        if first == b'{' {
+            if let Some(node) = self.record() {
+                return Some((node, "record", ""));
+            }
+        }
+
+        if first == b'[' {
+            if let Some(node) = self.array() {
+                return Some((node, "array", ""));
+            }
+        }
+
+        if first == b'd' {
+            if let Some(node) = self.do_block() {
+                return Some((node, "do_block", ""));
+            }
+        }
+
+        if first == b'(' || first == b'_' || first.is_ascii_alphabetic() {
+            if let Some(node) = self.lambda() {
+                return Some((node, "lambda", ""));
+            }
+        }
+
+        if first == b's' && self.rule("self_ref", |p| p.eat_word_skipping("self").then_some(())).is_some() {
+            return Some((Ok(AstNode::SelfReference), "self_ref", ""));
+        }
+
+        if first == b'r' && self.rule("rec_ref", |p| p.eat_word_skipping("rec").then_some(())).is_some() {
+            return Some((Ok(AstNode::RecReference), "rec_ref", ""));
+        }
+
+        if first == b'_' || first.is_ascii_alphabetic() {
+            if let Some(name) = self.identifier() {
+                return Some((Ok(AstNode::VariableRef(Symbol::intern(name))), "identifier", name));
+            }
+        }
+
+        if first == b'(' {
+            let save = self.pos;
+            self.pos += 1;
+            self.skip();
+            if let Some(inner) = self.expr() {
+                self.skip();
+                if self.eat(")") {
+                    return Some((inner, "expr", ""));
+                }
+            }
+            self.pos = save;
+        }
+
+        None
+    }
+
+    /// boolean = { "true" | "false" }
+    pub(crate) fn boolean(&mut self) -> Option<bool> {
+        self.rule("boolean", |p| {
+            if p.eat("true") {
+                Some(true)
+            } else if p.eat("false") {
+                Some(false)
+            } else {
+                None
+            }
+        })
+    }
+
+    /// complex = @{ number ~ "i" }
+    fn complex(&mut self) -> Option<Built> {
+        self.rule("complex", |p| {
+            let end = p.scan_number(p.pos)?;
+            if p.bytes.get(end) != Some(&b'i') {
+                return None;
+            }
+            let text = &p.src[p.pos..end];
+            p.pos = end + 1;
+            Some(
+                text.parse::<f64>()
+                    .map(|im| AstNode::ComplexLiteral { re: 0.0, im })
+                    .map_err(|e| format!("Failed to parse complex number: {}", e)),
+            )
+        })
+    }
+
+    // ------------------------------------------------------------------------
+    // Collections
+    // ------------------------------------------------------------------------
+
+    /// `(item ~ (NEWLINE* ~ "," ~ NEWLINE* ~ item)*)?`
+    pub(crate) fn nl_comma_list<T>(&mut self, item: fn(&mut Self) -> Option<T>) -> Vec<T> {
+        let mut items = Vec::new();
+        match item(self) {
+            Some(first) => items.push(first),
+            None => return items,
+        }
+        loop {
+            let save = self.pos;
+            self.skip_nl();
+            if self.eat(",") {
+                self.skip_nl();
+                if let Some(next) = item(self) {
+                    items.push(next);
+                    continue;
+                }
+            }
+            self.pos = save;
+            return items;
+        }
+    }
+
+    /// array = { "[" ~ NEWLINE* ~ (array_element ~ (NEWLINE* ~ "," ~ NEWLINE* ~ array_element)*)? ~ NEWLINE* ~ "]" }
+    fn array(&mut self) -> Option<Built> {
+        self.rule("array", |p| {
+            if let Some(numbers) = p.numeric_array() {
+                return Some(Ok(AstNode::ArrayLiteral(numbers)));
+            }
+
+            p.expect("[")?;
+            p.skip_nl();
+            let elements = p.nl_comma_list(Self::array_element);
+            p.skip_nl();
+            p.expect("]")?;
+            Some(elements.into_iter().collect::<Result<Vec<_>, _>>().map(AstNode::ArrayLiteral))
+        })
+    }
+
+    /// Fast path for arrays whose elements are all plain number literals,
+    /// optionally negated, or such arrays themselves, e.g. `[1, -2.5, 3e-2]`
+    /// or `[[1, 2], [3, 4]]`: scan the literals directly
+    /// instead of descending the whole expression chain for every element.
+    /// Large generated data literals are almost entirely made of these.
+    ///
+    /// Gives up (restoring the position) on anything else, leaving the
+    /// general rule to produce the exact same result the slow way.
+    fn numeric_array(&mut self) -> Option<Vec<ArrayElement>> {
+        let start = self.pos;
+        let result = self.numeric_array_inner();
+        if result.is_none() {
+            self.pos = start;
+        }
+        result
+    }
+
+    fn numeric_array_inner(&mut self) -> Option<Vec<ArrayElement>> {
+        self.expect("[")?;
+        self.skip_nl();
+        let mut elements = Vec::new();
+        if self.eat("]") {
+            return Some(elements);
+        }
+        loop {
+            // Rows of a matrix literal
+            if self.peek()? == b'[' {
+                let row = self.numeric_array_inner()?;
+                elements.push(ArrayElement::Single(AstNode::ArrayLiteral(row)));
+                if !self.numeric_array_separator()? {
+                    return Some(elements);
+                }
+                continue;
+            }
+
+            // `-1` is `unary`'s "-" ~ unary, not a negative number literal
+            let negate = self.peek()? == b'-';
+            if negate {
+                self.pos += 1;
+            }
+            if !self.peek()?.is_ascii_digit() {
+                return None;
+            }
+            let end = self.scan_number(self.pos)?;
+            // A literal followed by `i` is complex; by `.`, `(`, `[`, `^` or an
+            // operator it is part of a larger expression.
+            let value: f64 = self.src[self.pos..end].parse().ok()?;
+            self.pos = end;
+            if matches!(self.peek(), Some(b) if is_alnum(b) || b == b'_') {
+                return None;
+            }
+            let number = AstNode::Number(value);
+            elements.push(ArrayElement::Single(if negate {
+                AstNode::UnaryOp { op: UnaryOp::Negate, operand: Box::new(number) }
+            } else {
+                number
+            }));
+            if !self.numeric_array_separator()? {
+                return Some(elements);
+            }
+        }
+    }
+
+    /// After an element of a numeric array: `Some(true)` past a `,`,
+    /// `Some(false)` past the closing `]`, `None` if the element continues
+    /// as a larger expression
+    fn numeric_array_separator(&mut self) -> Option<bool> {
+        self.skip_nl();
+        match self.peek()? {
+            b',' => {
+                self.pos += 1;
+                self.skip_nl();
+                Some(true)
+            }
+            b']' => {
+                self.pos += 1;
+                Some(false)
+            }
+            _ => None,
+        }
+    }
+
+    /// array_element = { spread_expr | expr }
+    fn array_element(&mut self) -> Option<Built<ArrayElement>> {
+        self.rule("array_element", |p| {
+            if let Some(spread) = p.spread_expr() {
+                return Some(spread.map(|node| ArrayElement::Spread(Box::new(node))));
+            }
+            p.expr().map(|node| node.map(ArrayElement::Single))
+        })
+    }
+
+    /// spread_expr = { "..." ~ expr }
+    fn spread_expr(&mut self) -> Option<Built> {
+        self.rule("spread_expr", |p| {
+            p.expect("...")?;
+            p.skip();
+            p.expr()
+        })
+    }
+
+    /// record = { "{" ~ NEWLINE* ~ (record_field_or_spread ~ (NEWLINE* ~ "," ~ NEWLINE* ~ record_field_or_spread)*)? ~ NEWLINE* ~ "}" }
+    fn record(&mut self) -> Option<Built> {
+        self.rule("record", |p| {
+            p.expect("{")?;
+            p.skip_nl();
+            let fields = p.nl_comma_list(Self::record_field_or_spread);
+            p.skip_nl();
+            p.expect("}")?;
+            Some(fields.into_iter().collect::<Result<Vec<_>, _>>().map(AstNode::RecordLiteral))
+        })
+    }
+
+    /// record_field_or_spread = { spread_expr | record_field }
+    fn record_field_or_spread(&mut self) -> Option<Built<RecordFieldOrSpread>> {
+        self.rule("record_field_or_spread", |p| {
+            if let Some(spread) = p.spread_expr() {
+                return Some(spread.map(|node| RecordFieldOrSpread::Spread(Box::new(node))));
+            }
+            p.record_field()
+        })
+    }
+
+    /// record_field = { (mut_keyword ~ identifier ~ ":" ~ expr) | (identifier ~ ":" ~ expr) }
+    fn record_field(&mut self) -> Option<Built<RecordFieldOrSpread>> {
+        self.rule("record_field", |p| {
+            let start = p.pos;
+            if p.mut_keyword() {
+                if let Some((name, value)) = p.field_body() {
+                    return Some(value.map(|value| RecordFieldOrSpread::MutableField { name, value }));
+                }
+                p.pos = start;
+            }
+            let (name, value) = p.field_body()?;
+            Some(value.map(|value| RecordFieldOrSpread::Field { name, value }))
+        })
+    }
+
+    /// `identifier ~ ":" ~ expr` (the leading skip belongs to the caller)
+    fn field_body(&mut self) -> Option<(String, Built)> {
+        let start = self.pos;
+        self.skip();
+        let result = (|| {
+            let name = self.identifier()?.to_string();
+            self.skip();
+            self.expect(":")?;
+            self.skip();
+            let value = self.expr()?;
+            Some((name, value))
+        })();
+        if result.is_none() {
+            self.pos = start;
+        }
+        result
+    }
+
+    // ------------------------------------------------------------------------
+    // Blocks
+    // ------------------------------------------------------------------------
+
+    /// block = { "{" ~ NEWLINE* ~ (sequence | statement) ~ NEWLINE* ~ "}" }
+    pub(crate) fn block(&mut self) -> Option<Built> {
+        self.rule("block", |p| {
+            p.expect("{")?;
+            p.skip_nl();
+            let content = p.sequence_or_statement()?;
+            p.skip_nl();
+            p.expect("}")?;
+            Some(content)
+        })
+    }
+
+    /// Statements of a block, as used by do and generate blocks
+    fn block_statements(content: AstNode) -> Vec<AstNode> {
+        match content {
+            AstNode::Sequence { statements } => statements,
+            single => vec![single],
+        }
+    }
+
+    /// do_block = { "do" ~ block }
+    fn do_block(&mut self) -> Option<Built> {
+        self.rule("do_block", |p| {
+            p.expect("do")?;
+            p.skip();
+            let content = p.block()?;
+            Some(content.map(|c| AstNode::DoBlock { statements: Self::block_statements(c) }))
+        })
+    }
+
+    /// generate_block = { "generate" ~ block }
+    fn generate_block(&mut self) -> Option<Built> {
+        self.rule("generate_block", |p| {
+            p.expect("generate")?;
+            p.skip();
+            let content = p.block()?;
+            Some(content.map(|c| AstNode::GenerateBlock { statements: Self::block_statements(c) }))
+        })
+    }
+
+    // ------------------------------------------------------------------------
+    // Lambdas
+    // ------------------------------------------------------------------------
+
+    /// lambda = { typed_lambda_params ~ (":" ~ type_annotation)? ~ "=>" ~ NEWLINE* ~ lambda_body }
+    fn lambda(&mut self) -> Option<Built> {
+        self.rule("lambda", |p| {
+            let params = p.typed_lambda_params()?;
+
+            let save = p.pos;
+            p.skip();
+            let return_type = if p.eat(":") {
+                p.skip();
+                match p.type_annotation() {
+                    Some(ty) => Some(ty),
+                    None => {
+                        p.pos = save;
+                        None
+                    }
+                }
+            } else {
+                p.pos = save;
+                None
+            };
+
+            p.skip();
+            p.expect("=>")?;
+            p.skip_nl();
+            let body = p.lambda_body()?;
+
+            Some((|| {
+                Ok(AstNode::Lambda {
+                    params: params?,
+                    return_type: return_type.transpose()?,
+                    body: Box::new(body?),
+                })
+            })())
+        })
+    }
+
+    /// lambda_body = { generate_block | do_block | expr }
+    fn lambda_body(&mut self) -> Option<Built> {
+        self.rule("lambda_body", |p| {
+            if p.peek() == Some(b'g') {
+                if let Some(node) = p.generate_block() {
+                    return Some(node);
+                }
+            }
+            if p.peek() == Some(b'd') {
+                if let Some(node) = p.do_block() {
+                    return Some(node);
+                }
+            }
+            p.expr()
+        })
+    }
+
+    /// typed_lambda_params = { typed_param | ("(" ~ (typed_param ~ ("," ~ typed_param)*)? ~ ")") }
+    fn typed_lambda_params(&mut self) -> Option<Built<Vec<Param>>> {
+        self.rule("typed_lambda_params", |p| {
+            if let Some(param) = p.typed_param() {
+                return Some(param.map(|param| vec![param]));
+            }
+            p.expect("(")?;
+            p.skip();
+            let params = p.comma_list(Self::typed_param);
+            p.skip();
+            p.expect(")")?;
+            Some(params.into_iter().collect())
+        })
+    }
+
+    /// typed_param = { identifier ~ (":" ~ type_annotation)? }
+    fn typed_param(&mut self) -> Option<Built<Param>> {
+        self.rule("typed_param", |p| {
+            let name = p.identifier()?.to_string();
+            let save = p.pos;
+            p.skip();
+            if p.eat(":") {
+                p.skip();
+                if let Some(ty) = p.type_annotation() {
+                    return Some(ty.map(|ty| (name, Some(ty))));
+                }
+            }
+            p.pos = save;
+            Some(Ok((name, None)))
+        })
+    }
+
+    // ------------------------------------------------------------------------
+    // Control flow
+    // ------------------------------------------------------------------------
+
+    /// control_flow_expr = { if_expr | while_expr | for_in_loop | try_catch_expr | match_expr }
+    fn control_flow_expr(&mut self) -> Option<Built> {
+        self.rule("control_flow_expr", |p| match p.peek()? {
+            b'i' => p.if_expr(),
+            b'w' => p.while_expr(),
+            b'f' => p.for_in_loop(),
+            b't' => p.try_catch_expr(),
+            b'm' => p.match_expr(),
+            _ => None,
+        })
+    }
+
+    /// `"(" ~ expr ~ ")"` as used by if/while conditions
+    fn parenthesized_condition(&mut self) -> Option<Built> {
+        self.expect("(")?;
+        self.skip();
+        let condition = self.expr()?;
+        self.skip();
+        self.expect(")")?;
+        Some(condition)
+    }
+
+    /// if_expr = { "if" ~ "(" ~ expr ~ ")" ~ &"{" ~ block ~ ("else" ~ (if_expr | block))? }
+    fn if_expr(&mut self) -> Option<Built> {
+        self.rule("if_expr", |p| {
+            p.expect("if")?;
+            p.skip();
+            let condition = p.parenthesized_condition()?;
+            p.skip();
+            if !p.looking_at("{") {
+                return None;
+            }
+            let then_expr = p.block()?;
+
+            let save = p.pos;
+            p.skip();
+            let else_expr = if p.eat("else") {
+                p.skip();
+                match p.if_expr().or_else(|| p.block()) {
+                    Some(node) => Some(node),
+                    None => {
+                        p.pos = save;
+                        None
+                    }
+                }
+            } else {
+                p.pos = save;
+                None
+            };
+
+            Some((|| {
+                Ok(AstNode::If {
+                    condition: Box::new(condition?),
+                    then_expr: Box::new(then_expr?),
+                    else_expr: Box::new(else_expr.unwrap_or(Ok(AstNode::Number(0.0)))?),
+                })
+            })())
+        })
+    }
+
+    /// while_expr = { "while" ~ "(" ~ expr ~ ")" ~ &"{" ~ block }
+    fn while_expr(&mut self) -> Option<Built> {
+        self.rule("while_expr", |p| {
+            p.expect("while")?;
+            p.skip();
+            let condition = p.parenthesized_condition()?;
+            p.skip();
+            if !p.looking_at("{") {
+                return None;
+            }
+            let body = p.block()?;
+            Some((|| {
+                Ok(AstNode::WhileLoop {
+                    condition: Box::new(condition?),
+                    body: Box::new(body?),
+                })
+            })())
+        })
+    }
+
+    /// for_in_loop = { "for" ~ "(" ~ identifier ~ "in" ~ expr ~ ")" ~ &"{" ~ block }
+    fn for_in_loop(&mut self) -> Option<Built> {
+        self.rule("for_in_loop", |p| {
+            p.expect("for")?;
+            p.skip();
+            p.expect("(")?;
+            p.skip();
+            let variable = p.identifier()?.to_string();
+            p.skip();
+            p.expect("in")?;
+            p.skip();
+            let iterable = p.expr()?;
+            p.skip();
+            p.expect(")")?;
+            p.skip();
+            if !p.looking_at("{") {
+                return None;
+            }
+            let body = p.block()?;
+            Some((|| {
+                Ok(AstNode::ForInLoop {
+                    variable,
+                    iterable: Box::new(iterable?),
+                    body: Box::new(body?),
+                })
+            })())
+        })
+    }
+
+    /// try_catch_expr = { "try" ~ block ~ "catch" ~ "(" ~ identifier ~ ")" ~ block }
+    fn try_catch_expr(&mut self) -> Option<Built> {
+        self.rule("try_catch_expr", |p| {
+            p.expect("try")?;
+            p.skip();
+            let try_block = p.block()?;
+            p.skip();
+            p.expect("catch")?;
+            p.skip();
+            p.expect("(")?;
+            p.skip();
+            let error_param = p.identifier()?.to_string();
+            p.skip();
+            p.expect(")")?;
+            p.skip();
+            let catch_block = p.block()?;
+            Some((|| {
+                Ok(AstNode::TryCatch {
+                    try_block: Box::new(try_block?),
+                    error_param,
+                    catch_block: Box::new(catch_block?),
+                })
+            })())
+        })
+    }
+}
@@ -0,0 +1,290 @@
+// Byte-level scanning helpers and the atomic (`@{}`) rules of the grammar:
+// whitespace/comments, keywords, identifiers, numbers and string literals.
+
+use super::FastParser;
+
+/// Reserved keywords, in grammar order
+const KEYWORDS: &[&str] = &[
+    "let", "mut", "rec", "self", "true", "false", "import", "from", "export", "as", "return",
+    "while", "type", "yield", "generate", "for", "in", "try", "catch", "throw", "match",
+];
+
+#[inline]
+pub(crate) fn is_alnum(b: u8) -> bool {
+    b.is_ascii_alphanumeric()
+}
+
+#[inline]
+fn is_ident_start(b: u8) -> bool {
+    b.is_ascii_alphabetic() || b == b'_'
+}
+
+#[inline]
+fn is_ident_continue(b: u8) -> bool {
+    b.is_ascii_alphanumeric() || b == b'_'
+}
+
+impl<'a> FastParser<'a> {
+    #[inline]
+    pub(crate) fn peek(&self) -> Option<u8> {
+        self.bytes.get(self.pos).copied()
+    }
+
+    #[inline]
+    pub(crate) fn peek_at(&self, offset: usize) -> Option<u8> {
+        self.bytes.get(self.pos + offset).copied()
+    }
+
+    #[inline]
+    pub(crate) fn at_end(&self) -> bool {
+        self.pos >= self.bytes.len()
+    }
+
+    #[inline]
+    pub(crate) fn looking_at(&self, lit: &str) -> bool {
+        self.bytes[self.pos..].starts_with(lit.as_bytes())
+    }
+
+    /// Match a literal string (no whitespace handling)
+    #[inline]
+    pub(crate) fn eat(&mut self, lit: &str) -> bool {
+        if self.looking_at(lit) {
+            self.pos += lit.len();
+            true
+        } else {
+            false
+        }
+    }
+
+    /// Match a literal string, failing the enclosing rule if absent
+    #[inline]
+    pub(crate) fn expect(&mut self, lit: &str) -> Option<()> {
+        if self.eat(lit) { Some(()) } else { None }
+    }
+
+    /// `!ASCII_ALPHANUMERIC` lookahead
+    #[inline]
+    pub(crate) fn at_word_boundary(&self) -> bool {
+        !matches!(self.peek(), Some(b) if is_alnum(b))
+    }
+
+    /// Implicit skip between tokens: (WHITESPACE | COMMENT)*
+    ///
+    /// WHITESPACE is space, tab and carriage return; newlines are significant
+    /// and only consumed where the grammar asks for NEWLINE.
+    #[inline]
+    pub(crate) fn skip(&mut self) {
+        loop {
+            match self.peek() {
+                Some(b' ') | Some(b'\t') | Some(b'\r') => self.pos += 1,
+                Some(b'/') if self.peek_at(1) == Some(b'/') => {
+                    while let Some(b) = self.peek() {
+                        if b == b'\n' {
+                            break;
+                        }
+                        self.pos += 1;
+                    }
+                }
+                _ => return,
+            }
+        }
+    }
+
+    /// `NEWLINE*` surrounded by implicit skips: any mix of whitespace,
+    /// comments and newlines
+    #[inline]
+    pub(crate) fn skip_nl(&mut self) {
+        loop {
+            self.skip();
+            if self.peek() == Some(b'\n') {
+                self.pos += 1;
+            } else {
+                return;
+            }
+        }
+    }
+
+    /// keyword = _{ ("let" | ... | "match") ~ !ASCII_ALPHANUMERIC }
+    ///
+    /// Like the grammar, the first keyword that prefixes the input decides.
+    /// Note that `_` is not alphanumeric, so `in_range` starts with a keyword.
+    fn at_keyword(&self) -> bool {
+        let rest = &self.bytes[self.pos..];
+        for kw in KEYWORDS {
+            if rest.starts_with(kw.as_bytes()) {
+                return !matches!(rest.get(kw.len()), Some(&b) if is_alnum(b));
+            }
+        }
+        false
+    }
+
+    /// identifier = @{ !keyword ~ (ASCII_ALPHA | "_") ~ (ASCII_ALPHANUMERIC | "_")* }
+    pub(crate) fn identifier(&mut self) -> Option<&'a str> {
+        self.rule("identifier", |p| {
+            if p.at_keyword() {
+                return None;
+            }
+            p.word()
+        })
+    }
+
+    /// field_identifier = @{ (ASCII_ALPHA | "_") ~ (ASCII_ALPHANUMERIC | "_")* }
+    pub(crate) fn field_identifier(&mut self) -> Option<&'a str> {
+        self.rule("field_identifier", |p| p.word())
+    }
+
+    fn word(&mut self) -> Option<&'a str> {
+        let start = self.pos;
+        match self.peek() {
+            Some(b) if is_ident_start(b) => self.pos += 1,
+            _ => return None,
+        }
+        while matches!(self.peek(), Some(b) if is_ident_continue(b)) {
+            self.pos += 1;
+        }
+        Some(&self.src[start..self.pos])
+    }
+
+    /// Atomic `literal ~ !ASCII_ALPHANUMERIC` (simple_type, any_type, ...)
+    pub(crate) fn eat_word(&mut self, lit: &str) -> bool {
+        let save = self.pos;
+        if self.eat(lit) && self.at_word_boundary() {
+            true
+        } else {
+            self.pos = save;
+            false
+        }
+    }
+
+    /// Non-atomic `literal ~ !ASCII_ALPHANUMERIC` (self_ref, rec_ref,
+    /// null_literal): the implicit skip runs before the lookahead.
+    pub(crate) fn eat_word_skipping(&mut self, lit: &str) -> bool {
+        let save = self.pos;
+        if self.eat(lit) {
+            self.skip();
+            if self.at_word_boundary() {
+                return true;
+            }
+        }
+        self.pos = save;
+        false
+    }
+
+    /// mut_keyword = @{ "mut" ~ !ASCII_ALPHANUMERIC }
+    pub(crate) fn mut_keyword(&mut self) -> bool {
+        self.rule("mut_keyword", |p| if p.eat_word("mut") { Some(()) } else { None }).is_some()
+    }
+
+    /// Scan `number` without consuming it; returns the end offset.
+    ///
+    /// number = @{ "-"? ~ ASCII_DIGIT+ ~ ("." ~ !"." ~ ASCII_DIGIT+)? ~ (^"e" ~ ("+" | "-")? ~ ASCII_DIGIT+)? }
+    pub(crate) fn scan_number(&self, start: usize) -> Option<usize> {
+        let b = self.bytes;
+        let digits = |mut i: usize| -> usize {
+            while i < b.len() && b[i].is_ascii_digit() {
+                i += 1;
+            }
+            i
+        };
+
+        let mut i = start;
+        if b.get(i) == Some(&b'-') {
+            i += 1;
+        }
+        let int_end = digits(i);
+        if int_end == i {
+            return None;
+        }
+        i = int_end;
+
+        if b.get(i) == Some(&b'.') && b.get(i + 1) != Some(&b'.') {
+            let frac_end = digits(i + 1);
+            if frac_end > i + 1 {
+                i = frac_end;
+            }
+        }
+
+        if matches!(b.get(i), Some(b'e') | Some(b'E')) {
+            let mut j = i + 1;
+            if matches!(b.get(j), Some(b'+') | Some(b'-')) {
+                j += 1;
+            }
+            let exp_end = digits(j);
+            if exp_end > j {
+                i = exp_end;
+            }
+        }
+
+        Some(i)
+    }
+
+    /// number rule: returns the matched text
+    pub(crate) fn number(&mut self) -> Option<&'a str> {
+        self.rule("number", |p| {
+            let end = p.scan_number(p.pos)?;
+            let text = &p.src[p.pos..end];
+            p.pos = end;
+            Some(text)
+        })
+    }
+
+    /// string_literal = @{ "\"" ~ string_char* ~ "\"" }
+    ///
+    /// Returns the raw text between the quotes (escapes unprocessed).
+    pub(crate) fn string_literal(&mut self) -> Option<&'a str> {
+        self.rule("string_literal", |p| {
+            if p.peek() != Some(b'"') {
+                return None;
+            }
+            let start = p.pos + 1;
+            let mut i = start;
+            loop {
+                match p.bytes.get(i) {
+                    None => return None,
+                    Some(b'"') => break,
+                    Some(b'\\') => match p.bytes.get(i + 1) {
+                        Some(b'"') | Some(b'\\') | Some(b'n') | Some(b't') | Some(b'r') => i += 2,
+                        _ => return None,
+                    },
+                    Some(_) => i += 1,
+                }
+            }
+            p.pos = i + 1;
+            Some(&p.src[start..i])
+        })
+    }
+}
+
+/// Process escape sequences in string literals
+pub(crate) fn process_escape_sequences(s: &str) -> String {
+    if !s.contains('\\') {
+        return s.to_string();
+    }
+
+    let mut result = String::with_capacity(s.len());
+    let mut chars = s.chars();
+
+    while let Some(ch) = chars.next() {
+        if ch == '\\' {
+            if let Some(next_ch) = chars.next() {
+                match next_ch {
+                    'n' => result.push('\n'),
+                    't' => result.push('\t'),
+                    'r' => result.push('\r'),
+                    '\\' => result.push('\\'),
+                    '"' => result.push('"'),
+                    _ => {
+                        result.push('\\');
+                        result.push(next_ch);
+                    }
+                }
+            } else {
+                result.push('\\');
+            }
+        } else {
+            result.push(ch);
+        }
+    }
+
+    result
+}
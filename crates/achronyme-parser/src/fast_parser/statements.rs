@@ -0,0 +1,239 @@
+// Statements: import/export, let/mut, type aliases, return/yield/throw,
+// assignment and expression statements.
+
+use super::{Built, FastParser};
+use crate::ast::{AstNode, ImportItem};
+
+impl<'a> FastParser<'a> {
+    /// statement = { import_statement | export_statement | let_statement | mut_statement
+    ///             | type_alias_statement | return_statement | yield_statement | throw_stmt
+    ///             | assignment | expr }
+    pub(crate) fn statement(&mut self) -> Option<Built> {
+        self.rule("statement", |p| {
+            // Keyword-led statements all start with a lowercase letter
+            if matches!(p.peek(), Some(b'e' | b'i' | b'l' | b'm' | b'r' | b't' | b'y')) {
+                if let Some(node) = p.keyword_statement() {
+                    return Some(node);
+                }
+            }
+            p.assignment_or_expr()
+        })
+    }
+
+    fn keyword_statement(&mut self) -> Option<Built> {
+        match self.peek()? {
+            b'i' => self.import_statement(),
+            b'e' => self.export_statement(),
+            b'l' => self.declaration("let_statement", "let", false),
+            b'm' => self.declaration("mut_statement", "mut", true),
+            b't' => self
+                .type_alias_statement()
+                .or_else(|| self.prefixed_statement("throw_stmt", "throw", |value| AstNode::Throw { value })),
+            b'r' => self.prefixed_statement("return_statement", "return", |value| AstNode::Return { value }),
+            b'y' => self.prefixed_statement("yield_statement", "yield", |value| AstNode::Yield { value }),
+            _ => None,
+        }
+    }
+
+    /// import_statement = { "import" ~ import_list ~ "from" ~ module_path }
+    fn import_statement(&mut self) -> Option<Built> {
+        self.rule("import_statement", |p| {
+            p.expect("import")?;
+            p.skip();
+            let items = p.import_list()?;
+            p.skip();
+            p.expect("from")?;
+            p.skip();
+            let module_path = p.module_path()?;
+            Some(Ok(AstNode::Import { items, module_path }))
+        })
+    }
+
+    /// export_statement = { "export" ~ import_list }
+    fn export_statement(&mut self) -> Option<Built> {
+        self.rule("export_statement", |p| {
+            p.expect("export")?;
+            p.skip();
+            let items = p.import_list()?;
+            Some(Ok(AstNode::Export { items }))
+        })
+    }
+
+    /// import_list = { "{" ~ import_item ~ ("," ~ import_item)* ~ "}" }
+    fn import_list(&mut self) -> Option<Vec<ImportItem>> {
+        self.rule("import_list", |p| {
+            p.expect("{")?;
+            p.skip();
+            let mut items = vec![p.import_item()?];
+            loop {
+                let save = p.pos;
+                p.skip();
+                if p.eat(",") {
+                    p.skip();
+                    if let Some(item) = p.import_item() {
+                        items.push(item);
+                        continue;
+                    }
+                }
+                p.pos = save;
+                break;
+            }
+            p.skip();
+            p.expect("}")?;
+            Some(items)
+        })
+    }
+
+    /// import_item = { identifier ~ ("as" ~ identifier)? }
+    fn import_item(&mut self) -> Option<ImportItem> {
+        self.rule("import_item", |p| {
+            let name = p.identifier()?.to_string();
+            let save = p.pos;
+            p.skip();
+            let alias = if p.eat("as") {
+                p.skip();
+                match p.identifier() {
+                    Some(alias) => Some(alias.to_string()),
+                    None => {
+                        p.pos = save;
+                        None
+                    }
+                }
+            } else {
+                p.pos = save;
+                None
+            };
+            Some(ImportItem { name, alias })
+        })
+    }
+
+    /// module_path = { string_literal }
+    fn module_path(&mut self) -> Option<String> {
+        self.rule("module_path", |p| {
+            let raw = p.string_literal()?;
+            // Same escape handling as the Pest builder's extract_string_literal
+            Some(
+                raw.replace("\\n", "\n")
+                    .replace("\\t", "\t")
+                    .replace("\\r", "\r")
+                    .replace("\\\"", "\"")
+                    .replace("\\\\", "\\"),
+            )
+        })
+    }
+
+    /// let_statement = { "let" ~ identifier ~ (":" ~ type_annotation)? ~ "=" ~ expr }
+    /// mut_statement = { "mut" ~ identifier ~ (":" ~ type_annotation)? ~ "=" ~ expr }
+    fn declaration(&mut self, rule: &'static str, keyword: &'static str, mutable: bool) -> Option<Built> {
+        self.rule(rule, |p| {
+            p.expect(keyword)?;
+            p.skip();
+            let name = p.identifier()?.to_string();
+
+            let save = p.pos;
+            p.skip();
+            let type_annotation = if p.eat(":") {
+                p.skip();
+                match p.type_annotation() {
+                    Some(ty) => Some(ty),
+                    None => {
+                        p.pos = save;
+                        None
+                    }
+                }
+            } else {
+                p.pos = save;
+                None
+            };
+
+            p.skip();
+            p.expect("=")?;
+            p.skip();
+            let initializer = p.expr()?;
+
+            Some((|| {
+                let type_annotation = type_annotation.transpose()?;
+                let initializer = Box::new(initializer?);
+                Ok(if mutable {
+                    AstNode::MutableDecl { name, type_annotation, initializer }
+                } else {
+                    AstNode::VariableDecl { name, type_annotation, initializer }
+                })
+            })())
+        })
+    }
+
+    /// type_alias_statement = { "type" ~ identifier ~ "=" ~ type_annotation }
+    fn type_alias_statement(&mut self) -> Option<Built> {
+        self.rule("type_alias_statement", |p| {
+            p.expect("type")?;
+            p.skip();
+            let name = p.identifier()?.to_string();
+            p.skip();
+            p.expect("=")?;
+            p.skip();
+            let type_definition = p.type_annotation()?;
+            Some(type_definition.map(|type_definition| AstNode::TypeAlias { name, type_definition }))
+        })
+    }
+
+    /// return_statement / yield_statement / throw_stmt = { keyword ~ expr }
+    fn prefixed_statement(
+        &mut self,
+        rule: &'static str,
+        keyword: &'static str,
+        make: fn(Box<AstNode>) -> AstNode,
+    ) -> Option<Built> {
+        self.rule(rule, |p| {
+            p.expect(keyword)?;
+            p.skip();
+            let value = p.expr()?;
+            Some(value.map(|v| make(Box::new(v))))
+        })
+    }
+
+    /// assignment = { postfix_expression ~ "=" ~ expr }, falling back to expr.
+    ///
+    /// The postfix expression parsed for the assignment attempt is handed to
+    /// the expression parser through `postfix_memo`, so a plain expression
+    /// statement does not parse its leading operand twice. This is only
+    /// valid when the statement does not start with `-`: `postfix_expression`
+    /// accepts a negative number literal there, while `expr` parses a unary
+    /// negation first.
+    fn assignment_or_expr(&mut self) -> Option<Built> {
+        let start = self.pos;
+
+        let target = self.rule("assignment", |p| {
+            let target = p.postfix_expression()?;
+            let target_end = p.pos;
+            p.skip();
+            if p.eat("=") {
+                p.skip();
+                if let Some(value) = p.expr() {
+                    return Some(Ok((|| {
+                        Ok(AstNode::Assignment {
+                            target: Box::new(target?),
+                            value: Box::new(value?),
+                        })
+                    })()));
+                }
+            }
+            Some(Err((target_end, target)))
+        });
+
+        match target {
+            Some(Ok(assignment)) => Some(assignment),
+            Some(Err((target_end, target))) => {
+                // Not an assignment: undo the match and parse an expression
+                self.pos = start;
+                if self.peek() != Some(b'-') {
+                    self.postfix_memo = Some((start, target_end, target));
+                }
+                let result = self.expr();
+                self.postfix_memo = None;
+                result
+            }
+            None => self.expr(),
+        }
+    }
+}
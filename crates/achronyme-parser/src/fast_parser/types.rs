@@ -0,0 +1,248 @@
+// Type annotations: unions, simple types, Tensor<...>, record, function and
+// grouped types, Any, null and type alias references.
+
+use std::collections::HashMap;
+
+use super::{Built, FastParser};
+use crate::type_annotation::TypeAnnotation;
+
+const SIMPLE_TYPES: &[(&str, TypeAnnotation)] = &[
+    ("Number", TypeAnnotation::Number),
+    ("Boolean", TypeAnnotation::Boolean),
+    ("String", TypeAnnotation::String),
+    ("Complex", TypeAnnotation::Complex),
+    ("Generator", TypeAnnotation::Generator),
+    ("Function", TypeAnnotation::AnyFunction),
+    ("Error", TypeAnnotation::Error),
+    ("Edge", TypeAnnotation::Edge),
+];
+
+impl<'a> FastParser<'a> {
+    /// type_annotation = { union_type | simple_type_annotation }
+    /// union_type = { simple_type_annotation ~ ("|" ~ simple_type_annotation)+ }
+    pub(crate) fn type_annotation(&mut self) -> Option<Built<TypeAnnotation>> {
+        self.rule("type_annotation", |p| {
+            let first = p.simple_type_annotation()?;
+            let mut types = vec![first];
+            loop {
+                let save = p.pos;
+                p.skip();
+                if p.eat("|") {
+                    p.skip();
+                    if let Some(ty) = p.simple_type_annotation() {
+                        types.push(ty);
+                        continue;
+                    }
+                }
+                p.pos = save;
+                break;
+            }
+
+            if types.len() == 1 {
+                return types.pop();
+            }
+            Some(types.into_iter().collect::<Result<Vec<_>, _>>().map(TypeAnnotation::Union))
+        })
+    }
+
+    /// simple_type_annotation = { simple_type | tensor_type | vector_type | record_type
+    ///                          | function_type | grouped_type | any_type | null_type
+    ///                          | type_reference }
+    fn simple_type_annotation(&mut self) -> Option<Built<TypeAnnotation>> {
+        self.rule("simple_type_annotation", |p| {
+            if let Some(ty) = p.rule("simple_type", |p| {
+                SIMPLE_TYPES
+                    .iter()
+                    .find(|(name, _)| p.looking_at(name))
+                    .and_then(|(name, ty)| p.eat_word(name).then(|| ty.clone()))
+            }) {
+                return Some(Ok(ty));
+            }
+
+            if p.peek() == Some(b'T') {
+                if let Some(ty) = p.tensor_type() {
+                    return Some(ty);
+                }
+            }
+
+            if p.rule("vector_type", |p| p.eat_word("Vector").then_some(())).is_some() {
+                return Some(Ok(TypeAnnotation::Vector));
+            }
+
+            if p.peek() == Some(b'{') {
+                if let Some(ty) = p.record_type() {
+                    return Some(ty);
+                }
+            }
+
+            if p.peek() == Some(b'(') {
+                if let Some(ty) = p.function_type() {
+                    return Some(ty);
+                }
+                if let Some(ty) = p.rule("grouped_type", |p| {
+                    p.expect("(")?;
+                    p.skip();
+                    let inner = p.type_annotation()?;
+                    p.skip();
+                    p.expect(")")?;
+                    Some(inner)
+                }) {
+                    return Some(ty);
+                }
+            }
+
+            if p.rule("any_type", |p| p.eat_word("Any").then_some(())).is_some() {
+                return Some(Ok(TypeAnnotation::Any));
+            }
+
+            if p.rule("null_type", |p| p.eat_word("null").then_some(())).is_some() {
+                return Some(Ok(TypeAnnotation::Null));
+            }
+
+            let name = p.rule("type_reference", |p| p.identifier())?;
+            Some(Ok(TypeAnnotation::TypeReference(name.to_string())))
+        })
+    }
+
+    /// tensor_type = { "Tensor" ~ "<" ~ type_annotation ~ ("," ~ shape_spec)? ~ ">" }
+    fn tensor_type(&mut self) -> Option<Built<TypeAnnotation>> {
+        self.rule("tensor_type", |p| {
+            p.expect("Tensor")?;
+            p.skip();
+            p.expect("<")?;
+            p.skip();
+            let element_type = p.type_annotation()?;
+
+            let save = p.pos;
+            p.skip();
+            let shape = if p.eat(",") {
+                p.skip();
+                match p.shape_spec() {
+                    Some(shape) => Some(shape),
+                    None => {
+                        p.pos = save;
+                        None
+                    }
+                }
+            } else {
+                p.pos = save;
+                None
+            };
+
+            p.skip();
+            p.expect(">")?;
+
+            Some((|| {
+                Ok(TypeAnnotation::Tensor {
+                    element_type: Box::new(element_type?),
+                    shape: shape.transpose()?,
+                })
+            })())
+        })
+    }
+
+    /// shape_spec = { "[" ~ (dimension ~ ("," ~ dimension)*)? ~ "]" }
+    fn shape_spec(&mut self) -> Option<Built<Vec<Option<usize>>>> {
+        self.rule("shape_spec", |p| {
+            p.expect("[")?;
+            p.skip();
+            let dims = p.comma_list(Self::dimension);
+            p.skip();
+            p.expect("]")?;
+            Some(dims.into_iter().collect())
+        })
+    }
+
+    /// dimension = { number | "_" }
+    fn dimension(&mut self) -> Option<Built<Option<usize>>> {
+        self.rule("dimension", |p| {
+            if let Some(text) = p.number() {
+                return Some(
+                    text.parse::<usize>()
+                        .map(Some)
+                        .map_err(|e| format!("Invalid dimension '{}': {}", text, e)),
+                );
+            }
+            p.expect("_")?;
+            Some(Ok(None))
+        })
+    }
+
+    /// record_type = { "{" ~ NEWLINE* ~ (record_type_field ~ (NEWLINE* ~ "," ~ NEWLINE* ~ record_type_field)*)? ~ NEWLINE* ~ "}" }
+    fn record_type(&mut self) -> Option<Built<TypeAnnotation>> {
+        self.rule("record_type", |p| {
+            p.expect("{")?;
+            p.skip_nl();
+            let entries = p.nl_comma_list(Self::record_type_field);
+            p.skip_nl();
+            p.expect("}")?;
+
+            Some((|| {
+                let mut fields = HashMap::new();
+                for entry in entries {
+                    let (name, is_mutable, ty) = entry?;
+                    fields.insert(name, (is_mutable, ty));
+                }
+                Ok(TypeAnnotation::Record { fields })
+            })())
+        })
+    }
+
+    /// record_type_field = { (mut_keyword ~ identifier ~ ":" ~ type_annotation) | (identifier ~ ":" ~ type_annotation) }
+    fn record_type_field(&mut self) -> Option<Built<(String, bool, TypeAnnotation)>> {
+        self.rule("record_type_field", |p| {
+            let start = p.pos;
+            if p.mut_keyword() {
+                p.skip();
+                if let Some((name, ty)) = p.record_type_field_body() {
+                    return Some(ty.map(|ty| (name, true, ty)));
+                }
+                p.pos = start;
+            }
+            let (name, ty) = p.record_type_field_body()?;
+            Some(ty.map(|ty| (name, false, ty)))
+        })
+    }
+
+    fn record_type_field_body(&mut self) -> Option<(String, Built<TypeAnnotation>)> {
+        let start = self.pos;
+        let result = (|| {
+            let name = self.identifier()?.to_string();
+            self.skip();
+            self.expect(":")?;
+            self.skip();
+            let ty = self.type_annotation()?;
+            Some((name, ty))
+        })();
+        if result.is_none() {
+            self.pos = start;
+        }
+        result
+    }
+
+    /// function_type = { "(" ~ (type_annotation ~ ("," ~ type_annotation)*)? ~ ")" ~ ":" ~ type_annotation }
+    fn function_type(&mut self) -> Option<Built<TypeAnnotation>> {
+        self.rule("function_type", |p| {
+            p.expect("(")?;
+            p.skip();
+            let params = p.comma_list(Self::type_annotation);
+            p.skip();
+            p.expect(")")?;
+            p.skip();
+            p.expect(":")?;
+            p.skip();
+            let return_type = p.type_annotation()?;
+
+            Some((|| {
+                let params = params
+                    .into_iter()
+                    .map(|param| param.map(Some))
+                    .collect::<Result<Vec<_>, _>>()?;
+                Ok(TypeAnnotation::Function {
+                    params,
+                    return_type: Box::new(return_type?),
+                })
+            })())
+        })
+    }
+}
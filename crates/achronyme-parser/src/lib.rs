@@ -1,9 +1,15 @@
 pub mod ast;
 pub mod pest_parser;
+pub mod fast_parser;
 pub mod parser;
 pub mod type_annotation;
+pub mod symbol;
+pub mod cache;
 
 // Re-export commonly used items
 pub use pest_parser::parse;
+pub use fast_parser::parse as parse_fast;
 pub use ast::AstNode;
-pub use type_annotation::TypeAnnotation;
\ No newline at end of file
+pub use type_annotation::TypeAnnotation;
+pub use symbol::Symbol;
+pub use cache::ParseCache;
\ No newline at end of file
@@ -1,5 +1,6 @@
 use pest::iterators::Pair;
 use crate::ast::{AstNode, BinaryOp, UnaryOp};
+use crate::symbol::Symbol;
 use crate::parser::AstParser;
 use crate::pest_parser::Rule;
 
@@ -67,8 +68,8 @@ impl AstParser {
         };
 
         Ok(AstNode::Edge {
-            from,
-            to,
+            from: Symbol::intern(&from),
+            to: Symbol::intern(&to),
             directed,
             metadata,
         })
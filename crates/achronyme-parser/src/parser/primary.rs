@@ -1,5 +1,6 @@
 use pest::iterators::Pair;
 use crate::ast::AstNode;
+use crate::symbol::Symbol;
 use crate::parser::AstParser;
 use crate::pest_parser::Rule;
 
@@ -36,7 +37,7 @@ impl AstParser {
                 Ok(AstNode::ComplexLiteral { re: 0.0, im })
             }
             Rule::identifier => {
-                Ok(AstNode::VariableRef(inner.as_str().to_string()))
+                Ok(AstNode::VariableRef(Symbol::intern(inner.as_str())))
             }
             Rule::self_ref => {
                 Ok(AstNode::SelfReference)
@@ -0,0 +1,297 @@
+//! Interned identifiers
+//!
+//! A `Symbol` is a 4-byte handle to a string stored once in a process-wide
+//! interner. Comparing and hashing symbols compares and hashes the handle,
+//! so identifier lookups (environment slots, function names, edge endpoints)
+//! never touch the string bytes once a name has been interned.
+//!
+//! Resolving a handle (`as_str`) is lock-free: names sit in an append-only
+//! table of geometrically growing chunks, indexed by id, whose slots are
+//! written once. Name-to-handle maps are split into shards, each behind its
+//! own lock, so interning on one thread rarely blocks another.
+//!
+//! Interned strings live for the rest of the process. Interning is meant for
+//! identifiers that appear in source code, not for runtime strings such as
+//! the node IDs of a network record.
+
+use serde::{Deserialize, Deserializer, Serialize, Serializer};
+use std::collections::hash_map::DefaultHasher;
+use std::collections::HashMap;
+use std::fmt;
+use std::hash::{Hash, Hasher};
+use std::ops::Deref;
+use std::sync::atomic::{AtomicU32, Ordering};
+use std::sync::{OnceLock, RwLock};
+
+/// Handle to an interned string
+///
+/// `Eq` and `Hash` use the handle; `Ord` uses the string, so sorting symbols
+/// gives the same order as sorting their names.
+#[derive(Clone, Copy, PartialEq, Eq, Hash)]
+pub struct Symbol(u32);
+
+/// Name-to-handle shards; a power of two
+const SHARDS: usize = 16;
+
+/// Slots in the first name chunk, as a power of two; chunk `k` has
+/// `1 << (FIRST_CHUNK_BITS + k)` slots
+const FIRST_CHUNK_BITS: u32 = 8;
+
+/// Chunks needed to cover every `u32` id
+const CHUNKS: usize = (33 - FIRST_CHUNK_BITS) as usize;
+
+type Chunk = Box<[OnceLock<&'static str>]>;
+
+struct Interner {
+    shards: [RwLock<HashMap<&'static str, u32>>; SHARDS],
+    names: [OnceLock<Chunk>; CHUNKS],
+    next_id: AtomicU32,
+}
+
+fn interner() -> &'static Interner {
+    static INTERNER: OnceLock<Interner> = OnceLock::new();
+    INTERNER.get_or_init(|| Interner {
+        shards: std::array::from_fn(|_| RwLock::new(HashMap::new())),
+        names: std::array::from_fn(|_| OnceLock::new()),
+        next_id: AtomicU32::new(0),
+    })
+}
+
+impl Interner {
+    fn shard(&self, name: &str) -> &RwLock<HashMap<&'static str, u32>> {
+        let mut hasher = DefaultHasher::new();
+        name.hash(&mut hasher);
+        &self.shards[hasher.finish() as usize & (SHARDS - 1)]
+    }
+
+    /// Chunk and offset of the slot for `id`
+    fn slot_position(id: u32) -> (usize, usize) {
+        let n = id as u64 + (1 << FIRST_CHUNK_BITS);
+        let chunk = 63 - n.leading_zeros() - FIRST_CHUNK_BITS;
+        (chunk as usize, (n - (1 << (FIRST_CHUNK_BITS + chunk))) as usize)
+    }
+
+    fn slot(&self, id: u32) -> &OnceLock<&'static str> {
+        let (chunk, offset) = Self::slot_position(id);
+        let chunk = self.names[chunk].get_or_init(|| {
+            let len = 1usize << (FIRST_CHUNK_BITS as usize + chunk);
+            (0..len).map(|_| OnceLock::new()).collect()
+        });
+        &chunk[offset]
+    }
+}
+
+impl Symbol {
+    /// Intern `name`, returning the existing symbol if it was seen before
+    pub fn intern(name: &str) -> Symbol {
+        let interner = interner();
+        let shard = interner.shard(name);
+        if let Some(&id) = shard.read().unwrap_or_else(|e| e.into_inner()).get(name) {
+            return Symbol(id);
+        }
+
+        let mut ids = shard.write().unwrap_or_else(|e| e.into_inner());
+        // Another thread may have interned it between the two locks
+        if let Some(&id) = ids.get(name) {
+            return Symbol(id);
+        }
+        let id = interner.next_id.fetch_add(1, Ordering::Relaxed);
+        assert!(id != u32::MAX, "symbol table overflow");
+        let name: &'static str = Box::leak(name.to_owned().into_boxed_str());
+        // The slot is filled before the id can be seen by anyone else
+        let _ = interner.slot(id).set(name);
+        ids.insert(name, id);
+        Symbol(id)
+    }
+
+    /// The symbol for `name` if it has been interned, without interning it
+    ///
+    /// A name that was never interned cannot be bound anywhere, so lookups by
+    /// string use this to fail fast instead of growing the table.
+    pub fn lookup(name: &str) -> Option<Symbol> {
+        let ids = interner().shard(name).read().unwrap_or_else(|e| e.into_inner());
+        ids.get(name).map(|&id| Symbol(id))
+    }
+
+    /// The interned string
+    pub fn as_str(self) -> &'static str {
+        interner().slot(self.0).get().expect("symbols are only created by interning")
+    }
+
+    /// The raw handle, dense from 0 in interning order
+    pub fn id(self) -> u32 {
+        self.0
+    }
+}
+
+impl Deref for Symbol {
+    type Target = str;
+
+    fn deref(&self) -> &str {
+        self.as_str()
+    }
+}
+
+impl AsRef<str> for Symbol {
+    fn as_ref(&self) -> &str {
+        self.as_str()
+    }
+}
+
+impl From<&str> for Symbol {
+    fn from(name: &str) -> Self {
+        Symbol::intern(name)
+    }
+}
+
+impl From<String> for Symbol {
+    fn from(name: String) -> Self {
+        Symbol::intern(&name)
+    }
+}
+
+impl From<&String> for Symbol {
+    fn from(name: &String) -> Self {
+        Symbol::intern(name)
+    }
+}
+
+impl From<Symbol> for String {
+    fn from(symbol: Symbol) -> Self {
+        symbol.as_str().to_string()
+    }
+}
+
+impl PartialEq<str> for Symbol {
+    fn eq(&self, other: &str) -> bool {
+        self.as_str() == other
+    }
+}
+
+impl PartialEq<&str> for Symbol {
+    fn eq(&self, other: &&str) -> bool {
+        self.as_str() == *other
+    }
+}
+
+impl PartialEq<String> for Symbol {
+    fn eq(&self, other: &String) -> bool {
+        self.as_str() == other
+    }
+}
+
+impl PartialOrd for Symbol {
+    fn partial_cmp(&self, other: &Self) -> Option<std::cmp::Ordering> {
+        Some(self.cmp(other))
+    }
+}
+
+impl Ord for Symbol {
+    fn cmp(&self, other: &Self) -> std::cmp::Ordering {
+        if self.0 == other.0 {
+            return std::cmp::Ordering::Equal;
+        }
+        self.as_str().cmp(other.as_str())
+    }
+}
+
+impl fmt::Debug for Symbol {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        fmt::Debug::fmt(self.as_str(), f)
+    }
+}
+
+impl fmt::Display for Symbol {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.write_str(self.as_str())
+    }
+}
+
+/// Symbols serialize as their name: handles are only meaningful inside the
+/// process that interned them
+impl Serialize for Symbol {
+    fn serialize<S: Serializer>(&self, serializer: S) -> Result<S::Ok, S::Error> {
+        serializer.serialize_str(self.as_str())
+    }
+}
+
+impl<'de> Deserialize<'de> for Symbol {
+    fn deserialize<D: Deserializer<'de>>(deserializer: D) -> Result<Self, D::Error> {
+        let name = String::deserialize(deserializer)?;
+        Ok(Symbol::intern(&name))
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_interning_is_idempotent() {
+        let a = Symbol::intern("symbol_test_alpha");
+        let b = Symbol::intern(&String::from("symbol_test_alpha"));
+        assert_eq!(a, b);
+        assert_eq!(a.as_str(), "symbol_test_alpha");
+        assert_ne!(a, Symbol::intern("symbol_test_beta"));
+    }
+
+    #[test]
+    fn test_lookup_does_not_intern() {
+        assert_eq!(Symbol::lookup("symbol_test_never_interned"), None);
+        let s = Symbol::intern("symbol_test_interned");
+        assert_eq!(Symbol::lookup("symbol_test_interned"), Some(s));
+    }
+
+    #[test]
+    fn test_ordering_follows_names() {
+        let z = Symbol::intern("symbol_test_z");
+        let a = Symbol::intern("symbol_test_a");
+        let mut symbols = vec![z, a];
+        symbols.sort();
+        assert_eq!(symbols, vec![a, z]);
+    }
+
+    #[test]
+    fn test_string_comparisons_and_display() {
+        let s = Symbol::intern("node_1");
+        assert!(s == "node_1");
+        assert!(s == "node_1".to_string());
+        assert_eq!(format!("{} {:?}", s, s), "node_1 \"node_1\"");
+        assert!(s.starts_with("node"));
+    }
+
+    #[test]
+    fn test_slot_positions_tile_the_id_space() {
+        assert_eq!(Interner::slot_position(0), (0, 0));
+        assert_eq!(Interner::slot_position(255), (0, 255));
+        assert_eq!(Interner::slot_position(256), (1, 0));
+        assert_eq!(Interner::slot_position(767), (1, 511));
+        assert_eq!(Interner::slot_position(768), (2, 0));
+        assert_eq!(Interner::slot_position(u32::MAX - 1), (CHUNKS - 1, 254));
+    }
+
+    #[test]
+    fn test_concurrent_interning() {
+        let handles: Vec<_> = (0..4)
+            .map(|_| std::thread::spawn(|| Symbol::intern("symbol_test_shared")))
+            .collect();
+        let symbols: Vec<Symbol> = handles.into_iter().map(|h| h.join().unwrap()).collect();
+        assert!(symbols.windows(2).all(|w| w[0] == w[1]));
+    }
+
+    #[test]
+    fn test_concurrent_interning_of_distinct_names() {
+        let handles: Vec<_> = (0..4)
+            .map(|t| {
+                std::thread::spawn(move || {
+                    (0..500).map(|i| Symbol::intern(&format!("symbol_test_{}_{}", t, i))).collect::<Vec<_>>()
+                })
+            })
+            .collect();
+        for (t, handle) in handles.into_iter().enumerate() {
+            for (i, symbol) in handle.join().unwrap().into_iter().enumerate() {
+                assert_eq!(symbol.as_str(), format!("symbol_test_{}_{}", t, i));
+            }
+        }
+    }
+}
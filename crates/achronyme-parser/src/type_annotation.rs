@@ -13,10 +13,11 @@
 // - Null type for optional values
 // - Any type (opt-out of type checking)
 
+use serde::{Deserialize, Serialize};
 use std::collections::HashMap;
 
 /// Type annotation for gradual typing system (AST representation)
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum TypeAnnotation {
     /// Number type (f64)
     Number,
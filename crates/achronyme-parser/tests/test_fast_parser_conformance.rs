@@ -0,0 +1,174 @@
+// ============================================================================
+// Fast Parser Conformance Tests
+// ============================================================================
+// The hand-written parser must produce exactly the AST of the Pest pipeline
+// and reject exactly the inputs it rejects.
+
+use achronyme_parser::{fast_parser, pest_parser};
+use std::fs;
+use std::path::{Path, PathBuf};
+
+fn assert_conforms(source: &str) {
+    let expected = pest_parser::parse(source);
+    let actual = fast_parser::parse(source);
+    match (&expected, &actual) {
+        (Ok(expected), Ok(actual)) => assert_eq!(actual, expected, "AST mismatch for:\n{}", source),
+        (Err(_), Err(_)) => {}
+        _ => panic!(
+            "Parsers disagree on:\n{}\npest: {:?}\nfast: {:?}",
+            source, expected, actual
+        ),
+    }
+}
+
+#[test]
+fn test_literals_and_operators() {
+    for source in [
+        "42",
+        "3.14e-2",
+        "-5",
+        "- 5",
+        "--5",
+        "2i",
+        "3 + 4i",
+        "true && !false || x",
+        "\"line\\n\\ttab \\\"quoted\\\"\"",
+        "null",
+        "1 + 2 * 3 - 4 / 5 % 6",
+        "2 ^ 3 ^ 2",
+        "-2 ^ 2",
+        "a < b && c >= d || e != f",
+        "a < b < c",
+        "a == b == c",
+        "1 +",
+        "a - -b",
+        "a -> b",
+        "a <> b : 5",
+        "a -> b : {weight: 3}",
+        "a - > b",
+        "a + b -> c",
+        "a < b -> c",
+        "(1 + 2) * 3",
+        "f(1, 2)(3)",
+        "m[1, 2..3, ..4, 5.., ..]",
+        "r.field.inner",
+        "if(x > 0, 1, -1)",
+        "if(x, 1)",
+        "piecewise([x < 0, -x], [x < 1, x^2], 1)",
+    ] {
+        assert_conforms(source);
+    }
+}
+
+#[test]
+fn test_collections() {
+    for source in [
+        "[]",
+        "[1, 2, 3]",
+        "[1, -2.5, 3e-2, -4E+1]",
+        "[1 - 2, 3]",
+        "[-2^2, 1]",
+        "[1, 2i]",
+        "[1.x]",
+        "[\n  1,\n  2\n]",
+        "[[1, 2], [3, 4]]",
+        "[[1, 2], [3]]",
+        "[[1, 2] [0], [3, 4]]",
+        "[[1, -2], [3, x]]",
+        "[[[1], [2]], [[3], [4]]]",
+        "[[1].x]",
+        "[1, ...v, 2]",
+        "[a, f(b), [c]]",
+        "{ a: 1, mut b: 2, ...rest }",
+        "{\n  name: \"x\",\n  f: () => self.name\n}",
+        "{}",
+    ] {
+        assert_conforms(source);
+    }
+}
+
+#[test]
+fn test_statements_and_blocks() {
+    for source in [
+        "let x = 1",
+        "let x: Number = 1; mut y = 2\nx + y",
+        "let t: Tensor<Number, [2, _]> = [[1, 2], [3, 4]]",
+        "let r: { mut a: Number, b: String | null } = { a: 1, b: null }",
+        "let f: (Number, String) => Boolean = (n, s) => true",
+        "type Point = { x: Number, y: Number }",
+        "mut v = [1, 2]\nv[0] = 5\nv",
+        "obj.field = 3",
+        "import { sin, mean as average } from \"math\"",
+        "export { foo, bar as baz }",
+        "return 5",
+        "do { let a = 1; a + 1 }",
+        "while(i < 10) { i = i + 1 }",
+        "for(x in xs) { total = total + x }",
+        "generate { yield 1; yield 2 }",
+        "try { throw \"boom\" } catch(e) { e.message }",
+        "let x = 1 // trailing comment\nx",
+        "let = ",
+        "let x = (1",
+    ] {
+        assert_conforms(source);
+    }
+}
+
+#[test]
+fn test_lambdas_and_matching() {
+    for source in [
+        "x => x * 2",
+        "(x, y) => x + y",
+        "(x: Number, y): Number => x + y",
+        "() => 42",
+        "rec(n - 1)",
+        "(x => x + 1)(2)",
+        "match x { 0 => \"zero\", n if n > 0 => \"pos\", _ => \"neg\" }",
+        "match p { { x: 0, y } => y, [a, b, ...rest] => a, Number => 1, _ => 0 }",
+        "match 1 {\n    a if b => c\n}",
+        "match v { \"s\" => true, false => 0, 3.5 => 1 }",
+    ] {
+        assert_conforms(source);
+    }
+}
+
+#[test]
+fn test_large_numeric_literal() {
+    let rows: Vec<String> = (0..200)
+        .map(|i| {
+            let row: Vec<String> = (0..50).map(|j| format!("{}", (i * 50 + j) as f64 * if j % 3 == 0 { -0.5 } else { 1.25 })).collect();
+            format!("[{}]", row.join(", "))
+        })
+        .collect();
+    assert_conforms(&format!("let data = [\n{}\n]\ndata", rows.join(",\n")));
+}
+
+/// Every `.soc` file under `dir`, recursively
+fn soc_files(dir: &Path, files: &mut Vec<PathBuf>) {
+    let entries = match fs::read_dir(dir) {
+        Ok(entries) => entries,
+        Err(_) => return,
+    };
+    for entry in entries.flatten() {
+        let path = entry.path();
+        if path.is_dir() {
+            soc_files(&path, files);
+        } else if path.extension().map_or(false, |ext| ext == "soc") {
+            files.push(path);
+        }
+    }
+}
+
+#[test]
+fn test_repository_scripts() {
+    let root = Path::new(env!("CARGO_MANIFEST_DIR")).join("../..");
+    let mut files = Vec::new();
+    soc_files(&root.join("examples"), &mut files);
+    soc_files(&root.join("crates/achronyme-eval/tests"), &mut files);
+    assert!(!files.is_empty(), "no .soc scripts found under {}", root.display());
+
+    for file in files {
+        let source = fs::read_to_string(&file).unwrap();
+        assert_conforms(&source);
+    }
+}
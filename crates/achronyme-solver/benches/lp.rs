@@ -0,0 +1,129 @@
+use achronyme_solver::{
+    binary_linprog, intlinprog, intlinprog_with_options, revised_simplex_solve, revised_simplex_solve_sparse, simplex_solve,
+    BranchBoundOptions, CscMatrix, NodeSelection,
+};
+use achronyme_types::tensor::RealTensor;
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion};
+
+/// `max c^T x  s.t.  A x <= b, x >= 0`
+struct Lp {
+    c: Vec<f64>,
+    a: RealTensor,
+    b: Vec<f64>,
+}
+
+/// Wyndor Glass (Hillier & Lieberman)
+fn wyndor() -> Lp {
+    Lp {
+        c: vec![3.0, 5.0],
+        a: RealTensor::matrix(3, 2, vec![1.0, 0.0, 0.0, 2.0, 3.0, 2.0]).unwrap(),
+        b: vec![4.0, 12.0, 18.0],
+    }
+}
+
+/// Dense `m x n` resource-allocation LP with a bounded, non-degenerate optimum
+fn dense(m: usize, n: usize) -> Lp {
+    let a: Vec<f64> = (0..m * n).map(|i| 1.0 + ((i * 7919) % 97) as f64 / 10.0).collect();
+    let b = (0..m).map(|i| a[i * n..(i + 1) * n].iter().sum::<f64>() * 0.5).collect();
+    let c = (0..n).map(|j| 1.0 + ((j * 31) % 11) as f64).collect();
+    Lp { c, a: RealTensor::matrix(m, n, a).unwrap(), b }
+}
+
+/// Block-sparse `m x n` LP: every column touches 3 consecutive rows
+fn sparse_triplets(m: usize, n: usize) -> (Vec<f64>, Vec<(usize, usize, f64)>, Vec<f64>) {
+    let mut triplets = Vec::with_capacity(3 * n);
+    for j in 0..n {
+        for k in 0..3 {
+            triplets.push(((j * m / n + k) % m, j, 1.0 + ((j * 13 + k * 7) % 5) as f64));
+        }
+    }
+    let c = (0..n).map(|j| 1.0 + ((j * 31) % 11) as f64).collect();
+    let b = (0..m).map(|i| 10.0 + (i % 7) as f64).collect();
+    (c, triplets, b)
+}
+
+fn sparse(m: usize, n: usize) -> Lp {
+    let (c, triplets, b) = sparse_triplets(m, n);
+    let mut a = vec![0.0; m * n];
+    for (i, j, value) in triplets {
+        a[i * n + j] += value;
+    }
+    Lp { c, a: RealTensor::matrix(m, n, a).unwrap(), b }
+}
+
+fn bench_simplex(c: &mut Criterion) {
+    let mut group = c.benchmark_group("solver/simplex");
+    let instances = [("wyndor".to_string(), wyndor()), ("dense_10x10".to_string(), dense(10, 10)), ("dense_40x60".to_string(), dense(40, 60)), ("sparse_300x450".to_string(), sparse(300, 450))];
+    for (name, lp) in &instances {
+        group.bench_with_input(BenchmarkId::new("tableau", name), lp, |bench, lp| {
+            bench.iter(|| simplex_solve(black_box(&lp.c), black_box(&lp.a), black_box(&lp.b), 1.0).unwrap())
+        });
+        group.bench_with_input(BenchmarkId::new("revised", name), lp, |bench, lp| {
+            bench.iter(|| revised_simplex_solve(black_box(&lp.c), black_box(&lp.a), black_box(&lp.b), 1.0).unwrap())
+        });
+    }
+
+    // Large sparse model built directly in CSC form (too big for the tableau)
+    let (c_sparse, triplets, b_sparse) = sparse_triplets(1000, 1500);
+    let a_sparse = CscMatrix::from_triplets(1000, 1500, &triplets).unwrap();
+    group.bench_function("revised/sparse_1000x1500", |bench| {
+        bench.iter(|| revised_simplex_solve_sparse(black_box(&c_sparse), black_box(&a_sparse), black_box(&b_sparse), 1.0).unwrap())
+    });
+    group.finish();
+}
+
+fn bench_intlinprog(c: &mut Criterion) {
+    let mut group = c.benchmark_group("solver/intlinprog");
+
+    let lp = wyndor();
+    group.bench_function("wyndor", |bench| {
+        bench.iter(|| intlinprog(black_box(&lp.c), black_box(&lp.a), black_box(&lp.b), 1.0, &[0, 1]).unwrap())
+    });
+
+    // 0/1 knapsack
+    let c = vec![60.0, 100.0, 120.0, 80.0, 30.0, 70.0];
+    let a = RealTensor::matrix(1, 6, vec![10.0, 20.0, 30.0, 25.0, 5.0, 15.0]).unwrap();
+    let b = vec![60.0];
+    let binary_vars: Vec<usize> = (0..6).collect();
+    group.bench_function("knapsack_6", |bench| {
+        bench.iter(|| binary_linprog(black_box(&c), black_box(&a), black_box(&b), 1.0, &binary_vars).unwrap())
+    });
+
+    // California Manufacturing (Hillier & Lieberman): 0/1 with precedence rows
+    let c = vec![9.0, 5.0, 6.0, 4.0];
+    let a = RealTensor::matrix(4, 4, vec![
+        6.0, 3.0, 5.0, 2.0,
+        0.0, 0.0, 1.0, 1.0,
+        -1.0, 0.0, 1.0, 0.0,
+        0.0, -1.0, 0.0, 1.0,
+    ]).unwrap();
+    let b = vec![10.0, 1.0, 0.0, 0.0];
+    group.bench_function("california_manufacturing", |bench| {
+        bench.iter(|| binary_linprog(black_box(&c), black_box(&a), black_box(&b), 1.0, &[0, 1, 2, 3]).unwrap())
+    });
+
+    // General-integer resource allocation: the tree is large enough for node
+    // selection and worker count to matter
+    let lp = dense(12, 20);
+    let integer_vars: Vec<usize> = (0..20).collect();
+    let selections = [
+        ("best_bound", NodeSelection::BestBound),
+        ("depth_first", NodeSelection::DepthFirst),
+        ("hybrid", NodeSelection::Hybrid),
+    ];
+    for (name, node_selection) in selections {
+        for threads in [1, 4] {
+            let options = BranchBoundOptions { node_selection, threads, max_nodes: 1_000_000 };
+            group.bench_with_input(BenchmarkId::new(format!("dense_12x20/{}", name), threads), &options, |bench, options| {
+                bench.iter(|| {
+                    intlinprog_with_options(black_box(&lp.c), black_box(&lp.a), black_box(&lp.b), 1.0, &integer_vars, options)
+                        .unwrap()
+                })
+            });
+        }
+    }
+    group.finish();
+}
+
+criterion_group!(benches, bench_simplex, bench_intlinprog);
+criterion_main!(benches);
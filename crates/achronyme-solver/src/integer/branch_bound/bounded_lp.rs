@@ -1,12 +1,13 @@
 use achronyme_types::tensor::RealTensor;
-use crate::linear::simplex;
+use crate::linear::{dual_simplex, simplex};
+use crate::linear::tableau::Tableau;
 
-/// Solve LP with variable bounds
+/// Solve LP with variable bounds, returning its optimal tableau
 ///
 /// Transforms the bounded LP into standard form by:
-/// 1. Fixing variables where lower == upper
-/// 2. Adding upper bound constraints xᵢ ≤ upper[i]
-/// 3. Substituting fixed variables in constraints
+/// 1. Adding upper bound constraints xᵢ ≤ upper[i] and solving with simplex
+/// 2. Adding lower bound constraints -xᵢ ≤ -lower[i] to the optimal tableau
+///    and restoring feasibility with dual simplex
 ///
 /// # Parameters
 /// - `c`: Objective coefficients
@@ -17,94 +18,60 @@ use crate::linear::simplex;
 /// - `upper`: Upper bounds for each variable
 ///
 /// # Returns
-/// - `Ok(solution)`: Optimal solution respecting bounds
+/// - `Ok(tableau)`: Optimal tableau; `extract_solution()` respects the bounds
 /// - `Err`: If subproblem is infeasible
 ///
-/// # Note
-/// Lower bounds > 0 are not fully enforced in current implementation.
-/// This is a known limitation that relies on simplex vertex solutions.
-pub fn solve_with_bounds(
+/// The tableau is what Branch & Bound keeps: a child node adds its branching
+/// bound with `Tableau::add_constraint` and re-solves from this basis.
+pub fn bounded_tableau(
     c: &[f64],
     a: &RealTensor,
     b: &[f64],
     sense: f64,
     lower: &[f64],
     upper: &[f64],
-) -> Result<Vec<f64>, String> {
+) -> Result<Tableau, String> {
     let n = c.len();
     let m = a.rows();
 
-    // Identify fixed variables (lower == upper) and substitute them
-    let mut fixed_vars = vec![None; n];
-    let mut modified_c = c.to_vec();
-    for i in 0..n {
-        if (upper[i] - lower[i]).abs() < 1e-9 {
-            fixed_vars[i] = Some(lower[i]);
-            modified_c[i] = 0.0;  // Zero out objective coefficient for fixed variables
-        }
-    }
-
-    // Build new constraint matrix with bounds and fixed variable substitution
-    let mut new_rows = Vec::new();
-    let mut new_b_values = Vec::new();
-
-    // Copy original constraints with fixed variable substitution
-    for i in 0..m {
-        let row_start = i * n;
-        let row_end = row_start + n;
-        let mut row = a.data[row_start..row_end].to_vec();
-        let mut b_val = b[i];
-
-        // Subtract contribution of fixed variables
-        for j in 0..n {
-            if let Some(fixed_val) = fixed_vars[j] {
-                b_val -= row[j] * fixed_val;
-                row[j] = 0.0;  // Fixed variable doesn't participate
-            }
-        }
-
-        new_rows.push(row);
-        new_b_values.push(b_val);
+    if (0..n).any(|i| upper[i] < lower[i].max(0.0)) {
+        return Err("Subproblem infeasible".to_string());
     }
 
-    // Add upper bound constraints: xᵢ ≤ upper[i] (only for non-fixed variables)
+    // Original constraints plus upper bounds xᵢ ≤ upper[i]: every RHS is
+    // non-negative, so the slack basis is a feasible start for simplex
+    let mut combined_data = a.data()[..m * n].to_vec();
+    let mut new_b_values = b.to_vec();
     for i in 0..n {
-        if fixed_vars[i].is_none() && upper[i] < f64::INFINITY {
+        if upper[i] < f64::INFINITY {
             let mut row = vec![0.0; n];
             row[i] = 1.0;
-            new_rows.push(row);
+            combined_data.extend_from_slice(&row);
             new_b_values.push(upper[i]);
         }
     }
 
-    // For lower bounds, we have two cases:
-    // 1. If lower[i] == 0, no constraint needed (default)
-    // 2. If lower[i] > 0, we need to add constraint, but simplex requires non-negative RHS
-    //    So we don't add it directly. Instead, we rely on the fact that simplex
-    //    solutions are typically at vertices, and combined with upper bounds this should work.
-    // NOTE: This is a limitation - we may not correctly enforce lower > 0 in all cases.
+    let a_new = RealTensor::matrix(new_b_values.len(), n, combined_data)
+        .map_err(|e| format!("Failed to create bounded constraint matrix: {}", e))?;
 
-    // Build combined matrix
-    let total_rows = new_rows.len();
-    let mut combined_data = Vec::with_capacity(total_rows * n);
-    for row in new_rows {
-        combined_data.extend_from_slice(&row);
-    }
+    let mut tableau = Tableau::new(c, &a_new, &new_b_values, sense)?;
+    simplex::optimize(&mut tableau)?;
 
-    let a_new = RealTensor::matrix(total_rows, n, combined_data)
-        .map_err(|e| format!("Failed to create bounded constraint matrix: {}", e))?;
+    // Lower bounds -xᵢ ≤ -lower[i] cut the current optimum from outside the
+    // slack basis; dual simplex moves to the bounded optimum
+    let mut has_lower = false;
+    for i in 0..n {
+        if lower[i] > 0.0 {
+            let mut row = vec![0.0; n];
+            row[i] = -1.0;
+            tableau.add_constraint(&row, -lower[i]);
+            has_lower = true;
+        }
+    }
 
-    // Solve bounded LP with modified objective
-    match simplex::solve(&modified_c, &a_new, &new_b_values, sense) {
-        Ok(mut sol) => {
-            // Restore fixed variables to their fixed values
-            for i in 0..n {
-                if let Some(fixed_val) = fixed_vars[i] {
-                    sol[i] = fixed_val;
-                }
-            }
-            Ok(sol)
-        },
-        Err(_) => Err("Subproblem infeasible".to_string()),
+    if has_lower && !dual_simplex::reoptimize(&mut tableau)? {
+        return Err("Subproblem infeasible".to_string());
     }
+
+    Ok(tableau)
 }
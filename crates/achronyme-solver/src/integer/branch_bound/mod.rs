@@ -5,14 +5,18 @@
 //! - Binary Linear Programming (0-1 ILP)
 //!
 //! The implementation uses the Branch & Bound algorithm with LP relaxation.
+//! Child LPs are warm-started from their parent's optimal tableau with dual
+//! simplex, and the tree is explored by a pool of worker threads.
 
 mod node;
 mod helpers;
 mod bounded_lp;
+mod search;
 mod solvers;
 
 // Re-export public API
-pub use solvers::{intlinprog, binary_linprog};
+pub use search::{BranchBoundOptions, NodeSelection};
+pub use solvers::{intlinprog, intlinprog_with_options, binary_linprog, binary_linprog_with_options};
 
 #[cfg(test)]
 mod tests {
@@ -223,4 +227,136 @@ mod tests {
         // Optimal: x = [3, 2] with z = 17 (constraints: 2*3+3*2=12≤12, 3+2=5≤5)
         assert!((z - 17.0).abs() < 1e-3, "Expected z = 17, got z = {}", z);
     }
+
+    /// California Manufacturing (Hillier & Lieberman): 0/1 with precedence
+    /// constraints between the decisions
+    /// maximize z = 9x₁ + 5x₂ + 6x₃ + 4x₄
+    /// subject to: 6x₁ + 3x₂ + 5x₃ + 2x₄ ≤ 10, x₃ + x₄ ≤ 1, x₃ ≤ x₁, x₄ ≤ x₂
+    fn california_manufacturing() -> (Vec<f64>, RealTensor, Vec<f64>) {
+        let c = vec![9.0, 5.0, 6.0, 4.0];
+        let a = RealTensor::matrix(4, 4, vec![
+            6.0, 3.0, 5.0, 2.0,
+            0.0, 0.0, 1.0, 1.0,
+            -1.0, 0.0, 1.0, 0.0,
+            0.0, -1.0, 0.0, 1.0,
+        ]).unwrap();
+        (c, a, vec![10.0, 1.0, 0.0, 0.0])
+    }
+
+    fn all_options() -> Vec<BranchBoundOptions> {
+        let mut options = Vec::new();
+        for node_selection in [NodeSelection::BestBound, NodeSelection::DepthFirst, NodeSelection::Hybrid] {
+            for threads in [1, 4] {
+                options.push(BranchBoundOptions { node_selection, threads, ..Default::default() });
+            }
+        }
+        options
+    }
+
+    #[test]
+    fn test_binary_linprog_precedence_constraints() {
+        let (c, a, b) = california_manufacturing();
+
+        for options in all_options() {
+            let solution = binary_linprog_with_options(&c, &a, &b, 1.0, &[0, 1, 2, 3], &options).unwrap();
+
+            // Optimal: x = [1, 1, 0, 0], z = 14
+            let z = simplex::objective_value(&c, &solution).unwrap();
+            assert!((z - 14.0).abs() < 1e-6, "{:?}: expected z = 14, got z = {}", options, z);
+            for (x, expected) in solution.iter().zip([1.0, 1.0, 0.0, 0.0]) {
+                assert!((x - expected).abs() < 1e-6, "{:?}: x = {:?}", options, solution);
+            }
+        }
+    }
+
+    #[test]
+    fn test_node_selection_strategies_agree() {
+        // General integers with several fractional branchings
+        // maximize z = 5x₁ + 4x₂ + 3x₃
+        // subject to: 2x₁ + 3x₂ + x₃ ≤ 5.5, 4x₁ + x₂ + 2x₃ ≤ 11.3, 3x₁ + 4x₂ + 2x₃ ≤ 8.7
+        let c = vec![5.0, 4.0, 3.0];
+        let a = RealTensor::matrix(3, 3, vec![2.0, 3.0, 1.0, 4.0, 1.0, 2.0, 3.0, 4.0, 2.0]).unwrap();
+        let b = vec![5.5, 11.3, 8.7];
+        let integer_vars = vec![0, 1, 2];
+
+        let reference = intlinprog_with_options(
+            &c, &a, &b, 1.0, &integer_vars,
+            &BranchBoundOptions { node_selection: NodeSelection::DepthFirst, threads: 1, ..Default::default() },
+        ).unwrap();
+        let z_reference = simplex::objective_value(&c, &reference).unwrap();
+        // x = [2, 0, 1] or [1, 0, 2]... best is z = 13 (x₁ = 2, x₃ = 1)
+        assert!((z_reference - 13.0).abs() < 1e-6, "Expected z = 13, got z = {}", z_reference);
+
+        for options in all_options() {
+            let solution = intlinprog_with_options(&c, &a, &b, 1.0, &integer_vars, &options).unwrap();
+            let z = simplex::objective_value(&c, &solution).unwrap();
+            assert!((z - z_reference).abs() < 1e-6, "{:?}: z = {}", options, z);
+        }
+    }
+
+    #[test]
+    fn test_parallel_ties_are_deterministic() {
+        // maximize z = x₁ + ... + x₆ over binaries with x₁ + ... + x₆ ≤ 3.5:
+        // the 20 ways of picking three variables are all optimal, and every
+        // run must return the lexicographically smallest
+        let c = vec![1.0; 6];
+        let a = RealTensor::matrix(1, 6, vec![1.0; 6]).unwrap();
+        let b = vec![3.5];
+        let binaries: Vec<usize> = (0..6).collect();
+
+        for node_selection in [NodeSelection::BestBound, NodeSelection::DepthFirst, NodeSelection::Hybrid] {
+            let options = BranchBoundOptions { node_selection, threads: 4, ..Default::default() };
+            let first = binary_linprog_with_options(&c, &a, &b, 1.0, &binaries, &options).unwrap();
+            let z = simplex::objective_value(&c, &first).unwrap();
+            assert!((z - 3.0).abs() < 1e-6, "{:?}: z = {}", options, z);
+            assert_eq!(first, vec![0.0, 0.0, 0.0, 1.0, 1.0, 1.0], "{:?}", options);
+
+            for _ in 0..20 {
+                let solution = binary_linprog_with_options(&c, &a, &b, 1.0, &binaries, &options).unwrap();
+                assert_eq!(solution, first, "{:?}", options);
+            }
+        }
+    }
+
+    #[test]
+    fn test_intlinprog_prunes_infeasible_branches() {
+        // maximize z = x₁ + x₂ subject to 2x₁ ≤ 3, 2x₂ ≤ 3:
+        // the x ≥ 2 branches are infeasible and must be pruned, not abort
+        let c = vec![1.0, 1.0];
+        let a = RealTensor::matrix(2, 2, vec![2.0, 0.0, 0.0, 2.0]).unwrap();
+        let b = vec![3.0, 3.0];
+
+        for options in all_options() {
+            let solution = intlinprog_with_options(&c, &a, &b, 1.0, &[0, 1], &options).unwrap();
+            assert!((solution[0] - 1.0).abs() < 1e-6 && (solution[1] - 1.0).abs() < 1e-6, "x = {:?}", solution);
+        }
+    }
+
+    #[test]
+    fn test_bounded_lp_enforces_lower_bounds() {
+        // maximize z = -x₁ + x₂ subject to x₁ + x₂ ≤ 4, with 1 ≤ x₁
+        // Without the lower bound the optimum is x = [0, 4]
+        let c = vec![-1.0, 1.0];
+        let a = RealTensor::matrix(1, 2, vec![1.0, 1.0]).unwrap();
+        let b = vec![4.0];
+
+        let solution = bounded_lp::bounded_tableau(&c, &a, &b, 1.0, &[1.0, 0.0], &[f64::INFINITY, f64::INFINITY])
+            .unwrap()
+            .extract_solution();
+        assert!((solution[0] - 1.0).abs() < 1e-9, "x₁ should be 1");
+        assert!((solution[1] - 3.0).abs() < 1e-9, "x₂ should be 3");
+
+        // 5 ≤ x₁ contradicts x₁ + x₂ ≤ 4
+        assert!(bounded_lp::bounded_tableau(&c, &a, &b, 1.0, &[5.0, 0.0], &[f64::INFINITY, f64::INFINITY]).is_err());
+    }
+
+    #[test]
+    fn test_node_limit() {
+        let (c, a, b) = california_manufacturing();
+        let options = BranchBoundOptions { max_nodes: 1, threads: 1, ..Default::default() };
+
+        // Only the root LP is solved and it is fractional
+        let result = intlinprog_with_options(&c, &a, &b, 1.0, &[0, 1, 2, 3], &options);
+        assert_eq!(result.unwrap_err(), "Branch & Bound exceeded maximum iterations");
+    }
 }
@@ -1,3 +1,32 @@
+use std::sync::Arc;
+use crate::linear::tableau::Tableau;
+
+/// Bound added by branching on a fractional variable
+#[derive(Clone, Copy, Debug)]
+pub enum Branch {
+    /// xᵢ ≤ value
+    Down { var: usize, value: f64 },
+    /// xᵢ ≥ value
+    Up { var: usize, value: f64 },
+}
+
+impl Branch {
+    /// The bound as a tableau row `row · x ≤ rhs`
+    pub fn constraint(&self, n: usize) -> (Vec<f64>, f64) {
+        let mut row = vec![0.0; n];
+        match *self {
+            Branch::Down { var, value } => {
+                row[var] = 1.0;
+                (row, value)
+            }
+            Branch::Up { var, value } => {
+                row[var] = -1.0;
+                (row, -value)
+            }
+        }
+    }
+}
+
 /// Branch & Bound tree node representing a subproblem
 ///
 /// Each node represents a region of the search space defined by
@@ -6,6 +35,14 @@
 pub struct BBNode {
     pub lower_bounds: Vec<f64>,
     pub upper_bounds: Vec<f64>,
+    /// `sense × z` of the parent's LP relaxation: nothing in this subtree
+    /// scores higher (∞ when unknown)
+    pub score: f64,
+    /// Number of branching bounds from the root
+    pub depth: usize,
+    /// Parent's optimal tableau and the bound that separates this node from
+    /// it; the node LP is warm-started from that basis
+    pub warm_start: Option<(Arc<Tableau>, Branch)>,
 }
 
 impl BBNode {
@@ -14,14 +51,33 @@ impl BBNode {
         Self {
             lower_bounds,
             upper_bounds,
+            score: f64::INFINITY,
+            depth: 0,
+            warm_start: None,
         }
     }
 
     /// Create initial root node with default bounds [0, ∞)
     pub fn initial(n: usize) -> Self {
+        Self::new(vec![0.0; n], vec![f64::INFINITY; n])
+    }
+
+    /// Child of this node (solved, with tableau `parent` and score `score`)
+    /// restricted by `branch`
+    pub fn child(&self, branch: Branch, parent: Arc<Tableau>, score: f64) -> Self {
+        let mut lower_bounds = self.lower_bounds.clone();
+        let mut upper_bounds = self.upper_bounds.clone();
+        match branch {
+            Branch::Down { var, value } => upper_bounds[var] = value,
+            Branch::Up { var, value } => lower_bounds[var] = value,
+        }
+
         Self {
-            lower_bounds: vec![0.0; n],
-            upper_bounds: vec![f64::INFINITY; n],
+            lower_bounds,
+            upper_bounds,
+            score,
+            depth: self.depth + 1,
+            warm_start: Some((parent, branch)),
         }
     }
 }
@@ -0,0 +1,432 @@
+use achronyme_types::tensor::RealTensor;
+use std::cmp::Ordering;
+use std::collections::BinaryHeap;
+use std::sync::atomic::{AtomicBool, AtomicU64, AtomicUsize, Ordering as AtomicOrdering};
+use std::sync::{Arc, Condvar, Mutex};
+use std::thread;
+use std::time::Duration;
+use crate::linear::{dual_simplex, simplex};
+use crate::linear::tableau::Tableau;
+use super::node::{BBNode, Branch};
+use super::helpers::{is_integer_solution, find_fractional_var, should_prune, is_better};
+use super::bounded_lp::bounded_tableau;
+
+/// Order in which open nodes are explored
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum NodeSelection {
+    /// Node with the best LP bound first: proves optimality with the fewest
+    /// nodes, keeps the most nodes open
+    BestBound,
+    /// Deepest node first (stack order): finds incumbents early, low memory
+    DepthFirst,
+    /// Dive depth-first from each node until the dive is pruned, then
+    /// restart from the best bound
+    Hybrid,
+}
+
+/// Branch & Bound search settings
+#[derive(Debug, Clone)]
+pub struct BranchBoundOptions {
+    /// Node selection rule
+    pub node_selection: NodeSelection,
+    /// Worker threads; 0 uses every available core. Defaults to 1: most
+    /// models are small enough that spawning workers costs more than it saves
+    pub threads: usize,
+    /// Maximum number of node LPs solved
+    pub max_nodes: usize,
+}
+
+impl Default for BranchBoundOptions {
+    fn default() -> Self {
+        Self {
+            node_selection: NodeSelection::Hybrid,
+            threads: 1,
+            max_nodes: 10000,
+        }
+    }
+}
+
+/// Result of a search
+pub struct Outcome {
+    /// Best integer solution found
+    pub solution: Option<Vec<f64>>,
+    /// Whether `max_nodes` stopped the search before it was exhausted
+    pub hit_node_limit: bool,
+}
+
+/// Run Branch & Bound on `max c^T x  s.t.  A x ≤ b` within the bounds of `root`
+///
+/// The root LP is solved on the calling thread (its errors, e.g. an
+/// unbounded relaxation, are returned); the tree below it is explored by
+/// `options.threads` workers sharing the incumbent and a node pool.
+pub fn branch_and_bound(
+    c: &[f64],
+    a: &RealTensor,
+    b: &[f64],
+    sense: f64,
+    integer_vars: &[usize],
+    root: BBNode,
+    options: &BranchBoundOptions,
+) -> Result<Outcome, String> {
+    let threads = match options.threads {
+        0 => thread::available_parallelism().map_or(1, |n| n.get()),
+        n => n,
+    };
+
+    let tableau = bounded_tableau(c, a, b, sense, &root.lower_bounds, &root.upper_bounds)?;
+
+    let search = Search {
+        c,
+        a,
+        b,
+        sense,
+        integer_vars,
+        options,
+        incumbent: Incumbent::new(sense, threads > 1),
+        pool: NodePool::new(options.node_selection, threads),
+    };
+
+    search.pool.solved.store(1, AtomicOrdering::Relaxed);
+    let children = search.expand(&root, tableau);
+    search.pool.pending.store(children.len(), AtomicOrdering::Relaxed);
+    for child in children.into_iter().rev() {
+        search.pool.push(0, child);
+    }
+
+    let search = &search;
+    thread::scope(|scope| {
+        for worker in 1..threads {
+            scope.spawn(move || search.work(worker));
+        }
+        search.work(0);
+    });
+
+    let solution = search.incumbent.solution.lock().unwrap().take();
+    Ok(Outcome {
+        solution,
+        hit_node_limit: search.pool.stop.load(AtomicOrdering::Relaxed),
+    })
+}
+
+/// Problem data and shared state of one search
+struct Search<'a> {
+    c: &'a [f64],
+    a: &'a RealTensor,
+    b: &'a [f64],
+    sense: f64,
+    integer_vars: &'a [usize],
+    options: &'a BranchBoundOptions,
+    incumbent: Incumbent,
+    pool: NodePool,
+}
+
+impl Search<'_> {
+    /// Worker loop: take a node (the current dive, the own queue, or one
+    /// stolen from another worker), solve it and queue its children
+    fn work(&self, worker: usize) {
+        let mut dive: Option<BBNode> = None;
+
+        loop {
+            let node = match dive.take().or_else(|| self.pool.pop(worker)) {
+                Some(node) => node,
+                None => {
+                    if self.pool.pending.load(AtomicOrdering::Acquire) == 0 {
+                        return;
+                    }
+                    self.pool.wait();
+                    continue;
+                }
+            };
+
+            let children = self.process(&node);
+
+            // Children count as pending before their parent is finished, so
+            // the count only reaches zero when the tree is exhausted
+            self.pool.pending.fetch_add(children.len(), AtomicOrdering::AcqRel);
+            let mut children = children.into_iter();
+            if self.options.node_selection == NodeSelection::Hybrid {
+                dive = children.next();
+            }
+            // Preferred child last: it pops first from a depth-first queue
+            for child in children.rev() {
+                self.pool.push(worker, child);
+            }
+            self.pool.finish();
+        }
+    }
+
+    /// Children of `node` worth exploring, preferred child first
+    fn process(&self, node: &BBNode) -> Vec<BBNode> {
+        // Bound: the parent's relaxation already can't beat the incumbent
+        if self.pool.stop.load(AtomicOrdering::Relaxed) || self.incumbent.prunes(self.sense * node.score) {
+            return Vec::new();
+        }
+
+        if self.pool.solved.fetch_add(1, AtomicOrdering::Relaxed) >= self.options.max_nodes {
+            self.pool.stop.store(true, AtomicOrdering::Relaxed);
+            return Vec::new();
+        }
+
+        match self.solve(node) {
+            Some(tableau) => self.expand(node, tableau),
+            None => Vec::new(), // Infeasible subproblem, prune
+        }
+    }
+
+    /// Optimal tableau of the node LP, or `None` if it is infeasible
+    fn solve(&self, node: &BBNode) -> Option<Tableau> {
+        // Warm start: parent's optimal basis plus the branching bound
+        if let Some((parent, branch)) = &node.warm_start {
+            let mut tableau = Tableau::clone(parent);
+            let (row, rhs) = branch.constraint(self.c.len());
+            tableau.add_constraint(&row, rhs);
+            match dual_simplex::reoptimize(&mut tableau) {
+                Ok(true) => return Some(tableau),
+                Ok(false) => return None,
+                Err(_) => {} // Iteration limit: solve from scratch below
+            }
+        }
+
+        bounded_tableau(self.c, self.a, self.b, self.sense, &node.lower_bounds, &node.upper_bounds).ok()
+    }
+
+    /// Record an integer solution or branch on a fractional variable
+    fn expand(&self, node: &BBNode, tableau: Tableau) -> Vec<BBNode> {
+        let solution = tableau.extract_solution();
+        let objective = match simplex::objective_value(self.c, &solution) {
+            Ok(obj) => obj,
+            Err(_) => return Vec::new(),
+        };
+
+        // Integer solution: the incumbent decides, including ties
+        if is_integer_solution(&solution, self.integer_vars) {
+            self.incumbent.offer(objective, solution);
+            return Vec::new();
+        }
+
+        // Prune: check if this branch is worse than best found
+        if self.incumbent.prunes(objective) {
+            return Vec::new();
+        }
+
+        // Branch: choose fractional variable
+        let var = match find_fractional_var(&solution, self.integer_vars) {
+            Some(var) => var,
+            None => return Vec::new(),
+        };
+        let value = solution[var];
+        let score = self.sense * objective;
+        let parent = Arc::new(tableau);
+
+        // Left branch: xᵢ ≤ ⌊xᵢ⌋, right branch: xᵢ ≥ ⌈xᵢ⌉
+        let down = node.child(Branch::Down { var, value: value.floor() }, Arc::clone(&parent), score);
+        let up = node.child(Branch::Up { var, value: value.ceil() }, parent, score);
+
+        // Prefer the side the LP value rounds to
+        if value - value.floor() >= 0.5 {
+            vec![up, down]
+        } else {
+            vec![down, up]
+        }
+    }
+}
+
+/// Best integer solution found, shared by all workers
+///
+/// The objective is also kept as f64 bits in an atomic so that pruning
+/// checks never take the lock. Of two solutions with the same objective the
+/// lexicographically smaller one is kept.
+///
+/// With one worker the search order is fixed, so the usual pruning of nodes
+/// that merely tie the incumbent is deterministic. With several workers the
+/// incumbent's arrival time varies, and pruning ties would cut whichever
+/// co-optimal subtree happened to be explored later; `strict` then prunes
+/// only strictly worse nodes, so every co-optimal leaf reaches `offer` and
+/// the answer does not depend on which worker reported first (unless
+/// `max_nodes` stops the search). The price is exploring the tied nodes.
+struct Incumbent {
+    sense: f64,
+    /// Keep nodes that tie the incumbent
+    strict: bool,
+    objective: AtomicU64,
+    solution: Mutex<Option<Vec<f64>>>,
+}
+
+impl Incumbent {
+    fn new(sense: f64, strict: bool) -> Self {
+        let worst = if sense > 0.0 { f64::NEG_INFINITY } else { f64::INFINITY };
+        Self {
+            sense,
+            strict,
+            objective: AtomicU64::new(worst.to_bits()),
+            solution: Mutex::new(None),
+        }
+    }
+
+    fn objective(&self) -> f64 {
+        f64::from_bits(self.objective.load(AtomicOrdering::Acquire))
+    }
+
+    fn prunes(&self, objective: f64) -> bool {
+        if self.strict {
+            is_better(self.objective(), objective, self.sense)
+        } else {
+            should_prune(objective, self.objective(), self.sense)
+        }
+    }
+
+    fn offer(&self, objective: f64, solution: Vec<f64>) {
+        let mut best = self.solution.lock().unwrap();
+        let current = self.objective();
+        let replaces = is_better(objective, current, self.sense)
+            || (objective == current && best.as_ref().map_or(true, |best| lexicographically_less(&solution, best)));
+        if replaces {
+            self.objective.store(objective.to_bits(), AtomicOrdering::Release);
+            *best = Some(solution);
+        }
+    }
+}
+
+fn lexicographically_less(a: &[f64], b: &[f64]) -> bool {
+    a.iter()
+        .zip(b)
+        .map(|(x, y)| x.total_cmp(y))
+        .find(|ordering| ordering.is_ne())
+        .map_or(a.len() < b.len(), |ordering| ordering.is_lt())
+}
+
+/// Work-stealing node pool: one priority queue per worker
+///
+/// Workers push children to their own queue and pop from it; an idle worker
+/// steals from the others before going to sleep.
+struct NodePool {
+    selection: NodeSelection,
+    queues: Vec<Mutex<BinaryHeap<Entry>>>,
+    /// Push counter, breaks priority ties (newest first)
+    sequence: AtomicU64,
+    /// Nodes queued or being processed
+    pending: AtomicUsize,
+    /// Node LPs solved
+    solved: AtomicUsize,
+    /// Set when `max_nodes` is reached; remaining nodes are drained unsolved
+    stop: AtomicBool,
+    idle: Mutex<()>,
+    wake: Condvar,
+}
+
+impl NodePool {
+    fn new(selection: NodeSelection, workers: usize) -> Self {
+        Self {
+            selection,
+            queues: (0..workers).map(|_| Mutex::new(BinaryHeap::new())).collect(),
+            sequence: AtomicU64::new(0),
+            pending: AtomicUsize::new(0),
+            solved: AtomicUsize::new(0),
+            stop: AtomicBool::new(false),
+            idle: Mutex::new(()),
+            wake: Condvar::new(),
+        }
+    }
+
+    fn push(&self, worker: usize, node: BBNode) {
+        let primary = match self.selection {
+            NodeSelection::DepthFirst => 0.0,
+            NodeSelection::BestBound | NodeSelection::Hybrid => node.score,
+        };
+        let entry = Entry {
+            primary,
+            depth: node.depth,
+            sequence: self.sequence.fetch_add(1, AtomicOrdering::Relaxed),
+            node,
+        };
+        self.queues[worker].lock().unwrap().push(entry);
+        self.wake.notify_one();
+    }
+
+    /// Best node of the worker's own queue, else one stolen from another
+    fn pop(&self, worker: usize) -> Option<BBNode> {
+        let workers = self.queues.len();
+        (0..workers).find_map(|offset| {
+            let queue = &self.queues[(worker + offset) % workers];
+            queue.lock().unwrap().pop().map(|entry| entry.node)
+        })
+    }
+
+    /// Mark a popped node as done
+    fn finish(&self) {
+        if self.pending.fetch_sub(1, AtomicOrdering::AcqRel) == 1 {
+            self.wake.notify_all();
+        }
+    }
+
+    /// Sleep until a push or the end of the search; the timeout covers a
+    /// wake-up sent between the empty pop and the wait
+    fn wait(&self) {
+        let guard = self.idle.lock().unwrap();
+        let _ = self.wake.wait_timeout(guard, Duration::from_millis(1));
+    }
+}
+
+/// Queued node with its priority
+struct Entry {
+    /// Parent's score (0 for depth-first)
+    primary: f64,
+    depth: usize,
+    sequence: u64,
+    node: BBNode,
+}
+
+impl Ord for Entry {
+    fn cmp(&self, other: &Self) -> Ordering {
+        self.primary
+            .total_cmp(&other.primary)
+            .then(self.depth.cmp(&other.depth))
+            .then(self.sequence.cmp(&other.sequence))
+    }
+}
+
+impl PartialOrd for Entry {
+    fn partial_cmp(&self, other: &Self) -> Option<Ordering> {
+        Some(self.cmp(other))
+    }
+}
+
+impl PartialEq for Entry {
+    fn eq(&self, other: &Self) -> bool {
+        self.cmp(other) == Ordering::Equal
+    }
+}
+
+impl Eq for Entry {}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_incumbent_ties_keep_the_smallest_solution() {
+        let incumbent = Incumbent::new(1.0, false);
+        incumbent.offer(3.0, vec![2.0, 1.0]);
+        incumbent.offer(3.0, vec![1.0, 2.0]);
+        incumbent.offer(3.0, vec![3.0, 0.0]);
+        assert_eq!(incumbent.solution.lock().unwrap().as_deref(), Some(&[1.0, 2.0][..]));
+
+        incumbent.offer(4.0, vec![4.0, 0.0]);
+        assert_eq!(incumbent.objective(), 4.0);
+        assert_eq!(incumbent.solution.lock().unwrap().as_deref(), Some(&[4.0, 0.0][..]));
+    }
+
+    #[test]
+    fn test_strict_incumbent_keeps_ties() {
+        for sense in [1.0, -1.0] {
+            let (loose, strict) = (Incumbent::new(sense, false), Incumbent::new(sense, true));
+            for incumbent in [&loose, &strict] {
+                incumbent.offer(3.0, vec![1.0]);
+                assert!(!incumbent.prunes(3.0 + sense));
+                assert!(incumbent.prunes(3.0 - sense));
+            }
+            assert!(loose.prunes(3.0));
+            assert!(!strict.prunes(3.0));
+        }
+    }
+}
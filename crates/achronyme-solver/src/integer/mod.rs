@@ -3,3 +3,4 @@ pub mod branch_bound;
 // Re-exports
 pub use branch_bound::intlinprog;
 pub use branch_bound::binary_linprog;
+pub use branch_bound::{intlinprog_with_options, binary_linprog_with_options, BranchBoundOptions, NodeSelection};
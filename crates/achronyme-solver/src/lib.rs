@@ -7,5 +7,8 @@ pub use linear::linprog::solve as linprog_solve;
 pub use linear::dual_simplex::solve as dual_simplex_solve;
 pub use linear::two_phase::solve as two_phase_solve;
 pub use linear::revised_simplex::solve as revised_simplex_solve;
+pub use linear::revised_simplex::solve_sparse as revised_simplex_solve_sparse;
+pub use linear::sparse::CscMatrix;
 pub use linear::sensitivity::{shadow_price, sensitivity_b, sensitivity_c};
 pub use integer::{intlinprog, binary_linprog};
+pub use integer::{intlinprog_with_options, binary_linprog_with_options, BranchBoundOptions, NodeSelection};
@@ -0,0 +1,315 @@
+use super::sparse::CscMatrix;
+
+/// Tolerancia de pivote: por debajo de este valor la base se considera singular
+const PIVOT_TOLERANCE: f64 = 1e-11;
+
+/// Factorización LU dispersa de la base B del Revised Simplex, con
+/// actualizaciones en forma producto (product form of the inverse)
+///
+/// ```text
+/// P · B₀ · Q = L · U          (factorización, Q = orden de columnas)
+/// Bₖ = B₀ · E₁ · E₂ ⋯ Eₖ      (una matriz eta por cambio de base)
+/// ```
+///
+/// FTRAN (`B x = a`) y BTRAN (`yᵀ B = cᵀ`) resuelven con L, U y las etas sin
+/// formar nunca B⁻¹. Cada cambio de base agrega una eta en O(m); el
+/// llamador refactoriza cuando hay demasiadas (`num_updates`), lo que
+/// acota tanto el costo de las resoluciones como el error acumulado.
+///
+/// Todo se guarda en vectores planos estilo CSC: L y U por columnas, y el
+/// archivo de etas igual.
+#[derive(Debug, Clone)]
+pub struct BasisFactor {
+    m: usize,
+    /// Fila original elegida como pivote en el paso k
+    pivot_row: Vec<usize>,
+    /// Posición en la base de la columna factorizada en el paso k
+    column_order: Vec<usize>,
+    /// L sin la diagonal unitaria, por columnas, con índices de fila originales
+    l_start: Vec<usize>,
+    l_index: Vec<usize>,
+    l_value: Vec<f64>,
+    /// U sin la diagonal, por columnas, con índices = paso de pivote
+    u_start: Vec<usize>,
+    u_index: Vec<usize>,
+    u_value: Vec<f64>,
+    u_diag: Vec<f64>,
+    /// Etas: posición de la base reemplazada, su pivote y el resto de la columna
+    eta_position: Vec<usize>,
+    eta_pivot: Vec<f64>,
+    eta_start: Vec<usize>,
+    eta_index: Vec<usize>,
+    eta_value: Vec<f64>,
+}
+
+impl BasisFactor {
+    /// Factorizar la base formada por las columnas `basis` de `a`
+    ///
+    /// Gilbert-Peierls por izquierda con pivoteo parcial. Las columnas se
+    /// procesan de menos a más entradas (las holguras primero), lo que en
+    /// bases típicas del Simplex mantiene L y U casi tan dispersas como B.
+    pub fn factorize(a: &CscMatrix, basis: &[usize]) -> Result<Self, String> {
+        let m = a.rows();
+        if basis.len() != m {
+            return Err(format!("Basis has {} columns but the matrix has {} rows", basis.len(), m));
+        }
+
+        let mut column_order: Vec<usize> = (0..m).collect();
+        column_order.sort_by_key(|&position| a.column(basis[position]).0.len());
+
+        let mut factor = Self {
+            m,
+            pivot_row: Vec::with_capacity(m),
+            column_order,
+            l_start: vec![0],
+            l_index: Vec::new(),
+            l_value: Vec::new(),
+            u_start: vec![0],
+            u_index: Vec::new(),
+            u_value: Vec::new(),
+            u_diag: Vec::with_capacity(m),
+            eta_position: Vec::new(),
+            eta_pivot: Vec::new(),
+            eta_start: vec![0],
+            eta_index: Vec::new(),
+            eta_value: Vec::new(),
+        };
+
+        // Paso de pivote de cada fila original (usize::MAX = todavía libre)
+        let mut step_of_row = vec![usize::MAX; m];
+        let mut work = vec![0.0; m];
+
+        for step in 0..m {
+            let column = basis[factor.column_order[step]];
+            a.scatter_column(column, 1.0, &mut work);
+
+            // x = L⁻¹ · B_j restringido a los pivotes anteriores; los
+            // coeficientes en filas ya pivotadas forman la columna de U
+            for previous in 0..step {
+                let value = work[factor.pivot_row[previous]];
+                if value != 0.0 {
+                    factor.u_index.push(previous);
+                    factor.u_value.push(value);
+                    for k in factor.l_start[previous]..factor.l_start[previous + 1] {
+                        work[factor.l_index[k]] -= factor.l_value[k] * value;
+                    }
+                }
+            }
+            factor.u_start.push(factor.u_index.len());
+
+            // Pivote: la entrada libre de mayor magnitud
+            let mut pivot = None;
+            let mut pivot_abs = PIVOT_TOLERANCE;
+            for row in 0..m {
+                if step_of_row[row] == usize::MAX && work[row].abs() > pivot_abs {
+                    pivot_abs = work[row].abs();
+                    pivot = Some(row);
+                }
+            }
+            let pivot = match pivot {
+                Some(row) => row,
+                None => return Err("Basis matrix is singular".to_string()),
+            };
+
+            let diag = work[pivot];
+            factor.pivot_row.push(pivot);
+            factor.u_diag.push(diag);
+            step_of_row[pivot] = step;
+
+            for row in 0..m {
+                if step_of_row[row] == usize::MAX && work[row] != 0.0 {
+                    factor.l_index.push(row);
+                    factor.l_value.push(work[row] / diag);
+                }
+                work[row] = 0.0;
+            }
+            factor.l_start.push(factor.l_index.len());
+        }
+
+        Ok(factor)
+    }
+
+    /// Número de etas desde la última factorización
+    pub fn num_updates(&self) -> usize {
+        self.eta_position.len()
+    }
+
+    /// Resolver `B x = rhs` (FTRAN); `x` queda indexado por posición en la base
+    pub fn ftran(&self, rhs: &[f64]) -> Vec<f64> {
+        let m = self.m;
+
+        // L z = P rhs, en el espacio de filas originales
+        let mut work = rhs.to_vec();
+        let mut z = vec![0.0; m];
+        for step in 0..m {
+            let value = work[self.pivot_row[step]];
+            z[step] = value;
+            if value != 0.0 {
+                for k in self.l_start[step]..self.l_start[step + 1] {
+                    work[self.l_index[k]] -= self.l_value[k] * value;
+                }
+            }
+        }
+
+        // U w = z, hacia atrás por columnas
+        for step in (0..m).rev() {
+            let value = z[step] / self.u_diag[step];
+            z[step] = value;
+            if value != 0.0 {
+                for k in self.u_start[step]..self.u_start[step + 1] {
+                    z[self.u_index[k]] -= self.u_value[k] * value;
+                }
+            }
+        }
+
+        // Deshacer el orden de columnas
+        let mut x = vec![0.0; m];
+        for step in 0..m {
+            x[self.column_order[step]] = z[step];
+        }
+
+        // Etas en orden: x ← Eₖ⁻¹ x
+        for eta in 0..self.eta_position.len() {
+            let position = self.eta_position[eta];
+            let value = x[position] / self.eta_pivot[eta];
+            x[position] = value;
+            if value != 0.0 {
+                for k in self.eta_start[eta]..self.eta_start[eta + 1] {
+                    x[self.eta_index[k]] -= self.eta_value[k] * value;
+                }
+            }
+        }
+
+        x
+    }
+
+    /// Resolver `yᵀ B = rhsᵀ` (BTRAN); `rhs` va indexado por posición en la
+    /// base y `y` por fila
+    pub fn btran(&self, rhs: &[f64]) -> Vec<f64> {
+        let m = self.m;
+
+        // Etas en orden inverso: zᵀ ← zᵀ Eₖ⁻¹ sólo cambia la componente pivote
+        let mut z = rhs.to_vec();
+        for eta in (0..self.eta_position.len()).rev() {
+            let position = self.eta_position[eta];
+            let mut value = z[position];
+            for k in self.eta_start[eta]..self.eta_start[eta + 1] {
+                value -= self.eta_value[k] * z[self.eta_index[k]];
+            }
+            z[position] = value / self.eta_pivot[eta];
+        }
+
+        // Uᵀ w = Qᵀ z, hacia adelante por columnas de U
+        let mut w = vec![0.0; m];
+        for step in 0..m {
+            let mut value = z[self.column_order[step]];
+            for k in self.u_start[step]..self.u_start[step + 1] {
+                value -= self.u_value[k] * w[self.u_index[k]];
+            }
+            w[step] = value / self.u_diag[step];
+        }
+
+        // Lᵀ (P y) = w, hacia atrás; las filas de L ya están resueltas
+        let mut y = vec![0.0; m];
+        for step in (0..m).rev() {
+            let mut value = w[step];
+            for k in self.l_start[step]..self.l_start[step + 1] {
+                value -= self.l_value[k] * y[self.l_index[k]];
+            }
+            y[self.pivot_row[step]] = value;
+        }
+
+        y
+    }
+
+    /// Registrar el reemplazo de la columna en `position` por una columna
+    /// cuya FTRAN con la base actual es `alpha`
+    pub fn update(&mut self, position: usize, alpha: &[f64]) -> Result<(), String> {
+        let pivot = alpha[position];
+        if pivot.abs() < PIVOT_TOLERANCE {
+            return Err("Basis update with a zero pivot".to_string());
+        }
+
+        self.eta_position.push(position);
+        self.eta_pivot.push(pivot);
+        for (i, &value) in alpha.iter().enumerate() {
+            if i != position && value != 0.0 {
+                self.eta_index.push(i);
+                self.eta_value.push(value);
+            }
+        }
+        self.eta_start.push(self.eta_index.len());
+        Ok(())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use achronyme_types::tensor::RealTensor;
+
+    fn matrix(rows: usize, cols: usize, data: Vec<f64>) -> CscMatrix {
+        CscMatrix::from_dense(&RealTensor::matrix(rows, cols, data).unwrap()).unwrap()
+    }
+
+    fn multiply(a: &CscMatrix, basis: &[usize], x: &[f64]) -> Vec<f64> {
+        let mut result = vec![0.0; a.rows()];
+        for (position, &column) in basis.iter().enumerate() {
+            a.scatter_column(column, x[position], &mut result);
+        }
+        result
+    }
+
+    #[test]
+    fn test_ftran_btran() {
+        // B = [4 7 0; 2 6 1; 0 3 5] (requiere pivoteo y tiene relleno)
+        let a = matrix(3, 3, vec![4.0, 7.0, 0.0, 2.0, 6.0, 1.0, 0.0, 3.0, 5.0]);
+        let basis = [0, 1, 2];
+        let factor = BasisFactor::factorize(&a, &basis).unwrap();
+
+        let rhs = [1.0, -2.0, 3.0];
+        let x = factor.ftran(&rhs);
+        let bx = multiply(&a, &basis, &x);
+        for i in 0..3 {
+            assert!((bx[i] - rhs[i]).abs() < 1e-12, "B x = {:?}", bx);
+        }
+
+        // yᵀ B = rhsᵀ  ⇔  y · B_j = rhs_j
+        let y = factor.btran(&rhs);
+        for j in 0..3 {
+            assert!((a.dot_column(basis[j], &y) - rhs[j]).abs() < 1e-12);
+        }
+    }
+
+    #[test]
+    fn test_product_form_update() {
+        // [A | I] con base de holguras; entran las columnas de A una a una
+        let a = matrix(3, 3, vec![2.0, 1.0, 0.0, 1.0, 3.0, 1.0, 0.0, 1.0, 4.0]).with_slacks();
+        let mut basis = vec![3, 4, 5];
+        let mut factor = BasisFactor::factorize(&a, &basis).unwrap();
+
+        for (position, column) in [(1, 0), (0, 2), (2, 1)] {
+            let mut dense_column = vec![0.0; 3];
+            a.scatter_column(column, 1.0, &mut dense_column);
+            let alpha = factor.ftran(&dense_column);
+            factor.update(position, &alpha).unwrap();
+            basis[position] = column;
+
+            let rhs = [1.0, 2.0, 3.0];
+            let x = factor.ftran(&rhs);
+            let bx = multiply(&a, &basis, &x);
+            let y = factor.btran(&rhs);
+            for i in 0..3 {
+                assert!((bx[i] - rhs[i]).abs() < 1e-12, "B x = {:?}", bx);
+                assert!((a.dot_column(basis[i], &y) - rhs[i]).abs() < 1e-12);
+            }
+        }
+        assert_eq!(factor.num_updates(), 3);
+    }
+
+    #[test]
+    fn test_singular_basis() {
+        let a = matrix(2, 2, vec![1.0, 2.0, 2.0, 4.0]);
+        assert!(BasisFactor::factorize(&a, &[0, 1]).is_err());
+    }
+}
@@ -86,6 +86,46 @@ pub fn solve(c: &[f64], a: &RealTensor, b: &[f64], sense: f64) -> Result<Vec<f64
     }
 }
 
+/// Reoptimizar un tableau dual factible (warm start)
+///
+/// Caso típico: el tableau óptimo de un problema ya resuelto al que se le
+/// agregaron restricciones con `Tableau::add_constraint`. El Dual Simplex
+/// parte de la base anterior y sólo pivotea lo necesario para volver a ser
+/// primal factible.
+///
+/// Returns:
+///   - Ok(true): el tableau quedó óptimo y factible
+///   - Ok(false): el problema con las nuevas restricciones es infactible
+///   - Err: límite de iteraciones o el primal simplex final falló
+pub fn reoptimize(tableau: &mut Tableau) -> Result<bool, String> {
+    let max_iterations = 10000;
+
+    for _ in 0..max_iterations {
+        let leaving = match find_leaving_variable_dual(tableau) {
+            Some(row) => row,
+            None => {
+                // Primal factible; si el redondeo dejó algún costo reducido
+                // apenas negativo, el primal simplex termina el trabajo
+                if !tableau.is_optimal() {
+                    super::simplex::optimize(tableau)?;
+                }
+                return Ok(true);
+            }
+        };
+
+        match find_entering_variable_dual(tableau, leaving) {
+            Ok(entering) => tableau.pivot(entering, leaving),
+            // Fila con RHS negativo sin coeficientes negativos: infactible
+            Err(_) => return Ok(false),
+        }
+    }
+
+    Err(format!(
+        "Maximum iterations ({}) reached in dual simplex.",
+        max_iterations
+    ))
+}
+
 /// Verificar si la solución actual es primal factible
 /// (todas las variables básicas tienen valor no negativo)
 fn is_primal_feasible(tableau: &Tableau) -> bool {
@@ -177,4 +217,28 @@ mod tests {
         assert!((solution[0] - 2.0).abs() < 1e-6, "x₁ should be 2.0");
         assert!((solution[1] - 6.0).abs() < 1e-6, "x₂ should be 6.0");
     }
+
+    #[test]
+    fn test_reoptimize_after_added_constraint() {
+        // Wyndor resuelto (x = [2, 6], z = 36), luego se agrega x₁ ≥ 3,
+        // es decir -x₁ ≤ -3: óptimo nuevo x = [3, 4.5], z = 31.5
+        let c = vec![3.0, 5.0];
+        let a = RealTensor::matrix(3, 2, vec![1.0, 0.0, 0.0, 2.0, 3.0, 2.0]).unwrap();
+        let b = vec![4.0, 12.0, 18.0];
+
+        let mut tableau = Tableau::new(&c, &a, &b, 1.0).unwrap();
+        crate::linear::simplex::optimize(&mut tableau).unwrap();
+
+        tableau.add_constraint(&[-1.0, 0.0], -3.0);
+        assert!(reoptimize(&mut tableau).unwrap());
+
+        let solution = tableau.extract_solution();
+        assert!((solution[0] - 3.0).abs() < 1e-9, "x₁ should be 3.0");
+        assert!((solution[1] - 4.5).abs() < 1e-9, "x₂ should be 4.5");
+        assert!((tableau.objective_value() - 31.5).abs() < 1e-9);
+
+        // x₁ ≥ 5 contradice x₁ ≤ 4
+        tableau.add_constraint(&[-1.0, 0.0], -5.0);
+        assert!(!reoptimize(&mut tableau).unwrap());
+    }
 }
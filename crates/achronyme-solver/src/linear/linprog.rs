@@ -1,16 +1,19 @@
 use achronyme_types::tensor::RealTensor;
-use super::simplex;
+use super::{revised_simplex, simplex};
+
+/// Dimensión (filas o columnas) a partir de la cual se usa el Revised Simplex
+const LARGE_PROBLEM: usize = 100;
+
+/// Filas mínimas para que la dispersión justifique el Revised Simplex
+const SPARSE_MIN_ROWS: usize = 20;
 
 /// Resolver un problema de programación lineal con auto-selección de método
 ///
 /// Esta función selecciona automáticamente el mejor algoritmo basándose en
 /// las características del problema:
-///   - Problemas grandes (n > 1000 o m > 1000): Interior Point (futuro)
-///   - Muchas variables, pocas restricciones (m < n/2): Dual Simplex (futuro)
-///   - Matriz dispersa: Revised Simplex (futuro)
-///   - Caso general: Primal Simplex
-///
-/// Por ahora, solo usa Primal Simplex.
+///   - Problemas grandes (m o n ≥ 100) o matriz dispersa: Revised Simplex
+///     (A en CSC, base LU, pricing Devex)
+///   - Caso general: Primal Simplex (tableau denso)
 ///
 /// Args:
 ///   - c: vector de coeficientes objetivo (n elementos)
@@ -22,31 +25,27 @@ use super::simplex;
 ///   - Ok(x): vector solución óptima (n elementos)
 ///   - Err: mensaje de error
 pub fn solve(c: &[f64], a: &RealTensor, b: &[f64], sense: f64) -> Result<Vec<f64>, String> {
-    let _n = c.len();
-    let _m = a.rows();
-
-    // Heurística de selección de método (por ahora, solo Simplex)
-    // TODO: Implementar Dual Simplex, Revised Simplex, Interior Point
-
-    // if n > 5000 || m > 5000 {
-    //     // Problemas grandes: Interior Point
-    //     return interior_point::solve(c, a, b, sense);
-    // } else if m < n / 2 {
-    //     // Muchas variables, pocas restricciones: Dual Simplex
-    //     return dual_simplex::solve(c, a, b, sense);
-    // } else if is_sparse(a) {
-    //     // Matriz dispersa: Revised Simplex
-    //     return revised_simplex::solve(c, a, b, sense);
-    // }
+    if uses_revised_simplex(a) {
+        return revised_simplex::solve(c, a, b, sense);
+    }
 
     // Caso general: Primal Simplex
     simplex::solve(c, a, b, sense)
 }
 
+/// Criterio de `solve`: el tableau denso cuesta O(m·(n+m)) por iteración,
+/// el Revised Simplex O(nnz) más la LU de la base
+fn uses_revised_simplex(a: &RealTensor) -> bool {
+    if !a.is_matrix() {
+        return false;
+    }
+    let (m, n) = (a.rows(), a.cols());
+    m.max(n) >= LARGE_PROBLEM || (m >= SPARSE_MIN_ROWS && is_sparse(a))
+}
+
 /// Verificar si una matriz es dispersa (sparse)
 ///
 /// Una matriz se considera dispersa si más del 50% de sus elementos son cero
-#[allow(dead_code)]
 fn is_sparse(tensor: &RealTensor) -> bool {
     let total = tensor.size();
     let zeros = tensor.data().iter().filter(|&&x| x.abs() < 1e-10).count();
@@ -94,4 +93,27 @@ mod tests {
 
         assert!(!is_sparse(&dense));
     }
-}
\ No newline at end of file
+
+    #[test]
+    fn test_linprog_selects_revised_simplex_for_large_sparse() {
+        // 40 restricciones, diagonal por bloques: dispersa
+        let (m, n) = (40, 40);
+        let mut data = vec![0.0; m * n];
+        for i in 0..m {
+            data[i * n + i] = 2.0;
+            data[i * n + (i + 1) % n] = 1.0;
+        }
+        let a = RealTensor::matrix(m, n, data).unwrap();
+        let c: Vec<f64> = (0..n).map(|j| 1.0 + (j % 3) as f64).collect();
+        let b = vec![6.0; m];
+
+        assert!(uses_revised_simplex(&a));
+        assert!(!uses_revised_simplex(&RealTensor::matrix(3, 2, vec![1.0, 0.0, 0.0, 2.0, 3.0, 2.0]).unwrap()));
+
+        let solution = solve(&c, &a, &b, 1.0).unwrap();
+        let expected = simplex::solve(&c, &a, &b, 1.0).unwrap();
+        let z = simplex::objective_value(&c, &solution).unwrap();
+        let z_expected = simplex::objective_value(&c, &expected).unwrap();
+        assert!((z - z_expected).abs() < 1e-9, "z = {}, expected {}", z, z_expected);
+    }
+}
@@ -1,5 +1,7 @@
 pub mod simplex;
 pub mod tableau;
+pub mod sparse;
+pub mod basis_lu;
 pub mod linprog;
 pub mod dual_simplex;
 pub mod two_phase;
@@ -12,4 +14,6 @@ pub use linprog::solve as linprog_solve;
 pub use dual_simplex::solve as dual_simplex_solve;
 pub use two_phase::solve as two_phase_solve;
 pub use revised_simplex::solve as revised_simplex_solve;
+pub use revised_simplex::solve_sparse as revised_simplex_solve_sparse;
+pub use sparse::CscMatrix;
 pub use sensitivity::{shadow_price, sensitivity_b, sensitivity_c};
@@ -1,21 +1,41 @@
 use achronyme_types::tensor::RealTensor;
+use super::basis_lu::BasisFactor;
+use super::sparse::CscMatrix;
+
+/// Cambios de base entre refactorizaciones de la LU
+const REFACTOR_INTERVAL: usize = 64;
+
+/// Tolerancia de optimalidad sobre los costos reducidos
+const OPTIMALITY_TOLERANCE: f64 = 1e-9;
+
+/// Tolerancia de pivote en el ratio test
+const PIVOT_TOLERANCE: f64 = 1e-9;
 
 /// Resolver un problema de programación lineal usando el método Revised Simplex
 ///
 /// El Revised Simplex es una versión más eficiente del Simplex estándar que:
 /// - NO mantiene el tableau completo en memoria
-/// - Solo almacena la base inversa B⁻¹
-/// - Recalcula columnas del tableau on-demand
+/// - Guarda A en formato disperso (CSC) y la base como una factorización LU
+/// - Calcula sólo lo que cada iteración necesita: la columna entrante
+///   (FTRAN) y la fila pivote (BTRAN + productos por columna de A)
 ///
 /// **Ventajas sobre Primal Simplex**:
-/// - Memoria: O(m²) vs O(m*n) donde m << n (muchas variables, pocas restricciones)
-/// - Más eficiente para matrices dispersas (sparse)
-/// - Mejor para problemas grandes (n > 1000)
+/// - Memoria: O(nnz(A) + nnz(LU)) vs O(m*(n+m)) del tableau
+/// - Cada iteración cuesta O(nnz) en vez de O(m*(n+m))
+/// - Mejor para problemas grandes y dispersos (miles de restricciones)
 ///
 /// **Desventajas**:
 /// - Más complejo de implementar
-/// - Overhead de recalcular columnas
-/// - No es mejor si n ≈ m
+/// - En problemas chicos y densos el tableau es igual de rápido
+///
+/// Detalles de la implementación:
+/// - Base factorizada P·B·Q = L·U (`BasisFactor`), actualizada en forma
+///   producto (una eta por iteración) y refactorizada cada
+///   `REFACTOR_INTERVAL` cambios de base
+/// - Pricing Devex (pesos de referencia aproximando steepest edge), que
+///   reduce mucho las iteraciones frente a la regla de Dantzig
+/// - Costos reducidos actualizados con la fila pivote y recalculados desde
+///   cero en cada refactorización
 ///
 /// Args:
 ///   - c: vector de coeficientes objetivo (n elementos)
@@ -26,26 +46,29 @@ use achronyme_types::tensor::RealTensor;
 /// Returns:
 ///   - Ok(x): vector solución óptima (n elementos)
 ///   - Err: mensaje de error (infactible, no acotado, etc.)
-///
-/// # Nota sobre la Implementación
-///
-/// Esta es una implementación simplificada del Revised Simplex.
-/// Una implementación productiva requeriría:
-/// - Factorización LU de la base para eficiencia
-/// - Actualización incremental de B⁻¹ (product form)
-/// - Manejo de degeneración (reglas de Bland, etc.)
-/// - Reoptimización periódica para estabilidad numérica
 pub fn solve(c: &[f64], a: &RealTensor, b: &[f64], sense: f64) -> Result<Vec<f64>, String> {
     // Validar sense
     if sense != 1.0 && sense != -1.0 {
         return Err("sense must be 1.0 (maximize) or -1.0 (minimize)".to_string());
     }
 
-    if !a.is_matrix() {
-        return Err("`a` must be a matrix".to_string());
+    let a = CscMatrix::from_dense(a)?;
+    solve_sparse(c, &a, b, sense)
+}
+
+/// Revised Simplex sobre una matriz de restricciones ya dispersa
+///
+/// Mismo problema que `solve` (A x ≤ b, x ≥ 0, b ≥ 0), sin pasar nunca por
+/// una matriz densa: para modelos grandes construidos con
+/// `CscMatrix::from_triplets`.
+pub fn solve_sparse(c: &[f64], a: &CscMatrix, b: &[f64], sense: f64) -> Result<Vec<f64>, String> {
+    // Validar sense
+    if sense != 1.0 && sense != -1.0 {
+        return Err("sense must be 1.0 (maximize) or -1.0 (minimize)".to_string());
     }
+
     let n = c.len(); // Variables de decisión
-    let m = a.rows();  // Restricciones
+    let m = a.rows(); // Restricciones
 
     // Validaciones
     if a.cols() != n {
@@ -71,116 +94,35 @@ pub fn solve(c: &[f64], a: &RealTensor, b: &[f64], sense: f64) -> Result<Vec<f64
         }
     }
 
-    // Construir matriz aumentada [A | I] para incluir variables de holgura
-    let total_vars = n + m;
-    let mut aug_a = vec![0.0; m * total_vars];
-
-    // Copiar A
-    for i in 0..m {
-        for j in 0..n {
-            aug_a[i * total_vars + j] = a.get_matrix(i, j).unwrap();
-        }
-    }
-
-    // Agregar matriz identidad (holguras)
-    for i in 0..m {
-        aug_a[i * total_vars + (n + i)] = 1.0;
-    }
-
-    // Vector de costos aumentado [c | 0]
-    let mut c_aug = vec![0.0; total_vars];
-    for j in 0..n {
-        c_aug[j] = -sense * c[j]; // Negativo porque maximizamos
-    }
-
-    // Base inicial: variables de holgura [n, n+1, ..., n+m-1]
-    let mut basis: Vec<usize> = (n..n + m).collect();
-
-    // Solución básica inicial
-    let mut x_b = b.to_vec();
+    let mut state = RevisedSimplex::new(c, a, b, sense)?;
 
     // Configuración
-    let max_iterations = 10000;
+    let max_iterations = 10000.max(20 * (n + m));
 
-    // Algoritmo Revised Simplex
     for iteration in 0..max_iterations {
-        // Paso 1: Calcular multiplicadores simplex (precios sombra duales)
-        // π = c_B^T * B⁻¹
-        let b_inv = compute_basis_inverse(&aug_a, &basis, m, total_vars)?;
-        let c_b = get_basis_costs(&c_aug, &basis);
-        let pi = multiply_vector_matrix(&c_b, &b_inv, m);
-
-        // Paso 2: Calcular costos reducidos para variables no básicas
-        // r_j = c_j - π^T * A_j
-        let mut entering_col = None;
-        let mut min_reduced_cost = 0.0;
-
-        for j in 0..total_vars {
-            // Si j está en la base, su costo reducido es 0
-            if basis.contains(&j) {
-                continue;
-            }
-
-            // Extraer columna A_j
-            let a_j = get_column(&aug_a, j, m, total_vars);
-
-            // Calcular r_j = c_j - π^T * A_j
-            let pi_a_j = dot_product(&pi, &a_j);
-            let r_j = c_aug[j] - pi_a_j;
-
-            // Para maximización, buscamos r_j < 0
-            if r_j < min_reduced_cost - 1e-10 {
-                min_reduced_cost = r_j;
-                entering_col = Some(j);
-            }
-        }
-
-        // Paso 3: Verificar optimalidad
-        if entering_col.is_none() {
+        // Paso 1: Pricing Devex → variable entrante
+        let entering = match state.choose_entering() {
+            Some(j) => j,
             // Todos los costos reducidos son >= 0, solución óptima
-            return extract_solution(&basis, &x_b, n, m);
-        }
-
-        let entering = entering_col.unwrap();
-
-        // Paso 4: Calcular dirección: d = B⁻¹ * A_entering
-        let a_entering = get_column(&aug_a, entering, m, total_vars);
-        let d = multiply_matrix_vector(&b_inv, &a_entering, m);
-
-        // Paso 5: Minimum ratio test para encontrar leaving variable
-        let mut min_ratio = f64::INFINITY;
-        let mut leaving_idx = None;
-
-        for i in 0..m {
-            if d[i] > 1e-10 {
-                let ratio = x_b[i] / d[i];
-                if ratio < min_ratio {
-                    min_ratio = ratio;
-                    leaving_idx = Some(i);
-                }
+            None => return Ok(state.solution()),
+        };
+
+        // Paso 2: Dirección d = B⁻¹ * A_entering (FTRAN)
+        let alpha = state.ftran_column(entering);
+
+        // Paso 3: Minimum ratio test para encontrar leaving variable
+        let leaving = match state.ratio_test(&alpha) {
+            Some(row) => row,
+            None => {
+                return Err(format!(
+                    "Unbounded problem at iteration {} (no valid leaving variable)",
+                    iteration
+                ))
             }
-        }
-
-        if leaving_idx.is_none() {
-            return Err(format!(
-                "Unbounded problem at iteration {} (no valid leaving variable)",
-                iteration
-            ));
-        }
-
-        let leaving_row = leaving_idx.unwrap();
+        };
 
-        // Paso 6: Actualizar base y solución
-        let theta = min_ratio;
-
-        // Actualizar x_b
-        for i in 0..m {
-            x_b[i] -= theta * d[i];
-        }
-        x_b[leaving_row] = theta;
-
-        // Actualizar base
-        basis[leaving_row] = entering;
+        // Paso 4: Actualizar base, solución, costos reducidos y pesos
+        state.pivot(entering, leaving, &alpha)?;
     }
 
     Err(format!(
@@ -189,152 +131,188 @@ pub fn solve(c: &[f64], a: &RealTensor, b: &[f64], sense: f64) -> Result<Vec<f64
     ))
 }
 
-// ============================================================================
-// Funciones Auxiliares de Álgebra Lineal
-// ============================================================================
-
-/// Calcular la inversa de la submatriz base B
-///
-/// Usa eliminación gaussiana con pivoteo parcial
-fn compute_basis_inverse(
-    aug_a: &[f64],
-    basis: &[usize],
-    m: usize,
-    total_vars: usize,
-) -> Result<Vec<f64>, String> {
-    // Extraer matriz base B (m × m)
-    let mut b = vec![0.0; m * m];
-    for (i, &col) in basis.iter().enumerate() {
-        for row in 0..m {
-            b[row * m + i] = aug_a[row * total_vars + col];
-        }
-    }
-
-    // Invertir usando eliminación gaussiana
-    invert_matrix(&b, m)
+/// Estado del Revised Simplex sobre `[A | I]`
+struct RevisedSimplex {
+    n: usize,
+    /// `[A | I]`: columnas de decisión seguidas de una holgura por fila
+    aug: CscMatrix,
+    /// Costos de minimización `[-sense * c | 0]`
+    cost: Vec<f64>,
+    b: Vec<f64>,
+    /// basis[i] = variable básica en la posición i
+    basis: Vec<usize>,
+    /// Posición en la base de cada variable (usize::MAX si no es básica)
+    position: Vec<usize>,
+    factor: BasisFactor,
+    /// Valores de las variables básicas
+    x_b: Vec<f64>,
+    /// Costos reducidos (0 para las básicas)
+    reduced: Vec<f64>,
+    /// Pesos de referencia Devex
+    weights: Vec<f64>,
 }
 
-/// Invertir una matriz usando eliminación gaussiana (Gauss-Jordan)
-fn invert_matrix(mat: &[f64], n: usize) -> Result<Vec<f64>, String> {
-    // Crear matriz aumentada [A | I]
-    let mut aug = vec![0.0; n * (2 * n)];
+impl RevisedSimplex {
+    fn new(c: &[f64], a: &CscMatrix, b: &[f64], sense: f64) -> Result<Self, String> {
+        let n = c.len();
+        let m = a.rows();
+        let total_vars = n + m;
 
-    for i in 0..n {
+        let mut cost = vec![0.0; total_vars];
         for j in 0..n {
-            aug[i * (2 * n) + j] = mat[i * n + j];
+            cost[j] = -sense * c[j]; // Negativo porque maximizamos
         }
-        aug[i * (2 * n) + (n + i)] = 1.0; // Identidad
-    }
 
-    // Eliminación hacia adelante
-    for k in 0..n {
-        // Encontrar pivote
-        let mut max_row = k;
-        let mut max_val = aug[k * (2 * n) + k].abs();
-
-        for i in (k + 1)..n {
-            let val = aug[i * (2 * n) + k].abs();
-            if val > max_val {
-                max_val = val;
-                max_row = i;
-            }
+        // Base inicial: variables de holgura [n, n+1, ..., n+m-1]
+        let basis: Vec<usize> = (n..total_vars).collect();
+        let mut position = vec![usize::MAX; total_vars];
+        for (i, &var) in basis.iter().enumerate() {
+            position[var] = i;
         }
 
-        if max_val < 1e-10 {
-            return Err("Matrix is singular (not invertible)".to_string());
-        }
+        let aug = a.with_slacks();
+        let factor = BasisFactor::factorize(&aug, &basis)?;
+
+        let mut state = Self {
+            n,
+            aug,
+            cost,
+            b: b.to_vec(),
+            basis,
+            position,
+            factor,
+            x_b: Vec::new(),
+            reduced: Vec::new(),
+            weights: vec![1.0; total_vars],
+        };
+        state.recompute();
+        Ok(state)
+    }
 
-        // Intercambiar filas
-        if max_row != k {
-            for j in 0..(2 * n) {
-                let temp = aug[k * (2 * n) + j];
-                aug[k * (2 * n) + j] = aug[max_row * (2 * n) + j];
-                aug[max_row * (2 * n) + j] = temp;
+    /// x_B = B⁻¹ b y costos reducidos r_j = c_j - πᵀ A_j con π = c_Bᵀ B⁻¹
+    fn recompute(&mut self) {
+        self.x_b = self.factor.ftran(&self.b);
+
+        let c_b: Vec<f64> = self.basis.iter().map(|&j| self.cost[j]).collect();
+        let pi = self.factor.btran(&c_b);
+        self.reduced = (0..self.aug.cols())
+            .map(|j| {
+                if self.position[j] == usize::MAX {
+                    self.cost[j] - self.aug.dot_column(j, &pi)
+                } else {
+                    0.0
+                }
+            })
+            .collect();
+    }
+
+    /// Variable no básica con costo reducido negativo que maximiza r_j² / w_j
+    fn choose_entering(&self) -> Option<usize> {
+        let mut best = None;
+        let mut best_score = 0.0;
+        for (j, &r_j) in self.reduced.iter().enumerate() {
+            if r_j < -OPTIMALITY_TOLERANCE && self.position[j] == usize::MAX {
+                let score = r_j * r_j / self.weights[j];
+                if score > best_score {
+                    best_score = score;
+                    best = Some(j);
+                }
             }
         }
+        best
+    }
 
-        // Normalizar fila pivote
-        let pivot = aug[k * (2 * n) + k];
-        for j in 0..(2 * n) {
-            aug[k * (2 * n) + j] /= pivot;
-        }
+    fn ftran_column(&self, j: usize) -> Vec<f64> {
+        let mut column = vec![0.0; self.b.len()];
+        self.aug.scatter_column(j, 1.0, &mut column);
+        self.factor.ftran(&column)
+    }
 
-        // Eliminar columna k en otras filas
-        for i in 0..n {
-            if i != k {
-                let factor = aug[i * (2 * n) + k];
-                for j in 0..(2 * n) {
-                    aug[i * (2 * n) + j] -= factor * aug[k * (2 * n) + j];
+    /// Posición que sale: ratio mínimo x_B[i] / d[i] con d[i] > 0; entre
+    /// empates (degeneración) el pivote más grande, por estabilidad
+    fn ratio_test(&self, alpha: &[f64]) -> Option<usize> {
+        let mut leaving = None;
+        let mut min_ratio = f64::INFINITY;
+        let mut best_pivot = 0.0;
+        for (i, &d) in alpha.iter().enumerate() {
+            if d > PIVOT_TOLERANCE {
+                let ratio = self.x_b[i].max(0.0) / d;
+                if ratio < min_ratio - 1e-12 || (ratio <= min_ratio + 1e-12 && d > best_pivot) {
+                    min_ratio = ratio.min(min_ratio);
+                    best_pivot = d;
+                    leaving = Some(i);
                 }
             }
         }
+        leaving
     }
 
-    // Extraer matriz inversa (mitad derecha)
-    let mut inv = vec![0.0; n * n];
-    for i in 0..n {
-        for j in 0..n {
-            inv[i * n + j] = aug[i * (2 * n) + (n + j)];
-        }
-    }
+    fn pivot(&mut self, entering: usize, leaving: usize, alpha: &[f64]) -> Result<(), String> {
+        let alpha_q = alpha[leaving];
+        let leaving_var = self.basis[leaving];
 
-    Ok(inv)
-}
+        // Fila pivote: α_r = e_rᵀ B⁻¹ [A | I] (BTRAN + un producto por columna)
+        let mut unit = vec![0.0; self.b.len()];
+        unit[leaving] = 1.0;
+        let rho = self.factor.btran(&unit);
 
-/// Obtener costos de variables en la base
-fn get_basis_costs(c: &[f64], basis: &[usize]) -> Vec<f64> {
-    basis.iter().map(|&j| c[j]).collect()
-}
+        // Costos reducidos y pesos Devex de las no básicas
+        let step = self.reduced[entering] / alpha_q;
+        let weight_q = self.weights[entering];
+        for j in 0..self.aug.cols() {
+            if self.position[j] != usize::MAX || j == entering {
+                continue;
+            }
+            let alpha_rj = self.aug.dot_column(j, &rho);
+            if alpha_rj != 0.0 {
+                self.reduced[j] -= step * alpha_rj;
+                let ratio = alpha_rj / alpha_q;
+                self.weights[j] = self.weights[j].max(ratio * ratio * weight_q);
+            }
+        }
+        self.reduced[entering] = 0.0;
+        self.reduced[leaving_var] = -step;
+        self.weights[leaving_var] = (weight_q / (alpha_q * alpha_q)).max(1.0);
 
-/// Multiplicar vector por matriz: v^T * M
-fn multiply_vector_matrix(v: &[f64], m: &[f64], n: usize) -> Vec<f64> {
-    let mut result = vec![0.0; n];
-    for j in 0..n {
-        for i in 0..n {
-            result[j] += v[i] * m[i * n + j];
+        // Actualizar x_b
+        let theta = self.x_b[leaving].max(0.0) / alpha_q;
+        for (x, &d) in self.x_b.iter_mut().zip(alpha) {
+            *x -= theta * d;
         }
-    }
-    result
-}
+        self.x_b[leaving] = theta;
 
-/// Multiplicar matriz por vector: M * v
-fn multiply_matrix_vector(m: &[f64], v: &[f64], n: usize) -> Vec<f64> {
-    let mut result = vec![0.0; n];
-    for i in 0..n {
-        for j in 0..n {
-            result[i] += m[i * n + j] * v[j];
+        // Actualizar base
+        self.basis[leaving] = entering;
+        self.position[leaving_var] = usize::MAX;
+        self.position[entering] = leaving;
+
+        if self.factor.num_updates() + 1 >= REFACTOR_INTERVAL {
+            // Refactorizar: acota el archivo de etas y el error acumulado
+            self.factor = BasisFactor::factorize(&self.aug, &self.basis)?;
+            self.recompute();
+        } else {
+            self.factor.update(leaving, alpha)?;
         }
+        Ok(())
     }
-    result
-}
-
-/// Producto punto de dos vectores
-fn dot_product(a: &[f64], b: &[f64]) -> f64 {
-    a.iter().zip(b.iter()).map(|(x, y)| x * y).sum()
-}
-
-/// Obtener una columna de la matriz
-fn get_column(mat: &[f64], col: usize, rows: usize, cols: usize) -> Vec<f64> {
-    (0..rows).map(|i| mat[i * cols + col]).collect()
-}
-
-/// Extraer solución final
-fn extract_solution(basis: &[usize], x_b: &[f64], n: usize, _m: usize) -> Result<Vec<f64>, String> {
-    let mut solution = vec![0.0; n];
 
-    for (i, &var) in basis.iter().enumerate() {
-        if var < n {
-            // Variable de decisión (no holgura)
-            solution[var] = x_b[i];
+    /// Extraer solución final
+    fn solution(&self) -> Vec<f64> {
+        let mut solution = vec![0.0; self.n];
+        for (i, &var) in self.basis.iter().enumerate() {
+            if var < self.n {
+                // Variable de decisión (no holgura)
+                solution[var] = self.x_b[i].max(0.0);
+            }
         }
+        solution
     }
-
-    Ok(solution)
 }
 
 #[cfg(test)]
 mod tests {
     use super::*;
+    use crate::linear::simplex;
 
     #[test]
     fn test_revised_simplex_basic() {
@@ -355,23 +333,61 @@ mod tests {
         assert!((solution[1] - 6.0).abs() < 1e-6, "x₂ should be 6.0");
     }
 
+    /// LP disperso `m × n`: cada variable aparece en 3 restricciones
+    fn sparse_lp(m: usize, n: usize) -> (Vec<f64>, Vec<(usize, usize, f64)>, Vec<f64>) {
+        let mut triplets = Vec::new();
+        for j in 0..n {
+            for k in 0..3 {
+                let row = (j * 7 + k * 13) % m;
+                triplets.push((row, j, 1.0 + ((j + k) % 5) as f64));
+            }
+        }
+        let c = (0..n).map(|j| 1.0 + (j % 7) as f64).collect();
+        let b = (0..m).map(|i| 10.0 + (i % 3) as f64).collect();
+        (c, triplets, b)
+    }
+
+    #[test]
+    fn test_sparse_matches_tableau_simplex() {
+        // Suficientemente grande para varias refactorizaciones
+        let (m, n) = (120, 180);
+        let (c, triplets, b) = sparse_lp(m, n);
+        let sparse = CscMatrix::from_triplets(m, n, &triplets).unwrap();
+        let mut dense = vec![0.0; m * n];
+        for &(i, j, value) in &triplets {
+            dense[i * n + j] += value;
+        }
+        let dense = RealTensor::matrix(m, n, dense).unwrap();
+
+        for sense in [1.0, -1.0] {
+            let expected = simplex::solve(&c, &dense, &b, sense).unwrap();
+            let solution = solve_sparse(&c, &sparse, &b, sense).unwrap();
+
+            let z_expected = simplex::objective_value(&c, &expected).unwrap();
+            let z = simplex::objective_value(&c, &solution).unwrap();
+            assert!((z - z_expected).abs() < 1e-6 * z_expected.abs().max(1.0), "z = {}, expected {}", z, z_expected);
+
+            // Factibilidad
+            for i in 0..m {
+                let row: f64 = triplets.iter().filter(|t| t.0 == i).map(|&(_, j, v)| v * solution[j]).sum();
+                assert!(row <= b[i] + 1e-7, "constraint {} violated: {} > {}", i, row, b[i]);
+            }
+        }
+    }
+
+    #[test]
+    fn test_revised_simplex_unbounded() {
+        // maximize x₁ + x₂ subject to x₁ - x₂ ≤ 1
+        let c = vec![1.0, 1.0];
+        let a = RealTensor::matrix(1, 2, vec![1.0, -1.0]).unwrap();
+        let result = solve(&c, &a, &[1.0], 1.0);
+        assert!(result.unwrap_err().contains("Unbounded"));
+    }
+
     #[test]
-    fn test_matrix_inversion() {
-        // Test 2×2
-        let mat = vec![4.0, 7.0, 2.0, 6.0];
-        let inv = invert_matrix(&mat, 2).unwrap();
-
-        // Verificar A * A⁻¹ = I
-        let result = vec![
-            mat[0] * inv[0] + mat[1] * inv[2],
-            mat[0] * inv[1] + mat[1] * inv[3],
-            mat[2] * inv[0] + mat[3] * inv[2],
-            mat[2] * inv[1] + mat[3] * inv[3],
-        ];
-
-        assert!((result[0] - 1.0).abs() < 1e-10);
-        assert!(result[1].abs() < 1e-10);
-        assert!(result[2].abs() < 1e-10);
-        assert!((result[3] - 1.0).abs() < 1e-10);
+    fn test_revised_simplex_negative_rhs() {
+        let c = vec![1.0];
+        let a = RealTensor::matrix(1, 1, vec![1.0]).unwrap();
+        assert!(solve(&c, &a, &[-1.0], 1.0).is_err());
     }
 }
@@ -52,7 +52,15 @@ pub fn solve(c: &[f64], a: &RealTensor, b: &[f64], sense: f64) -> Result<Vec<f64
 
     // Crear tableau inicial
     let mut tableau = Tableau::new(c, a, b, sense)?;
+    optimize(&mut tableau)?;
+    Ok(tableau.extract_solution())
+}
 
+/// Pivotear un tableau primal factible hasta la solución óptima
+///
+/// Es el ciclo del Simplex de `solve`, expuesto para quien necesita el
+/// tableau final (p. ej. Branch & Bound, que lo reutiliza en los hijos).
+pub fn optimize(tableau: &mut Tableau) -> Result<(), String> {
     // Configuración
     let max_iterations = 10000;
     let mut iteration = 0;
@@ -71,7 +79,7 @@ pub fn solve(c: &[f64], a: &RealTensor, b: &[f64], sense: f64) -> Result<Vec<f64
         // Paso 1: Verificar optimalidad
         if tableau.is_optimal() {
             // Solución óptima encontrada
-            return Ok(tableau.extract_solution());
+            return Ok(());
         }
 
         // Paso 2: Encontrar variable entrante (entering variable)
@@ -79,7 +87,7 @@ pub fn solve(c: &[f64], a: &RealTensor, b: &[f64], sense: f64) -> Result<Vec<f64
             Some(col) => col,
             None => {
                 // No hay columnas con coeficiente negativo → óptimo
-                return Ok(tableau.extract_solution());
+                return Ok(());
             }
         };
 
@@ -0,0 +1,205 @@
+use achronyme_types::tensor::RealTensor;
+
+/// Matriz dispersa en formato CSC (Compressed Sparse Column)
+///
+/// Las entradas no nulas de la columna `j` son
+/// `row_index[col_start[j]..col_start[j + 1]]` con sus valores en `values`,
+/// todo en tres vectores planos. Es el formato natural del Revised Simplex,
+/// que sólo accede a A por columnas (FTRAN de la columna entrante, costos
+/// reducidos y fila pivote como productos punto por columna).
+#[derive(Debug, Clone, PartialEq)]
+pub struct CscMatrix {
+    rows: usize,
+    cols: usize,
+    col_start: Vec<usize>,
+    row_index: Vec<usize>,
+    values: Vec<f64>,
+}
+
+impl CscMatrix {
+    /// Construir desde una matriz densa, descartando los ceros
+    pub fn from_dense(a: &RealTensor) -> Result<Self, String> {
+        if !a.is_matrix() {
+            return Err("`a` must be a matrix".to_string());
+        }
+        let (rows, cols) = (a.rows(), a.cols());
+        let data = a.data();
+
+        let mut col_start = Vec::with_capacity(cols + 1);
+        let mut row_index = Vec::new();
+        let mut values = Vec::new();
+        col_start.push(0);
+        for j in 0..cols {
+            for i in 0..rows {
+                let value = data[i * cols + j];
+                if value != 0.0 {
+                    row_index.push(i);
+                    values.push(value);
+                }
+            }
+            col_start.push(row_index.len());
+        }
+
+        Ok(Self { rows, cols, col_start, row_index, values })
+    }
+
+    /// Construir desde tripletas (fila, columna, valor)
+    ///
+    /// Las entradas repetidas se suman; los ceros se descartan.
+    pub fn from_triplets(rows: usize, cols: usize, triplets: &[(usize, usize, f64)]) -> Result<Self, String> {
+        let mut sorted: Vec<(usize, usize, f64)> = Vec::with_capacity(triplets.len());
+        for &(i, j, value) in triplets {
+            if i >= rows || j >= cols {
+                return Err(format!(
+                    "Entry ({}, {}) is out of bounds for a {}x{} matrix",
+                    i, j, rows, cols
+                ));
+            }
+            sorted.push((i, j, value));
+        }
+        sorted.sort_by_key(|&(i, j, _)| (j, i));
+
+        let mut col_start = vec![0; cols + 1];
+        let mut row_index: Vec<usize> = Vec::with_capacity(sorted.len());
+        let mut values: Vec<f64> = Vec::with_capacity(sorted.len());
+        let mut last: Option<(usize, usize)> = None;
+        for (i, j, value) in sorted {
+            if last == Some((i, j)) {
+                *values.last_mut().unwrap() += value;
+            } else {
+                row_index.push(i);
+                values.push(value);
+                col_start[j + 1] += 1;
+                last = Some((i, j));
+            }
+        }
+        for j in 0..cols {
+            col_start[j + 1] += col_start[j];
+        }
+
+        let mut matrix = Self { rows, cols, col_start, row_index, values };
+        matrix.drop_zeros();
+        Ok(matrix)
+    }
+
+    /// `[A | I]`: la matriz con una columna de holgura por fila
+    pub fn with_slacks(&self) -> Self {
+        let mut col_start = self.col_start.clone();
+        let mut row_index = self.row_index.clone();
+        let mut values = self.values.clone();
+        for i in 0..self.rows {
+            row_index.push(i);
+            values.push(1.0);
+            col_start.push(row_index.len());
+        }
+
+        Self {
+            rows: self.rows,
+            cols: self.cols + self.rows,
+            col_start,
+            row_index,
+            values,
+        }
+    }
+
+    pub fn rows(&self) -> usize {
+        self.rows
+    }
+
+    pub fn cols(&self) -> usize {
+        self.cols
+    }
+
+    /// Número de entradas no nulas
+    pub fn nnz(&self) -> usize {
+        self.values.len()
+    }
+
+    /// Fracción de entradas no nulas
+    pub fn density(&self) -> f64 {
+        if self.rows == 0 || self.cols == 0 {
+            return 0.0;
+        }
+        self.nnz() as f64 / (self.rows as f64 * self.cols as f64)
+    }
+
+    /// Índices de fila y valores de la columna `j`
+    pub fn column(&self, j: usize) -> (&[usize], &[f64]) {
+        let range = self.col_start[j]..self.col_start[j + 1];
+        (&self.row_index[range.clone()], &self.values[range])
+    }
+
+    /// `y · A_j`
+    pub fn dot_column(&self, j: usize, y: &[f64]) -> f64 {
+        let (rows, values) = self.column(j);
+        rows.iter().zip(values).map(|(&i, &value)| y[i] * value).sum()
+    }
+
+    /// Agregar la columna `j` escalada por `factor` a un vector denso
+    pub fn scatter_column(&self, j: usize, factor: f64, dense: &mut [f64]) {
+        let (rows, values) = self.column(j);
+        for (&i, &value) in rows.iter().zip(values) {
+            dense[i] += factor * value;
+        }
+    }
+
+    fn drop_zeros(&mut self) {
+        let mut write = 0;
+        let mut start = 0;
+        for j in 0..self.cols {
+            let end = self.col_start[j + 1];
+            for read in start..end {
+                if self.values[read] != 0.0 {
+                    self.row_index[write] = self.row_index[read];
+                    self.values[write] = self.values[read];
+                    write += 1;
+                }
+            }
+            start = end;
+            self.col_start[j + 1] = write;
+        }
+        self.row_index.truncate(write);
+        self.values.truncate(write);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_from_dense_and_triplets_agree() {
+        // [1 0 2]
+        // [0 3 0]
+        let dense = RealTensor::matrix(2, 3, vec![1.0, 0.0, 2.0, 0.0, 3.0, 0.0]).unwrap();
+        let from_dense = CscMatrix::from_dense(&dense).unwrap();
+
+        // Entradas desordenadas, una repetida y un cero explícito
+        let from_triplets = CscMatrix::from_triplets(
+            2,
+            3,
+            &[(0, 2, 1.5), (1, 1, 3.0), (0, 0, 1.0), (0, 2, 0.5), (1, 0, 0.0)],
+        )
+        .unwrap();
+
+        assert_eq!(from_dense, from_triplets);
+        assert_eq!(from_dense.nnz(), 3);
+        assert_eq!(from_dense.column(2), (&[0usize][..], &[2.0][..]));
+        assert_eq!(from_dense.dot_column(0, &[2.0, 5.0]), 2.0);
+    }
+
+    #[test]
+    fn test_with_slacks() {
+        let a = CscMatrix::from_triplets(2, 1, &[(1, 0, 4.0)]).unwrap();
+        let aug = a.with_slacks();
+
+        assert_eq!(aug.cols(), 3);
+        assert_eq!(aug.column(1), (&[0usize][..], &[1.0][..]));
+        assert_eq!(aug.column(2), (&[1usize][..], &[1.0][..]));
+    }
+
+    #[test]
+    fn test_triplet_out_of_bounds() {
+        assert!(CscMatrix::from_triplets(2, 2, &[(2, 0, 1.0)]).is_err());
+    }
+}
@@ -278,6 +278,47 @@ impl Tableau {
         solution
     }
 
+    /// Agregar una restricción `row · x ≤ rhs` a un tableau ya pivoteado
+    ///
+    /// La fila se expresa en la base actual y recibe su propia variable de
+    /// holgura, que entra a la base. Si el tableau era óptimo sigue siendo
+    /// dual factible, y cuando la nueva restricción corta la solución actual
+    /// su RHS queda negativo: el Dual Simplex restaura la factibilidad sin
+    /// resolver el problema desde cero (warm start de Branch & Bound).
+    ///
+    /// Args:
+    ///   - row: coeficientes sobre las variables de decisión (n elementos)
+    ///   - rhs: lado derecho (puede ser negativo, p. ej. -xᵢ ≤ -lᵢ)
+    pub fn add_constraint(&mut self, row: &[f64], rhs: f64) {
+        let n = self.num_vars;
+        let m = self.num_constraints;
+
+        // Nueva columna de holgura antes del RHS, en cero en todas las filas
+        for existing in self.data.iter_mut() {
+            existing.insert(n + m, 0.0);
+        }
+
+        let mut new_row = vec![0.0; n + m + 2];
+        new_row[..n].copy_from_slice(row);
+        new_row[n + m] = 1.0;
+        new_row[n + m + 1] = rhs;
+
+        // Eliminar las variables básicas de la nueva fila
+        for (i, &basic_var) in self.basis.iter().enumerate() {
+            let factor = new_row[basic_var];
+            if factor != 0.0 {
+                for (value, &pivot_value) in new_row.iter_mut().zip(&self.data[i]) {
+                    *value -= factor * pivot_value;
+                }
+            }
+        }
+
+        // La fila objetivo queda al final
+        self.data.insert(m, new_row);
+        self.basis.push(n + m);
+        self.num_constraints += 1;
+    }
+
     /// Obtener el valor objetivo actual
     pub fn objective_value(&self) -> f64 {
         let m = self.num_constraints;
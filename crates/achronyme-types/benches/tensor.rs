@@ -0,0 +1,47 @@
+use achronyme_types::tensor::RealTensor;
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+
+/// Deterministic, non-trivial fill so no kernel can shortcut on zeros
+fn matrix(rows: usize, cols: usize) -> RealTensor {
+    let data = (0..rows * cols).map(|i| ((i * 7919) % 1000) as f64 / 1000.0 - 0.5).collect();
+    RealTensor::matrix(rows, cols, data).unwrap()
+}
+
+fn bench_matmul(c: &mut Criterion) {
+    let mut group = c.benchmark_group("tensor/matmul");
+    for n in [16, 64, 128, 256] {
+        let (a, b) = (matrix(n, n), matrix(n, n));
+        group.throughput(Throughput::Elements((n * n * n) as u64));
+        group.bench_with_input(BenchmarkId::from_parameter(n), &n, |bench, _| {
+            bench.iter(|| black_box(&a).matmul(black_box(&b)).unwrap())
+        });
+    }
+    group.finish();
+}
+
+fn bench_broadcast(c: &mut Criterion) {
+    let mut group = c.benchmark_group("tensor/broadcast");
+    for n in [64, 256, 1024] {
+        let a = matrix(n, n);
+        let same = matrix(n, n);
+        let row = matrix(1, n);
+        let column = matrix(n, 1);
+        group.throughput(Throughput::Elements((n * n) as u64));
+        group.bench_with_input(BenchmarkId::new("same_shape", n), &n, |bench, _| {
+            bench.iter(|| black_box(&a).add(black_box(&same)).unwrap())
+        });
+        group.bench_with_input(BenchmarkId::new("row", n), &n, |bench, _| {
+            bench.iter(|| black_box(&a).add(black_box(&row)).unwrap())
+        });
+        group.bench_with_input(BenchmarkId::new("column", n), &n, |bench, _| {
+            bench.iter(|| black_box(&a).mul(black_box(&column)).unwrap())
+        });
+        group.bench_with_input(BenchmarkId::new("scalar", n), &n, |bench, _| {
+            bench.iter(|| black_box(&a).mul_scalar(black_box(1.5)))
+        });
+    }
+    group.finish();
+}
+
+criterion_group!(benches, bench_matmul, bench_broadcast);
+criterion_main!(benches);
@@ -1,7 +1,12 @@
 use std::ops::{Add, Sub, Mul, Div, Neg};
 use std::fmt;
 
+/// Complex number with `f64` parts
+///
+/// `#[repr(C)]` keeps the layout identical to `num_complex::Complex<f64>`,
+/// so slices can be passed to FFT and linear algebra kernels without copying.
 #[derive(Debug, Clone, Copy, PartialEq)]
+#[repr(C)]
 pub struct Complex {
     pub re: f64,
     pub im: f64,
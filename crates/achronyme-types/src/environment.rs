@@ -1,5 +1,7 @@
+use crate::fork::Forker;
 use crate::value::Value;
 use achronyme_parser::type_annotation::TypeAnnotation;
+use achronyme_parser::Symbol;
 use std::collections::HashMap;
 use std::rc::Rc;
 use std::cell::RefCell;
@@ -33,24 +35,42 @@ use std::cell::RefCell;
 /// ```
 #[derive(Debug, Clone)]
 pub struct Environment {
-    /// Current scope variables
-    variables: HashMap<String, Value>,
-    /// Metadata: tracks which variables are mutable
-    mutability: HashMap<String, bool>,
-    /// Metadata: tracks type annotations for variables (for type checking on assignment)
-    type_annotations: HashMap<String, TypeAnnotation>,
+    /// Current scope bindings, in definition order
+    ///
+    /// Each slot keeps its own metadata (mutability, type annotation), so a
+    /// scope is a single flat vector instead of one map per kind of data.
+    slots: Vec<Slot>,
+    /// Name -> slot index, only built once a scope grows past
+    /// `LINEAR_SCAN_LIMIT` bindings (small scopes are scanned linearly)
+    index: Option<HashMap<Symbol, usize>>,
     /// Parent environment (if any)
     /// Now uses RefCell to allow mutation of parent scopes
     parent: Option<Rc<RefCell<Environment>>>,
 }
 
+/// Scopes with at most this many bindings are searched linearly; lambda
+/// parameter scopes (the overwhelmingly common case) never build a map
+const LINEAR_SCAN_LIMIT: usize = 8;
+
+/// A single binding of a scope
+#[derive(Debug, Clone)]
+struct Slot {
+    /// Interned name; scans and index lookups compare handles, not strings
+    name: Symbol,
+    /// The value (a `Value::MutableRef` cell for mutable bindings)
+    value: Value,
+    /// Declared with `mut`
+    mutable: bool,
+    /// Type annotation enforced on assignment (typed `mut` declarations)
+    type_annotation: Option<TypeAnnotation>,
+}
+
 impl Environment {
     /// Create a new empty environment (root scope)
     pub fn new() -> Self {
         Self {
-            variables: HashMap::new(),
-            mutability: HashMap::new(),
-            type_annotations: HashMap::new(),
+            slots: Vec::new(),
+            index: None,
             parent: None,
         }
     }
@@ -58,12 +78,12 @@ impl Environment {
     /// Create a child environment with this environment as parent
     ///
     /// This is now the primary way to create a new scope. It's O(1) because
-    /// we just create a new empty HashMap and an Rc pointer to the parent.
+    /// we just create an empty slot vector (no allocation until the first
+    /// binding) and an Rc pointer to the parent.
     pub fn new_child(parent: Rc<RefCell<Environment>>) -> Self {
         Self {
-            variables: HashMap::new(),
-            mutability: HashMap::new(),
-            type_annotations: HashMap::new(),
+            slots: Vec::new(),
+            index: None,
             parent: Some(parent),
         }
     }
@@ -74,9 +94,9 @@ impl Environment {
     /// points to the old self. Variables defined after this will be in the
     /// new scope and can shadow outer variables.
     ///
-    /// NOTE: This is now implemented by creating a child and swapping.
+    /// O(1): the current scope is moved (not copied) behind the parent Rc.
     pub fn push_scope(&mut self) {
-        let parent = Rc::new(RefCell::new(self.clone()));
+        let parent = Rc::new(RefCell::new(std::mem::take(self)));
         *self = Environment::new_child(parent);
     }
 
@@ -84,10 +104,15 @@ impl Environment {
     ///
     /// This removes the innermost scope and all variables defined in it.
     /// Panics if trying to pop the root scope.
+    ///
+    /// The parent is moved back out of its Rc when nothing else holds it;
+    /// it is only copied when a closure captured the popped scope.
     pub fn pop_scope(&mut self) {
-        if let Some(parent) = self.parent.clone() {
-            // Clone the parent out of the Rc<RefCell<>> and replace self
-            *self = parent.borrow().clone();
+        if let Some(parent) = self.parent.take() {
+            *self = match Rc::try_unwrap(parent) {
+                Ok(parent) => parent.into_inner(),
+                Err(shared) => shared.borrow().clone(),
+            };
         } else {
             panic!("Cannot pop root scope");
         }
@@ -95,13 +120,10 @@ impl Environment {
 
     /// Get the current scope depth (0 = root, 1+ = nested)
     pub fn scope_depth(&self) -> usize {
-        let mut depth = 0;
-        let mut current_parent = self.parent.clone();
-        while let Some(parent) = current_parent {
-            depth += 1;
-            current_parent = parent.borrow().parent.clone();
+        match self.parent {
+            Some(ref parent) => 1 + parent.borrow().scope_depth(),
+            None => 0,
         }
-        depth
     }
 
     /// Define a new variable in the current scope (immutable by default)
@@ -134,14 +156,27 @@ impl Environment {
     /// * `value` - Initial value
     /// * `type_ann` - Type annotation to enforce on assignments
     pub fn define_mutable_typed(&mut self, name: String, value: Value, type_ann: TypeAnnotation) -> Result<(), String> {
-        // Wrap in MutableRef
-        let stored_value = Value::new_mutable(value);
-
-        // Insert into current scope's variables
-        self.variables.insert(name.clone(), stored_value);
-        self.mutability.insert(name.clone(), true);
-        // Store the type annotation for assignment checking
-        self.type_annotations.insert(name, type_ann);
+        // Wrap in MutableRef and store the type annotation for assignment checking
+        self.insert_slot(Slot {
+            name: Symbol::intern(&name),
+            value: Value::new_mutable(value),
+            mutable: true,
+            type_annotation: Some(type_ann),
+        });
+        Ok(())
+    }
+
+    /// Bind an existing mutable cell (a `Value::MutableRef`) in the current scope
+    ///
+    /// Unlike `define_mutable`, the cell is shared rather than copied, so
+    /// assignments through this binding are visible to every other holder of
+    /// the cell (used by the bytecode VM to expose `mut` locals).
+    pub fn bind_cell(&mut self, name: String, cell: Value) -> Result<(), String> {
+        if !matches!(cell, Value::MutableRef(_)) {
+            return Err(format!("Cannot bind '{}': value is not a mutable cell", name));
+        }
+
+        self.insert_slot(Slot { name: Symbol::intern(&name), value: cell, mutable: true, type_annotation: None });
         Ok(())
     }
 
@@ -154,12 +189,49 @@ impl Environment {
             value
         };
 
-        // Insert into current scope's variables
-        self.variables.insert(name.clone(), stored_value);
-        self.mutability.insert(name, is_mutable);
+        self.insert_slot(Slot { name: Symbol::intern(&name), value: stored_value, mutable: is_mutable, type_annotation: None });
         Ok(())
     }
 
+    /// Internal: Find the slot index of `name` in the current scope only
+    #[inline]
+    fn find_slot_index(&self, name: Symbol) -> Option<usize> {
+        match &self.index {
+            Some(index) => index.get(&name).copied(),
+            None => self.slots.iter().position(|slot| slot.name == name),
+        }
+    }
+
+    /// Internal: Find the slot of `name` in the current scope only
+    #[inline]
+    fn find_slot(&self, name: Symbol) -> Option<&Slot> {
+        self.find_slot_index(name).map(|i| &self.slots[i])
+    }
+
+    /// Internal: Insert a binding into the current scope, replacing any
+    /// existing binding of the same name (redefinition in the same scope)
+    fn insert_slot(&mut self, slot: Slot) {
+        if let Some(i) = self.find_slot_index(slot.name) {
+            self.slots[i] = slot;
+            return;
+        }
+
+        if let Some(index) = &mut self.index {
+            index.insert(slot.name, self.slots.len());
+        }
+        self.slots.push(slot);
+
+        if self.index.is_none() && self.slots.len() > LINEAR_SCAN_LIMIT {
+            self.index = Some(
+                self.slots
+                    .iter()
+                    .enumerate()
+                    .map(|(i, slot)| (slot.name, i))
+                    .collect(),
+            );
+        }
+    }
+
     /// Get a variable value, searching from current to parent scopes
     ///
     /// Auto-dereferences MutableRef values for transparent access
@@ -173,18 +245,45 @@ impl Environment {
     /// # Errors
     /// Returns error if variable not found in any scope
     pub fn get(&self, name: &str) -> Result<Value, String> {
+        match Symbol::lookup(name) {
+            Some(symbol) => self.get_symbol(symbol),
+            None => Err(format!("Undefined variable '{}'", name)),
+        }
+    }
+
+    /// `get` for an already interned name (identifiers from the AST)
+    pub fn get_symbol(&self, name: Symbol) -> Result<Value, String> {
+        self.lookup_symbol(name)
+            .unwrap_or_else(|| Err(format!("Undefined variable '{}'", name)))
+    }
+
+    /// The value bound to `name`, or None if no scope binds it
+    ///
+    /// One walk of the scope chain where `has_symbol` + `get_symbol` take two.
+    pub fn lookup_symbol(&self, name: Symbol) -> Option<Result<Value, String>> {
         // Check current scope first
-        if let Some(value) = self.variables.get(name) {
+        if let Some(slot) = self.find_slot(name) {
             // Auto-deref MutableRef for transparent access
-            return value.deref();
+            return Some(slot.value.deref());
         }
 
         // Search parent scopes
-        if let Some(ref parent) = self.parent {
-            return parent.borrow().get(name);
+        self.parent.as_ref()?.borrow().lookup_symbol(name)
+    }
+
+    /// The value in slot `index` of the scope `depth` levels up, provided
+    /// that slot binds `name`
+    ///
+    /// Used for references resolved to a slot ahead of time: no scope is
+    /// searched. None means the slot holds another binding (or doesn't
+    /// exist), and the caller falls back to a lookup by name.
+    pub fn get_slot(&self, depth: usize, index: usize, name: Symbol) -> Option<Result<Value, String>> {
+        if depth > 0 {
+            return self.parent.as_ref()?.borrow().get_slot(depth - 1, index, name);
         }
 
-        Err(format!("Undefined variable '{}'", name))
+        let slot = self.slots.get(index)?;
+        (slot.name == name).then(|| slot.value.deref())
     }
 
     /// Check if a variable is defined in any scope
@@ -195,17 +294,41 @@ impl Environment {
     /// # Returns
     /// true if variable exists in any scope
     pub fn has(&self, name: &str) -> bool {
-        if self.variables.contains_key(name) {
+        Symbol::lookup(name).is_some_and(|symbol| self.has_symbol(symbol))
+    }
+
+    /// `has` for an already interned name
+    pub fn has_symbol(&self, name: Symbol) -> bool {
+        if self.find_slot(name).is_some() {
             return true;
         }
 
         if let Some(ref parent) = self.parent {
-            return parent.borrow().has(name);
+            return parent.borrow().has_symbol(name);
         }
 
         false
     }
 
+    /// Check if the nearest binding of a variable was declared with `mut`
+    ///
+    /// # Returns
+    /// false if the variable is immutable or not defined
+    pub fn is_mutable(&self, name: &str) -> bool {
+        Symbol::lookup(name).is_some_and(|symbol| self.is_mutable_symbol(symbol))
+    }
+
+    fn is_mutable_symbol(&self, name: Symbol) -> bool {
+        if let Some(slot) = self.find_slot(name) {
+            return slot.mutable;
+        }
+
+        match self.parent {
+            Some(ref parent) => parent.borrow().is_mutable_symbol(name),
+            None => false,
+        }
+    }
+
     /// Assign a new value to a mutable variable
     ///
     /// Searches current and parent scopes for the variable.
@@ -223,22 +346,27 @@ impl Environment {
     /// # Returns
     /// Ok(()) on success. Caller should check type annotations separately.
     pub fn assign(&mut self, name: &str, value: Value) -> Result<(), String> {
-        // Check current scope first
-        if let Some(var_value) = self.variables.get(name) {
-            let is_mutable = self.mutability.get(name).copied().unwrap_or(false);
+        match Symbol::lookup(name) {
+            Some(symbol) => self.assign_symbol(symbol, value),
+            None => Err(format!("Undefined variable '{}'", name)),
+        }
+    }
 
-            if !is_mutable {
+    fn assign_symbol(&mut self, name: Symbol, value: Value) -> Result<(), String> {
+        // Check current scope first
+        if let Some(slot) = self.find_slot(name) {
+            if !slot.mutable {
                 return Err(format!("Cannot assign to immutable variable '{}'", name));
             }
 
             // Assign to MutableRef
-            var_value.assign(value)?;
+            slot.value.assign(value)?;
             return Ok(());
         }
 
         // Search and mutate in parent scopes
         if let Some(ref parent) = self.parent {
-            return parent.borrow_mut().assign(name, value);
+            return parent.borrow_mut().assign_symbol(name, value);
         }
 
         Err(format!("Undefined variable '{}'", name))
@@ -248,14 +376,19 @@ impl Environment {
     ///
     /// Searches current and parent scopes.
     pub fn get_type_annotation(&self, name: &str) -> Option<TypeAnnotation> {
+        self.type_annotation_of(Symbol::lookup(name)?)
+    }
+
+    fn type_annotation_of(&self, name: Symbol) -> Option<TypeAnnotation> {
         // Check current scope first
-        if let Some(type_ann) = self.type_annotations.get(name) {
-            return Some(type_ann.clone());
+        // (a binding in the current scope shadows any outer annotation)
+        if let Some(slot) = self.find_slot(name) {
+            return slot.type_annotation.clone();
         }
 
         // Search parent scopes
         if let Some(ref parent) = self.parent {
-            return parent.borrow().get_type_annotation(name);
+            return parent.borrow().type_annotation_of(name);
         }
 
         None
@@ -276,19 +409,21 @@ impl Environment {
     /// of most languages where assignment creates a new binding if it doesn't
     /// exist in the current scope.
     pub fn set(&mut self, name: &str, value: Value) -> Result<(), String> {
+        let Some(symbol) = Symbol::lookup(name) else {
+            return Err(format!("Cannot assign to undefined variable '{}'", name));
+        };
+
         // Check if variable exists in current scope
-        if self.variables.contains_key(name) {
-            self.variables.insert(name.to_string(), value);
+        if let Some(i) = self.find_slot_index(symbol) {
+            self.slots[i].value = value;
             return Ok(());
         }
 
         // Check if it exists in parent scopes
-        if let Some(ref parent) = self.parent {
-            if parent.borrow().has(name) {
-                // Variable exists in parent, but we shadow it in the current scope
-                self.variables.insert(name.to_string(), value);
-                return Ok(());
-            }
+        let in_parent = self.parent.as_ref().is_some_and(|parent| parent.borrow().has_symbol(symbol));
+        if in_parent {
+            // Variable exists in parent, but we shadow it in the current scope
+            return self.define_with_mutability(name.to_string(), value, false);
         }
 
         Err(format!("Cannot assign to undefined variable '{}'", name))
@@ -296,21 +431,35 @@ impl Environment {
 
     /// Clear all variables in the current scope only
     pub fn clear(&mut self) {
-        self.variables.clear();
-        self.mutability.clear();
-        self.type_annotations.clear();
+        self.slots.clear();
+        self.index = None;
         self.parent = None;
     }
 
     /// Get total number of variables in current scope only
     /// (counting parent variables would require traversing the chain)
     pub fn len(&self) -> usize {
-        self.variables.len()
+        self.slots.len()
     }
 
     /// Check if current scope has no variables
     pub fn is_empty(&self) -> bool {
-        self.variables.is_empty()
+        self.slots.is_empty()
+    }
+
+    /// Names of all visible variables, sorted and without duplicates
+    ///
+    /// Unlike `snapshot()` this copies no values; pair it with `get()` to
+    /// visit bindings one at a time.
+    pub fn visible_names(&self) -> Vec<String> {
+        let mut names = match self.parent {
+            Some(ref parent) => parent.borrow().visible_names(),
+            None => Vec::new(),
+        };
+        names.extend(self.slots.iter().map(|slot| slot.name.to_string()));
+        names.sort_unstable();
+        names.dedup();
+        names
     }
 
     /// Get a snapshot of all visible variables (for lambda closures)
@@ -329,11 +478,11 @@ impl Environment {
         }
 
         // Add/override with current scope (deref MutableRef values)
-        for (name, value) in &self.variables {
-            if let Ok(derefed) = value.deref() {
-                snapshot.insert(name.clone(), derefed);
+        for slot in &self.slots {
+            if let Ok(derefed) = slot.value.deref() {
+                snapshot.insert(slot.name.to_string(), derefed);
             } else {
-                snapshot.insert(name.clone(), value.clone());
+                snapshot.insert(slot.name.to_string(), slot.value.clone());
             }
         }
 
@@ -346,12 +495,12 @@ impl Environment {
     ///
     /// DEPRECATED: This is kept for backward compatibility.
     pub fn from_snapshot(snapshot: HashMap<String, Value>) -> Self {
-        Self {
-            variables: snapshot,
-            mutability: HashMap::new(), // No mutability info in snapshot
-            type_annotations: HashMap::new(), // No type info in snapshot
-            parent: None,
+        let mut env = Self::new();
+        for (name, value) in snapshot {
+            // No mutability or type info in snapshot
+            env.insert_slot(Slot { name: Symbol::intern(&name), value, mutable: false, type_annotation: None });
         }
+        env
     }
 
     /// Convert this environment to an Rc<RefCell<>> for efficient sharing
@@ -365,6 +514,37 @@ impl Environment {
     pub fn with_parent(parent: Rc<RefCell<Environment>>) -> Self {
         Self::new_child(parent)
     }
+
+    /// Copy of this environment whose mutable state is independent
+    ///
+    /// Immutable values (functions without mutable captures, tensors,
+    /// parent scopes) stay shared; see [`Forker`] for the details.
+    pub fn fork(&self) -> Environment {
+        Forker::new().environment(self)
+    }
+
+    /// The forked environment, or None when nothing in the chain needs a copy
+    pub(crate) fn fork_with(&self, forker: &mut Forker) -> Option<Environment> {
+        let parent = self.parent.as_ref().and_then(|parent| forker.env_rc(parent));
+        let changed: Vec<(usize, Value)> = self
+            .slots
+            .iter()
+            .enumerate()
+            .filter_map(|(i, slot)| forker.fork_value(&slot.value).map(|value| (i, value)))
+            .collect();
+        if parent.is_none() && changed.is_empty() {
+            return None;
+        }
+
+        let mut env = self.clone();
+        for (i, value) in changed {
+            env.slots[i].value = value;
+        }
+        if parent.is_some() {
+            env.parent = parent;
+        }
+        Some(env)
+    }
 }
 
 impl Default for Environment {
@@ -91,6 +91,22 @@ fn test_has() {
     assert!(env.has("x"));
 }
 
+#[test]
+fn test_is_mutable() {
+    let mut env = Environment::new();
+    assert!(!env.is_mutable("x"));
+    env.define_mutable("x".to_string(), Value::Number(1.0)).unwrap();
+    env.define("y".to_string(), Value::Number(2.0)).unwrap();
+    assert!(env.is_mutable("x"));
+    assert!(!env.is_mutable("y"));
+
+    // The nearest binding decides
+    env.push_scope();
+    assert!(env.is_mutable("x"));
+    env.define("x".to_string(), Value::Number(3.0)).unwrap();
+    assert!(!env.is_mutable("x"));
+}
+
 #[test]
 fn test_set_existing() {
     let mut env = Environment::new();
@@ -167,3 +183,131 @@ fn test_scope_depth() {
     env.pop_scope();
     assert_eq!(env.scope_depth(), 1);
 }
+
+#[test]
+fn test_bind_cell_shares_value() {
+    let mut env = Environment::new();
+    let cell = Value::new_mutable(Value::Number(1.0));
+
+    env.push_scope();
+    env.bind_cell("x".to_string(), cell.clone()).unwrap();
+    env.assign("x", Value::Number(2.0)).unwrap();
+    env.pop_scope();
+
+    // The assignment went through the shared cell
+    assert_eq!(cell.deref().unwrap(), Value::Number(2.0));
+
+    // Only cells can be bound
+    assert!(env.bind_cell("y".to_string(), Value::Number(1.0)).is_err());
+}
+
+#[test]
+fn test_large_scope_uses_index() {
+    let mut env = Environment::new();
+    for i in 0..20 {
+        env.define(format!("v{}", i), Value::Number(i as f64)).unwrap();
+    }
+    // Redefinition replaces the binding instead of adding a new one
+    env.define_mutable("v3".to_string(), Value::Number(30.0)).unwrap();
+
+    assert_eq!(env.len(), 20);
+    assert_eq!(env.get("v3").unwrap(), Value::Number(30.0));
+    assert_eq!(env.get("v19").unwrap(), Value::Number(19.0));
+    assert!(env.assign("v3", Value::Number(31.0)).is_ok());
+    assert!(env.assign("v4", Value::Number(0.0)).is_err());
+}
+
+#[test]
+fn test_redefinition_resets_type_annotation() {
+    use achronyme_parser::type_annotation::TypeAnnotation;
+
+    let mut env = Environment::new();
+    env.define_mutable_typed("x".to_string(), Value::Number(1.0), TypeAnnotation::Number).unwrap();
+    assert_eq!(env.get_type_annotation("x"), Some(TypeAnnotation::Number));
+
+    env.define_mutable("x".to_string(), Value::String("a".to_string())).unwrap();
+    assert_eq!(env.get_type_annotation("x"), None);
+
+    // An untyped inner binding shadows an outer annotation
+    env.define_mutable_typed("y".to_string(), Value::Number(1.0), TypeAnnotation::Number).unwrap();
+    env.push_scope();
+    env.define_mutable("y".to_string(), Value::Boolean(true)).unwrap();
+    assert_eq!(env.get_type_annotation("y"), None);
+    env.pop_scope();
+    assert_eq!(env.get_type_annotation("y"), Some(TypeAnnotation::Number));
+}
+
+#[test]
+fn test_pop_scope_with_captured_child() {
+    let mut env = Environment::new();
+    env.define("x".to_string(), Value::Number(1.0)).unwrap();
+
+    env.push_scope();
+    env.define("y".to_string(), Value::Number(2.0)).unwrap();
+    // A closure capturing the inner scope shares its parent
+    let captured = env.to_rc();
+    env.pop_scope();
+
+    assert_eq!(env.get("x").unwrap(), Value::Number(1.0));
+    assert!(!env.has("y"));
+    assert_eq!(captured.borrow().get("x").unwrap(), Value::Number(1.0));
+    assert_eq!(captured.borrow().get("y").unwrap(), Value::Number(2.0));
+}
+
+#[test]
+fn test_fork_copies_mutable_state() {
+    use crate::function::Function;
+    use achronyme_parser::ast::AstNode;
+
+    let mut base = Environment::new();
+    let cell = Value::new_mutable(Value::Number(0.0));
+    base.bind_cell("count".to_string(), cell.clone()).unwrap();
+    base.bind_cell("alias".to_string(), cell).unwrap();
+
+    // A closure over the cell, and one over immutable bindings only
+    let counter = Function::new_with_env(vec![], AstNode::Number(0.0), base.to_rc());
+    let mut pure_env = Environment::new();
+    pure_env.define("k".to_string(), Value::Number(2.0)).unwrap();
+    let pure = Value::Function(Rc::new(Function::new_with_env(vec![], AstNode::Number(0.0), pure_env.to_rc())));
+    base.define("counter".to_string(), Value::from(counter)).unwrap();
+    base.define("pure".to_string(), pure.clone()).unwrap();
+
+    let mut session = base.fork();
+    session.assign("count", Value::Number(5.0)).unwrap();
+    assert_eq!(base.get("count").unwrap(), Value::Number(0.0));
+    // Bindings that shared a cell still share the forked one
+    assert_eq!(session.get("alias").unwrap(), Value::Number(5.0));
+
+    let Value::Function(forked) = session.get("counter").unwrap() else { panic!("expected a function") };
+    let Function::UserDefined { closure_env, .. } = &*forked else { panic!("expected a lambda") };
+    assert_eq!(closure_env.borrow().get("count").unwrap(), Value::Number(5.0));
+
+    // Nothing mutable is reachable from `pure`, so it is shared
+    let (Value::Function(original), Value::Function(shared)) = (pure, session.get("pure").unwrap()) else {
+        panic!("expected functions")
+    };
+    assert!(Rc::ptr_eq(&original, &shared));
+}
+
+#[test]
+fn test_get_slot_checks_the_binding() {
+    let mut env = Environment::new();
+    env.define("a".to_string(), Value::Number(1.0)).unwrap();
+    env.push_scope();
+    env.define("b".to_string(), Value::Number(2.0)).unwrap();
+    env.define_mutable("c".to_string(), Value::Number(3.0)).unwrap();
+
+    let (a, b, c) = (Symbol::intern("a"), Symbol::intern("b"), Symbol::intern("c"));
+    assert_eq!(env.get_slot(1, 0, a), Some(Ok(Value::Number(1.0))));
+    assert_eq!(env.get_slot(0, 0, b), Some(Ok(Value::Number(2.0))));
+    // Mutable cells are dereferenced like `get`
+    assert_eq!(env.get_slot(0, 1, c), Some(Ok(Value::Number(3.0))));
+
+    // A slot holding another name, or no slot at all, is a miss
+    assert_eq!(env.get_slot(0, 0, a), None);
+    assert_eq!(env.get_slot(0, 5, b), None);
+    assert_eq!(env.get_slot(3, 0, a), None);
+
+    assert_eq!(env.lookup_symbol(a), Some(Ok(Value::Number(1.0))));
+    assert_eq!(env.lookup_symbol(Symbol::intern("missing_slot_name")), None);
+}
@@ -0,0 +1,231 @@
+//! Copy-on-fork of environments and values
+//!
+//! Values are cheap to clone: tensors share their `Arc` buffer, functions
+//! and sequences their `Rc`. Cloning alone does not isolate two sessions,
+//! though, because mutable state lives in shared cells: `mut` bindings
+//! (`MutableRef`), generators, and closure environments that capture them.
+//!
+//! A [`Forker`] walks values and gives every such cell a fresh copy. Anything
+//! that can't reach mutable state is shared with the original. Cells are
+//! memoized by address, so bindings that shared a cell before the fork
+//! still share one afterwards. Cyclic structures (a closure stored in the
+//! `mut` binding it captures) fork in one pass.
+//!
+//! ```
+//! use achronyme_types::Environment;
+//! use achronyme_types::value::Value;
+//!
+//! let mut base = Environment::new();
+//! base.define_mutable("count".to_string(), Value::Number(0.0)).unwrap();
+//!
+//! let mut session = base.fork();
+//! session.assign("count", Value::Number(5.0)).unwrap();
+//! assert_eq!(base.get("count").unwrap(), Value::Number(0.0));
+//! ```
+
+use std::cell::RefCell;
+use std::collections::HashMap;
+use std::rc::Rc;
+
+use crate::environment::Environment;
+use crate::function::Function;
+use crate::sequence::{Sequence, SequenceSource, SequenceStage};
+use crate::generator::GeneratorIterator;
+use crate::value::{ErrorValue, GeneratorState, Value};
+
+/// Memo of the cells, environments and closures forked so far, by address
+///
+/// Use one forker for everything that must stay consistent after the fork
+/// (an environment plus values kept beside it, such as module exports).
+#[derive(Default)]
+pub struct Forker {
+    cells: HashMap<usize, Rc<RefCell<Value>>>,
+    generators: HashMap<usize, Rc<RefCell<GeneratorState>>>,
+    envs: HashMap<usize, Rc<RefCell<Environment>>>,
+    functions: HashMap<usize, Rc<Function>>,
+}
+
+impl Forker {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// `value` with its mutable state copied
+    pub fn value(&mut self, value: &Value) -> Value {
+        self.fork_value(value).unwrap_or_else(|| value.clone())
+    }
+
+    /// `env` (its whole scope chain) with its mutable state copied
+    pub fn environment(&mut self, env: &Environment) -> Environment {
+        env.fork_with(self).unwrap_or_else(|| env.clone())
+    }
+
+    /// The forked value, or None when `value` can be shared as is
+    pub(crate) fn fork_value(&mut self, value: &Value) -> Option<Value> {
+        match value {
+            Value::MutableRef(cell) => Some(Value::MutableRef(self.cell(cell))),
+            Value::Generator(state) => Some(Value::Generator(self.generator(state))),
+            Value::Function(function) => self.function(function).map(Value::Function),
+            Value::Sequence(sequence) => self.sequence(sequence).map(|s| Value::Sequence(Rc::new(s))),
+            Value::Vector(items) => self.values(items).map(Value::Vector),
+            Value::Record(fields) => self.fields(fields).map(|f| Value::Record(Box::new(f))),
+            Value::Edge { from, to, directed, properties } => self.fields(properties).map(|properties| Value::Edge {
+                from: *from,
+                to: *to,
+                directed: *directed,
+                properties: Box::new(properties),
+            }),
+            Value::Error(error) => {
+                let source = self.fork_value(error.source.as_deref()?)?;
+                Some(Value::Error(Box::new(ErrorValue {
+                    source: Some(Box::new(source)),
+                    ..(**error).clone()
+                })))
+            }
+            _ => None,
+        }
+    }
+
+    /// Forked parent environment, or None when it can be shared
+    pub(crate) fn env_rc(&mut self, env: &Rc<RefCell<Environment>>) -> Option<Rc<RefCell<Environment>>> {
+        let key = Rc::as_ptr(env) as usize;
+        let forked = match self.envs.get(&key) {
+            Some(forked) => forked.clone(),
+            None => {
+                let forked = match env.borrow().fork_with(self) {
+                    Some(copy) => Rc::new(RefCell::new(copy)),
+                    None => env.clone(),
+                };
+                self.envs.insert(key, forked.clone());
+                forked
+            }
+        };
+        (!Rc::ptr_eq(&forked, env)).then_some(forked)
+    }
+
+    fn cell(&mut self, cell: &Rc<RefCell<Value>>) -> Rc<RefCell<Value>> {
+        let key = Rc::as_ptr(cell) as usize;
+        if let Some(forked) = self.cells.get(&key) {
+            return forked.clone();
+        }
+        // Registered before its contents so a cycle back to it terminates
+        let forked = Rc::new(RefCell::new(Value::Null));
+        self.cells.insert(key, forked.clone());
+        let contents = cell.borrow().clone();
+        *forked.borrow_mut() = self.value(&contents);
+        forked
+    }
+
+    fn generator(&mut self, state: &Rc<RefCell<GeneratorState>>) -> Rc<RefCell<GeneratorState>> {
+        let key = Rc::as_ptr(state) as usize;
+        if let Some(forked) = self.generators.get(&key) {
+            return forked.clone();
+        }
+        let original = state.borrow().clone();
+        let forked = Rc::new(RefCell::new(original.clone()));
+        self.generators.insert(key, forked.clone());
+
+        let env = self.environment(&original.env);
+        let iterators = original
+            .iterators
+            .iter()
+            .map(|iterator| match iterator {
+                GeneratorIterator::Next(function) => {
+                    GeneratorIterator::Next(self.function(function).unwrap_or_else(|| function.clone()))
+                }
+                GeneratorIterator::Generator(inner) => GeneratorIterator::Generator(self.generator(inner)),
+            })
+            .collect();
+        let return_value = original.return_value.as_deref().map(|value| Box::new(self.value(value)));
+
+        let mut copy = forked.borrow_mut();
+        copy.env = env;
+        copy.iterators = iterators;
+        copy.return_value = return_value;
+        drop(copy);
+        forked
+    }
+
+    fn function(&mut self, function: &Rc<Function>) -> Option<Rc<Function>> {
+        let key = Rc::as_ptr(function) as usize;
+        let forked = match self.functions.get(&key) {
+            Some(forked) => forked.clone(),
+            None => {
+                let forked = match &**function {
+                    Function::UserDefined { params, param_types, return_type, body, closure_env } => {
+                        match self.env_rc(closure_env) {
+                            Some(env) => Rc::new(Function::UserDefined {
+                                params: params.clone(),
+                                param_types: param_types.clone(),
+                                return_type: return_type.clone(),
+                                body: body.clone(),
+                                closure_env: env,
+                            }),
+                            None => function.clone(),
+                        }
+                    }
+                    Function::Builtin(_) => function.clone(),
+                };
+                self.functions.insert(key, forked.clone());
+                forked
+            }
+        };
+        (!Rc::ptr_eq(&forked, function)).then_some(forked)
+    }
+
+    fn sequence(&mut self, sequence: &Sequence) -> Option<Sequence> {
+        let source = match &sequence.source {
+            SequenceSource::Range { .. } => None,
+            SequenceSource::Collection(value) => self.fork_value(value).map(SequenceSource::Collection),
+            SequenceSource::Generator(state) => Some(SequenceSource::Generator(self.generator(state))),
+        };
+        let stages: Vec<Option<SequenceStage>> = sequence
+            .stages
+            .iter()
+            .map(|stage| match stage {
+                SequenceStage::Map(function) => self.function(function).map(SequenceStage::Map),
+                SequenceStage::Filter(function) => self.function(function).map(SequenceStage::Filter),
+                SequenceStage::Take(_) => None,
+            })
+            .collect();
+
+        if source.is_none() && stages.iter().all(Option::is_none) {
+            return None;
+        }
+        Some(Sequence {
+            source: source.unwrap_or_else(|| sequence.source.clone()),
+            stages: stages
+                .into_iter()
+                .zip(&sequence.stages)
+                .map(|(forked, original)| forked.unwrap_or_else(|| original.clone()))
+                .collect(),
+        })
+    }
+
+    fn values(&mut self, items: &[Value]) -> Option<Vec<Value>> {
+        let forked: Vec<Option<Value>> = items.iter().map(|item| self.fork_value(item)).collect();
+        if forked.iter().all(Option::is_none) {
+            return None;
+        }
+        Some(
+            forked
+                .into_iter()
+                .zip(items)
+                .map(|(forked, original)| forked.unwrap_or_else(|| original.clone()))
+                .collect(),
+        )
+    }
+
+    fn fields(&mut self, fields: &HashMap<String, Value>) -> Option<HashMap<String, Value>> {
+        let changed: Vec<(String, Value)> = fields
+            .iter()
+            .filter_map(|(name, value)| self.fork_value(value).map(|forked| (name.clone(), forked)))
+            .collect();
+        if changed.is_empty() {
+            return None;
+        }
+        let mut copy = fields.clone();
+        copy.extend(changed);
+        Some(copy)
+    }
+}
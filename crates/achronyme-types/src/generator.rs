@@ -0,0 +1,47 @@
+//! Generator bodies as resumable programs
+//!
+//! A `generate { ... }` body is lowered once into a flat list of
+//! [`GeneratorOp`]s. Loops and branches that contain a `yield` become
+//! conditional jumps, so suspending a generator only means saving the index
+//! of the next op; resuming jumps straight back there instead of re-walking
+//! the statements that led to the yield. Statements without a `yield` are
+//! kept whole and evaluated by the tree-walker.
+
+use std::cell::RefCell;
+use std::rc::Rc;
+
+use achronyme_parser::ast::AstNode;
+
+use crate::function::Function;
+use crate::value::GeneratorState;
+
+/// One step of a lowered generator body
+#[derive(Debug, Clone, PartialEq)]
+pub enum GeneratorOp {
+    /// Evaluate a statement that contains no yield
+    Eval(AstNode),
+    /// Evaluate the expression and suspend with its value
+    Yield(AstNode),
+    /// Continue at `target` unless the condition is truthy
+    JumpUnless { condition: AstNode, target: usize },
+    /// Continue at `target`
+    Jump(usize),
+    /// Open a block scope (`do { }` / loop body)
+    PushScope,
+    /// Close the innermost block scope
+    PopScope,
+    /// Evaluate a for-in iterable and push its iterator
+    IterStart(AstNode),
+    /// Bind the next item of the innermost iterator to `variable`, or drop
+    /// the iterator and continue at `exit` when it is done
+    IterNext { variable: String, exit: usize },
+}
+
+/// Iterator of a for-in loop suspended inside a generator body
+#[derive(Debug, Clone)]
+pub enum GeneratorIterator {
+    /// Record iterator, through its `next` method
+    Next(Rc<Function>),
+    /// Another generator
+    Generator(Rc<RefCell<GeneratorState>>),
+}
@@ -2,10 +2,15 @@ pub mod value;
 pub mod complex;
 pub mod tensor;
 pub mod function;
+pub mod sequence;
+pub mod generator;
 pub mod lambda_evaluator;
 pub mod environment;
+pub mod fork;
 
 // Re-exports
 pub use lambda_evaluator::LambdaEvaluator;
 pub use environment::Environment;
+pub use fork::Forker;
+pub use achronyme_parser::Symbol;
 pub use value::GeneratorState;
\ No newline at end of file
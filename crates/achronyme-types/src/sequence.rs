@@ -0,0 +1,65 @@
+//! Lazy sequences
+//!
+//! A `Sequence` is a recipe: a source of elements plus the `map`, `filter`
+//! and `take` stages still to apply to them. Nothing is computed when one
+//! is built; the evaluator pulls elements one at a time through every stage
+//! when the sequence is consumed (`reduce`, `collect`, `for ... in`), so a
+//! chain of stages runs as a single loop in constant memory.
+//!
+//! Sequences over ranges and collections can be consumed any number of
+//! times. A sequence over a generator resumes that generator, so consuming
+//! it consumes the generator.
+
+use std::cell::RefCell;
+use std::rc::Rc;
+
+use crate::function::Function;
+use crate::value::{GeneratorState, Value};
+
+/// Where the elements of a sequence come from
+#[derive(Debug, Clone)]
+pub enum SequenceSource {
+    /// start, start + step, ... while before `end` (exclusive), as `range()`
+    Range { start: f64, end: f64, step: f64 },
+    /// Elements of a Vector, Tensor or ComplexTensor value
+    Collection(Value),
+    /// A generator, resumed for each element
+    Generator(Rc<RefCell<GeneratorState>>),
+}
+
+/// A transformation applied to each element pulled through a sequence
+#[derive(Debug, Clone)]
+pub enum SequenceStage {
+    Map(Rc<Function>),
+    Filter(Rc<Function>),
+    /// Stop after this many elements have reached the stage
+    Take(usize),
+}
+
+/// Source plus pending stages, applied in order
+#[derive(Debug, Clone)]
+pub struct Sequence {
+    pub source: SequenceSource,
+    pub stages: Vec<SequenceStage>,
+}
+
+impl Sequence {
+    /// Sequence with no stages over `source`
+    pub fn new(source: SequenceSource) -> Self {
+        Self { source, stages: Vec::new() }
+    }
+
+    /// This sequence followed by one more stage
+    pub fn then(&self, stage: SequenceStage) -> Self {
+        let mut stages = self.stages.clone();
+        stages.push(stage);
+        Self { source: self.source.clone(), stages }
+    }
+}
+
+/// Sequences are compared by identity, like the generators they may wrap
+impl PartialEq for Sequence {
+    fn eq(&self, other: &Self) -> bool {
+        std::ptr::eq(self, other)
+    }
+}
@@ -0,0 +1,38 @@
+//! Tensor buffer allocation counter
+//!
+//! Counts the buffers tensors allocate on the current thread: `Tensor::new`,
+//! materialized views and the copy-on-write copy in `data_mut`. Counting is
+//! off by default; while it is off the only cost is one thread-local flag
+//! check per allocation.
+
+use std::cell::Cell;
+use std::sync::Arc;
+
+thread_local! {
+    static TRACKING: Cell<bool> = const { Cell::new(false) };
+    static ALLOCATIONS: Cell<u64> = const { Cell::new(0) };
+}
+
+/// Start or stop counting tensor buffer allocations on this thread
+pub fn set_allocation_tracking(enabled: bool) {
+    TRACKING.with(|tracking| tracking.set(enabled));
+}
+
+/// Whether tensor buffer allocations are being counted on this thread
+pub fn is_allocation_tracking() -> bool {
+    TRACKING.with(Cell::get)
+}
+
+/// Buffers allocated on this thread while tracking was on
+pub fn allocation_count() -> u64 {
+    ALLOCATIONS.with(Cell::get)
+}
+
+/// Shared storage for a new tensor buffer
+#[inline]
+pub(crate) fn new_storage<T>(data: Vec<T>) -> Arc<Vec<T>> {
+    if TRACKING.with(Cell::get) {
+        ALLOCATIONS.with(|count| count.set(count.get() + 1));
+    }
+    Arc::new(data)
+}
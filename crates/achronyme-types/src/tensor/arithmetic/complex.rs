@@ -1,5 +1,6 @@
 use crate::complex::Complex;
-use crate::tensor::core::{ComplexTensor, RealTensor, Tensor, TensorError};
+use crate::tensor::complex_kernels as kernels;
+use crate::tensor::core::{ComplexTensor, RealTensor, TensorError};
 
 // ============================================================================
 // Arithmetic Operations for ComplexTensor
@@ -8,143 +9,144 @@ use crate::tensor::core::{ComplexTensor, RealTensor, Tensor, TensorError};
 impl ComplexTensor {
     /// Element-wise addition with broadcasting
     pub fn add(&self, other: &ComplexTensor) -> Result<ComplexTensor, TensorError> {
-        // Fast path: if shapes are identical, use direct element-wise operation
-        if self.shape == other.shape {
-            let data: Vec<Complex> = self.data.iter()
-                .zip(other.data.iter())
-                .map(|(a, b)| *a + *b)
-                .collect();
-            return ComplexTensor::new(data, self.shape.clone());
-        }
-
-        // Broadcasting path
-        let result_shape = Tensor::<Complex>::broadcast_shape(&self.shape, &other.shape)?;
-        let result_strides = Tensor::<Complex>::compute_strides(&result_shape);
-        let result_size: usize = result_shape.iter().product();
-
-        let mut data = Vec::with_capacity(result_size);
+        self.broadcast_zip(other, |a, b| *a + *b)
+    }
 
-        for flat_idx in 0..result_size {
-            let result_indices = Tensor::<Complex>::unravel_index(flat_idx, &result_shape, &result_strides);
-            let self_indices = Tensor::<Complex>::broadcast_index(&result_indices, &self.shape, &result_shape);
-            let other_indices = Tensor::<Complex>::broadcast_index(&result_indices, &other.shape, &result_shape);
+    /// Element-wise subtraction with broadcasting
+    pub fn sub(&self, other: &ComplexTensor) -> Result<ComplexTensor, TensorError> {
+        self.broadcast_zip(other, |a, b| *a - *b)
+    }
 
-            let a = self.get(&self_indices)?;
-            let b = other.get(&other_indices)?;
-            data.push(*a + *b);
+    /// Element-wise multiplication with broadcasting
+    pub fn mul(&self, other: &ComplexTensor) -> Result<ComplexTensor, TensorError> {
+        if self.shape == other.shape {
+            let mut data = self.data().to_vec();
+            kernels::mul_assign(&mut data, other.data());
+            return ComplexTensor::new(data, self.shape.clone());
         }
-
-        ComplexTensor::new(data, result_shape)
+        self.broadcast_zip(other, |a, b| *a * *b)
     }
 
-    /// Element-wise subtraction with broadcasting
-    pub fn sub(&self, other: &ComplexTensor) -> Result<ComplexTensor, TensorError> {
-        // Fast path: if shapes are identical, use direct element-wise operation
+    /// Element-wise division with broadcasting
+    pub fn div(&self, other: &ComplexTensor) -> Result<ComplexTensor, TensorError> {
         if self.shape == other.shape {
-            let data: Vec<Complex> = self.data.iter()
-                .zip(other.data.iter())
-                .map(|(a, b)| *a - *b)
-                .collect();
+            let mut data = self.data().to_vec();
+            kernels::div_assign(&mut data, other.data());
             return ComplexTensor::new(data, self.shape.clone());
         }
+        self.broadcast_zip(other, |a, b| *a / *b)
+    }
 
-        // Broadcasting path
-        let result_shape = Tensor::<Complex>::broadcast_shape(&self.shape, &other.shape)?;
-        let result_strides = Tensor::<Complex>::compute_strides(&result_shape);
-        let result_size: usize = result_shape.iter().product();
+    // ------------------------------------------------------------------------
+    // Ownership-aware variants: reuse an existing buffer instead of allocating
+    // ------------------------------------------------------------------------
 
-        let mut data = Vec::with_capacity(result_size);
+    /// In-place element-wise addition; `other` must broadcast to `self`'s shape
+    pub fn add_assign(&mut self, other: &ComplexTensor) -> Result<(), TensorError> {
+        self.broadcast_zip_assign(other, |a, b| *a = *a + *b)
+    }
 
-        for flat_idx in 0..result_size {
-            let result_indices = Tensor::<Complex>::unravel_index(flat_idx, &result_shape, &result_strides);
-            let self_indices = Tensor::<Complex>::broadcast_index(&result_indices, &self.shape, &result_shape);
-            let other_indices = Tensor::<Complex>::broadcast_index(&result_indices, &other.shape, &result_shape);
+    /// In-place element-wise subtraction; `other` must broadcast to `self`'s shape
+    pub fn sub_assign(&mut self, other: &ComplexTensor) -> Result<(), TensorError> {
+        self.broadcast_zip_assign(other, |a, b| *a = *a - *b)
+    }
 
-            let a = self.get(&self_indices)?;
-            let b = other.get(&other_indices)?;
-            data.push(*a - *b);
+    /// In-place element-wise multiplication; `other` must broadcast to `self`'s shape
+    pub fn mul_assign(&mut self, other: &ComplexTensor) -> Result<(), TensorError> {
+        if self.shape == other.shape {
+            kernels::mul_assign(self.data_mut(), other.data());
+            return Ok(());
         }
-
-        ComplexTensor::new(data, result_shape)
+        self.broadcast_zip_assign(other, |a, b| *a = *a * *b)
     }
 
-    /// Element-wise multiplication with broadcasting
-    pub fn mul(&self, other: &ComplexTensor) -> Result<ComplexTensor, TensorError> {
-        // Fast path: if shapes are identical, use direct element-wise operation
+    /// In-place element-wise division; `other` must broadcast to `self`'s shape
+    pub fn div_assign(&mut self, other: &ComplexTensor) -> Result<(), TensorError> {
         if self.shape == other.shape {
-            let data: Vec<Complex> = self.data.iter()
-                .zip(other.data.iter())
-                .map(|(a, b)| *a * *b)
-                .collect();
-            return ComplexTensor::new(data, self.shape.clone());
+            kernels::div_assign(self.data_mut(), other.data());
+            return Ok(());
         }
+        self.broadcast_zip_assign(other, |a, b| *a = *a / *b)
+    }
 
-        // Broadcasting path
-        let result_shape = Tensor::<Complex>::broadcast_shape(&self.shape, &other.shape)?;
-        let result_strides = Tensor::<Complex>::compute_strides(&result_shape);
-        let result_size: usize = result_shape.iter().product();
-
-        let mut data = Vec::with_capacity(result_size);
+    /// Element-wise addition that reuses an operand's buffer
+    pub fn add_owned(self, other: ComplexTensor) -> Result<ComplexTensor, TensorError> {
+        self.broadcast_zip_owned(other, |a, b| *a + *b)
+    }
 
-        for flat_idx in 0..result_size {
-            let result_indices = Tensor::<Complex>::unravel_index(flat_idx, &result_shape, &result_strides);
-            let self_indices = Tensor::<Complex>::broadcast_index(&result_indices, &self.shape, &result_shape);
-            let other_indices = Tensor::<Complex>::broadcast_index(&result_indices, &other.shape, &result_shape);
+    /// Element-wise subtraction that reuses an operand's buffer
+    pub fn sub_owned(self, other: ComplexTensor) -> Result<ComplexTensor, TensorError> {
+        self.broadcast_zip_owned(other, |a, b| *a - *b)
+    }
 
-            let a = self.get(&self_indices)?;
-            let b = other.get(&other_indices)?;
-            data.push(*a * *b);
+    /// Element-wise multiplication that reuses an operand's buffer
+    pub fn mul_owned(mut self, other: ComplexTensor) -> Result<ComplexTensor, TensorError> {
+        if self.shape == other.shape {
+            self.mul_assign(&other)?;
+            return Ok(self);
         }
-
-        ComplexTensor::new(data, result_shape)
+        self.broadcast_zip_owned(other, |a, b| *a * *b)
     }
 
-    /// Element-wise division with broadcasting
-    pub fn div(&self, other: &ComplexTensor) -> Result<ComplexTensor, TensorError> {
-        // Fast path: if shapes are identical, use direct element-wise operation
+    /// Element-wise division that reuses an operand's buffer
+    pub fn div_owned(mut self, other: ComplexTensor) -> Result<ComplexTensor, TensorError> {
         if self.shape == other.shape {
-            let data: Vec<Complex> = self.data.iter()
-                .zip(other.data.iter())
-                .map(|(a, b)| *a / *b)
-                .collect();
-            return ComplexTensor::new(data, self.shape.clone());
+            self.div_assign(&other)?;
+            return Ok(self);
         }
+        self.broadcast_zip_owned(other, |a, b| *a / *b)
+    }
+
+    /// In-place scalar addition
+    pub fn add_scalar_assign(&mut self, scalar: Complex) {
+        self.map_in_place(|x| *x + scalar);
+    }
 
-        // Broadcasting path
-        let result_shape = Tensor::<Complex>::broadcast_shape(&self.shape, &other.shape)?;
-        let result_strides = Tensor::<Complex>::compute_strides(&result_shape);
-        let result_size: usize = result_shape.iter().product();
+    /// In-place scalar subtraction (tensor - scalar)
+    pub fn sub_scalar_assign(&mut self, scalar: Complex) {
+        self.map_in_place(|x| *x - scalar);
+    }
 
-        let mut data = Vec::with_capacity(result_size);
+    /// In-place reversed scalar subtraction (scalar - tensor)
+    pub fn rsub_scalar_assign(&mut self, scalar: Complex) {
+        self.map_in_place(|x| scalar - *x);
+    }
 
-        for flat_idx in 0..result_size {
-            let result_indices = Tensor::<Complex>::unravel_index(flat_idx, &result_shape, &result_strides);
-            let self_indices = Tensor::<Complex>::broadcast_index(&result_indices, &self.shape, &result_shape);
-            let other_indices = Tensor::<Complex>::broadcast_index(&result_indices, &other.shape, &result_shape);
+    /// In-place scalar multiplication
+    pub fn mul_scalar_assign(&mut self, scalar: Complex) {
+        kernels::scale_assign(self.data_mut(), scalar);
+    }
 
-            let a = self.get(&self_indices)?;
-            let b = other.get(&other_indices)?;
-            data.push(*a / *b);
+    /// In-place scalar division (tensor / scalar)
+    pub fn div_scalar_assign(&mut self, scalar: Complex) -> Result<(), String> {
+        if scalar.re == 0.0 && scalar.im == 0.0 {
+            return Err("Division by zero".to_string());
         }
+        kernels::div_scalar_assign(self.data_mut(), scalar);
+        Ok(())
+    }
 
-        ComplexTensor::new(data, result_shape)
+    /// Negate all elements in place
+    pub fn negate_assign(&mut self) {
+        self.map_in_place(|x| -*x);
     }
 
     /// Scalar addition
     pub fn add_scalar(&self, scalar: Complex) -> ComplexTensor {
-        let data: Vec<Complex> = self.data.iter().map(|x| *x + scalar).collect();
+        let data: Vec<Complex> = self.data().iter().map(|x| *x + scalar).collect();
         ComplexTensor::new(data, self.shape.clone()).unwrap()
     }
 
     /// Scalar subtraction (tensor - scalar)
     pub fn sub_scalar(&self, scalar: Complex) -> ComplexTensor {
-        let data: Vec<Complex> = self.data.iter().map(|x| *x - scalar).collect();
+        let data: Vec<Complex> = self.data().iter().map(|x| *x - scalar).collect();
         ComplexTensor::new(data, self.shape.clone()).unwrap()
     }
 
     /// Scalar multiplication
     pub fn mul_scalar(&self, scalar: Complex) -> ComplexTensor {
-        let data: Vec<Complex> = self.data.iter().map(|x| *x * scalar).collect();
+        let mut data = self.data().to_vec();
+        kernels::scale_assign(&mut data, scalar);
         ComplexTensor::new(data, self.shape.clone()).unwrap()
     }
 
@@ -153,19 +155,42 @@ impl ComplexTensor {
         if scalar.re == 0.0 && scalar.im == 0.0 {
             return Err("Division by zero".to_string());
         }
-        let data: Vec<Complex> = self.data.iter().map(|x| *x / scalar).collect();
+        let mut data = self.data().to_vec();
+        kernels::div_scalar_assign(&mut data, scalar);
         Ok(ComplexTensor::new(data, self.shape.clone()).unwrap())
     }
 
     /// Negate all elements
     pub fn negate(&self) -> ComplexTensor {
-        let data: Vec<Complex> = self.data.iter().map(|x| -*x).collect();
+        let data: Vec<Complex> = self.data().iter().map(|x| -*x).collect();
         ComplexTensor::new(data, self.shape.clone()).unwrap()
     }
 
     /// Convert to RealTensor (magnitude)
     pub fn abs(&self) -> RealTensor {
-        let data: Vec<f64> = self.data.iter().map(|c| c.magnitude()).collect();
+        let mut data = vec![0.0; self.size()];
+        kernels::abs(self.data(), &mut data);
+        RealTensor::new(data, self.shape.clone()).unwrap()
+    }
+
+    /// Squared magnitude `re² + im²` of every element
+    pub fn norm_sqr(&self) -> RealTensor {
+        let mut data = vec![0.0; self.size()];
+        kernels::norm_sqr(self.data(), &mut data);
         RealTensor::new(data, self.shape.clone()).unwrap()
     }
+
+    /// Phase (argument) in radians of every element
+    pub fn phase(&self) -> RealTensor {
+        let mut data = vec![0.0; self.size()];
+        kernels::phase(self.data(), &mut data);
+        RealTensor::new(data, self.shape.clone()).unwrap()
+    }
+
+    /// Complex conjugate of every element
+    pub fn conj(&self) -> ComplexTensor {
+        let mut data = self.data().to_vec();
+        kernels::conj_assign(&mut data);
+        ComplexTensor::new(data, self.shape.clone()).unwrap()
+    }
 }
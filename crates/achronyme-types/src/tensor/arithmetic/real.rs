@@ -1,4 +1,4 @@
-use crate::tensor::core::{RealTensor, Tensor, TensorError};
+use crate::tensor::core::{RealTensor, TensorError};
 
 // ============================================================================
 // Arithmetic Operations for RealTensor
@@ -7,143 +7,117 @@ use crate::tensor::core::{RealTensor, Tensor, TensorError};
 impl RealTensor {
     /// Element-wise addition with broadcasting
     pub fn add(&self, other: &RealTensor) -> Result<RealTensor, TensorError> {
-        // Fast path: if shapes are identical, use direct element-wise operation
-        if self.shape == other.shape {
-            let data: Vec<f64> = self.data.iter()
-                .zip(other.data.iter())
-                .map(|(a, b)| a + b)
-                .collect();
-            return RealTensor::new(data, self.shape.clone());
-        }
-
-        // Broadcasting path
-        let result_shape = Tensor::<f64>::broadcast_shape(&self.shape, &other.shape)?;
-        let result_strides = Tensor::<f64>::compute_strides(&result_shape);
-        let result_size: usize = result_shape.iter().product();
-
-        let mut data = Vec::with_capacity(result_size);
-
-        for flat_idx in 0..result_size {
-            let result_indices = Tensor::<f64>::unravel_index(flat_idx, &result_shape, &result_strides);
-            let self_indices = Tensor::<f64>::broadcast_index(&result_indices, &self.shape, &result_shape);
-            let other_indices = Tensor::<f64>::broadcast_index(&result_indices, &other.shape, &result_shape);
-
-            let a = self.get(&self_indices)?;
-            let b = other.get(&other_indices)?;
-            data.push(a + b);
-        }
-
-        RealTensor::new(data, result_shape)
+        self.broadcast_zip(other, |a, b| a + b)
     }
 
     /// Element-wise subtraction with broadcasting
     pub fn sub(&self, other: &RealTensor) -> Result<RealTensor, TensorError> {
-        // Fast path: if shapes are identical, use direct element-wise operation
-        if self.shape == other.shape {
-            let data: Vec<f64> = self.data.iter()
-                .zip(other.data.iter())
-                .map(|(a, b)| a - b)
-                .collect();
-            return RealTensor::new(data, self.shape.clone());
-        }
+        self.broadcast_zip(other, |a, b| a - b)
+    }
 
-        // Broadcasting path
-        let result_shape = Tensor::<f64>::broadcast_shape(&self.shape, &other.shape)?;
-        let result_strides = Tensor::<f64>::compute_strides(&result_shape);
-        let result_size: usize = result_shape.iter().product();
+    /// Element-wise multiplication (Hadamard product) with broadcasting
+    pub fn mul(&self, other: &RealTensor) -> Result<RealTensor, TensorError> {
+        self.broadcast_zip(other, |a, b| a * b)
+    }
 
-        let mut data = Vec::with_capacity(result_size);
+    /// Element-wise division with broadcasting
+    pub fn div(&self, other: &RealTensor) -> Result<RealTensor, TensorError> {
+        self.broadcast_zip(other, |a, b| a / b)
+    }
 
-        for flat_idx in 0..result_size {
-            let result_indices = Tensor::<f64>::unravel_index(flat_idx, &result_shape, &result_strides);
-            let self_indices = Tensor::<f64>::broadcast_index(&result_indices, &self.shape, &result_shape);
-            let other_indices = Tensor::<f64>::broadcast_index(&result_indices, &other.shape, &result_shape);
+    // ------------------------------------------------------------------------
+    // Ownership-aware variants: reuse an existing buffer instead of allocating
+    // ------------------------------------------------------------------------
 
-            let a = self.get(&self_indices)?;
-            let b = other.get(&other_indices)?;
-            data.push(a - b);
-        }
+    /// In-place element-wise addition; `other` must broadcast to `self`'s shape
+    pub fn add_assign(&mut self, other: &RealTensor) -> Result<(), TensorError> {
+        self.broadcast_zip_assign(other, |a, b| *a = *a + *b)
+    }
 
-        RealTensor::new(data, result_shape)
+    /// In-place element-wise subtraction; `other` must broadcast to `self`'s shape
+    pub fn sub_assign(&mut self, other: &RealTensor) -> Result<(), TensorError> {
+        self.broadcast_zip_assign(other, |a, b| *a = *a - *b)
     }
 
-    /// Element-wise multiplication (Hadamard product) with broadcasting
-    pub fn mul(&self, other: &RealTensor) -> Result<RealTensor, TensorError> {
-        // Fast path: if shapes are identical, use direct element-wise operation
-        if self.shape == other.shape {
-            let data: Vec<f64> = self.data.iter()
-                .zip(other.data.iter())
-                .map(|(a, b)| a * b)
-                .collect();
-            return RealTensor::new(data, self.shape.clone());
-        }
+    /// In-place element-wise multiplication; `other` must broadcast to `self`'s shape
+    pub fn mul_assign(&mut self, other: &RealTensor) -> Result<(), TensorError> {
+        self.broadcast_zip_assign(other, |a, b| *a = *a * *b)
+    }
 
-        // Broadcasting path
-        let result_shape = Tensor::<f64>::broadcast_shape(&self.shape, &other.shape)?;
-        let result_strides = Tensor::<f64>::compute_strides(&result_shape);
-        let result_size: usize = result_shape.iter().product();
+    /// In-place element-wise division; `other` must broadcast to `self`'s shape
+    pub fn div_assign(&mut self, other: &RealTensor) -> Result<(), TensorError> {
+        self.broadcast_zip_assign(other, |a, b| *a = *a / *b)
+    }
 
-        let mut data = Vec::with_capacity(result_size);
+    /// Element-wise addition that reuses an operand's buffer
+    pub fn add_owned(self, other: RealTensor) -> Result<RealTensor, TensorError> {
+        self.broadcast_zip_owned(other, |a, b| a + b)
+    }
 
-        for flat_idx in 0..result_size {
-            let result_indices = Tensor::<f64>::unravel_index(flat_idx, &result_shape, &result_strides);
-            let self_indices = Tensor::<f64>::broadcast_index(&result_indices, &self.shape, &result_shape);
-            let other_indices = Tensor::<f64>::broadcast_index(&result_indices, &other.shape, &result_shape);
+    /// Element-wise subtraction that reuses an operand's buffer
+    pub fn sub_owned(self, other: RealTensor) -> Result<RealTensor, TensorError> {
+        self.broadcast_zip_owned(other, |a, b| a - b)
+    }
 
-            let a = self.get(&self_indices)?;
-            let b = other.get(&other_indices)?;
-            data.push(a * b);
-        }
+    /// Element-wise multiplication that reuses an operand's buffer
+    pub fn mul_owned(self, other: RealTensor) -> Result<RealTensor, TensorError> {
+        self.broadcast_zip_owned(other, |a, b| a * b)
+    }
 
-        RealTensor::new(data, result_shape)
+    /// Element-wise division that reuses an operand's buffer
+    pub fn div_owned(self, other: RealTensor) -> Result<RealTensor, TensorError> {
+        self.broadcast_zip_owned(other, |a, b| a / b)
     }
 
-    /// Element-wise division with broadcasting
-    pub fn div(&self, other: &RealTensor) -> Result<RealTensor, TensorError> {
-        // Fast path: if shapes are identical, use direct element-wise operation
-        if self.shape == other.shape {
-            let data: Vec<f64> = self.data.iter()
-                .zip(other.data.iter())
-                .map(|(a, b)| a / b)
-                .collect();
-            return RealTensor::new(data, self.shape.clone());
-        }
+    /// In-place scalar addition
+    pub fn add_scalar_assign(&mut self, scalar: f64) {
+        self.map_in_place(|x| *x + scalar);
+    }
 
-        // Broadcasting path
-        let result_shape = Tensor::<f64>::broadcast_shape(&self.shape, &other.shape)?;
-        let result_strides = Tensor::<f64>::compute_strides(&result_shape);
-        let result_size: usize = result_shape.iter().product();
+    /// In-place scalar subtraction (tensor - scalar)
+    pub fn sub_scalar_assign(&mut self, scalar: f64) {
+        self.map_in_place(|x| *x - scalar);
+    }
 
-        let mut data = Vec::with_capacity(result_size);
+    /// In-place reversed scalar subtraction (scalar - tensor)
+    pub fn rsub_scalar_assign(&mut self, scalar: f64) {
+        self.map_in_place(|x| scalar - *x);
+    }
 
-        for flat_idx in 0..result_size {
-            let result_indices = Tensor::<f64>::unravel_index(flat_idx, &result_shape, &result_strides);
-            let self_indices = Tensor::<f64>::broadcast_index(&result_indices, &self.shape, &result_shape);
-            let other_indices = Tensor::<f64>::broadcast_index(&result_indices, &other.shape, &result_shape);
+    /// In-place scalar multiplication
+    pub fn mul_scalar_assign(&mut self, scalar: f64) {
+        self.map_in_place(|x| *x * scalar);
+    }
 
-            let a = self.get(&self_indices)?;
-            let b = other.get(&other_indices)?;
-            data.push(a / b);
+    /// In-place scalar division (tensor / scalar)
+    pub fn div_scalar_assign(&mut self, scalar: f64) -> Result<(), String> {
+        if scalar == 0.0 {
+            return Err("Division by zero".to_string());
         }
+        self.map_in_place(|x| *x / scalar);
+        Ok(())
+    }
 
-        RealTensor::new(data, result_shape)
+    /// Negate all elements in place
+    pub fn negate_assign(&mut self) {
+        self.map_in_place(|x| -*x);
     }
 
     /// Scalar addition
     pub fn add_scalar(&self, scalar: f64) -> RealTensor {
-        let data: Vec<f64> = self.data.iter().map(|x| x + scalar).collect();
+        let data: Vec<f64> = self.data().iter().map(|x| x + scalar).collect();
         RealTensor::new(data, self.shape.clone()).unwrap()
     }
 
     /// Scalar subtraction (tensor - scalar)
     pub fn sub_scalar(&self, scalar: f64) -> RealTensor {
-        let data: Vec<f64> = self.data.iter().map(|x| x - scalar).collect();
+        let data: Vec<f64> = self.data().iter().map(|x| x - scalar).collect();
         RealTensor::new(data, self.shape.clone()).unwrap()
     }
 
     /// Scalar multiplication
     pub fn mul_scalar(&self, scalar: f64) -> RealTensor {
-        let data: Vec<f64> = self.data.iter().map(|x| x * scalar).collect();
+        let data: Vec<f64> = self.data().iter().map(|x| x * scalar).collect();
         RealTensor::new(data, self.shape.clone()).unwrap()
     }
 
@@ -152,13 +126,13 @@ impl RealTensor {
         if scalar == 0.0 {
             return Err("Division by zero".to_string());
         }
-        let data: Vec<f64> = self.data.iter().map(|x| x / scalar).collect();
+        let data: Vec<f64> = self.data().iter().map(|x| x / scalar).collect();
         Ok(RealTensor::new(data, self.shape.clone()).unwrap())
     }
 
     /// Negate all elements
     pub fn negate(&self) -> RealTensor {
-        let data: Vec<f64> = self.data.iter().map(|x| -x).collect();
+        let data: Vec<f64> = self.data().iter().map(|x| -x).collect();
         RealTensor::new(data, self.shape.clone()).unwrap()
     }
 }
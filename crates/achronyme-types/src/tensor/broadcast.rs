@@ -58,38 +58,209 @@ impl<T: Clone> Tensor<T> {
                 1
             };
 
-            result.push(dim1.max(dim2));
+            // A size-1 dim takes the other's size (including 0)
+            result.push(if dim1 == 1 { dim2 } else { dim1 });
         }
 
         result.reverse();
         Ok(result)
     }
 
-    /// Convert a flat index to multi-dimensional indices given a shape
-    pub(crate) fn unravel_index(flat_idx: usize, shape: &[usize], strides: &[usize]) -> Vec<usize> {
-        let mut indices = Vec::with_capacity(shape.len());
-        let mut remaining = flat_idx;
+    /// Apply `op` element-wise over two broadcast-compatible tensors
+    ///
+    /// Shared by the `add`/`sub`/`mul`/`div` kernels of every element type.
+    /// Identical shapes, a single-element operand and
+    /// trailing-dimension broadcasts (`matrix + row_vector`) run as flat
+    /// slice loops; everything else walks [`BroadcastOffsets`].
+    pub(crate) fn broadcast_zip<U: Clone>(
+        &self,
+        other: &Tensor<T>,
+        op: impl Fn(&T, &T) -> U,
+    ) -> Result<Tensor<U>, TensorError> {
+        let (lhs, rhs) = (self.data(), other.data());
 
-        for &stride in strides.iter() {
-            indices.push(remaining / stride);
-            remaining %= stride;
+        // Fast path: identical shapes
+        if self.shape == other.shape {
+            let data = lhs.iter().zip(rhs).map(|(a, b)| op(a, b)).collect();
+            return Tensor::new(data, self.shape.clone());
         }
 
-        indices
+        let result_shape = Self::broadcast_shape(&self.shape, &other.shape)?;
+        let result_size: usize = result_shape.iter().product();
+        if result_size == 0 {
+            return Tensor::new(Vec::new(), result_shape);
+        }
+
+        let data = if result_shape == self.shape && rhs.len() == 1 {
+            let b = &rhs[0];
+            lhs.iter().map(|a| op(a, b)).collect()
+        } else if result_shape == other.shape && lhs.len() == 1 {
+            let a = &lhs[0];
+            rhs.iter().map(|b| op(a, b)).collect()
+        } else if result_shape == self.shape && is_trailing_shape(&other.shape, &self.shape) {
+            // `other` repeats once per leading index of `self`
+            let mut data = Vec::with_capacity(result_size);
+            for chunk in lhs.chunks_exact(rhs.len()) {
+                data.extend(chunk.iter().zip(rhs).map(|(a, b)| op(a, b)));
+            }
+            data
+        } else if result_shape == other.shape && is_trailing_shape(&self.shape, &other.shape) {
+            let mut data = Vec::with_capacity(result_size);
+            for chunk in rhs.chunks_exact(lhs.len()) {
+                data.extend(lhs.iter().zip(chunk).map(|(a, b)| op(a, b)));
+            }
+            data
+        } else {
+            BroadcastOffsets::new(&result_shape, &self.shape, &other.shape)
+                .map(|(i, j)| op(&lhs[i], &rhs[j]))
+                .collect()
+        };
+
+        Tensor::new(data, result_shape)
+    }
+
+    /// Apply `op(&mut self_elem, &other_elem)` in place, broadcasting `other`
+    ///
+    /// Fails unless the broadcast result has exactly `self`'s shape.
+    pub(crate) fn broadcast_zip_assign(
+        &mut self,
+        other: &Tensor<T>,
+        op: impl Fn(&mut T, &T),
+    ) -> Result<(), TensorError> {
+        if self.shape != other.shape {
+            let result_shape = Self::broadcast_shape(&self.shape, &other.shape)?;
+            if result_shape != self.shape {
+                return Err(TensorError::BroadcastError {
+                    shape1: self.shape.clone(),
+                    shape2: other.shape.clone(),
+                });
+            }
+        }
+
+        if self.is_empty() {
+            return Ok(());
+        }
+
+        let src = other.data();
+        if self.shape == other.shape {
+            self.data_mut().iter_mut().zip(src).for_each(|(a, b)| op(a, b));
+        } else if src.len() == 1 {
+            let b = &src[0];
+            self.data_mut().iter_mut().for_each(|a| op(a, b));
+        } else if is_trailing_shape(&other.shape, &self.shape) {
+            for chunk in self.data_mut().chunks_exact_mut(src.len()) {
+                chunk.iter_mut().zip(src).for_each(|(a, b)| op(a, b));
+            }
+        } else {
+            let offsets = BroadcastOffsets::new(&self.shape, &self.shape, &other.shape);
+            for (a, (_, j)) in self.data_mut().iter_mut().zip(offsets) {
+                op(a, &src[j]);
+            }
+        }
+        Ok(())
+    }
+
+    /// Like [`broadcast_zip`](Self::broadcast_zip), but consumes both
+    /// operands and writes into whichever buffer already has the result
+    /// shape, allocating only when neither does
+    pub(crate) fn broadcast_zip_owned(
+        mut self,
+        mut other: Tensor<T>,
+        op: impl Fn(&T, &T) -> T,
+    ) -> Result<Tensor<T>, TensorError> {
+        let result_shape = Self::broadcast_shape(&self.shape, &other.shape)?;
+
+        if result_shape == self.shape {
+            self.broadcast_zip_assign(&other, |a, b| *a = op(a, b))?;
+            Ok(self)
+        } else if result_shape == other.shape {
+            other.broadcast_zip_assign(&self, |b, a| *b = op(a, b))?;
+            Ok(other)
+        } else {
+            self.broadcast_zip(&other, op)
+        }
     }
+}
 
-    /// Adjust multi-dimensional indices for broadcasting
-    /// Maps indices from result shape to indices in original shape
-    pub(crate) fn broadcast_index(result_indices: &[usize], original_shape: &[usize], result_shape: &[usize]) -> Vec<usize> {
-        let rank_diff = result_shape.len() - original_shape.len();
-        let mut adjusted = Vec::with_capacity(original_shape.len());
+/// Whether `inner`, ignoring leading 1s, equals the trailing dims of `outer`
+fn is_trailing_shape(inner: &[usize], outer: &[usize]) -> bool {
+    let first = inner.iter().position(|&d| d != 1).unwrap_or(inner.len());
+    let inner = &inner[first..];
+    inner.len() <= outer.len() && outer.ends_with(inner)
+}
 
-        for i in 0..original_shape.len() {
-            let result_idx = result_indices[i + rank_diff];
-            // If the original dimension is 1, always use index 0 (broadcasting)
-            adjusted.push(if original_shape[i] == 1 { 0 } else { result_idx });
+/// Row-major walk over a broadcast result yielding flat offsets into both operands
+///
+/// Each operand gets per-dimension strides in the result's rank, with zero
+/// stride on broadcast (size-1 or missing) dims, so advancing is a counter
+/// increment plus two additions instead of per-element index vectors.
+pub(crate) struct BroadcastOffsets {
+    shape: Vec<usize>,
+    strides: [Vec<usize>; 2],
+    index: Vec<usize>,
+    offsets: [usize; 2],
+    remaining: usize,
+}
+
+impl BroadcastOffsets {
+    pub(crate) fn new(result_shape: &[usize], shape1: &[usize], shape2: &[usize]) -> Self {
+        Self {
+            shape: result_shape.to_vec(),
+            strides: [
+                broadcast_strides(shape1, result_shape.len()),
+                broadcast_strides(shape2, result_shape.len()),
+            ],
+            index: vec![0; result_shape.len()],
+            offsets: [0, 0],
+            remaining: result_shape.iter().product(),
         }
+    }
+}
 
-        adjusted
+/// Row-major strides of `shape` aligned to `rank` dims, zero where broadcast
+fn broadcast_strides(shape: &[usize], rank: usize) -> Vec<usize> {
+    let mut strides = vec![0; rank];
+    let rank_diff = rank - shape.len();
+    let mut stride = 1;
+    for i in (0..shape.len()).rev() {
+        if shape[i] != 1 {
+            strides[i + rank_diff] = stride;
+        }
+        stride *= shape[i];
     }
+    strides
 }
+
+impl Iterator for BroadcastOffsets {
+    type Item = (usize, usize);
+
+    #[inline]
+    fn next(&mut self) -> Option<(usize, usize)> {
+        if self.remaining == 0 {
+            return None;
+        }
+        self.remaining -= 1;
+        let current = (self.offsets[0], self.offsets[1]);
+
+        // Odometer step from the innermost dimension outwards
+        for d in (0..self.shape.len()).rev() {
+            self.index[d] += 1;
+            self.offsets[0] += self.strides[0][d];
+            self.offsets[1] += self.strides[1][d];
+            if self.index[d] < self.shape[d] {
+                break;
+            }
+            self.offsets[0] -= self.strides[0][d] * self.shape[d];
+            self.offsets[1] -= self.strides[1][d] * self.shape[d];
+            self.index[d] = 0;
+        }
+
+        Some(current)
+    }
+
+    fn size_hint(&self) -> (usize, Option<usize>) {
+        (self.remaining, Some(self.remaining))
+    }
+}
+
+impl ExactSizeIterator for BroadcastOffsets {}
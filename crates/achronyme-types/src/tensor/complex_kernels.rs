@@ -0,0 +1,307 @@
+//! Slice kernels for interleaved complex buffers
+//!
+//! `Complex` stays `[re, im]` interleaved so buffers can be handed to
+//! rustfft and back without copying. On x86_64 CPUs with AVX2 the hot
+//! element-wise operations run two complex numbers per 256-bit register,
+//! using the lane shuffles that keep the interleaved layout (`movedup`,
+//! `permute`, `addsub`, `hadd`); everywhere else they are plain loops.
+//!
+//! Each vector path issues exactly the same IEEE operations, in the same
+//! order, as the `Complex` operators (no FMA contraction, no reassociation),
+//! so results are bit-identical whichever path runs.
+
+use crate::complex::Complex;
+
+/// `a[i] = a[i] * b[i]`
+pub fn mul_assign(a: &mut [Complex], b: &[Complex]) {
+    assert_eq!(a.len(), b.len(), "complex kernel operands differ in length");
+    #[cfg(target_arch = "x86_64")]
+    if avx2::available() {
+        // SAFETY: AVX2 support was just detected
+        unsafe { avx2::mul_assign(a, b) };
+        return;
+    }
+    for (x, y) in a.iter_mut().zip(b) {
+        *x = *x * *y;
+    }
+}
+
+/// `a[i] = a[i] * s`
+pub fn scale_assign(a: &mut [Complex], s: Complex) {
+    #[cfg(target_arch = "x86_64")]
+    if avx2::available() {
+        // SAFETY: AVX2 support was just detected
+        unsafe { avx2::scale_assign(a, s) };
+        return;
+    }
+    for x in a.iter_mut() {
+        *x = *x * s;
+    }
+}
+
+/// `a[i] = a[i] / b[i]`
+pub fn div_assign(a: &mut [Complex], b: &[Complex]) {
+    assert_eq!(a.len(), b.len(), "complex kernel operands differ in length");
+    #[cfg(target_arch = "x86_64")]
+    if avx2::available() {
+        // SAFETY: AVX2 support was just detected
+        unsafe { avx2::div_assign(a, b) };
+        return;
+    }
+    for (x, y) in a.iter_mut().zip(b) {
+        *x = *x / *y;
+    }
+}
+
+/// `a[i] = a[i] / s`
+pub fn div_scalar_assign(a: &mut [Complex], s: Complex) {
+    #[cfg(target_arch = "x86_64")]
+    if avx2::available() {
+        // SAFETY: AVX2 support was just detected
+        unsafe { avx2::div_scalar_assign(a, s) };
+        return;
+    }
+    for x in a.iter_mut() {
+        *x = *x / s;
+    }
+}
+
+/// `out[i] = out[i] + s * b[i]`, the inner loop of complex GEMM
+pub fn mul_add(out: &mut [Complex], s: Complex, b: &[Complex]) {
+    assert_eq!(out.len(), b.len(), "complex kernel operands differ in length");
+    #[cfg(target_arch = "x86_64")]
+    if avx2::available() {
+        // SAFETY: AVX2 support was just detected
+        unsafe { avx2::mul_add(out, s, b) };
+        return;
+    }
+    for (c, y) in out.iter_mut().zip(b) {
+        *c = *c + s * *y;
+    }
+}
+
+/// `a[i] = conj(a[i])`
+pub fn conj_assign(a: &mut [Complex]) {
+    #[cfg(target_arch = "x86_64")]
+    if avx2::available() {
+        // SAFETY: AVX2 support was just detected
+        unsafe { avx2::conj_assign(a) };
+        return;
+    }
+    for x in a.iter_mut() {
+        *x = x.conjugate();
+    }
+}
+
+/// `out[i] = |a[i]|`
+pub fn abs(a: &[Complex], out: &mut [f64]) {
+    assert_eq!(a.len(), out.len(), "complex kernel operands differ in length");
+    #[cfg(target_arch = "x86_64")]
+    if avx2::available() {
+        // SAFETY: AVX2 support was just detected
+        unsafe { avx2::abs(a, out) };
+        return;
+    }
+    for (m, x) in out.iter_mut().zip(a) {
+        *m = x.magnitude();
+    }
+}
+
+/// `out[i] = re² + im²` of `a[i]` (power spectra)
+pub fn norm_sqr(a: &[Complex], out: &mut [f64]) {
+    assert_eq!(a.len(), out.len(), "complex kernel operands differ in length");
+    #[cfg(target_arch = "x86_64")]
+    if avx2::available() {
+        // SAFETY: AVX2 support was just detected
+        unsafe { avx2::norm_sqr(a, out) };
+        return;
+    }
+    for (m, x) in out.iter_mut().zip(a) {
+        *m = x.re * x.re + x.im * x.im;
+    }
+}
+
+/// `out[i] = arg(a[i])`
+///
+/// `atan2` has no vector form, so this is always the scalar loop; it is
+/// here so callers pick every complex map from one place.
+pub fn phase(a: &[Complex], out: &mut [f64]) {
+    assert_eq!(a.len(), out.len(), "complex kernel operands differ in length");
+    for (p, x) in out.iter_mut().zip(a) {
+        *p = x.phase();
+    }
+}
+
+#[cfg(target_arch = "x86_64")]
+mod avx2 {
+    //! Two `Complex` per `__m256d`: lanes `[re0, im0, re1, im1]`
+    //!
+    //! Loops run over pairs with unaligned loads and finish an odd tail with
+    //! the scalar operator. `Complex` is `#[repr(C)] { re, im }`, so a
+    //! `*const Complex` is a valid `*const f64` over `2 * len` values.
+
+    use std::arch::x86_64::*;
+
+    use crate::complex::Complex;
+
+    pub(super) fn available() -> bool {
+        // The standard library caches the CPUID result after the first call
+        std::arch::is_x86_feature_detected!("avx2")
+    }
+
+    /// `x * y` for two interleaved pairs, as in `Complex::mul`:
+    /// `re = xr*yr - xi*yi`, `im = xi*yr + xr*yi`
+    #[inline]
+    #[target_feature(enable = "avx2")]
+    unsafe fn cmul(x: __m256d, y_re: __m256d, y_im: __m256d) -> __m256d {
+        let swapped = _mm256_permute_pd(x, 0b0101);
+        _mm256_addsub_pd(_mm256_mul_pd(x, y_re), _mm256_mul_pd(swapped, y_im))
+    }
+
+    /// `x / y` for two interleaved pairs, as in `Complex::div`:
+    /// `re = (xr*yr + xi*yi) / d`, `im = (xi*yr - xr*yi) / d`
+    #[inline]
+    #[target_feature(enable = "avx2")]
+    unsafe fn cdiv(x: __m256d, y: __m256d) -> __m256d {
+        let y_re = _mm256_movedup_pd(y);
+        let y_im = _mm256_permute_pd(y, 0b1111);
+        let swapped = _mm256_permute_pd(x, 0b0101);
+        let t = _mm256_mul_pd(x, y_re);
+        let u = _mm256_mul_pd(swapped, y_im);
+        // addsub subtracts in even lanes and adds in odd ones: flip u's sign
+        let numerator = _mm256_addsub_pd(t, _mm256_xor_pd(u, _mm256_set1_pd(-0.0)));
+        let squares = _mm256_mul_pd(y, y);
+        // [yr0² + yi0², same, yr1² + yi1², same]
+        let denominator = _mm256_hadd_pd(squares, squares);
+        _mm256_div_pd(numerator, denominator)
+    }
+
+    /// `[re² + im²]` of four complex numbers, in order
+    #[inline]
+    #[target_feature(enable = "avx2")]
+    unsafe fn norm_sqr4(p: *const f64) -> __m256d {
+        let x = _mm256_loadu_pd(p);
+        let y = _mm256_loadu_pd(p.add(4));
+        // hadd yields [|z0|², |z2|², |z1|², |z3|²]
+        let h = _mm256_hadd_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y));
+        _mm256_permute4x64_pd(h, 0b11_01_10_00)
+    }
+
+    #[target_feature(enable = "avx2")]
+    pub(super) unsafe fn mul_assign(a: &mut [Complex], b: &[Complex]) {
+        let pairs = a.len() / 2;
+        let pa = a.as_mut_ptr() as *mut f64;
+        let pb = b.as_ptr() as *const f64;
+        for i in 0..pairs {
+            let x = _mm256_loadu_pd(pa.add(4 * i));
+            let y = _mm256_loadu_pd(pb.add(4 * i));
+            let r = cmul(x, _mm256_movedup_pd(y), _mm256_permute_pd(y, 0b1111));
+            _mm256_storeu_pd(pa.add(4 * i), r);
+        }
+        for i in 2 * pairs..a.len() {
+            a[i] = a[i] * b[i];
+        }
+    }
+
+    #[target_feature(enable = "avx2")]
+    pub(super) unsafe fn scale_assign(a: &mut [Complex], s: Complex) {
+        let pairs = a.len() / 2;
+        let pa = a.as_mut_ptr() as *mut f64;
+        let s_re = _mm256_set1_pd(s.re);
+        let s_im = _mm256_set1_pd(s.im);
+        for i in 0..pairs {
+            let x = _mm256_loadu_pd(pa.add(4 * i));
+            _mm256_storeu_pd(pa.add(4 * i), cmul(x, s_re, s_im));
+        }
+        for x in &mut a[2 * pairs..] {
+            *x = *x * s;
+        }
+    }
+
+    #[target_feature(enable = "avx2")]
+    pub(super) unsafe fn div_assign(a: &mut [Complex], b: &[Complex]) {
+        let pairs = a.len() / 2;
+        let pa = a.as_mut_ptr() as *mut f64;
+        let pb = b.as_ptr() as *const f64;
+        for i in 0..pairs {
+            let x = _mm256_loadu_pd(pa.add(4 * i));
+            let y = _mm256_loadu_pd(pb.add(4 * i));
+            _mm256_storeu_pd(pa.add(4 * i), cdiv(x, y));
+        }
+        for i in 2 * pairs..a.len() {
+            a[i] = a[i] / b[i];
+        }
+    }
+
+    #[target_feature(enable = "avx2")]
+    pub(super) unsafe fn div_scalar_assign(a: &mut [Complex], s: Complex) {
+        let pairs = a.len() / 2;
+        let pa = a.as_mut_ptr() as *mut f64;
+        let y = _mm256_setr_pd(s.re, s.im, s.re, s.im);
+        for i in 0..pairs {
+            let x = _mm256_loadu_pd(pa.add(4 * i));
+            _mm256_storeu_pd(pa.add(4 * i), cdiv(x, y));
+        }
+        for x in &mut a[2 * pairs..] {
+            *x = *x / s;
+        }
+    }
+
+    #[target_feature(enable = "avx2")]
+    pub(super) unsafe fn mul_add(out: &mut [Complex], s: Complex, b: &[Complex]) {
+        let pairs = out.len() / 2;
+        let po = out.as_mut_ptr() as *mut f64;
+        let pb = b.as_ptr() as *const f64;
+        let s_re = _mm256_set1_pd(s.re);
+        let s_im = _mm256_set1_pd(s.im);
+        for i in 0..pairs {
+            let c = _mm256_loadu_pd(po.add(4 * i));
+            // b * s has the same products and sums as s * b
+            let product = cmul(_mm256_loadu_pd(pb.add(4 * i)), s_re, s_im);
+            _mm256_storeu_pd(po.add(4 * i), _mm256_add_pd(c, product));
+        }
+        for i in 2 * pairs..out.len() {
+            out[i] = out[i] + s * b[i];
+        }
+    }
+
+    #[target_feature(enable = "avx2")]
+    pub(super) unsafe fn conj_assign(a: &mut [Complex]) {
+        let pairs = a.len() / 2;
+        let pa = a.as_mut_ptr() as *mut f64;
+        let sign = _mm256_setr_pd(0.0, -0.0, 0.0, -0.0);
+        for i in 0..pairs {
+            let x = _mm256_loadu_pd(pa.add(4 * i));
+            _mm256_storeu_pd(pa.add(4 * i), _mm256_xor_pd(x, sign));
+        }
+        for x in &mut a[2 * pairs..] {
+            *x = x.conjugate();
+        }
+    }
+
+    #[target_feature(enable = "avx2")]
+    pub(super) unsafe fn abs(a: &[Complex], out: &mut [f64]) {
+        let quads = a.len() / 4;
+        let pa = a.as_ptr() as *const f64;
+        let po = out.as_mut_ptr();
+        for i in 0..quads {
+            _mm256_storeu_pd(po.add(4 * i), _mm256_sqrt_pd(norm_sqr4(pa.add(8 * i))));
+        }
+        for i in 4 * quads..a.len() {
+            out[i] = a[i].magnitude();
+        }
+    }
+
+    #[target_feature(enable = "avx2")]
+    pub(super) unsafe fn norm_sqr(a: &[Complex], out: &mut [f64]) {
+        let quads = a.len() / 4;
+        let pa = a.as_ptr() as *const f64;
+        let po = out.as_mut_ptr();
+        for i in 0..quads {
+            _mm256_storeu_pd(po.add(4 * i), norm_sqr4(pa.add(8 * i)));
+        }
+        for i in 4 * quads..a.len() {
+            out[i] = a[i].re * a[i].re + a[i].im * a[i].im;
+        }
+    }
+}
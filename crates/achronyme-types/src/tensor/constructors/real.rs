@@ -109,7 +109,7 @@ impl RealTensor {
         }
         let cols = self.shape[1];
         let start = index * cols;
-        Ok(self.data[start..start + cols].to_vec())
+        Ok(self.data()[start..start + cols].to_vec())
     }
 
     /// Get a column from a matrix as a vector
@@ -126,13 +126,7 @@ impl RealTensor {
                 shape: self.shape.clone(),
             });
         }
-        let rows = self.shape[0];
-        let cols = self.shape[1];
-        let mut column = Vec::with_capacity(rows);
-        for row in 0..rows {
-            column.push(self.data[row * cols + index]);
-        }
-        Ok(column)
+        Ok(self.view().column(index)?.iter().copied().collect())
     }
 
     /// Scalar multiplication (convenience method, same as mul_scalar)
@@ -158,10 +152,10 @@ impl RealTensor {
 
         // Base cases
         if n == 1 {
-            return Ok(self.data[0]);
+            return Ok(self.data()[0]);
         }
         if n == 2 {
-            return Ok(self.data[0] * self.data[3] - self.data[1] * self.data[2]);
+            return Ok(self.data()[0] * self.data()[3] - self.data()[1] * self.data()[2]);
         }
 
         // For larger matrices, use LU decomposition or cofactor expansion
@@ -170,7 +164,7 @@ impl RealTensor {
         for j in 0..n {
             let minor = self.minor(0, j)?;
             let sign = if j % 2 == 0 { 1.0 } else { -1.0 };
-            det += sign * self.data[j] * minor.determinant()?;
+            det += sign * self.data()[j] * minor.determinant()?;
         }
         Ok(det)
     }
@@ -185,6 +179,7 @@ impl RealTensor {
         }
 
         let n = self.shape[0];
+        let src = self.data();
         let mut data = Vec::with_capacity((n - 1) * (n - 1));
 
         for i in 0..n {
@@ -195,7 +190,7 @@ impl RealTensor {
                 if j == col {
                     continue;
                 }
-                data.push(self.data[i * n + j]);
+                data.push(src[i * n + j]);
             }
         }
 
@@ -1,9 +1,20 @@
+use std::sync::Arc;
+
 use crate::complex::Complex;
 
+use super::allocations::new_storage;
+
 /// Generic N-dimensional tensor with efficient storage and operations
-#[derive(Debug, Clone, PartialEq)]
+///
+/// Storage is shared: cloning a tensor (and so cloning a `Value`) only bumps
+/// a reference count, and the buffer is copied the first time a shared
+/// tensor is mutated. A tensor owns the row-major window
+/// `storage[offset..offset + size]`, so leading-axis slices and rows of a
+/// larger tensor can share its buffer too.
+#[derive(Clone)]
 pub struct Tensor<T> {
-    pub data: Vec<T>,           // Flat storage in row-major order
+    storage: Arc<Vec<T>>,       // Shared flat storage
+    offset: usize,              // Start of this tensor's window in `storage`
     pub shape: Vec<usize>,      // Dimensions [d0, d1, d2, ...]
     pub strides: Vec<usize>,    // Strides for efficient indexing
 }
@@ -83,13 +94,61 @@ impl<T: Clone> Tensor<T> {
             });
         }
 
-        let strides = Self::compute_strides(&shape);
+        Ok(Self::from_shared(new_storage(data), 0, shape))
+    }
 
-        Ok(Self {
-            data,
+    /// Tensor over `storage[offset..offset + product(shape)]`
+    ///
+    /// The caller guarantees the window lies within `storage`.
+    pub(crate) fn from_shared(storage: Arc<Vec<T>>, offset: usize, shape: Vec<usize>) -> Self {
+        debug_assert!(offset + shape.iter().product::<usize>() <= storage.len());
+        let strides = Self::compute_strides(&shape);
+        Self {
+            storage,
+            offset,
             shape,
             strides,
-        })
+        }
+    }
+
+    /// The shared buffer and this tensor's offset into it
+    pub(crate) fn storage(&self) -> (&Arc<Vec<T>>, usize) {
+        (&self.storage, self.offset)
+    }
+
+    /// Whether both tensors read from the same underlying buffer
+    pub fn shares_storage(&self, other: &Tensor<T>) -> bool {
+        Arc::ptr_eq(&self.storage, &other.storage)
+    }
+
+    /// Mutable access to the elements, copying them first if the buffer is
+    /// shared with another tensor or holds more than this tensor's window
+    pub fn data_mut(&mut self) -> &mut [T] {
+        let len = self.size();
+        if self.offset != 0 || self.storage.len() != len || Arc::get_mut(&mut self.storage).is_none() {
+            self.storage = new_storage(self.data().to_vec());
+            self.offset = 0;
+        }
+        Arc::get_mut(&mut self.storage).expect("storage was just made unique")
+    }
+
+    /// Take the elements as a `Vec`, without copying when the buffer is unshared
+    pub fn into_data(self) -> Vec<T> {
+        if self.offset == 0 && self.storage.len() == self.size() {
+            match Arc::try_unwrap(self.storage) {
+                Ok(data) => data,
+                Err(shared) => shared.to_vec(),
+            }
+        } else {
+            self.data().to_vec()
+        }
+    }
+
+    /// Replace every element with `f(element)` without reallocating
+    pub fn map_in_place(&mut self, f: impl Fn(&T) -> T) {
+        for x in self.data_mut().iter_mut() {
+            *x = f(x);
+        }
     }
 
     /// Compute strides from shape (row-major order)
@@ -109,12 +168,12 @@ impl<T: Clone> Tensor<T> {
 
     /// Get total number of elements
     pub fn size(&self) -> usize {
-        self.data.len()
+        self.shape.iter().product()
     }
 
     /// Check if tensor is empty
     pub fn is_empty(&self) -> bool {
-        self.data.is_empty()
+        self.size() == 0
     }
 
     /// Check if tensor is a scalar (rank 0)
@@ -162,17 +221,19 @@ impl<T: Clone> Tensor<T> {
     /// Get element at given index
     pub fn get(&self, index: &[usize]) -> Result<&T, TensorError> {
         let flat_idx = self.ravel_index(index)?;
-        Ok(&self.data[flat_idx])
+        Ok(&self.data()[flat_idx])
     }
 
     /// Set element at given index
     pub fn set(&mut self, index: &[usize], value: T) -> Result<(), TensorError> {
         let flat_idx = self.ravel_index(index)?;
-        self.data[flat_idx] = value;
+        self.data_mut()[flat_idx] = value;
         Ok(())
     }
 
     /// Reshape tensor to new shape (must preserve total size)
+    ///
+    /// The result shares this tensor's storage.
     pub fn reshape(&self, new_shape: Vec<usize>) -> Result<Self, TensorError> {
         let old_size: usize = self.shape.iter().product();
         let new_size: usize = new_shape.iter().product();
@@ -184,12 +245,12 @@ impl<T: Clone> Tensor<T> {
             });
         }
 
-        Self::new(self.data.clone(), new_shape)
+        Ok(Self::from_shared(self.storage.clone(), self.offset, new_shape))
     }
 
     /// Get a reference to the underlying data
     pub fn data(&self) -> &[T] {
-        &self.data
+        &self.storage[self.offset..self.offset + self.size()]
     }
 
     /// Get shape
@@ -202,3 +263,19 @@ impl<T: Clone> Tensor<T> {
         &self.strides
     }
 }
+
+impl<T: PartialEq + Clone> PartialEq for Tensor<T> {
+    fn eq(&self, other: &Self) -> bool {
+        self.shape == other.shape && self.data() == other.data()
+    }
+}
+
+impl<T: std::fmt::Debug + Clone> std::fmt::Debug for Tensor<T> {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("Tensor")
+            .field("data", &self.data())
+            .field("shape", &self.shape)
+            .field("strides", &self.strides)
+            .finish()
+    }
+}
@@ -8,12 +8,12 @@ impl fmt::Display for RealTensor {
         match self.rank() {
             0 => {
                 // Scalar
-                write!(f, "{}", self.data[0])
+                write!(f, "{}", self.data()[0])
             }
             1 => {
                 // Vector
                 write!(f, "[")?;
-                for (i, val) in self.data.iter().enumerate() {
+                for (i, val) in self.data().iter().enumerate() {
                     if i > 0 {
                         write!(f, ", ")?;
                     }
@@ -35,7 +35,7 @@ impl fmt::Display for RealTensor {
                         if j > 0 {
                             write!(f, ", ")?;
                         }
-                        write!(f, "{}", self.data[i * cols + j])?;
+                        write!(f, "{}", self.data()[i * cols + j])?;
                     }
                     write!(f, "]")?;
                 }
@@ -43,7 +43,7 @@ impl fmt::Display for RealTensor {
             }
             _ => {
                 // Higher-order tensor (3D+)
-                format_nd_tensor(f, &self.data, &self.shape, 0, 0)
+                format_nd_tensor(f, self.data(), &self.shape, 0, 0)
             }
         }
     }
@@ -98,12 +98,12 @@ impl fmt::Display for ComplexTensor {
         match self.rank() {
             0 => {
                 // Scalar
-                write!(f, "{}", self.data[0])
+                write!(f, "{}", self.data()[0])
             }
             1 => {
                 // Vector
                 write!(f, "[")?;
-                for (i, val) in self.data.iter().enumerate() {
+                for (i, val) in self.data().iter().enumerate() {
                     if i > 0 {
                         write!(f, ", ")?;
                     }
@@ -125,7 +125,7 @@ impl fmt::Display for ComplexTensor {
                         if j > 0 {
                             write!(f, ", ")?;
                         }
-                        write!(f, "{}", self.data[i * cols + j])?;
+                        write!(f, "{}", self.data()[i * cols + j])?;
                     }
                     write!(f, "]")?;
                 }
@@ -133,7 +133,7 @@ impl fmt::Display for ComplexTensor {
             }
             _ => {
                 // Higher-order tensor (3D+)
-                format_nd_complex_tensor(f, &self.data, &self.shape, 0, 0)
+                format_nd_complex_tensor(f, self.data(), &self.shape, 0, 0)
             }
         }
     }
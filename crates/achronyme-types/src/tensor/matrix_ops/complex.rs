@@ -1,5 +1,6 @@
 use crate::complex::Complex;
 use crate::tensor::core::{ComplexTensor, TensorError};
+use super::gemm;
 
 impl ComplexTensor {
     /// Transpose a complex matrix
@@ -11,17 +12,7 @@ impl ComplexTensor {
             });
         }
 
-        let rows = self.shape[0];
-        let cols = self.shape[1];
-        let mut data = vec![Complex::new(0.0, 0.0); rows * cols];
-
-        for i in 0..rows {
-            for j in 0..cols {
-                data[j * rows + i] = self.data[i * cols + j];
-            }
-        }
-
-        ComplexTensor::new(data, vec![cols, rows])
+        Ok(self.view().transpose().to_tensor())
     }
 
     /// Hermitian transpose (conjugate transpose)
@@ -33,17 +24,9 @@ impl ComplexTensor {
             });
         }
 
-        let rows = self.shape[0];
-        let cols = self.shape[1];
-        let mut data = vec![Complex::new(0.0, 0.0); rows * cols];
-
-        for i in 0..rows {
-            for j in 0..cols {
-                data[j * rows + i] = self.data[i * cols + j].conjugate();
-            }
-        }
-
-        ComplexTensor::new(data, vec![cols, rows])
+        let transposed = self.view().transpose();
+        let data = transposed.iter().map(|c| c.conjugate()).collect();
+        ComplexTensor::new(data, transposed.shape().to_vec())
     }
 
     /// Matrix trace
@@ -61,9 +44,35 @@ impl ComplexTensor {
 
         let mut sum = Complex::new(0.0, 0.0);
         for i in 0..min_dim {
-            sum = sum + self.data[i * cols + i];
+            sum = sum + self.data()[i * cols + i];
         }
 
         Ok(sum)
     }
+
+    /// Complex matrix multiplication
+    ///
+    /// Uses the same cache-blocked kernel as `RealTensor::matmul`.
+    pub fn matmul(&self, other: &ComplexTensor) -> Result<ComplexTensor, TensorError> {
+        if !self.is_matrix() || !other.is_matrix() {
+            return Err(TensorError::DimensionMismatch {
+                expected: vec![0, 0],
+                got: self.shape.clone(),
+            });
+        }
+
+        let m = self.shape[0];
+        let n = self.shape[1];
+        let p = other.shape[1];
+
+        if n != other.shape[0] {
+            return Err(TensorError::DimensionMismatch {
+                expected: vec![n, 0],
+                got: other.shape.clone(),
+            });
+        }
+
+        let data = gemm::matmul(self.data(), other.data(), m, n, p);
+        ComplexTensor::new(data, vec![m, p])
+    }
 }
@@ -0,0 +1,100 @@
+use crate::complex::Complex;
+use crate::tensor::complex_kernels;
+
+// ============================================================================
+// Blocked GEMM kernel shared by RealTensor and ComplexTensor
+// ============================================================================
+
+/// Rows of the output computed per block (rows of A kept hot)
+const ROW_BLOCK: usize = 64;
+/// Depth of each k-panel (rows of B kept hot)
+const DEPTH_BLOCK: usize = 256;
+/// Width of each j-panel (columns of B and C kept hot)
+const COL_BLOCK: usize = 512;
+
+/// Below this many multiply-adds the product runs on the calling thread
+const PARALLEL_MIN_WORK: usize = 1 << 21;
+
+/// Element types with a row update kernel for [`matmul`]
+pub(crate) trait GemmElement: Copy + Send + Sync {
+    const ZERO: Self;
+
+    /// out[j] += a · b[j]
+    fn mul_add_row(out: &mut [Self], a: Self, b: &[Self]);
+}
+
+impl GemmElement for f64 {
+    const ZERO: Self = 0.0;
+
+    #[inline]
+    fn mul_add_row(out: &mut [f64], a: f64, b: &[f64]) {
+        for (c, &bkj) in out.iter_mut().zip(b) {
+            *c += a * bkj;
+        }
+    }
+}
+
+impl GemmElement for Complex {
+    const ZERO: Self = Complex { re: 0.0, im: 0.0 };
+
+    #[inline]
+    fn mul_add_row(out: &mut [Complex], a: Complex, b: &[Complex]) {
+        complex_kernels::mul_add(out, a, b);
+    }
+}
+
+/// out[m×p] = a[m×n] · b[n×p], all row-major and contiguous
+///
+/// The inner loop walks a row of B and a row of C with unit stride, so it
+/// vectorizes (complex rows go through the interleaved SIMD kernel); k and j are tiled so the active panel of B stays in cache.
+/// Large products are split into row panels across threads.
+pub(crate) fn matmul<T: GemmElement>(a: &[T], b: &[T], m: usize, n: usize, p: usize) -> Vec<T> {
+    let mut out = vec![T::ZERO; m * p];
+    if m == 0 || p == 0 || n == 0 {
+        return out;
+    }
+
+    let threads = if m * n * p >= PARALLEL_MIN_WORK {
+        std::thread::available_parallelism().map_or(1, |t| t.get()).min(m)
+    } else {
+        1
+    };
+
+    if threads <= 1 {
+        matmul_rows(a, b, &mut out, n, p);
+        return out;
+    }
+
+    let rows_per_thread = m.div_ceil(threads);
+    std::thread::scope(|scope| {
+        for (panel, out_panel) in out.chunks_mut(rows_per_thread * p).enumerate() {
+            let rows = out_panel.len() / p;
+            let start = panel * rows_per_thread * n;
+            let a_panel = &a[start..start + rows * n];
+            scope.spawn(move || matmul_rows(a_panel, b, out_panel, n, p));
+        }
+    });
+    out
+}
+
+/// Accumulate a row panel: out[rows×p] += a[rows×n] · b[n×p]
+fn matmul_rows<T: GemmElement>(a: &[T], b: &[T], out: &mut [T], n: usize, p: usize) {
+    let rows = out.len() / p;
+
+    for j0 in (0..p).step_by(COL_BLOCK) {
+        let j1 = (j0 + COL_BLOCK).min(p);
+        for k0 in (0..n).step_by(DEPTH_BLOCK) {
+            let k1 = (k0 + DEPTH_BLOCK).min(n);
+            for i0 in (0..rows).step_by(ROW_BLOCK) {
+                let i1 = (i0 + ROW_BLOCK).min(rows);
+                for i in i0..i1 {
+                    let a_row = &a[i * n..(i + 1) * n];
+                    let out_row = &mut out[i * p + j0..i * p + j1];
+                    for k in k0..k1 {
+                        T::mul_add_row(out_row, a_row[k], &b[k * p + j0..k * p + j1]);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -1,3 +1,4 @@
+mod gemm;
 mod real;
 mod complex;
 
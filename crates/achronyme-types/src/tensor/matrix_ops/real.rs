@@ -1,4 +1,5 @@
 use crate::tensor::core::{RealTensor, TensorError};
+use super::gemm;
 
 // ============================================================================
 // Matrix Operations (rank 2 tensors)
@@ -14,17 +15,7 @@ impl RealTensor {
             });
         }
 
-        let rows = self.shape[0];
-        let cols = self.shape[1];
-        let mut data = vec![0.0; rows * cols];
-
-        for i in 0..rows {
-            for j in 0..cols {
-                data[j * rows + i] = self.data[i * cols + j];
-            }
-        }
-
-        RealTensor::new(data, vec![cols, rows])
+        Ok(self.view().transpose().to_tensor())
     }
 
     /// Matrix trace (sum of diagonal elements)
@@ -42,13 +33,16 @@ impl RealTensor {
 
         let mut sum = 0.0;
         for i in 0..min_dim {
-            sum += self.data[i * cols + i];
+            sum += self.data()[i * cols + i];
         }
 
         Ok(sum)
     }
 
     /// Matrix multiplication
+    ///
+    /// Uses a cache-blocked kernel that is split across threads for large
+    /// products.
     pub fn matmul(&self, other: &RealTensor) -> Result<RealTensor, TensorError> {
         if !self.is_matrix() || !other.is_matrix() {
             return Err(TensorError::DimensionMismatch {
@@ -68,18 +62,7 @@ impl RealTensor {
             });
         }
 
-        let mut data = vec![0.0; m * p];
-
-        for i in 0..m {
-            for j in 0..p {
-                let mut sum = 0.0;
-                for k in 0..n {
-                    sum += self.data[i * n + k] * other.data[k * p + j];
-                }
-                data[i * p + j] = sum;
-            }
-        }
-
+        let data = gemm::matmul(self.data(), other.data(), m, n, p);
         RealTensor::new(data, vec![m, p])
     }
 }
@@ -1,15 +1,20 @@
 mod core;
+mod view;
 mod broadcast;
 mod display;
 mod conversions;
 
+pub mod allocations;
+
 pub mod constructors;
 pub mod arithmetic;
 pub mod vector_ops;
 pub mod matrix_ops;
+pub mod complex_kernels;
 
 #[cfg(test)]
 mod tests;
 
 // Re-export main types
 pub use core::{Tensor, TensorError, RealTensor, ComplexTensor};
+pub use view::{TensorView, ViewIter};
@@ -55,10 +55,10 @@ fn test_reshape() {
 fn test_zeros_ones() {
     let z = RealTensor::zeros(vec![2, 3]);
     assert_eq!(z.size(), 6);
-    assert!(z.data.iter().all(|&x| x == 0.0));
+    assert!(z.data().iter().all(|&x| x == 0.0));
 
     let o = RealTensor::ones(vec![2, 3]);
-    assert!(o.data.iter().all(|&x| x == 1.0));
+    assert!(o.data().iter().all(|&x| x == 1.0));
 }
 
 #[test]
@@ -81,6 +81,78 @@ fn test_complex_tensor() {
     assert_eq!(ct.size(), 2);
 }
 
+// ========================================================================
+// Shared Storage and View Tests
+// ========================================================================
+
+#[test]
+fn test_clone_shares_storage_until_mutation() {
+    let a = RealTensor::matrix(2, 2, vec![1.0, 2.0, 3.0, 4.0]).unwrap();
+    let mut b = a.clone();
+    assert!(b.shares_storage(&a));
+
+    b.set(&[0, 0], 10.0).unwrap();
+    assert!(!b.shares_storage(&a));
+    assert_eq!(a.data(), &[1.0, 2.0, 3.0, 4.0]);
+    assert_eq!(b.data(), &[10.0, 2.0, 3.0, 4.0]);
+
+    // A unique buffer is mutated in place and handed out without a copy
+    let ptr = b.data().as_ptr();
+    b.mul_scalar_assign(2.0);
+    assert_eq!(b.data().as_ptr(), ptr);
+    assert_eq!(b.into_data().as_ptr(), ptr);
+}
+
+#[test]
+fn test_leading_axis_slices_share_storage() {
+    let t = RealTensor::new((0..12).map(|x| x as f64).collect(), vec![3, 2, 2]).unwrap();
+
+    let rows = t.narrow(1, 3).unwrap();
+    assert!(rows.shares_storage(&t));
+    assert_eq!(rows.shape(), &[2, 2, 2]);
+    assert_eq!(rows.data(), &[4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0]);
+
+    let mut plane = t.subtensor(2).unwrap();
+    assert!(plane.shares_storage(&t));
+    assert_eq!(plane, RealTensor::matrix(2, 2, vec![8.0, 9.0, 10.0, 11.0]).unwrap());
+
+    let reshaped = plane.reshape(vec![4]).unwrap();
+    assert!(reshaped.shares_storage(&t));
+
+    // Writing through a window copies only the window
+    plane.set(&[0, 0], -1.0).unwrap();
+    assert_eq!(plane.data(), &[-1.0, 9.0, 10.0, 11.0]);
+    assert_eq!(t.get(&[2, 0, 0]).unwrap(), &8.0);
+
+    assert!(t.narrow(2, 4).is_err());
+}
+
+#[test]
+fn test_strided_views() {
+    let m = RealTensor::matrix(2, 3, vec![1.0, 2.0, 3.0, 4.0, 5.0, 6.0]).unwrap();
+    let view = m.view();
+    assert!(view.is_contiguous());
+
+    let t = view.transpose();
+    assert_eq!(t.shape(), &[3, 2]);
+    assert!(!t.is_contiguous());
+    assert_eq!(t.get(&[2, 1]).unwrap(), &6.0);
+    assert_eq!(t.iter().copied().collect::<Vec<_>>(), vec![1.0, 4.0, 2.0, 5.0, 3.0, 6.0]);
+    assert_eq!(t.to_tensor(), m.transpose().unwrap());
+
+    let col = view.column(1).unwrap();
+    assert_eq!(col.iter().copied().collect::<Vec<_>>(), vec![2.0, 5.0]);
+
+    let row = view.row(1).unwrap();
+    assert!(row.is_contiguous());
+    assert!(row.to_tensor().shares_storage(&m));
+
+    let inner = view.slice_axis(1, 1, 3).unwrap();
+    assert_eq!(inner.iter().copied().collect::<Vec<_>>(), vec![2.0, 3.0, 5.0, 6.0]);
+    assert!(view.slice_axis(1, 2, 4).is_err());
+    assert!(view.index_axis(2, 0).is_err());
+}
+
 // ========================================================================
 // Broadcasting Tests
 // ========================================================================
@@ -110,6 +182,35 @@ fn test_broadcast_shape() {
     );
 }
 
+#[test]
+fn test_broadcast_offsets_strides() {
+    use super::broadcast::BroadcastOffsets;
+
+    // [2, 3] against a column [2, 1]: the column repeats along dim 1
+    let offsets: Vec<(usize, usize)> = BroadcastOffsets::new(&[2, 3], &[2, 3], &[2, 1]).collect();
+    assert_eq!(offsets, vec![(0, 0), (1, 0), (2, 0), (3, 1), (4, 1), (5, 1)]);
+
+    // Missing leading dims broadcast with zero stride
+    let offsets: Vec<(usize, usize)> = BroadcastOffsets::new(&[2, 2], &[2], &[2, 1]).collect();
+    assert_eq!(offsets, vec![(0, 0), (1, 0), (0, 1), (1, 1)]);
+}
+
+#[test]
+fn test_broadcast_fast_paths_preserve_operand_order() {
+    let m = RealTensor::matrix(2, 2, vec![10.0, 20.0, 30.0, 40.0]).unwrap();
+    let row = RealTensor::new(vec![1.0, 2.0], vec![1, 2]).unwrap();
+    let single = RealTensor::new(vec![5.0], vec![1, 1]).unwrap();
+
+    assert_eq!(m.sub(&row).unwrap().data(), &[9.0, 18.0, 29.0, 38.0]);
+    assert_eq!(row.sub(&m).unwrap().data(), &[-9.0, -18.0, -29.0, -38.0]);
+    assert_eq!(m.div(&single).unwrap().data(), &[2.0, 4.0, 6.0, 8.0]);
+    assert_eq!(single.sub(&m).unwrap().data(), &[-5.0, -15.0, -25.0, -35.0]);
+
+    // Empty results keep their broadcast shape
+    let empty = RealTensor::new(vec![], vec![0, 2]).unwrap();
+    assert_eq!(empty.add(&row).unwrap().shape(), &[0, 2]);
+}
+
 // ========================================================================
 // Arithmetic Tests
 // ========================================================================
@@ -176,8 +277,46 @@ fn test_complex_arithmetic() {
     ]);
 
     let c = a.add(&b).unwrap();
-    assert_eq!(c.data[0], Complex::new(6.0, 8.0));
-    assert_eq!(c.data[1], Complex::new(10.0, 12.0));
+    assert_eq!(c.data()[0], Complex::new(6.0, 8.0));
+    assert_eq!(c.data()[1], Complex::new(10.0, 12.0));
+}
+
+#[test]
+fn test_in_place_arithmetic() {
+    let mut t = RealTensor::matrix(2, 2, vec![1.0, 2.0, 3.0, 4.0]).unwrap();
+    let row = RealTensor::vector(vec![10.0, 20.0]);
+
+    t.add_assign(&row).unwrap();
+    assert_eq!(t.data(), &[11.0, 22.0, 13.0, 24.0]);
+
+    t.mul_scalar_assign(2.0);
+    t.rsub_scalar_assign(1.0);
+    assert_eq!(t.data(), &[-21.0, -43.0, -25.0, -47.0]);
+
+    assert!(t.div_scalar_assign(0.0).is_err());
+
+    // The in-place target must already have the broadcast shape
+    let mut small = row.clone();
+    assert!(small.add_assign(&t).is_err());
+}
+
+#[test]
+fn test_owned_arithmetic_reuses_either_operand() {
+    let m = RealTensor::matrix(2, 2, vec![10.0, 20.0, 30.0, 40.0]).unwrap();
+    let row = RealTensor::vector(vec![1.0, 2.0]);
+
+    // Result shape matches the right operand: its buffer is reused
+    let r = row.clone().sub_owned(m.clone()).unwrap();
+    assert_eq!(r.data(), &[-9.0, -18.0, -29.0, -38.0]);
+
+    let r = m.clone().div_owned(row.clone()).unwrap();
+    assert_eq!(r.data(), &[10.0, 10.0, 30.0, 20.0]);
+
+    // Neither operand has the result shape: falls back to a fresh buffer
+    let col = RealTensor::matrix(2, 1, vec![1.0, 2.0]).unwrap();
+    let r = col.mul_owned(row).unwrap();
+    assert_eq!(r.shape(), &[2, 2]);
+    assert_eq!(r.data(), &[1.0, 2.0, 2.0, 4.0]);
 }
 
 // ========================================================================
@@ -314,6 +453,52 @@ fn test_matrix_multiplication() {
     assert_eq!(*c.get(&[1, 1]).unwrap(), 154.0);
 }
 
+/// Reference i-j-k product for checking the blocked kernel
+fn naive_matmul(a: &[f64], b: &[f64], m: usize, n: usize, p: usize) -> Vec<f64> {
+    let mut data = vec![0.0; m * p];
+    for i in 0..m {
+        for j in 0..p {
+            data[i * p + j] = (0..n).map(|k| a[i * n + k] * b[k * p + j]).sum();
+        }
+    }
+    data
+}
+
+#[test]
+fn test_matmul_blocked_matches_naive() {
+    // Odd sizes straddle block edges; the last one takes the threaded path
+    for &(m, n, p) in &[(1, 1, 1), (3, 300, 5), (70, 33, 530), (140, 130, 150)] {
+        let a: Vec<f64> = (0..m * n).map(|i| ((i * 7) % 13) as f64 - 6.0).collect();
+        let b: Vec<f64> = (0..n * p).map(|i| ((i * 5) % 11) as f64 - 5.0).collect();
+
+        let c = RealTensor::matrix(m, n, a.clone()).unwrap()
+            .matmul(&RealTensor::matrix(n, p, b.clone()).unwrap())
+            .unwrap();
+
+        assert_eq!(c.shape(), &[m, p]);
+        assert_eq!(c.data(), naive_matmul(&a, &b, m, n, p).as_slice());
+    }
+}
+
+#[test]
+fn test_complex_matmul() {
+    let a = ComplexTensor::new(vec![
+        Complex::new(1.0, 1.0), Complex::new(0.0, 2.0),
+        Complex::new(3.0, 0.0), Complex::new(1.0, -1.0),
+    ], vec![2, 2]).unwrap();
+    let b = ComplexTensor::new(vec![
+        Complex::new(2.0, 0.0),
+        Complex::new(0.0, 1.0),
+    ], vec![2, 1]).unwrap();
+
+    let c = a.matmul(&b).unwrap();
+    assert_eq!(c.shape(), &[2, 1]);
+    // (1+i)*2 + 2i*i = 2+2i-2 = 2i ; 3*2 + (1-i)*i = 6+i+1 = 7+i
+    assert_eq!(c.data(), &[Complex::new(0.0, 2.0), Complex::new(7.0, 1.0)]);
+
+    assert!(a.matmul(&ComplexTensor::zeros(vec![3, 3])).is_err());
+}
+
 #[test]
 fn test_complex_hermitian() {
     let m = ComplexTensor::zeros(vec![2, 2]);
@@ -338,8 +523,8 @@ fn test_real_to_complex() {
     let c = r.to_complex();
 
     assert_eq!(c.size(), 3);
-    assert_eq!(c.data[0], Complex::new(1.0, 0.0));
-    assert_eq!(c.data[1], Complex::new(2.0, 0.0));
+    assert_eq!(c.data()[0], Complex::new(1.0, 0.0));
+    assert_eq!(c.data()[1], Complex::new(2.0, 0.0));
 }
 
 #[test]
@@ -531,3 +716,97 @@ fn test_broadcast_higher_rank() {
     assert_eq!(*result.get(&[0, 0, 3]).unwrap(), 5.0);  // 1 + 4
     assert_eq!(*result.get(&[0, 0, 4]).unwrap(), 6.0);  // 1 + 5
 }
+
+#[test]
+fn test_allocation_counting() {
+    // Counting is per thread and off by default
+    let before = allocations::allocation_count();
+    let t = RealTensor::vector(vec![1.0, 2.0, 3.0]);
+    assert_eq!(allocations::allocation_count(), before);
+
+    allocations::set_allocation_tracking(true);
+    let shared = t.clone();
+    let mut copy = t.clone();
+    copy.data_mut()[0] = 9.0;            // copy-on-write: one buffer
+    let _sum = t.add(&shared).unwrap();  // result: one buffer
+    allocations::set_allocation_tracking(false);
+
+    assert_eq!(allocations::allocation_count(), before + 2);
+}
+
+fn complex_samples(n: usize, seed: f64) -> Vec<Complex> {
+    (0..n)
+        .map(|i| {
+            let t = i as f64 + seed;
+            Complex::new((t * 1.3).sin() * 7.0, (t * 0.7).cos() - 0.25)
+        })
+        .collect()
+}
+
+#[test]
+fn test_complex_kernels_match_scalar_ops() {
+    // Odd and even lengths exercise both the vector body and the tail
+    for n in [0, 1, 2, 3, 4, 5, 7, 8, 33] {
+        let a = complex_samples(n, 0.5);
+        let b = complex_samples(n, 3.25);
+        let s = Complex::new(-1.5, 0.75);
+
+        let mut out = a.clone();
+        complex_kernels::mul_assign(&mut out, &b);
+        assert!(out.iter().zip(a.iter().zip(&b)).all(|(r, (x, y))| *r == *x * *y));
+
+        let mut out = a.clone();
+        complex_kernels::div_assign(&mut out, &b);
+        assert!(out.iter().zip(a.iter().zip(&b)).all(|(r, (x, y))| *r == *x / *y));
+
+        let mut out = a.clone();
+        complex_kernels::scale_assign(&mut out, s);
+        assert!(out.iter().zip(&a).all(|(r, x)| *r == *x * s));
+
+        let mut out = a.clone();
+        complex_kernels::div_scalar_assign(&mut out, s);
+        assert!(out.iter().zip(&a).all(|(r, x)| *r == *x / s));
+
+        let mut out = a.clone();
+        complex_kernels::mul_add(&mut out, s, &b);
+        assert!(out.iter().zip(a.iter().zip(&b)).all(|(r, (x, y))| *r == *x + s * *y));
+
+        let mut out = a.clone();
+        complex_kernels::conj_assign(&mut out);
+        assert!(out.iter().zip(&a).all(|(r, x)| *r == x.conjugate()));
+
+        let mut magnitudes = vec![0.0; n];
+        complex_kernels::abs(&a, &mut magnitudes);
+        assert!(magnitudes.iter().zip(&a).all(|(m, x)| *m == x.magnitude()));
+
+        let mut power = vec![0.0; n];
+        complex_kernels::norm_sqr(&a, &mut power);
+        assert!(power.iter().zip(&a).all(|(p, x)| *p == x.re * x.re + x.im * x.im));
+    }
+}
+
+#[test]
+fn test_complex_tensor_elementwise_maps() {
+    let data = complex_samples(6, 1.0);
+    let t = ComplexTensor::new(data.clone(), vec![2, 3]).unwrap();
+
+    let product = t.mul(&t.conj()).unwrap();
+    assert_eq!(product.shape(), &[2, 3]);
+    assert!(product.data().iter().zip(&data).all(|(p, x)| *p == *x * x.conjugate()));
+    assert_eq!(t.norm_sqr().data()[4], data[4].re * data[4].re + data[4].im * data[4].im);
+    assert_eq!(t.phase().data()[2], data[2].phase());
+
+    // Division by zero follows IEEE like the scalar operator
+    let zeros = ComplexTensor::new(vec![Complex::new(0.0, 0.0); 6], vec![2, 3]).unwrap();
+    assert!(t.div(&zeros).unwrap().data().iter().all(|c| !c.re.is_finite()));
+
+    // Complex matmul goes through the row kernel
+    let a = ComplexTensor::new(complex_samples(6, 2.0), vec![2, 3]).unwrap();
+    let b = ComplexTensor::new(complex_samples(9, 4.0), vec![3, 3]).unwrap();
+    let c = a.matmul(&b).unwrap();
+    let mut expected = Complex::new(0.0, 0.0);
+    for k in 0..3 {
+        expected = expected + a.data()[3 + k] * b.data()[3 * k + 2];
+    }
+    assert_eq!(c.data()[5], expected);
+}
@@ -21,7 +21,7 @@ impl RealTensor {
             });
         }
 
-        Ok(self.data.iter().zip(other.data.iter()).map(|(a, b)| a * b).sum())
+        Ok(self.data().iter().zip(other.data().iter()).map(|(a, b)| a * b).sum())
     }
 
     /// Cross product of two 3D vectors
@@ -40,8 +40,8 @@ impl RealTensor {
             });
         }
 
-        let a = &self.data;
-        let b = &other.data;
+        let a = self.data();
+        let b = other.data();
 
         let data = vec![
             a[1] * b[2] - a[2] * b[1],
@@ -54,12 +54,12 @@ impl RealTensor {
 
     /// Euclidean norm (L2 norm)
     pub fn norm(&self) -> f64 {
-        self.data.iter().map(|x| x * x).sum::<f64>().sqrt()
+        self.data().iter().map(|x| x * x).sum::<f64>().sqrt()
     }
 
     /// L1 norm (Manhattan distance)
     pub fn norm_l1(&self) -> f64 {
-        self.data.iter().map(|x| x.abs()).sum()
+        self.data().iter().map(|x| x.abs()).sum()
     }
 
     /// Normalize vector to unit length
@@ -73,7 +73,7 @@ impl RealTensor {
 
     /// Sum of all elements
     pub fn sum(&self) -> f64 {
-        self.data.iter().sum()
+        self.data().iter().sum()
     }
 
     /// Mean of all elements
@@ -86,7 +86,7 @@ impl RealTensor {
 
     /// Maximum element
     pub fn max(&self) -> Result<f64, TensorError> {
-        self.data.iter()
+        self.data().iter()
             .copied()
             .max_by(|a, b| a.partial_cmp(b).unwrap())
             .ok_or(TensorError::EmptyTensor)
@@ -94,7 +94,7 @@ impl RealTensor {
 
     /// Minimum element
     pub fn min(&self) -> Result<f64, TensorError> {
-        self.data.iter()
+        self.data().iter()
             .copied()
             .min_by(|a, b| a.partial_cmp(b).unwrap())
             .ok_or(TensorError::EmptyTensor)
@@ -106,7 +106,7 @@ impl RealTensor {
             return Err(TensorError::EmptyTensor);
         }
         let mean = self.mean()?;
-        let sum_squared_diff: f64 = self.data.iter()
+        let sum_squared_diff: f64 = self.data().iter()
             .map(|x| (x - mean).powi(2))
             .sum();
         Ok(sum_squared_diff / (self.size() - 1) as f64)
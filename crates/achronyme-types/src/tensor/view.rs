@@ -0,0 +1,216 @@
+//! Strided views over shared tensor storage
+
+use std::sync::Arc;
+
+use super::allocations::new_storage;
+use super::core::{Tensor, TensorError};
+
+/// Read-only strided window onto a tensor's storage
+///
+/// Creating a view, slicing it, transposing it or selecting a row or column
+/// is O(1): only the offset, shape and strides change. [`to_tensor`]
+/// shares the storage when the view is contiguous and gathers the elements
+/// otherwise.
+///
+/// [`to_tensor`]: TensorView::to_tensor
+#[derive(Debug, Clone)]
+pub struct TensorView<T> {
+    storage: Arc<Vec<T>>,
+    offset: usize,
+    shape: Vec<usize>,
+    strides: Vec<usize>,
+}
+
+impl<T: Clone> Tensor<T> {
+    /// O(1) strided view of the whole tensor
+    pub fn view(&self) -> TensorView<T> {
+        let (storage, offset) = self.storage();
+        TensorView {
+            storage: storage.clone(),
+            offset,
+            shape: self.shape.clone(),
+            strides: self.strides.clone(),
+        }
+    }
+
+    /// Range `start..end` of the leading axis, sharing this storage
+    pub fn narrow(&self, start: usize, end: usize) -> Result<Self, TensorError> {
+        self.view().slice_axis(0, start, end).map(|v| v.to_tensor())
+    }
+
+    /// Sub-tensor at index `i` of the leading axis, sharing this storage
+    ///
+    /// For a matrix this is row `i`; O(1) for any rank.
+    pub fn subtensor(&self, i: usize) -> Result<Self, TensorError> {
+        self.view().index_axis(0, i).map(|v| v.to_tensor())
+    }
+}
+
+impl<T: Clone> TensorView<T> {
+    /// Get shape
+    pub fn shape(&self) -> &[usize] {
+        &self.shape
+    }
+
+    /// Get strides (in elements of the underlying storage)
+    pub fn strides(&self) -> &[usize] {
+        &self.strides
+    }
+
+    /// Number of dimensions
+    pub fn rank(&self) -> usize {
+        self.shape.len()
+    }
+
+    /// Total number of elements
+    pub fn size(&self) -> usize {
+        self.shape.iter().product()
+    }
+
+    fn axis_error(&self, axis: usize, index: usize) -> TensorError {
+        TensorError::IndexOutOfBounds {
+            index: vec![axis, index],
+            shape: self.shape.clone(),
+        }
+    }
+
+    /// Get element at given index
+    pub fn get(&self, index: &[usize]) -> Result<&T, TensorError> {
+        if index.len() != self.shape.len() || index.iter().zip(&self.shape).any(|(i, d)| i >= d) {
+            return Err(TensorError::IndexOutOfBounds {
+                index: index.to_vec(),
+                shape: self.shape.clone(),
+            });
+        }
+        let flat: usize = index.iter().zip(&self.strides).map(|(i, s)| i * s).sum();
+        Ok(&self.storage[self.offset + flat])
+    }
+
+    /// Fix `axis` at `index`, dropping that dimension
+    pub fn index_axis(&self, axis: usize, index: usize) -> Result<Self, TensorError> {
+        if axis >= self.rank() || index >= self.shape[axis] {
+            return Err(self.axis_error(axis, index));
+        }
+        let mut view = self.clone();
+        view.offset += index * self.strides[axis];
+        view.shape.remove(axis);
+        view.strides.remove(axis);
+        Ok(view)
+    }
+
+    /// Restrict `axis` to `start..end`
+    pub fn slice_axis(&self, axis: usize, start: usize, end: usize) -> Result<Self, TensorError> {
+        if axis >= self.rank() || start > end || end > self.shape[axis] {
+            return Err(self.axis_error(axis, end));
+        }
+        let mut view = self.clone();
+        if end > start {
+            view.offset += start * self.strides[axis];
+        }
+        view.shape[axis] = end - start;
+        Ok(view)
+    }
+
+    /// Reverse the order of the axes (the matrix transpose for rank 2)
+    pub fn transpose(&self) -> Self {
+        let mut view = self.clone();
+        view.shape.reverse();
+        view.strides.reverse();
+        view
+    }
+
+    /// Row `i` of a matrix view
+    pub fn row(&self, i: usize) -> Result<Self, TensorError> {
+        self.require_matrix()?;
+        self.index_axis(0, i)
+    }
+
+    /// Column `j` of a matrix view
+    pub fn column(&self, j: usize) -> Result<Self, TensorError> {
+        self.require_matrix()?;
+        self.index_axis(1, j)
+    }
+
+    fn require_matrix(&self) -> Result<(), TensorError> {
+        if self.rank() == 2 {
+            Ok(())
+        } else {
+            Err(TensorError::DimensionMismatch {
+                expected: vec![2],
+                got: vec![self.rank()],
+            })
+        }
+    }
+
+    /// Whether the elements are laid out row-major without gaps
+    pub fn is_contiguous(&self) -> bool {
+        let mut expected = 1;
+        for (&dim, &stride) in self.shape.iter().zip(&self.strides).rev() {
+            if dim == 0 {
+                return true;
+            }
+            if dim != 1 && stride != expected {
+                return false;
+            }
+            expected *= dim;
+        }
+        true
+    }
+
+    /// Elements in row-major order of the view
+    pub fn iter(&self) -> ViewIter<'_, T> {
+        ViewIter {
+            view: self,
+            coords: vec![0; self.rank()],
+            position: self.offset,
+            remaining: self.size(),
+        }
+    }
+
+    /// Materialize as a tensor: zero-copy when contiguous, a gather otherwise
+    pub fn to_tensor(&self) -> Tensor<T> {
+        if self.is_contiguous() {
+            Tensor::from_shared(self.storage.clone(), self.offset, self.shape.clone())
+        } else {
+            Tensor::from_shared(new_storage(self.iter().cloned().collect()), 0, self.shape.clone())
+        }
+    }
+}
+
+/// Row-major iterator over a [`TensorView`]
+pub struct ViewIter<'a, T> {
+    view: &'a TensorView<T>,
+    coords: Vec<usize>,
+    position: usize,
+    remaining: usize,
+}
+
+impl<'a, T> Iterator for ViewIter<'a, T> {
+    type Item = &'a T;
+
+    fn next(&mut self) -> Option<&'a T> {
+        if self.remaining == 0 {
+            return None;
+        }
+        let item = &self.view.storage[self.position];
+        self.remaining -= 1;
+
+        // Odometer step: bump the last axis, carrying into earlier ones
+        for axis in (0..self.coords.len()).rev() {
+            self.coords[axis] += 1;
+            self.position += self.view.strides[axis];
+            if self.coords[axis] < self.view.shape[axis] {
+                break;
+            }
+            self.position -= self.coords[axis] * self.view.strides[axis];
+            self.coords[axis] = 0;
+        }
+        Some(item)
+    }
+
+    fn size_hint(&self) -> (usize, Option<usize>) {
+        (self.remaining, Some(self.remaining))
+    }
+}
+
+impl<T> ExactSizeIterator for ViewIter<'_, T> {}
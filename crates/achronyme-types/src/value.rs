@@ -1,8 +1,10 @@
 use crate::complex::Complex;
 use crate::tensor::{RealTensor, ComplexTensor};
 use crate::function::Function;
+use crate::sequence::Sequence;
+use crate::generator::{GeneratorIterator, GeneratorOp};
 use crate::environment::Environment;
-use achronyme_parser::ast::AstNode;
+use achronyme_parser::Symbol;
 use std::collections::HashMap;
 use std::rc::Rc;
 use std::cell::RefCell;
@@ -20,22 +22,33 @@ impl std::fmt::Display for TypeError {
     }
 }
 
+/// A runtime value
+///
+/// Kept to 32 bytes: numbers, booleans, complex numbers and the headers of
+/// vectors and strings are stored inline, and every larger payload (tensors,
+/// records, functions, error details) sits behind a pointer. Each
+/// `Vec<Value>` element, environment slot and argument pays for the largest
+/// inline variant, so a new variant with a large payload should box it too
+/// (see `test_value_size`).
 #[derive(Debug, Clone, PartialEq)]
 pub enum Value {
     Number(f64),
     Boolean(bool),
     Complex(Complex),
     Vector(Vec<Value>),  // Generic vector - can hold any Value type (strings, records, etc.)
-    Tensor(RealTensor),  // Optimized N-dimensional array of real numbers
-    ComplexTensor(ComplexTensor),  // Optimized N-dimensional array of complex numbers
-    Function(Function),  // Both user-defined lambdas and built-in functions
+    Tensor(Box<RealTensor>),  // Optimized N-dimensional array of real numbers
+    ComplexTensor(Box<ComplexTensor>),  // Optimized N-dimensional array of complex numbers
+    /// Both user-defined lambdas and built-in functions; shared, so cloning a
+    /// function value does not copy its parameters and annotations
+    Function(Rc<Function>),
     String(String),
-    Record(HashMap<String, Value>),
+    Record(Box<HashMap<String, Value>>),
+    /// Graph edge; node IDs are interned so edges carry no heap strings
     Edge {
-        from: String,
-        to: String,
+        from: Symbol,
+        to: Symbol,
         directed: bool,
-        properties: HashMap<String, Value>,
+        properties: Box<HashMap<String, Value>>,
     },
     /// Internal marker for tail call optimization
     /// Contains arguments for the next iteration of a tail-recursive function
@@ -54,45 +67,52 @@ pub enum Value {
     /// Generator: suspended function that can be resumed
     /// Contains state for yield/resume semantics
     Generator(Rc<RefCell<GeneratorState>>),
+    /// Lazy sequence: a source plus map/filter/take stages, evaluated only
+    /// when consumed (see `sequence.rs`)
+    Sequence(Rc<Sequence>),
     /// Internal marker for yield in generators
     /// Contains the value to yield and signals that generator should suspend
     /// This variant should never be exposed to user code
     GeneratorYield(Box<Value>),
     /// Error value for try/catch/throw error handling
-    /// Contains message, optional kind (TypeError, ValueError, etc.), and optional source error
-    Error {
-        message: String,
-        kind: Option<String>,
-        source: Option<Box<Value>>,
-    },
+    Error(Box<ErrorValue>),
+}
+
+/// Payload of `Value::Error`: message, optional kind (TypeError, ValueError,
+/// etc.), and optional source error
+#[derive(Debug, Clone, PartialEq)]
+pub struct ErrorValue {
+    pub message: String,
+    pub kind: Option<String>,
+    pub source: Option<Box<Value>>,
 }
 
 /// State of a generator function
 ///
 /// A generator is a function that can be suspended (yield) and resumed (next()).
-/// It maintains its execution state between calls.
+/// It maintains its execution state between calls: the body lowered to a
+/// program (see `generator.rs`), the index of the next op, the generator's
+/// own environment with any block scopes still open, and the iterators of
+/// the for-in loops it is suspended in.
 #[derive(Debug, Clone)]
 pub struct GeneratorState {
     /// The generator's environment (captured scope)
     pub env: Environment,
 
-    /// Current execution position (statement index)
-    pub position: usize,
+    /// Index of the next op to run
+    pub pc: usize,
+
+    /// Lowered generator body, shared by every instance of the same block
+    pub program: Rc<[GeneratorOp]>,
 
-    /// Statements in the generator body
-    pub statements: Vec<AstNode>,
+    /// Iterators of the enclosing for-in loops, innermost last
+    pub iterators: Vec<GeneratorIterator>,
 
     /// Is the generator exhausted?
     pub done: bool,
 
     /// Value returned by last `return` statement (sticky)
     pub return_value: Option<Box<Value>>,
-
-    /// Track how many yields have occurred (for resuming)
-    pub yield_count: usize,
-
-    /// Current yield target (for resuming after nested yields)
-    pub current_yield_target: usize,
 }
 
 // Conversiones automáticas con From/Into
@@ -102,6 +122,30 @@ impl From<f64> for Value {
     }
 }
 
+impl From<RealTensor> for Value {
+    fn from(tensor: RealTensor) -> Self {
+        Value::Tensor(Box::new(tensor))
+    }
+}
+
+impl From<ComplexTensor> for Value {
+    fn from(tensor: ComplexTensor) -> Self {
+        Value::ComplexTensor(Box::new(tensor))
+    }
+}
+
+impl From<Function> for Value {
+    fn from(function: Function) -> Self {
+        Value::Function(Rc::new(function))
+    }
+}
+
+impl From<HashMap<String, Value>> for Value {
+    fn from(map: HashMap<String, Value>) -> Self {
+        Value::Record(Box::new(map))
+    }
+}
+
 // Helper functions for vector operations
 impl Value {
     /// Check if a vector is numeric (contains only Number or Complex values)
@@ -141,7 +185,7 @@ impl Value {
         if tensor.is_vector() {
             Value::Vector(tensor.data().iter().map(|&n| Value::Number(n)).collect())
         } else {
-            Value::Tensor(tensor)
+            Value::Tensor(Box::new(tensor))
         }
     }
 
@@ -150,10 +194,15 @@ impl Value {
         if tensor.is_vector() {
             Value::Vector(tensor.data().iter().map(|&c| Value::Complex(c)).collect())
         } else {
-            Value::ComplexTensor(tensor)
+            Value::ComplexTensor(Box::new(tensor))
         }
     }
 
+    /// Error value with no source error
+    pub fn error(message: String, kind: Option<String>) -> Value {
+        Value::Error(Box::new(ErrorValue { message, kind, source: None }))
+    }
+
     pub fn as_complex(&self) -> Option<&Complex> {
         if let Value::Complex(c) = self {
             Some(c)
@@ -207,15 +256,14 @@ impl Value {
 
 impl GeneratorState {
     /// Create a new generator state
-    pub fn new(env: Environment, statements: Vec<AstNode>) -> Self {
+    pub fn new(env: Environment, program: Rc<[GeneratorOp]>) -> Self {
         Self {
             env,
-            position: 0,
-            statements,
+            pc: 0,
+            program,
+            iterators: Vec::new(),
             done: false,
             return_value: None,
-            yield_count: 0,
-            current_yield_target: 0,
         }
     }
 
@@ -238,9 +286,9 @@ impl PartialEq for GeneratorState {
         // For generators, we use structural equality of position and done state
         // This is reasonable since generators with same state are "equivalent"
         // But in practice, comparing generators is rare
-        self.position == other.position
+        self.pc == other.pc
             && self.done == other.done
-            && self.statements.len() == other.statements.len()
+            && Rc::ptr_eq(&self.program, &other.program)
     }
 }
 
@@ -263,13 +311,13 @@ impl std::ops::Add for Value {
                         let tensor_a = Value::to_complex_tensor(a)?;
                         let tensor_b = Value::to_complex_tensor(b)?;
                         let result = tensor_a.add(&tensor_b).map_err(|_| TypeError::IncompatibleTypes)?;
-                        Ok(Value::ComplexTensor(result))
+                        Ok(Value::ComplexTensor(Box::new(result)))
                     } else {
                         // Real tensor addition
                         let tensor_a = Value::to_real_tensor(a)?;
                         let tensor_b = Value::to_real_tensor(b)?;
                         let result = tensor_a.add(&tensor_b).map_err(|_| TypeError::IncompatibleTypes)?;
-                        Ok(Value::Tensor(result))
+                        Ok(Value::Tensor(Box::new(result)))
                     }
                 } else {
                     Err(TypeError::IncompatibleTypes)
@@ -282,4 +330,15 @@ impl std::ops::Add for Value {
             _ => Err(TypeError::IncompatibleTypes),
         }
     }
-}
\ No newline at end of file
+}
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_value_size() {
+        // Large payloads are boxed: a Value is a tag plus a Vec/String header
+        assert!(std::mem::size_of::<Value>() <= 32, "Value is {} bytes", std::mem::size_of::<Value>());
+        assert!(std::mem::size_of::<Option<Value>>() <= 32);
+    }
+}